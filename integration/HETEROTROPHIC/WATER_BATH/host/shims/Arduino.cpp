@@ -0,0 +1,67 @@
+// Arduino.cpp
+#include <Arduino.h>
+#include <chrono>
+
+static size_t heapUsed = 0;
+static size_t heapPeak = 0;
+
+size_t hostHeapUsed() { return heapUsed; }
+size_t hostHeapPeak() { return heapPeak; }
+void hostResetHeapPeak() { heapPeak = heapUsed; }
+
+unsigned long millis() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return duration_cast<milliseconds>(steady_clock::now() - start).count();
+}
+
+String::String(unsigned int value) {
+    char digits[12];
+    concat(digits, snprintf(digits, sizeof(digits), "%u", value));
+}
+
+String::String(unsigned long value) {
+    char digits[24];
+    concat(digits, snprintf(digits, sizeof(digits), "%lu", value));
+}
+
+String::String(float value, unsigned int decimals) {
+    char digits[48];
+    concat(digits, snprintf(digits, sizeof(digits), "%.*f", decimals, value));
+}
+
+String::~String() {
+    heapUsed -= _capacity;
+    free(_buffer);
+}
+
+String& String::operator=(const String& other) {
+    if (this != &other) {
+        _length = 0;
+        concat(other.c_str(), other._length);
+    }
+    return *this;
+}
+
+void String::concat(const char* s, size_t count) {
+    if (_length + count + 1 > _capacity) {
+        unsigned int capacity = _length + count + 1;
+        _buffer = static_cast<char*>(realloc(_buffer, capacity));
+        heapUsed += capacity - _capacity;
+        heapPeak = max(heapPeak, heapUsed);
+        _capacity = capacity;
+    }
+    memcpy(_buffer + _length, s, count);
+    _length += count;
+    _buffer[_length] = 0;
+}
+
+size_t Print::print(unsigned long value) {
+    char digits[24];
+    return write(reinterpret_cast<const uint8_t*>(digits), snprintf(digits, sizeof(digits), "%lu", value));
+}
+
+size_t Print::print(double value, int decimals) {
+    char digits[48];
+    return write(reinterpret_cast<const uint8_t*>(digits), snprintf(digits, sizeof(digits), "%.*f", decimals, value));
+}
@@ -0,0 +1,81 @@
+// Arduino.h
+// Host stand-in of the ESP32 Arduino core for the web pages of the water bath built on the PC: String, Print,
+// PROGMEM and millis().
+// String grows like the Arduino one (a realloc to the exact new length on every concatenation) and its blocks are
+// counted, so that a test sees the heap a request takes. Only the web server task may use String during a run.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define F(x) (x)
+typedef const char* PGM_P;
+
+unsigned long millis();
+
+// Bytes held by String blocks, highest since the last hostResetHeapPeak()
+size_t hostHeapUsed();
+size_t hostHeapPeak();
+void hostResetHeapPeak();
+
+class String {
+public:
+    String() {}
+    String(const char* value) { concat(value ? value : "", value ? strlen(value) : 0); }
+    String(const String& other) { concat(other.c_str(), other._length); }
+    explicit String(unsigned int value);
+    explicit String(unsigned long value);
+    explicit String(float value, unsigned int decimals = 2);
+    ~String();
+
+    String& operator=(const String& other);
+
+    unsigned int length() const { return _length; }
+    const char* c_str() const { return _buffer ? _buffer : ""; }
+
+    String& operator+=(const String& s) { concat(s.c_str(), s._length); return *this; }
+    String& operator+=(const char* s) { if (s) concat(s, strlen(s)); return *this; }
+
+    bool operator==(const String& other) const { return _length == other._length && !memcmp(c_str(), other.c_str(), _length); }
+    bool operator==(const char* other) const { return other && strcmp(c_str(), other) == 0; }
+    bool operator!=(const String& other) const { return !(*this == other); }
+
+private:
+    char* _buffer = nullptr;
+    unsigned int _length = 0;
+    unsigned int _capacity = 0;
+
+    void concat(const char* s, size_t count);
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* data, size_t size) {
+        size_t written = 0;
+        while (size--) written += write(*data++);
+        return written;
+    }
+    size_t write(const char* s) { return write(reinterpret_cast<const uint8_t*>(s), strlen(s)); }
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s) { return write(reinterpret_cast<const uint8_t*>(s.c_str()), s.length()); }
+    size_t print(unsigned long value);
+    size_t print(double value, int decimals = 2);
+};
+
+#endif // HOST_ARDUINO_H
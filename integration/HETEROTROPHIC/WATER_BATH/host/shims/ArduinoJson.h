@@ -0,0 +1,8 @@
+// ArduinoJson.h
+// Only the type named by MessageFormatter.h: no JSON is built on the host.
+#ifndef HOST_ARDUINO_JSON_H
+#define HOST_ARDUINO_JSON_H
+
+class JsonDocument {};
+
+#endif // HOST_ARDUINO_JSON_H
@@ -0,0 +1,177 @@
+// WebServer.cpp
+#include <WebServer.h>
+#include <WiFi.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+
+WiFiClass WiFi;
+
+double WebServer::hostLinkBytesPerSecond = 250000;
+
+WebServer::WebServer(int port)
+    : _port(port), _listener(-1), _client(-1), _routeCount(0), _headerKeysCount(0),
+      _contentLength(CONTENT_LENGTH_NOT_SET), _chunked(false), _requests(0), _bytesSent(0), _maxRequestHeap(0) {
+}
+
+WebServer::~WebServer() {
+    stop();
+}
+
+void WebServer::begin() {
+    _listener = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(_port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(_listener, reinterpret_cast<sockaddr*>(&address), length) != 0 || listen(_listener, 16) != 0) {
+        perror("WebServer");
+        exit(1);
+    }
+    getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &length);
+    _port = ntohs(address.sin_port);
+    fcntl(_listener, F_SETFL, O_NONBLOCK);      // handleClient() returns at once without a client
+}
+
+void WebServer::stop() {
+    if (_listener >= 0) close(_listener);
+    _listener = -1;
+}
+
+void WebServer::on(const char* uri, HTTPMethod method, THandlerFunction handler) {
+    if (_routeCount < MAX_ROUTES) _routes[_routeCount++] = {uri, method, handler};
+}
+
+void WebServer::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    _headerKeysCount = min(headerKeysCount, MAX_HEADERS);
+    for (size_t i = 0; i < _headerKeysCount; i++) _headerKeys[i] = headerKeys[i];
+}
+
+String WebServer::header(const char* name) {
+    for (size_t i = 0; i < _headerKeysCount; i++) {
+        if (strcasecmp(_headerKeys[i], name) == 0) return _headerValues[i];
+    }
+    return String();
+}
+
+void WebServer::handleClient() {
+    if (_listener < 0) return;
+    _client = accept(_listener, nullptr, nullptr);
+    if (_client < 0) return;
+
+    // The request line and headers, as WebServer::_parseRequest() reads them
+    char request[1024];
+    size_t received = 0;
+    while (received < sizeof(request) - 1) {
+        ssize_t count = recv(_client, request + received, sizeof(request) - 1 - received, 0);
+        if (count <= 0) break;
+        received += count;
+        request[received] = 0;
+        if (strstr(request, "\r\n\r\n")) break;
+    }
+    request[received] = 0;
+
+    hostResetHeapPeak();
+    size_t heapBefore = hostHeapUsed();
+
+    char method[8] = "";
+    char uri[128] = "";
+    sscanf(request, "%7s %127s", method, uri);
+    if (char* query = strchr(uri, '?')) *query = 0;
+    for (size_t i = 0; i < _headerKeysCount; i++) {
+        _headerValues[i] = String();
+        for (const char* line = strstr(request, "\r\n"); line && line[2] != '\r'; line = strstr(line + 2, "\r\n")) {
+            size_t keyLength = strlen(_headerKeys[i]);
+            if (strncasecmp(line + 2, _headerKeys[i], keyLength) == 0 && line[2 + keyLength] == ':') {
+                char value[128] = "";
+                sscanf(line + 3 + keyLength, " %127[^\r]", value);
+                _headerValues[i] = String(value);
+                break;
+            }
+        }
+    }
+
+    _requests++;
+    HTTPMethod requestMethod = strcmp(method, "POST") == 0 ? HTTP_POST : HTTP_GET;
+    bool handled = false;
+    for (size_t i = 0; i < _routeCount && !handled; i++) {
+        if (strcmp(_routes[i].uri, uri) == 0 && (_routes[i].method == HTTP_ANY || _routes[i].method == requestMethod)) {
+            _routes[i].handler();
+            handled = true;
+        }
+    }
+    if (!handled) send(404, "text/plain", "Not found");
+
+    for (size_t i = 0; i < _headerKeysCount; i++) _headerValues[i] = String();
+    _maxRequestHeap = max(_maxRequestHeap, hostHeapPeak() - heapBefore);
+
+    close(_client);
+    _client = -1;
+}
+
+void WebServer::sendHeader(const String& name, const String& value) {
+    _responseHeaders += name;
+    _responseHeaders += ": ";
+    _responseHeaders += value;
+    _responseHeaders += "\r\n";
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    sendStatus(code, contentType, _contentLength == CONTENT_LENGTH_NOT_SET ? content.length() : _contentLength);
+    if (content.length() > 0) sendContent(content);
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) {
+    sendStatus(code, contentType, contentLength);
+    write(content, contentLength);
+}
+
+void WebServer::sendContent(const char* content, size_t contentLength) {
+    if (!_chunked) {
+        write(content, contentLength);
+        return;
+    }
+    char size[12];
+    write(size, snprintf(size, sizeof(size), "%zx\r\n", contentLength));
+    write(content, contentLength);
+    write("\r\n", 2);
+    if (contentLength == 0) _chunked = false;     // Last chunk
+}
+
+void WebServer::sendStatus(int code, const char* contentType, size_t contentLength) {
+    char status[256];
+    int length = snprintf(status, sizeof(status), "HTTP/1.1 %d %s\r\n", code,
+                          code == 200 ? "OK" : code == 304 ? "Not Modified" : code == 404 ? "Not Found" : "Error");
+    if (contentType) length += snprintf(status + length, sizeof(status) - length, "Content-Type: %s\r\n", contentType);
+    _chunked = contentLength == CONTENT_LENGTH_UNKNOWN;
+    if (_chunked) {
+        length += snprintf(status + length, sizeof(status) - length, "Transfer-Encoding: chunked\r\n");
+    } else {
+        length += snprintf(status + length, sizeof(status) - length, "Content-Length: %zu\r\n", contentLength);
+    }
+    length += snprintf(status + length, sizeof(status) - length, "Connection: close\r\n");
+    write(status, length);
+    write(_responseHeaders.c_str(), _responseHeaders.length());
+    write("\r\n", 2);
+    _responseHeaders = String();
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+}
+
+void WebServer::write(const char* data, size_t length) {
+    if (_client < 0 || length == 0) return;
+    std::this_thread::sleep_for(std::chrono::duration<double>(length / hostLinkBytesPerSecond));
+    while (length > 0) {
+        ssize_t count = ::send(_client, data, length, MSG_NOSIGNAL);
+        if (count <= 0) return;
+        data += count;
+        length -= count;
+        _bytesSent += count;
+    }
+}
@@ -0,0 +1,76 @@
+// WebServer.h
+// Stand-in of the synchronous ESP32 WebServer over loopback sockets: one request per handleClient(), HTTP/1.1 with
+// Connection: close, chunked transfer encoding after setContentLength(CONTENT_LENGTH_UNKNOWN).
+// Every write to the client takes the air time of its bytes on a WiFi station of hostLinkBytesPerSecond, in the
+// calling task like on the target. Port 0 takes any free port (hostPort()).
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include <Arduino.h>
+#include <functional>
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) -2)
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST };
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    static double hostLinkBytesPerSecond;
+
+    explicit WebServer(int port = 80);
+    ~WebServer();
+
+    void begin();
+    void stop();
+    void handleClient();
+
+    void on(const char* uri, HTTPMethod method, THandlerFunction handler);
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const char* name);
+
+    void sendHeader(const String& name, const String& value);
+    void setContentLength(size_t contentLength) { _contentLength = contentLength; }
+    void send(int code, const char* contentType = nullptr, const String& content = String(""));
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength);
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t contentLength);
+
+    int hostPort() const { return _port; }
+    size_t hostRequests() const { return _requests; }
+    size_t hostBytesSent() const { return _bytesSent; }
+    size_t hostMaxRequestHeap() const { return _maxRequestHeap; }      // Highest String heap of one request
+
+private:
+    static const size_t MAX_ROUTES = 16;
+    static const size_t MAX_HEADERS = 4;
+
+    struct Route {
+        const char* uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+
+    int _port;
+    int _listener;
+    int _client;
+    Route _routes[MAX_ROUTES];
+    size_t _routeCount;
+    const char* _headerKeys[MAX_HEADERS];
+    String _headerValues[MAX_HEADERS];
+    size_t _headerKeysCount;
+    String _responseHeaders;
+    size_t _contentLength;
+    bool _chunked;
+
+    size_t _requests;
+    size_t _bytesSent;
+    size_t _maxRequestHeap;
+
+    void write(const char* data, size_t length);
+    void sendStatus(int code, const char* contentType, size_t contentLength);
+};
+
+#endif // HOST_WEBSERVER_H
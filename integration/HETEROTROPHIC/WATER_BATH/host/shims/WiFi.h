@@ -0,0 +1,20 @@
+// WiFi.h
+// Station address of the ESP32 WiFi library, for the device information of the pages.
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+
+class IPAddress {
+public:
+    String toString() const { return String("192.168.1.42"); }
+};
+
+class WiFiClass {
+public:
+    IPAddress localIP() const { return IPAddress(); }
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
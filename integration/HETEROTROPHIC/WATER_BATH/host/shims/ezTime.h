@@ -0,0 +1,8 @@
+// ezTime.h
+// Only the type named by MessageFormatter.h.
+#ifndef HOST_EZTIME_H
+#define HOST_EZTIME_H
+
+class Timezone {};
+
+#endif // HOST_EZTIME_H
@@ -0,0 +1,19 @@
+// StringPageBuilder.h
+// The pages as the water bath built them before ChunkedResponse: the whole page in a String, style and script inline.
+#ifndef STRING_PAGE_BUILDER_H
+#define STRING_PAGE_BUILDER_H
+
+#include <Arduino.h>
+#include "MessageFormatter.h"
+
+class StringPageBuilder {
+public:
+    static String buildIndexPage(const String& deviceInfo);
+    static String buildDataPage(const SensorData& data);
+
+private:
+    static String getStyle();
+    static String getScript();
+};
+
+#endif // STRING_PAGE_BUILDER_H
@@ -0,0 +1,255 @@
+// Load test of the water bath web pages against the stand-in WebServer (loopback, 250 KB/s WiFi link): browsers load
+// "/" and "/data" in turn for a few seconds, once with the pages built as a String and served every 10 ms (before
+// ChunkedResponse, StringPageBuilder), once streamed by ChunkedResponse every TASK_INTERVAL_WEBSERVER with /style.css
+// and /app.js revalidated by ETag. The routes are those of WebServerManager::setupRoutes(), then and now.
+// Reported: requests and page loads per second, bytes per page load, highest String heap of one request.
+#include "HostTest.h"
+#include <Arduino.h>
+#include <WebServer.h>
+#include <WiFi.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ChunkedResponse.h"
+#include "StringPageBuilder.h"
+#include "WebAssets.h"
+#include "WebPageBuilder.h"
+#include "config.h"
+
+static const int SECONDS = 3;
+static const int BROWSERS = 2;
+static const int STRING_PAGES_INTERVAL = 10;        // ms, serverTask() before ChunkedResponse
+static const uint32_t FREE_HEAP = 187432;
+static const SensorData SENSOR_DATA = {37.25f};
+
+struct LoadResult {
+    double requestsPerSecond;
+    double pageLoadsPerSecond;
+    double bytesPerPageLoad;
+    size_t maxRequestHeap;
+};
+
+struct Response {
+    int code = 0;
+    std::string etag;
+    std::string body;
+    size_t bytes = 0;
+};
+
+// BioreactorDataProvider::getDeviceInfo()
+static String deviceInfo() {
+    String info;
+    info += "Device ID: " + String(MQTT_CLIENT_ID) + "<br>";
+    info += "IP: " + WiFi.localIP().toString() + "<br>";
+    info += "Uptime: " + String(millis() / 1000) + "s<br>";
+    info += "Free Heap: " + String(FREE_HEAP) + " bytes<br>";
+    return info;
+}
+
+// Page written as the browser should get it once the chunks are put together
+class StringPrint : public Print {
+public:
+    std::string text;
+    size_t write(uint8_t c) override { text += static_cast<char>(c); return 1; }
+    using Print::write;
+};
+
+static std::string dechunk(const std::string& body) {
+    std::string result;
+    size_t position = 0;
+    while (position < body.size()) {
+        size_t lineEnd = body.find("\r\n", position);
+        if (lineEnd == std::string::npos) return "<bad chunk>";
+        size_t size = strtoul(body.c_str() + position, nullptr, 16);
+        if (size == 0) return body.compare(lineEnd, 4, "\r\n\r\n") == 0 ? result : "<bad last chunk>";
+        result.append(body, lineEnd + 2, size);
+        position = lineEnd + 2 + size + 2;
+    }
+    return "<no last chunk>";
+}
+
+static Response get(int port, const char* path, const std::string& etag) {
+    Response response;
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(s, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(s);
+        return response;
+    }
+    std::string request = std::string("GET ") + path + " HTTP/1.1\r\nHost: water-bath\r\nAccept-Encoding: gzip\r\n";
+    if (!etag.empty()) request += "If-None-Match: " + etag + "\r\n";
+    request += "\r\n";
+    send(s, request.data(), request.size(), MSG_NOSIGNAL);
+
+    std::string raw;
+    char buffer[4096];
+    ssize_t count;
+    while ((count = recv(s, buffer, sizeof(buffer), 0)) > 0) raw.append(buffer, count);
+    close(s);
+
+    response.bytes = raw.size();
+    size_t headerEnd = raw.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) return response;
+    std::string headers = raw.substr(0, headerEnd + 2);
+    sscanf(headers.c_str(), "HTTP/1.1 %d", &response.code);
+    size_t etagStart = headers.find("ETag: ");
+    if (etagStart != std::string::npos) {
+        etagStart += 6;
+        response.etag = headers.substr(etagStart, headers.find("\r\n", etagStart) - etagStart);
+    }
+    response.body = raw.substr(headerEnd + 4);
+    if (headers.find("Transfer-Encoding: chunked") != std::string::npos) response.body = dechunk(response.body);
+    return response;
+}
+
+// Precompressed static file: a browser that has the current version gets a 304 without body
+static void serveAsset(WebServer& server, const WebAsset& asset) {
+    server.sendHeader("ETag", asset.etag);
+    server.sendHeader("Cache-Control", "no-cache");
+    if (server.header("If-None-Match") == asset.etag) {
+        server.send(304);
+        return;
+    }
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, asset.contentType, reinterpret_cast<PGM_P>(asset.data), asset.length);
+}
+
+static void setupStringRoutes(WebServer& server) {
+    server.on("/", HTTP_GET, [&server]() {
+        String html = StringPageBuilder::buildIndexPage(deviceInfo());
+        server.send(200, "text/html", html);
+    });
+
+    server.on("/data", HTTP_GET, [&server]() {
+        SensorData data = SENSOR_DATA;
+        String html = StringPageBuilder::buildDataPage(data);
+        server.send(200, "text/html", html);
+    });
+}
+
+static void setupStreamedRoutes(WebServer& server) {
+    static const char* headerKeys[] = {"If-None-Match"};
+    server.collectHeaders(headerKeys, 1);
+
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        const WebAsset* asset = &WEB_ASSETS[i];
+        server.on(asset->path, HTTP_GET, [&server, asset]() {
+            serveAsset(server, *asset);
+        });
+    }
+
+    server.on("/", HTTP_GET, [&server]() {
+        ChunkedResponse page(server, 200, "text/html");
+        WebPageBuilder::writeIndexPage(page, deviceInfo());
+    });
+
+    server.on("/data", HTTP_GET, [&server]() {
+        ChunkedResponse page(server, 200, "text/html");
+        WebPageBuilder::writeDataPage(page, SENSOR_DATA);
+    });
+}
+
+static LoadResult runLoad(const char* name, bool streamed) {
+    WebServer server(0);
+    if (streamed) {
+        setupStreamedRoutes(server);
+    } else {
+        setupStringRoutes(server);
+    }
+    server.begin();
+    const int interval = streamed ? TASK_INTERVAL_WEBSERVER : STRING_PAGES_INTERVAL;
+
+    std::atomic<bool> serving(true);
+    std::thread serverTask([&]() {
+        while (serving) {
+            server.handleClient();
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+        }
+    });
+
+    StringPrint dataPage;
+    WebPageBuilder::writeDataPage(dataPage, SENSOR_DATA);
+
+    std::atomic<bool> loading(true);
+    std::atomic<size_t> pageLoads(0), bytesReceived(0), badResponses(0), assetsDownloaded(0);
+    std::vector<std::thread> browsers;
+    for (int b = 0; b < BROWSERS; b++) {
+        browsers.emplace_back([&]() {
+            const char* pages[] = {"/", "/data"};
+            std::vector<std::string> etags(streamed ? WEB_ASSET_COUNT : 0);
+            for (unsigned load = 0; loading; load++) {
+                const char* path = pages[load % 2];
+                Response page = get(server.hostPort(), path, "");
+                size_t bytes = page.bytes;
+                bool good = page.code == 200 && page.body.size() >= 7 &&
+                            page.body.compare(page.body.size() - 7, 7, "</html>") == 0;
+                if (streamed && strcmp(path, "/data") == 0) good = good && page.body == dataPage.text;
+
+                for (size_t i = 0; i < etags.size(); i++) {
+                    const WebAsset& asset = WEB_ASSETS[i];
+                    Response file = get(server.hostPort(), asset.path, etags[i]);
+                    bytes += file.bytes;
+                    if (etags[i].empty()) {
+                        good = good && file.code == 200 && file.body.size() == asset.length &&
+                               memcmp(file.body.data(), asset.data, asset.length) == 0;
+                        assetsDownloaded++;
+                    } else {
+                        good = good && file.code == 304 && file.body.empty();
+                    }
+                    good = good && file.etag == asset.etag;
+                    etags[i] = file.etag;
+                }
+                if (!good) badResponses++;
+                bytesReceived += bytes;
+                pageLoads++;
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(SECONDS));
+    loading = false;
+    for (std::thread& browser : browsers) browser.join();
+    serving = false;
+    serverTask.join();
+
+    LoadResult result;
+    result.requestsPerSecond = server.hostRequests() / double(SECONDS);
+    result.pageLoadsPerSecond = pageLoads / double(SECONDS);
+    result.bytesPerPageLoad = pageLoads ? bytesReceived / double(pageLoads) : 0;
+    result.maxRequestHeap = server.hostMaxRequestHeap();
+    printf("%-8s %d browsers: %6.1f requests/s, %5.1f page loads/s, %5.0f bytes/page load, %5zu B heap per request\n",
+           name, BROWSERS, result.requestsPerSecond, result.pageLoadsPerSecond, result.bytesPerPageLoad,
+           result.maxRequestHeap);
+    CHECK(pageLoads > 0);
+    CHECK(badResponses == 0);
+    // The gzip files go once to each browser, then only 304s
+    CHECK(assetsDownloaded == (streamed ? BROWSERS * WEB_ASSET_COUNT : 0));
+    return result;
+}
+
+int main() {
+    LoadResult before = runLoad("String", false);
+    LoadResult after = runLoad("streamed", true);
+
+    // The index page holds the device info String in both cases, the streamed pages nothing else
+    size_t infoHeap = deviceInfo().length() + 1;
+    printf("requests/s x%.1f, page loads/s x%.1f, bytes/page load x%.2f, heap per request %zu -> %zu B "
+           "(device info %zu B)\n", after.requestsPerSecond / before.requestsPerSecond,
+           after.pageLoadsPerSecond / before.pageLoadsPerSecond, after.bytesPerPageLoad / before.bytesPerPageLoad,
+           before.maxRequestHeap, after.maxRequestHeap, infoHeap);
+    CHECK(after.requestsPerSecond >= 3 * before.requestsPerSecond);
+    CHECK(after.pageLoadsPerSecond > before.pageLoadsPerSecond);
+    CHECK(after.bytesPerPageLoad < before.bytesPerPageLoad);
+    CHECK(before.maxRequestHeap > 4 * infoHeap);
+    CHECK(after.maxRequestHeap <= 2 * infoHeap);
+    return testResult();
+}
@@ -10,4 +10,9 @@ String APIHandler::serializeData(const SensorData& data) {
     String json;
     serializeJson(doc, json);
     return json;
+}
+
+size_t APIHandler::writeLiveData(char* buffer, size_t size, const SensorData& data) {
+    int length = snprintf(buffer, size, "{\"waterTemp\":%.2f,\"uptime\":%lu}", data.waterTemp, millis() / 1000);
+    return (length > 0 && static_cast<size_t>(length) < size) ? length : 0;
 }
\ No newline at end of file
@@ -12,6 +12,8 @@ class APIHandler {
 public:
     explicit APIHandler(DataProvider& provider);
     static String serializeData(const SensorData& data);
+    // Live values of the web dashboard as JSON, written into buffer; returns the length (0 if it does not fit)
+    static size_t writeLiveData(char* buffer, size_t size, const SensorData& data);
     void handleGETRequest(AsyncWebServerRequest *request);
     void handlePOSTRequest(AsyncWebServerRequest *request);
     
@@ -0,0 +1,41 @@
+// ChunkedResponse.cpp
+#include "ChunkedResponse.h"
+
+ChunkedResponse::ChunkedResponse(WebServer& server, int code, const char* contentType)
+    : server(server), length(0), ended(false) {
+    // Unknown length: WebServer answers with Transfer-Encoding: chunked
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(code, contentType, "");
+}
+
+size_t ChunkedResponse::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t ChunkedResponse::write(const uint8_t* data, size_t size) {
+    if (ended) return 0;
+
+    size_t written = 0;
+    while (written < size) {
+        size_t count = min(size - written, BUFFER_SIZE - length);
+        memcpy(buffer + length, data + written, count);
+        length += count;
+        written += count;
+        if (length == BUFFER_SIZE) flush();
+    }
+    return written;
+}
+
+void ChunkedResponse::end() {
+    if (ended) return;
+    flush();
+    server.sendContent("");     // Zero-length chunk: end of the response
+    ended = true;
+}
+
+void ChunkedResponse::flush() {
+    if (length > 0) {
+        server.sendContent(buffer, length);
+        length = 0;
+    }
+}
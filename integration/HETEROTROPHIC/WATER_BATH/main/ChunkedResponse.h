@@ -0,0 +1,35 @@
+// ChunkedResponse.h
+#ifndef CHUNKED_RESPONSE_H
+#define CHUNKED_RESPONSE_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+/*
+ * Print sending a response with chunked transfer encoding: a page is written piece by piece into a fixed
+ * buffer sent as one chunk whenever it is full, it is never held whole in RAM.
+ */
+class ChunkedResponse : public Print {
+public:
+    static const size_t BUFFER_SIZE = 512;      // One chunk, on the stack of the web server task
+
+    ChunkedResponse(WebServer& server, int code, const char* contentType);
+    ~ChunkedResponse() { end(); }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+
+    // Send the last chunk, called by the destructor otherwise
+    void end();
+
+private:
+    WebServer& server;
+    char buffer[BUFFER_SIZE];
+    size_t length;
+    bool ended;
+
+    void flush();
+};
+
+#endif // CHUNKED_RESPONSE_H
@@ -5,6 +5,8 @@ MQTTClient::MQTTClient() :
     reconnectTaskHandle(nullptr),
     heartbeatTaskHandle(nullptr),
     messageQueue(nullptr),
+    messagePool(MQTT_POOL_SIZE),
+    receiving(nullptr),
     connected(false),
     retryCount(0),
     connectionEstablishedCallback(nullptr),
@@ -28,8 +30,12 @@ void MQTTClient::begin() {
         WiFiManager::connect();
     }
     
-    // Créer la queue de messages
-    messageQueue = TaskManager::createQueue(MQTT_QUEUE_SIZE, sizeof(MQTTMessage));
+    // Créer le pool et la queue de messages (pointeurs vers le pool)
+    if (!messagePool.begin()) {
+        Logger::log(Logger::LogLevel::ERROR, "MQTT message pool allocation failed");
+        return;
+    }
+    messageQueue = TaskManager::createQueue(MQTT_POOL_SIZE, sizeof(MQTTMessagePool::Message*));
     
     // Configuration MQTT
     setupMQTT();
@@ -122,13 +128,14 @@ void MQTTClient::heartbeatTask(void* parameter) {
 
 void MQTTClient::messageHandlerTask(void* parameter) {
     MQTTClient* client = static_cast<MQTTClient*>(parameter);
-    MQTTMessage message;
+    MQTTMessagePool::Message* message;
 
     while (true) {
         if (xQueueReceive(client->messageQueue, &message, portMAX_DELAY) == pdTRUE) {
             if (client->messageCallback) {
-                client->messageCallback(message.topic, message.payload);
+                client->messageCallback(message->topic, message->payload);
             }
+            client->messagePool.release(message);
         }
     }
 }
@@ -163,53 +170,84 @@ void MQTTClient::handleDisconnect(AsyncMqttClientDisconnectReason reason) {
 void MQTTClient::handleMessage(char* topic, char* payload,
                              AsyncMqttClientMessageProperties properties,
                              size_t len, size_t index, size_t total) {
-    if (len >= sizeof(MQTTMessage::payload)) {
-        Logger::log(Logger::LogLevel::ERROR, "Message too large");
-        return;
+    // A message larger than the TCP segment arrives in several chunks, copied at their index into the same slot
+    if (index == 0) {
+        if (receiving) {
+            messagePool.release(receiving);    // Previous message never completed
+            receiving = nullptr;
+        }
+        if (total >= MQTTMessagePool::PAYLOAD_SIZE || strlen(topic) >= MQTTMessagePool::TOPIC_SIZE) {
+            Logger::log(Logger::LogLevel::ERROR, "Message too large");
+            return;
+        }
+        receiving = messagePool.acquire();
+        if (!receiving) {
+            Logger::log(Logger::LogLevel::ERROR, "Message queue full");
+            return;
+        }
+        strlcpy(receiving->topic, topic, sizeof(receiving->topic));
     }
+    if (!receiving || index + len > total || total >= MQTTMessagePool::PAYLOAD_SIZE) return;
 
-    MQTTMessage message;
-    strlcpy(message.topic, topic, sizeof(message.topic));
-    strlcpy(message.payload, payload, sizeof(message.payload));
+    // The payload is not NUL-terminated
+    memcpy(receiving->payload + index, payload, len);
+    if (index + len < total) return;
 
-    if (xQueueSend(messageQueue, &message, 0) != pdTRUE) {
+    receiving->payload[total] = '\0';
+    receiving->length = total;
+    if (xQueueSend(messageQueue, &receiving, 0) != pdTRUE) {
+        messagePool.release(receiving);
         Logger::log(Logger::LogLevel::ERROR, "Message queue full");
     }
+    receiving = nullptr;
+}
+
+template <typename Builder>
+bool MQTTClient::publishJson(const char* topic, uint8_t qos, bool retain, Builder builder) {
+    MQTTMessagePool::Message* message = messagePool.acquire();
+    if (!message) {
+        Logger::log(Logger::LogLevel::ERROR, "MQTT message pool empty");
+        return false;
+    }
+
+    bool sent = false;
+    if (messagePool.serialize(message, builder)) {
+        // AsyncMqttClient copies the payload into its own buffer: the slot is free again once publish() returns
+        sent = mqttClient.publish(topic, qos, retain, message->payload, message->length) != 0;
+    } else {
+        Logger::log(Logger::LogLevel::ERROR, "Generated message too large for " + String(topic));
+    }
+    messagePool.release(message);
+    return sent;
 }
 
 bool MQTTClient::publishSensorData(const SensorData& data) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = MessageFormatter::createSensorMessage(data);
-    String payload;
-    serializeJson(doc, payload);
-    
-    if (payload.length() >= sizeof(MQTTMessage::payload)) {
-        Logger::log(Logger::LogLevel::ERROR, "Generated message too large: " + String(payload.length()) + " bytes");
-        return false;
-    }
-    
-    return mqttClient.publish(MQTT_TOPIC_SENSORS, 0, true, payload.c_str()) != 0;
+    return publishJson(MQTT_TOPIC_SENSORS, 0, true, [&data](JsonDocument& doc) {
+        MessageFormatter::addSensorMessage(doc, data);
+    });
 }
 
 bool MQTTClient::publishStatus(const String& status) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = MessageFormatter::createStatusMessage(status);
-    String payload;
-    serializeJson(doc, payload);
-    
-    return mqttClient.publish(MQTT_TOPIC_STATUS, 0, true, payload.c_str()) != 0;
+    return publishJson(MQTT_TOPIC_STATUS, 0, true, [&status](JsonDocument& doc) {
+        MessageFormatter::addStatusMessage(doc, status);
+    });
 }
 
 bool MQTTClient::publishHeartbeat() {
     if (!isConnected()) return false;
 
-    JsonDocument doc = MessageFormatter::createHeartbeatMessage();
-    String payload;
-    serializeJson(doc, payload);
-    
-    return mqttClient.publish(MQTT_TOPIC_STATUS, 0, false, payload.c_str()) != 0;
+    return publishJson(MQTT_TOPIC_STATUS, 0, false, [this](JsonDocument& doc) {
+        MessageFormatter::addHeartbeatMessage(doc);
+        // Lowest free slot count and arena use since boot: the pool is sized right when neither reaches its limit
+        JsonObject pool = doc["mqttPool"].to<JsonObject>();
+        pool["min_free"] = messagePool.getMinFreeSlots();
+        pool["failed"] = messagePool.getFailedAcquires();
+        pool["arena_peak"] = messagePool.getArenaPeak();
+    });
 }
 
 // Getters & Setters
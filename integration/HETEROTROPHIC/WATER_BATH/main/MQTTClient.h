@@ -9,6 +9,7 @@
 #include "TaskManager.h"
 #include "SystemMonitor.h"
 #include "WiFiManager.h"
+#include "MQTTMessagePool.h"
 #include "config.h"
 
 class MQTTClient {
@@ -25,6 +26,8 @@ public:
     bool publishStatus(const String& status);
     bool publishHeartbeat();
 
+    const MQTTMessagePool& getMessagePool() const { return messagePool; }
+
     // Callback setters
     void onConnectionEstablished(std::function<void()> callback);
     void onConnectionLost(std::function<void()> callback);
@@ -32,18 +35,17 @@ public:
     void onError(std::function<void(const char* error)> callback);
 
 private:
-    struct MQTTMessage {
-        char topic[128];
-        char payload[1024];
-    };
-
     // MQTT client instance
     AsyncMqttClient mqttClient;
     
     // FreeRTOS resources
     TaskHandle_t reconnectTaskHandle;
     TaskHandle_t heartbeatTaskHandle;
-    QueueHandle_t messageQueue;
+    QueueHandle_t messageQueue;         // MQTTMessagePool::Message* received, released by the handler task
+
+    // Buffers of the received and published messages, no heap after begin()
+    MQTTMessagePool messagePool;
+    MQTTMessagePool::Message* receiving;    // Message whose next chunk is expected (AsyncMqttClient callback only)
     
     // State
     bool connected;
@@ -62,6 +64,10 @@ private:
                       AsyncMqttClientMessageProperties properties,
                       size_t len, size_t index, size_t total);
 
+    // Build the JSON with builder(JsonDocument&) into a pool message and publish it
+    template <typename Builder>
+    bool publishJson(const char* topic, uint8_t qos, bool retain, Builder builder);
+
     // Callbacks
     std::function<void()> connectionEstablishedCallback;
     std::function<void()> connectionLostCallback;
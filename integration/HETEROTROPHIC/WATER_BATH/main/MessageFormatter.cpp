@@ -4,34 +4,47 @@
 
 JsonDocument MessageFormatter::createSensorMessage(const SensorData& data) {
     JsonDocument doc;
-    
+    addSensorMessage(doc, data);
+    return doc;
+}
+
+JsonDocument MessageFormatter::createStatusMessage(const String& status) {
+    JsonDocument doc;
+    addStatusMessage(doc, status);
+    return doc;
+}
+
+JsonDocument MessageFormatter::createHeartbeatMessage() {
+    JsonDocument doc;
+    addHeartbeatMessage(doc);
+    return doc;
+}
+
+void MessageFormatter::addSensorMessage(JsonDocument& doc, const SensorData& data) {
     JsonObject sensorData = doc["sensorData"].to<JsonObject>();
     sensorData["waterTemp"] = data.waterTemp;
     
     addCommonFields(doc);
-    return doc;
 }
 
-JsonDocument MessageFormatter::createStatusMessage(const String& status) {
-    JsonDocument doc;
+void MessageFormatter::addStatusMessage(JsonDocument& doc, const String& status) {
     doc["status"] = status;
     doc["version"] = "1.0.0";
     
     addCommonFields(doc);
-    return doc;
 }
 
-JsonDocument MessageFormatter::createHeartbeatMessage() {
-    JsonDocument doc;
+void MessageFormatter::addHeartbeatMessage(JsonDocument& doc) {
     doc["type"] = "heartbeat";
     doc["uptime"] = millis() / 1000;
 
     auto system = doc["system"].to<JsonObject>();
     system["heap"] = ESP.getFreeHeap();
+    system["heap_min"] = ESP.getMinFreeHeap();
+    system["heap_max_block"] = ESP.getMaxAllocHeap();   // Falls below heap when the heap fragments
     system["wifi_strength"] = WiFi.RSSI();
 
     addCommonFields(doc);
-    return doc;
 }
 
 JsonDocument MessageFormatter::createErrorMessage(const String& error) {
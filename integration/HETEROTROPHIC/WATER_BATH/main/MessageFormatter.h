@@ -20,6 +20,11 @@ public:
     static JsonDocument createStatusMessage(const String& status);
     static JsonDocument createHeartbeatMessage();
     static JsonDocument createErrorMessage(const String& error);
+
+    // Same messages built into a caller's document (MQTTMessagePool arena)
+    static void addSensorMessage(JsonDocument& doc, const SensorData& data);
+    static void addStatusMessage(JsonDocument& doc, const String& status);
+    static void addHeartbeatMessage(JsonDocument& doc);
     
     static bool parseSensorCommand(const String& message, SensorData& data);
     static bool parseCommand(const String& message, String& command, JsonDocument& params);
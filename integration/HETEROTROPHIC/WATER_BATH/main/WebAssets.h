@@ -0,0 +1,69 @@
+// WebAssets.h
+// Generated by web/build_assets.py from web/style.css, web/app.js: do not edit
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+struct WebAsset {
+    const char* path;
+    const char* contentType;
+    const uint8_t* data;        // gzip
+    size_t length;
+    const char* etag;
+};
+
+// style.css: 708 bytes, 334 compressed
+static const uint8_t STYLE_CSS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x52, 0x5d, 0x6f, 0x83, 0x20,
+    0x14, 0x7d, 0xf7, 0x57, 0x90, 0x34, 0x4d, 0xb6, 0xa4, 0x34, 0x68, 0x67, 0xd2, 0xd0, 0xa7, 0x66,
+    0xc9, 0xfe, 0xc7, 0xb5, 0xa0, 0x90, 0xa1, 0x18, 0xc4, 0x6a, 0xb3, 0xec, 0xbf, 0x0f, 0x10, 0xb6,
+    0xba, 0x2f, 0xce, 0x8b, 0xde, 0x8f, 0x73, 0xce, 0xbd, 0x50, 0x69, 0x76, 0x43, 0x6f, 0x19, 0x72,
+    0xa7, 0xd6, 0x9d, 0xc5, 0x35, 0xb4, 0x52, 0xdd, 0x28, 0x3a, 0x1b, 0x09, 0xea, 0x14, 0xe2, 0x2d,
+    0x98, 0x46, 0x76, 0x14, 0x91, 0xe5, 0xb7, 0x07, 0xc6, 0x64, 0xd7, 0x50, 0x54, 0x90, 0x7e, 0x5e,
+    0x42, 0x15, 0x5c, 0x5e, 0x1b, 0xa3, 0xc7, 0x8e, 0x51, 0xb4, 0xc9, 0x0b, 0x8f, 0x25, 0x71, 0xd1,
+    0x4a, 0x1b, 0x17, 0xe3, 0xc4, 0xe3, 0x94, 0xbd, 0x67, 0xd9, 0xfe, 0x02, 0x86, 0x45, 0xc5, 0x75,
+    0x1f, 0xf7, 0x88, 0x84, 0xda, 0x30, 0x6e, 0xb0, 0x01, 0x26, 0xc7, 0x81, 0xa2, 0x63, 0x12, 0xfa,
+    0x45, 0x3b, 0xb9, 0xcb, 0xcb, 0x7e, 0x4e, 0x16, 0x2b, 0x3d, 0xe3, 0x41, 0x00, 0xd3, 0x93, 0x73,
+    0x8d, 0x0a, 0x97, 0xf0, 0x49, 0xd3, 0x54, 0xf0, 0x40, 0x76, 0x01, 0xfb, 0xf2, 0x31, 0xb8, 0x11,
+    0xf9, 0x0e, 0x89, 0x22, 0xda, 0x49, 0x6e, 0xeb, 0x70, 0xee, 0xe9, 0x71, 0xa5, 0xad, 0xd5, 0x6d,
+    0xd2, 0x75, 0x8d, 0x16, 0x2a, 0xc5, 0x63, 0xdf, 0x24, 0x99, 0x15, 0xce, 0x01, 0x21, 0xdb, 0x95,
+    0x7d, 0xc7, 0xa7, 0xa0, 0x1f, 0x38, 0x45, 0xe9, 0xeb, 0x9b, 0x65, 0xb2, 0x58, 0xf6, 0x74, 0x62,
+    0x87, 0x6c, 0x5a, 0xcb, 0xe7, 0x94, 0x79, 0x91, 0xa6, 0xb4, 0x7c, 0xb6, 0x18, 0x94, 0x6c, 0x5c,
+    0x9b, 0xe2, 0xb5, 0x5d, 0xe9, 0x24, 0x73, 0xb9, 0xa3, 0x1b, 0xb4, 0x92, 0x0c, 0x6d, 0x0e, 0x87,
+    0x43, 0xe4, 0xfd, 0xb1, 0x6a, 0x9c, 0xc6, 0x2c, 0x98, 0xc7, 0xe9, 0xcf, 0xd1, 0xc3, 0x7b, 0x98,
+    0xb8, 0x6c, 0x84, 0xa5, 0x4e, 0x4a, 0xb1, 0xe5, 0xfe, 0xae, 0xa0, 0x46, 0x7e, 0xff, 0x64, 0xd6,
+    0x25, 0xf7, 0x6c, 0x4f, 0xcf, 0xe7, 0x97, 0x32, 0x0e, 0x68, 0xa8, 0xd0, 0x57, 0x6e, 0xfe, 0xb1,
+    0x53, 0x7a, 0x84, 0xe2, 0x3e, 0x56, 0xa5, 0x45, 0x1d, 0xbf, 0xae, 0x56, 0xc9, 0x8e, 0x63, 0x11,
+    0x15, 0xf3, 0x7d, 0xa8, 0xff, 0x00, 0x49, 0x95, 0x79, 0x4f, 0xc4, 0x02, 0x00, 0x00,
+};
+
+// app.js: 438 bytes, 276 compressed
+static const uint8_t APP_JS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x90, 0xcb, 0x4e, 0xc3, 0x30,
+    0x10, 0x45, 0xf7, 0xfe, 0x8a, 0x51, 0x85, 0x88, 0x2d, 0xa1, 0x38, 0x2c, 0xd8, 0x90, 0xc7, 0x82,
+    0x97, 0xa8, 0x54, 0x76, 0x95, 0xd8, 0xd6, 0xc4, 0x93, 0xc6, 0x28, 0xb5, 0xad, 0xd8, 0x29, 0xa0,
+    0x28, 0xff, 0x8e, 0x5d, 0xd4, 0xd0, 0xb2, 0xe1, 0xae, 0xc6, 0xa3, 0x33, 0x77, 0xae, 0x87, 0x73,
+    0x58, 0xa9, 0x3d, 0xc2, 0x5e, 0x74, 0x03, 0x3a, 0x30, 0x0d, 0xf8, 0x16, 0x41, 0x0a, 0xd7, 0xbe,
+    0x19, 0xd1, 0x4b, 0xa0, 0x5c, 0x58, 0xc5, 0xbb, 0x80, 0x30, 0x42, 0x9a, 0x41, 0xd7, 0x5e, 0x19,
+    0x0d, 0x83, 0x95, 0xc2, 0xe3, 0x83, 0xf0, 0x82, 0x32, 0x18, 0x09, 0x04, 0x35, 0xe8, 0xeb, 0x96,
+    0x26, 0x33, 0x9e, 0xb0, 0x43, 0x3b, 0x2a, 0x0d, 0x96, 0x9a, 0xf6, 0xe8, 0xac, 0xd1, 0x0e, 0xa1,
+    0xac, 0xe0, 0x58, 0xa7, 0xef, 0xce, 0x68, 0xca, 0xfe, 0xa2, 0xc1, 0x5c, 0x44, 0x6c, 0x9c, 0xfb,
+    0x51, 0xd2, 0xd4, 0xc3, 0x0e, 0xb5, 0x4f, 0xb7, 0xe8, 0x1f, 0x3b, 0x8c, 0xe5, 0xdd, 0xd7, 0x52,
+    0xd2, 0x24, 0xe2, 0x09, 0x4b, 0x95, 0xd6, 0xd8, 0x3f, 0xaf, 0x5f, 0x56, 0x50, 0xc2, 0xe6, 0x6c,
+    0x32, 0xaa, 0xb0, 0xd5, 0x6b, 0xc8, 0xdc, 0xc3, 0x1a, 0x77, 0xf6, 0x16, 0x0a, 0x67, 0x85, 0x86,
+    0xba, 0x13, 0xce, 0x95, 0x8b, 0xc3, 0xe7, 0x17, 0xd5, 0xc5, 0x18, 0x9d, 0xd2, 0x8f, 0x88, 0x45,
+    0x2a, 0xf5, 0xe6, 0x49, 0x7d, 0xa2, 0xa4, 0xd7, 0x6c, 0xba, 0x94, 0xb8, 0xcd, 0xef, 0x0b, 0x1e,
+    0xc7, 0xaa, 0x82, 0xdb, 0xea, 0x6c, 0xc1, 0x26, 0x9f, 0x9f, 0x13, 0xcb, 0xc9, 0x44, 0x88, 0x6a,
+    0x80, 0xfe, 0x13, 0xf8, 0x78, 0x39, 0x87, 0x7e, 0xa9, 0xc3, 0xca, 0x90, 0x82, 0xfe, 0x1e, 0xf6,
+    0x0a, 0x6e, 0xb2, 0x2c, 0x63, 0x3f, 0xc6, 0xa7, 0xf7, 0x8e, 0xf6, 0xdf, 0x9a, 0x50, 0x32, 0x5d,
+    0xb6, 0x01, 0x00, 0x00,
+};
+
+static const WebAsset WEB_ASSETS[] = {
+    {"/style.css", "text/css", STYLE_CSS_GZ, sizeof(STYLE_CSS_GZ), "\"00b405baa4c77417\""},
+    {"/app.js", "application/javascript", APP_JS_GZ, sizeof(APP_JS_GZ), "\"958703b12b6cbe41\""},
+};
+static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
+
+#endif // WEB_ASSETS_H
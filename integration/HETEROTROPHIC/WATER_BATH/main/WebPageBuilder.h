@@ -5,17 +5,18 @@
 #include <Arduino.h>
 #include "MessageFormatter.h"
 
+/*
+ * Pages are written piece by piece to a Print (ChunkedResponse) instead of being built in a String.
+ * Style and script are the static /style.css and /app.js (WebAssets.h, sources in ../web).
+ */
 class WebPageBuilder {
 public:
-    static String buildIndexPage(const String& deviceInfo);
-    static String buildDataPage(const SensorData& data);
-    static String buildConfigPage();
+    static void writeIndexPage(Print& out, const String& deviceInfo);
+    static void writeDataPage(Print& out, const SensorData& data);
     
 private:
-    static String getHeader(const String& title);
-    static String getFooter();
-    static String getStyle();
-    static String getScript();
+    static void writeHeader(Print& out, const char* title);
+    static void writeFooter(Print& out);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,5 +1,7 @@
 // WebServerManager.cpp
 #include "WebServerManager.h"
+#include "ChunkedResponse.h"
+#include "WebAssets.h"      // Only included here: the PROGMEM arrays are defined in the header
 
 WebServerManager::WebServerManager(DataProvider& provider) 
     : server(80)
@@ -163,16 +165,46 @@ void WebServerManager::setupOTA() {
     Logger::log(Logger::INFO, "OTA setup completed");
 }
 
+// Precompressed static file: a browser that has the current version gets a 304 without body
+void WebServerManager::serveAsset(const WebAsset& asset) {
+    server.sendHeader("ETag", asset.etag);
+    server.sendHeader("Cache-Control", "no-cache");     // Always revalidated: a new firmware changes the ETag
+    if (server.header("If-None-Match") == asset.etag) {
+        server.send(304);
+        return;
+    }
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, asset.contentType, reinterpret_cast<PGM_P>(asset.data), asset.length);
+}
+
 void WebServerManager::setupRoutes() {
+    static const char* headerKeys[] = {"If-None-Match"};
+    server.collectHeaders(headerKeys, 1);
+
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        const WebAsset* asset = &WEB_ASSETS[i];
+        server.on(asset->path, HTTP_GET, [this, asset]() {
+            serveAsset(*asset);
+        });
+    }
+
     server.on("/", HTTP_GET, [this]() {
-        String html = WebPageBuilder::buildIndexPage(dataProvider.getDeviceInfo());
-        server.send(200, "text/html", html);
+        ChunkedResponse page(server, 200, "text/html");
+        WebPageBuilder::writeIndexPage(page, dataProvider.getDeviceInfo());
     });
     
     server.on("/data", HTTP_GET, [this]() {
-        SensorData data = dataProvider.getLatestSensorData();
-        String html = WebPageBuilder::buildDataPage(data);
-        server.send(200, "text/html", html);
+        ChunkedResponse page(server, 200, "text/html");
+        WebPageBuilder::writeDataPage(page, dataProvider.getLatestSensorData());
+    });
+
+    server.on("/api/live", HTTP_GET, [this]() {
+        char json[64];
+        if (APIHandler::writeLiveData(json, sizeof(json), dataProvider.getLatestSensorData()) == 0) {
+            server.send(500, "text/plain", "Live data too large");
+            return;
+        }
+        server.send(200, "application/json", json);
     });
     
     server.on("/api/data", HTTP_GET, [this]() {
@@ -194,7 +226,7 @@ void WebServerManager::handle() {
 
 void WebServerManager::serverTask(void* parameter) {
     WebServerManager* manager = static_cast<WebServerManager*>(parameter);
-    const TickType_t xDelay = pdMS_TO_TICKS(10);
+    const TickType_t xDelay = pdMS_TO_TICKS(TASK_INTERVAL_WEBSERVER);
     
     while (true) {
         manager->handle();
@@ -11,6 +11,8 @@
 #include "WebPageBuilder.h"
 #include "APIHandler.h"
 
+struct WebAsset;
+
 class WebServerManager {
 public:
     explicit WebServerManager(DataProvider& dataProvider);
@@ -29,6 +31,7 @@ private:
     
     void setupOTA();
     void setupRoutes();
+    void serveAsset(const WebAsset& asset);
     static void serverTask(void* parameter);
 };
 
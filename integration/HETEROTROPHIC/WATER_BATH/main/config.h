@@ -11,6 +11,7 @@
 // OTA
 static const char* ALLOWED_IP = "192.168.1.122";  // La seule adresse IP autorisé à téléversé sur l'ESP32
 #define STACK_SIZE_WEBSERVER 8192  // Augmenter la taille de 4096 à 8192
+#define TASK_INTERVAL_WEBSERVER 2       // ms between two WebServer::handleClient(), one request served per call
 
 // MQTT Configuration
 #define MQTT_BROKER "192.168.1.25" // Adress du serveur
@@ -45,7 +46,7 @@ static const char* ALLOWED_IP = "192.168.1.122";  // La seule adresse IP autoris
 
 // Buffer Sizes
 #define JSON_BUFFER_SIZE 1024  
-#define MQTT_QUEUE_SIZE 20
+#define MQTT_POOL_SIZE 6       // MQTTMessagePool slots: received messages waiting for the handler + publishes in progress
 
 //
 #define MQTT_MAX_RETRIES 5
@@ -0,0 +1,16 @@
+// Live values of the dashboard (/api/live)
+
+function updateData() {
+    fetch('/api/live')
+        .then(response => response.json())
+        .then(data => {
+            document.getElementById('data').innerHTML = `
+                <p>Water Temp: <span class="value">${data.waterTemp.toFixed(1)}&deg;C</span></p>
+            `;
+        });
+}
+
+if (document.getElementById('data')) {
+    setInterval(updateData, 5000);
+    updateData();
+}
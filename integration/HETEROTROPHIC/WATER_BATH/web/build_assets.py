@@ -0,0 +1,83 @@
+"""
+Compress the static files of the web interface into WebAssets.h (gzip, PROGMEM).
+
+The pages only reference /style.css and /app.js: they are served compressed with an ETag, and a browser that
+already has them gets a 304 without body (WebServerManager::serveAsset()). Run again after editing a file of
+this folder and commit the generated header with it.
+
+Usage:
+    python build_assets.py --output ../main/WebAssets.h style.css app.js
+"""
+import argparse
+import gzip
+import hashlib
+import os
+import re
+
+CONTENT_TYPES = {
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".html": "text/html",
+    ".svg": "image/svg+xml",
+}
+
+
+def symbol(name):
+    return re.sub(r"[^A-Za-z0-9]", "_", name).upper() + "_GZ"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+")
+    parser.add_argument("--output", required=True)
+    args = parser.parse_args()
+
+    lines = [
+        "// WebAssets.h",
+        "// Generated by web/build_assets.py from web/" + ", web/".join(os.path.basename(f) for f in args.files)
+        + ": do not edit",
+        "#ifndef WEB_ASSETS_H",
+        "#define WEB_ASSETS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "struct WebAsset {",
+        "    const char* path;",
+        "    const char* contentType;",
+        "    const uint8_t* data;        // gzip",
+        "    size_t length;",
+        "    const char* etag;",
+        "};",
+        "",
+    ]
+    entries = []
+    for path in args.files:
+        name = os.path.basename(path)
+        with open(path, "rb") as f:
+            source = f.read()
+        data = gzip.compress(source, compresslevel=9, mtime=0)  # Same bytes, same ETag, for the same source
+        etag = '"' + hashlib.sha1(source).hexdigest()[:16] + '"'
+
+        lines.append("// %s: %d bytes, %d compressed" % (name, len(source), len(data)))
+        lines.append("static const uint8_t %s[] PROGMEM = {" % symbol(name))
+        for i in range(0, len(data), 16):
+            lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+        entries.append('    {"/%s", "%s", %s, sizeof(%s), "%s"},' % (
+            name, CONTENT_TYPES[os.path.splitext(name)[1]], symbol(name), symbol(name), etag.replace('"', '\\"')))
+
+    lines.append("static const WebAsset WEB_ASSETS[] = {")
+    lines.extend(entries)
+    lines.append("};")
+    lines.append("static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    lines.append("")
+    lines.append("#endif // WEB_ASSETS_H")
+
+    with open(args.output, "w", newline="\n") as f:
+        f.write("\n".join(lines) + "\n")
+    print("%s: %d assets" % (args.output, len(args.files)))
+
+
+if __name__ == "__main__":
+    main()
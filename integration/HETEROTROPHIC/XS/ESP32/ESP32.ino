@@ -23,7 +23,12 @@
  * - The ESP32 connects to the WiFi network.
  * - It connects to a WebSocket server on the Raspberry Pi to receive commands.
  * - When a command is received, it sends the corresponding command to the Teensy via Serial2.
- * - When data is received from the Teensy, it sends it to the web server using an HTTP POST request.
+ * - Data received from the Teensy is published on MQTT and handed to the uplink task, which queues it in flash
+ *   (LittleFS) and sends it to the web server in batches (HTTP POST on a kept-alive connection) whenever the
+ *   server can be reached, so an outage leaves no gap and the UART is never left unread during a POST.
+ * - Every 10 seconds the uplink state (queue depths, POST latency) is published on the MQTT status topic.
+ * - Binary frames are published on MQTT in batches, delta-encoded (see TelemetryBatch.h). The command
+ *   {"command":"telemetryFormat","params":{"format":"json"}} on the command topic goes back to one JSON per sample.
  * 
  * Software Setup:
  * - Install the ESP32 Board in Arduino IDE:
@@ -83,7 +88,13 @@ const char* MQTT_SENSOR_TOPIC = "bioreactor/sensors";
 #include <HTTPClient.h>
 #include <AsyncMqttClient.h> //MQTT   https://github.com/marvinroger/async-mqtt-client
 #include <ezTime.h>
+#include <LittleFS.h>
+#include <atomic>
 #include "config.h"
+#include "TelemetryProtocol.h"
+#include "SerialLineReader.h"
+#include "TelemetryQueue.h"
+#include "TelemetryBatch.h"
 
 // Define the pins for Serial2 communication with the Teensy
 const int rxPin = 12;
@@ -97,6 +108,112 @@ TimerHandle_t wifiReconnectTimer;
 // Time management
 Timezone myTZ;
 
+// Binary telemetry frames from the Teensy (see TelemetryProtocol.h)
+TelemetryProtocol::FrameReader frameReader;
+
+// Text lines from the Teensy, assembled without blocking from the Serial2 receive buffer
+SerialLineReader<TelemetryProtocol::MAX_TEXT_LINE_LENGTH + 1> teensyReader(Serial2);
+
+// Serial2 baud rate negotiation with the Teensy (see Communication.h on the Teensy side)
+const unsigned long LINK_DEFAULT_BAUD = 9600;
+const unsigned long LINK_BAUD_CANDIDATES[] = { 460800, 115200 };
+const int LINK_CANDIDATE_COUNT = sizeof(LINK_BAUD_CANDIDATES) / sizeof(LINK_BAUD_CANDIDATES[0]);
+const unsigned long LINK_REQUEST_INTERVAL = 2500;   // Between two "LINK:BAUD" requests (longer than the Teensy confirm timeout)
+const int LINK_MAX_REQUESTS = 3;                    // Requests sent for a candidate before trying the next one
+const unsigned long LINK_CONFIRM_TIMEOUT = 1500;    // Time allowed for the first PONG after switching
+const unsigned long LINK_CONFIRM_PING_INTERVAL = 200; // Between two PINGs while waiting for that PONG
+const unsigned long LINK_PING_INTERVAL = 10000;     // Keep-alive, must stay well below the Teensy idle timeout
+const int LINK_MAX_MISSED_PONGS = 3;
+const unsigned long LINK_RETRY_INTERVAL = 60000;    // Retry the negotiation when stuck at the default baud rate
+
+enum class LinkState { NEGOTIATING, CONFIRMING, LINKED };
+LinkState linkState = LinkState::NEGOTIATING;
+unsigned long linkBaud = LINK_DEFAULT_BAUD;
+int linkCandidate = 0;
+int linkRequests = 0;
+int linkMissedPongs = 0;
+unsigned long linkTimer = 0;
+unsigned long linkLastPing = 0;
+
+// Store-and-forward of the Teensy data to the web server (see TelemetryQueue.h)
+const char* const SENSOR_DATA_BATCH_URL = "http://192.168.1.25:8000/sensor_data/batch";
+const size_t QUEUE_MAX_BYTES = 1024 * 1024;         // Must fit in the LittleFS partition (Partition Scheme)
+const size_t QUEUE_SEGMENT_SIZE = 16 * 1024;
+
+// Uplink task: the only user of the flash queue and of the HTTP connection
+const int UPLINK_HANDOFF_LENGTH = 16;               // Messages waiting for the uplink task (1 kB of RAM each)
+const unsigned long UPLINK_HANDOFF_TIMEOUT = 50;    // Longest wait of loop() for room in the handoff queue, ms
+const int UPLINK_BATCH_SIZE = 20;                   // Queued messages per POST
+const unsigned long UPLINK_FLUSH_INTERVAL = 1000;   // Longest wait for a batch to fill up before it is sent, ms
+const unsigned long UPLINK_MIN_BACKOFF = 1000;      // Retry delay after a failed POST, doubled up to the maximum
+const unsigned long UPLINK_MAX_BACKOFF = 60000;
+const uint16_t UPLINK_HTTP_TIMEOUT = 3000;          // ms
+const uint32_t UPLINK_STACK_SIZE = 8192;
+const UBaseType_t UPLINK_PRIORITY = 1;
+const BaseType_t UPLINK_CORE = 0;                   // loop() and the UART run on core 1
+
+struct UplinkMessage {
+    uint8_t type;                                   // TelemetryQueue::TYPE_TEXT or TYPE_FRAME
+    uint32_t time;
+    uint16_t length;
+    uint8_t data[TelemetryQueue::MAX_RECORD_SIZE];
+};
+static_assert(TelemetryQueue::MAX_RECORD_SIZE >= TelemetryProtocol::MAX_TEXT_LINE_LENGTH,
+              "A text line from the Teensy must fit in a queue record");
+
+// Written by the uplink task, published by loop()
+struct UplinkStatistics {
+    volatile uint32_t posts;
+    volatile uint32_t failures;
+    volatile uint32_t messagesSent;
+    volatile uint32_t handoffDropped;               // Handoff queue full
+    volatile uint32_t lastLatency;                  // ms, last POST
+    volatile uint32_t maxLatency;                   // ms, since the last status
+    volatile uint32_t totalLatency;                 // ms, all POSTs
+};
+
+// Outcome of a POST of queued messages
+enum class BatchResult {
+    COMMITTED,   // Accepted by the server (or nothing to send), removed from the queue
+    DROPPED,     // Refused for good by the server, removed from the queue
+    TOO_LARGE,   // HTTP 413: still queued, to be sent again in smaller batches
+    FAILED       // No answer or temporary error: still queued, to be sent again after a backoff
+};
+
+TelemetryQueue telemetryQueue;
+QueueHandle_t uplinkHandoff = nullptr;
+TaskHandle_t uplinkTaskHandle = nullptr;
+UplinkStatistics uplinkStatistics = {};
+uint8_t uplinkStorage[UPLINK_BATCH_SIZE * 256];     // Queued messages of the batch being sent
+
+// Batched MQTT telemetry of the binary frames (see TelemetryBatch.h)
+const char* const MQTT_SENSOR_BATCH_TOPIC = "bioreactor/sensors/batch";
+const uint8_t TELEMETRY_SCHEMA = 2;                 // XS bioreactor, see telemetry_batch.py on the server
+const uint8_t TELEMETRY_CHANNELS = 1 + 7 + 1 + TelemetryProtocol::ACTUATOR_COUNT + TelemetryProtocol::VOLUME_COUNT;
+const uint8_t TELEMETRY_BATCH_SIZE = 15;            // Samples per publish
+const uint8_t TELEMETRY_KEYFRAME_INTERVAL = 10;     // Batches
+const unsigned long TELEMETRY_BATCH_MAX_AGE = 15000; // Longest wait of the first sample of a batch, ms
+
+TelemetryBatch telemetryBatch(TELEMETRY_SCHEMA, TELEMETRY_CHANNELS, TELEMETRY_BATCH_SIZE, TELEMETRY_KEYFRAME_INTERVAL);
+// Written by the MQTT callbacks, applied by loop() which alone builds the batches
+std::atomic<bool> telemetryBatchMode(true);         // false: one JSON per sample on MQTT_SENSOR_TOPIC
+std::atomic<bool> telemetryKeyframeRequested(false);
+unsigned long telemetryBatchStart = 0;
+
+// Key names of the binary frame actuators, same order as ActuatorId on the Teensy
+const char* const ACTUATOR_NAMES[TelemetryProtocol::ACTUATOR_COUNT] = {
+    "airPump", "drainPump", "samplePump", "nutrientPump", "basePump",
+    "fillPump", "stirringMotor", "heatingPlate", "ledGrowLight"
+};
+const char* const ACTUATOR_VALUE_NAMES[TelemetryProtocol::ACTUATOR_COUNT] = {
+    "airPumpValue", "drainPumpValue", "samplePumpValue", "nutrientPumpValue", "basePumpValue",
+    "fillPumpValue", "stirringMotorValue", "heatingPlateValue", "ledGrowLightValue"
+};
+const char* const ACTUATOR_REMAINING_NAMES[TelemetryProtocol::ACTUATOR_COUNT] = {
+    "airPumpRemaining", "drainPumpRemaining", "samplePumpRemaining", "nutrientPumpRemaining", "basePumpRemaining",
+    "fillPumpRemaining", "stirringMotorRemaining", "heatingPlateRemaining", "ledGrowLightRemaining"
+};
+
 void printMqttDisconnectReason(AsyncMqttClientDisconnectReason reason) {
     const char* reasonString;
     switch (static_cast<uint8_t>(reason)) {
@@ -146,6 +263,9 @@ void onMqttConnect(bool sessionPresent) {
     uint16_t packetIdSub = mqttClient.subscribe(MQTT_COMMAND_TOPIC, 2);
     Serial.printf("Subscribing to %s at QoS 2, packetId: %d\n", MQTT_COMMAND_TOPIC, packetIdSub);
     
+    // New subscribers can decode from the first batch
+    telemetryKeyframeRequested = true;
+
     // Publish connection status
     String status = "{\"device\":\"ESP32\",\"status\":\"connected\",\"ip\":\"" + WiFi.localIP().toString() + "\"}";
     mqttClient.publish(MQTT_STATUS_TOPIC, 0, true, status.c_str());
@@ -165,6 +285,8 @@ void onMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProperties
     Serial.println(message);
 
     if (String(topic) == MQTT_COMMAND_TOPIC) {
+        if (handleBridgeCommand(message)) return;
+
         // Forward command to Teensy
         Serial.println("Forwarding command to Teensy:");
         Serial.println(message);
@@ -172,19 +294,146 @@ void onMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProperties
     }
 }
 
+// Commands for the bridge itself, the others go to the Teensy
+bool handleBridgeCommand(const String& message) {
+    if (!message.startsWith("{")) return false;
+    JsonDocument doc;
+    if (deserializeJson(doc, message) || doc["command"].as<String>() != "telemetryFormat") return false;
+
+    String format = doc["params"]["format"].as<String>();
+    if (format == "json" || format == "batch") {
+        telemetryBatchMode = (format == "batch");
+        Serial.println("MQTT telemetry format: " + format);
+    } else {
+        Serial.println("Unknown telemetry format: " + format);
+    }
+    return true;
+}
+
 void onMqttPublish(uint16_t packetId) {
     Serial.printf("Publish acknowledged, packetId: %d\n", packetId);
 }
 
+void setLinkBaud(unsigned long baud) {
+    Serial2.flush();
+    Serial2.updateBaudRate(baud);
+    teensyReader.clear();
+    frameReader.reset();
+    linkBaud = baud;
+}
+
+void startLinkNegotiation() {
+    setLinkBaud(LINK_DEFAULT_BAUD);
+    linkState = LinkState::NEGOTIATING;
+    linkCandidate = 0;
+    linkRequests = 0;
+    linkTimer = millis() - LINK_REQUEST_INTERVAL; // First request right away
+}
+
+// Give up the current candidate and go back to the default baud rate to try the next one
+void nextLinkCandidate() {
+    setLinkBaud(LINK_DEFAULT_BAUD);
+    linkState = LinkState::NEGOTIATING;
+    linkCandidate++;
+    linkRequests = 0;
+    linkTimer = millis();
+}
+
+void updateLink() {
+    unsigned long now = millis();
+    switch (linkState) {
+        case LinkState::NEGOTIATING:
+            if (linkCandidate >= LINK_CANDIDATE_COUNT) {
+                Serial.printf("Teensy link stays at %lu baud\n", LINK_DEFAULT_BAUD);
+                linkState = LinkState::LINKED;
+                linkTimer = now;
+            } else if (now - linkTimer >= LINK_REQUEST_INTERVAL) {
+                if (linkRequests >= LINK_MAX_REQUESTS) {
+                    nextLinkCandidate();
+                } else {
+                    Serial2.println("LINK:BAUD:" + String(LINK_BAUD_CANDIDATES[linkCandidate]));
+                    linkRequests++;
+                    linkTimer = now;
+                }
+            }
+            break;
+        case LinkState::CONFIRMING:
+            if (now - linkTimer >= LINK_CONFIRM_TIMEOUT) {
+                Serial.printf("No answer from Teensy at %lu baud\n", linkBaud);
+                nextLinkCandidate();
+            } else if (now - linkLastPing >= LINK_CONFIRM_PING_INTERVAL) {
+                Serial2.println("LINK:PING");
+                linkLastPing = now;
+            }
+            break;
+        case LinkState::LINKED:
+            if (linkBaud == LINK_DEFAULT_BAUD) {
+                if (now - linkTimer >= LINK_RETRY_INTERVAL) {
+                    startLinkNegotiation();
+                }
+            } else if (now - linkTimer >= LINK_PING_INTERVAL) {
+                if (linkMissedPongs >= LINK_MAX_MISSED_PONGS) {
+                    Serial.println("Teensy link lost, negotiating again");
+                    startLinkNegotiation();
+                } else {
+                    Serial2.println("LINK:PING");
+                    linkMissedPongs++;
+                    linkTimer = now;
+                }
+            }
+            break;
+    }
+}
+
+// Link control messages from the Teensy are handled here and never forwarded
+bool handleLinkMessage(const String& message) {
+    if (!message.startsWith("LINK:")) {
+        return false;
+    }
+
+    if (message.startsWith("LINK:BAUD_OK:") && linkState == LinkState::NEGOTIATING) {
+        unsigned long baud = message.substring(13).toInt();
+        if (linkCandidate < LINK_CANDIDATE_COUNT && baud == LINK_BAUD_CANDIDATES[linkCandidate]) {
+            setLinkBaud(baud);
+            linkState = LinkState::CONFIRMING;
+            linkTimer = millis();
+            linkLastPing = linkTimer - LINK_CONFIRM_PING_INTERVAL; // First PING right away
+        }
+    } else if (message.startsWith("LINK:BAUD_REFUSED:") && linkState == LinkState::NEGOTIATING) {
+        nextLinkCandidate();
+    } else if (message == "LINK:PONG") {
+        if (linkState == LinkState::CONFIRMING) {
+            Serial.printf("Teensy link running at %lu baud\n", linkBaud);
+            linkState = LinkState::LINKED;
+            linkTimer = millis();
+        }
+        linkMissedPongs = 0;
+    }
+    return true;
+}
+
 void setup() {
     Serial.begin(115200);
     delay(3000);
     Serial.println("ESP32 Ready");
 
-    // Setup Serial2 communication with Teensy
-    Serial2.begin(9600, SERIAL_8N1, rxPin, txPin);
-    Serial2.setRxBufferSize(256);
+    // Setup Serial2 communication with Teensy (the RX buffer size must be set before begin)
+    Serial2.setRxBufferSize(8192);
+    Serial2.begin(LINK_DEFAULT_BAUD, SERIAL_8N1, rxPin, txPin);
     Serial2.setTimeout(500);
+
+    // Data not sent before the last reset is still queued
+    if (!LittleFS.begin(true) || !telemetryQueue.begin(LittleFS, "/queue", QUEUE_MAX_BYTES, QUEUE_SEGMENT_SIZE)) {
+        Serial.println("Telemetry queue unavailable, data received during an outage will be lost");
+    } else {
+        Serial.printf("Telemetry queue: %u messages waiting\n", telemetryQueue.getPendingRecords());
+    }
+    uplinkHandoff = xQueueCreate(UPLINK_HANDOFF_LENGTH, sizeof(UplinkMessage));
+    if (uplinkHandoff == nullptr ||
+        xTaskCreatePinnedToCore(uplinkTask, "uplink", UPLINK_STACK_SIZE, nullptr, UPLINK_PRIORITY,
+                                &uplinkTaskHandle, UPLINK_CORE) != pdPASS) {
+        Serial.println("Failed to create the uplink task, no data will reach the web server");
+    }
     
     // Create timers for reconnection
     mqttReconnectTimer = xTimerCreate("mqttTimer", pdMS_TO_TICKS(2000), pdFALSE, (void*)0, 
@@ -218,56 +467,350 @@ void setup() {
     // Initial connection
     connectToWifi();
     
-    // Setup time
-    waitForSync();
+    // Setup time, without waiting forever when the network is down (messages are then queued without time)
+    waitForSync(10);
     myTZ.setLocation(F("Europe/Paris"));
+
+    startLinkNegotiation();
+}
+
+// UTC time to store with a received message, 0 until the clock has been set
+uint32_t receptionTime() {
+    return timeStatus() == timeSet ? UTC.now() : 0;
+}
+
+// Body sent to the web server for one message, "epoch" keeps the reception time of queued messages
+String buildServerMessage(const String& message, uint32_t time) {
+    String timestamp = time ? myTZ.dateTime(time, UTC_TIME, "H:i:s") : myTZ.dateTime("H:i:s");
+    return "{\"arduino_value\":" + message + ",\"timestamp\":\"" + timestamp + "\",\"epoch\":" + String(time) + "}";
+}
+
+// Give a message to the uplink task, which queues it in flash
+void handOffToUplink(uint8_t type, uint32_t time, const uint8_t* data, size_t length) {
+    static UplinkMessage message; // Too large for the loop() stack
+    if (uplinkHandoff == nullptr || length > sizeof(message.data)) {
+        uplinkStatistics.handoffDropped++;
+        return;
+    }
+    message.type = type;
+    message.time = time;
+    message.length = length;
+    memcpy(message.data, data, length);
+    if (xQueueSend(uplinkHandoff, &message, pdMS_TO_TICKS(UPLINK_HANDOFF_TIMEOUT)) != pdTRUE) {
+        uplinkStatistics.handoffDropped++;
+    }
+}
+
+// Send a message from the Teensy to the web server (through the uplink task) and publish it on MQTT
+void forwardTeensyMessage(const String& message) {
+    Serial.print("Received from Teensy: ");
+    Serial.println(message);
+
+    uint32_t time = receptionTime();
+    // Profiler results ("profile telemetry on") are live diagnostics: MQTT only, the server does not store them
+    if (message.startsWith("{\"profile\":")) {
+        if (mqttClient.connected()) {
+            mqttClient.publish(MQTT_SENSOR_TOPIC, 0, false, buildServerMessage(message, time).c_str());
+        }
+        return;
+    }
+    handOffToUplink(TelemetryQueue::TYPE_TEXT, time, reinterpret_cast<const uint8_t*>(message.c_str()), message.length());
+
+    // MQTT only carries live data
+    if (mqttClient.connected()) {
+        mqttClient.publish(MQTT_SENSOR_TOPIC, 0, false, buildServerMessage(message, time).c_str());
+        Serial.println("Data sent to MQTT");
+    }
+}
+
+// Expand a binary frame to the JSON sent by the Teensy in text mode, so the server sees no difference
+String expandAllData(const TelemetryProtocol::AllDataFrame& frame) {
+    JsonDocument doc;
+
+    doc["currentProgram"] = frame.currentProgram;
+    doc["programState"] = frame.programState;
+
+    JsonObject sensorData = doc["sensorData"].to<JsonObject>();
+    sensorData["waterTemp"] = frame.waterTemp;
+    sensorData["airTemp"] = frame.airTemp;
+    sensorData["elecTemp"] = frame.elecTemp;
+    sensorData["pH"] = frame.pH;
+    sensorData["turbidity"] = frame.turbidity;
+    sensorData["oxygen"] = frame.oxygen;
+    sensorData["airFlow"] = frame.airFlow;
+
+    JsonObject actuatorData = doc["actuatorData"].to<JsonObject>();
+    for (uint8_t i = 0; i < TelemetryProtocol::ACTUATOR_COUNT; i++) {
+        actuatorData[ACTUATOR_NAMES[i]] = (frame.actuatorRunning & (1 << i)) != 0;
+    }
+
+    JsonObject actuatorSetpoints = doc["actuatorSetpoints"].to<JsonObject>();
+    for (uint8_t i = 0; i < TelemetryProtocol::ACTUATOR_COUNT; i++) {
+        actuatorSetpoints[ACTUATOR_VALUE_NAMES[i]] = frame.actuatorValues[i];
+    }
+
+    JsonObject actuatorTimers = doc["actuatorTimers"].to<JsonObject>();
+    for (uint8_t i = 0; i < TelemetryProtocol::ACTUATOR_COUNT; i++) {
+        actuatorTimers[ACTUATOR_REMAINING_NAMES[i]] = frame.actuatorRemaining[i];
+    }
+
+    JsonObject volumeData = doc["volumeData"].to<JsonObject>();
+    volumeData["currentVolume"] = frame.currentVolume;
+    volumeData["availableVolume"] = frame.availableVolume;
+    volumeData["addedNaOH"] = frame.addedNaOH;
+    volumeData["addedNutrient"] = frame.addedNutrient;
+    volumeData["addedMicroalgae"] = frame.addedMicroalgae;
+    volumeData["removedVolume"] = frame.removedVolume;
+
+    String output;
+    serializeJson(doc, output);
+    return output;
+}
+
+// Publish the batch being built; when it cannot be, the next batch starts with a keyframe
+void publishTelemetryBatch() {
+    if (telemetryBatch.isEmpty()) return;
+    if (!mqttClient.connected() ||
+        mqttClient.publish(MQTT_SENSOR_BATCH_TOPIC, 0, false, reinterpret_cast<const char*>(telemetryBatch.data()),
+                           telemetryBatch.length()) == 0) {
+        telemetryBatch.requestKeyframe();
+    }
+    telemetryBatch.next();
+}
+
+void addToTelemetryBatch(const TelemetryProtocol::AllDataFrame& frame, uint32_t time) {
+    if (telemetryKeyframeRequested.exchange(false)) {
+        telemetryBatch.requestKeyframe();
+    }
+    // A batch carries a single program name
+    if (!telemetryBatch.isEmpty() && telemetryBatch.getLabel() != frame.currentProgram) {
+        publishTelemetryBatch();
+    }
+    telemetryBatch.setLabel(frame.currentProgram);
+
+    // Channel order and scales of schema 2 in telemetry_batch.py
+    int32_t values[TELEMETRY_CHANNELS];
+    int n = 0;
+    values[n++] = frame.programState;
+    values[n++] = TelemetryBatch::toFixed(frame.waterTemp, 100);
+    values[n++] = TelemetryBatch::toFixed(frame.airTemp, 100);
+    values[n++] = TelemetryBatch::toFixed(frame.elecTemp, 100);
+    values[n++] = TelemetryBatch::toFixed(frame.pH, 100);
+    values[n++] = TelemetryBatch::toFixed(frame.turbidity, 100);
+    values[n++] = TelemetryBatch::toFixed(frame.oxygen, 100);
+    values[n++] = TelemetryBatch::toFixed(frame.airFlow, 100);
+    values[n++] = frame.actuatorRunning;
+    for (uint8_t i = 0; i < TelemetryProtocol::ACTUATOR_COUNT; i++) {
+        values[n++] = frame.actuatorValues[i];
+    }
+    values[n++] = TelemetryBatch::toFixed(frame.currentVolume, 10000);
+    values[n++] = TelemetryBatch::toFixed(frame.availableVolume, 10000);
+    values[n++] = TelemetryBatch::toFixed(frame.addedNaOH, 10000);
+    values[n++] = TelemetryBatch::toFixed(frame.addedNutrient, 10000);
+    values[n++] = TelemetryBatch::toFixed(frame.addedMicroalgae, 10000);
+    values[n++] = TelemetryBatch::toFixed(frame.removedVolume, 10000);
+
+    if (telemetryBatch.isEmpty()) {
+        telemetryBatchStart = millis();
+    }
+    if (telemetryBatch.addSample(time, millis(), values)) {
+        publishTelemetryBatch();
+    }
+}
+
+void handleFrameByte(uint8_t incomingByte) {
+    switch (frameReader.push(incomingByte)) {
+        case TelemetryProtocol::FrameReader::Result::FRAME: {
+            TelemetryProtocol::AllDataFrame frame;
+            if (TelemetryProtocol::decodeAllData(frameReader.payload(), frameReader.length(), frame)) {
+                // Queued in its compact form, expanded when sent
+                uint32_t time = receptionTime();
+                handOffToUplink(TelemetryQueue::TYPE_FRAME, time, frameReader.payload(), frameReader.length());
+                if (telemetryBatchMode) {
+                    addToTelemetryBatch(frame, time);
+                } else if (mqttClient.connected()) {
+                    mqttClient.publish(MQTT_SENSOR_TOPIC, 0, false, buildServerMessage(expandAllData(frame), time).c_str());
+                }
+            } else {
+                Serial.println("Unsupported binary frame from Teensy (schema version or type)");
+            }
+            break;
+        }
+        case TelemetryProtocol::FrameReader::Result::CRC_ERROR:
+            Serial.println("Binary frame from Teensy dropped: CRC error");
+            break;
+        default:
+            break;
+    }
+}
+
+// POST at most maxEntries of the oldest queued messages to the web server
+BatchResult sendQueuedBatch(HTTPClient& http, WiFiClient& client, int maxEntries) {
+    TelemetryQueue::Entry entries[UPLINK_BATCH_SIZE];
+    int count = telemetryQueue.peek(entries, min(maxEntries, UPLINK_BATCH_SIZE), uplinkStorage, sizeof(uplinkStorage));
+    if (count == 0) return BatchResult::COMMITTED;
+
+    String body = "[";
+    for (int i = 0; i < count; i++) {
+        String message;
+        TelemetryProtocol::AllDataFrame frame;
+        if (entries[i].type == TelemetryQueue::TYPE_FRAME) {
+            if (!TelemetryProtocol::decodeAllData(entries[i].data, entries[i].length, frame)) continue;
+            message = expandAllData(frame);
+        } else {
+            message = String(reinterpret_cast<const char*>(entries[i].data), entries[i].length);
+        }
+        if (body.length() > 1) body += ',';
+        body += buildServerMessage(message, entries[i].time);
+    }
+    body += ']';
+
+    // With reuse, begin() keeps the connection of the previous POST when it is still open
+    unsigned long start = millis();
+    http.begin(client, SENSOR_DATA_BATCH_URL);
+    http.addHeader("Content-Type", "application/json");
+    int httpResponseCode = http.POST(body);
+    http.end();
+    uint32_t latency = millis() - start;
+
+    uplinkStatistics.posts++;
+    uplinkStatistics.lastLatency = latency;
+    uplinkStatistics.totalLatency += latency;
+    if (latency > uplinkStatistics.maxLatency) uplinkStatistics.maxLatency = latency;
+
+    if (httpResponseCode >= 200 && httpResponseCode < 300) {
+        telemetryQueue.commit();
+        uplinkStatistics.messagesSent += count;
+        DEBUG_SERIAL.printf("%d messages sent to the server in %u ms, %u queued\n", count, latency,
+                            telemetryQueue.getPendingRecords());
+        return BatchResult::COMMITTED;
+    }
+    if (httpResponseCode == HTTP_CODE_PAYLOAD_TOO_LARGE && count > 1) {
+        Serial.printf("Server refused %d messages as too large (HTTP 413), splitting the batch\n", count);
+        return BatchResult::TOO_LARGE;
+    }
+    if (httpResponseCode == 400 || httpResponseCode == 422 || httpResponseCode == HTTP_CODE_PAYLOAD_TOO_LARGE) {
+        // The server will never accept this batch: do not let it block the queue
+        telemetryQueue.commit();
+        Serial.printf("Server rejected %d messages (HTTP %d), dropped\n", count, httpResponseCode);
+        return BatchResult::DROPPED;
+    }
+    uplinkStatistics.failures++;
+    Serial.printf("HTTP Error: %d, %u messages queued\n", httpResponseCode, telemetryQueue.getPendingRecords());
+    return BatchResult::FAILED;
+}
+
+/*
+ * Uplink task: moves the messages handed off by loop() to the flash queue and sends the queue to the web
+ * server. A batch is sent when it is full or when its oldest message has waited UPLINK_FLUSH_INTERVAL.
+ * The HTTP connection is kept alive between POSTs; failed POSTs are retried with an exponential backoff.
+ * A batch refused as too large is sent again at once in halves, the batch size then grows back after each success.
+ */
+void uplinkTask(void* parameter) {
+    static UplinkMessage message;
+    WiFiClient client;
+    HTTPClient http;
+    http.setReuse(true);
+    http.setTimeout(UPLINK_HTTP_TIMEOUT);
+    http.setConnectTimeout(UPLINK_HTTP_TIMEOUT);
+
+    unsigned long backoff = 0;
+    unsigned long lastAttempt = 0;
+    int batchLimit = UPLINK_BATCH_SIZE;     // Messages per POST, reduced after an HTTP 413
+    unsigned long oldestPending = millis(); // Arrival of the oldest message not sent yet
+
+    for (;;) {
+        // Sleep until a message arrives or the next POST is due
+        TickType_t wait = portMAX_DELAY;
+        if (!telemetryQueue.isEmpty()) {
+            unsigned long now = millis();
+            unsigned long flushWait = 0;
+            if (telemetryQueue.getPendingRecords() < UPLINK_BATCH_SIZE && now - oldestPending < UPLINK_FLUSH_INTERVAL) {
+                flushWait = UPLINK_FLUSH_INTERVAL - (now - oldestPending);
+            }
+            unsigned long backoffWait = (now - lastAttempt < backoff) ? backoff - (now - lastAttempt) : 0;
+            wait = pdMS_TO_TICKS(WiFi.status() == WL_CONNECTED ? max(flushWait, backoffWait) : UPLINK_FLUSH_INTERVAL);
+        }
+        if (xQueueReceive(uplinkHandoff, &message, wait) == pdTRUE) {
+            do {
+                if (telemetryQueue.isEmpty()) oldestPending = millis();
+                telemetryQueue.push(message.type, message.time, message.data, message.length);
+            } while (xQueueReceive(uplinkHandoff, &message, 0) == pdTRUE);
+        }
+
+        unsigned long now = millis();
+        if (telemetryQueue.isEmpty() || WiFi.status() != WL_CONNECTED) continue;
+        if (telemetryQueue.getPendingRecords() < UPLINK_BATCH_SIZE && now - oldestPending < UPLINK_FLUSH_INTERVAL) continue;
+        if (now - lastAttempt < backoff) continue;
+
+        lastAttempt = now;
+        switch (sendQueuedBatch(http, client, batchLimit)) {
+            case BatchResult::COMMITTED:
+                batchLimit = min(batchLimit * 2, UPLINK_BATCH_SIZE);
+                // fall through
+            case BatchResult::DROPPED:
+                backoff = 0;
+                oldestPending = millis();
+                break;
+            case BatchResult::TOO_LARGE:
+                batchLimit = max(batchLimit / 2, 1);
+                break;
+            case BatchResult::FAILED:
+                backoff = constrain(backoff * 2, UPLINK_MIN_BACKOFF, UPLINK_MAX_BACKOFF);
+                Serial.printf("Retry in %lu ms\n", backoff);
+                break;
+        }
+    }
+}
+
+// Uplink state on the MQTT status topic, the maximum POST latency restarts with each status
+void publishUplinkStatus() {
+    uint32_t posts = uplinkStatistics.posts;
+    String status = "{\"device\":\"ESP32\",\"uplink\":{\"handoff\":" +
+                    String(uplinkHandoff ? uxQueueMessagesWaiting(uplinkHandoff) : 0) +
+                    ",\"queued\":" + String(telemetryQueue.getPendingRecords()) +
+                    ",\"queuedBytes\":" + String(telemetryQueue.getPendingBytes()) +
+                    ",\"dropped\":" + String(telemetryQueue.getDroppedRecords() + uplinkStatistics.handoffDropped) +
+                    ",\"sent\":" + String(uplinkStatistics.messagesSent) +
+                    ",\"posts\":" + String(posts) +
+                    ",\"failures\":" + String(uplinkStatistics.failures) +
+                    ",\"latencyMs\":" + String(uplinkStatistics.lastLatency) +
+                    ",\"avgLatencyMs\":" + String(posts ? uplinkStatistics.totalLatency / posts : 0) +
+                    ",\"maxLatencyMs\":" + String(uplinkStatistics.maxLatency) + "}}";
+    uplinkStatistics.maxLatency = 0;
+    Serial.println(status);
+    if (mqttClient.connected()) {
+        mqttClient.publish(MQTT_STATUS_TOPIC, 0, false, status.c_str());
+    }
 }
 
 void loop() {
+    updateLink();
+    events(); // ezTime NTP updates
+
     // Process data from Teensy
-    static String receivedData = "";
     while (Serial2.available()) {
-        char incomingChar = Serial2.read();
-        receivedData += incomingChar;
-
-        if (incomingChar == '\n') {
-            Serial.print("Received from Teensy: ");
-            Serial.println(receivedData);
-
-            if (WiFi.status() == WL_CONNECTED) {
-                Serial.println("Preparing HTTP request...");
-                // Prepare JSON data
-                String jsonData = "{\"arduino_value\":" + receivedData.substring(0, receivedData.length() - 1) +
-                                ",\"timestamp\":\"" + myTZ.dateTime("H:i:s") + "\"}";
-                Serial.println("JSON data: " + jsonData);
-
-                // Send to HTTP endpoint
-                HTTPClient http;
-                Serial.println("Sending HTTP POST to server...");
-                http.begin("http://192.168.1.25:8000/sensor_data");
-                http.addHeader("Content-Type", "application/json");
-                
-                int httpResponseCode = http.POST(jsonData);
-                if (httpResponseCode > 0) {
-                    String response = http.getString();
-                    Serial.println("Server response: " + response);
-                } else {
-                    Serial.print("HTTP Error: ");
-                    Serial.println(httpResponseCode);
-                }
-                http.end();
+        uint8_t incomingByte = Serial2.read();
 
-                // Send to MQTT if connected
-                if (mqttClient.connected()) {
-                    mqttClient.publish(MQTT_SENSOR_TOPIC, 0, false, jsonData.c_str());
-                    Serial.println("Data sent to MQTT");
-                }
-            }
+        // A binary frame can only start where a text line would start
+        if (frameReader.inFrame() || (teensyReader.atLineStart() && incomingByte == TelemetryProtocol::SYNC_BYTE)) {
+            handleFrameByte(incomingByte);
+            continue;
+        }
 
-            receivedData = "";
+        if (teensyReader.push(incomingByte)) {
+            String message = teensyReader.line();
+            if (message.length() > 0 && !handleLinkMessage(message)) {
+                forwardTeensyMessage(message);
+            }
         }
     }
 
+    // A partial batch is not kept longer than TELEMETRY_BATCH_MAX_AGE, nor after a switch to JSON
+    if (!telemetryBatch.isEmpty() && (!telemetryBatchMode || millis() - telemetryBatchStart >= TELEMETRY_BATCH_MAX_AGE)) {
+        publishTelemetryBatch();
+    }
+
     // Status logging
     static unsigned long lastStatusCheck = 0;
     if (millis() - lastStatusCheck > 10000) {  // Every 10 seconds
@@ -275,6 +818,7 @@ void loop() {
         Serial.println("ESP32 Status:");
         Serial.printf("WiFi Connected: %d\n", WiFi.status() == WL_CONNECTED);
         Serial.printf("MQTT Connected: %d\n", mqttClient.connected());
+        publishUplinkStatus();
         Serial.println("ESP32 loop is running");
     }
 
@@ -0,0 +1,88 @@
+// SerialLineReader.h
+#ifndef SERIAL_LINE_READER_H
+#define SERIAL_LINE_READER_H
+
+#include <Arduino.h>
+
+/*
+ * Non-blocking line reader on top of a serial port.
+ * The UART driver fills its receive ring buffer from the RX interrupt; this class only moves the
+ * bytes already received into a fixed line buffer, so it never waits for the sender.
+ * Lines end with '\n' ('\r' is ignored). Lines longer than Size - 1 characters are dropped.
+ */
+template<size_t Size>
+class SerialLineReader {
+public:
+    SerialLineReader(Stream& stream) : _stream(&stream), _length(0), _overflow(false), _droppedLines(0) {
+        _buffer[0] = '\0';
+    }
+
+    /*
+     * Add one received byte.
+     * @return: true when the byte completes a line, available through line() until the next push().
+     */
+    bool push(char c) {
+        if (c == '\n') {
+            bool valid = !_overflow;
+            _buffer[_length] = '\0';
+            _length = 0;
+            _overflow = false;
+            if (!valid) {
+                _droppedLines++;
+            }
+            return valid;
+        }
+        if (c == '\r') {
+            return false;
+        }
+        if (_length < Size - 1) {
+            _buffer[_length++] = c;
+        } else {
+            _overflow = true;
+        }
+        return false;
+    }
+
+    /*
+     * Consume the bytes already received, without waiting.
+     * @return: true when a complete line is available through line().
+     */
+    bool tryReadLine() {
+        while (_stream->available() > 0) {
+            if (push(_stream->read())) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool tryReadLine(String& line) {
+        if (!tryReadLine()) {
+            return false;
+        }
+        line = _buffer;
+        return true;
+    }
+
+    const char* line() const { return _buffer; }
+
+    // True when no partial line is pending
+    bool atLineStart() const { return _length == 0 && !_overflow; }
+
+    // Drop the partial line
+    void clear() {
+        _length = 0;
+        _overflow = false;
+    }
+
+    unsigned long droppedLines() const { return _droppedLines; }
+
+private:
+    Stream* _stream;
+    char _buffer[Size];
+    size_t _length;
+    bool _overflow;
+    unsigned long _droppedLines;
+};
+
+#endif // SERIAL_LINE_READER_H
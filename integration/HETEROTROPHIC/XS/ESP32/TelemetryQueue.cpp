@@ -0,0 +1,248 @@
+// TelemetryQueue.cpp
+#include "TelemetryQueue.h"
+
+TelemetryQueue::TelemetryQueue()
+    : fs(nullptr), maxBytes(0), segmentSize(0),
+      writeSegment(0), writeOffset(0), readSegment(0), readOffset(0),
+      peeked(false), peekSegment(0), peekStartOffset(0), peekEndSegment(0), peekEndOffset(0), peekRecords(0), peekBytes(0),
+      pendingRecords(0), pendingBytes(0), droppedRecords(0) {}
+
+bool TelemetryQueue::begin(fs::FS& fileSystem, const char* dir, size_t maxQueueBytes, size_t maxSegmentSize) {
+    fs = &fileSystem;
+    directory = dir;
+    maxBytes = maxQueueBytes;
+    segmentSize = maxSegmentSize;
+    fs->mkdir(directory);
+
+    // Segments left before the reset
+    bool found = false;
+    uint32_t firstSegment = 0;
+    uint32_t lastSegment = 0;
+    File root = fs->open(directory);
+    for (File entry = root.openNextFile(); entry; entry = root.openNextFile()) {
+        String name = entry.name();
+        entry.close();
+        int slash = name.lastIndexOf('/');
+        if (slash >= 0) name = name.substring(slash + 1);
+        if (!name.endsWith(".q")) continue;
+        uint32_t segment = name.toInt();
+        if (!found || segment < firstSegment) firstSegment = segment;
+        if (!found || segment > lastSegment) lastSegment = segment;
+        found = true;
+    }
+    root.close();
+
+    readSegment = firstSegment;
+    readOffset = 0;
+    File cursor = fs->open(directory + "/cursor", FILE_READ);
+    if (cursor) {
+        uint32_t saved[2];
+        if (cursor.read(reinterpret_cast<uint8_t*>(saved), sizeof(saved)) == sizeof(saved) &&
+            found && saved[0] >= firstSegment && saved[0] <= lastSegment) {
+            readSegment = saved[0];
+            readOffset = saved[1];
+        }
+        cursor.close();
+    }
+
+    pendingRecords = 0;
+    pendingBytes = 0;
+    if (!found) {
+        return openWriteSegment(0);
+    }
+
+    uint32_t end = 0;
+    for (uint32_t segment = firstSegment; segment <= lastSegment; segment++) {
+        if (segment < readSegment) {
+            fs->remove(segmentPath(segment));
+            continue;
+        }
+        uint32_t start = (segment == readSegment) ? readOffset : 0;
+        uint32_t records = 0;
+        end = scanSegment(segment, start, records);
+        pendingRecords += records;
+        pendingBytes += end - start;
+    }
+
+    // Append after the last complete record, in a new segment if the last one is full or ends with a torn record
+    File last = fs->open(segmentPath(lastSegment), FILE_READ);
+    bool torn = last && last.size() != end;
+    if (last) last.close();
+    if (torn || end >= segmentSize) {
+        return openWriteSegment(lastSegment + 1);
+    }
+    if (!openWriteSegment(lastSegment)) {
+        return false;
+    }
+    writeOffset = end;
+    return true;
+}
+
+bool TelemetryQueue::push(uint8_t type, uint32_t time, const uint8_t* data, size_t length) {
+    if (!fs || length > MAX_RECORD_SIZE) {
+        droppedRecords++;
+        return false;
+    }
+    size_t recordSize = HEADER_SIZE + length;
+
+    // Full: the oldest data goes first
+    while (pendingBytes + recordSize > maxBytes && readSegment < writeSegment) {
+        dropOldestSegment();
+    }
+    if (pendingBytes + recordSize > maxBytes) {
+        droppedRecords++;
+        return false;
+    }
+
+    if (writeOffset > 0 && writeOffset + recordSize > segmentSize) {
+        if (!openWriteSegment(writeSegment + 1)) {
+            droppedRecords++;
+            return false;
+        }
+    }
+
+    uint8_t header[HEADER_SIZE] = {
+        MAGIC, type, static_cast<uint8_t>(length & 0xFF), static_cast<uint8_t>(length >> 8),
+        static_cast<uint8_t>(time), static_cast<uint8_t>(time >> 8), static_cast<uint8_t>(time >> 16), static_cast<uint8_t>(time >> 24)
+    };
+    if (!writeFile || writeFile.write(header, HEADER_SIZE) != HEADER_SIZE || writeFile.write(data, length) != length) {
+        // The partial record ends this segment
+        Serial.println("Telemetry queue: write failed");
+        openWriteSegment(writeSegment + 1);
+        droppedRecords++;
+        return false;
+    }
+    writeFile.flush();
+
+    writeOffset += recordSize;
+    pendingRecords++;
+    pendingBytes += recordSize;
+    return true;
+}
+
+int TelemetryQueue::peek(Entry* entries, int maxEntries, uint8_t* storage, size_t storageSize) {
+    peeked = false;
+    if (!fs || pendingRecords == 0) return 0;
+
+    int count = 0;
+    size_t used = 0;
+    uint32_t segment = readSegment;
+    uint32_t offset = readOffset;
+    uint32_t bytes = 0;
+    File file;
+    uint32_t openSegment = UINT32_MAX;
+
+    while (count < maxEntries) {
+        if (openSegment != segment) {
+            if (file) file.close();
+            file = fs->open(segmentPath(segment), FILE_READ);
+            openSegment = segment;
+        }
+
+        uint8_t header[HEADER_SIZE];
+        bool valid = file && file.seek(offset) && file.read(header, HEADER_SIZE) == HEADER_SIZE && header[0] == MAGIC;
+        uint16_t length = valid ? (header[2] | (header[3] << 8)) : 0;
+        valid = valid && length <= MAX_RECORD_SIZE && offset + HEADER_SIZE + length <= file.size();
+        if (!valid) {
+            // End of the segment (or torn record): continue with the next one
+            if (segment >= writeSegment) break;
+            segment++;
+            offset = 0;
+            continue;
+        }
+        if (used + length > storageSize) break;
+        if (file.read(storage + used, length) != length) break;
+
+        Entry& entry = entries[count++];
+        entry.type = header[1];
+        entry.time = header[4] | (header[5] << 8) | (header[6] << 16) | (static_cast<uint32_t>(header[7]) << 24);
+        entry.data = storage + used;
+        entry.length = length;
+        used += length;
+        offset += HEADER_SIZE + length;
+        bytes += HEADER_SIZE + length;
+    }
+    if (file) file.close();
+
+    if (count > 0) {
+        peeked = true;
+        peekSegment = readSegment;
+        peekStartOffset = readOffset;
+        peekEndSegment = segment;
+        peekEndOffset = offset;
+        peekRecords = count;
+        peekBytes = bytes;
+    }
+    return count;
+}
+
+void TelemetryQueue::commit() {
+    // Entries dropped meanwhile to make room: the others are sent again with the next peek()
+    if (!peeked || readSegment != peekSegment || readOffset != peekStartOffset) {
+        peeked = false;
+        return;
+    }
+    peeked = false;
+
+    for (uint32_t segment = readSegment; segment < peekEndSegment; segment++) {
+        fs->remove(segmentPath(segment));
+    }
+    readSegment = peekEndSegment;
+    readOffset = peekEndOffset;
+    pendingRecords -= peekRecords;
+    pendingBytes -= peekBytes;
+    saveCursor();
+}
+
+String TelemetryQueue::segmentPath(uint32_t segment) const {
+    return directory + "/" + String(segment) + ".q";
+}
+
+bool TelemetryQueue::openWriteSegment(uint32_t segment) {
+    if (writeFile) writeFile.close();
+    writeSegment = segment;
+    writeOffset = 0;
+    writeFile = fs->open(segmentPath(segment), FILE_APPEND);
+    if (!writeFile) {
+        Serial.println("Telemetry queue: cannot open " + segmentPath(segment));
+        return false;
+    }
+    return true;
+}
+
+uint32_t TelemetryQueue::scanSegment(uint32_t segment, uint32_t offset, uint32_t& records) {
+    records = 0;
+    File file = fs->open(segmentPath(segment), FILE_READ);
+    if (!file) return offset;
+    size_t size = file.size();
+    uint8_t header[HEADER_SIZE];
+    while (file.seek(offset) && file.read(header, HEADER_SIZE) == HEADER_SIZE && header[0] == MAGIC) {
+        uint16_t length = header[2] | (header[3] << 8);
+        if (length > MAX_RECORD_SIZE || offset + HEADER_SIZE + length > size) break;
+        offset += HEADER_SIZE + length;
+        records++;
+    }
+    file.close();
+    return offset;
+}
+
+void TelemetryQueue::dropOldestSegment() {
+    uint32_t records;
+    uint32_t end = scanSegment(readSegment, readOffset, records);
+    fs->remove(segmentPath(readSegment));
+    droppedRecords += records;
+    pendingRecords -= min(records, pendingRecords.load());
+    pendingBytes -= min(end - readOffset, pendingBytes.load());
+    Serial.printf("Telemetry queue full: %u oldest records dropped\n", records);
+    readSegment++;
+    readOffset = 0;
+    saveCursor();
+}
+
+void TelemetryQueue::saveCursor() {
+    File cursor = fs->open(directory + "/cursor", FILE_WRITE);
+    if (!cursor) return;
+    uint32_t saved[2] = { readSegment, readOffset };
+    cursor.write(reinterpret_cast<const uint8_t*>(saved), sizeof(saved));
+    cursor.close();
+}
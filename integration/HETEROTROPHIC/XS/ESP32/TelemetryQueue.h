@@ -0,0 +1,91 @@
+// TelemetryQueue.h
+#ifndef TELEMETRY_QUEUE_H
+#define TELEMETRY_QUEUE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <atomic>
+
+/*
+ * Bounded FIFO of the data received from the Teensy, kept in flash (LittleFS) until the server acknowledged it,
+ * so that WiFi, MQTT broker or server outages and ESP32 resets lose nothing.
+ *
+ * Records are appended to segment files <dir>/<n>.q, a new segment is started every segmentSize bytes:
+ *   [MAGIC][type][length low][length high][time, 4 bytes][data ... length bytes]
+ * The read position (segment, offset) is saved in <dir>/cursor after each commit(); fully read segments
+ * are deleted. When the queue holds maxBytes, the oldest segment is deleted to make room (records counted as dropped).
+ * A record torn by a reset ends its segment: appending then continues in a new segment.
+ *
+ * Only one task may call begin(), push(), peek() and commit(). The counters read by the getters are atomic,
+ * so that another task can report them while the queue is in use.
+ */
+class TelemetryQueue {
+public:
+    static const uint8_t TYPE_TEXT = 'T';      // JSON line from the Teensy
+    static const uint8_t TYPE_FRAME = 'B';     // Payload of a binary frame (TelemetryProtocol)
+    static const size_t MAX_RECORD_SIZE = 1024;
+
+    struct Entry {
+        uint8_t type;
+        uint32_t time;           // UTC epoch when received, 0 when the clock was not set
+        const uint8_t* data;     // Points into the storage given to peek()
+        uint16_t length;
+    };
+
+    TelemetryQueue();
+
+    // Reload the queue left before a reset, fileSystem must be mounted
+    bool begin(fs::FS& fs, const char* directory, size_t maxBytes, size_t segmentSize);
+
+    bool push(uint8_t type, uint32_t time, const uint8_t* data, size_t length);
+
+    /*
+     * Read the oldest records without removing them.
+     * @param storage: Buffer the entries point to, must hold at least one record.
+     * @return: Number of entries read. commit() removes them from the queue.
+     */
+    int peek(Entry* entries, int maxEntries, uint8_t* storage, size_t storageSize);
+    void commit();
+
+    bool isEmpty() const { return pendingRecords == 0; }
+    uint32_t getPendingRecords() const { return pendingRecords; }
+    uint32_t getPendingBytes() const { return pendingBytes; }
+    uint32_t getDroppedRecords() const { return droppedRecords; }
+
+private:
+    static const uint8_t MAGIC = 0xA7;
+    static const size_t HEADER_SIZE = 8;
+
+    fs::FS* fs;
+    String directory;
+    size_t maxBytes;
+    size_t segmentSize;
+
+    File writeFile;
+    uint32_t writeSegment;
+    uint32_t writeOffset;
+    uint32_t readSegment;
+    uint32_t readOffset;
+
+    // Position after the entries of the last peek(), applied by commit()
+    bool peeked;
+    uint32_t peekSegment;
+    uint32_t peekStartOffset;
+    uint32_t peekEndSegment;
+    uint32_t peekEndOffset;
+    uint32_t peekRecords;
+    uint32_t peekBytes;
+
+    std::atomic<uint32_t> pendingRecords;
+    std::atomic<uint32_t> pendingBytes;
+    std::atomic<uint32_t> droppedRecords;
+
+    String segmentPath(uint32_t segment) const;
+    bool openWriteSegment(uint32_t segment);
+    // Count the valid records of a segment from an offset, returns the offset after the last one
+    uint32_t scanSegment(uint32_t segment, uint32_t offset, uint32_t& records);
+    void dropOldestSegment();
+    void saveCursor();
+};
+
+#endif // TELEMETRY_QUEUE_H
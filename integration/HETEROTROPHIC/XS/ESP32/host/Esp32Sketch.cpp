@@ -0,0 +1,8 @@
+// Esp32Sketch.cpp
+// ESP32.ino as the Arduino IDE compiles it: the IDE declares the sketch functions before the sketch body.
+#include <Arduino.h>
+
+bool handleBridgeCommand(const String& message);
+void uplinkTask(void* parameter);
+
+#include "ESP32.ino"
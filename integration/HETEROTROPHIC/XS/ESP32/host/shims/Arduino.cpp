@@ -0,0 +1,249 @@
+// Arduino.cpp
+#include <Arduino.h>
+#include "HostRuntime.h"
+
+#include <cctype>
+#include <vector>
+
+HardwareSerial Serial, Serial1, Serial2;
+
+// ---- String ----
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (_s.size() != other._s.size()) return false;
+    for (size_t i = 0; i < _s.size(); i++) {
+        if (tolower(static_cast<unsigned char>(_s[i])) != tolower(static_cast<unsigned char>(other._s[i]))) return false;
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    return offset <= _s.size() && _s.compare(offset, prefix._s.size(), prefix._s) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return _s.size() >= suffix._s.size() && _s.compare(_s.size() - suffix._s.size(), suffix._s.size(), suffix._s) == 0;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _s.size()) return String();
+    if (to > _s.size()) to = _s.size();
+    return String(_s.substr(from, to - from));
+}
+
+void String::trim() {
+    size_t begin = 0;
+    while (begin < _s.size() && isspace(static_cast<unsigned char>(_s[begin]))) begin++;
+    size_t end = _s.size();
+    while (end > begin && isspace(static_cast<unsigned char>(_s[end - 1]))) end--;
+    _s = _s.substr(begin, end - begin);
+}
+
+void String::toUpperCase() {
+    for (char& c : _s) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+}
+
+void String::toLowerCase() {
+    for (char& c : _s) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+}
+
+void String::replace(char find, char replacement) {
+    std::replace(_s.begin(), _s.end(), find, replacement);
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find._s.empty()) return;
+    size_t index = 0;
+    while ((index = _s.find(find._s, index)) != std::string::npos) {
+        _s.replace(index, find._s.size(), replacement._s);
+        index += replacement._s.size();
+    }
+}
+
+void String::getBytes(unsigned char* buffer, unsigned int size, unsigned int index) const {
+    if (!buffer || size == 0) return;
+    unsigned int count = 0;
+    if (index < _s.size()) {
+        count = std::min<unsigned int>(size - 1, _s.size() - index);
+        memcpy(buffer, _s.data() + index, count);
+    }
+    buffer[count] = '\0';
+}
+
+std::string String::formatInteger(long long value, unsigned char base) {
+    if (value < 0 && base == 10) return "-" + formatUnsigned(static_cast<unsigned long long>(-(value + 1)) + 1, base);
+    // Negative values in another base print as their two's complement, like on the target (32 bits)
+    if (value < 0) return formatUnsigned(static_cast<uint32_t>(value), base);
+    return formatUnsigned(static_cast<unsigned long long>(value), base);
+}
+
+std::string String::formatUnsigned(unsigned long long value, unsigned char base) {
+    if (base < 2 || base > 36) base = 10;
+    char digits[66];
+    int length = 0;
+    do {
+        int digit = static_cast<int>(value % base);
+        digits[length++] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value > 0);
+    std::string result;
+    while (length > 0) result += digits[--length];
+    return result;
+}
+
+std::string String::formatFloat(double value, unsigned char decimals) {
+    if (std::isnan(value)) return "nan";
+    if (std::isinf(value)) return value > 0 ? "inf" : "-inf";
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), value);
+    return buffer;
+}
+
+// ---- Print / Stream ----
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t count = 0;
+    while (size--) {
+        count += write(*buffer++);
+    }
+    return count;
+}
+
+int Print::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    char small[256];
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(small, sizeof(small), format, copy);
+    va_end(copy);
+    if (length < 0) {
+        va_end(args);
+        return length;
+    }
+    if (static_cast<size_t>(length) < sizeof(small)) {
+        write(small, length);
+    } else {
+        std::vector<char> large(length + 1);
+        vsnprintf(large.data(), large.size(), format, args);
+        write(large.data(), length);
+    }
+    va_end(args);
+    return length;
+}
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) return c;
+        delay(1);
+    } while (millis() - start < _timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) break;
+        buffer[count++] = static_cast<char>(c);
+    }
+    return count;
+}
+
+String Stream::readStringUntil(char terminator) {
+    std::string result;
+    int c = timedRead();
+    while (c >= 0 && c != terminator) {
+        result += static_cast<char>(c);
+        c = timedRead();
+    }
+    return String(result);
+}
+
+// ---- HardwareSerial ----
+
+size_t HardwareSerial::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    std::lock_guard<std::mutex> lock(_lock);
+    _tx.append(reinterpret_cast<const char*>(buffer), size);
+    if (_echo) {
+        fwrite(buffer, 1, size, _echo);
+    }
+    // Keep long runs bounded when nobody reads the port
+    if (_tx.size() > (1u << 24)) {
+        _tx.erase(0, _tx.size() / 2);
+    }
+    return size;
+}
+
+int HardwareSerial::available() {
+    std::lock_guard<std::mutex> lock(_lock);
+    return static_cast<int>(_rx.size());
+}
+
+int HardwareSerial::read() {
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_rx.empty()) return -1;
+    int c = _rx.front();
+    _rx.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek() {
+    std::lock_guard<std::mutex> lock(_lock);
+    return _rx.empty() ? -1 : _rx.front();
+}
+
+void HardwareSerial::hostInject(const std::string& data) {
+    std::lock_guard<std::mutex> lock(_lock);
+    for (char c : data) {
+        if (_rx.size() < _rxCapacity) {
+            _rx.push_back(static_cast<uint8_t>(c));
+        } else {
+            _droppedBytes++;
+        }
+    }
+}
+
+std::string HardwareSerial::hostTakeOutput() {
+    std::lock_guard<std::mutex> lock(_lock);
+    std::string output;
+    output.swap(_tx);
+    return output;
+}
+
+// ---- Time ----
+
+unsigned long millis() {
+    return static_cast<unsigned long>(HostRuntime::nowMicros() / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(HostRuntime::nowMicros());
+}
+
+void delay(unsigned long ms) {
+    HostRuntime::advanceMicros(static_cast<uint64_t>(ms) * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    HostRuntime::advanceMicros(us);
+}
+
+// ---- String functions of the ESP32 libc ----
+
+size_t strlcpy(char* destination, const char* source, size_t size) {
+    size_t length = strlen(source);
+    if (size > 0) {
+        size_t count = length < size - 1 ? length : size - 1;
+        memcpy(destination, source, count);
+        destination[count] = '\0';
+    }
+    return length;
+}
@@ -0,0 +1,257 @@
+// Arduino.h
+// Host stand-in of the ESP32 Arduino core for the bridge sketch: String, Print/Stream, serial ports, FreeRTOS
+// (freertos/) and the clock of HostRuntime.h, virtual by default (a run is deterministic and as fast as the CPU
+// allows) or real time for the tests that measure against a real socket. Only what ESP32.ino uses is provided.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+#include <deque>
+#include <type_traits>
+#include <algorithm>
+#include <mutex>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/timers.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define IRAM_ATTR
+#define PROGMEM
+#define F(x) (x)
+typedef const char* PGM_P;
+
+#define PI 3.1415926535897932384626433832795
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 4
+#define FALLING 2
+#define RISING 3
+#define DEC 10
+#define HEX 16
+#define BIN 2
+#define SERIAL_8N1 0x800001c
+
+class String {
+public:
+    String() {}
+    String(const char* value) : _s(value ? value : "") {}
+    String(const char* value, unsigned int length) : _s(value ? std::string(value, length) : std::string()) {}
+    String(const std::string& value) : _s(value) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) : _s(formatInteger(value, base)) {}
+    explicit String(int value, unsigned char base = 10) : _s(formatInteger(value, base)) {}
+    explicit String(unsigned int value, unsigned char base = 10) : _s(formatInteger(value, base)) {}
+    explicit String(long value, unsigned char base = 10) : _s(formatInteger(value, base)) {}
+    explicit String(unsigned long value, unsigned char base = 10) : _s(formatInteger(value, base)) {}
+    explicit String(long long value, unsigned char base = 10) : _s(formatInteger(value, base)) {}
+    explicit String(unsigned long long value, unsigned char base = 10) : _s(formatInteger(value, base)) {}
+    explicit String(float value, unsigned char decimals = 2) : _s(formatFloat(value, decimals)) {}
+    explicit String(double value, unsigned char decimals = 2) : _s(formatFloat(value, decimals)) {}
+
+    unsigned int length() const { return _s.size(); }
+    const char* c_str() const { return _s.c_str(); }
+    bool reserve(unsigned int size) { _s.reserve(size); return true; }
+    bool isEmpty() const { return _s.empty(); }
+
+    char charAt(unsigned int index) const { return index < _s.size() ? _s[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < _s.size()) _s[index] = c; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return _s[index]; }
+
+    bool equals(const String& other) const { return _s == other._s; }
+    bool equalsIgnoreCase(const String& other) const;
+    bool startsWith(const String& prefix) const { return _s.compare(0, prefix._s.size(), prefix._s) == 0; }
+    bool startsWith(const String& prefix, unsigned int offset) const;
+    bool endsWith(const String& suffix) const;
+    int compareTo(const String& other) const { return _s.compare(other._s); }
+
+    int indexOf(char c, unsigned int from = 0) const { return position(_s.find(c, from)); }
+    int indexOf(const String& s, unsigned int from = 0) const { return position(_s.find(s._s, from)); }
+    int lastIndexOf(char c) const { return position(_s.rfind(c)); }
+    int lastIndexOf(const String& s) const { return position(_s.rfind(s._s)); }
+
+    String substring(unsigned int from) const { return from >= _s.size() ? String() : String(_s.substr(from)); }
+    String substring(unsigned int from, unsigned int to) const;
+
+    void trim();
+    void toUpperCase();
+    void toLowerCase();
+    void replace(char find, char replacement);
+    void replace(const String& find, const String& replacement);
+    void remove(unsigned int index) { if (index < _s.size()) _s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < _s.size()) _s.erase(index, count); }
+
+    long toInt() const { return atol(_s.c_str()); }
+    float toFloat() const { return static_cast<float>(atof(_s.c_str())); }
+    double toDouble() const { return atof(_s.c_str()); }
+
+    void toCharArray(char* buffer, unsigned int size, unsigned int index = 0) const { getBytes(reinterpret_cast<unsigned char*>(buffer), size, index); }
+    void getBytes(unsigned char* buffer, unsigned int size, unsigned int index = 0) const;
+
+    bool concat(const String& s) { _s += s._s; return true; }
+    bool concat(const char* s) { if (s) _s += s; return true; }
+    bool concat(char c) { _s += c; return true; }
+    template<class T, class = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    bool concat(T value) { _s += String(value)._s; return true; }
+
+    String& operator+=(const String& s) { concat(s); return *this; }
+    String& operator+=(const char* s) { concat(s); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+    template<class T, class = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    String& operator+=(T value) { concat(value); return *this; }
+
+    bool operator==(const String& other) const { return _s == other._s; }
+    bool operator==(const char* other) const { return _s == (other ? other : ""); }
+    bool operator!=(const String& other) const { return !(*this == other); }
+    bool operator!=(const char* other) const { return !(*this == other); }
+    bool operator<(const String& other) const { return _s < other._s; }
+    bool operator>(const String& other) const { return _s > other._s; }
+
+    const std::string& str() const { return _s; }
+
+private:
+    std::string _s;
+
+    static int position(size_t index) { return index == std::string::npos ? -1 : static_cast<int>(index); }
+    static std::string formatInteger(long long value, unsigned char base);
+    static std::string formatUnsigned(unsigned long long value, unsigned char base);
+    static std::string formatFloat(double value, unsigned char decimals);
+    template<class T> static std::string formatInteger(T value, unsigned char base,
+        typename std::enable_if<std::is_unsigned<T>::value>::type* = 0) { return formatUnsigned(value, base); }
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, char b) { String r(a); r += b; return r; }
+template<class T, class = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+inline String operator+(const String& a, T b) { String r(a); r += b; return r; }
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t b) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* s) { return s ? write(reinterpret_cast<const uint8_t*>(s), strlen(s)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write(reinterpret_cast<const uint8_t*>(buffer), size); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(unsigned char value, int base = DEC) { return print(String(value, base)); }
+    size_t print(int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned int value, int base = DEC) { return print(String(value, base)); }
+    size_t print(long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(long long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(unsigned long long value, int base = DEC) { return print(String(value, base)); }
+    size_t print(double value, int digits = 2) { return print(String(value, digits)); }
+    size_t print(bool value) { return print(static_cast<int>(value)); }
+    size_t print(const Printable& value) { return value.printTo(*this); }
+
+    size_t println() { return write("\r\n"); }
+    template<class T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template<class T> size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes(reinterpret_cast<char*>(buffer), length); }
+    String readStringUntil(char terminator);
+
+protected:
+    unsigned long _timeout = 1000;
+    int timedRead();
+};
+
+/*
+ * Serial port: bytes written by the firmware are kept until the test takes them (or echoed to stdout), bytes
+ * injected by the test are what the firmware reads. The receive buffer holds setRxBufferSize() bytes (256 by
+ * default, as the UART driver), injected bytes that do not fit are lost.
+ * Writes may come from several tasks: they are serialized, as by the lock of the UART driver.
+ */
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1) {
+        _baud = baud;
+        (void)config; (void)rxPin; (void)txPin;
+    }
+    void end() { _baud = 0; }
+    void updateBaudRate(unsigned long baud) { _baud = baud; }
+    size_t setRxBufferSize(size_t size) { _rxCapacity = size; return size; }
+    operator bool() const { return true; }
+
+    size_t write(uint8_t b) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int availableForWrite() override { return 128; }
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    // Host side
+    void hostInject(const std::string& data);
+    std::string hostTakeOutput();
+    void hostSetEcho(FILE* stream) { _echo = stream; }
+    unsigned long hostBaud() const { return _baud; }
+    unsigned long hostDroppedBytes() const { return _droppedBytes; }
+
+private:
+    std::mutex _lock;
+    std::deque<uint8_t> _rx;
+    std::string _tx;
+    FILE* _echo = nullptr;
+    unsigned long _baud = 0;
+    size_t _rxCapacity = 256;
+    unsigned long _droppedBytes = 0;
+};
+
+extern HardwareSerial Serial, Serial1, Serial2;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+size_t strlcpy(char* destination, const char* source, size_t size);
+
+template<class A, class B> auto min(A a, B b) -> typename std::common_type<A, B>::type { return (b < a) ? b : a; }
+template<class A, class B> auto max(A a, B b) -> typename std::common_type<A, B>::type { return (a < b) ? b : a; }
+template<class T, class L, class H> auto constrain(T x, L low, H high) -> typename std::common_type<T, L, H>::type {
+    return x < low ? low : (x > high ? high : x);
+}
+
+using std::abs;
+
+#endif // HOST_ARDUINO_H
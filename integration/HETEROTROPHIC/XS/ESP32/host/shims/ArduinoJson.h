@@ -0,0 +1,334 @@
+// ArduinoJson.h
+// Subset of the ArduinoJson 7 API used by the sketch, on top of a plain heap tree.
+// Documents, member proxies (doc["a"]["b"] = 1), to<JsonObject>(), nested objects, implicit conversions,
+// serializeJson/measureJson/deserializeJson.
+// A document created with a custom allocator takes the memory of its values from it, with the sizes of the library
+// on a 32-bit target: a 16-byte slot per value, an 8-byte header plus the characters and the NUL per copied string
+// (keys excepted, they are string literals in the sketch). When the allocator fails the value is dropped and
+// overflowed() becomes true, as in the library. Documents without an allocator use the heap and never overflow.
+#ifndef HOST_ARDUINO_JSON_H
+#define HOST_ARDUINO_JSON_H
+
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include <utility>
+
+namespace ArduinoJson {
+class Allocator {
+public:
+    virtual void* allocate(size_t size) = 0;
+    virtual void deallocate(void* ptr) = 0;
+    virtual void* reallocate(void* ptr, size_t newSize) = 0;
+
+protected:
+    ~Allocator() = default;
+};
+}
+
+namespace HostJson {
+
+/*
+ * Alive while the shim works on its own heap tree, proxies and text buffers. The library keeps all of this in the
+ * memory of the document (its allocator when it has one): a test counting the heap use of the sketch skips the
+ * allocations made meanwhile.
+ */
+class ShimHeap {
+public:
+    ShimHeap() { depth()++; }
+    ~ShimHeap() { depth()--; }
+    ShimHeap(const ShimHeap&) = delete;
+    ShimHeap& operator=(const ShimHeap&) = delete;
+    static bool active() { return depth() > 0; }
+
+private:
+    static int& depth() {
+        static thread_local int value = 0;
+        return value;
+    }
+};
+
+struct Node {
+    enum Type { Null, Bool, Integer, Unsigned, Float, Double, Text, Object, Array };
+
+    static const size_t SLOT_SIZE = 16;
+    static const size_t STRING_HEADER_SIZE = 8;
+
+    Type type = Null;
+    bool boolean = false;
+    long long integer = 0;
+    unsigned long long uinteger = 0;
+    double number = 0;
+    std::string text;
+    std::vector<std::pair<std::string, std::unique_ptr<Node>>> members;
+    std::vector<std::unique_ptr<Node>> items;
+
+    // Memory of the document (nullptr: heap, not accounted), inherited by the children
+    ArduinoJson::Allocator* allocator = nullptr;
+    bool* overflowed = nullptr;
+    void* slot = nullptr;
+    void* textBlock = nullptr;
+
+    Node() {}
+    Node(const Node&) = delete;
+    Node& operator=(const Node&) = delete;
+    ~Node() { reset(); release(slot); }
+
+    void reset(Type newType = Null);
+    // false when the allocator is full, the node is then left null
+    bool copyFrom(const Node& other);
+    bool setText(const std::string& value);
+    Node* find(const std::string& key) const;
+    Node* member(const std::string& key);
+    Node* element(size_t index, bool create);
+    Node* append();
+    bool removeMember(const std::string& key);
+    size_t size() const { return type == Object ? members.size() : (type == Array ? items.size() : 0); }
+
+private:
+    // Child in the same document, nullptr when its slot cannot be allocated
+    std::unique_ptr<Node> newChild();
+    void* allocate(size_t size);
+    void release(void*& block);
+};
+
+void write(const Node* node, std::string& out);
+bool parse(const char* input, size_t length, Node& node, const char** error);
+
+} // namespace HostJson
+
+class JsonObject;
+class JsonArray;
+
+class JsonVariant {
+public:
+    JsonVariant() {}
+    explicit JsonVariant(HostJson::Node* node) : _node(node) {}
+
+    JsonVariant operator[](const char* key) const { return child(key); }
+    JsonVariant operator[](const String& key) const { return child(key.c_str()); }
+    JsonVariant operator[](const std::string& key) const { return child(key.c_str()); }
+    template<class T, class = typename std::enable_if<std::is_integral<T>::value>::type>
+    JsonVariant operator[](T index) const { return element(static_cast<size_t>(index)); }
+
+    template<class T> JsonVariant& operator=(const T& value) { set(value); return *this; }
+    JsonVariant& operator=(const char* value) { set(value); return *this; }
+    JsonVariant(const JsonVariant&) = default;
+    JsonVariant& operator=(const JsonVariant& other) = default;
+
+    bool set(std::nullptr_t) { return assign([](HostJson::Node& n) { n.reset(); }); }
+    bool set(bool value) { return assign([&](HostJson::Node& n) { n.reset(HostJson::Node::Bool); n.boolean = value; }); }
+    bool set(float value) { return assign([&](HostJson::Node& n) { n.reset(HostJson::Node::Float); n.number = value; }); }
+    bool set(double value) { return assign([&](HostJson::Node& n) { n.reset(HostJson::Node::Double); n.number = value; }); }
+    bool set(const char* value);
+    bool set(char* value) { return set(static_cast<const char*>(value)); }
+    bool set(const String& value) { return set(value.c_str()); }
+    bool set(const std::string& value) { return set(value.c_str()); }
+    bool set(const JsonVariant& value);
+    template<class T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value && !std::is_same<T, bool>::value, bool>::type
+    set(T value) { return assign([&](HostJson::Node& n) { n.reset(HostJson::Node::Integer); n.integer = value; }); }
+    template<class T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value, bool>::type
+    set(T value) { return assign([&](HostJson::Node& n) { n.reset(HostJson::Node::Unsigned); n.uinteger = value; }); }
+    template<class T>
+    typename std::enable_if<std::is_enum<T>::value, bool>::type
+    set(T value) { return set(static_cast<long long>(value)); }
+
+    template<class T> T as() const;
+    template<class T> bool is() const;
+    template<class T> operator T() const { return as<T>(); }
+
+    template<class T> T operator|(const T& fallback) const { return is<T>() ? as<T>() : fallback; }
+    const char* operator|(const char* fallback) const;
+
+    template<class T> T to();
+
+    bool isNull() const;
+    size_t size() const;
+    bool containsKey(const char* key) const;
+    bool containsKey(const String& key) const { return containsKey(key.c_str()); }
+    void remove(const char* key);
+    void remove(const String& key) { remove(key.c_str()); }
+    void clear();
+
+    JsonObject createNestedObject(const char* key);
+    JsonObject createNestedObject(const String& key);
+    JsonArray createNestedArray(const char* key);
+    JsonObject createNestedObject();
+    JsonArray createNestedArray();
+    template<class T> bool add(const T& value) { return add().set(value); }
+    JsonVariant add();
+
+    // Host side
+    HostJson::Node* node(bool create) const;
+
+protected:
+    HostJson::Node* _node = nullptr;
+
+private:
+    std::shared_ptr<JsonVariant> _parent;
+    std::string _key;
+    long _index = -1;
+
+    JsonVariant child(const char* key) const;
+    JsonVariant element(size_t index) const;
+    template<class F> bool assign(F apply) {
+        HostJson::Node* n = node(true);
+        if (!n) return false;
+        apply(*n);
+        return true;
+    }
+};
+
+class JsonObject : public JsonVariant {
+public:
+    JsonObject() {}
+    explicit JsonObject(const JsonVariant& variant) : JsonVariant(variant) {}
+    using JsonVariant::operator=;
+};
+
+class JsonArray : public JsonVariant {
+public:
+    JsonArray() {}
+    explicit JsonArray(const JsonVariant& variant) : JsonVariant(variant) {}
+    using JsonVariant::operator=;
+};
+
+typedef JsonVariant JsonVariantConst;
+typedef JsonObject JsonObjectConst;
+typedef JsonArray JsonArrayConst;
+
+class JsonDocument : public JsonVariant {
+public:
+    JsonDocument();
+    explicit JsonDocument(ArduinoJson::Allocator* allocator);
+    JsonDocument(const JsonDocument& other);
+    JsonDocument& operator=(const JsonDocument& other);
+    using JsonVariant::operator=;
+
+    void clear() {
+        _root->reset();
+        *_overflowed = false;
+    }
+    bool overflowed() const { return *_overflowed; }
+    void shrinkToFit() {}
+
+private:
+    std::unique_ptr<HostJson::Node> _root;
+    std::unique_ptr<bool> _overflowed;      // Shared with the nodes, stays in place when the document is moved
+};
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+
+    DeserializationError(Code code = Ok) : _code(code) {}
+    Code code() const { return _code; }
+    const char* c_str() const;
+    explicit operator bool() const { return _code != Ok; }
+    bool operator==(Code code) const { return _code == code; }
+    bool operator!=(Code code) const { return _code != code; }
+
+private:
+    Code _code;
+};
+
+DeserializationError deserializeJson(JsonVariant destination, const char* input, size_t length);
+inline DeserializationError deserializeJson(JsonVariant destination, const char* input) {
+    return deserializeJson(destination, input, input ? strlen(input) : 0);
+}
+inline DeserializationError deserializeJson(JsonVariant destination, const String& input) {
+    return deserializeJson(destination, input.c_str(), input.length());
+}
+inline DeserializationError deserializeJson(JsonVariant destination, const std::string& input) {
+    return deserializeJson(destination, input.c_str(), input.size());
+}
+
+size_t serializeJson(const JsonVariant& source, String& output);
+size_t serializeJson(const JsonVariant& source, std::string& output);
+size_t serializeJson(const JsonVariant& source, Print& output);
+size_t serializeJson(const JsonVariant& source, char* buffer, size_t size);
+template<size_t N> size_t serializeJson(const JsonVariant& source, char (&buffer)[N]) { return serializeJson(source, buffer, N); }
+size_t measureJson(const JsonVariant& source);
+
+// ---- Conversions ----
+
+template<class T> T JsonVariant::as() const {
+    typedef typename std::decay<T>::type U;
+    const HostJson::Node* n = node(false);
+    if (!n) return U();
+    switch (n->type) {
+        case HostJson::Node::Bool: return static_cast<U>(n->boolean);
+        case HostJson::Node::Integer: return static_cast<U>(n->integer);
+        case HostJson::Node::Unsigned: return static_cast<U>(n->uinteger);
+        case HostJson::Node::Float:
+        case HostJson::Node::Double: return static_cast<U>(n->number);
+        default: return U();
+    }
+}
+template<> inline const char* JsonVariant::as<const char*>() const {
+    const HostJson::Node* n = node(false);
+    return n && n->type == HostJson::Node::Text ? n->text.c_str() : nullptr;
+}
+template<> inline String JsonVariant::as<String>() const {
+    const HostJson::Node* n = node(false);
+    if (n && n->type == HostJson::Node::Text) return String(n->text);
+    std::string text;
+    HostJson::write(n, text);
+    return String(text);
+}
+template<> inline JsonVariant JsonVariant::as<JsonVariant>() const { return *this; }
+template<> inline JsonObject JsonVariant::as<JsonObject>() const {
+    const HostJson::Node* n = node(false);
+    return n && n->type == HostJson::Node::Object ? JsonObject(*this) : JsonObject();
+}
+template<> inline JsonArray JsonVariant::as<JsonArray>() const {
+    const HostJson::Node* n = node(false);
+    return n && n->type == HostJson::Node::Array ? JsonArray(*this) : JsonArray();
+}
+
+template<class T> bool JsonVariant::is() const {
+    typedef typename std::decay<T>::type U;
+    const HostJson::Node* n = node(false);
+    if (!n) return false;
+    if (std::is_same<U, bool>::value) return n->type == HostJson::Node::Bool;
+    if (std::is_integral<U>::value) return n->type == HostJson::Node::Integer || n->type == HostJson::Node::Unsigned;
+    if (std::is_floating_point<U>::value) {
+        return n->type == HostJson::Node::Integer || n->type == HostJson::Node::Unsigned ||
+               n->type == HostJson::Node::Float || n->type == HostJson::Node::Double;
+    }
+    return false;
+}
+template<> inline bool JsonVariant::is<const char*>() const {
+    const HostJson::Node* n = node(false);
+    return n && n->type == HostJson::Node::Text;
+}
+template<> inline bool JsonVariant::is<String>() const { return is<const char*>(); }
+template<> inline bool JsonVariant::is<JsonObject>() const {
+    const HostJson::Node* n = node(false);
+    return n && n->type == HostJson::Node::Object;
+}
+template<> inline bool JsonVariant::is<JsonArray>() const {
+    const HostJson::Node* n = node(false);
+    return n && n->type == HostJson::Node::Array;
+}
+
+inline const char* JsonVariant::operator|(const char* fallback) const {
+    return is<const char*>() ? as<const char*>() : fallback;
+}
+
+template<> inline JsonObject JsonVariant::to<JsonObject>() {
+    assign([](HostJson::Node& n) { n.reset(HostJson::Node::Object); });
+    return JsonObject(JsonVariant(node(false)));
+}
+template<> inline JsonArray JsonVariant::to<JsonArray>() {
+    assign([](HostJson::Node& n) { n.reset(HostJson::Node::Array); });
+    return JsonArray(JsonVariant(node(false)));
+}
+template<> inline JsonVariant JsonVariant::to<JsonVariant>() {
+    assign([](HostJson::Node& n) { n.reset(); });
+    return JsonVariant(node(false));
+}
+
+#endif // HOST_ARDUINO_JSON_H
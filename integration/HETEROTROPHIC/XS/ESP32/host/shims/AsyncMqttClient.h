@@ -0,0 +1,86 @@
+// AsyncMqttClient.h
+// Host stand-in of the MQTT client: no broker. The test plays the broker side of the last client constructed:
+// it connects it, hands it received messages, and sees every publish (hostOnPublish), which fails while the client
+// is not connected, as in the library.
+#ifndef HOST_ASYNC_MQTT_CLIENT_H
+#define HOST_ASYNC_MQTT_CLIENT_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <functional>
+
+enum class AsyncMqttClientDisconnectReason : uint8_t {
+    TCP_DISCONNECTED = 0,
+};
+
+struct AsyncMqttClientMessageProperties {
+    uint8_t qos;
+    bool dup;
+    bool retain;
+};
+
+class AsyncMqttClient {
+public:
+    typedef std::function<void(bool sessionPresent)> OnConnectUserCallback;
+    typedef std::function<void(AsyncMqttClientDisconnectReason reason)> OnDisconnectUserCallback;
+    typedef std::function<void(char* topic, char* payload, AsyncMqttClientMessageProperties properties, size_t len,
+                               size_t index, size_t total)> OnMessageUserCallback;
+    typedef std::function<void(uint16_t packetId)> OnPublishUserCallback;
+    typedef std::function<void(const char* topic, const char* payload, size_t length)> HostPublishHook;
+
+    AsyncMqttClient() { last() = this; }
+
+    AsyncMqttClient& onConnect(OnConnectUserCallback callback) { _onConnect = callback; return *this; }
+    AsyncMqttClient& onDisconnect(OnDisconnectUserCallback callback) { _onDisconnect = callback; return *this; }
+    AsyncMqttClient& onMessage(OnMessageUserCallback callback) { _onMessage = callback; return *this; }
+    AsyncMqttClient& onPublish(OnPublishUserCallback callback) { _onPublish = callback; return *this; }
+    AsyncMqttClient& setServer(IPAddress ip, uint16_t port) { (void)ip; (void)port; return *this; }
+    AsyncMqttClient& setClientId(const char* clientId) { (void)clientId; return *this; }
+    AsyncMqttClient& setKeepAlive(uint16_t keepAlive) { (void)keepAlive; return *this; }
+    AsyncMqttClient& setCleanSession(bool cleanSession) { (void)cleanSession; return *this; }
+
+    // The connection is up when the test says so (hostConnect)
+    void connect() {}
+    bool connected() const { return _connected; }
+    uint16_t subscribe(const char* topic, uint8_t qos) { (void)topic; (void)qos; return 1; }
+    uint16_t publish(const char* topic, uint8_t qos, bool retain, const char* payload = nullptr, size_t length = 0) {
+        (void)qos; (void)retain;
+        if (!_connected) return 0;
+        if (payload && length == 0) length = strlen(payload);
+        if (_publishHook) _publishHook(topic, payload, length);
+        return 1;
+    }
+
+    // ---- Host side ----
+    static AsyncMqttClient* hostLast() { return last(); }
+    void hostOnPublish(HostPublishHook hook) { _publishHook = hook; }
+
+    void hostConnect(bool sessionPresent = false) {
+        _connected = true;
+        if (_onConnect) _onConnect(sessionPresent);
+    }
+    void hostDisconnect() {
+        _connected = false;
+        if (_onDisconnect) _onDisconnect(AsyncMqttClientDisconnectReason::TCP_DISCONNECTED);
+    }
+    void hostReceive(const char* topic, const char* payload) {
+        AsyncMqttClientMessageProperties properties = {2, false, false};
+        size_t length = strlen(payload);
+        if (_onMessage) _onMessage(const_cast<char*>(topic), const_cast<char*>(payload), properties, length, 0, length);
+    }
+
+private:
+    static AsyncMqttClient*& last() {
+        static AsyncMqttClient* client = nullptr;
+        return client;
+    }
+
+    bool _connected = false;
+    OnConnectUserCallback _onConnect;
+    OnDisconnectUserCallback _onDisconnect;
+    OnMessageUserCallback _onMessage;
+    OnPublishUserCallback _onPublish;
+    HostPublishHook _publishHook;
+};
+
+#endif // HOST_ASYNC_MQTT_CLIENT_H
@@ -0,0 +1,95 @@
+// FS.cpp
+#include <FS.h>
+#include <LittleFS.h>
+
+#include <sys/stat.h>
+
+LittleFSFS LittleFS;
+
+namespace fs {
+
+File& File::operator=(File&& other) {
+    if (this != &other) {
+        close();
+        _file = other._file;
+        _directory = other._directory;
+        _path = other._path;
+        _name = other._name;
+        other._file = nullptr;
+        other._directory = nullptr;
+    }
+    return *this;
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    return _file ? fwrite(buffer, 1, size, _file) : 0;
+}
+
+int File::read(uint8_t* buffer, size_t size) {
+    return _file ? static_cast<int>(fread(buffer, 1, size, _file)) : -1;
+}
+
+bool File::seek(uint32_t position) {
+    return _file && fseek(_file, position, SEEK_SET) == 0;
+}
+
+size_t File::size() {
+    if (!_file) return 0;
+    fflush(_file);
+    struct stat status;
+    return stat(_path.c_str(), &status) == 0 ? status.st_size : 0;
+}
+
+void File::flush() {
+    if (_file) fflush(_file);
+}
+
+void File::close() {
+    if (_file) fclose(_file);
+    if (_directory) closedir(_directory);
+    _file = nullptr;
+    _directory = nullptr;
+}
+
+File File::openNextFile() {
+    File entry;
+    if (!_directory) return entry;
+    while (dirent* item = readdir(_directory)) {
+        if (item->d_name[0] == '.') continue;
+        entry._name = item->d_name;
+        entry._path = _path + "/" + item->d_name;
+        entry._file = fopen(entry._path.c_str(), "rb");
+        break;
+    }
+    return entry;
+}
+
+File FS::open(const String& path, const char* mode) {
+    File file;
+    file._path = _root + path.c_str();
+    size_t slash = file._path.rfind('/');
+    file._name = slash == std::string::npos ? file._path : file._path.substr(slash + 1);
+    struct stat status;
+    if (mode[0] == 'r' && stat(file._path.c_str(), &status) == 0 && S_ISDIR(status.st_mode)) {
+        file._directory = opendir(file._path.c_str());
+        return file;
+    }
+    file._file = fopen(file._path.c_str(), mode[0] == 'r' ? "rb" : (mode[0] == 'w' ? "wb" : "ab"));
+    return file;
+}
+
+bool FS::mkdir(const String& path) {
+    return ::mkdir((_root + path.c_str()).c_str(), 0755) == 0;
+}
+
+bool FS::remove(const String& path) {
+    return ::remove((_root + path.c_str()).c_str()) == 0;
+}
+
+} // namespace fs
+
+bool LittleFSFS::begin(bool formatOnFail) {
+    (void)formatOnFail;
+    struct stat status;
+    return (stat(_root.c_str(), &status) == 0 && S_ISDIR(status.st_mode)) || ::mkdir(_root.c_str(), 0755) == 0;
+}
@@ -0,0 +1,64 @@
+// FS.h
+// Host stand-in of the ESP32 file system API (fs::FS, fs::File) on a directory of the PC, so that what the sketch
+// writes survives the end of the process as the flash does a reset. Only what TelemetryQueue uses is provided.
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <Arduino.h>
+#include <dirent.h>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+class File {
+public:
+    File() {}
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+    File(File&& other) { *this = static_cast<File&&>(other); }
+    File& operator=(File&& other);
+    ~File() { close(); }
+
+    explicit operator bool() const { return _file != nullptr || _directory != nullptr; }
+
+    size_t write(const uint8_t* buffer, size_t size);
+    int read(uint8_t* buffer, size_t size);
+    bool seek(uint32_t position);
+    size_t size();
+    void flush();
+    void close();
+    const char* name() const { return _name.c_str(); }
+
+    // Directory: the next entry, a closed File after the last one
+    File openNextFile();
+
+private:
+    friend class FS;
+    FILE* _file = nullptr;
+    DIR* _directory = nullptr;
+    std::string _path;      // On the PC
+    std::string _name;      // Last component, as the ESP32 core 2.x returns it
+};
+
+class FS {
+public:
+    File open(const String& path, const char* mode = FILE_READ);
+    bool mkdir(const String& path);
+    bool remove(const String& path);
+
+    // Host side: directory of the PC the paths of the sketch are relative to
+    void hostSetRoot(const std::string& root) { _root = root; }
+    const std::string& hostRoot() const { return _root; }
+
+protected:
+    std::string _root = ".";
+};
+
+} // namespace fs
+
+using fs::File;
+
+#endif // HOST_FS_H
@@ -0,0 +1,155 @@
+// FreeRTOS.cpp
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/timers.h>
+#include <Arduino.h>
+#include "HostRuntime.h"
+
+struct HostQueue {
+    uint8_t* storage;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head = 0;
+    UBaseType_t count = 0;
+};
+
+struct HostTask {
+    char name[16];
+    TaskFunction_t function;
+    void* parameter;
+    bool used;
+    bool started;
+};
+
+struct HostTimer {
+    bool used;
+    bool active;
+};
+
+// Fixed tables: the sketch creates a handful of tasks and timers
+static const size_t MAX_TASKS = 8;
+static const size_t MAX_TIMERS = 8;
+static HostTask tasks[MAX_TASKS];
+static HostTimer timers[MAX_TIMERS];
+
+static uint64_t deadline(TickType_t ticks) {
+    if (ticks == portMAX_DELAY) return UINT64_MAX;
+    return HostRuntime::nowMicros() + static_cast<uint64_t>(ticks) * portTICK_PERIOD_MS * 1000;
+}
+
+// ---- Tasks ----
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreID) {
+    (void)stackDepth; (void)priority; (void)coreID;
+    std::unique_lock<std::mutex> lock = HostRuntime::lockKernel();
+    for (HostTask& task : tasks) {
+        if (task.used) continue;
+        strlcpy(task.name, name, sizeof(task.name));
+        task.function = function;
+        task.parameter = parameter;
+        task.used = true;
+        task.started = false;
+        if (created) *created = &task;
+        return pdPASS;
+    }
+    return pdFALSE;
+}
+
+bool hostStartTask(const char* name) {
+    HostTask* found = nullptr;
+    {
+        std::unique_lock<std::mutex> lock = HostRuntime::lockKernel();
+        for (HostTask& task : tasks) {
+            if (task.used && !task.started && strcmp(task.name, name) == 0) {
+                task.started = true;
+                found = &task;
+                break;
+            }
+        }
+    }
+    if (!found) return false;
+    HostRuntime::startTask(found->function, found->parameter);
+    return true;
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(millis() / portTICK_PERIOD_MS);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks * portTICK_PERIOD_MS);
+}
+
+// ---- Queues ----
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    HostQueue* queue = new (std::nothrow) HostQueue;
+    if (!queue) return nullptr;
+    queue->storage = new (std::nothrow) uint8_t[length * itemSize + 1];
+    if (!queue->storage) {
+        delete queue;
+        return nullptr;
+    }
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock = HostRuntime::lockKernel();
+    if (!HostRuntime::wait(lock, [queue] { return queue->count < queue->length; }, deadline(ticksToWait))) {
+        return pdFALSE;
+    }
+    UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    memcpy(queue->storage + tail * queue->itemSize, item, queue->itemSize);
+    queue->count++;
+    HostRuntime::notify();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock = HostRuntime::lockKernel();
+    if (!HostRuntime::wait(lock, [queue] { return queue->count > 0; }, deadline(ticksToWait))) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->storage + queue->head * queue->itemSize, queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    HostRuntime::notify();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::unique_lock<std::mutex> lock = HostRuntime::lockKernel();
+    return queue->count;
+}
+
+// ---- Timers ----
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* timerID,
+                           TimerCallbackFunction_t callback) {
+    (void)name; (void)period; (void)autoReload; (void)timerID; (void)callback;
+    for (HostTimer& timer : timers) {
+        if (timer.used) continue;
+        timer.used = true;
+        timer.active = false;
+        return &timer;
+    }
+    return nullptr;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticksToWait) {
+    (void)ticksToWait;
+    if (!timer) return pdFALSE;
+    timer->active = true;
+    return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticksToWait) {
+    (void)ticksToWait;
+    if (!timer) return pdFALSE;
+    timer->active = false;
+    return pdPASS;
+}
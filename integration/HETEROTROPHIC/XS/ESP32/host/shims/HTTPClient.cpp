@@ -0,0 +1,103 @@
+// HTTPClient.cpp
+#include <HTTPClient.h>
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+    _client = &client;
+    _headers.clear();
+    _response = String();
+    std::string text = url.str();
+    if (text.compare(0, 7, "http://") != 0) return false;
+    size_t hostStart = 7;
+    size_t pathStart = text.find('/', hostStart);
+    std::string authority = text.substr(hostStart, pathStart == std::string::npos ? std::string::npos : pathStart - hostStart);
+    _uri = pathStart == std::string::npos ? String("/") : String(text.substr(pathStart));
+    size_t colon = authority.find(':');
+    _host = String(authority.substr(0, colon));
+    _port = colon == std::string::npos ? 80 : static_cast<uint16_t>(atoi(authority.c_str() + colon + 1));
+    return true;
+}
+
+void HTTPClient::addHeader(const String& name, const String& value) {
+    _headers.push_back(name.str() + ": " + value.str());
+}
+
+int HTTPClient::POST(const String& payload) {
+    return sendRequest("POST", payload);
+}
+
+void HTTPClient::end() {
+    if (_client && !(_reuse && _canReuse)) _client->stop();
+}
+
+int HTTPClient::sendRequest(const char* method, const String& payload) {
+    if (!_client) return HTTPC_ERROR_NOT_CONNECTED;
+    _canReuse = false;
+    _client->setTimeout(_timeout);
+    if (!_client->connected() && !_client->connect(_host.c_str(), _port, _connectTimeout)) {
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+
+    std::string request = std::string(method) + " " + _uri.str() + " HTTP/1.1\r\nHost: " + _host.str() + "\r\n" +
+                          "User-Agent: ESP32HTTPClient\r\nConnection: " + (_reuse ? "keep-alive" : "close") + "\r\n";
+    for (const std::string& header : _headers) request += header + "\r\n";
+    request += "Content-Length: " + std::to_string(payload.length()) + "\r\n\r\n" + payload.str();
+    if (_client->write(reinterpret_cast<const uint8_t*>(request.data()), request.size()) != request.size()) {
+        _client->stop();
+        return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+    }
+
+    // Status line and headers
+    std::string buffer;
+    std::string line;
+    if (!readLine(buffer, line)) {
+        _client->stop();
+        return HTTPC_ERROR_READ_TIMEOUT;
+    }
+    int code = 0;
+    if (sscanf(line.c_str(), "HTTP/1.%*d %d", &code) != 1) {
+        _client->stop();
+        return HTTPC_ERROR_CONNECTION_LOST;
+    }
+    size_t contentLength = 0;
+    bool keepAlive = true;
+    while (readLine(buffer, line) && !line.empty()) {
+        std::string name = line.substr(0, line.find(':'));
+        for (char& c : name) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        std::string value = line.size() > name.size() + 1 ? line.substr(name.size() + 1) : "";
+        while (!value.empty() && value[0] == ' ') value.erase(0, 1);
+        if (name == "content-length") contentLength = strtoul(value.c_str(), nullptr, 10);
+        if (name == "connection" && (value == "close" || value == "Close")) keepAlive = false;
+    }
+    if (!line.empty()) {
+        _client->stop();
+        return HTTPC_ERROR_READ_TIMEOUT;
+    }
+
+    // Body
+    uint8_t chunk[1024];
+    while (buffer.size() < contentLength) {
+        int n = _client->read(chunk, sizeof(chunk));
+        if (n < 0) {
+            _client->stop();
+            return HTTPC_ERROR_READ_TIMEOUT;
+        }
+        buffer.append(reinterpret_cast<char*>(chunk), n);
+    }
+    _response = String(buffer.substr(0, contentLength));
+    _canReuse = keepAlive;
+    return code;
+}
+
+// Next line of the response, without its CRLF; buffer keeps what was read past it
+bool HTTPClient::readLine(std::string& buffer, std::string& line) {
+    uint8_t chunk[512];
+    size_t end;
+    while ((end = buffer.find("\r\n")) == std::string::npos) {
+        int n = _client->read(chunk, sizeof(chunk));
+        if (n < 0) return false;
+        buffer.append(reinterpret_cast<char*>(chunk), n);
+    }
+    line = buffer.substr(0, end);
+    buffer.erase(0, end + 2);
+    return true;
+}
@@ -0,0 +1,52 @@
+// HTTPClient.h
+// Host stand-in of the ESP32 HTTPClient: HTTP/1.1 requests on the WiFiClient given to begin(), kept open between
+// requests with setReuse(true) unless the server answers "Connection: close", reopened when the server closed it.
+#ifndef HOST_HTTP_CLIENT_H
+#define HOST_HTTP_CLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <vector>
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_BAD_REQUEST 400
+#define HTTP_CODE_PAYLOAD_TOO_LARGE 413
+#define HTTP_CODE_UNPROCESSABLE_ENTITY 422
+#define HTTP_CODE_SERVICE_UNAVAILABLE 503
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+class HTTPClient {
+public:
+    void setReuse(bool reuse) { _reuse = reuse; }
+    void setTimeout(uint16_t timeout) { _timeout = timeout; }
+    void setConnectTimeout(int32_t timeout) { _connectTimeout = timeout; }
+
+    // url: http://host[:port]/path
+    bool begin(WiFiClient& client, const String& url);
+    void addHeader(const String& name, const String& value);
+    int POST(const String& payload);
+    String getString() const { return _response; }
+    void end();
+
+private:
+    WiFiClient* _client = nullptr;
+    bool _reuse = true;
+    bool _canReuse = false;
+    uint16_t _timeout = 5000;
+    int32_t _connectTimeout = 5000;
+    String _host;
+    uint16_t _port = 80;
+    String _uri;
+    std::vector<std::string> _headers;
+    String _response;
+
+    int sendRequest(const char* method, const String& payload);
+    bool readLine(std::string& buffer, std::string& line);
+};
+
+#endif // HOST_HTTP_CLIENT_H
@@ -0,0 +1,199 @@
+// HostRuntime.cpp
+#include "HostRuntime.h"
+#include <Arduino.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+void setup();
+void loop();
+
+namespace {
+
+// A task blocked with the virtual clock, woken by whoever makes ready() true or moves the clock past deadline
+struct Waiter {
+    const std::function<bool()>* ready;
+    uint64_t deadline;
+    bool woken;
+    std::condition_variable wake;
+};
+
+struct Kernel {
+    std::mutex mutex;
+    std::condition_variable changed;    // Real time: any change. Virtual clock: a task blocked.
+    std::vector<Waiter*> waiters;
+    int runningTasks = 0;               // Started tasks not blocked, virtual clock
+};
+
+// Never destroyed: the task threads are still blocked in it when the process exits
+Kernel& kernel() {
+    static Kernel* instance = new Kernel;
+    return *instance;
+}
+
+thread_local bool inTask = false;
+std::atomic<uint64_t> clockMicros(0);
+std::atomic<bool> realTimeClock(false);
+std::chrono::steady_clock::time_point realTimeStart = std::chrono::steady_clock::now();
+
+// Kernel locked
+void wakeDue() {
+    Kernel& k = kernel();
+    for (auto it = k.waiters.begin(); it != k.waiters.end();) {
+        Waiter* waiter = *it;
+        if ((*waiter->ready)() || clockMicros >= waiter->deadline) {
+            waiter->woken = true;
+            k.runningTasks++;
+            waiter->wake.notify_one();
+            it = k.waiters.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void waitIdle(std::unique_lock<std::mutex>& lock) {
+    kernel().changed.wait(lock, [] { return kernel().runningTasks == 0; });
+}
+
+uint64_t nextWakeup() {
+    uint64_t next = UINT64_MAX;
+    for (Waiter* waiter : kernel().waiters) next = std::min(next, waiter->deadline);
+    return next;
+}
+
+// Virtual clock, kernel locked: move the clock to end through every task wakeup on the way
+void runUntil(std::unique_lock<std::mutex>& lock, uint64_t end) {
+    waitIdle(lock);
+    for (uint64_t next = nextWakeup(); next <= end; next = nextWakeup()) {
+        clockMicros = std::max<uint64_t>(clockMicros, next);
+        wakeDue();
+        waitIdle(lock);
+    }
+    clockMicros = std::max<uint64_t>(clockMicros, end);
+    wakeDue();
+    waitIdle(lock);
+}
+
+} // namespace
+
+// The clock goes on from where it is, so that a test can boot on the virtual clock (setup() waits 3 s) first
+void HostRuntime::setRealTime(bool enabled) {
+    if (enabled == realTimeClock) return;
+    if (enabled) {
+        realTimeStart = std::chrono::steady_clock::now() - std::chrono::microseconds(clockMicros.load());
+    } else {
+        clockMicros = nowMicros();
+    }
+    realTimeClock = enabled;
+}
+
+bool HostRuntime::realTime() {
+    return realTimeClock;
+}
+
+uint64_t HostRuntime::nowMicros() {
+    if (!realTimeClock) return clockMicros;
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now() - realTimeStart).count();
+}
+
+void HostRuntime::advanceMicros(uint64_t us) {
+    if (realTimeClock) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+        return;
+    }
+    std::unique_lock<std::mutex> lock = lockKernel();
+    if (inTask) {
+        wait(lock, [] { return false; }, clockMicros + us);
+    } else {
+        runUntil(lock, clockMicros + us);
+    }
+}
+
+void HostRuntime::boot() {
+    setup();
+}
+
+void HostRuntime::runFor(uint64_t durationMs) {
+    uint64_t end = nowMicros() + durationMs * 1000;
+    while (nowMicros() < end) {
+        loop();
+    }
+}
+
+void HostRuntime::settle() {
+    if (realTimeClock) return;
+    std::unique_lock<std::mutex> lock = lockKernel();
+    waitIdle(lock);
+}
+
+void HostRuntime::setConsoleEcho(bool enabled) {
+    Serial.hostSetEcho(enabled ? stdout : nullptr);
+}
+
+std::string HostRuntime::takeConsole() {
+    return Serial.hostTakeOutput();
+}
+
+std::unique_lock<std::mutex> HostRuntime::lockKernel() {
+    return std::unique_lock<std::mutex>(kernel().mutex);
+}
+
+bool HostRuntime::wait(std::unique_lock<std::mutex>& lock, const std::function<bool()>& ready, uint64_t deadline) {
+    Kernel& k = kernel();
+    if (realTimeClock) {
+        if (deadline == UINT64_MAX) {
+            k.changed.wait(lock, ready);
+            return true;
+        }
+        return k.changed.wait_until(lock, realTimeStart + std::chrono::microseconds(deadline), ready);
+    }
+    if (inTask) {
+        while (!ready()) {
+            if (clockMicros >= deadline) return false;
+            Waiter waiter{&ready, deadline, false, {}};
+            k.waiters.push_back(&waiter);
+            k.runningTasks--;
+            k.changed.notify_all();
+            waiter.wake.wait(lock, [&waiter] { return waiter.woken; });
+        }
+        return true;
+    }
+    // The test thread
+    for (;;) {
+        waitIdle(lock);
+        if (ready()) return true;
+        if (clockMicros >= deadline) return false;
+        uint64_t next = std::min(deadline, nextWakeup());
+        if (next == UINT64_MAX) {
+            fprintf(stderr, "HostRuntime: the test thread waits forever for the tasks, which are all blocked\n");
+            abort();
+        }
+        clockMicros = std::max<uint64_t>(clockMicros, next);
+        wakeDue();
+    }
+}
+
+void HostRuntime::notify() {
+    if (realTimeClock) {
+        kernel().changed.notify_all();
+    } else {
+        wakeDue();
+    }
+}
+
+void HostRuntime::startTask(void (*function)(void*), void* parameter) {
+    {
+        std::unique_lock<std::mutex> lock = lockKernel();
+        if (!realTimeClock) kernel().runningTasks++;
+    }
+    std::thread([function, parameter] {
+        inTask = true;
+        function(parameter);
+    }).detach();
+}
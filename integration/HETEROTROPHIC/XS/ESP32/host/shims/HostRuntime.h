@@ -0,0 +1,55 @@
+// HostRuntime.h
+// Drives the sketch on the host: the clock, the setup()/loop() calls and the scheduler of the FreeRTOS tasks.
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+#include <stdint.h>
+#include <functional>
+#include <mutex>
+#include <string>
+
+/*
+ * Two clocks:
+ * - Virtual (default): time only moves with delay() in loop() and the functions below. The started tasks run as
+ *   threads but in no virtual time: the clock waits for all of them to block (queue or delay) before it moves, then
+ *   wakes those whose wait is over, each at its own time. A run is deterministic and as fast as the CPU allows.
+ * - Real time: the steady clock of the PC, every wait lasts what it says. For the tests that measure the sketch
+ *   against a real socket. Tasks must be started after the switch.
+ */
+class HostRuntime {
+public:
+    static void setRealTime(bool enabled);
+    static bool realTime();
+
+    static uint64_t nowMicros();
+    // From a task: wait for the clock to move by us (another thread moves it)
+    static void advanceMicros(uint64_t us);
+    static void advanceMillis(uint64_t ms) { advanceMicros(ms * 1000); }
+
+    // Run the sketch setup() (once per process: the sketch objects are globals)
+    static void boot();
+    // Call loop() until the clock has moved by duration (loop() ends with a 10 ms delay)
+    static void runFor(uint64_t durationMs);
+    // Virtual clock: return once every started task is blocked, so that the test sees what they did
+    static void settle();
+
+    // Echo the console output to stdout (off by default, the output is also kept in Serial)
+    static void setConsoleEcho(bool enabled);
+    // Console output since the last call
+    static std::string takeConsole();
+
+    // ---- Scheduler of the FreeRTOS stand-in (freertos/), one lock for every queue as on a single core ----
+    static std::unique_lock<std::mutex> lockKernel();
+    /*
+     * Block the calling thread until ready() or until the clock reaches deadline (UINT64_MAX: no timeout).
+     * ready() is called with the kernel locked. From the test thread with the virtual clock, nobody else moves the
+     * clock: the wait moves it from one task wakeup to the next.
+     * @return: ready()
+     */
+    static bool wait(std::unique_lock<std::mutex>& lock, const std::function<bool()>& ready, uint64_t deadline);
+    // Kernel locked: the state a waiting thread may be waiting for has changed
+    static void notify();
+    static void startTask(void (*function)(void*), void* parameter);
+};
+
+#endif // HOST_RUNTIME_H
@@ -0,0 +1,33 @@
+// IPAddress.h
+#ifndef HOST_IP_ADDRESS_H
+#define HOST_IP_ADDRESS_H
+
+#include <Arduino.h>
+
+class IPAddress : public Printable {
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _bytes{a, b, c, d} {}
+
+    bool fromString(const char* address) {
+        unsigned int parts[4];
+        char end;
+        if (sscanf(address, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &end) != 4) return false;
+        for (int i = 0; i < 4; i++) {
+            if (parts[i] > 255) return false;
+            _bytes[i] = static_cast<uint8_t>(parts[i]);
+        }
+        return true;
+    }
+    String toString() const {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+        return String(text);
+    }
+    size_t printTo(Print& p) const override { return p.print(toString()); }
+
+private:
+    uint8_t _bytes[4] = {0, 0, 0, 0};
+};
+
+#endif // HOST_IP_ADDRESS_H
@@ -0,0 +1,15 @@
+// LittleFS.h
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include <FS.h>
+
+class LittleFSFS : public fs::FS {
+public:
+    // Mounting creates the root directory, as formatting a blank partition
+    bool begin(bool formatOnFail = false);
+};
+
+extern LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
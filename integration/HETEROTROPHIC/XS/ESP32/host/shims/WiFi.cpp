@@ -0,0 +1,72 @@
+// WiFi.cpp
+#include <WiFi.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+void WiFiClass::hostSetConnected(bool connected) {
+    if (connected == _connected) return;
+    _connected = connected;
+    if (_handler) _handler(connected ? ARDUINO_EVENT_WIFI_STA_GOT_IP : ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeout) {
+    (void)host; (void)port; (void)timeout;
+    stop();
+    if (!WiFi.isConnected() || WiFi.hostServerPort() == 0) return 0;
+    _socket = socket(AF_INET, SOCK_STREAM, 0);
+    if (_socket < 0) return 0;
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(WiFi.hostServerPort());
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        stop();
+        return 0;
+    }
+    int one = 1;
+    setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return 1;
+}
+
+// Open and not closed by the peer (a pending end of stream reads as 0)
+uint8_t WiFiClient::connected() {
+    if (_socket < 0) return 0;
+    char c;
+    ssize_t n = recv(_socket, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        stop();
+        return 0;
+    }
+    return 1;
+}
+
+void WiFiClient::stop() {
+    if (_socket >= 0) close(_socket);
+    _socket = -1;
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (_socket >= 0 && written < size) {
+        ssize_t n = send(_socket, buffer + written, size - written, MSG_NOSIGNAL);
+        if (n <= 0) break;
+        written += n;
+    }
+    return written;
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    if (_socket < 0) return -1;
+    pollfd descriptor = {_socket, POLLIN, 0};
+    if (poll(&descriptor, 1, static_cast<int>(_timeout)) <= 0) return -1;
+    ssize_t n = recv(_socket, buffer, size, 0);
+    return n > 0 ? static_cast<int>(n) : -1;
+}
@@ -0,0 +1,71 @@
+// WiFi.h
+// Host stand-in of the ESP32 WiFi library. The link is up when the test says so (hostSetConnected), which also
+// delivers the events of the station to the handler of the sketch. Every TCP connection of a WiFiClient goes to the
+// server of the test on 127.0.0.1 (hostSetServerPort), whatever the address the sketch asks for.
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <atomic>
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_CONNECTED = 3,
+    WL_DISCONNECTED = 6,
+} wl_status_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+} arduino_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+typedef void (*WiFiEventCb)(WiFiEvent_t event);
+
+class WiFiClass {
+public:
+    void begin(const char* ssid, const char* password) { (void)ssid; (void)password; }
+    wl_status_t status() const { return _connected ? WL_CONNECTED : WL_DISCONNECTED; }
+    bool isConnected() const { return _connected; }
+    IPAddress localIP() const { return _connected ? IPAddress(192, 168, 1, 42) : IPAddress(); }
+    void onEvent(WiFiEventCb handler) { _handler = handler; }
+
+    // ---- Host side ----
+    void hostSetConnected(bool connected);
+    void hostSetServerPort(uint16_t port) { _serverPort = port; }
+    uint16_t hostServerPort() const { return _serverPort; }
+
+private:
+    std::atomic<bool> _connected{false};
+    std::atomic<uint16_t> _serverPort{0};
+    WiFiEventCb _handler = nullptr;
+};
+
+extern WiFiClass WiFi;
+
+/*
+ * TCP client on a socket of the PC. Reads wait on the socket up to the timeout instead of polling available():
+ * with the virtual clock a request then takes no virtual time, only the real time of the socket.
+ */
+class WiFiClient {
+public:
+    WiFiClient() {}
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+    ~WiFiClient() { stop(); }
+
+    // Fails without a WiFi link. timeout: ms
+    int connect(const char* host, uint16_t port, int32_t timeout);
+    uint8_t connected();
+    void stop();
+    size_t write(const uint8_t* buffer, size_t size);
+    // At least one byte, -1 on timeout or when the peer closed the connection
+    int read(uint8_t* buffer, size_t size);
+    void setTimeout(uint32_t timeout) { _timeout = timeout; }
+
+private:
+    int _socket = -1;
+    uint32_t _timeout = 5000;
+};
+
+#endif // HOST_WIFI_H
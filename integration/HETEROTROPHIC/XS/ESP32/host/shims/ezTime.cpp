@@ -0,0 +1,31 @@
+// ezTime.cpp
+#include <ezTime.h>
+#include <atomic>
+
+Timezone UTC;
+
+static std::atomic<time_t> setEpoch(0);
+static std::atomic<unsigned long> setMillis(0);
+static std::atomic<bool> clockSet(false);
+
+void hostSetTime(time_t epoch) {
+    setEpoch = epoch;
+    setMillis = millis();
+    clockSet = true;
+}
+
+timeStatus_t timeStatus() {
+    return clockSet ? timeSet : timeNotSet;
+}
+
+time_t hostNow() {
+    return clockSet ? setEpoch + static_cast<time_t>((millis() - setMillis) / 1000) : 0;
+}
+
+String Timezone::dateTime(time_t t, ezLocalOrUTC_t localOrUTC, const String& format) {
+    (void)localOrUTC; (void)format;
+    char text[9];
+    snprintf(text, sizeof(text), "%02d:%02d:%02d", static_cast<int>(t / 3600 % 24), static_cast<int>(t / 60 % 60),
+             static_cast<int>(t % 60));
+    return String(text);
+}
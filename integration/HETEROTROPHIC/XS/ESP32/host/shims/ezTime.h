@@ -0,0 +1,33 @@
+// ezTime.h
+// No NTP on the host: the clock is unset (timeStatus() is timeNotSet) until the test sets it with hostSetTime(),
+// it then follows millis(). Only the "H:i:s" format of dateTime() is provided, in UTC.
+#ifndef HOST_EZTIME_H
+#define HOST_EZTIME_H
+
+#include <Arduino.h>
+#include <time.h>
+
+enum timeStatus_t { timeNotSet, timeSet, timeNeedsSync };
+enum ezLocalOrUTC_t { LOCAL_TIME, UTC_TIME };
+
+void hostSetTime(time_t epoch);
+timeStatus_t timeStatus();
+time_t hostNow();
+
+class Timezone {
+public:
+    bool setLocation(const String& location) { (void)location; return true; }
+    time_t now() { return hostNow(); }
+    String dateTime(const String& format) { return dateTime(now(), UTC_TIME, format); }
+    String dateTime(time_t t, ezLocalOrUTC_t localOrUTC, const String& format);
+};
+
+extern Timezone UTC;
+
+inline bool waitForSync(uint16_t timeout = 0) {
+    (void)timeout;
+    return timeStatus() == timeSet;
+}
+inline void events() {}
+
+#endif // HOST_EZTIME_H
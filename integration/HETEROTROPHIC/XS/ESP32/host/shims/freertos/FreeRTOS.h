@@ -0,0 +1,24 @@
+// FreeRTOS.h
+// Host stand-in of the FreeRTOS types and of the queues, tasks and timers used by the bridge sketch (queue.h,
+// task.h, timers.h). Tasks run as threads under the scheduler of HostRuntime.h. Tick = 1 ms.
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+
+struct HostQueue;
+typedef HostQueue* QueueHandle_t;
+
+#endif // HOST_FREERTOS_H
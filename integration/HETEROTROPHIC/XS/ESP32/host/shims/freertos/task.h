@@ -0,0 +1,23 @@
+// task.h
+// Created tasks do not run by themselves: the test starts the ones it needs as threads with hostStartTask(),
+// once setup() has created them.
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void* parameter);
+struct HostTask;
+typedef HostTask* TaskHandle_t;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreID);
+
+TickType_t xTaskGetTickCount();
+void vTaskDelay(TickType_t ticks);
+
+// Host side: run the task created under this name in its own thread; false if there is none or it already runs.
+// A started task cannot be stopped, it ends with the process.
+bool hostStartTask(const char* name);
+
+#endif // HOST_FREERTOS_TASK_H
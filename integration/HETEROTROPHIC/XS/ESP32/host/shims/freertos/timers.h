@@ -0,0 +1,17 @@
+// timers.h
+// Software timers never fire on the host: the tests drive the WiFi and MQTT connection events the timers retry.
+#ifndef HOST_FREERTOS_TIMERS_H
+#define HOST_FREERTOS_TIMERS_H
+
+#include "FreeRTOS.h"
+
+struct HostTimer;
+typedef HostTimer* TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t timer);
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* timerID,
+                           TimerCallbackFunction_t callback);
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticksToWait);
+
+#endif // HOST_FREERTOS_TIMERS_H
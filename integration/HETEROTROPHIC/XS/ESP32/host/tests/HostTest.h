@@ -0,0 +1,80 @@
+// HostTest.h
+// Minimal checks for the host tests: a failed CHECK prints its location and makes the test exit with 1.
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static int hostTestFailures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            hostTestFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(value, expected, tolerance) \
+    do { \
+        double checkValue = (value); \
+        double checkExpected = (expected); \
+        if (!(checkValue >= checkExpected - (tolerance) && checkValue <= checkExpected + (tolerance))) { \
+            fprintf(stderr, "%s:%d: CHECK_NEAR failed: %s = %g, expected %g +/- %g\n", __FILE__, __LINE__, \
+                    #value, checkValue, checkExpected, static_cast<double>(tolerance)); \
+            hostTestFailures++; \
+        } \
+    } while (0)
+
+inline int testResult() {
+    if (hostTestFailures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", hostTestFailures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
+
+// Wall clock time, to report how much faster than real time a simulated run went
+inline double wallSeconds() {
+    using namespace std::chrono;
+    return duration_cast<duration<double>>(steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Run body(fd) in a child process, for runs that end in a simulated power cut (the child exits from inside the
+ * firmware). The child reports its results with sendToParent(fd, value).
+ * @return: the exit code of the child, -1 if it did not exit normally.
+ */
+template<class F> inline int runChild(F body, std::vector<long>& results) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    fflush(stdout);     // Or the child would print the parent's pending output again
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        body(fds[1]);
+        _exit(0);
+    }
+    close(fds[1]);
+    long value;
+    results.clear();
+    while (read(fds[0], &value, sizeof(value)) == sizeof(value)) {
+        results.push_back(value);
+    }
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+inline void sendToParent(int fd, long value) {
+    if (write(fd, &value, sizeof(value)) != sizeof(value)) _exit(2);
+}
+
+#endif // HOST_TEST_H
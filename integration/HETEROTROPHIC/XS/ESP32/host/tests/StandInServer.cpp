@@ -0,0 +1,165 @@
+// StandInServer.cpp
+#include "StandInServer.h"
+#include <ArduinoJson.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+StandInServer::StandInServer() {
+    listen();
+    _acceptThread = std::thread(&StandInServer::acceptLoop, this);
+}
+
+StandInServer::~StandInServer() {
+    _stopping = true;
+    _acceptThread.join();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        closeListener();
+        for (int socket : _sockets) shutdown(socket, SHUT_RDWR);
+    }
+    for (std::thread& thread : _threads) thread.join();
+}
+
+// On the port of the first call, an ephemeral one at first
+bool StandInServer::listen() {
+    _listener = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(_port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(_listener, 8) != 0 ||
+        getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        perror("StandInServer");
+        closeListener();
+        return false;
+    }
+    _port = ntohs(address.sin_port);
+    return true;
+}
+
+void StandInServer::closeListener() {
+    if (_listener >= 0) close(_listener);
+    _listener = -1;
+}
+
+void StandInServer::setMode(Mode mode) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (mode == Mode::DOWN && _mode != Mode::DOWN) {
+        closeListener();
+        for (int socket : _sockets) shutdown(socket, SHUT_RDWR);
+    } else if (mode != Mode::DOWN && _mode == Mode::DOWN) {
+        listen();
+    }
+    _mode = mode;
+}
+
+std::vector<StandInServer::Entry> StandInServer::entries() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries;
+}
+
+void StandInServer::acceptLoop() {
+    while (!_stopping) {
+        int listener;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            listener = _listener;
+        }
+        pollfd descriptor = {listener, POLLIN, 0};
+        if (listener < 0 || poll(&descriptor, 1, 10) <= 0) {
+            if (listener < 0) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_listener != listener) continue;
+        int socket = accept(listener, nullptr, nullptr);
+        if (socket < 0) continue;
+        _connections++;
+        _sockets.push_back(socket);
+        _threads.emplace_back(&StandInServer::serve, this, socket);
+    }
+}
+
+void StandInServer::serve(int socket) {
+    std::string buffer;
+    char chunk[4096];
+    for (;;) {
+        // Request line and headers
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            ssize_t n = recv(socket, chunk, sizeof(chunk), 0);
+            if (n <= 0) goto closed;
+            buffer.append(chunk, n);
+        }
+        std::string head = buffer.substr(0, headerEnd);
+        buffer.erase(0, headerEnd + 4);
+        std::string lowerHead = head;
+        std::transform(lowerHead.begin(), lowerHead.end(), lowerHead.begin(), ::tolower);
+        size_t lengthField = lowerHead.find("content-length:");
+        size_t contentLength = lengthField == std::string::npos ? 0 : strtoul(head.c_str() + lengthField + 15, nullptr, 10);
+        while (buffer.size() < contentLength) {
+            ssize_t n = recv(socket, chunk, sizeof(chunk), 0);
+            if (n <= 0) goto closed;
+            buffer.append(chunk, n);
+        }
+        std::string body = buffer.substr(0, contentLength);
+        buffer.erase(0, contentLength);
+        _requests++;
+
+        if (_responseDelay > 0) std::this_thread::sleep_for(std::chrono::milliseconds(_responseDelay.load()));
+        int status;
+        if (_mode == Mode::FAILING) {
+            status = 500;
+        } else if (head.compare(0, 26, "POST /sensor_data/batch HT") != 0) {
+            status = 404;
+            _invalidRequests++;
+        } else {
+            status = receiveBatch(body);
+        }
+        std::string answer = status == 200 ? "{\"status\":\"success\"}" : "{\"detail\":\"error\"}";
+        std::string response = "HTTP/1.1 " + std::to_string(status) + (status == 200 ? " OK" : " Error") +
+                               "\r\nContent-Type: application/json\r\nContent-Length: " +
+                               std::to_string(answer.size()) + "\r\n\r\n" + answer;
+        if (send(socket, response.data(), response.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(response.size())) {
+            break;
+        }
+    }
+closed:
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sockets.erase(std::remove(_sockets.begin(), _sockets.end(), socket), _sockets.end());
+    close(socket);
+}
+
+int StandInServer::receiveBatch(const std::string& body) {
+    JsonDocument doc;
+    if (deserializeJson(doc, body) || !doc.is<JsonArray>()) {
+        _invalidRequests++;
+        return 422;
+    }
+    JsonArray batch = doc.as<JsonArray>();
+    std::vector<Entry> received;
+    for (size_t i = 0; i < batch.size(); i++) {
+        JsonVariant entry = batch[i];
+        if (!entry["arduino_value"].is<JsonObject>() || !entry["timestamp"].is<const char*>() ||
+            !entry["epoch"].is<long>()) {
+            _invalidRequests++;
+            return 422;
+        }
+        JsonVariant sequence = entry["arduino_value"]["actuatorTimers"]["airPumpRemaining"];
+        received.push_back({sequence.is<long>() ? sequence.as<long>() : -1, entry["epoch"].as<uint32_t>()});
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.insert(_entries.end(), received.begin(), received.end());
+    return 200;
+}
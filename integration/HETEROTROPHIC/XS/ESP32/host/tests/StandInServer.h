@@ -0,0 +1,66 @@
+// StandInServer.h
+// Stand-in of the web server (SERVER/raspberry_pi/ServerFastAPI, POST /sensor_data/batch) on 127.0.0.1, for the
+// bridge to send to through the WiFiClient stand-in. HTTP/1.1 with keep-alive, one thread per connection.
+// Every entry of a batch is checked as the server does (object with arduino_value, timestamp and epoch) and kept
+// with the sequence number the test put in its frame (actuatorTimers.airPumpRemaining).
+#ifndef STAND_IN_SERVER_H
+#define STAND_IN_SERVER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class StandInServer {
+public:
+    struct Entry {
+        long sequence;      // -1 when the entry is not a frame of the test
+        uint32_t epoch;
+    };
+
+    enum class Mode {
+        UP,         // 200 for a valid batch
+        DOWN,       // Not listening: connections refused, open ones closed
+        FAILING     // 500 for every request (database error): the bridge must keep the batch
+    };
+
+    StandInServer();
+    ~StandInServer();
+
+    uint16_t port() const { return _port; }
+    void setMode(Mode mode);
+    // Real time taken to answer each request, ms
+    void setResponseDelay(unsigned int ms) { _responseDelay = ms; }
+
+    std::vector<Entry> entries();
+    unsigned long requests() const { return _requests; }
+    unsigned long connections() const { return _connections; }
+    // Requests that were not a valid batch POST (answered 422)
+    unsigned long invalidRequests() const { return _invalidRequests; }
+
+private:
+    uint16_t _port = 0;
+    int _listener = -1;
+    std::atomic<Mode> _mode{Mode::UP};
+    std::atomic<bool> _stopping{false};
+    std::atomic<unsigned int> _responseDelay{0};
+    std::atomic<unsigned long> _requests{0};
+    std::atomic<unsigned long> _connections{0};
+    std::atomic<unsigned long> _invalidRequests{0};
+
+    std::mutex _mutex;
+    std::vector<Entry> _entries;
+    std::vector<int> _sockets;
+    std::vector<std::thread> _threads;
+    std::thread _acceptThread;
+
+    bool listen();
+    void closeListener();
+    void acceptLoop();
+    void serve(int socket);
+    // HTTP status of the answer to a batch
+    int receiveBatch(const std::string& body);
+};
+
+#endif // STAND_IN_SERVER_H
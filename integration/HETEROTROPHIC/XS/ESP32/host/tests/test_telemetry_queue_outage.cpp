@@ -0,0 +1,164 @@
+// Store-and-forward of the bridge (TelemetryQueue and the uplink task) across a 30-minute network outage, against
+// the stand-in web server. The Teensy sends a binary frame every second (15 times its normal rate), numbered in
+// actuatorRemaining[0]. The network works for 5 minutes, then WiFi is lost for 30 minutes, during which the ESP32
+// also resets once (the frames already queued in flash must survive it). WiFi comes back with the server still
+// down, then failing (HTTP 500), then up: every frame must reach the server once, in order, with the time it was
+// received, and the queue must end empty with nothing dropped.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include "StandInServer.h"
+#include <Arduino.h>
+#include <AsyncMqttClient.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <ezTime.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "TelemetryProtocol.h"
+
+static const char* FLASH_DIR = "outage_flash";
+static const time_t START_EPOCH = 1760000000;
+static const unsigned long FRAME_INTERVAL = 1000;   // ms
+static const unsigned long MINUTE = 60000;
+
+static long nextSequence = 0;
+static std::string lastStatus;
+
+// One frame from the Teensy, then the loop runs until the next one is due
+static void sendFrames(unsigned long duration) {
+    for (unsigned long elapsed = 0; elapsed < duration; elapsed += FRAME_INTERVAL) {
+        TelemetryProtocol::AllDataFrame frame = {};
+        strlcpy(frame.currentProgram, "Fermentation", sizeof(frame.currentProgram));
+        frame.programState = 2;
+        frame.waterTemp = 30.0f;
+        frame.pH = 7.0f;
+        frame.actuatorRemaining[0] = static_cast<uint32_t>(nextSequence++);
+        uint8_t buffer[TelemetryProtocol::MAX_FRAME_SIZE];
+        size_t length = TelemetryProtocol::encodeAllData(frame, buffer, sizeof(buffer));
+        Serial2.hostInject(std::string(reinterpret_cast<char*>(buffer), length));
+        HostRuntime::runFor(FRAME_INTERVAL);
+        HostRuntime::takeConsole();
+    }
+}
+
+static void bootBridge(time_t epoch) {
+    LittleFS.hostSetRoot(FLASH_DIR);
+    hostSetTime(epoch);
+    HostRuntime::boot();
+    CHECK(hostStartTask("uplink"));
+    AsyncMqttClient::hostLast()->hostOnPublish([](const char* topic, const char* payload, size_t length) {
+        if (strcmp(topic, "bioreactor/status") == 0) lastStatus.assign(payload, length);
+    });
+}
+
+static void setNetwork(bool up) {
+    WiFi.hostSetConnected(up);
+    if (up) {
+        AsyncMqttClient::hostLast()->hostConnect();
+    } else {
+        AsyncMqttClient::hostLast()->hostDisconnect();
+    }
+}
+
+static long statusField(const char* name) {
+    std::string key = std::string("\"") + name + "\":";
+    size_t position = lastStatus.find(key);
+    return position == std::string::npos ? -1 : atol(lastStatus.c_str() + position + key.size());
+}
+
+// 5 minutes online, the first 15 minutes of the outage, then a reset.
+// Sends the next sequence number and the number of frames queued in flash.
+static void firstBoot(int fd, uint16_t port) {
+    WiFi.hostSetServerPort(port);
+    bootBridge(START_EPOCH);
+    setNetwork(true);
+    sendFrames(5 * MINUTE);
+    setNetwork(false);
+    sendFrames(15 * MINUTE);
+    HostRuntime::settle();
+    sendToParent(fd, nextSequence);
+    sendToParent(fd, lround(millis() / 1000.0));
+    _exit(0);
+}
+
+int main() {
+    std::filesystem::remove_all(FLASH_DIR);
+    StandInServer server;
+
+    std::vector<long> results;
+    int status = runChild([&server](int fd) { firstBoot(fd, server.port()); }, results);
+    CHECK(status == 0 && results.size() == 2);
+    if (results.size() != 2) return testResult();
+    nextSequence = results[0];
+    long beforeOutage = static_cast<long>(5 * MINUTE / FRAME_INTERVAL);
+    size_t delivered = server.entries().size();
+    printf("First boot: %ld frames, %zu delivered before the outage, reset after %ld s\n", nextSequence, delivered,
+           results[1]);
+    CHECK(static_cast<long>(delivered) >= beforeOutage - 1 && static_cast<long>(delivered) <= beforeOutage);
+
+    // Second boot on the same flash, still offline
+    WiFi.hostSetServerPort(server.port());
+    bootBridge(START_EPOCH + results[1]);
+    std::string console = HostRuntime::takeConsole();
+    long queuedAtBoot = nextSequence - static_cast<long>(delivered);
+    CHECK(console.find("Telemetry queue: " + std::to_string(queuedAtBoot) + " messages waiting") != std::string::npos);
+    sendFrames(15 * MINUTE);
+    CHECK(server.entries().size() == delivered);
+
+    // WiFi back, server down for 2 minutes then failing for 1 minute: retried with backoff, nothing lost
+    server.setMode(StandInServer::Mode::DOWN);
+    setNetwork(true);
+    sendFrames(2 * MINUTE);
+    server.setMode(StandInServer::Mode::FAILING);
+    sendFrames(1 * MINUTE);
+    HostRuntime::runFor(10000);     // Status after the last failure
+    long failures = statusField("failures");
+    CHECK(server.entries().size() == delivered);
+
+    // Server back: the backlog goes as soon as the backoff (60 s at most) allows, in full batches
+    server.setMode(StandInServer::Mode::UP);
+    unsigned long recovery = millis();
+    long drainSeconds = -1;
+    for (unsigned long elapsed = 0; elapsed < 5 * MINUTE; elapsed += FRAME_INTERVAL) {
+        sendFrames(FRAME_INTERVAL);
+        HostRuntime::settle();
+        if (drainSeconds < 0 && static_cast<long>(server.entries().size()) >= nextSequence - 1) {
+            drainSeconds = (millis() - recovery) / 1000;
+        }
+    }
+    HostRuntime::runFor(15000);     // Last frame sent, then a status
+    HostRuntime::settle();
+
+    // Every frame once, in order, with a time that never goes back
+    std::vector<StandInServer::Entry> entries = server.entries();
+    long missing = 0, duplicated = 0, reordered = 0;
+    long expected = 0;
+    uint32_t lastEpoch = 0;
+    for (const StandInServer::Entry& entry : entries) {
+        if (entry.sequence < expected) duplicated++;
+        if (entry.sequence > expected) missing += entry.sequence - expected;
+        if (entry.epoch < lastEpoch || entry.epoch == 0) reordered++;
+        expected = max(expected, entry.sequence + 1);
+        lastEpoch = entry.epoch;
+    }
+    missing += nextSequence - expected;
+    printf("%ld frames sent, %zu received, %ld missing, %ld duplicated, %ld out of order\n", nextSequence,
+           entries.size(), missing, duplicated, reordered);
+    printf("Server: %lu requests on %lu connections, %lu invalid; %ld failed POSTs in 3 minutes, backlog sent %ld s "
+           "after the server came back\n", server.requests(), server.connections(), server.invalidRequests(), failures,
+           drainSeconds);
+    printf("Last status: %s\n", lastStatus.c_str());
+    CHECK(static_cast<long>(entries.size()) == nextSequence);
+    CHECK(missing == 0);
+    CHECK(duplicated == 0);
+    CHECK(reordered == 0);
+    CHECK(server.invalidRequests() == 0);
+    // Backoff doubling from 1 s up to the 60 s cap: 1 + 2 + ... + 32 + 60 + 60 s, not one attempt per flush interval
+    CHECK(failures >= 6 && failures <= 10);
+    CHECK(drainSeconds >= 0 && drainSeconds <= 61);
+    CHECK(statusField("queued") == 0);
+    CHECK(statusField("dropped") == 0);
+    CHECK(statusField("handoff") == 0);
+    return testResult();
+}
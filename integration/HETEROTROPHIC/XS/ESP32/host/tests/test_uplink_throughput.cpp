@@ -0,0 +1,123 @@
+// Sustained throughput of the uplink task against the stand-in web server, in real time. The server takes 50 ms to
+// answer each request: one POST per frame from loop() could not pass 20 frames/s and would leave the UART unread
+// meanwhile. The Teensy sends 40 frames/s for 12 s; every frame must reach the server in order, the backlog must
+// stay within a flush interval, all POSTs must go over one kept-alive connection, loop() must never wait for the
+// network, and the POST latency and queue depth must be published on bioreactor/status.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include "StandInServer.h"
+#include <Arduino.h>
+#include <AsyncMqttClient.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <ezTime.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "TelemetryProtocol.h"
+
+void loop();
+
+static const char* FLASH_DIR = "throughput_flash";
+static const unsigned int RESPONSE_DELAY = 50;      // ms per request
+static const unsigned long FRAME_PERIOD = 25;       // ms, 40 frames/s
+static const unsigned long DURATION = 12000;        // ms, past the first status (every 10 s)
+static const double REQUIRED_RATE = 20;             // frames/s
+
+static std::vector<std::string> statuses;
+
+static std::string frameBytes(long sequence) {
+    TelemetryProtocol::AllDataFrame frame = {};
+    strlcpy(frame.currentProgram, "Fermentation", sizeof(frame.currentProgram));
+    frame.programState = 2;
+    frame.waterTemp = 30.0f;
+    frame.actuatorRemaining[0] = static_cast<uint32_t>(sequence);
+    uint8_t buffer[TelemetryProtocol::MAX_FRAME_SIZE];
+    size_t length = TelemetryProtocol::encodeAllData(frame, buffer, sizeof(buffer));
+    return std::string(reinterpret_cast<char*>(buffer), length);
+}
+
+static long statusField(const std::string& status, const char* name) {
+    std::string key = std::string("\"") + name + "\":";
+    size_t position = status.find(key);
+    return position == std::string::npos ? -1 : atol(status.c_str() + position + key.size());
+}
+
+int main() {
+    std::filesystem::remove_all(FLASH_DIR);
+    StandInServer server;
+    server.setResponseDelay(RESPONSE_DELAY);
+
+    // setup() on the virtual clock (it waits 3 s), the run in real time
+    LittleFS.hostSetRoot(FLASH_DIR);
+    WiFi.hostSetServerPort(server.port());
+    hostSetTime(1760000000);
+    HostRuntime::boot();
+    HostRuntime::setRealTime(true);
+    CHECK(hostStartTask("uplink"));
+    AsyncMqttClient* mqtt = AsyncMqttClient::hostLast();
+    mqtt->hostOnPublish([](const char* topic, const char* payload, size_t length) {
+        if (strcmp(topic, "bioreactor/status") == 0) statuses.emplace_back(payload, length);
+    });
+    WiFi.hostSetConnected(true);
+    mqtt->hostConnect();
+    HostRuntime::takeConsole();
+
+    // One frame every FRAME_PERIOD, loop() running in between as on the target
+    long sent = 0;
+    unsigned long start = millis();
+    unsigned long longestLoop = 0;
+    while (millis() - start < DURATION) {
+        while (sent < static_cast<long>((millis() - start) / FRAME_PERIOD) + 1) {
+            Serial2.hostInject(frameBytes(sent++));
+        }
+        unsigned long before = millis();
+        loop();
+        longestLoop = max(longestLoop, millis() - before);
+        HostRuntime::takeConsole();
+    }
+    double seconds = (millis() - start) / 1000.0;
+    size_t deliveredInTime = server.entries().size();
+    // What is still queued goes within a flush interval and a POST
+    unsigned long drainStart = millis();
+    while (static_cast<long>(server.entries().size()) < sent && millis() - drainStart < 3000) {
+        loop();
+        HostRuntime::takeConsole();
+    }
+    unsigned long drainTime = millis() - drainStart;
+
+    std::vector<StandInServer::Entry> entries = server.entries();
+    long outOfOrder = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].sequence != static_cast<long>(i)) outOfOrder++;
+    }
+    double rate = deliveredInTime / seconds;
+    printf("%ld frames in %.1f s (%.1f frames/s), %.1f frames/s delivered, backlog sent %lu ms after the last frame\n",
+           sent, seconds, sent / seconds, rate, drainTime);
+    printf("Server: %lu requests (%.1f frames per POST) on %lu connection(s), %ld out of order; longest loop() %lu ms\n",
+           server.requests(), server.requests() ? static_cast<double>(entries.size()) / server.requests() : 0.0,
+           server.connections(), outOfOrder, longestLoop);
+    CHECK(static_cast<long>(entries.size()) == sent);
+    CHECK(outOfOrder == 0);
+    CHECK(rate >= REQUIRED_RATE);
+    CHECK(drainTime <= 1000 + 2 * RESPONSE_DELAY + 200);
+    CHECK(server.connections() == 1);
+    CHECK(server.invalidRequests() == 0);
+    CHECK(Serial2.hostDroppedBytes() == 0);
+    // loop() reads the UART every 10 ms: it never waits for a POST
+    CHECK(longestLoop < RESPONSE_DELAY);
+
+    CHECK(!statuses.empty());
+    if (!statuses.empty()) {
+        const std::string& status = statuses.back();
+        printf("Status: %s\n", status.c_str());
+        CHECK(statusField(status, "latencyMs") >= static_cast<long>(RESPONSE_DELAY));
+        CHECK(statusField(status, "maxLatencyMs") >= statusField(status, "latencyMs"));
+        CHECK(statusField(status, "avgLatencyMs") >= static_cast<long>(RESPONSE_DELAY));
+        CHECK(statusField(status, "queued") >= 0 && statusField(status, "queued") <= 2 * 40);
+        CHECK(statusField(status, "handoff") >= 0);
+        CHECK(statusField(status, "dropped") == 0);
+        CHECK(statusField(status, "failures") == 0);
+    }
+    return testResult();
+}
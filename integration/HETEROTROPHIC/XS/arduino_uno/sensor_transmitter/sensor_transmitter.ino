@@ -39,72 +39,96 @@ void loop() {
         Serial.print(F("Command received: "));
         Serial.println(command);
 
-        // pH commands
-        if (command.startsWith(F("PH:READ:"))) {
-            float temp = command.substring(8).toFloat();
-            float ph = SensorController::readSensor("phSensor", temp);
-            teensySerial.print(F("PH:"));
-            teensySerial.println(ph);
-        }
-        /*
-        else if (command.startsWith(F("PH:CAL:ENTERPH:"))) {
-            float temp = command.substring(14).toFloat();
-            String result = phSensor.calibration("ENTERPH", temp);
-            teensySerial.println("ENTERPH:" + result);
-        }
-        */
-        else if (command.startsWith(F("PH:CAL:ENTERPH:"))) {
-            float temp = command.substring(14 + 1).toFloat();
-            String result = phSensor.calibration("ENTERPH", temp);
-            teensySerial.println("ENTERPH:" + result);
-        }
-        else if (command.startsWith(F("PH:CAL:CALPH:"))) {
-            float temp = command.substring(12 + 1).toFloat();
-            String result = phSensor.calibration("CALPH", temp);
-            teensySerial.println("CALPH:" + result);
-        }
-        else if (command.startsWith(F("PH:CAL:EXITPH:"))) {
-            float temp = command.substring(13 + 1).toFloat();
-            String result = phSensor.calibration("EXITPH", temp);
-            teensySerial.println("EXITPH:" + result);
+        // Tagged requests "#<tag>:<command>" are answered with "#<tag>:<response>"
+        // so that the Teensy can match every answer with its request
+        String tag = "";
+        if (command.startsWith(F("#"))) {
+            int separator = command.indexOf(':');
+            if (separator > 0) {
+                tag = command.substring(0, separator + 1);
+                command = command.substring(separator + 1);
+            }
         }
 
-        // O2 commands
-        else if (command.startsWith(F("O2:READ:"))) {
-            float temp = command.substring(8).toFloat();
-            float o2 = SensorController::readSensor("oxygenSensor", temp);
-            teensySerial.print(F("O2:"));
-            teensySerial.println(o2);
-        }
-        else if (command == F("O2:CAL:START")) {
-            teensySerial.println(F("O2:CAL:START:OK"));
-        }
-        else if (command.startsWith(F("O2:CAL:ZERO:"))) {
-            float temp = command.substring(12).toFloat();
-            oxygenSensor.saveZeroPoint(temp);
-            teensySerial.println(F("O2:CAL:ZERO:OK"));
-        }
-        else if (command.startsWith(F("O2:CAL:SAT_LOW:"))) {
-            float temp = command.substring(15).toFloat();
-            oxygenSensor.saveSaturationLowTemp(temp);
-            teensySerial.println(F("O2:CAL:SAT_LOW:OK"));
-        }
-        else if (command.startsWith(F("O2:CAL:SAT_HIGH:"))) {
-            float temp = command.substring(16).toFloat();
-            oxygenSensor.saveSaturationHighTemp(temp);
-            teensySerial.println(F("O2:CAL:SAT_HIGH:OK"));
-        }
-        else if (command == F("O2:CAL:RESET")) {
-            oxygenSensor.resetCalibration();
-            teensySerial.println(F("O2:CAL:RESET:OK"));
-        }
-        else if (command == F("O2:CAL:STATUS")) {
-            String status = oxygenSensor.getCalibrationStatus();
-            teensySerial.println("O2:CAL:STATUS:" + status);
-        }
-        else {
-            Serial.print(F("Unknown command: "));
-            Serial.println(command);
+        String response = handleCommand(command);
+        if (response.length() > 0) {
+            teensySerial.println(tag + response);
         }
     }
+}
+
+String handleCommand(const String& command) {
+    // pH and O2 in a single transaction, compensated with the same temperature
+    if (command.startsWith(F("READ_ALL:"))) {
+        float temp = command.substring(9).toFloat();
+        float ph = SensorController::readSensor("phSensor", temp);
+        float o2 = SensorController::readSensor("oxygenSensor", temp);
+        return "ALL:" + String(ph) + ":" + String(o2);
+    }
+
+    // pH commands
+    if (command.startsWith(F("PH:READ:"))) {
+        float temp = command.substring(8).toFloat();
+        float ph = SensorController::readSensor("phSensor", temp);
+        return "PH:" + String(ph);
+    }
+    /*
+    else if (command.startsWith(F("PH:CAL:ENTERPH:"))) {
+        float temp = command.substring(14).toFloat();
+        String result = phSensor.calibration("ENTERPH", temp);
+        teensySerial.println("ENTERPH:" + result);
+    }
+    */
+    else if (command.startsWith(F("PH:CAL:ENTERPH:"))) {
+        float temp = command.substring(14 + 1).toFloat();
+        String result = phSensor.calibration("ENTERPH", temp);
+        return "ENTERPH:" + result;
+    }
+    else if (command.startsWith(F("PH:CAL:CALPH:"))) {
+        float temp = command.substring(12 + 1).toFloat();
+        String result = phSensor.calibration("CALPH", temp);
+        return "CALPH:" + result;
+    }
+    else if (command.startsWith(F("PH:CAL:EXITPH:"))) {
+        float temp = command.substring(13 + 1).toFloat();
+        String result = phSensor.calibration("EXITPH", temp);
+        return "EXITPH:" + result;
+    }
+
+    // O2 commands
+    else if (command.startsWith(F("O2:READ:"))) {
+        float temp = command.substring(8).toFloat();
+        float o2 = SensorController::readSensor("oxygenSensor", temp);
+        return "O2:" + String(o2);
+    }
+    else if (command == F("O2:CAL:START")) {
+        return F("O2:CAL:START:OK");
+    }
+    else if (command.startsWith(F("O2:CAL:ZERO:"))) {
+        float temp = command.substring(12).toFloat();
+        oxygenSensor.saveZeroPoint(temp);
+        return F("O2:CAL:ZERO:OK");
+    }
+    else if (command.startsWith(F("O2:CAL:SAT_LOW:"))) {
+        float temp = command.substring(15).toFloat();
+        oxygenSensor.saveSaturationLowTemp(temp);
+        return F("O2:CAL:SAT_LOW:OK");
+    }
+    else if (command.startsWith(F("O2:CAL:SAT_HIGH:"))) {
+        float temp = command.substring(16).toFloat();
+        oxygenSensor.saveSaturationHighTemp(temp);
+        return F("O2:CAL:SAT_HIGH:OK");
+    }
+    else if (command == F("O2:CAL:RESET")) {
+        oxygenSensor.resetCalibration();
+        return F("O2:CAL:RESET:OK");
+    }
+    else if (command == F("O2:CAL:STATUS")) {
+        String status = oxygenSensor.getCalibrationStatus();
+        return "O2:CAL:STATUS:" + status;
+    }
+
+    Serial.print(F("Unknown command: "));
+    Serial.println(command);
+    return "";
 }
\ No newline at end of file
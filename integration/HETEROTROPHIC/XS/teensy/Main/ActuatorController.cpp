@@ -1,5 +1,6 @@
 // ActuatorController.cpp
 #include "ActuatorController.h"
+#include "SystemClock.h"
 #include "Logger.h"
 
 // Static pointers, initialized to nullptr
@@ -12,6 +13,8 @@ HeatingPlate* ActuatorController::heatingPlate = nullptr;
 LEDGrowLight* ActuatorController::ledGrowLight = nullptr;
 DCPump* ActuatorController::samplePump = nullptr;
 DCPump* ActuatorController::fillPump = nullptr;
+ActuatorInterface* ActuatorController::actuators[ActuatorController::ACTUATOR_COUNT] = {};
+ActuatorController::TimedRun ActuatorController::timedRuns[ActuatorController::ACTUATOR_COUNT] = {};
 
 // Initialize method
 void ActuatorController::initialize(DCPump& airP, DCPump& drainP,
@@ -28,6 +31,17 @@ void ActuatorController::initialize(DCPump& airP, DCPump& drainP,
     ledGrowLight = &ledLight;
     samplePump = &sampleP;
     fillPump = &fillP;
+
+    // Table indexed by ActuatorId
+    actuators[static_cast<int>(ActuatorId::AirPump)] = airPump;
+    actuators[static_cast<int>(ActuatorId::DrainPump)] = drainPump;
+    actuators[static_cast<int>(ActuatorId::SamplePump)] = samplePump;
+    actuators[static_cast<int>(ActuatorId::NutrientPump)] = nutrientPump;
+    actuators[static_cast<int>(ActuatorId::BasePump)] = basePump;
+    actuators[static_cast<int>(ActuatorId::FillPump)] = fillPump;
+    actuators[static_cast<int>(ActuatorId::StirringMotor)] = stirringMotor;
+    actuators[static_cast<int>(ActuatorId::HeatingPlate)] = heatingPlate;
+    actuators[static_cast<int>(ActuatorId::LedGrowLight)] = ledGrowLight;
 }
 
 void ActuatorController::beginAll() {
@@ -42,68 +56,102 @@ void ActuatorController::beginAll() {
     fillPump->begin();
 }
 
+void ActuatorController::runActuator(ActuatorId id, float value, int duration) {
+    ActuatorInterface* actuator = getActuator(id);
+    actuator->control(true, value);
+    //Logger::log(LogLevel::INFO, "Running actuator: " + String(actuator->getName()) + " with value: " + String(value));
+    TimedRun& run = timedRuns[static_cast<int>(id)];
+    run.active = duration > 0;
+    run.start = SystemClock::now();
+    run.duration = duration;
+}
+
 void ActuatorController::runActuator(const String& actuatorName, float value, int duration) {
-    ActuatorInterface* actuator = findActuatorByName(actuatorName);
-    if (actuator) {
-        actuator->control(true, value);
-        //Logger::log(LogLevel::INFO, "Running actuator: " + actuatorName + " with value: " + String(value));
-        if (duration > 0) {
-            delay(duration);
-            stopActuator(actuatorName);
-        }
+    ActuatorId id;
+    if (findActuatorId(actuatorName, id)) {
+        runActuator(id, value, duration);
     } else {
         Logger::log(LogLevel::ERROR, "Actuator not found: " + actuatorName);
     }
 }
 
+void ActuatorController::update() {
+    unsigned long currentTime = SystemClock::now();
+    for (int i = 0; i < ACTUATOR_COUNT; i++) {
+        const TimedRun& run = timedRuns[i];
+        if (run.active && currentTime - run.start >= run.duration) {
+            stopActuator(static_cast<ActuatorId>(i));
+        }
+    }
+}
+
+unsigned long ActuatorController::getRemainingTime(ActuatorId id) {
+    const TimedRun& run = timedRuns[static_cast<int>(id)];
+    if (!run.active) {
+        return 0;
+    }
+    unsigned long elapsed = SystemClock::now() - run.start;
+    return (elapsed < run.duration) ? run.duration - elapsed : 0;
+}
+
+void ActuatorController::stopActuator(ActuatorId id) {
+    getActuator(id)->control(false, 0);
+    timedRuns[static_cast<int>(id)].active = false;
+    //Logger::log(LogLevel::INFO, "Stopped actuator: " + String(getActuator(id)->getName()));
+}
+
 void ActuatorController::stopActuator(const String& actuatorName) {
-    ActuatorInterface* actuator = findActuatorByName(actuatorName);
-    if (actuator) {
-        actuator->control(false, 0);
-        delay(50);  // Ajoutez un court délai pour la stabilisation
-        //Logger::log(LogLevel::INFO, "Stopped actuator: " + actuatorName);
+    ActuatorId id;
+    if (findActuatorId(actuatorName, id)) {
+        stopActuator(id);
     }
 }
 
 void ActuatorController::stopAllActuators() {
     //Logger::log(LogLevel::INFO, "Entering stopAllActuators");
     //Logger::log(LogLevel::INFO, F("Entering stopAllActuators"));
-    const ActuatorInterface* actuators[] = {
-        airPump, drainPump, nutrientPump, basePump, 
-        stirringMotor, heatingPlate, ledGrowLight
-    };
-    for (const auto& actuator : actuators) {
-        if (actuator->isOn()) {
-            //Logger::log(LogLevel::INFO, "Stopping " + String(actuator->getName()));
-            //actuator->control(false, 0);
-            const_cast<ActuatorInterface*>(actuator)->control(false, 0);
-            delay(50); 
+    for (int i = 0; i < ACTUATOR_COUNT; i++) {
+        timedRuns[i].active = false;
+        if (actuators[i]->isOn()) {
+            //Logger::log(LogLevel::INFO, "Stopping " + String(actuators[i]->getName()));
+            actuators[i]->control(false, 0);
         }
     }
     //Logger::log(LogLevel::INFO, "All actuators stopped");
     Logger::log(LogLevel::INFO, F("All actuators stopped"));
 }
 
+bool ActuatorController::isActuatorRunning(ActuatorId id) {
+    return getActuator(id)->isOn();
+}
+
 bool ActuatorController::isActuatorRunning(const String& actuatorName) {
-    ActuatorInterface* actuator = findActuatorByName(actuatorName);
-    return actuator ? actuator->isOn() : false;
+    ActuatorId id;
+    return findActuatorId(actuatorName, id) ? isActuatorRunning(id) : false;
+}
+
+int ActuatorController::getCurrentValue(ActuatorId id) {
+    return getActuator(id)->getCurrentValue();
 }
 
 int ActuatorController::getCurrentValue(const String& actuatorName) {
-    ActuatorInterface* actuator = findActuatorByName(actuatorName);
-    return actuator ? actuator->getCurrentValue() : 0;
+    ActuatorId id;
+    return findActuatorId(actuatorName, id) ? getCurrentValue(id) : 0;
 }
 
 ActuatorInterface* ActuatorController::findActuatorByName(const String& name) {
-    static const ActuatorInterface* actuators[] = {
-        airPump, drainPump, nutrientPump, basePump, 
-        stirringMotor, heatingPlate, ledGrowLight, samplePump, fillPump
-    };
-    
-    for (const auto& actuator : actuators) {
-        if (name == actuator->getName()) return const_cast<ActuatorInterface*>(actuator);
+    ActuatorId id;
+    return findActuatorId(name, id) ? getActuator(id) : nullptr;
+}
+
+bool ActuatorController::findActuatorId(const String& name, ActuatorId& id) {
+    for (int i = 0; i < ACTUATOR_COUNT; i++) {
+        if (name == actuators[i]->getName()) {
+            id = static_cast<ActuatorId>(i);
+            return true;
+        }
     }
-    return nullptr;
+    return false;
 }
 
 float ActuatorController::getVolumeAdded(const String& actuatorName) {
@@ -15,6 +15,20 @@ enum class ControlMode {
     Relay
 };
 
+// Typed handles of the actuators, used as direct index into the controller table
+enum class ActuatorId : uint8_t {
+    AirPump,
+    DrainPump,
+    SamplePump,
+    NutrientPump,
+    BasePump,
+    FillPump,
+    StirringMotor,
+    HeatingPlate,
+    LedGrowLight,
+    Count
+};
+
 class ActuatorController {
 public:
     public:
@@ -24,10 +38,19 @@ public:
                            LEDGrowLight& ledGrowLight, DCPump& samplePump, DCPump& fillPump);
     static void beginAll();
     
+    // duration > 0: timed run, stopped by update() once elapsed; duration = 0: runs until stopActuator()
+    static void runActuator(ActuatorId id, float value, int duration);
     static void runActuator(const String& actuatorName, float value, int duration);
+    // Stops the timed runs whose duration has elapsed, call on every loop
+    static void update();
+    // Time left (ms) before a timed run stops, 0 if the actuator is not on a timed run
+    static unsigned long getRemainingTime(ActuatorId id);
+    static void stopActuator(ActuatorId id);
     static void stopActuator(const String& actuatorName);
     static void stopAllActuators();
+    static bool isActuatorRunning(ActuatorId id);
     static bool isActuatorRunning(const String& actuatorName);
+    static int getCurrentValue(ActuatorId id);
     static int getCurrentValue(const String& actuatorName);
 
     template<typename T>
@@ -45,7 +68,10 @@ public:
     static int getStirringMotorMinRPM();
     static int getStirringMotorMaxRPM();
 
+    static ActuatorInterface* getActuator(ActuatorId id) { return actuators[static_cast<int>(id)]; }
+    // Name based lookup kept for the serial commands, resolves the name to its ActuatorId
     static ActuatorInterface* findActuatorByName(const String& name);
+    static bool findActuatorId(const String& name, ActuatorId& id);
     static void runHeatingPlatePID(double pidOutput);
 
 private:
@@ -59,6 +85,17 @@ private:
     static ControlMode heatingControlMode;
     static DCPump* samplePump;
     static DCPump* fillPump;
+
+    static const int ACTUATOR_COUNT = static_cast<int>(ActuatorId::Count);
+    static ActuatorInterface* actuators[ACTUATOR_COUNT];
+
+    // Timed runs, indexed by ActuatorId: each actuator has its own deadline so runs can overlap
+    struct TimedRun {
+        bool active;
+        unsigned long start;
+        unsigned long duration;
+    };
+    static TimedRun timedRuns[ACTUATOR_COUNT];
 };
 
 #endif // ACTUATOR_CONTROLLER_H
@@ -43,6 +43,16 @@ float AirFlowSensor::readValue() {
     return -1.0; // Indicate that the flow rate is not updated yet
 }
 
+// Method to poll the flow rate; the counting interval replaces the wait
+bool AirFlowSensor::pollReading(float& value) {
+    float flowRate = readValue();
+    if (flowRate < 0) {
+        return false; // Counting interval not elapsed yet
+    }
+    value = flowRate;
+    return true;
+}
+
 // Interrupt service routine to count pulses
 void AirFlowSensor::countPulses() {
     instance->_pulseCount++;
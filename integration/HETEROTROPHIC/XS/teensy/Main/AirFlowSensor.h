@@ -52,6 +52,13 @@ public:
      */
     float readValue();
 
+    /*
+     * Method to poll the flow rate without waiting.
+     * @param value: The flow rate in liters per minute (L/min).
+     * @return: true once a full counting interval has elapsed.
+     */
+    bool pollReading(float& value) override;
+
     /*
      * Interrupt service routine to count pulses.
      */
@@ -0,0 +1,278 @@
+// AutotuneProgram.cpp
+#include "AutotuneProgram.h"
+#include "SystemClock.h"
+#include <Arduino.h>
+
+AutotuneProgram::AutotuneProgram(PIDManager& pidManager)
+    : pidManager(pidManager), loop(PIDLoop::Temperature), setpoint(0), hysteresis(0),
+      highOutput(100), lowOutput(0), relayHigh(false), startTime(0), lastSwitchOn(0), lastDose(0),
+      switchedOn(false), cycleCount(0), cycleMin(0), cycleMax(0), periodSum(0), amplitudeSum(0),
+      ultimateGain(0), ultimatePeriod(0) {}
+
+void AutotuneProgram::start(const String& command) {
+    if (!parseArguments(command)) {
+        return;
+    }
+
+    // The loop PID must not fight the relay
+    switch (loop) {
+        case PIDLoop::Temperature: pidManager.stopTemperaturePID(); break;
+        case PIDLoop::PH: pidManager.stopPHPID(); break;
+        default: pidManager.stopDOPID(); break;
+    }
+
+    _isRunning = true;
+    _isPaused = false;
+    ultimateGain = 0;
+    ultimatePeriod = 0;
+    resetCycles();
+    Logger::log(LogLevel::INFO, "Autotune of the " + String(PIDManager::getLoopName(loop)) + " loop started - Setpoint: " +
+                String(setpoint) + ", Hysteresis: " + String(hysteresis) + ", Relay: " + String(lowOutput) + "/" + String(highOutput) + "%");
+}
+
+void AutotuneProgram::update() {
+    if (!_isRunning || _isPaused) return;
+
+    unsigned long now = SystemClock::now();
+    if (now - startTime > maxDuration()) {
+        Logger::log(LogLevel::ERROR, "Autotune: no sustained oscillation after " + String(maxDuration() / 60000) + " min, tunings unchanged");
+        stop();
+        return;
+    }
+
+    float measure = readMeasure();
+    if (isnan(measure)) return;
+
+    if (measure < cycleMin) cycleMin = measure;
+    if (measure > cycleMax) cycleMax = measure;
+
+    if (!relayHigh && measure < setpoint - hysteresis) {
+        setRelay(true);
+        switchOn(now, measure);
+    } else if (relayHigh && measure > setpoint + hysteresis) {
+        setRelay(false);
+    } else if (loop == PIDLoop::PH && relayHigh && now - lastDose >= PH_DOSING_INTERVAL) {
+        applyOutput(highOutput);
+    }
+}
+
+void AutotuneProgram::pause() {
+    if (_isRunning && !_isPaused) {
+        releaseActuators();
+        _isPaused = true;
+        Logger::log(LogLevel::INFO, F("Autotune paused"));
+    }
+}
+
+void AutotuneProgram::resume() {
+    if (_isRunning && _isPaused) {
+        // The oscillation was interrupted, measure it again
+        resetCycles();
+        _isPaused = false;
+        Logger::log(LogLevel::INFO, F("Autotune resumed, cycles restarted"));
+    }
+}
+
+void AutotuneProgram::stop() {
+    if (_isRunning) {
+        releaseActuators();
+        _isRunning = false;
+        _isPaused = false;
+        Logger::log(LogLevel::INFO, F("Autotune stopped"));
+    }
+}
+
+void AutotuneProgram::parseCommand(const String& command) {
+    parseArguments(command);
+}
+
+void AutotuneProgram::getParameters(JsonDocument& doc) const {
+    doc["loop"] = PIDManager::getLoopName(loop);
+    doc["sp"] = setpoint;
+    doc["hyst"] = hysteresis;
+    if (ultimatePeriod > 0) {
+        doc["Ku"] = ultimateGain;
+        doc["Pu"] = ultimatePeriod;
+    }
+}
+
+bool AutotuneProgram::parseArguments(const String& command) {
+    // Parse command: "autotune <temperature|ph|do> [setpoint] [hysteresis]"
+    int firstSpace = command.indexOf(' ');
+    if (firstSpace == -1) {
+        Logger::log(LogLevel::ERROR, F("Invalid autotune command format"));
+        return false;
+    }
+    int secondSpace = command.indexOf(' ', firstSpace + 1);
+    String loopName = (secondSpace == -1) ? command.substring(firstSpace + 1) : command.substring(firstSpace + 1, secondSpace);
+
+    float defaultSetpoint;
+    if (loopName.equalsIgnoreCase("temperature") || loopName.equalsIgnoreCase("temp")) {
+        loop = PIDLoop::Temperature;
+        hysteresis = 0.2f;
+        highOutput = 100;
+        lowOutput = 0;
+        defaultSetpoint = pidManager.getTemperatureSetpoint();
+    } else if (loopName.equalsIgnoreCase("ph")) {
+        loop = PIDLoop::PH;
+        hysteresis = 0.05f;
+        // Highest PID output still dosed at the flow rate allowed by the pH PID
+        float minFlowRate = ActuatorController::getPumpMinFlowRate("basePump");
+        float maxFlowRate = ActuatorController::getPumpMaxFlowRate("basePump");
+        highOutput = (maxFlowRate > MAX_BASE_FLOW_RATE && maxFlowRate > minFlowRate) ?
+                     100.0f * (MAX_BASE_FLOW_RATE - minFlowRate) / (maxFlowRate - minFlowRate) : 100.0f;
+        lowOutput = 0;
+        defaultSetpoint = pidManager.getPHSetpoint();
+    } else if (loopName.equalsIgnoreCase("do")) {
+        loop = PIDLoop::DO;
+        hysteresis = 0.2f;
+        highOutput = 100;
+        lowOutput = 15; // Lower output limit of the DO PID, the air pump does not work below
+        defaultSetpoint = pidManager.getDOSetpoint();
+    } else {
+        Logger::log(LogLevel::ERROR, "Unknown autotune loop: " + loopName);
+        return false;
+    }
+
+    setpoint = defaultSetpoint;
+    if (secondSpace != -1) {
+        const char* cursor = command.c_str() + secondSpace;
+        char* end;
+        float value = strtod(cursor, &end);
+        if (end != cursor) {
+            setpoint = value;
+            cursor = end;
+            value = strtod(cursor, &end);
+            if (end != cursor && value > 0) {
+                hysteresis = value;
+            }
+        }
+    }
+
+    if (setpoint <= 0) {
+        Logger::log(LogLevel::ERROR, "Autotune: no setpoint for the " + String(PIDManager::getLoopName(loop)) + " loop");
+        return false;
+    }
+    return true;
+}
+
+float AutotuneProgram::readMeasure() const {
+    const SensorSnapshot& snapshot = SensorController::getSnapshot();
+    switch (loop) {
+        case PIDLoop::Temperature:
+            return (snapshot.waterTemp > -100 && snapshot.waterTemp < 100) ? snapshot.waterTemp : NAN;
+        case PIDLoop::PH:
+            return (snapshot.pH > 0 && snapshot.pH < 14) ? snapshot.pH : NAN;
+        default:
+            return (snapshot.oxygen >= 0) ? snapshot.oxygen : NAN;
+    }
+}
+
+void AutotuneProgram::setRelay(bool high) {
+    relayHigh = high;
+    applyOutput(high ? highOutput : lowOutput);
+}
+
+void AutotuneProgram::applyOutput(float output) {
+    switch (loop) {
+        case PIDLoop::Temperature:
+            if (output > 0) {
+                ActuatorController::runActuator(ActuatorId::HeatingPlate, output, 0);
+            } else {
+                ActuatorController::stopActuator(ActuatorId::HeatingPlate);
+            }
+            break;
+        case PIDLoop::PH:
+            if (output > 0) {
+                float minFlowRate = ActuatorController::getPumpMinFlowRate("basePump");
+                float maxFlowRate = ActuatorController::getPumpMaxFlowRate("basePump");
+                float flowRate = minFlowRate + output * (maxFlowRate - minFlowRate) / 100.0f;
+                ActuatorController::runActuator(ActuatorId::BasePump, flowRate, PH_PULSE_DURATION);
+                lastDose = SystemClock::now();
+            } else {
+                ActuatorController::stopActuator(ActuatorId::BasePump);
+            }
+            break;
+        default:
+            ActuatorController::runActuator(ActuatorId::AirPump, output, 0);
+            break;
+    }
+}
+
+void AutotuneProgram::switchOn(unsigned long now, float measure) {
+    if (switchedOn) {
+        cycleCount++;
+        float period = (now - lastSwitchOn) / 1000.0f;
+        float amplitude = (cycleMax - cycleMin) / 2;
+        Logger::log(LogLevel::INFO, "Autotune cycle " + String(cycleCount) + " - Period: " + String(period, 1) +
+                    " s, Amplitude: " + String(amplitude, 3));
+
+        // The first cycle starts from the initial conditions
+        if (cycleCount > 1) {
+            periodSum += period;
+            amplitudeSum += amplitude;
+        }
+        if (cycleCount > MEASURED_CYCLES) {
+            finish();
+            return;
+        }
+    }
+    switchedOn = true;
+    lastSwitchOn = now;
+    cycleMin = measure;
+    cycleMax = measure;
+}
+
+void AutotuneProgram::resetCycles() {
+    // Mixing is needed for a representative measure
+    int stirringSpeed = max(pidManager.getMinStirringSpeed(), ActuatorController::getStirringMotorMinRPM());
+    ActuatorController::runActuator(ActuatorId::StirringMotor, stirringSpeed, 0);
+
+    setRelay(false);
+    startTime = SystemClock::now();
+    switchedOn = false;
+    cycleCount = 0;
+    periodSum = 0;
+    amplitudeSum = 0;
+    cycleMin = 1e9f;
+    cycleMax = -1e9f;
+}
+
+void AutotuneProgram::finish() {
+    float amplitude = amplitudeSum / MEASURED_CYCLES;
+    ultimatePeriod = periodSum / MEASURED_CYCLES;
+    if (amplitude <= 0 || ultimatePeriod <= 0) {
+        Logger::log(LogLevel::ERROR, F("Autotune: invalid oscillation, tunings unchanged"));
+        stop();
+        return;
+    }
+
+    float relayAmplitude = (highOutput - lowOutput) / 2;
+    ultimateGain = 4 * relayAmplitude / (PI * amplitude);
+
+    // Ziegler–Nichols PI
+    double Kp = 0.45 * ultimateGain;
+    double Ki = Kp / (ultimatePeriod / 1.2);
+    Logger::log(LogLevel::INFO, "Autotune of the " + String(PIDManager::getLoopName(loop)) + " loop completed - Ku: " +
+                String(ultimateGain, 3) + ", Pu: " + String(ultimatePeriod, 1) + " s");
+    pidManager.setTunedParameters(loop, Kp, Ki, 0);
+    pidManager.saveParameters();
+    stop();
+}
+
+void AutotuneProgram::releaseActuators() {
+    switch (loop) {
+        case PIDLoop::Temperature: ActuatorController::stopActuator(ActuatorId::HeatingPlate); break;
+        case PIDLoop::PH: ActuatorController::stopActuator(ActuatorId::BasePump); break;
+        default: ActuatorController::stopActuator(ActuatorId::AirPump); break;
+    }
+    ActuatorController::stopActuator(ActuatorId::StirringMotor);
+}
+
+unsigned long AutotuneProgram::maxDuration() const {
+    switch (loop) {
+        case PIDLoop::Temperature: return MAX_DURATION_TEMP;
+        case PIDLoop::PH: return MAX_DURATION_PH;
+        default: return MAX_DURATION_DO;
+    }
+}
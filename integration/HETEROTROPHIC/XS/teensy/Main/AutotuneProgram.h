@@ -0,0 +1,79 @@
+// AutotuneProgram.h
+#ifndef AUTOTUNE_PROGRAM_H
+#define AUTOTUNE_PROGRAM_H
+
+#include "ProgramBase.h"
+#include "ActuatorController.h"
+#include "SensorController.h"
+#include "PIDManager.h"
+#include "Logger.h"
+
+/*
+ * Relay feedback auto-tuning (Åström–Hägglund) of one PIDManager loop.
+ * The loop actuator is switched between a high and a low output around the setpoint, with a hysteresis:
+ *   temperature: heating plate 100% / off
+ *   pH: base pump dosed as by the pH PID (1 s pulse per minute) / off
+ *   DO: air pump 100% / 15%
+ * After the first cycle (transient), the amplitude a and period Pu of MEASURED_CYCLES oscillations are averaged:
+ *   ultimate gain Ku = 4 d / (pi a), d = (high - low) / 2 in PID output %
+ * and Ziegler–Nichols PI tunings are applied to the loop: Kp = 0.45 Ku, Ki = Kp / (Pu / 1.2), Kd = 0.
+ * No derivative action: the quantised temperature and noisy pH/DO readings would make it chatter.
+ * Command: "autotune <temperature|ph|do> [setpoint] [hysteresis]"
+ * Without setpoint, the current setpoint of the loop in the PIDManager is used.
+ */
+class AutotuneProgram : public ProgramBase {
+public:
+    AutotuneProgram(PIDManager& pidManager);
+    void start(const String& command) override;
+    void update() override;
+    void pause() override;
+    void resume() override;
+    void stop() override;
+    bool isRunning() const override { return _isRunning; }
+    bool isPaused() const override { return _isPaused; }
+    String getName() const override { return "Autotune"; }
+    void parseCommand(const String& command) override;
+    void getParameters(JsonDocument& doc) const override;
+
+private:
+    PIDManager& pidManager;
+    PIDLoop loop;
+    float setpoint;
+    float hysteresis;
+    float highOutput;   // PID output % of the relay
+    float lowOutput;
+
+    bool relayHigh;
+    unsigned long startTime;
+    unsigned long lastSwitchOn;
+    unsigned long lastDose;
+    bool switchedOn;    // at least one switch on since the start
+    int cycleCount;
+    float cycleMin;
+    float cycleMax;
+    float periodSum;    // s
+    float amplitudeSum;
+    float ultimateGain;
+    float ultimatePeriod;
+
+    static const int MEASURED_CYCLES = 3;
+    static const unsigned long MAX_DURATION_TEMP = 4UL * 3600UL * 1000UL;
+    static const unsigned long MAX_DURATION_PH = 8UL * 3600UL * 1000UL;
+    static const unsigned long MAX_DURATION_DO = 2UL * 3600UL * 1000UL;
+    // Same dosing as PIDManager::updatePHPID()
+    static const unsigned long PH_DOSING_INTERVAL = 60000;
+    static const int PH_PULSE_DURATION = 1000;
+    static constexpr float MAX_BASE_FLOW_RATE = 20.0f; // ml/min
+
+    bool parseArguments(const String& command);
+    float readMeasure() const;
+    void setRelay(bool high);
+    void applyOutput(float output);
+    void switchOn(unsigned long now, float measure);
+    void resetCycles();
+    void finish();
+    void releaseActuators();
+    unsigned long maxDuration() const;
+};
+
+#endif // AUTOTUNE_PROGRAM_H
@@ -0,0 +1,118 @@
+// ClockedPID.cpp
+#include "ClockedPID.h"
+#include "SystemClock.h"
+
+ClockedPID::ClockedPID(double* input, double* output, double* setpoint, double Kp, double Ki, double Kd, int POn, int direction)
+    : controllerDirection(DIRECT), pOn(POn), pOnE(POn == P_ON_E), myInput(input), myOutput(output), mySetpoint(setpoint),
+      outputSum(0), lastInput(0), outMin(0), outMax(255), inAuto(false) {
+    SetOutputLimits(0, 255);
+    SampleTime = 100;
+    SetControllerDirection(direction);
+    SetTunings(Kp, Ki, Kd, POn);
+    lastTime = SystemClock::now() - SampleTime;
+}
+
+ClockedPID::ClockedPID(double* input, double* output, double* setpoint, double Kp, double Ki, double Kd, int direction)
+    : ClockedPID(input, output, setpoint, Kp, Ki, Kd, P_ON_E, direction) {}
+
+bool ClockedPID::Compute() {
+    if (!inAuto) return false;
+    unsigned long now = SystemClock::now();
+    unsigned long timeChange = now - lastTime;
+    if (timeChange >= SampleTime) {
+        double input = *myInput;
+        double error = *mySetpoint - input;
+        double dInput = input - lastInput;
+        outputSum += ki * error;
+
+        if (!pOnE) outputSum -= kp * dInput;
+
+        if (outputSum > outMax) outputSum = outMax;
+        else if (outputSum < outMin) outputSum = outMin;
+
+        double output = pOnE ? kp * error : 0;
+        output += outputSum - kd * dInput;
+
+        if (output > outMax) output = outMax;
+        else if (output < outMin) output = outMin;
+        *myOutput = output;
+
+        lastInput = input;
+        lastTime = now;
+        return true;
+    }
+    return false;
+}
+
+void ClockedPID::SetTunings(double Kp, double Ki, double Kd, int POn) {
+    if (Kp < 0 || Ki < 0 || Kd < 0) return;
+
+    pOn = POn;
+    pOnE = POn == P_ON_E;
+
+    dispKp = Kp;
+    dispKi = Ki;
+    dispKd = Kd;
+
+    double SampleTimeInSec = static_cast<double>(SampleTime) / 1000;
+    kp = Kp;
+    ki = Ki * SampleTimeInSec;
+    kd = Kd / SampleTimeInSec;
+
+    if (controllerDirection == REVERSE) {
+        kp = 0 - kp;
+        ki = 0 - ki;
+        kd = 0 - kd;
+    }
+}
+
+void ClockedPID::SetTunings(double Kp, double Ki, double Kd) {
+    SetTunings(Kp, Ki, Kd, pOn);
+}
+
+void ClockedPID::SetSampleTime(int NewSampleTime) {
+    if (NewSampleTime > 0) {
+        double ratio = static_cast<double>(NewSampleTime) / static_cast<double>(SampleTime);
+        ki *= ratio;
+        kd /= ratio;
+        SampleTime = static_cast<unsigned long>(NewSampleTime);
+    }
+}
+
+void ClockedPID::SetOutputLimits(double Min, double Max) {
+    if (Min >= Max) return;
+    outMin = Min;
+    outMax = Max;
+
+    if (inAuto) {
+        if (*myOutput > outMax) *myOutput = outMax;
+        else if (*myOutput < outMin) *myOutput = outMin;
+
+        if (outputSum > outMax) outputSum = outMax;
+        else if (outputSum < outMin) outputSum = outMin;
+    }
+}
+
+void ClockedPID::SetMode(int Mode) {
+    bool newAuto = (Mode == AUTOMATIC);
+    if (newAuto && !inAuto) {
+        Initialize();
+    }
+    inAuto = newAuto;
+}
+
+void ClockedPID::Initialize() {
+    outputSum = *myOutput;
+    lastInput = *myInput;
+    if (outputSum > outMax) outputSum = outMax;
+    else if (outputSum < outMin) outputSum = outMin;
+}
+
+void ClockedPID::SetControllerDirection(int Direction) {
+    if (inAuto && Direction != controllerDirection) {
+        kp = 0 - kp;
+        ki = 0 - ki;
+        kd = 0 - kd;
+    }
+    controllerDirection = Direction;
+}
@@ -0,0 +1,56 @@
+// ClockedPID.h
+#ifndef CLOCKED_PID_H
+#define CLOCKED_PID_H
+
+#define AUTOMATIC 1
+#define MANUAL 0
+#define DIRECT 0
+#define REVERSE 1
+#define P_ON_M 0
+#define P_ON_E 1
+
+/*
+ * Arduino PID Library v1.2 (Brett Beauregard), same algorithm and interface,
+ * with the sample time measured on SystemClock instead of millis(): a replay
+ * fed faster than real time computes at the recorded intervals.
+ */
+class ClockedPID {
+public:
+    ClockedPID(double* input, double* output, double* setpoint, double Kp, double Ki, double Kd, int POn, int controllerDirection);
+    ClockedPID(double* input, double* output, double* setpoint, double Kp, double Ki, double Kd, int controllerDirection);
+
+    void SetMode(int mode);
+    bool Compute();
+    void SetOutputLimits(double min, double max);
+    void SetTunings(double Kp, double Ki, double Kd);
+    void SetTunings(double Kp, double Ki, double Kd, int POn);
+    void SetControllerDirection(int direction);
+    void SetSampleTime(int newSampleTime);
+
+    double GetKp() { return dispKp; }
+    double GetKi() { return dispKi; }
+    double GetKd() { return dispKd; }
+    int GetMode() { return inAuto ? AUTOMATIC : MANUAL; }
+    int GetDirection() { return controllerDirection; }
+
+private:
+    void Initialize();
+
+    double dispKp, dispKi, dispKd;
+    double kp, ki, kd;
+    int controllerDirection;
+    int pOn;
+    bool pOnE;
+
+    double* myInput;
+    double* myOutput;
+    double* mySetpoint;
+
+    unsigned long lastTime;
+    double outputSum, lastInput;
+    unsigned long SampleTime;
+    double outMin, outMax;
+    bool inAuto;
+};
+
+#endif // CLOCKED_PID_H
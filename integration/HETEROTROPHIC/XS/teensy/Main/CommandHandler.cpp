@@ -1,5 +1,16 @@
 // CommandHandler.cpp
 #include "CommandHandler.h"
+#include "Communication.h"
+#include "TaskScheduler.h"
+#include "Profiler.h"
+#include "PlantSimulator.h"
+#include "ReplayHarness.h"
+#include "ParameterStore.h"
+#include "SdLogger.h"
+
+extern Communication espCommunication;
+extern SensorTransmitterLink sensorTransmitter;
+extern ReplayHarness replayHarness;
 
 CommandHandler::CommandHandler(StateMachine& stateMachine, SafetySystem& safetySystem, 
                                VolumeManager& volumeManager, PIDManager& pidManager)
@@ -21,6 +32,8 @@ void CommandHandler::executeCommand(const String& command) {
         stateMachine.startProgram("Mix", command);
     } else if (command.startsWith("fermentation")) {
         stateMachine.startProgram("Fermentation", command);
+    } else if (command.startsWith("autotune")) {
+        stateMachine.startProgram("Autotune", command);
     } else if (command == "stop") {
         stateMachine.stopAllPrograms();
         //stateMachine.stopProgram();
@@ -36,6 +49,38 @@ void CommandHandler::executeCommand(const String& command) {
         handleO2CalibrationCommand(command);
     } else if (command == "reset volume") {
         volumeManager.resetVolume();
+    } else if (command == "sensor stats") {
+        SensorController::logReadStatistics();
+        sensorTransmitter.logStatistics();
+    } else if (command.startsWith("replay")) {
+        handleReplayCommand(command);
+    } else if (command.startsWith("simulate")) {
+        handleSimulateCommand(command);
+    } else if (command == "store") {
+        ParameterStore::logStatistics();
+    } else if (command == "store clear") {
+        ParameterStore::clear();
+    } else if (command == "sdlog") {
+        SdLogger::logStatistics();
+    } else if (command == "dump") {
+        SdLogger::listFiles();
+    } else if (command.startsWith("dump ")) {
+        SdLogger::startDump(command.substring(5).toInt());
+    } else if (command == "stats") {
+        TaskScheduler::logStatistics();
+#if PROFILING_ENABLED
+    } else if (command == "profile") {
+        Profiler::logReport();
+    } else if (command == "profile reset") {
+        Profiler::reset();
+        Logger::log(LogLevel::INFO, F("Profiler statistics reset"));
+    } else if (command == "profile telemetry on" || command == "profile telemetry off") {
+        Profiler::setTelemetryEnabled(command.endsWith("on"));
+        Logger::log(LogLevel::INFO, "Profiler data in telemetry " + command.substring(18));
+#endif
+    } else if (command == "telemetry binary" || command == "telemetry json") {
+        espCommunication.setBinaryTelemetry(command == "telemetry binary");
+        Logger::log(LogLevel::INFO, "Telemetry to ESP32 set to " + command.substring(10));
     } else {
         Logger::log(LogLevel::WARNING, "Unknown command: " + command);
     }
@@ -75,13 +120,44 @@ void CommandHandler::handleSetCommand(const String& command) {
     }
 }
 
+void CommandHandler::handleSimulateCommand(const String& command) {
+    if (command == "simulate") {
+        PlantSimulator::logState();
+    } else if (command == "simulate stop") {
+        PlantSimulator::stop();
+    } else if (command.startsWith("simulate start")) {
+        if (replayHarness.isRunning()) {
+            Logger::log(LogLevel::WARNING, F("Stop the replay before starting the plant simulation"));
+            return;
+        }
+        float timeScale = command.length() > 15 ? command.substring(15).toFloat() : 1.0f;
+        PlantSimulator::start(timeScale);
+    } else {
+        Logger::log(LogLevel::WARNING, "Invalid simulate command: " + command);
+    }
+}
+
+void CommandHandler::handleReplayCommand(const String& command) {
+    if (command.startsWith("replay step ")) {
+        replayHarness.step(command.substring(12));
+    } else if (command.startsWith("replay setpoints ")) {
+        replayHarness.setpoints(command.substring(17));
+    } else if (command == "replay start") {
+        replayHarness.start();
+    } else if (command == "replay stop") {
+        replayHarness.stop();
+    } else {
+        Logger::log(LogLevel::WARNING, "Invalid replay command: " + command);
+    }
+}
+
 void CommandHandler::handleVolumeInfoCommand() {
     String volumeInfo = volumeManager.getVolumeInfo();
     Logger::log(LogLevel::INFO, volumeInfo);
 }
 
 void CommandHandler::handlePHCalibrationCommand(const String& command) {
-    PHSensor* phSensor = (PHSensor*)SensorController::findSensorByName("phSensor");
+    PHSensor* phSensor = (PHSensor*)SensorController::getSensor(SensorId::PH);
     if (!phSensor) {
         Logger::log(LogLevel::WARNING, "pH sensor not found");
         return;
@@ -99,7 +175,7 @@ void CommandHandler::handlePHCalibrationCommand(const String& command) {
 }
 
 void CommandHandler::handleO2CalibrationCommand(const String& command) {
-    OxygenSensor* o2Sensor = (OxygenSensor*)SensorController::findSensorByName("oxygenSensor");
+    OxygenSensor* o2Sensor = (OxygenSensor*)SensorController::getSensor(SensorId::Oxygen);
     if (!o2Sensor) {
         Logger::log(LogLevel::WARNING, "O2 sensor not found");
         return;
@@ -161,6 +237,7 @@ void CommandHandler::printHelp() {
     Serial.println(F("  stop - Stop all actuators and PIDs"));
     Serial.println(F("  mix <speed> - Start mixing"));
     Serial.println(F("  fermentation <temp> <ph> <do> <nutrient_conc> <base_conc> <duration_hours> <nutrient_delay_hours> <experiment_name> <comment> - Start fermentation"));
+    Serial.println(F("  autotune <temperature|ph|do> [setpoint] [hysteresis] - Relay test of a PID loop, applies the identified tunings"));
     Serial.println(F("---ALARM & WARNING COMMANDS:---"));
     Serial.println(F("  alarm false - Disable safety alarms"));
     Serial.println(F("  alarm true - Enable safety alarms"));
@@ -172,6 +249,24 @@ void CommandHandler::printHelp() {
     Serial.println(F("  set_initial_volume <volume> - Set the initial culture volume (in liters)"));
     Serial.println(F("  volume info - Get all volume informations"));
     Serial.println(F("  reset volume - Reset the volume to initial conditions"));
+    Serial.println(F("  simulate start [time_scale] - Replace the sensors by a plant model driven by the actuators (time_scale speeds up the plant)"));
+    Serial.println(F("  simulate stop - Back to the physical sensors"));
+    Serial.println(F("  simulate - Show the state of the plant model"));
+    Serial.println(F("  replay start - Feed recorded sensor data through PID and safety on virtual time (drives the actuators!)"));
+    Serial.println(F("  replay step <dt_ms> <waterTemp> <airTemp> <elecTemp> <pH> <turbidity> <oxygen> <airFlow> - One replay step"));
+    Serial.println(F("  replay setpoints <temp> <ph> <do> - Start the PIDs with the recorded setpoints (no program is started)"));
+    Serial.println(F("  replay stop - Back to the physical sensors and real time"));
+    Serial.println(F("  store - Show the state of the parameter journal in EEPROM"));
+    Serial.println(F("  store clear - Erase the saved PID parameters, volumes, program state and checkpoint"));
+    Serial.println(F("  sdlog - Show samples, drops and write latency of the SD card logger"));
+    Serial.println(F("  dump - List the log files on the SD card"));
+    Serial.println(F("  dump <n> - Stream the log file LOGn.BIN to the console as DUMP: hex lines (tools/sdlog_dump.py)"));
+    Serial.println(F("  stats - Show execution time, jitter and deadline misses of the main loop tasks since the last call"));
+    Serial.println(F("  profile - Show min/avg/p99/max duration of the profiled code zones (profile reset to clear)"));
+    Serial.println(F("  profile telemetry on|off - Send the profiled zones to the ESP32 after the periodic data, on a line of their own"));
+    Serial.println(F("  sensor stats - Show physical sensor reads, consumer reads and pH/O2 link transactions since the last call"));
+    Serial.println(F("  telemetry binary - Send periodic data to the ESP32 as compact binary frames"));
+    Serial.println(F("  telemetry json - Send periodic data to the ESP32 as JSON (default)"));
     Serial.println(F("  set_pid_enabled - set pid enabled during Fermentation program (true, false "));
     Serial.println(F("---PH CALIBRATION COMMANDS:---"));
     Serial.println(F("  ph ENTERPH - Enter pH calibration mode : put the probe into the 4.0 or 7.0 standard buffer solution" ));
@@ -45,6 +45,10 @@ private:
 
     void handleO2CalibrationCommand(const String& command);
 
+    void handleSimulateCommand(const String& command);
+
+    void handleReplayCommand(const String& command);
+
     String sendCommandAndWaitResponse(const String& cmd) {
         Serial7.println(cmd);
         unsigned long startTime = millis();
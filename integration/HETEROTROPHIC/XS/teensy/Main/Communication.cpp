@@ -1,14 +1,19 @@
 // Communication.cpp
 #include "Communication.h"
 #include "CommandHandler.h"
+#include "Profiler.h"
 
 extern CommandHandler commandHandler;
 
 Communication::Communication(HardwareSerial& serial, DataCollector& dataCollector) 
-    : _serial(serial), _dataCollector(dataCollector) {}
+    : _serial(serial), _dataCollector(dataCollector), _binaryTelemetry(false), _reader(serial),
+      _defaultBaud(9600), _baud(9600), _awaitingPing(false), _lastLinkActivity(0) {}
 
 void Communication::begin(unsigned long baud) {
+    _defaultBaud = baud;
+    _baud = baud;
     _serial.begin(baud);
+    _serial.addMemoryForRead(_rxMemory, sizeof(_rxMemory));
 }
 
 bool Communication::available() {
@@ -16,16 +21,69 @@ bool Communication::available() {
 }
 
 String Communication::readMessage() {
-    if (_serial.available() > 0) {
-        String receivedData = _serial.readStringUntil('\n');
-        receivedData.trim();
-        if (receivedData.length() > 0) {
-            return receivedData;
-        }
+    String receivedData;
+    if (tryReadMessage(receivedData)) {
+        return receivedData;
     }
     return "";
 }
 
+bool Communication::tryReadMessage(String& message) {
+    checkLink();
+    while (_reader.tryReadLine(message)) {
+        message.trim();
+        if (message.length() > 0 && !handleLinkMessage(message)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Communication::handleLinkMessage(const String& message) {
+    if (!message.startsWith("LINK:")) {
+        return false;
+    }
+    _lastLinkActivity = millis();
+
+    if (message.startsWith("LINK:BAUD:")) {
+        unsigned long baud = message.substring(10).toInt();
+        if (isSupportedBaud(baud)) {
+            sendMessage("LINK:BAUD_OK:" + String(baud));
+            switchBaud(baud);
+            _awaitingPing = true;
+        } else {
+            sendMessage("LINK:BAUD_REFUSED:" + String(baud));
+        }
+    } else if (message == "LINK:PING") {
+        sendMessage("LINK:PONG");
+        if (_awaitingPing) {
+            _awaitingPing = false;
+            Logger::log(LogLevel::INFO, "ESP32 link running at " + String(_baud) + " baud");
+        }
+    }
+    return true;
+}
+
+void Communication::switchBaud(unsigned long baud) {
+    _serial.flush(); // Let the answer leave at the current baud rate
+    _serial.begin(baud);
+    _reader.clear();
+    _baud = baud;
+    _lastLinkActivity = millis();
+}
+
+void Communication::checkLink() {
+    if (_baud == _defaultBaud) {
+        return;
+    }
+    unsigned long silence = millis() - _lastLinkActivity;
+    if ((_awaitingPing && silence > LINK_CONFIRM_TIMEOUT) || silence > LINK_IDLE_TIMEOUT) {
+        _awaitingPing = false;
+        switchBaud(_defaultBaud);
+        Logger::log(LogLevel::WARNING, "ESP32 link lost, back to " + String(_defaultBaud) + " baud");
+    }
+}
+
 void Communication::sendMessage(const String& message) {
     _serial.println(message);
 }
@@ -91,8 +149,21 @@ void Communication::sendVolumeData() {
 }
 
 void Communication::sendAllData(const String& currentProgram, int currentState) {
-    String allData = _dataCollector.collectAllData(currentProgram, currentState);
-    sendMessage(allData);
+    PROFILE_ZONE("comm.sendAllData");
+    if (_binaryTelemetry) {
+        TelemetryProtocol::AllDataFrame frame;
+        uint8_t buffer[TelemetryProtocol::MAX_FRAME_SIZE];
+        _dataCollector.collectAllDataFrame(frame, currentProgram, currentState);
+        size_t length = TelemetryProtocol::encodeAllData(frame, buffer, sizeof(buffer));
+        _serial.write(buffer, length);
+    } else if (_dataCollector.writeAllData(_serial, currentProgram, currentState) > 0) {
+        // Streamed to the UART, same bytes as sendMessage(collectAllData())
+        _serial.println();
+    }
+
+    if (_dataCollector.writeProfile(_serial) > 0) {
+        _serial.println();
+    }
 }
 
 void Communication::sendProgramEvent(const String& programName, ProgramBase* program) {
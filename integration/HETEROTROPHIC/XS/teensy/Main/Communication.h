@@ -5,13 +5,17 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include "DataCollector.h"
+#include "SerialLineReader.h"
 
 class Communication {
 public:
     Communication(HardwareSerial& serial, DataCollector& dataCollector);
     void begin(unsigned long baud);
     bool available();
+    // Non-blocking: returns an empty String until a complete message has been received
     String readMessage();
+    // Non-blocking: true when a complete message has been received; also runs the baud rate negotiation
+    bool tryReadMessage(String& message);
     void sendMessage(const String& message);
     void processCommand(const String& command);
     void sendSensorData();
@@ -19,10 +23,42 @@ public:
     void sendVolumeData();
     void sendAllData(const String& currentProgram, int currentState);
     void sendProgramEvent(const String& programName, ProgramBase* program);
+
+    // Periodic data sent as binary frames (TelemetryProtocol) instead of JSON, expanded back to JSON by the ESP32
+    void setBinaryTelemetry(bool enabled) { _binaryTelemetry = enabled; }
+    bool isBinaryTelemetry() const { return _binaryTelemetry; }
     
 private:
     HardwareSerial& _serial;
     DataCollector& _dataCollector;
+    bool _binaryTelemetry;
+
+    // Receive side: the RX interrupt fills the UART ring buffer (enlarged with _rxMemory),
+    // the line reader assembles messages from it without waiting.
+    // At 460800 baud 4 KB hold 90 ms: two command task periods plus the slowest pass (SD card erase, ~40 ms)
+    static const size_t RX_MEMORY_SIZE = 4096;
+    static const size_t MESSAGE_BUFFER_SIZE = 512;
+    uint8_t _rxMemory[RX_MEMORY_SIZE];
+    SerialLineReader<MESSAGE_BUFFER_SIZE> _reader;
+
+    /*
+     * Baud rate negotiation, started by the ESP32 at the default baud rate:
+     *   ESP32 -> "LINK:BAUD:<rate>", Teensy -> "LINK:BAUD_OK:<rate>" (or "LINK:BAUD_REFUSED:<rate>")
+     *   both switch, then ESP32 -> "LINK:PING", Teensy -> "LINK:PONG"
+     * The Teensy goes back to the default baud rate if no PING arrives after the switch,
+     * or if the ESP32 stays silent for LINK_IDLE_TIMEOUT (e.g. after a reboot).
+     */
+    static const unsigned long LINK_CONFIRM_TIMEOUT = 2000;
+    static const unsigned long LINK_IDLE_TIMEOUT = 30000;
+    unsigned long _defaultBaud;
+    unsigned long _baud;
+    bool _awaitingPing;
+    unsigned long _lastLinkActivity;
+
+    bool handleLinkMessage(const String& message);
+    void switchBaud(unsigned long baud);
+    void checkLink();
+    static bool isSupportedBaud(unsigned long baud) { return baud == 115200 || baud == 460800; }
 };
 
 #endif // COMMUNICATION_H
\ No newline at end of file
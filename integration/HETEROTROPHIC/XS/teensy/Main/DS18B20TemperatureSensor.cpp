@@ -8,7 +8,8 @@
 #include "Logger.h"
 
 // Constructor for DS18B20TemperatureSensor
-DS18B20TemperatureSensor::DS18B20TemperatureSensor(int pin, const char* name) : _ds(pin), _pin(pin), _name(name) {}
+DS18B20TemperatureSensor::DS18B20TemperatureSensor(int pin, const char* name)
+    : _ds(pin), _pin(pin), _name(name), _hasAddress(false), _pendingError(0), _conversionStart(0) {}
 
 // Method to initialize the temperature sensor
 void DS18B20TemperatureSensor::begin() {
@@ -17,42 +18,85 @@ void DS18B20TemperatureSensor::begin() {
     Logger::log(LogLevel::INFO, String(_name) + F(" initialized"));
 }
 
-// Method to read the temperature from the sensor
+// Method to read the temperature from the sensor (blocking, used outside the acquisition loop)
 float DS18B20TemperatureSensor::readValue() {
-    byte data[12];
-    byte addr[8];
+    float value;
+    startReading();
+    delay(CONVERSION_TIME);
+    while (!pollReading(value)) {
+        delay(10);
+    }
+    return value;
+}
 
-    if (!_ds.search(addr)) {
+// Search the bus for the sensor ROM address; only done until a valid sensor has been found
+float DS18B20TemperatureSensor::locateSensor() {
+    if (!_ds.search(_addr)) {
         _ds.reset_search();
         //Serial.println("no DS18B20 temperature sensor found!");
         return -1000; // Return an error value if no sensor found
     }
+    _ds.reset_search();
 
-    if (OneWire::crc8(addr, 7) != addr[7]) {
+    if (OneWire::crc8(_addr, 7) != _addr[7]) {
         //Serial.println("CRC is not valid (DS18B20 temperature sensor)!");
         return -2000; // Return an error value if CRC check fails
     }
 
-    if (addr[0] != 0x10 && addr[0] != 0x28) {
+    if (_addr[0] != 0x10 && _addr[0] != 0x28) {
         //Serial.print("Device (DS18B20 temperature sensor) is not recognized");
         return -3000; // Return an error value if the device is not recognized
     }
 
-    _ds.reset();
-    _ds.select(addr);
+    _hasAddress = true;
+    return 0;
+}
+
+bool DS18B20TemperatureSensor::startReading() {
+    _pendingError = 0;
+
+    if (!_hasAddress) {
+        _pendingError = locateSensor();
+        if (_pendingError != 0) {
+            return true; // The error is reported at the next poll
+        }
+    }
+
+    if (!_ds.reset()) {
+        _hasAddress = false; // Sensor disconnected, search again next time
+        _pendingError = -1000;
+        return true;
+    }
+    _ds.skip();         // Each sensor has its own pin: Skip ROM instead of the 9-byte Match ROM
     _ds.write(0x44, 1); // Start temperature conversion
+    _conversionStart = millis(); // The conversion time counts from the command, after the bus transfers
+    return true;
+}
 
-    delay(1000); // Wait for conversion to complete
+bool DS18B20TemperatureSensor::pollReading(float& value) {
+    if (_pendingError != 0) {
+        value = _pendingError;
+        return true;
+    }
+    if (millis() - _conversionStart < CONVERSION_TIME) {
+        return false; // Conversion still in progress
+    }
+    value = readScratchpad();
+    return true;
+}
+
+// Only the two temperature bytes are read, a reset ends the transfer: the pass stays within a few ms of bus slots
+float DS18B20TemperatureSensor::readScratchpad() {
+    byte data[2];
 
     _ds.reset();
-    _ds.select(addr);
+    _ds.skip();
     _ds.write(0xBE); // Read Scratchpad
 
-    for (int i = 0; i < 9; i++) {
+    for (int i = 0; i < 2; i++) {
         data[i] = _ds.read();
     }
-
-    _ds.reset_search();
+    _ds.reset();
 
     int16_t rawTemperature = (data[1] << 8) | data[0];
     float  temperature = rawTemperature / 16.0; // Convert raw temperature to Celsius
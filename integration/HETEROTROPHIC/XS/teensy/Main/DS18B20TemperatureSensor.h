@@ -44,12 +44,36 @@ public:
      * @return: The temperature in degrees Celsius.
      */
     float readValue();
+
+    /*
+     * Method to start a temperature conversion without waiting for it.
+     * @return: true if a conversion has been started (or an error value is pending).
+     */
+    bool startReading() override;
+
+    /*
+     * Method to poll the conversion started with startReading().
+     * @param value: The temperature in degrees Celsius, or an error value.
+     * @return: true once the conversion time has elapsed and the scratchpad has been read.
+     */
+    bool pollReading(float& value) override;
+
     const char* getName() const override { return _name; }
 
 private:
     OneWire _ds; // OneWire object for communication with DS18B20
     int _pin;    // Digital pin connected to the DS18B20
     const char* _name;
+
+    byte _addr[8];                   // ROM address of the sensor, checked once (CRC and family code)
+    bool _hasAddress;                // True once a valid sensor has been found on the bus
+    float _pendingError;             // Error value to report at the next poll (0 if none)
+    unsigned long _conversionStart;  // Time at which the current conversion was started
+
+    static const unsigned long CONVERSION_TIME = 750; // Max conversion time at 12-bit resolution (ms)
+
+    float locateSensor();
+    float readScratchpad();
 };
 
 #endif
@@ -1,7 +1,10 @@
 // DataCollector.cpp
 #include "DataCollector.h"
+#include "Logger.h"
+#include "Profiler.h"
 
-DataCollector::DataCollector(VolumeManager& volumeManager) : _volumeManager(volumeManager) {}
+DataCollector::DataCollector(VolumeManager& volumeManager)
+    : _volumeManager(volumeManager), _frameAllocator(_frameBuffer, FRAME_BUFFER_SIZE) {}
 
 String DataCollector::collectProgramEvent(const String& programName, ProgramBase* program) {
     JsonDocument doc;
@@ -19,14 +22,7 @@ String DataCollector::collectProgramEvent(const String& programName, ProgramBase
 
 String DataCollector::collectSensorData() {
     JsonDocument doc;
-
-    doc["waterTemp"] = SensorController::readSensor("waterTempSensor");
-    doc["airTemp"] = SensorController::readSensor("airTempSensor");
-    doc["elecTemp"] = SensorController::readSensor("electronicTempSensor");
-    doc["pH"] = SensorController::readSensor("phSensor");
-    doc["turbidity"] = SensorController::readSensor("turbiditySensorSEN0554");
-    doc["oxygen"] = SensorController::readSensor("oxygenSensor");
-    doc["airFlow"] = SensorController::readSensor("airFlowSensor");
+    addSensorData(doc.to<JsonObject>());
 
     String output;
     serializeJson(doc, output);
@@ -35,16 +31,7 @@ String DataCollector::collectSensorData() {
 
 String DataCollector::collectActuatorData() {
     JsonDocument doc;
-
-    doc["airPump"] = ActuatorController::isActuatorRunning("airPump");
-    doc["drainPump"] = ActuatorController::isActuatorRunning("drainPump");
-    doc["samplePump"] = ActuatorController::isActuatorRunning("samplePump");
-    doc["nutrientPump"] = ActuatorController::isActuatorRunning("nutrientPump");
-    doc["basePump"] = ActuatorController::isActuatorRunning("basePump");
-    doc["fillPump"] = ActuatorController::isActuatorRunning("fillPump");
-    doc["stirringMotor"] = ActuatorController::isActuatorRunning("stirringMotor");
-    doc["heatingPlate"] = ActuatorController::isActuatorRunning("heatingPlate");
-    doc["ledGrowLight"] = ActuatorController::isActuatorRunning("ledGrowLight");
+    addActuatorData(doc.to<JsonObject>());
 
     String output;
     serializeJson(doc, output);
@@ -53,17 +40,8 @@ String DataCollector::collectActuatorData() {
 
 String DataCollector::collectActuatorSetpoints() {
     JsonDocument doc;
-    
-    doc["airPumpValue"] = ActuatorController::getCurrentValue("airPump");
-    doc["drainPumpValue"] = ActuatorController::getCurrentValue("drainPump");
-    doc["samplePumpValue"] = ActuatorController::getCurrentValue("samplePump");
-    doc["nutrientPumpValue"] = ActuatorController::getCurrentValue("nutrientPump");
-    doc["basePumpValue"] = ActuatorController::getCurrentValue("basePump");
-    doc["fillPumpValue"] = ActuatorController::getCurrentValue("fillPump");
-    doc["stirringMotorValue"] = ActuatorController::getCurrentValue("stirringMotor");
-    doc["heatingPlateValue"] = ActuatorController::getCurrentValue("heatingPlate");
-    doc["ledGrowLightValue"] = ActuatorController::getCurrentValue("ledGrowLight");
-    
+    addActuatorSetpoints(doc.to<JsonObject>());
+
     String output;
     serializeJson(doc, output);
     return output;
@@ -71,19 +49,71 @@ String DataCollector::collectActuatorSetpoints() {
 
 String DataCollector::collectVolumeData() {
     JsonDocument doc;
-
-    doc["currentVolume"] = _volumeManager.getCurrentVolume();
-    doc["availableVolume"] = _volumeManager.getAvailableVolume();
-    doc["addedNaOH"] = _volumeManager.getAddedNaOH();
-    doc["addedNutrient"] = _volumeManager.getAddedNutrient();
-    doc["addedMicroalgae"] = _volumeManager.getAddedMicroalgae();
-    doc["removedVolume"] = _volumeManager.getRemovedVolume();
+    addVolumeData(doc.to<JsonObject>());
 
     String output;
     serializeJson(doc, output);
     return output;
 }
 
+void DataCollector::addSensorData(JsonObject data) {
+    const SensorSnapshot& snapshot = SensorController::getSnapshot();
+
+    data["waterTemp"] = snapshot.waterTemp;
+    data["airTemp"] = snapshot.airTemp;
+    data["elecTemp"] = snapshot.electronicTemp;
+    data["pH"] = snapshot.pH;
+    data["turbidity"] = snapshot.turbidity;
+    data["oxygen"] = snapshot.oxygen;
+    data["airFlow"] = snapshot.airFlow;
+}
+
+void DataCollector::addActuatorData(JsonObject data) {
+    data["airPump"] = ActuatorController::isActuatorRunning(ActuatorId::AirPump);
+    data["drainPump"] = ActuatorController::isActuatorRunning(ActuatorId::DrainPump);
+    data["samplePump"] = ActuatorController::isActuatorRunning(ActuatorId::SamplePump);
+    data["nutrientPump"] = ActuatorController::isActuatorRunning(ActuatorId::NutrientPump);
+    data["basePump"] = ActuatorController::isActuatorRunning(ActuatorId::BasePump);
+    data["fillPump"] = ActuatorController::isActuatorRunning(ActuatorId::FillPump);
+    data["stirringMotor"] = ActuatorController::isActuatorRunning(ActuatorId::StirringMotor);
+    data["heatingPlate"] = ActuatorController::isActuatorRunning(ActuatorId::HeatingPlate);
+    data["ledGrowLight"] = ActuatorController::isActuatorRunning(ActuatorId::LedGrowLight);
+}
+
+// Time left (ms) on the timed runs, 0 when the actuator is stopped or runs continuously
+void DataCollector::addActuatorTimers(JsonObject data) {
+    data["airPumpRemaining"] = ActuatorController::getRemainingTime(ActuatorId::AirPump);
+    data["drainPumpRemaining"] = ActuatorController::getRemainingTime(ActuatorId::DrainPump);
+    data["samplePumpRemaining"] = ActuatorController::getRemainingTime(ActuatorId::SamplePump);
+    data["nutrientPumpRemaining"] = ActuatorController::getRemainingTime(ActuatorId::NutrientPump);
+    data["basePumpRemaining"] = ActuatorController::getRemainingTime(ActuatorId::BasePump);
+    data["fillPumpRemaining"] = ActuatorController::getRemainingTime(ActuatorId::FillPump);
+    data["stirringMotorRemaining"] = ActuatorController::getRemainingTime(ActuatorId::StirringMotor);
+    data["heatingPlateRemaining"] = ActuatorController::getRemainingTime(ActuatorId::HeatingPlate);
+    data["ledGrowLightRemaining"] = ActuatorController::getRemainingTime(ActuatorId::LedGrowLight);
+}
+
+void DataCollector::addActuatorSetpoints(JsonObject data) {
+    data["airPumpValue"] = ActuatorController::getCurrentValue(ActuatorId::AirPump);
+    data["drainPumpValue"] = ActuatorController::getCurrentValue(ActuatorId::DrainPump);
+    data["samplePumpValue"] = ActuatorController::getCurrentValue(ActuatorId::SamplePump);
+    data["nutrientPumpValue"] = ActuatorController::getCurrentValue(ActuatorId::NutrientPump);
+    data["basePumpValue"] = ActuatorController::getCurrentValue(ActuatorId::BasePump);
+    data["fillPumpValue"] = ActuatorController::getCurrentValue(ActuatorId::FillPump);
+    data["stirringMotorValue"] = ActuatorController::getCurrentValue(ActuatorId::StirringMotor);
+    data["heatingPlateValue"] = ActuatorController::getCurrentValue(ActuatorId::HeatingPlate);
+    data["ledGrowLightValue"] = ActuatorController::getCurrentValue(ActuatorId::LedGrowLight);
+}
+
+void DataCollector::addVolumeData(JsonObject data) {
+    data["currentVolume"] = _volumeManager.getCurrentVolume();
+    data["availableVolume"] = _volumeManager.getAvailableVolume();
+    data["addedNaOH"] = _volumeManager.getAddedNaOH();
+    data["addedNutrient"] = _volumeManager.getAddedNutrient();
+    data["addedMicroalgae"] = _volumeManager.getAddedMicroalgae();
+    data["removedVolume"] = _volumeManager.getRemovedVolume();
+}
+
 String DataCollector::collectPIDData(const String& pidType, float setpoint, float input, float output) {
     JsonDocument doc;
     
@@ -132,39 +162,100 @@ String DataCollector::collectAllData(const String& currentProgram, int currentSt
 }
 */
 
-String DataCollector::collectAllData(const String& currentProgram, int currentState) {
-    JsonDocument doc;
-    JsonDocument tempDoc;
-
+// The sub-objects are filled in place: one document and one serialization pass per frame
+bool DataCollector::buildAllData(JsonDocument& doc, const String& currentProgram, int currentState) {
+    PROFILE_ZONE("data.buildAllData");
     // Add program information
     doc["currentProgram"] = currentProgram;
     doc["programState"] = static_cast<int>(currentState);
 
-    // Collect sensor data
-    String sensorDataStr = collectSensorData();
-    deserializeJson(tempDoc, sensorDataStr);
-    doc["sensorData"] = tempDoc;
-    tempDoc.clear();
-
-    // Collect actuator data
-    String actuatorDataStr = collectActuatorData();
-    deserializeJson(tempDoc, actuatorDataStr);
-    doc["actuatorData"] = tempDoc;
-    tempDoc.clear();
+    addSensorData(doc["sensorData"].to<JsonObject>());
+    addActuatorData(doc["actuatorData"].to<JsonObject>());
+    addActuatorSetpoints(doc["actuatorSetpoints"].to<JsonObject>());
+    addActuatorTimers(doc["actuatorTimers"].to<JsonObject>());
+    addVolumeData(doc["volumeData"].to<JsonObject>());
 
-    // Collect actuator setpoints
-    String setpointsDataStr = collectActuatorSetpoints();
-    deserializeJson(tempDoc, setpointsDataStr);
-    doc["actuatorSetpoints"] = tempDoc;
-    tempDoc.clear();
+    if (doc.overflowed()) {
+        Logger::log(LogLevel::ERROR, F("Telemetry frame does not fit in the frame buffer"));
+        return false;
+    }
+    return true;
+}
 
-    // Collect volume data
-    String volumeDataStr = collectVolumeData();
-    deserializeJson(tempDoc, volumeDataStr);
-    doc["volumeData"] = tempDoc;
-    tempDoc.clear();
+String DataCollector::collectAllData(const String& currentProgram, int currentState) {
+    JsonDocument doc;
+    buildAllData(doc, currentProgram, currentState);
 
     String output;
     serializeJson(doc, output);
     return output;
 }
+
+size_t DataCollector::writeAllData(Print& output, const String& currentProgram, int currentState) {
+    _frameAllocator.reset();
+    JsonDocument doc(&_frameAllocator);
+    if (!buildAllData(doc, currentProgram, currentState)) {
+        return 0;
+    }
+    return serializeJson(doc, output);
+}
+
+size_t DataCollector::writeAllData(char* buffer, size_t size, const String& currentProgram, int currentState) {
+    _frameAllocator.reset();
+    JsonDocument doc(&_frameAllocator);
+    if (!buildAllData(doc, currentProgram, currentState) || measureJson(doc) >= size) {
+        return 0;
+    }
+    return serializeJson(doc, buffer, size);
+}
+
+size_t DataCollector::writeProfile(Print& output) {
+#if PROFILING_ENABLED
+    if (!Profiler::isTelemetryEnabled()) {
+        return 0;
+    }
+    _frameAllocator.reset();
+    JsonDocument doc(&_frameAllocator);
+    Profiler::addTelemetry(doc["profile"].to<JsonObject>());
+    if (doc.overflowed()) {
+        Logger::log(LogLevel::ERROR, F("Profile does not fit in the frame buffer"));
+        return 0;
+    }
+    return serializeJson(doc, output);
+#else
+    return 0;
+#endif
+}
+
+void DataCollector::collectAllDataFrame(TelemetryProtocol::AllDataFrame& frame, const String& currentProgram, int currentState) {
+    strncpy(frame.currentProgram, currentProgram.c_str(), TelemetryProtocol::PROGRAM_NAME_SIZE - 1);
+    frame.currentProgram[TelemetryProtocol::PROGRAM_NAME_SIZE - 1] = '\0';
+    frame.programState = static_cast<uint8_t>(currentState);
+
+    const SensorSnapshot& snapshot = SensorController::getSnapshot();
+    frame.waterTemp = snapshot.waterTemp;
+    frame.airTemp = snapshot.airTemp;
+    frame.elecTemp = snapshot.electronicTemp;
+    frame.pH = snapshot.pH;
+    frame.turbidity = snapshot.turbidity;
+    frame.oxygen = snapshot.oxygen;
+    frame.airFlow = snapshot.airFlow;
+
+    // Indexed by ActuatorId
+    frame.actuatorRunning = 0;
+    for (uint8_t i = 0; i < TelemetryProtocol::ACTUATOR_COUNT; i++) {
+        ActuatorId id = static_cast<ActuatorId>(i);
+        if (ActuatorController::isActuatorRunning(id)) {
+            frame.actuatorRunning |= (1 << i);
+        }
+        frame.actuatorValues[i] = ActuatorController::getCurrentValue(id);
+        frame.actuatorRemaining[i] = ActuatorController::getRemainingTime(id);
+    }
+
+    frame.currentVolume = _volumeManager.getCurrentVolume();
+    frame.availableVolume = _volumeManager.getAvailableVolume();
+    frame.addedNaOH = _volumeManager.getAddedNaOH();
+    frame.addedNutrient = _volumeManager.getAddedNutrient();
+    frame.addedMicroalgae = _volumeManager.getAddedMicroalgae();
+    frame.removedVolume = _volumeManager.getRemovedVolume();
+}
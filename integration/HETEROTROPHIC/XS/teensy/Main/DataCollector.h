@@ -8,6 +8,8 @@
 #include "ActuatorController.h"
 #include "VolumeManager.h"
 #include "ProgramBase.h"
+#include "JsonFrameAllocator.h"
+#include "TelemetryProtocol.h"
 
 class DataCollector {
 public:
@@ -32,11 +34,38 @@ public:
     // Colelct sensor, actuator and volume data
     String collectAllData(const String& currentProgram, int currentState);
 
+    // Write the same frame as collectAllData() straight to a sink (e.g. the ESP32 UART), without intermediate Strings
+    size_t writeAllData(Print& output, const String& currentProgram, int currentState);
+
+    // Write the same frame into a caller supplied buffer, returns 0 if it does not fit
+    size_t writeAllData(char* buffer, size_t size, const String& currentProgram, int currentState);
+
+    /*
+     * Write the profiled zones as {"profile":{...}} when "profile telemetry on" is set, returns 0 otherwise.
+     * Sent as a line of its own: with the periodic data it would not fit in TelemetryProtocol::MAX_TEXT_LINE_LENGTH.
+     */
+    size_t writeProfile(Print& output);
+
+    // Fill the fixed layout binary frame carrying the same values as collectAllData()
+    void collectAllDataFrame(TelemetryProtocol::AllDataFrame& frame, const String& currentProgram, int currentState);
+
     // Collect current setpoint values for all actuators
     String collectActuatorSetpoints();  
 
 private:
     VolumeManager& _volumeManager;
+
+    // Fixed memory for the frame document, so that the periodic frame does not touch the heap
+    static const size_t FRAME_BUFFER_SIZE = 4096;
+    alignas(sizeof(void*)) uint8_t _frameBuffer[FRAME_BUFFER_SIZE];
+    JsonFrameAllocator _frameAllocator;
+
+    void addSensorData(JsonObject data);
+    void addActuatorData(JsonObject data);
+    void addActuatorSetpoints(JsonObject data);
+    void addActuatorTimers(JsonObject data);
+    void addVolumeData(JsonObject data);
+    bool buildAllData(JsonDocument& doc, const String& currentProgram, int currentState);
 };
 
 #endif // DATA_COLLECTOR_H
\ No newline at end of file
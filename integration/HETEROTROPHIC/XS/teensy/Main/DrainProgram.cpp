@@ -18,7 +18,7 @@ void DrainProgram::start(const String& command) {
         _isPaused = false;
         startTime = millis();
         
-        ActuatorController::runActuator("drainPump", rate, 0); // 0 for continuous operation
+        ActuatorController::runActuator(ActuatorId::DrainPump, rate, 0); // 0 for continuous operation
         Logger::log(LogLevel::INFO, "Drain started at rate: " + String(rate));
     } else {
         //Logger::log(LogLevel::ERROR, "Invalid drain command format");
@@ -38,7 +38,7 @@ void DrainProgram::update() {
 
 void DrainProgram::pause() {
     if (_isRunning && !_isPaused) {
-        ActuatorController::stopActuator("drainPump");
+        ActuatorController::stopActuator(ActuatorId::DrainPump);
         _isPaused = true;
         //Logger::log(LogLevel::INFO, "Drain paused");
         Logger::log(LogLevel::INFO, F("Drain paused"));
@@ -47,7 +47,7 @@ void DrainProgram::pause() {
 
 void DrainProgram::resume() {
     if (_isRunning && _isPaused) {
-        ActuatorController::runActuator("drainPump", rate, 0);
+        ActuatorController::runActuator(ActuatorId::DrainPump, rate, 0);
         _isPaused = false;
         //Logger::log(LogLevel::INFO, "Drain resumed");
         Logger::log(LogLevel::INFO, F("Drain resumed"));
@@ -56,7 +56,7 @@ void DrainProgram::resume() {
 
 void DrainProgram::stop() {
     if (_isRunning) {
-        ActuatorController::stopActuator("drainPump");
+        ActuatorController::stopActuator(ActuatorId::DrainPump);
         _isRunning = false;
         _isPaused = false;
     }
@@ -1,6 +1,9 @@
 #include "FermentationProgram.h"
 #include <Arduino.h>
 #include "Logger.h"
+#include "Profiler.h"
+#include "ParameterStore.h"
+#include "SystemClock.h"
 
 
 /*
@@ -41,8 +44,6 @@ FermentationProgram::FermentationProgram(PIDManager& pidManager, VolumeManager&
     : ProgramBase(),
       pidManager(pidManager),
       volumeManager(volumeManager),
-      nutrientFixedFlowRate(DEFAULT_NUTRIENT_FLOW_RATE),
-      totalPauseTime(0),
       tempSetpoint(0),
       phSetpoint(0),
       doSetpoint(0),
@@ -51,9 +52,11 @@ FermentationProgram::FermentationProgram(PIDManager& pidManager, VolumeManager&
       duration(0),
       startTime(0),
       pauseStartTime(0),
-      isPIDEnabled(true), //PID activated by default ; false/true
+      totalPauseTime(0),
+      currentStirringSpeed(0),
       lastNutrientActivationTime(0),
-      currentStirringSpeed(0)
+      isPIDEnabled(true), //PID activated by default ; false/true
+      nutrientFixedFlowRate(DEFAULT_NUTRIENT_FLOW_RATE)
 {
 }
 
@@ -99,7 +102,7 @@ void FermentationProgram::start(const String& command) {
     }
     _isRunning = true;
     _isPaused = false;
-    startTime = millis();
+    startTime = SystemClock::now();
     totalPauseTime = 0;
     nutrientAdditionStarted = false;
 
@@ -110,6 +113,10 @@ void FermentationProgram::start(const String& command) {
         pidManager.startPHPID(phSetpoint);
         pidManager.startDOPID(doSetpoint);
         }
+
+    // Written at once: the checkpoint of an earlier run must never be resumed with this command
+    checkpoint();
+    ParameterStore::service(-1);
     
     //ActuatorController::runActuator("airPump", 50, 0);  // Start air pump at 50% speed
     //ActuatorController::runActuator("stirringMotor", 390, 0);  // Start stirring at 390 RPM
@@ -138,6 +145,7 @@ void FermentationProgram::start(const String& command) {
 
 void FermentationProgram::update() {
     if (!_isRunning || _isPaused) return;
+    PROFILE_ZONE("fermentation.update");
 
     if (isPIDEnabled) {
         pidManager.updateAllPIDControllers();
@@ -149,7 +157,7 @@ void FermentationProgram::update() {
     checkCompletion();
 
     // Check if it's time to start adding nutrients
-    unsigned long elapsedTime = millis() - startTime - totalPauseTime;
+    unsigned long elapsedTime = SystemClock::now() - startTime - totalPauseTime;
     if (!nutrientAdditionStarted && elapsedTime >= nutrientStartDelay) {
         nutrientAdditionStarted = true;
         Logger::log(LogLevel::INFO, "Starting nutrient addition after delay of " + 
@@ -159,21 +167,25 @@ void FermentationProgram::update() {
     if (nutrientAdditionStarted) {
         addNutrientsContinuouslyFixedRate(nutrientFixedFlowRate);
     }
-    
+
+    if (_isRunning && SystemClock::now() - lastCheckpointTime >= CHECKPOINT_INTERVAL) {
+        checkpoint();
+    }
 }
 
 void FermentationProgram::pause() {
     if (!_isRunning || _isPaused) return;
 
     _isPaused = true;
-    pauseStartTime = millis();
+    pauseStartTime = SystemClock::now();
 
     pidManager.pauseAllPID();
 
-    ActuatorController::runActuator("stirringMotor", 390, 0);  // Minimum stirring speed
-    ActuatorController::stopActuator("airPump");
-    ActuatorController::stopActuator("nutrientPump");
-    ActuatorController::stopActuator("basePump");
+    ActuatorController::runActuator(ActuatorId::StirringMotor, 390, 0);  // Minimum stirring speed
+    ActuatorController::stopActuator(ActuatorId::AirPump);
+    ActuatorController::stopActuator(ActuatorId::NutrientPump);
+    ActuatorController::stopActuator(ActuatorId::BasePump);
+    checkpoint();
 
     //Logger::log(LogLevel::INFO, "Fermentation paused");
     Logger::log(LogLevel::INFO, F("Fermentation paused"));
@@ -183,11 +195,12 @@ void FermentationProgram::resume() {
     if (!_isRunning || !_isPaused) return;
 
     _isPaused = false;
-    totalPauseTime += millis() - pauseStartTime;
+    totalPauseTime += SystemClock::now() - pauseStartTime;
 
     pidManager.resumeAllPID();
 
-    ActuatorController::runActuator("airPump", 30, 0);  // Resume air pump at 30% speed
+    ActuatorController::runActuator(ActuatorId::AirPump, 30, 0);  // Resume air pump at 30% speed
+    checkpoint();
 
     //Logger::log(LogLevel::INFO, "Fermentation resumed");
     Logger::log(LogLevel::INFO, F("Fermentation resumed"));
@@ -226,9 +239,9 @@ void FermentationProgram::checkCompletion() {
     Logger::log(LogLevel::INFO, "Fermentation stopped: Volume limit reached");
     return;
   }
-  unsigned long currentTime = millis();
+  unsigned long currentTime = SystemClock::now();
   unsigned long elapsedTime = currentTime - startTime - totalPauseTime;
-  if (elapsedTime >= static_cast<unsigned long>(duration) * 1000UL) {
+  if (elapsedTime >= duration) {
     stop();
     Logger::log(LogLevel::INFO, "Fermentation completed. Elapsed time: " + String(elapsedTime/1000) + " s");
     Logger::log(LogLevel::INFO, F("Fermentation stopped: Duration exceeded"));
@@ -241,7 +254,7 @@ void FermentationProgram::initializeStirringSpeed() {
     int minSpeed = max(MIN_STIRRING_SPEED, ActuatorController::getStirringMotorMinRPM());
     currentStirringSpeed = min(minSpeed, ActuatorController::getStirringMotorMaxRPM());
     pidManager.setMinStirringSpeed(currentStirringSpeed);
-    ActuatorController::runActuator("stirringMotor", currentStirringSpeed, 0);  // 0 for continuous operation
+    ActuatorController::runActuator(ActuatorId::StirringMotor, currentStirringSpeed, 0);  // 0 for continuous operation
     Logger::log(LogLevel::INFO, "Fermentation stirring speed initialized to: " + String(currentStirringSpeed) + " RPM");
 }
 
@@ -252,7 +265,7 @@ void FermentationProgram::parseCommand(const String& command) {
     int paramCount = 0;
     int lastIndex = command.indexOf(' ') + 1;
     
-    while (lastIndex < command.length() && paramCount < 9) {
+    while (lastIndex < static_cast<int>(command.length()) && paramCount < 9) {
         if (command.charAt(lastIndex) == '"') {
             // Si on trouve un guillemet, chercher le guillemet fermant
             int endQuote = command.indexOf('"', lastIndex + 1);
@@ -297,7 +310,7 @@ void FermentationProgram::parseCommand(const String& command) {
 /*
 void FermentationProgram::addNutrientsContinuously() {
     // Calculate elapsed time in hours
-    float elapsedTime = (millis() - startTime) / 3600000.0;
+    float elapsedTime = (SystemClock::now() - startTime) / 3600000.0;
     // Calculate total amount of nutrients to add based on current volume and desired concentration
     float totalNutrientToAdd = nutrientConc * volumeManager.getCurrentVolume();
     // Calculate the amount of nutrients to add now based on elapsed time
@@ -321,14 +334,14 @@ void FermentationProgram::addNutrientsContinuously() {
 */
 
 void FermentationProgram::addNutrientsContinuouslyFixedRate(float fixedFlowRate) {
-    unsigned long currentTime = millis();
+    unsigned long currentTime = SystemClock::now();
 
     // Check if the program is still running
     if (!_isRunning || _isPaused) {
-        if (ActuatorController::isActuatorRunning("nutrientPump")) {
+        if (ActuatorController::isActuatorRunning(ActuatorId::NutrientPump)) {
             unsigned long runTime = currentTime - lastNutrientActivationTime;
             float addedVolume = (fixedFlowRate / 60.0) * (runTime / 1000.0);
-            ActuatorController::stopActuator("nutrientPump");
+            ActuatorController::stopActuator(ActuatorId::NutrientPump);
             volumeManager.recordVolumeChange(addedVolume / 1000.0, "Nutrient"); // Convert to litres
             volumeManager.updateVolume();
             Logger::log(LogLevel::INFO, F("Nutrient pump stopped due to program stop/pause"));
@@ -338,10 +351,10 @@ void FermentationProgram::addNutrientsContinuouslyFixedRate(float fixedFlowRate)
     }
 
     // Check whether we are currently adding nutrients
-    if (ActuatorController::isActuatorRunning("nutrientPump")) {
+    if (ActuatorController::isActuatorRunning(ActuatorId::NutrientPump)) {
         // Check if it's time to stop adding nutrients
         if (currentTime - lastNutrientActivationTime >= plannedNutrientActivationTime) {
-            ActuatorController::stopActuator("nutrientPump");
+            ActuatorController::stopActuator(ActuatorId::NutrientPump);
             float addedVolume = (fixedFlowRate / 60.0) * (plannedNutrientActivationTime / 1000.0);
             volumeManager.recordVolumeChange(addedVolume / 1000.0, "Nutrient"); // Convert to litres
             volumeManager.updateVolume();
@@ -349,6 +362,7 @@ void FermentationProgram::addNutrientsContinuouslyFixedRate(float fixedFlowRate)
             Logger::log(LogLevel::INFO, "Added volume: " + String(addedVolume, 3) + " ml");
             Logger::log(LogLevel::INFO, "Current volume: " + String(volumeManager.getCurrentVolume(), 3) + " L");
             lastNutrientActivationTime = currentTime;
+            checkpoint();
         }
         return;
     }
@@ -367,7 +381,7 @@ void FermentationProgram::addNutrientsContinuouslyFixedRate(float fixedFlowRate)
         return;
     }
 
-    if ((currentTime - startTime) > (duration * 1000UL)) {
+    if ((currentTime - startTime) > duration) {
         stop();
         Logger::log(LogLevel::INFO, F("Fermentation stopped: Duration exceeded"));
         return;
@@ -382,14 +396,82 @@ void FermentationProgram::addNutrientsContinuouslyFixedRate(float fixedFlowRate)
     if (nutrientToAdd > 0) {
         Logger::log(LogLevel::INFO, "Starting nutrient addition: " + String(nutrientToAdd, 3) + " ml");
         plannedNutrientActivationTime = static_cast<unsigned long>((nutrientToAdd / maxPossibleAddition) * NUTRIENT_ACTIVATION_TIME);
-        ActuatorController::runActuator("nutrientPump", fixedFlowRate, 0); // 0 for continuous duration
+        ActuatorController::runActuator(ActuatorId::NutrientPump, fixedFlowRate, 0); // 0 for continuous duration
         lastNutrientActivationTime = currentTime;
+        checkpoint();
         Logger::log(LogLevel::INFO, "Nutrient pump activated for planned duration: " + String(plannedNutrientActivationTime / 1000) + " s");
     } else {
         Logger::log(LogLevel::INFO, "No nutrients added: insufficient available volume");
     }
 }
 
+void FermentationProgram::checkpoint() {
+    unsigned long now = SystemClock::now();
+    FermentationCheckpointRecord record;
+    memset(&record, 0, sizeof(record));
+    record.elapsedTime = (_isPaused ? pauseStartTime : now) - startTime - totalPauseTime;
+    record.nutrientCycleTime = now - lastNutrientActivationTime;
+    record.plannedNutrientActivationTime = plannedNutrientActivationTime;
+    record.tempOutput = pidManager.getTemperatureOutput();
+    record.phOutput = pidManager.getPHOutput();
+    record.doOutput = pidManager.getDOOutput();
+    record.stirringSpeed = ActuatorController::getCurrentValue(ActuatorId::StirringMotor);
+    record.nutrientAdditionStarted = nutrientAdditionStarted;
+    record.nutrientPumpRunning = ActuatorController::isActuatorRunning(ActuatorId::NutrientPump);
+    record.paused = _isPaused;
+    record.pidEnabled = isPIDEnabled;
+    ParameterStore::queue(record);
+    // The cumulative volumes go with the nutrient schedule
+    volumeManager.saveState();
+    lastCheckpointTime = now;
+}
+
+bool FermentationProgram::resumeFromCheckpoint(const String& command) {
+    FermentationCheckpointRecord record;
+    if (!ParameterStore::load(record)) {
+        Logger::log(LogLevel::WARNING, F("No fermentation checkpoint, the program cannot resume"));
+        return false;
+    }
+    parseCommand(command);
+
+    // The time spent without power is not counted as fermentation time
+    unsigned long now = SystemClock::now();
+    _isRunning = true;
+    _isPaused = false;
+    startTime = now - record.elapsedTime;
+    totalPauseTime = 0;
+    nutrientAdditionStarted = record.nutrientAdditionStarted;
+    plannedNutrientActivationTime = record.plannedNutrientActivationTime;
+    lastNutrientActivationTime = now - record.nutrientCycleTime;
+    isPIDEnabled = record.pidEnabled;
+
+    initializeStirringSpeed();
+    if (record.stirringSpeed > currentStirringSpeed) {
+        ActuatorController::runActuator(ActuatorId::StirringMotor, record.stirringSpeed, 0);
+    }
+
+    if (isPIDEnabled) {
+        pidManager.startTemperaturePID(tempSetpoint);
+        pidManager.startPHPID(phSetpoint);
+        pidManager.startDOPID(doSetpoint);
+        pidManager.restoreOutputs(record.tempOutput, record.phOutput, record.doOutput);
+    }
+
+    // An interrupted nutrient addition is completed, its volume is recorded when the pump stops
+    if (record.nutrientPumpRunning) {
+        ActuatorController::runActuator(ActuatorId::NutrientPump, nutrientFixedFlowRate, 0);
+    }
+
+    if (record.paused) {
+        pause();
+    }
+
+    Logger::log(LogLevel::INFO, "Fermentation resumed from checkpoint - Elapsed: " + String(record.elapsedTime / 60000) +
+                " min, nutrient addition " + (nutrientAdditionStarted ? "started" : "not started") +
+                (record.nutrientPumpRunning ? ", nutrient pump restarted" : ""));
+    return true;
+}
+
 void FermentationProgram::setPIDEnabled(bool enabled) {
     isPIDEnabled = enabled;
     if (enabled) {
@@ -418,12 +500,12 @@ void FermentationProgram::getParameters(JsonDocument& doc) const {
 }
 
 bool FermentationProgram::isAnyActuatorRunning() const {
-    return ActuatorController::isActuatorRunning("airPump") ||
-           ActuatorController::isActuatorRunning("drainPump") ||
-           ActuatorController::isActuatorRunning("samplePump") ||
-           ActuatorController::isActuatorRunning("nutrientPump") ||
-           ActuatorController::isActuatorRunning("basePump") ||
-           ActuatorController::isActuatorRunning("stirringMotor") ||
-           ActuatorController::isActuatorRunning("heatingPlate") ||
-           ActuatorController::isActuatorRunning("ledGrowLight");
+    return ActuatorController::isActuatorRunning(ActuatorId::AirPump) ||
+           ActuatorController::isActuatorRunning(ActuatorId::DrainPump) ||
+           ActuatorController::isActuatorRunning(ActuatorId::SamplePump) ||
+           ActuatorController::isActuatorRunning(ActuatorId::NutrientPump) ||
+           ActuatorController::isActuatorRunning(ActuatorId::BasePump) ||
+           ActuatorController::isActuatorRunning(ActuatorId::StirringMotor) ||
+           ActuatorController::isActuatorRunning(ActuatorId::HeatingPlate) ||
+           ActuatorController::isActuatorRunning(ActuatorId::LedGrowLight);
 }
@@ -24,6 +24,7 @@ public:
     bool isPaused() const override { return _isPaused; }
     String getName() const override { return "Fermentation"; }
     void parseCommand(const String& command) override;
+    bool resumeFromCheckpoint(const String& command) override;
     void initializeStirringSpeed();
     void setNutrientFixedFlowRate(float rate) { nutrientFixedFlowRate = rate; }
     
@@ -31,6 +32,8 @@ public:
     static const unsigned long NUTRIENT_ACTIVATION_TIME = 10000; //60000;  // 1 minute   10000
     static const unsigned long NUTRIENT_PAUSE_TIME = 508400; // 8.64 minutes - 10 secondes = 508.4 secondes
     static constexpr float DEFAULT_NUTRIENT_FLOW_RATE = 3.0; // ml/min
+    // Interval of the checkpoints in the ParameterStore, also taken at each pause, resume and nutrient pump start or stop
+    static const unsigned long CHECKPOINT_INTERVAL = 60000;
 
     void setPIDEnabled(bool enabled);
     //void setPIDEnabled(bool enabled) { isPIDEnabled = enabled; }
@@ -75,6 +78,8 @@ private:
 
     void updateVolume();
     void checkCompletion();
+    void checkpoint();
+    unsigned long lastCheckpointTime = 0;
 
     void addNutrientsContinuously();
     void addNutrientsContinuouslyFixedRate(float fixedFlowRate);
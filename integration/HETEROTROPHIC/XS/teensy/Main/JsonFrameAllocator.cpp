@@ -0,0 +1,60 @@
+// JsonFrameAllocator.cpp
+// The same file is used by the water heater and water bath ESP32s (MQTTMessagePool): keep the copies in sync.
+#include "JsonFrameAllocator.h"
+
+JsonFrameAllocator::JsonFrameAllocator(uint8_t* buffer, size_t capacity)
+    : _buffer(buffer), _capacity(capacity), _used(0), _lastBlock(nullptr) {}
+
+void* JsonFrameAllocator::allocate(size_t size) {
+    size_t blockSize = sizeof(BlockHeader) + align(size);
+    if (_used + blockSize > _capacity) {
+        return nullptr; // ArduinoJson reports it through doc.overflowed()
+    }
+    uint8_t* block = _buffer + _used;
+    reinterpret_cast<BlockHeader*>(block)->size = size;
+    _used += blockSize;
+    _lastBlock = block;
+    return block + sizeof(BlockHeader);
+}
+
+void JsonFrameAllocator::deallocate(void* ptr) {
+    // Released all at once by reset()
+    (void)ptr;
+}
+
+void* JsonFrameAllocator::reallocate(void* ptr, size_t newSize) {
+    if (ptr == nullptr) {
+        return allocate(newSize);
+    }
+
+    uint8_t* block = static_cast<uint8_t*>(ptr) - sizeof(BlockHeader);
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+
+    // The last block can be resized in place
+    if (block == _lastBlock) {
+        size_t blockStart = block - _buffer;
+        size_t blockSize = sizeof(BlockHeader) + align(newSize);
+        if (blockStart + blockSize > _capacity) {
+            return nullptr;
+        }
+        _used = blockStart + blockSize;
+        header->size = newSize;
+        return ptr;
+    }
+
+    if (newSize <= header->size) {
+        header->size = newSize; // Shrinking: keep the block, the tail is lost until reset()
+        return ptr;
+    }
+
+    void* newPtr = allocate(newSize);
+    if (newPtr != nullptr) {
+        memcpy(newPtr, ptr, header->size);
+    }
+    return newPtr;
+}
+
+void JsonFrameAllocator::reset() {
+    _used = 0;
+    _lastBlock = nullptr;
+}
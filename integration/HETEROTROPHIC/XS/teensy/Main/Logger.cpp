@@ -8,16 +8,22 @@ void Logger::initialize(DataCollector& dataCollector) {
     _dataCollector = &dataCollector;
 }
 
+bool Logger::beginLine(LogLevel level) {
+    if (level < _currentLevel) {
+        return false;
+    }
+    switch (level) {
+        case LogLevel::DEBUG: Serial.print(F("DEBUG: ")); break;
+        case LogLevel::INFO: Serial.print(F("INFO: ")); break;
+        case LogLevel::WARNING: Serial.print(F("WARNING: ")); break;
+        case LogLevel::ERROR: Serial.print(F("ERROR: ")); break;
+    }
+    return true;
+}
+
 void Logger::log(LogLevel level, const String& message) {
-    if (level >= _currentLevel) {
-        String prefix;
-        switch (level) {
-            case LogLevel::DEBUG: prefix = "DEBUG: "; break;
-            case LogLevel::INFO: prefix = "INFO: "; break;
-            case LogLevel::WARNING: prefix = "WARNING: "; break;
-            case LogLevel::ERROR: prefix = "ERROR: "; break;
-        }
-        Serial.println(prefix + message);
+    if (beginLine(level)) {
+        Serial.println(message);
     }
 }
 
@@ -67,8 +73,12 @@ void Logger::logVolumeData() {
 
 void Logger::logAllData(const String& currentProgram, int currentState) {
     if (_dataCollector) {
-        String allData = _dataCollector->collectAllData(currentProgram, currentState);
-        log(LogLevel::INFO, "Periodic Event :" + allData);
+        // Streamed to the console, same output as log(LogLevel::INFO, "Periodic Event :" + collectAllData())
+        if (beginLine(LogLevel::INFO)) {
+            Serial.print(F("Periodic Event :"));
+            _dataCollector->writeAllData(Serial, currentProgram, currentState);
+            Serial.println();
+        }
     } else {
         log(LogLevel::ERROR, "DataCollector not initialized");
     }
@@ -29,6 +29,9 @@ public:
 private:
     static DataCollector* _dataCollector;
     static LogLevel _currentLevel;
+
+    // Print the level prefix of a new line, false (nothing printed) when the level is filtered out
+    static bool beginLine(LogLevel level);
 };
 
 #endif // LOGGER_H
\ No newline at end of file
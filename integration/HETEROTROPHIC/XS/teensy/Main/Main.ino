@@ -32,11 +32,18 @@
 #include "Communication.h"
 #include "DataCollector.h"
 #include "QuadChannelDACController.h"
+#include "SerialLineReader.h"
+#include "TaskScheduler.h"
+#include "PlantSimulator.h"
+#include "ReplayHarness.h"
+#include "ParameterStore.h"
+#include "SdLogger.h"
 
 #include "TestsProgram.h"
 #include "DrainProgram.h"
 #include "MixProgram.h"
 #include "FermentationProgram.h"
+#include "AutotuneProgram.h"
 
 // WARNING, pins 2 and 3 do not work well in this system. Avoid allocating them without double-checking.
 
@@ -53,8 +60,9 @@
 PT100Sensor waterTempSensor(10, 11, 12, 13, "waterTempSensor");  // Water temperature sensor (CS: 10, DI: 11, DO: 12, CLK: 13)
 DS18B20TemperatureSensor airTempSensor(39, "airTempSensor");     // Air temperature sensor (Data: 52)
 DS18B20TemperatureSensor electronicTempSensor(36, "electronicTempSensor");     // Electronic temperature sensor (Data: 29)
-PHSensor phSensor(&SerialSensoTransmitter, &waterTempSensor, "phSensor");             // pH sensor (Analog: A1, uses water temp for compensation)
-OxygenSensor oxygenSensor(&SerialSensoTransmitter, &waterTempSensor, "oxygenSensor"); // Dissolved oxygen sensor (Analog: A3, uses water temp)
+SensorTransmitterLink sensorTransmitter(&SerialSensoTransmitter);                   // Tagged requests to the Arduino Uno, one READ_ALL for pH and O2
+PHSensor phSensor(&sensorTransmitter, &waterTempSensor, "phSensor");                 // pH sensor (Analog: A1, uses water temp for compensation)
+OxygenSensor oxygenSensor(&sensorTransmitter, &waterTempSensor, "oxygenSensor");     // Dissolved oxygen sensor (Analog: A3, uses water temp)
 AirFlowSensor airFlowSensor(23, "airFlowSensor");                // Air flow sensor (Digital: 37)
 TurbiditySensorSEN0554 turbiditySensorSEN0554(&SerialTurbidity, "turbiditySensorSEN0554"); // SEN0554 turbidity sensor (RX: Blue, TX: green)
 //TurbiditySensor turbiditySensor(A2, "turbiditySensor");          // Turbidity sensor (Analog: A2) 
@@ -83,10 +91,13 @@ TestsProgram testsProgram(pidManager);
 DrainProgram drainProgram;
 MixProgram mixProgram;
 FermentationProgram fermentationProgram(pidManager, volumeManager);
+AutotuneProgram autotuneProgram(pidManager);
 
 CommandHandler commandHandler(stateMachine, safetySystem, volumeManager, pidManager);
+ReplayHarness replayHarness(pidManager, safetySystem, stateMachine); // Recorded sensor data fed through PID and safety
+
+SerialLineReader<128> consoleReader(Serial); // Commands typed in the Serial Monitor
 
-unsigned long previousMillis = 0;
 const long measurement_interval = 15000; // Interval for logging (15 seconds)
 int measurementCounter = 0;  // Counter to track the number of measurements
 const int SAMPLE_FREQUENCY = 60;  // Take a turbiduty sample every 30 measurements/logging
@@ -130,6 +141,7 @@ void setup() {
     stateMachine.addProgram("Drain", &drainProgram);
     stateMachine.addProgram("Mix", &mixProgram);
     stateMachine.addProgram("Fermentation", &fermentationProgram);
+    stateMachine.addProgram("Autotune", &autotuneProgram);
 
     // Initialisation of the PIDManager to define hysteresis values
         /*
@@ -148,6 +160,17 @@ void setup() {
     volumeManager.setInitialVolume(0.500);           // set an initial volume of 0.2 L     // 750
     //Logger::log(LogLevel::INFO, "Setup an initial volume");
 
+    // Restore what was saved before the last reset over the defaults above,
+    // and resume the program that was running from its checkpoint
+    ParameterStore::begin();
+    SdLogger::begin(dataCollector);
+    pidManager.loadParameters();
+    volumeManager.loadState();
+    stateMachine.restoreProgramState();
+
+    // Register the main loop tasks
+    registerTasks();
+
     //Logger::log(LogLevel::INFO, "Setup completed");
     Logger::log(LogLevel::INFO, F("Setup completed"));
     Serial.println();
@@ -159,60 +182,104 @@ void setup() {
   
 }
 
-void loop() {
+// Scheduled tasks, see registerTasks() for their period and priority
+
+void acquisitionTask() {
+    // Advance the plant model when the sensors are simulated
+    PlantSimulator::update();
+    // Start and poll sensor measurements; every consumer below reads the cached values
+    // During a replay the sensor values only change with the replay steps
+    if (!replayHarness.isRunning()) {
+        SensorController::update();
+    }
+    // Freeze the values used by PID, safety and telemetry for this cycle
+    SensorController::takeSnapshot();
+    // Stop the timed actuator runs that are over
+    ActuatorController::update();
+}
+
+void safetyTask() {
+    // Check safety limits
+    safetySystem.checkLimits();
+}
+
+void pidTask() {
+    // Update PID manager
+    pidManager.updateAllPIDControllers();
+}
+
+void programTask() {
+    // Update state machine
+    stateMachine.update();
+}
+
+void commandTask() {
     // Check for incoming commands from ESP32
-    if (espCommunication.available()) {
-        String receivedData = espCommunication.readMessage();
-        if (receivedData.length() > 0) {
-            Logger::log(LogLevel::INFO, "Received from ESP32: " + receivedData);
-            espCommunication.processCommand(receivedData);
-        }
+    String receivedData;
+    if (espCommunication.tryReadMessage(receivedData)) {
+        Logger::log(LogLevel::INFO, "Received from ESP32: " + receivedData);
+        espCommunication.processCommand(receivedData);
     }
 
     // Check for incoming commands from Arduino Serial Monitor
-    if (Serial.available() > 0) {
-        String command = Serial.readStringUntil('\n');
+    String command;
+    if (consoleReader.tryReadLine(command)) {
         command.trim();
         Logger::log(LogLevel::INFO, "Received from Serial Monitor: " + command);
         commandHandler.executeCommand(command);
     }
+}
 
-    // Update state machine
-    stateMachine.update();
+void telemetryTask() {
+    measurementCounter++;  // Incrémente le compteur
 
-    // Update PID manager
-    pidManager.updateAllPIDControllers();
+    // Only take sample if Fermentation program is running
+    if (measurementCounter >= SAMPLE_FREQUENCY && 
+        stateMachine.getCurrentProgram() == "Fermentation") {
+        // Take a fresh sample
+        SensorController::takeSample();
+        measurementCounter = 0;  // Réinitialise le compteur
+        Logger::log(LogLevel::INFO, F("Fresh sample started for Fermentation program"));
+    }
+    
+    // log all data
+    Logger::logAllData(stateMachine.getCurrentProgram(), static_cast<int>(stateMachine.getCurrentState()));
 
+    // send all data to server
+    espCommunication.sendAllData(stateMachine.getCurrentProgram(), static_cast<int>(stateMachine.getCurrentState()));
+}
 
-    // Check safety limits
-    safetySystem.checkLimits();
+void persistenceTask() {
+    // Only the records that changed since the last save are written, by storageTask()
+    pidManager.saveParameters();
+    volumeManager.saveState();
+}
 
-    // Log data every interval
-    unsigned long currentMillis = millis();
-    if (currentMillis - previousMillis >= measurement_interval) {
-        previousMillis = currentMillis;
-
-        measurementCounter++;  // Incrémente le compteur
-
-        // Only take sample if Fermentation program is running
-        if (measurementCounter >= SAMPLE_FREQUENCY && 
-            stateMachine.getCurrentProgram() == "Fermentation") {
-            // Take a fresh sample
-            SensorController::takeSample();
-            measurementCounter = 0;  // Réinitialise le compteur
-            Logger::log(LogLevel::INFO, F("Fresh sample taken for Fermentation program"));
-        }
-        
-        // log all data
-        Logger::logAllData(stateMachine.getCurrentProgram(), static_cast<int>(stateMachine.getCurrentState()));
-
-        // send all data to server
-        espCommunication.sendAllData(stateMachine.getCurrentProgram(), static_cast<int>(stateMachine.getCurrentState()));
-        
-    }
+void storageTask() {
+    // A few EEPROM bytes per pass: checkpoints and journal compactions never hold the control loop
+    ParameterStore::service(16);
+}
 
-    // Short pause to avoid excessive CPU usage
-    delay(10);
+void sdLogTask() {
+    // Buffered in RAM, written to the card by SdLogger::service() when the loop is idle
+    SdLogger::recordSample(stateMachine.getCurrentProgram(), static_cast<int>(stateMachine.getCurrentState()));
 }
 
+void registerTasks() {
+    // Acquisition comes first so that the other tasks of the pass share its snapshot, then safety
+    // The PID and safety tasks keep their own, longer, update intervals: these periods only bound their reaction time
+    TaskScheduler::addTask("acquisition", acquisitionTask, 10, 0);
+    TaskScheduler::addTask("safety", safetyTask, 100, 1);
+    TaskScheduler::addTask("pid", pidTask, 100, 2);
+    TaskScheduler::addTask("program", programTask, 10, 3);
+    TaskScheduler::addTask("commands", commandTask, 10, 4);
+    TaskScheduler::addTask("telemetry", telemetryTask, measurement_interval, 5);
+    TaskScheduler::addTask("persistence", persistenceTask, 60000, 6);
+    TaskScheduler::addTask("storage", storageTask, 10, 7);
+    TaskScheduler::addTask("sdlog", sdLogTask, 1000, 8);
+    TaskScheduler::setIdleTask(SdLogger::service);
+}
 
+void loop() {
+    TaskScheduler::run();
+}
\ No newline at end of file
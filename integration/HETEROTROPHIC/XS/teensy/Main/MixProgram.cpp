@@ -13,7 +13,7 @@ void MixProgram::start(const String& command) {
         _isRunning = true;
         _isPaused = false;
         
-        ActuatorController::runActuator("stirringMotor", speed, 0); // 0 for continuous operation
+        ActuatorController::runActuator(ActuatorId::StirringMotor, speed, 0); // 0 for continuous operation
         //ActuatorController::runActuator("airPump", 80, 0); 
         Logger::log(LogLevel::INFO, "Mixing started at speed: " + String(speed));
     } else {
@@ -29,7 +29,7 @@ void MixProgram::update() {
 
 void MixProgram::pause() {
     if (_isRunning && !_isPaused) {
-        ActuatorController::stopActuator("stirringMotor");
+        ActuatorController::stopActuator(ActuatorId::StirringMotor);
         _isPaused = true;
         //Logger::log(LogLevel::INFO, "Mixing paused");
         Logger::log(LogLevel::INFO, F("Mixing paused"));
@@ -38,7 +38,7 @@ void MixProgram::pause() {
 
 void MixProgram::resume() {
     if (_isRunning && _isPaused) {
-        ActuatorController::runActuator("stirringMotor", speed, 0);
+        ActuatorController::runActuator(ActuatorId::StirringMotor, speed, 0);
         _isPaused = false;
         //Logger::log(LogLevel::INFO, "Mixing resumed");
         Logger::log(LogLevel::INFO, F("Mixing resumed"));
@@ -47,7 +47,7 @@ void MixProgram::resume() {
 
 void MixProgram::stop() {
     if (_isRunning) {
-        ActuatorController::stopActuator("stirringMotor");
+        ActuatorController::stopActuator(ActuatorId::StirringMotor);
         //ActuatorController::stopActuator("airPump");
         _isRunning = false;
         _isPaused = false;
@@ -1,23 +1,48 @@
 #include "OxygenSensor.h"
 #include "Logger.h"
 
-OxygenSensor::OxygenSensor(HardwareSerial* serial, SensorInterface* tempSensor, const char* name)
-    : _serial(serial), _tempSensor(tempSensor), _name(name) {}
+OxygenSensor::OxygenSensor(SensorTransmitterLink* link, SensorInterface* tempSensor, const char* name)
+    : _link(link), _tempSensor(tempSensor), _name(name) {}
 
 void OxygenSensor::begin() {
     Logger::log(LogLevel::INFO, String(_name) + " initialized");
 }
 
 float OxygenSensor::readValue() {
-    float temperature = _tempSensor->readValue();
-    String response = sendCommand("O2:READ:" + String(temperature, 2));
-    if (response.startsWith("O2:")) {
-        float o2 = response.substring(3).toFloat();
-        //Logger::log(LogLevel::INFO, String(_name) + " reading: " + String(o2));
-        return o2;
+    // pH and O2 come from the same READ_ALL transaction, shared with the other sensor if recent
+    if (!_link->readAll(compensationTemperature())) {
+        return -1;
+    }
+    return _link->getOxygen();
+}
+
+void OxygenSensor::setCompensationTemperature(float temperature) {
+    _compensationTemp = temperature;
+    _hasCompensationTemp = true;
+}
+
+float OxygenSensor::compensationTemperature() {
+    return _hasCompensationTemp ? _compensationTemp : _tempSensor->readValue();
+}
+
+bool OxygenSensor::startReading() {
+    // Joins the READ_ALL already sent for the other sensor, if any
+    _readingId = _link->requestReading(compensationTemperature());
+    return true;
+}
+
+bool OxygenSensor::pollReading(float& value) {
+    _link->poll();
+    switch (_link->getReadingStatus(_readingId)) {
+        case SensorTransmitterLink::ReadingStatus::PENDING:
+            return false;
+        case SensorTransmitterLink::ReadingStatus::READY:
+            value = _link->getOxygen();
+            return true;
+        default:
+            value = -1;
+            return true;
     }
-    Logger::log(LogLevel::ERROR, "Invalid O2 response: " + response);
-    return -1;
 }
 
 void OxygenSensor::startCalibration() {
@@ -62,18 +87,9 @@ void OxygenSensor::resetCalibration() {
 }
 
 String OxygenSensor::sendCommand(const String& cmd) {
-    //Logger::log(LogLevel::INFO, "Sending command to Arduino: " + cmd);
-    _serial->println(cmd);
-    
-    unsigned long startTime = millis();
-    while (!_serial->available()) {
-        if (millis() - startTime > 5000) {
-            Logger::log(LogLevel::ERROR, "Timeout waiting for O2 sensor response");
-            return "ERROR:TIMEOUT";
-        }
+    String response = _link->sendCommand(cmd);
+    if (response == "ERROR:TIMEOUT") {
+        Logger::log(LogLevel::ERROR, "Timeout waiting for O2 sensor response");
     }
-    String response = _serial->readStringUntil('\n');
-    response.trim();
-    //Logger::log(LogLevel::INFO, "Received response from Arduino: " + response);
     return response;
 }
\ No newline at end of file
@@ -2,14 +2,20 @@
 #define OXYGENSENSOR_H
 
 #include "SensorInterface.h"
+#include "SensorTransmitterLink.h"
 #include <Arduino.h>
 
 class OxygenSensor : public SensorInterface {
 public:
-    OxygenSensor(HardwareSerial* serial, SensorInterface* tempSensor, const char* name);
+    OxygenSensor(SensorTransmitterLink* link, SensorInterface* tempSensor, const char* name);
     void begin() override;
     float readValue() override;
+    bool startReading() override;
+    bool pollReading(float& value) override;
     const char* getName() const override { return _name; }
+
+    // Temperature used for compensation by startReading() and readValue(), avoids re-reading the temperature sensor
+    void setCompensationTemperature(float temperature);
     
     void startCalibration();
     void calibrateZero();
@@ -19,10 +25,16 @@ public:
     void getCalibrationStatus();
 
 private:
-    HardwareSerial* _serial;
+    SensorTransmitterLink* _link;
     SensorInterface* _tempSensor;
     const char* _name;
     String sendCommand(const String& cmd);
+
+    uint16_t _readingId = 0;
+    float _compensationTemp = 0;
+    bool _hasCompensationTemp = false;
+
+    float compensationTemperature();
 };
 
 #endif
\ No newline at end of file
@@ -1,22 +1,48 @@
 #include "PHSensor.h"
 #include "Logger.h"
 
-PHSensor::PHSensor(HardwareSerial* serial, SensorInterface* tempSensor, const char* name)
-    : _serial(serial), _tempSensor(tempSensor), _name(name) {}
+PHSensor::PHSensor(SensorTransmitterLink* link, SensorInterface* tempSensor, const char* name)
+    : _link(link), _tempSensor(tempSensor), _name(name) {}
 
 void PHSensor::begin() {
     Logger::log(LogLevel::INFO, String(_name) + " initialized");
 }
 
 float PHSensor::readValue() {
-    float temperature = _tempSensor->readValue();
-    String response = sendCommand("PH:READ:" + String(temperature, 2));
-    if (response.startsWith("PH:")) {
-        float pH = response.substring(3).toFloat();
-        return pH;
+    // pH and O2 come from the same READ_ALL transaction, shared with the other sensor if recent
+    if (!_link->readAll(compensationTemperature())) {
+        return -1;
+    }
+    return _link->getPH();
+}
+
+void PHSensor::setCompensationTemperature(float temperature) {
+    _compensationTemp = temperature;
+    _hasCompensationTemp = true;
+}
+
+float PHSensor::compensationTemperature() {
+    return _hasCompensationTemp ? _compensationTemp : _tempSensor->readValue();
+}
+
+bool PHSensor::startReading() {
+    // Joins the READ_ALL already sent for the other sensor, if any
+    _readingId = _link->requestReading(compensationTemperature());
+    return true;
+}
+
+bool PHSensor::pollReading(float& value) {
+    _link->poll();
+    switch (_link->getReadingStatus(_readingId)) {
+        case SensorTransmitterLink::ReadingStatus::PENDING:
+            return false;
+        case SensorTransmitterLink::ReadingStatus::READY:
+            value = _link->getPH();
+            return true;
+        default:
+            value = -1;
+            return true;
     }
-    Logger::log(LogLevel::ERROR, "Invalid pH response: " + response);
-    return -1;
 }
 
 void PHSensor::enterCalibration() {
@@ -43,13 +69,9 @@ void PHSensor::exitCalibration() {
 }
 
 String PHSensor::sendCommand(const String& cmd) {
-    _serial->println(cmd);
-    unsigned long startTime = millis();
-    while (!_serial->available()) {
-        if (millis() - startTime > 5000) {
-            Logger::log(LogLevel::ERROR, "Timeout waiting for pH sensor response");
-            return "ERROR:TIMEOUT";
-        }
+    String response = _link->sendCommand(cmd);
+    if (response == "ERROR:TIMEOUT") {
+        Logger::log(LogLevel::ERROR, "Timeout waiting for pH sensor response");
     }
-    return _serial->readStringUntil('\n');
+    return response;
 }
\ No newline at end of file
@@ -2,23 +2,35 @@
 #define PHSENSOR_H
 
 #include "SensorInterface.h"
+#include "SensorTransmitterLink.h"
 #include <Arduino.h>
 
 class PHSensor : public SensorInterface {
 public:
-    PHSensor(HardwareSerial* serial, SensorInterface* tempSensor, const char* name);
+    PHSensor(SensorTransmitterLink* link, SensorInterface* tempSensor, const char* name);
     void begin() override;
     float readValue() override;
+    bool startReading() override;
+    bool pollReading(float& value) override;
     const char* getName() const override { return _name; }
+
+    // Temperature used for compensation by startReading() and readValue(), avoids re-reading the temperature sensor
+    void setCompensationTemperature(float temperature);
     void enterCalibration();
     void calibrate();
     void exitCalibration();
 
 private:
-    HardwareSerial* _serial;
+    SensorTransmitterLink* _link;
     SensorInterface* _tempSensor;
     const char* _name;
     String sendCommand(const String& cmd);
+
+    uint16_t _readingId = 0;
+    float _compensationTemp = 0;
+    bool _hasCompensationTemp = false;
+
+    float compensationTemperature();
 };
 
 #endif
\ No newline at end of file
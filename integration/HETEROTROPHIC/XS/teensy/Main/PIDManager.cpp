@@ -1,6 +1,9 @@
 // PIDManager.cpp
 #include "PIDManager.h"
+#include "SystemClock.h"
 #include "Logger.h"
+#include "Profiler.h"
+#include "ParameterStore.h"
 #include <Arduino.h>
 #include "ActuatorController.h"
 
@@ -8,11 +11,15 @@ PIDManager::PIDManager()
     : tempPID(&tempInput, &tempOutput, &tempSetpoint, 0, 0, 0, DIRECT),
       phPID(&phInput, &phOutput, &phSetpoint, 0, 0, 0, DIRECT),
       doPID(&doInput, &doOutput, &doSetpoint, 0, 0, 0, DIRECT),
+      tempInput(0), tempOutput(0), tempSetpoint(0),
+      phInput(0), phOutput(0), phSetpoint(0),
+      doInput(0), doOutput(0), doSetpoint(0),
       tempPIDRunning(false), phPIDRunning(false), doPIDRunning(false),
       lastTempUpdateTime(0), lastPHUpdateTime(0), lastDOUpdateTime(0),
       tempHysteresis(0.5), phHysteresis(0.05), doHysteresis(1.0),
       minStirringSpeed(0),
-      isStartupPhase(true)
+      isStartupPhase(true),
+      tunings()
 {
     tempPID.SetOutputLimits(0, 100);
     phPID.SetOutputLimits(0, 100);
@@ -25,9 +32,16 @@ PIDManager::PIDManager()
 void PIDManager::initialize(double tempKp, double tempKi, double tempKd,
                             double phKp, double phKi, double phKd,
                             double doKp, double doKi, double doKd) {
-    tempPID.SetTunings(tempKp * 1.5, tempKi * 0.5, tempKd * 2);  // Start-up parameters for temperature
-    phPID.SetTunings(phKp * 1.5, phKi * 0.5, phKd * 2);  // Start-up parameters for pH
-    doPID.SetTunings(doKp * 1.5, doKi * 0.5, doKd * 2);  // Start-up parameters for  DO
+    // Loops with identified gains keep them
+    if (!tunings[static_cast<int>(PIDLoop::Temperature)].tuned) {
+        tempPID.SetTunings(tempKp * 1.5, tempKi * 0.5, tempKd * 2);  // Start-up parameters for temperature
+    }
+    if (!tunings[static_cast<int>(PIDLoop::PH)].tuned) {
+        phPID.SetTunings(phKp * 1.5, phKi * 0.5, phKd * 2);  // Start-up parameters for pH
+    }
+    if (!tunings[static_cast<int>(PIDLoop::DO)].tuned) {
+        doPID.SetTunings(doKp * 1.5, doKi * 0.5, doKd * 2);  // Start-up parameters for  DO
+    }
 }
 
 void PIDManager::setHysteresis(double tempHyst, double phHyst, double doHyst) {
@@ -37,7 +51,8 @@ void PIDManager::setHysteresis(double tempHyst, double phHyst, double doHyst) {
 }
 
 void PIDManager::updateAllPIDControllers() {
-    unsigned long currentTime = millis();
+    PROFILE_ZONE("pid.updateAll");
+    unsigned long currentTime = SystemClock::now();
     bool anyPIDUpdated  = false;
     if (tempPIDRunning && currentTime - lastTempUpdateTime >= UPDATE_INTERVAL_TEMP) {
         updateTemperaturePID();
@@ -91,6 +106,7 @@ void PIDManager::startDOPID(double setpoint) {
 
 void PIDManager::switchToMaintainMode() {
     isStartupPhase = false;
+    if (tunings[static_cast<int>(PIDLoop::Temperature)].tuned) return;
     double tempKp = tempPID.GetKp();
     double tempKi = tempPID.GetKi();
     double tempKd = tempPID.GetKd();
@@ -154,7 +170,7 @@ void PIDManager::adjustPIDStirringSpeed() {
     if (!tempPIDRunning && !phPIDRunning && !doPIDRunning) {
         // If no PID is active, use minimum speed
         int minSpeed = getMinStirringSpeed();
-        ActuatorController::runActuator("stirringMotor", minSpeed, 0);
+        ActuatorController::runActuator(ActuatorId::StirringMotor, minSpeed, 0);
         return;
     }
 
@@ -168,11 +184,11 @@ void PIDManager::adjustPIDStirringSpeed() {
     double phOutputValid = validPH ? abs(phOutput) : 0;
     double doOutputValid = (validDO && doSetpoint > 0) ? abs(doOutput) : 0;
 
-    double maxOutput = max(max(abs(tempOutput), abs(phOutput)), abs(doOutput));
+    double maxOutput = max(max(tempOutputValid, phOutputValid), doOutputValid);
     int pidSpeed = map(maxOutput, 0, 100, ActuatorController::getStirringMotorMinRPM(), ActuatorController::getStirringMotorMaxRPM());
     int finalSpeed = max(pidSpeed, getMinStirringSpeed());
     finalSpeed = constrain(finalSpeed, ActuatorController::getStirringMotorMinRPM(), ActuatorController::getStirringMotorMaxRPM());
-    ActuatorController::runActuator("stirringMotor", finalSpeed, 0);
+    ActuatorController::runActuator(ActuatorId::StirringMotor, finalSpeed, 0);
     
     //Logger::log(LogLevel::INFO, "Adjusted stirring motor speed: " + String(finalSpeed));
 }
@@ -278,14 +294,27 @@ void PIDManager::updateTemperaturePID() {
 void PIDManager::updateTemperaturePID() {
     if (!tempPIDRunning) return;
     
-    tempInput = SensorController::readSensor("waterTempSensor");
+    tempInput = SensorController::getSnapshot().waterTemp;
 
     // Safety check for invalid readings
     if (tempInput <= -100 || tempInput >= 100) {
-        ActuatorController::stopActuator("heatingPlate");
+        ActuatorController::stopActuator(ActuatorId::HeatingPlate);
         Logger::log(LogLevel::ERROR, "Invalid temperature reading, heating stopped for safety");
         return;
     }
+
+    // Identified gains: the PID output drives the heating plate directly
+    if (tunings[static_cast<int>(PIDLoop::Temperature)].tuned) {
+        tempPID.Compute();
+        if (tempOutput > 0) {
+            ActuatorController::runActuator(ActuatorId::HeatingPlate, tempOutput, 0);
+        } else {
+            ActuatorController::stopActuator(ActuatorId::HeatingPlate);
+        }
+        Logger::log(LogLevel::INFO, "Temperature PID update - Setpoint: " + String(tempSetpoint) +
+                    ", Input: " + String(tempInput) + ", Output: " + String(tempOutput) + "%, Tuned");
+        return;
+    }
     
     // Check if temperature is outside hysteresis range
     if (abs(tempInput - tempSetpoint) > tempHysteresis) {
@@ -295,15 +324,15 @@ void PIDManager::updateTemperaturePID() {
         if (tempInput < tempSetpoint) {
             // During startup phase, use aggressive heating if temp is significantly low
             if (isStartupPhase && tempInput < tempSetpoint - 2.0) {
-                ActuatorController::runActuator("heatingPlate", 100, 0);
+                ActuatorController::runActuator(ActuatorId::HeatingPlate, 100, 0);
                 Logger::log(LogLevel::INFO, "Aggressive heating: 100%");
             } else {
                 // Normal PID-controlled heating
-                ActuatorController::runActuator("heatingPlate", tempOutput, 0);
+                ActuatorController::runActuator(ActuatorId::HeatingPlate, tempOutput, 0);
             }
         } else {
             // Stop heating if temperature is above setpoint
-            ActuatorController::stopActuator("heatingPlate");
+            ActuatorController::stopActuator(ActuatorId::HeatingPlate);
             Logger::log(LogLevel::INFO, "Temperature above setpoint, heating stopped");
         }
 
@@ -318,7 +347,7 @@ void PIDManager::updateTemperaturePID() {
                     String(isStartupPhase ? "Yes" : "No"));
     } else {
         // Stop heating when within hysteresis range
-        ActuatorController::stopActuator("heatingPlate");
+        ActuatorController::stopActuator(ActuatorId::HeatingPlate);
         Logger::log(LogLevel::INFO, "Temperature within hysteresis range (" + 
                     String(tempHysteresis) + "°C). Heating paused.");
     }
@@ -330,9 +359,9 @@ void PIDManager::updatePHPID() {
     static unsigned long lastAdjustmentTime = 0;
     const unsigned long adjustmentDelay = 60000; // 1 minutes delay between adjustments
     
-    phInput = SensorController::readSensor("phSensor");
+    phInput = SensorController::getSnapshot().pH;
     
-    if (abs(phInput - phSetpoint) > phHysteresis && millis() - lastAdjustmentTime > adjustmentDelay) {
+    if (abs(phInput - phSetpoint) > phHysteresis && SystemClock::now() - lastAdjustmentTime > adjustmentDelay) {
         phPID.Compute();
         
         // Activate heating only if temperature is below setpoint
@@ -345,19 +374,19 @@ void PIDManager::updatePHPID() {
             
             // Activate pump for a short duration
             const unsigned long pumpDuration = 1000; // 1 second
-            ActuatorController::runActuator("basePump", flowRate, pumpDuration);
+            ActuatorController::runActuator(ActuatorId::BasePump, flowRate, pumpDuration);
             
-            lastAdjustmentTime = millis();
+            lastAdjustmentTime = SystemClock::now();
             
             Logger::log(LogLevel::INFO, "pH PID update - Setpoint: " + String(phSetpoint) + 
                         ", Input: " + String(phInput) + ", Output: " + String(flowRate) + 
                         ", Duration: " + String(pumpDuration));
         } else {
-            ActuatorController::stopActuator("basePump");
+            ActuatorController::stopActuator(ActuatorId::BasePump);
             Logger::log(LogLevel::INFO, "pH above setpoint, base dosing paused");
         }
     } else if (abs(phInput - phSetpoint) <= phHysteresis) {
-        ActuatorController::stopActuator("basePump");  // Just stop pump but keep PID active
+        ActuatorController::stopActuator(ActuatorId::BasePump);  // Just stop pump but keep PID active
         Logger::log(LogLevel::INFO, "pH within hysteresis range (" +
                     String(phHysteresis) + "). Base dosing paused.");
     }
@@ -389,12 +418,12 @@ void PIDManager::updateDOPID() {
 void PIDManager::updateDOPID() {
     if (!doPIDRunning) return;
 
-    doInput = SensorController::readSensor("oxygenSensor");
+    doInput = SensorController::getSnapshot().oxygen;
     doPID.Compute();
 
     // If set to 0, maintain constant aeration of 20%.
     if (doSetpoint == 0) {
-        ActuatorController::runActuator("airPump", 30, 0);  // Maintain minimum aeration at 30% constant
+        ActuatorController::runActuator(ActuatorId::AirPump, 30, 0);  // Maintain minimum aeration at 30% constant
         Logger::log(LogLevel::INFO, F("DO setpoint is 0, maintaining constant aeration at 30%"));
         return;
     }
@@ -402,15 +431,15 @@ void PIDManager::updateDOPID() {
     // Normal PID behavior if setpoint is not 0
     if (abs(doInput - doSetpoint) > doHysteresis) {
         if (doInput < doSetpoint) {
-            ActuatorController::runActuator("airPump", doOutput, 0);
+            ActuatorController::runActuator(ActuatorId::AirPump, doOutput, 0);
             Logger::log(LogLevel::INFO, "DO PID update - Setpoint: " + String(doSetpoint) + 
                        ", Input: " + String(doInput) + ", Output: " + String(doOutput));
         } else {
-            ActuatorController::stopActuator("airPump");
+            ActuatorController::stopActuator(ActuatorId::AirPump);
             Logger::log(LogLevel::INFO, "DO above setpoint, stopping aeration");
         }
     } else {
-        ActuatorController::stopActuator("airPump");
+        ActuatorController::stopActuator(ActuatorId::AirPump);
         // ActuatorController::runActuator("airPump", 20, 0);  // Maintain minimum aeration
         Logger::log(LogLevel::INFO, "DO within hysteresis range (" +
                     String(doHysteresis) + "). Aeration stopped.");
@@ -420,14 +449,14 @@ void PIDManager::updateDOPID() {
 void PIDManager::stopTemperaturePID() {
     tempPIDRunning = false;
     tempOutput = 0;
-    ActuatorController::stopActuator("heatingPlate");
+    ActuatorController::stopActuator(ActuatorId::HeatingPlate);
     Logger::log(LogLevel::INFO, F("Temperature PID stopped"));
 }
 
 void PIDManager::stopPHPID() {
     phPIDRunning = false;
     phOutput = 0;
-    ActuatorController::stopActuator("basePump");
+    ActuatorController::stopActuator(ActuatorId::BasePump);
     //Logger::log(LogLevel::INFO, "pH PID stopped");
     Logger::log(LogLevel::INFO, F("pH PID stopped"));
 }
@@ -435,7 +464,7 @@ void PIDManager::stopPHPID() {
 void PIDManager::stopDOPID() {
     doPIDRunning = false;
     doOutput = 0;
-    ActuatorController::stopActuator("airPump");
+    ActuatorController::stopActuator(ActuatorId::AirPump);
     //Logger::log(LogLevel::INFO, "DO PID stopped");
     Logger::log(LogLevel::INFO, F("DO PID stopped"));
 }
@@ -461,6 +490,19 @@ void PIDManager::resumeAllPID() {
     doPID.SetMode(AUTOMATIC);
 }
 
+void PIDManager::restoreOutputs(double tempOutput, double phOutput, double doOutput) {
+    const SensorSnapshot& snapshot = SensorController::getSnapshot();
+    tempInput = snapshot.waterTemp;
+    phInput = snapshot.pH;
+    doInput = snapshot.oxygen;
+    this->tempOutput = tempOutput;
+    this->phOutput = phOutput;
+    this->doOutput = doOutput;
+    // The switch to AUTOMATIC initializes the PIDs from the current input and output
+    pauseAllPID();
+    resumeAllPID();
+}
+
 void PIDManager::adjustPIDParameters(const String& pidType, double Kp, double Ki, double Kd) {
     if (pidType == "temperature") {
         tempPID.SetTunings(Kp, Ki, Kd);
@@ -471,14 +513,83 @@ void PIDManager::adjustPIDParameters(const String& pidType, double Kp, double Ki
     }
 }
 
-// A sauvegarder/charger sur le serveur SI BESOIN de plus de data.
-void PIDManager::saveParameters(const char* filename) {
-    // Implement saving PID parameters to EEPROM or SD card
-    Logger::log(LogLevel::INFO, "Saving PID parameters to " + String(filename));
+void PIDManager::setTunedParameters(PIDLoop loop, double Kp, double Ki, double Kd) {
+    PIDTunings& tuning = tunings[static_cast<int>(loop)];
+    tuning.tuned = true;
+    tuning.Kp = Kp;
+    tuning.Ki = Ki;
+    tuning.Kd = Kd;
+
+    // The PIDs keep their default 100 ms sample time while the loops compute every UPDATE_INTERVAL_*:
+    // scale the integral and derivative gains so that they act on the real interval
+    double ratio = getUpdateInterval(loop) / 100.0;
+    getPID(loop).SetTunings(Kp, Ki * ratio, Kd / ratio);
+
+    Logger::log(LogLevel::INFO, String(getLoopName(loop)) + " PID tuned - Kp: " + String(Kp, 3) +
+                ", Ki: " + String(Ki, 4) + ", Kd: " + String(Kd, 3));
 }
-void PIDManager::loadParameters(const char* filename) {
-    // Implement loading PID parameters from EEPROM or SD card
-    Logger::log(LogLevel::INFO, "Loading PID parameters from " + String(filename));
+
+const char* PIDManager::getLoopName(PIDLoop loop) {
+    switch (loop) {
+        case PIDLoop::Temperature: return "temperature";
+        case PIDLoop::PH: return "pH";
+        case PIDLoop::DO: return "DO";
+        default: return "unknown";
+    }
+}
+
+unsigned long PIDManager::getUpdateInterval(PIDLoop loop) {
+    switch (loop) {
+        case PIDLoop::PH: return UPDATE_INTERVAL_PH;
+        case PIDLoop::DO: return UPDATE_INTERVAL_DO;
+        default: return UPDATE_INTERVAL_TEMP;
+    }
+}
+
+ClockedPID& PIDManager::getPID(PIDLoop loop) {
+    switch (loop) {
+        case PIDLoop::PH: return phPID;
+        case PIDLoop::DO: return doPID;
+        default: return tempPID;
+    }
+}
+
+bool PIDManager::saveParameters() {
+    PIDParametersRecord record;
+    memset(&record, 0, sizeof(record));
+    for (int i = 0; i < static_cast<int>(PIDLoop::Count); i++) {
+        record.Kp[i] = tunings[i].Kp;
+        record.Ki[i] = tunings[i].Ki;
+        record.Kd[i] = tunings[i].Kd;
+        record.tuned[i] = tunings[i].tuned;
+    }
+    record.hysteresis[0] = tempHysteresis;
+    record.hysteresis[1] = phHysteresis;
+    record.hysteresis[2] = doHysteresis;
+    record.setpoint[0] = tempSetpoint;
+    record.setpoint[1] = phSetpoint;
+    record.setpoint[2] = doSetpoint;
+    return ParameterStore::queue(record);
+}
+
+bool PIDManager::loadParameters() {
+    PIDParametersRecord record;
+    if (!ParameterStore::load(record)) {
+        Logger::log(LogLevel::INFO, F("No saved PID parameters, using the defaults"));
+        return false;
+    }
+    for (int i = 0; i < static_cast<int>(PIDLoop::Count); i++) {
+        if (record.tuned[i]) {
+            setTunedParameters(static_cast<PIDLoop>(i), record.Kp[i], record.Ki[i], record.Kd[i]);
+        }
+    }
+    setHysteresis(record.hysteresis[0], record.hysteresis[1], record.hysteresis[2]);
+    tempSetpoint = record.setpoint[0];
+    phSetpoint = record.setpoint[1];
+    doSetpoint = record.setpoint[2];
+    Logger::log(LogLevel::INFO, "PID parameters restored - Hysteresis: " + String(tempHysteresis) + "/" + String(phHysteresis) +
+                "/" + String(doHysteresis) + ", Setpoints: " + String(tempSetpoint) + "/" + String(phSetpoint) + "/" + String(doSetpoint));
+    return true;
 }
 
 double PIDManager::convertPIDOutputToFlowRate(double pidOutput) {
@@ -2,11 +2,27 @@
 #ifndef PID_MANAGER_H
 #define PID_MANAGER_H
 
-#include <PID_v1.h>
+#include "ClockedPID.h"
 #include "ActuatorController.h"
 #include "SensorController.h"
 #include "VolumeManager.h"
 
+// Control loops of the PIDManager
+enum class PIDLoop {
+    Temperature,
+    PH,
+    DO,
+    Count
+};
+
+// Gains identified for a loop, in PID output % per unit of the measure and per second
+struct PIDTunings {
+    bool tuned;
+    double Kp;
+    double Ki;
+    double Kd;
+};
+
 class PIDManager {
 public:
     PIDManager();
@@ -37,29 +53,45 @@ public:
     void pauseAllPID();
     void resumeAllPID();
 
+    // Restart the loops from outputs saved before a reset: the integral terms start from these outputs
+    void restoreOutputs(double tempOutput, double phOutput, double doOutput);
+
     double getTemperatureOutput() const;
     double getPHOutput() const;
     double getDOOutput() const;
 
     void adjustPIDStirringSpeed();
 
-    void saveParameters(const char* filename);
-    void loadParameters(const char* filename);
+    // Tuned gains, hysteresis and setpoints in the ParameterStore, written by ParameterStore::service()
+    bool saveParameters();
+    bool loadParameters();
 
     void setHysteresis(double tempHyst, double phHyst, double doHyst);
 
     void adjustPIDParameters(const String& pidType, double Kp, double Ki, double Kd);
 
+    /*
+     * Apply gains identified by a tuning experiment (see AutotuneProgram.h).
+     * The start-up and maintain factors are no longer applied to a tuned loop,
+     * and the tuned temperature loop drives the heating plate without hysteresis band.
+     */
+    void setTunedParameters(PIDLoop loop, double Kp, double Ki, double Kd);
+    const PIDTunings& getTunings(PIDLoop loop) const { return tunings[static_cast<int>(loop)]; }
+    static const char* getLoopName(PIDLoop loop);
+    static unsigned long getUpdateInterval(PIDLoop loop);
+
     void setMinStirringSpeed(int speed) { minStirringSpeed = speed; }
     int getMinStirringSpeed() const { return minStirringSpeed; }
 
     bool isTemperaturePIDRunning() const { return tempPIDRunning; }
     double getTemperatureSetpoint() const { return tempSetpoint; }
+    double getPHSetpoint() const { return phSetpoint; }
+    double getDOSetpoint() const { return doSetpoint; }
     
 private:
-    PID tempPID;
-    PID phPID;
-    PID doPID;
+    ClockedPID tempPID;
+    ClockedPID phPID;
+    ClockedPID doPID;
 
     double tempInput, tempOutput, tempSetpoint;
     double phInput, phOutput, phSetpoint;
@@ -84,6 +116,10 @@ private:
     int minStirringSpeed;
     bool isStartupPhase;
 
+    PIDTunings tunings[static_cast<int>(PIDLoop::Count)];
+
+    ClockedPID& getPID(PIDLoop loop);
+
     void switchToMaintainMode();
     double convertPIDOutputToHeatingPower(double pidOutput);
     double convertPIDOutputToFlowRate(double pidOutput);
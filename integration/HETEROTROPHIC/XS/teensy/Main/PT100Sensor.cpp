@@ -9,17 +9,69 @@
 
 // Constructor for PT100Sensor
 PT100Sensor::PT100Sensor(int csPin, int diPin, int doPin, int clkPin, const char* name)
-    : _thermo(csPin, diPin, doPin, clkPin), _name(name) {}
+    : _thermo(csPin, diPin, doPin, clkPin),
+      _spi(csPin, clkPin, doPin, diPin, 1000000, SPI_BITORDER_MSBFIRST, SPI_MODE1),
+      _name(name), _state(IDLE), _stateStart(0) {}
 
 // Method to initialize the PT100 sensor
 void PT100Sensor::begin() {
     _thermo.begin(MAX31865_3WIRE); // Set up the MAX31865 module for 3-wire RTD
+    _spi.begin();
     //Logger::log(LogLevel::INFO, String(_name) + " initialized");
     Logger::log(LogLevel::INFO, String(_name) + F(" initialized"));
 }
 
-// Method to read the temperature from the sensor
+// Method to read the temperature from the sensor (blocking, used outside the acquisition loop)
 float PT100Sensor::readValue() {
-    float temperature = _thermo.temperature(100, 430); // Parameters are Rref and RTD nominal resistance
+    _state = IDLE;
+    float temperature = _thermo.temperature(RTD_NOMINAL, REF_RESISTOR);
     return round(temperature * 10) / 10.0; // Round to 1 decimal place
 }
+
+// Same sequence as Adafruit_MAX31865::readRTD(), with the two waits left to the caller
+bool PT100Sensor::startReading() {
+    _thermo.clearFault();
+    _thermo.enableBias(true);
+    _state = BIAS_SETTLING;
+    _stateStart = millis();
+    return true;
+}
+
+bool PT100Sensor::pollReading(float& value) {
+    unsigned long elapsed = millis() - _stateStart;
+    if (_state == BIAS_SETTLING) {
+        if (elapsed < BIAS_TIME) {
+            return false;
+        }
+        writeRegister8(MAX31865_CONFIG_REG, readRegister8(MAX31865_CONFIG_REG) | MAX31865_CONFIG_1SHOT);
+        _state = CONVERTING;
+        _stateStart = millis();
+        return false;
+    }
+    if (_state == CONVERTING && elapsed < CONVERSION_TIME) {
+        return false;
+    }
+    uint16_t rtd = readRegister16(MAX31865_RTDMSB_REG) >> 1; // Bit 0 is the fault flag
+    _thermo.enableBias(false);
+    _state = IDLE;
+    float temperature = _thermo.calculateTemperature(rtd, RTD_NOMINAL, REF_RESISTOR);
+    value = round(temperature * 10) / 10.0; // Round to 1 decimal place
+    return true;
+}
+
+uint8_t PT100Sensor::readRegister8(uint8_t address) {
+    uint8_t buffer[1] = {static_cast<uint8_t>(address & 0x7F)};
+    _spi.write_then_read(buffer, 1, buffer, 1);
+    return buffer[0];
+}
+
+uint16_t PT100Sensor::readRegister16(uint8_t address) {
+    uint8_t buffer[2] = {static_cast<uint8_t>(address & 0x7F), 0};
+    _spi.write_then_read(buffer, 1, buffer, 2);
+    return (static_cast<uint16_t>(buffer[0]) << 8) | buffer[1];
+}
+
+void PT100Sensor::writeRegister8(uint8_t address, uint8_t data) {
+    uint8_t buffer[2] = {static_cast<uint8_t>(address | 0x80), data};
+    _spi.write(buffer, 2);
+}
@@ -51,6 +51,7 @@
 
 #include "SensorInterface.h"
 #include <Adafruit_MAX31865.h>
+#include <Adafruit_SPIDevice.h>
 
 class PT100Sensor : public SensorInterface {
 public:
@@ -75,9 +76,41 @@ public:
      */
     float readValue();
 
+    /*
+     * Method to start a one-shot conversion without waiting for it (turns the RTD bias on).
+     * @return: true, the conversion is then driven by pollReading().
+     */
+    bool startReading() override;
+
+    /*
+     * Method to poll the conversion started with startReading().
+     * Starts the one-shot conversion once the bias has settled, then reads the RTD once it is complete.
+     * @param value: The temperature in degrees Celsius.
+     * @return: true once the RTD register has been read.
+     */
+    bool pollReading(float& value) override;
+
 private:
     Adafruit_MAX31865 _thermo; // MAX31865 sensor object
+    Adafruit_SPIDevice _spi;   // Same bus, used for the register accesses of the non-blocking conversion
     const char* _name;
+
+    enum ConversionState : uint8_t {
+        IDLE,
+        BIAS_SETTLING,  // Bias on, waiting before the one-shot conversion is started
+        CONVERTING      // One-shot conversion in progress
+    };
+    ConversionState _state;
+    unsigned long _stateStart; // Time at which the current state was entered
+
+    static const unsigned long BIAS_TIME = 10;        // Bias settling time before a conversion (ms)
+    static const unsigned long CONVERSION_TIME = 65;  // One-shot conversion time, 60 Hz filter (ms)
+    static constexpr float RTD_NOMINAL = 100.0f;      // PT100
+    static constexpr float REF_RESISTOR = 430.0f;
+
+    uint8_t readRegister8(uint8_t address);
+    uint16_t readRegister16(uint8_t address);
+    void writeRegister8(uint8_t address, uint8_t data);
 };
 
 #endif
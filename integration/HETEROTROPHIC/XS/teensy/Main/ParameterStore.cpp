@@ -0,0 +1,350 @@
+// ParameterStore.cpp
+#include "ParameterStore.h"
+#include <EEPROM.h>
+#include "Logger.h"
+#include "Profiler.h"
+
+bool ParameterStore::initialized = false;
+int ParameterStore::areaSize = 0;
+int ParameterStore::activeArea = 0;
+uint16_t ParameterStore::generation = 0;
+int ParameterStore::appendOffset = 0;
+ParameterStore::Slot ParameterStore::slots[ParameterStore::RECORD_TYPE_COUNT];
+ParameterStore::WriteJob ParameterStore::job;
+ParameterStore::Compaction ParameterStore::compaction;
+unsigned long ParameterStore::recordsWritten = 0;
+unsigned long ParameterStore::bytesWritten = 0;
+unsigned long ParameterStore::compactions = 0;
+bool ParameterStore::writesSuspended = false;
+unsigned long ParameterStore::refusedRecords = 0;
+
+void ParameterStore::begin() {
+    areaSize = EEPROM.length() / 2;
+    job.active = false;
+    compaction.active = false;
+
+    uint16_t generations[2];
+    bool valid[2];
+    for (int area = 0; area < 2; area++) {
+        valid[area] = readAreaGeneration(area, generations[area]);
+    }
+
+    if (!valid[0] && !valid[1]) {
+        activeArea = 0;
+        generation = 1;
+        prepareAreaHeader(activeArea, generation);
+        while (job.active) {
+            writeNextByte();
+        }
+        // Records left by an earlier journal must not follow the new header
+        EEPROM.update(areaStart(activeArea) + AREA_HEADER_SIZE, 0xFF);
+        Logger::log(LogLevel::INFO, "Parameter store formatted (" + String(EEPROM.length()) + " bytes)");
+    } else if (valid[0] && valid[1]) {
+        // The most recent area, generations wrap around
+        activeArea = (static_cast<int16_t>(generations[1] - generations[0]) > 0) ? 1 : 0;
+        generation = generations[activeArea];
+    } else {
+        activeArea = valid[0] ? 0 : 1;
+        generation = generations[activeArea];
+    }
+
+    scanArea();
+    initialized = true;
+}
+
+void ParameterStore::service(int maxBytes) {
+    if (!initialized) begin();
+    PROFILE_ZONE("store.service");
+    int written = 0;
+    while (maxBytes < 0 || written < maxBytes) {
+        if (!job.active && !startNextJob()) break;
+        writeNextByte();
+        written++;
+    }
+}
+
+bool ParameterStore::isIdle() {
+    if (job.active || compaction.active) return false;
+    for (int i = 0; i < RECORD_TYPE_COUNT; i++) {
+        if (slots[i].pending) return false;
+    }
+    return true;
+}
+
+void ParameterStore::clear() {
+    for (int area = 0; area < 2; area++) {
+        for (int i = 0; i < AREA_HEADER_SIZE; i++) {
+            EEPROM.update(areaStart(area) + i, 0xFF);
+        }
+    }
+    Logger::log(LogLevel::INFO, F("Parameter store cleared"));
+    begin();
+}
+
+void ParameterStore::logStatistics() {
+    if (!initialized) begin();
+    String stats = "Parameter store: area " + String(activeArea) + ", generation " + String(generation) +
+                   ", " + String(appendOffset - areaStart(activeArea)) + "/" + String(areaSize) + " bytes used, " +
+                   String(recordsWritten) + " records and " + String(bytesWritten) + " bytes written, " +
+                   String(compactions) + " compactions, records:";
+    for (int i = 0; i < RECORD_TYPE_COUNT; i++) {
+        stats += slots[i].pending ? " pending" : (slots[i].stored ? " saved" : " none");
+    }
+    Logger::log(LogLevel::INFO, stats);
+}
+
+bool ParameterStore::queue(RecordType type, uint8_t version, const void* data, uint8_t length) {
+    if (!initialized) begin();
+    if (length > MAX_RECORD_SIZE) {
+        Logger::log(LogLevel::ERROR, "Parameter record too large: " + String(length) + " bytes");
+        return false;
+    }
+    if (writesSuspended) {
+        refusedRecords++;
+        return false;
+    }
+
+    Slot& slot = slots[static_cast<int>(type)];
+    // Identical to the latest value: nothing to write
+    if ((slot.stored || slot.pending) && slot.version == version && slot.length == length &&
+        memcmp(slot.data, data, length) == 0) {
+        return true;
+    }
+    slot.version = version;
+    slot.length = length;
+    memcpy(slot.data, data, length);
+    slot.pending = true;
+    return true;
+}
+
+void ParameterStore::suspendWrites(bool suspended) {
+    if (suspended == writesSuspended) return;
+    writesSuspended = suspended;
+    if (suspended) {
+        refusedRecords = 0;
+        Logger::log(LogLevel::INFO, F("Parameter store writes suspended"));
+    } else {
+        Logger::log(LogLevel::INFO, "Parameter store writes resumed, " + String(refusedRecords) + " records discarded");
+    }
+}
+
+bool ParameterStore::read(RecordType type, uint8_t version, void* data, uint8_t length) {
+    if (!initialized) begin();
+    const Slot& slot = slots[static_cast<int>(type)];
+    if (!(slot.stored || slot.pending) || slot.version != version || slot.length != length) {
+        return false;
+    }
+    memcpy(data, slot.data, length);
+    return true;
+}
+
+bool ParameterStore::readAreaGeneration(int area, uint16_t& areaGeneration) {
+    int start = areaStart(area);
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < 6; i++) {
+        crc = crc16(crc, EEPROM.read(start + i));
+    }
+    uint32_t magic = static_cast<uint32_t>(readWord(start)) | (static_cast<uint32_t>(readWord(start + 2)) << 16);
+    areaGeneration = readWord(start + 4);
+    return magic == AREA_MAGIC && readWord(start + 6) == crc;
+}
+
+void ParameterStore::scanArea() {
+    for (int i = 0; i < RECORD_TYPE_COUNT; i++) {
+        slots[i].stored = false;
+        slots[i].pending = false;
+    }
+
+    int end = areaStart(activeArea) + areaSize;
+    int offset = areaStart(activeArea) + AREA_HEADER_SIZE;
+    // Records follow each other up to the first one that is not valid for this generation
+    while (offset + RECORD_HEADER_SIZE <= end) {
+        uint8_t type = EEPROM.read(offset + 1);
+        uint8_t length = EEPROM.read(offset + 3);
+        if (EEPROM.read(offset) != RECORD_MAGIC || readWord(offset + 4) != generation ||
+            offset + RECORD_HEADER_SIZE + length > end) {
+            break;
+        }
+        uint16_t crc = 0xFFFF;
+        for (int i = 0; i < 6; i++) {
+            crc = crc16(crc, EEPROM.read(offset + i));
+        }
+        for (int i = 0; i < length; i++) {
+            crc = crc16(crc, EEPROM.read(offset + RECORD_HEADER_SIZE + i));
+        }
+        if (readWord(offset + 6) != crc) {
+            break;
+        }
+        if (type < RECORD_TYPE_COUNT && length <= MAX_RECORD_SIZE) {
+            Slot& slot = slots[type];
+            slot.stored = true;
+            slot.version = EEPROM.read(offset + 2);
+            slot.length = length;
+            slot.offset = offset;
+            for (int i = 0; i < length; i++) {
+                slot.data[i] = EEPROM.read(offset + RECORD_HEADER_SIZE + i);
+            }
+        }
+        offset += RECORD_HEADER_SIZE + length;
+    }
+    appendOffset = offset;
+}
+
+bool ParameterStore::startNextJob() {
+    if (compaction.active) {
+        // Latest records first, then the header that activates the area
+        while (compaction.nextType < RECORD_TYPE_COUNT &&
+               !(slots[compaction.nextType].stored || slots[compaction.nextType].pending)) {
+            compaction.nextType++;
+        }
+        if (compaction.nextType < RECORD_TYPE_COUNT) {
+            int type = compaction.nextType++;
+            prepareRecord(type, compaction.offset, compaction.generation);
+            compaction.moved[type] = compaction.offset;
+            compaction.offset += job.size;
+        } else {
+            prepareAreaHeader(compaction.area, compaction.generation);
+        }
+        return true;
+    }
+
+    for (int i = 0; i < RECORD_TYPE_COUNT; i++) {
+        if (!slots[i].pending) continue;
+        if (appendOffset + RECORD_HEADER_SIZE + slots[i].length > areaStart(activeArea) + areaSize) {
+            return startCompaction() && startNextJob();
+        }
+        prepareRecord(i, appendOffset, generation);
+        return true;
+    }
+    return false;
+}
+
+bool ParameterStore::startCompaction() {
+    int size = 0;
+    for (int i = 0; i < RECORD_TYPE_COUNT; i++) {
+        if (slots[i].stored || slots[i].pending) size += RECORD_HEADER_SIZE + slots[i].length;
+    }
+    if (AREA_HEADER_SIZE + size > areaSize) {
+        Logger::log(LogLevel::ERROR, F("Parameter store too small for the records, queued records dropped"));
+        for (int i = 0; i < RECORD_TYPE_COUNT; i++) {
+            slots[i].pending = false;
+        }
+        return false;
+    }
+
+    compaction.active = true;
+    compaction.area = 1 - activeArea;
+    compaction.generation = generation + 1;
+    compaction.nextType = 0;
+    compaction.offset = areaStart(compaction.area) + AREA_HEADER_SIZE;
+    for (int i = 0; i < RECORD_TYPE_COUNT; i++) {
+        compaction.moved[i] = -1;
+    }
+    return true;
+}
+
+void ParameterStore::prepareRecord(int type, int offset, uint16_t recordGeneration) {
+    Slot& slot = slots[type];
+    job.active = true;
+    job.areaHeader = false;
+    job.type = type;
+    job.offset = offset;
+    job.size = RECORD_HEADER_SIZE + slot.length;
+    job.progress = 0;
+
+    job.bytes[0] = RECORD_MAGIC;
+    job.bytes[1] = type;
+    job.bytes[2] = slot.version;
+    job.bytes[3] = slot.length;
+    job.bytes[4] = recordGeneration & 0xFF;
+    job.bytes[5] = recordGeneration >> 8;
+    memcpy(job.bytes + RECORD_HEADER_SIZE, slot.data, slot.length);
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < job.size; i++) {
+        if (i == 6) i = RECORD_HEADER_SIZE;
+        crc = crc16(crc, job.bytes[i]);
+    }
+    job.bytes[6] = crc & 0xFF;
+    job.bytes[7] = crc >> 8;
+
+    // The job has its own copy, a newer value queued meanwhile is written afterwards
+    slot.pending = false;
+}
+
+void ParameterStore::prepareAreaHeader(int area, uint16_t areaGeneration) {
+    job.active = true;
+    job.areaHeader = true;
+    job.type = -1;
+    job.offset = areaStart(area);
+    job.size = AREA_HEADER_SIZE;
+    job.progress = 0;
+
+    job.bytes[0] = AREA_MAGIC & 0xFF;
+    job.bytes[1] = (AREA_MAGIC >> 8) & 0xFF;
+    job.bytes[2] = (AREA_MAGIC >> 16) & 0xFF;
+    job.bytes[3] = AREA_MAGIC >> 24;
+    job.bytes[4] = areaGeneration & 0xFF;
+    job.bytes[5] = areaGeneration >> 8;
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < 6; i++) {
+        crc = crc16(crc, job.bytes[i]);
+    }
+    job.bytes[6] = crc & 0xFF;
+    job.bytes[7] = crc >> 8;
+}
+
+void ParameterStore::writeNextByte() {
+    // Record: payload, CRC, then the header down to the magic byte that makes it visible.
+    // Area header: CRC first, so that it only becomes valid with its last byte.
+    int index;
+    int payloadLength = job.size - RECORD_HEADER_SIZE;
+    if (job.areaHeader) {
+        index = AREA_HEADER_SIZE - 1 - job.progress;
+    } else if (job.progress < payloadLength) {
+        index = RECORD_HEADER_SIZE + job.progress;
+    } else if (job.progress < payloadLength + 2) {
+        index = 6 + (job.progress - payloadLength);
+    } else {
+        index = 5 - (job.progress - payloadLength - 2);
+    }
+    EEPROM.update(job.offset + index, job.bytes[index]);
+    bytesWritten++;
+
+    if (++job.progress == job.size) {
+        finishJob();
+    }
+}
+
+void ParameterStore::finishJob() {
+    job.active = false;
+    if (job.areaHeader) {
+        if (!compaction.active) return;
+        activeArea = compaction.area;
+        generation = compaction.generation;
+        appendOffset = compaction.offset;
+        for (int i = 0; i < RECORD_TYPE_COUNT; i++) {
+            slots[i].stored = compaction.moved[i] >= 0;
+            slots[i].offset = compaction.moved[i];
+        }
+        compaction.active = false;
+        compactions++;
+    } else if (!compaction.active) {
+        slots[job.type].stored = true;
+        slots[job.type].offset = job.offset;
+        appendOffset += job.size;
+    }
+    recordsWritten++;
+}
+
+// CRC-16/CCITT-FALSE
+uint16_t ParameterStore::crc16(uint16_t crc, uint8_t value) {
+    crc ^= static_cast<uint16_t>(value) << 8;
+    for (int i = 0; i < 8; i++) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+uint16_t ParameterStore::readWord(int offset) {
+    return EEPROM.read(offset) | (EEPROM.read(offset + 1) << 8);
+}
@@ -0,0 +1,188 @@
+// ParameterStore.h
+#ifndef PARAMETER_STORE_H
+#define PARAMETER_STORE_H
+
+#include <Arduino.h>
+
+// Types of the records kept in the parameter store
+enum class RecordType : uint8_t {
+    PIDParameters,
+    Volume,
+    Program,
+    FermentationCheckpoint,
+    Count
+};
+
+// Records are stored as raw bytes: only fixed size fields, without padding.
+// Increment VERSION when the layout of a record changes, older records are then ignored.
+
+struct PIDParametersRecord {
+    static const RecordType TYPE = RecordType::PIDParameters;
+    static const uint8_t VERSION = 1;
+    float Kp[3];           // PIDLoop order
+    float Ki[3];
+    float Kd[3];
+    float hysteresis[3];
+    float setpoint[3];
+    uint8_t tuned[3];
+    uint8_t reserved;
+};
+
+struct VolumeRecord {
+    static const RecordType TYPE = RecordType::Volume;
+    static const uint8_t VERSION = 1;
+    float currentVolume;
+    float initialVolume;
+    float cumulativeNaOH;
+    float cumulativeNutrient;
+    float cumulativeMicroalgae;
+    float cumulativeRemoved;
+};
+
+struct ProgramRecord {
+    static const RecordType TYPE = RecordType::Program;
+    static const uint8_t VERSION = 1;
+    uint8_t state;         // ProgramState
+    uint8_t reserved[3];
+    char name[16];
+    char command[128];     // Command the program was started with
+};
+
+struct FermentationCheckpointRecord {
+    static const RecordType TYPE = RecordType::FermentationCheckpoint;
+    static const uint8_t VERSION = 1;
+    uint32_t elapsedTime;                   // ms of fermentation, pauses excluded
+    uint32_t nutrientCycleTime;             // ms since the last nutrient pump start or stop
+    uint32_t plannedNutrientActivationTime; // ms
+    float tempOutput;                       // PID outputs, for a bumpless restart
+    float phOutput;
+    float doOutput;
+    int32_t stirringSpeed;
+    uint8_t nutrientAdditionStarted;
+    uint8_t nutrientPumpRunning;
+    uint8_t paused;
+    uint8_t pidEnabled;
+};
+
+/*
+ * Journal of parameter records in the Teensy EEPROM.
+ * The EEPROM is split in two areas. Records are appended to the active area, each with a header
+ * (type, version, length, area generation) and a CRC-16, so that a record torn by a reset is ignored.
+ * The latest record of each type is the current value. When the active area is full, the latest records
+ * are copied to the other area, whose header is written last with the next generation: every cell
+ * is written once per pass over the EEPROM, and a reset during the copy leaves the previous area valid.
+ *
+ * The latest value of each type is kept in RAM. A record identical to it is not written again.
+ * save() writes at once, queue() leaves the writing to service(), which writes a bounded number
+ * of bytes per call so that checkpoints and compactions never hold the main loop.
+ */
+class ParameterStore {
+public:
+    // Find the active area and load the latest records, format the EEPROM if it holds no journal
+    static void begin();
+
+    // Write the record before returning
+    template <typename T>
+    static bool save(const T& record) {
+        if (!queue(T::TYPE, T::VERSION, &record, sizeof(T))) return false;
+        service(-1);
+        return true;
+    }
+
+    // Write the record during the next calls of service()
+    template <typename T>
+    static bool queue(const T& record) {
+        return queue(T::TYPE, T::VERSION, &record, sizeof(T));
+    }
+
+    // Latest record of the type, saved or queued. False if none has this version
+    template <typename T>
+    static bool load(T& record) {
+        return read(T::TYPE, T::VERSION, &record, sizeof(T));
+    }
+
+    /*
+     * Write queued records.
+     * @param maxBytes: maximum number of EEPROM bytes written by this call, -1 for all
+     */
+    static void service(int maxBytes);
+    static bool isIdle();
+
+    // While suspended (replay), queue() and save() refuse new records and load() keeps returning the stored ones
+    static void suspendWrites(bool suspended);
+    static bool areWritesSuspended() { return writesSuspended; }
+
+    static void clear();
+    static void logStatistics();
+
+private:
+    static const uint32_t AREA_MAGIC = 0x31505242;  // "BRP1", format of the journal
+    static const uint8_t RECORD_MAGIC = 0xB5;
+    static const int AREA_HEADER_SIZE = 8;          // magic, generation, CRC
+    static const int RECORD_HEADER_SIZE = 8;        // magic, type, version, length, generation, CRC
+    static const int MAX_RECORD_SIZE = 160;
+    static const int RECORD_TYPE_COUNT = static_cast<int>(RecordType::Count);
+
+    // Latest value of a record type
+    struct Slot {
+        bool stored;       // written in the active area, at offset
+        bool pending;      // data not written yet
+        uint8_t version;
+        uint8_t length;
+        int offset;
+        uint8_t data[MAX_RECORD_SIZE];
+    };
+
+    // Bytes being written, in an order that keeps a partial write invisible
+    struct WriteJob {
+        bool active;
+        bool areaHeader;
+        int type;
+        int offset;
+        int size;
+        int progress;
+        uint8_t bytes[RECORD_HEADER_SIZE + MAX_RECORD_SIZE];
+    };
+
+    // Copy of the latest records to the other area
+    struct Compaction {
+        bool active;
+        int area;
+        uint16_t generation;
+        int nextType;
+        int offset;
+        int moved[RECORD_TYPE_COUNT];
+    };
+
+    static bool initialized;
+    static int areaSize;
+    static int activeArea;
+    static uint16_t generation;
+    static int appendOffset;
+    static Slot slots[RECORD_TYPE_COUNT];
+    static WriteJob job;
+    static Compaction compaction;
+    static unsigned long recordsWritten;
+    static unsigned long bytesWritten;
+    static unsigned long compactions;
+    static bool writesSuspended;
+    static unsigned long refusedRecords;  // Records refused during the current suspension
+
+    static bool queue(RecordType type, uint8_t version, const void* data, uint8_t length);
+    static bool read(RecordType type, uint8_t version, void* data, uint8_t length);
+
+    static bool readAreaGeneration(int area, uint16_t& areaGeneration);
+    static void scanArea();
+    static bool startNextJob();
+    static bool startCompaction();
+    static void prepareRecord(int type, int offset, uint16_t recordGeneration);
+    static void prepareAreaHeader(int area, uint16_t areaGeneration);
+    static void writeNextByte();
+    static void finishJob();
+
+    static int areaStart(int area) { return area * areaSize; }
+    static uint16_t crc16(uint16_t crc, uint8_t value);
+    static uint16_t readWord(int offset);
+};
+
+#endif // PARAMETER_STORE_H
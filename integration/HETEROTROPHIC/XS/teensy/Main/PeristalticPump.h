@@ -62,8 +62,8 @@ public:
 private:
     uint8_t _dacAddress;    // I2C address of the DAC
     int _relayPin;          // Relay pin
-    float _maxFlowRate;     // Maximum flow rate of the pump
     float _minFlowRate;     // Minimum flow rate of the pump
+    float _maxFlowRate;     // Maximum flow rate of the pump
     const char* _name;
     Adafruit_MCP4725 _dac;  // DAC instance
     bool _status;            // Track the state of the pump
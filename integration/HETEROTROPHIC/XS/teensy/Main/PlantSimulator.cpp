@@ -0,0 +1,132 @@
+// PlantSimulator.cpp
+#include "PlantSimulator.h"
+#include "ActuatorController.h"
+#include "Logger.h"
+
+bool PlantSimulator::running = false;
+float PlantSimulator::timeScale = 1.0f;
+unsigned long PlantSimulator::lastUpdate = 0;
+float PlantSimulator::simulatedSeconds = 0;
+float PlantSimulator::waterTemp = AMBIENT_TEMP;
+float PlantSimulator::pH = 7.0f;
+float PlantSimulator::oxygen = 8.0f;
+float PlantSimulator::biomass = 0.1f;
+SimulatedSensor PlantSimulator::sensors[PlantSimulator::SENSOR_COUNT];
+SensorInterface* PlantSimulator::physicalSensors[PlantSimulator::SENSOR_COUNT] = {};
+
+float SimulatedSensor::readValue() {
+    return PlantSimulator::getValue(_id);
+}
+
+void PlantSimulator::start(float scale) {
+    timeScale = scale > 0 ? scale : 1.0f;
+    if (running) {
+        Logger::log(LogLevel::INFO, "Plant simulation time scale set to x" + String(timeScale));
+        return;
+    }
+
+    // Start from the last measured values
+    const SensorSnapshot& snapshot = SensorController::getSnapshot();
+    waterTemp = snapshot.waterTemp;
+    pH = snapshot.pH > 0 ? snapshot.pH : 7.0f;
+    oxygen = snapshot.oxygen > 0 ? snapshot.oxygen : oxygenSaturation(waterTemp);
+    biomass = max(snapshot.turbidity / TURBIDITY_PER_BIOMASS, 0.1f);
+    simulatedSeconds = 0;
+
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        SensorId id = static_cast<SensorId>(i);
+        physicalSensors[i] = SensorController::getSensor(id);
+        sensors[i].attach(id, physicalSensors[i]->getName());
+        SensorController::replaceSensor(id, &sensors[i]);
+    }
+    lastUpdate = micros();
+    running = true;
+    Logger::log(LogLevel::INFO, "Plant simulation started, time scale x" + String(timeScale));
+}
+
+void PlantSimulator::stop() {
+    if (!running) return;
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        SensorController::replaceSensor(static_cast<SensorId>(i), physicalSensors[i]);
+    }
+    running = false;
+    Logger::log(LogLevel::INFO, F("Plant simulation stopped, back to the physical sensors"));
+}
+
+void PlantSimulator::update() {
+    if (!running) return;
+    unsigned long now = micros();
+    float dt = (now - lastUpdate) / 1000000.0f * timeScale;
+    lastUpdate = now;
+
+    simulatedSeconds += dt;
+    while (dt > 0) {
+        float h = (dt < MAX_STEP) ? dt : MAX_STEP;
+        step(h);
+        dt -= h;
+    }
+}
+
+void PlantSimulator::step(float dt) {
+    // Heat balance of the culture, the plate power averaged over its switching cycle
+    float heating = ActuatorController::isActuatorRunning(ActuatorId::HeatingPlate) ?
+                    HEATER_POWER * ActuatorController::getCurrentValue(ActuatorId::HeatingPlate) / 100.0f : 0.0f;
+    float heatCapacity = 4186.0f * CULTURE_VOLUME; // J/K
+    waterTemp += (heating - HEAT_LOSS * (waterTemp - AMBIENT_TEMP)) / heatCapacity * dt;
+
+    // Acid production by the culture, compensated by the base pump (flow rate in ml/min)
+    float baseFlow = ActuatorController::isActuatorRunning(ActuatorId::BasePump) ?
+                     ActuatorController::getCurrentValue(ActuatorId::BasePump) / 60.0f : 0.0f;
+    pH += (-ACID_RATE * biomass + BASE_GAIN * baseFlow) * dt;
+
+    // Oxygen transfer from aeration and stirring, consumed by the culture
+    float airPump = ActuatorController::isActuatorRunning(ActuatorId::AirPump) ?
+                    ActuatorController::getCurrentValue(ActuatorId::AirPump) : 0.0f;
+    float stirring = ActuatorController::isActuatorRunning(ActuatorId::StirringMotor) ?
+                     ActuatorController::getCurrentValue(ActuatorId::StirringMotor) : 0.0f;
+    float kla = KLA_BASE + KLA_PER_AIR_PERCENT * airPump + KLA_PER_RPM * stirring;
+    oxygen += (kla * (oxygenSaturation(waterTemp) - oxygen) - OXYGEN_UPTAKE * biomass) * dt;
+    if (oxygen < 0) oxygen = 0;
+
+    // Logistic growth, stalled without oxygen
+    float growth = (oxygen > 0.5f) ? GROWTH_RATE : 0.0f;
+    biomass += growth * biomass * (1.0f - biomass / MAX_BIOMASS) * dt;
+}
+
+float PlantSimulator::getValue(SensorId id) {
+    switch (id) {
+        case SensorId::WaterTemp:
+            return waterTemp;
+        case SensorId::AirTemp:
+            return AMBIENT_TEMP;
+        case SensorId::ElectronicTemp:
+            return ELECTRONIC_TEMP;
+        case SensorId::PH:
+            return pH;
+        case SensorId::Oxygen:
+            return oxygen;
+        case SensorId::AirFlow:
+            return ActuatorController::isActuatorRunning(ActuatorId::AirPump) ?
+                   ActuatorController::getCurrentValue(ActuatorId::AirPump) * AIR_FLOW_PER_PERCENT : 0.0f;
+        case SensorId::Turbidity:
+            return biomass * TURBIDITY_PER_BIOMASS;
+        default:
+            return 0.0f;
+    }
+}
+
+void PlantSimulator::logState() {
+    if (!running) {
+        Logger::log(LogLevel::INFO, F("Plant simulation not running"));
+        return;
+    }
+    Logger::log(LogLevel::INFO, "Plant simulation x" + String(timeScale) + ", " + String(simulatedSeconds / 3600.0f, 2) +
+                " h simulated: water " + String(waterTemp, 2) + " C, pH " + String(pH, 2) +
+                ", DO " + String(oxygen, 2) + " mg/L, biomass " + String(biomass, 2) + " g/L");
+}
+
+// Dissolved oxygen at saturation in fresh water (mg/L)
+float PlantSimulator::oxygenSaturation(float temperature) {
+    float t = temperature;
+    return 14.62f - 0.3898f * t + 0.006969f * t * t - 0.00005897f * t * t * t;
+}
@@ -0,0 +1,83 @@
+// PlantSimulator.h
+#ifndef PLANT_SIMULATOR_H
+#define PLANT_SIMULATOR_H
+
+#include <Arduino.h>
+#include "SensorInterface.h"
+#include "SensorController.h"
+
+/*
+ * Sensor fed by the plant model instead of the hardware.
+ * Keeps the name of the sensor it replaces so that name based commands keep working.
+ */
+class SimulatedSensor : public SensorInterface {
+public:
+    SimulatedSensor() : _id(SensorId::WaterTemp), _name("") {}
+    void attach(SensorId id, const char* name) { _id = id; _name = name; }
+
+    void begin() override {}
+    float readValue() override;
+    const char* getName() const override { return _name; }
+
+private:
+    SensorId _id;
+    const char* _name;
+};
+
+/*
+ * Simple thermal / pH / dissolved oxygen / biomass model of the culture, driven by the actuator states.
+ * While running, the acquisition engine reads the model instead of the sensors, so control changes
+ * (PID, safety, programs) can be exercised on a Teensy without the bioreactor attached.
+ * timeScale speeds up the plant only: the controllers keep their real time intervals.
+ */
+class PlantSimulator {
+public:
+    static void start(float timeScale);
+    static void stop();
+    static bool isRunning() { return running; }
+
+    // Advance the model to the current time, call on every loop before SensorController::update()
+    static void update();
+
+    static float getValue(SensorId id);
+    static void logState();
+
+private:
+    static bool running;
+    static float timeScale;
+    static unsigned long lastUpdate;  // micros()
+    static float simulatedSeconds;
+
+    // Model state
+    static float waterTemp;  // °C
+    static float pH;
+    static float oxygen;     // mg/L
+    static float biomass;    // g/L
+
+    static SimulatedSensor sensors[static_cast<int>(SensorId::Count)];
+    static SensorInterface* physicalSensors[static_cast<int>(SensorId::Count)];
+
+    static void step(float dt);
+    static float oxygenSaturation(float temperature);
+
+    static const int SENSOR_COUNT = static_cast<int>(SensorId::Count);
+    static constexpr float MAX_STEP = 1.0f;               // Integration step (simulated s)
+
+    static constexpr float AMBIENT_TEMP = 22.0f;          // °C
+    static constexpr float ELECTRONIC_TEMP = 35.0f;       // °C
+    static constexpr float CULTURE_VOLUME = 0.5f;         // L
+    static constexpr float HEATER_POWER = 40.0f;          // W transferred to the culture at 100% power
+    static constexpr float HEAT_LOSS = 0.4f;              // W/K to the ambient air
+    static constexpr float ACID_RATE = 2.0e-6f;           // pH/s per g/L of biomass
+    static constexpr float BASE_GAIN = 0.05f;             // pH per ml of NaOH
+    static constexpr float KLA_BASE = 0.002f;             // 1/s, surface transfer
+    static constexpr float KLA_PER_AIR_PERCENT = 4.0e-5f; // 1/s per % of air pump
+    static constexpr float KLA_PER_RPM = 2.0e-6f;         // 1/s per RPM of stirring
+    static constexpr float OXYGEN_UPTAKE = 5.0e-4f;       // mg/L/s per g/L of biomass
+    static constexpr float GROWTH_RATE = 5.6e-5f;         // 1/s (0.2 /h)
+    static constexpr float MAX_BIOMASS = 10.0f;           // g/L
+    static constexpr float TURBIDITY_PER_BIOMASS = 100.0f; // NTU per g/L
+    static constexpr float AIR_FLOW_PER_PERCENT = 0.02f;  // L/min per % of air pump
+};
+
+#endif // PLANT_SIMULATOR_H
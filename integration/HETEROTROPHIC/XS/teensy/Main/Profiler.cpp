@@ -0,0 +1,119 @@
+// Profiler.cpp
+#include "Profiler.h"
+
+#if PROFILING_ENABLED
+
+#include "Logger.h"
+
+Profiler::Zone Profiler::zones[Profiler::MAX_ZONES];
+uint8_t Profiler::zoneCount = 0;
+bool Profiler::telemetryEnabled = false;
+
+uint8_t Profiler::registerZone(const char* name) {
+    if (zoneCount >= MAX_ZONES) {
+        Logger::log(LogLevel::WARNING, "Profiler zone table full, not measuring " + String(name));
+        return INVALID_ZONE;
+    }
+    zones[zoneCount].name = name;
+    resetZone(zones[zoneCount]);
+    return zoneCount++;
+}
+
+void Profiler::record(uint8_t zone, uint32_t cycles) {
+    if (zone >= zoneCount) return;
+    Zone& z = zones[zone];
+    z.count++;
+    z.totalCycles += cycles;
+    if (cycles < z.minCycles) z.minCycles = cycles;
+    if (cycles > z.maxCycles) z.maxCycles = cycles;
+    z.histogram[bucketFor(cycles)]++;
+}
+
+void Profiler::logReport() {
+    if (zoneCount == 0) {
+        Logger::log(LogLevel::INFO, F("Profiler: no zone measured yet"));
+        return;
+    }
+    Logger::log(LogLevel::INFO, F("Profiler zones (us): count min avg p99 max"));
+    for (uint8_t i = 0; i < zoneCount; i++) {
+        const Zone& z = zones[i];
+        if (z.count == 0) {
+            Logger::log(LogLevel::INFO, String(z.name) + ": 0");
+            continue;
+        }
+        Logger::log(LogLevel::INFO, String(z.name) + ": " + String(z.count) + " " +
+                    String(toMicros(z.minCycles), 1) + " " +
+                    String(toMicros(z.totalCycles / z.count), 1) + " " +
+                    String(toMicros(percentile(z, 99)), 1) + " " +
+                    String(toMicros(z.maxCycles), 1));
+    }
+}
+
+void Profiler::reset() {
+    for (uint8_t i = 0; i < zoneCount; i++) {
+        resetZone(zones[i]);
+    }
+}
+
+void Profiler::resetZone(Zone& zone) {
+    zone.count = 0;
+    zone.minCycles = UINT32_MAX;
+    zone.maxCycles = 0;
+    zone.totalCycles = 0;
+    memset(zone.histogram, 0, sizeof(zone.histogram));
+}
+
+void Profiler::addTelemetry(JsonObject data) {
+    for (uint8_t i = 0; i < zoneCount; i++) {
+        const Zone& z = zones[i];
+        if (z.count == 0) continue;
+        JsonObject zone = data[z.name].to<JsonObject>();
+        zone["count"] = z.count;
+        zone["avg"] = toMicros(z.totalCycles / z.count);
+        zone["p99"] = toMicros(percentile(z, 99));
+        zone["max"] = toMicros(z.maxCycles);
+    }
+}
+
+uint8_t Profiler::bucketFor(uint32_t cycles) {
+    if (cycles < (1u << SUB_BUCKET_BITS)) {
+        return cycles;
+    }
+    uint8_t exponent = 31 - __builtin_clz(cycles);
+    uint8_t subBucket = (cycles >> (exponent - SUB_BUCKET_BITS)) & ((1 << SUB_BUCKET_BITS) - 1);
+    return (exponent << SUB_BUCKET_BITS) + subBucket;
+}
+
+uint32_t Profiler::bucketUpperBound(uint8_t bucket) {
+    uint8_t exponent = bucket >> SUB_BUCKET_BITS;
+    if (exponent < SUB_BUCKET_BITS) {
+        return bucket;
+    }
+    uint32_t subBucket = bucket & ((1 << SUB_BUCKET_BITS) - 1);
+    uint64_t bound = ((1ull << SUB_BUCKET_BITS) + subBucket + 1) << (exponent - SUB_BUCKET_BITS);
+    return bound > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(bound - 1);
+}
+
+// Upper bound of the bucket holding the requested percentile, capped by the real maximum
+uint32_t Profiler::percentile(const Zone& zone, uint8_t percent) {
+    uint32_t target = (static_cast<uint64_t>(zone.count) * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        seen += zone.histogram[bucket];
+        if (seen >= target) {
+            uint32_t bound = bucketUpperBound(bucket);
+            return bound < zone.maxCycles ? bound : zone.maxCycles;
+        }
+    }
+    return zone.maxCycles;
+}
+
+float Profiler::toMicros(uint32_t cycles) {
+#if defined(ARM_DWT_CYCCNT)
+    return cycles / (F_CPU_ACTUAL / 1000000.0f);
+#else
+    return cycles;
+#endif
+}
+
+#endif // PROFILING_ENABLED
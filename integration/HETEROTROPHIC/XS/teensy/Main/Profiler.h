@@ -0,0 +1,100 @@
+// Profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Set to 0 to compile the profiler out: PROFILE_ZONE() then expands to nothing
+#ifndef PROFILING_ENABLED
+#define PROFILING_ENABLED 1
+#endif
+
+#if PROFILING_ENABLED
+
+/*
+ * Timing of named code zones with the ARM DWT cycle counter (micros() where it is not available).
+ * Usage, at the top of the block to measure:
+ *     PROFILE_ZONE("pid.update");
+ * Zones live in fixed-size static tables, nothing is allocated on the heap while measuring.
+ * The p99 comes from a log-scale histogram (4 sub-buckets per power of two, ~19% resolution).
+ */
+class Profiler {
+public:
+    static const uint8_t MAX_ZONES = 16;
+    static const uint8_t INVALID_ZONE = 0xFF;
+
+    /*
+     * Register a zone, called once per zone by PROFILE_ZONE().
+     * @param name: Must stay valid (string literal).
+     * @return: Zone id, INVALID_ZONE if the table is full.
+     */
+    static uint8_t registerZone(const char* name);
+    static void record(uint8_t zone, uint32_t cycles);
+
+    static inline uint32_t now() {
+#if defined(ARM_DWT_CYCCNT)
+        return ARM_DWT_CYCCNT;
+#else
+        return micros();
+#endif
+    }
+
+    // Log min/avg/p99/max of every zone (us)
+    static void logReport();
+    static void reset();
+
+    // Attach the zone statistics to the periodic telemetry frame
+    static void setTelemetryEnabled(bool enabled) { telemetryEnabled = enabled; }
+    static bool isTelemetryEnabled() { return telemetryEnabled; }
+    static void addTelemetry(JsonObject data);
+
+private:
+    // Bucket index = 4 * log2(cycles) + next two bits
+    static const uint8_t SUB_BUCKET_BITS = 2;
+    static const uint8_t BUCKET_COUNT = 32 << SUB_BUCKET_BITS;
+
+    struct Zone {
+        const char* name;
+        uint32_t count;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint64_t totalCycles;
+        uint32_t histogram[BUCKET_COUNT];
+    };
+
+    static Zone zones[MAX_ZONES];
+    static uint8_t zoneCount;
+    static bool telemetryEnabled;
+
+    static void resetZone(Zone& zone);
+    static uint8_t bucketFor(uint32_t cycles);
+    static uint32_t bucketUpperBound(uint8_t bucket);
+    static uint32_t percentile(const Zone& zone, uint8_t percent);
+    static float toMicros(uint32_t cycles);
+};
+
+// Records the time spent between its construction and the end of the enclosing scope
+class ProfileScope {
+public:
+    explicit ProfileScope(uint8_t zone) : _zone(zone), _start(Profiler::now()) {}
+    ~ProfileScope() { Profiler::record(_zone, Profiler::now() - _start); }
+
+private:
+    uint8_t _zone;
+    uint32_t _start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) \
+    static const uint8_t PROFILE_CONCAT(_profileZone, __LINE__) = Profiler::registerZone(name); \
+    ProfileScope PROFILE_CONCAT(_profileScope, __LINE__)(PROFILE_CONCAT(_profileZone, __LINE__))
+
+#else
+
+#define PROFILE_ZONE(name)
+
+#endif // PROFILING_ENABLED
+
+#endif // PROFILER_H
@@ -35,6 +35,9 @@ public:
 
     virtual void getParameters(JsonDocument& doc) const = 0;
 
+    // Continue the program interrupted by a reset, from its checkpoint. False if the program cannot resume
+    virtual bool resumeFromCheckpoint(const String& command) { return false; }
+
     // Virtual destructor
     virtual ~ProgramBase() {}
     
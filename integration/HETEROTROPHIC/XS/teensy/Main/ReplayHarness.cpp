@@ -0,0 +1,135 @@
+// ReplayHarness.cpp
+#include "ReplayHarness.h"
+#include "ActuatorController.h"
+#include "PlantSimulator.h"
+#include "ParameterStore.h"
+#include "SystemClock.h"
+#include "Logger.h"
+
+// Order of the values in a step, same as the backend CSV columns
+static const SensorId STEP_SENSORS[] = {
+    SensorId::WaterTemp, SensorId::AirTemp, SensorId::ElectronicTemp, SensorId::PH,
+    SensorId::Turbidity, SensorId::Oxygen, SensorId::AirFlow
+};
+static const int STEP_VALUE_COUNT = sizeof(STEP_SENSORS) / sizeof(STEP_SENSORS[0]);
+
+ReplayHarness::ReplayHarness(PIDManager& pidManager, SafetySystem& safetySystem, StateMachine& stateMachine)
+    : _pidManager(pidManager), _safetySystem(safetySystem), _stateMachine(stateMachine), _running(false),
+      _stepCount(0), _physicalSensors() {}
+
+bool ReplayHarness::start() {
+    if (_running) return true;
+    if (PlantSimulator::isRunning()) {
+        Logger::log(LogLevel::WARNING, F("Stop the plant simulation before starting a replay"));
+        return false;
+    }
+    if (_stateMachine.getCurrentProgram() != "None") {
+        Logger::log(LogLevel::WARNING, F("Stop the running program before starting a replay"));
+        return false;
+    }
+
+    ParameterStore::suspendWrites(true);
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        SensorId id = static_cast<SensorId>(i);
+        _physicalSensors[i] = SensorController::getSensor(id);
+        _sensors[i].attach(_physicalSensors[i]->getName());
+        _sensors[i].setValue(SensorController::readSensor(id));
+        SensorController::replaceSensor(id, &_sensors[i]);
+    }
+    SystemClock::startVirtual();
+    _stepCount = 0;
+    _running = true;
+    Logger::log(LogLevel::INFO, F("Replay started, waiting for steps"));
+    return true;
+}
+
+void ReplayHarness::stop() {
+    if (!_running) return;
+    // Programs started during the replay were fed recorded data
+    _stateMachine.stopAllPrograms();
+    _pidManager.stop();
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        SensorController::replaceSensor(static_cast<SensorId>(i), _physicalSensors[i]);
+    }
+    // Timed runs were started on virtual time
+    ActuatorController::stopAllActuators();
+    SystemClock::stopVirtual();
+    // Back to the setpoints and hysteresis saved before the replay
+    _pidManager.loadParameters();
+    ParameterStore::suspendWrites(false);
+    _running = false;
+    Logger::log(LogLevel::INFO, "Replay stopped after " + String(_stepCount) + " steps");
+}
+
+void ReplayHarness::setpoints(const String& args) {
+    if (!_running) {
+        Logger::log(LogLevel::WARNING, F("Replay not started"));
+        return;
+    }
+
+    const char* cursor = args.c_str();
+    char* end;
+    double values[3];
+    for (int i = 0; i < 3; i++) {
+        values[i] = strtod(cursor, &end);
+        if (end == cursor) {
+            Logger::log(LogLevel::ERROR, "Invalid replay setpoints: " + args);
+            return;
+        }
+        cursor = end;
+    }
+    _pidManager.startTemperaturePID(values[0]);
+    _pidManager.startPHPID(values[1]);
+    _pidManager.startDOPID(values[2]);
+}
+
+void ReplayHarness::step(const String& args) {
+    if (!_running) {
+        Logger::log(LogLevel::WARNING, F("Replay not started"));
+        return;
+    }
+
+    const char* cursor = args.c_str();
+    char* end;
+    unsigned long dt = strtoul(cursor, &end, 10);
+    if (end == cursor) {
+        Logger::log(LogLevel::ERROR, "Invalid replay step: " + args);
+        return;
+    }
+    float values[STEP_VALUE_COUNT];
+    for (int i = 0; i < STEP_VALUE_COUNT; i++) {
+        cursor = end;
+        values[i] = strtod(cursor, &end);
+        if (end == cursor) {
+            Logger::log(LogLevel::ERROR, "Invalid replay step: " + args);
+            return;
+        }
+    }
+
+    SystemClock::advance(dt);
+    for (int i = 0; i < STEP_VALUE_COUNT; i++) {
+        _sensors[static_cast<int>(STEP_SENSORS[i])].setValue(values[i]);
+    }
+    SensorController::updateAllSensors();
+    SensorController::takeSnapshot();
+
+    unsigned long start = micros();
+    _pidManager.updateAllPIDControllers();
+    _safetySystem.checkLimits();
+    ActuatorController::update();
+    unsigned long computeTime = micros() - start;
+
+    _stepCount++;
+    Serial.print(F("REPLAY:"));
+    Serial.print(_stepCount);
+    Serial.print(',');
+    Serial.print(SystemClock::now());
+    Serial.print(',');
+    Serial.print(computeTime);
+    for (int i = 0; i < static_cast<int>(ActuatorId::Count); i++) {
+        ActuatorId id = static_cast<ActuatorId>(i);
+        Serial.print(',');
+        Serial.print(ActuatorController::isActuatorRunning(id) ? ActuatorController::getCurrentValue(id) : 0);
+    }
+    Serial.println();
+}
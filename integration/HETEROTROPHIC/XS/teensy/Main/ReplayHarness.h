@@ -0,0 +1,70 @@
+// ReplayHarness.h
+#ifndef REPLAY_HARNESS_H
+#define REPLAY_HARNESS_H
+
+#include <Arduino.h>
+#include "SensorInterface.h"
+#include "SensorController.h"
+#include "PIDManager.h"
+#include "SafetySystem.h"
+#include "StateMachine.h"
+
+// Sensor returning the value of the current replay step
+class RecordedSensor : public SensorInterface {
+public:
+    RecordedSensor() : _name(""), _value(0) {}
+    void attach(const char* name) { _name = name; }
+    void setValue(float value) { _value = value; }
+
+    void begin() override {}
+    float readValue() override { return _value; }
+    const char* getName() const override { return _name; }
+
+private:
+    const char* _name;
+    float _value;
+};
+
+/*
+ * Feeds recorded sensor values (backend CSV, see teensy/tools/replay_csv.py) through the real PID and safety code.
+ * During a replay the sensors are replaced by RecordedSensor and SystemClock runs on virtual time:
+ * each step advances the clock by the recorded interval, updates the sensors, then runs PID, safety and
+ * the timed actuator runs, and prints one line:
+ *   REPLAY:<step>,<virtual ms>,<compute us>,<value of each actuator in ActuatorId order, 0 when stopped>
+ * No program runs during a replay: the recorded setpoints are applied to the PIDs directly, and the
+ * ParameterStore writes are suspended so that nothing of the replay survives a reset.
+ * stop() stops the PIDs and any program started meanwhile, and restores the saved PID parameters.
+ */
+class ReplayHarness {
+public:
+    ReplayHarness(PIDManager& pidManager, SafetySystem& safetySystem, StateMachine& stateMachine);
+
+    bool start();
+    void stop();
+    bool isRunning() const { return _running; }
+
+    /*
+     * Run one step.
+     * @param args: "<dt_ms> <waterTemp> <airTemp> <elecTemp> <pH> <turbidity> <oxygen> <airFlow>"
+     */
+    void step(const String& args);
+
+    /*
+     * Start the PIDs with the recorded setpoints.
+     * @param args: "<tempSetpoint> <pHSetpoint> <DOSetpoint>"
+     */
+    void setpoints(const String& args);
+
+private:
+    PIDManager& _pidManager;
+    SafetySystem& _safetySystem;
+    StateMachine& _stateMachine;
+    bool _running;
+    unsigned long _stepCount;
+
+    static const int SENSOR_COUNT = static_cast<int>(SensorId::Count);
+    RecordedSensor _sensors[SENSOR_COUNT];
+    SensorInterface* _physicalSensors[SENSOR_COUNT];
+};
+
+#endif // REPLAY_HARNESS_H
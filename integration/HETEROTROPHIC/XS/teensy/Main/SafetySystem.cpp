@@ -1,5 +1,6 @@
 // SafetySystem.cpp
 #include "SafetySystem.h"
+#include "SystemClock.h"
 #include "StateMachine.h"
 
 SafetySystem::SafetySystem(float totalVolume, float maxVolumePercent, float minVolume, StateMachine& stateMachine, VolumeManager& volumeManager, PIDManager& pidManager)
@@ -15,23 +16,26 @@ SafetySystem::SafetySystem(float totalVolume, float maxVolumePercent, float minV
       checkInterval(30000) {} // 30 seconds by default
 
 void SafetySystem::checkLimits() {
-    unsigned long currentTime = millis();
+    unsigned long currentTime = SystemClock::now();
     if (currentTime - lastCheckTime < checkInterval) {
         return; // Do not check if the interval has not elapsed
     }
     lastCheckTime = currentTime;
-    checkWaterTemperature();
-    checkAirTemperature();
-    checkElectronicTemperature();
-    checkPH();
-    checkDissolvedOxygen();
+
+    // All checks work on the same set of values
+    const SensorSnapshot& snapshot = SensorController::getSnapshot();
+    checkWaterTemperature(snapshot);
+    checkAirTemperature(snapshot);
+    checkElectronicTemperature(snapshot);
+    checkPH(snapshot);
+    checkDissolvedOxygen(snapshot);
     checkVolume();
-    checkTurbidity();
-    checkHeatingEffectiveness(); 
+    checkTurbidity(snapshot);
+    checkHeatingEffectiveness(snapshot);
 }
 
-void SafetySystem::checkWaterTemperature() {
-    float temp = SensorController::readSensor("waterTempSensor");
+void SafetySystem::checkWaterTemperature(const SensorSnapshot& snapshot) {
+    float temp = snapshot.waterTemp;
     if (temp < MIN_WATER_TEMP) logAlert("Water temperature low", LogLevel::WARNING);
     if (temp > MAX_WATER_TEMP) logAlert("Water temperature high", LogLevel::WARNING);
     if (temp > CRITICAL_WATER_TEMP) {
@@ -40,14 +44,14 @@ void SafetySystem::checkWaterTemperature() {
     }
 }
 
-void SafetySystem::checkAirTemperature() {
-    float temp = SensorController::readSensor("airTempSensor");
+void SafetySystem::checkAirTemperature(const SensorSnapshot& snapshot) {
+    float temp = snapshot.airTemp;
     if (temp < MIN_AIR_TEMP) logAlert("Air temperature low", LogLevel::WARNING);
     if (temp > MAX_AIR_TEMP) logAlert("Air temperature high", LogLevel::WARNING);
 }
 
-void SafetySystem::checkPH() {
-    float pH = SensorController::readSensor("phSensor");
+void SafetySystem::checkPH(const SensorSnapshot& snapshot) {
+    float pH = snapshot.pH;
     if (pH < MIN_PH) logAlert("pH low", LogLevel::WARNING);
     if (pH > MAX_PH) logAlert("pH high", LogLevel::WARNING);
     if (pH > CRITICAL_PH) {
@@ -56,8 +60,8 @@ void SafetySystem::checkPH() {
     }
 }
 
-void SafetySystem::checkDissolvedOxygen() {
-    float do_percent = SensorController::readSensor("oxygenSensor");
+void SafetySystem::checkDissolvedOxygen(const SensorSnapshot& snapshot) {
+    float do_percent = snapshot.oxygen;
     if (do_percent < MIN_DO) logAlert("Dissolved oxygen low", LogLevel::WARNING);
 }
 
@@ -73,15 +77,15 @@ void SafetySystem::checkVolume() {
     }
 }
 
-void SafetySystem::checkTurbidity() {
-    float turbidity = SensorController::readSensor("turbiditySensorSEN0554");
+void SafetySystem::checkTurbidity(const SensorSnapshot& snapshot) {
+    float turbidity = snapshot.turbidity;
     if (turbidity > MAX_TURBIDITY) {
         logAlert("Turbidity high", LogLevel::WARNING);
     }
 }
 
-void SafetySystem::checkElectronicTemperature() {
-    float temp = SensorController::readSensor("electronicTempSensor");
+void SafetySystem::checkElectronicTemperature(const SensorSnapshot& snapshot) {
+    float temp = snapshot.electronicTemp;
     if (temp > MAX_ELECTRONIC_TEMP) {
         logAlert("Electronic temperature critical", LogLevel::ERROR);
     } else if (temp > MAX_ELECTRONIC_TEMP - 10) {  // Warning at 5°C below the limit
@@ -110,10 +114,10 @@ void SafetySystem::parseCommand(const String& command) {
     }
 }
 
-void SafetySystem::checkHeatingEffectiveness() {
-    float currentTemp = SensorController::readSensor("waterTempSensor");
+void SafetySystem::checkHeatingEffectiveness(const SensorSnapshot& snapshot) {
+    float currentTemp = snapshot.waterTemp;
     
-    HeatingPlate* heatingPlate = (HeatingPlate*)ActuatorController::findActuatorByName("heatingPlate");
+    HeatingPlate* heatingPlate = (HeatingPlate*)ActuatorController::getActuator(ActuatorId::HeatingPlate);
     
     // If PID control is close to target temperature, no need to check
     if (pidManager.isTemperaturePIDRunning() && 
@@ -127,12 +131,12 @@ void SafetySystem::checkHeatingEffectiveness() {
         if (!heatingStatus.isMonitoring) {
             // Start new monitoring when heating plate lights up
             heatingStatus.isMonitoring = true;
-            heatingStatus.monitorStartTime = millis();
+            heatingStatus.monitorStartTime = SystemClock::now();
             heatingStatus.initialTemp = currentTemp;
             Logger::log(LogLevel::INFO, "Starting heating monitoring at temperature: " + String(currentTemp));
         }
 
-        unsigned long monitoringDuration = millis() - heatingStatus.monitorStartTime;
+        unsigned long monitoringDuration = SystemClock::now() - heatingStatus.monitorStartTime;
         if (monitoringDuration >= HeatingMonitoringStatus::MONITOR_DURATION) {
             float tempChange = currentTemp - heatingStatus.initialTemp;
             if (tempChange < HeatingMonitoringStatus::MIN_TEMP_INCREASE) {
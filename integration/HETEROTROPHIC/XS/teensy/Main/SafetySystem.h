@@ -40,14 +40,14 @@ private:
     unsigned long checkInterval;
     HeatingMonitoringStatus heatingStatus;
 
-    void checkWaterTemperature();
-    void checkAirTemperature();
-    void checkElectronicTemperature();
-    void checkPH();
-    void checkDissolvedOxygen();
+    void checkWaterTemperature(const SensorSnapshot& snapshot);
+    void checkAirTemperature(const SensorSnapshot& snapshot);
+    void checkElectronicTemperature(const SensorSnapshot& snapshot);
+    void checkPH(const SensorSnapshot& snapshot);
+    void checkDissolvedOxygen(const SensorSnapshot& snapshot);
     void checkVolume();
-    void checkTurbidity();
-    void checkHeatingEffectiveness();
+    void checkTurbidity(const SensorSnapshot& snapshot);
+    void checkHeatingEffectiveness(const SensorSnapshot& snapshot);
     void logAlert(const String& message, LogLevel level);
 
     // Safety thresholds
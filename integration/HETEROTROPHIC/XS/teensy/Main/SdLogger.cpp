@@ -0,0 +1,280 @@
+// SdLogger.cpp
+#include "SdLogger.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+DataCollector* SdLogger::_dataCollector = nullptr;
+bool SdLogger::enabled = false;
+File SdLogger::file;
+uint32_t SdLogger::fileIndex = 0;
+
+uint8_t SdLogger::buffer[SdLogger::BUFFER_SECTORS][SdLogger::SECTOR_SIZE];
+int SdLogger::writeSector = 0;
+int SdLogger::fillSector = 0;
+int SdLogger::fillCount = 0;
+int SdLogger::fullSectors = 0;
+uint16_t SdLogger::sequence = 0;
+unsigned long SdLogger::lastSync = 0;
+
+File SdLogger::dumpFile;
+uint32_t SdLogger::dumpSectors = 0;
+
+unsigned long SdLogger::samplesRecorded = 0;
+unsigned long SdLogger::samplesDropped = 0;
+unsigned long SdLogger::sectorsWritten = 0;
+unsigned long SdLogger::writeErrors = 0;
+unsigned long SdLogger::totalWriteTime = 0;
+unsigned long SdLogger::maxWriteTime = 0;
+unsigned long SdLogger::maxSyncTime = 0;
+unsigned long SdLogger::openFailures = 0;
+unsigned long SdLogger::lastOpenFailure = 0;
+
+bool SdLogger::begin(DataCollector& dataCollector) {
+    _dataCollector = &dataCollector;
+    if (!SD.begin(BUILTIN_SDCARD)) {
+        Logger::log(LogLevel::WARNING, F("No SD card, on-board data logging disabled"));
+        enabled = false;
+        return false;
+    }
+
+    // Continue the numbering of the files already on the card
+    fileIndex = 0;
+    while (fileIndex < 9999 && SD.exists(fileName(fileIndex + 1).c_str())) {
+        fileIndex++;
+    }
+    enabled = true;
+    Logger::log(LogLevel::INFO, "SD card logging ready, " + String(fileIndex) + " log files on the card");
+    return true;
+}
+
+void SdLogger::startFile(const String& programName, const String& command) {
+    if (!enabled) return;
+
+    // The last sector of the previous file is completed with samples that fail their CRC
+    if (fillCount > 0) {
+        memset(buffer[fillSector] + fillCount * sizeof(SampleRecord), 0xFF, SECTOR_SIZE - fillCount * sizeof(SampleRecord));
+        fillSector = (fillSector + 1) % BUFFER_SECTORS;
+        fillCount = 0;
+        fullSectors++;
+    }
+    while (enabled && file && fullSectors > 0) {
+        writeBufferedSector();
+    }
+    closeFile();
+    // Samples that could not be written belong to the previous file
+    writeSector = fillSector;
+    fullSectors = 0;
+    if (!enabled) return;
+
+    fileIndex++;
+    String name = fileName(fileIndex);
+    file = SD.open(name.c_str(), FILE_WRITE);
+    if (!file) {
+        openFailed(name);
+        return;
+    }
+
+    uint8_t sector[SECTOR_SIZE];
+    memset(sector, 0, sizeof(sector));
+    FileHeader* header = reinterpret_cast<FileHeader*>(sector);
+    memcpy(header->magic, "BRLG", 4);
+    header->version = FILE_VERSION;
+    header->recordSize = sizeof(SampleRecord);
+    header->fileIndex = fileIndex;
+    header->startTime = millis();
+    strncpy(header->programName, programName.c_str(), sizeof(header->programName) - 1);
+    strncpy(header->command, command.c_str(), sizeof(header->command) - 1);
+    if (file.write(sector, SECTOR_SIZE) != SECTOR_SIZE) {
+        writeErrors++;
+        closeFile();
+        SD.remove(name.c_str());
+        openFailed(name);
+        return;
+    }
+    file.flush();
+    lastSync = millis();
+    if (openFailures > 0) {
+        Logger::log(LogLevel::INFO, "SD log file " + name + " created after " + String(openFailures) + " failed attempts");
+        openFailures = 0;
+    }
+    Logger::log(LogLevel::INFO, "SD log file " + name + " started for " + programName);
+}
+
+void SdLogger::openFailed(const String& name) {
+    // The next attempt reuses the number
+    fileIndex--;
+    if (openFailures == 0) {
+        Logger::log(LogLevel::ERROR, "Cannot create " + name + " on the SD card, retrying every " +
+                    String(OPEN_RETRY_INTERVAL / 1000) + " s");
+    }
+    openFailures++;
+    lastOpenFailure = millis();
+}
+
+void SdLogger::recordSample(const String& currentProgram, int currentState) {
+    if (!enabled || !_dataCollector) return;
+    if (!file && (openFailures == 0 || millis() - lastOpenFailure >= OPEN_RETRY_INTERVAL)) {
+        startFile(currentProgram, "");
+    }
+
+    sequence++;
+    if (fullSectors == BUFFER_SECTORS) {
+        samplesDropped++;
+        return;
+    }
+
+    TelemetryProtocol::AllDataFrame frame;
+    _dataCollector->collectAllDataFrame(frame, currentProgram, currentState);
+
+    SampleRecord* record = reinterpret_cast<SampleRecord*>(buffer[fillSector]) + fillCount;
+    record->time = millis();
+    record->sequence = sequence;
+    record->programState = frame.programState;
+    record->reserved = 0;
+    record->waterTemp = frame.waterTemp;
+    record->airTemp = frame.airTemp;
+    record->elecTemp = frame.elecTemp;
+    record->pH = frame.pH;
+    record->turbidity = frame.turbidity;
+    record->oxygen = frame.oxygen;
+    record->airFlow = frame.airFlow;
+    record->actuatorRunning = frame.actuatorRunning;
+    memcpy(record->actuatorValues, frame.actuatorValues, sizeof(record->actuatorValues));
+    record->currentVolume = constrain(frame.currentVolume * 10000.0f, 0.0f, 65535.0f);
+    record->addedNaOH = constrain(frame.addedNaOH * 10000.0f, 0.0f, 65535.0f);
+    record->addedNutrient = constrain(frame.addedNutrient * 10000.0f, 0.0f, 65535.0f);
+    record->crc = TelemetryProtocol::crc16(reinterpret_cast<const uint8_t*>(record), offsetof(SampleRecord, crc));
+    samplesRecorded++;
+
+    if (++fillCount == SAMPLES_PER_SECTOR) {
+        fillSector = (fillSector + 1) % BUFFER_SECTORS;
+        fillCount = 0;
+        fullSectors++;
+    }
+}
+
+void SdLogger::service() {
+    if (!enabled) return;
+    PROFILE_ZONE("sdlog.service");
+
+    // One card operation per call
+    if (file && fullSectors > 0) {
+        writeBufferedSector();
+    } else if (file && millis() - lastSync >= SYNC_INTERVAL) {
+        unsigned long start = micros();
+        file.flush();
+        unsigned long duration = micros() - start;
+        if (duration > maxSyncTime) maxSyncTime = duration;
+        lastSync = millis();
+    } else if (dumpFile) {
+        dumpNextSector();
+    }
+}
+
+void SdLogger::listFiles() {
+    if (!enabled) {
+        Logger::log(LogLevel::WARNING, F("SD card logging disabled"));
+        return;
+    }
+    File root = SD.open("/");
+    int count = 0;
+    for (File entry = root.openNextFile(); entry; entry = root.openNextFile()) {
+        String name = entry.name();
+        if (name.startsWith("LOG") && name.endsWith(".BIN")) {
+            Logger::log(LogLevel::INFO, "  " + name + ": " + String(static_cast<unsigned long>(entry.size())) + " bytes");
+            count++;
+        }
+        entry.close();
+    }
+    root.close();
+    Logger::log(LogLevel::INFO, String(count) + " log files, current: " + (file ? fileName(fileIndex) : String("none")));
+}
+
+bool SdLogger::startDump(uint32_t index) {
+    if (!enabled) {
+        Logger::log(LogLevel::WARNING, F("SD card logging disabled"));
+        return false;
+    }
+    if (dumpFile) {
+        dumpFile.close();
+    }
+    String name = fileName(index);
+    dumpFile = SD.open(name.c_str(), FILE_READ);
+    if (!dumpFile) {
+        Logger::log(LogLevel::ERROR, "No log file " + name);
+        return false;
+    }
+    dumpSectors = 0;
+    Serial.print(F("DUMP:BEGIN "));
+    Serial.print(name);
+    Serial.print(' ');
+    Serial.println(static_cast<unsigned long>(dumpFile.size()));
+    return true;
+}
+
+void SdLogger::logStatistics() {
+    unsigned long averageWriteTime = sectorsWritten > 0 ? totalWriteTime / sectorsWritten : 0;
+    unsigned long throughput = totalWriteTime > 0 ? static_cast<unsigned long>(sectorsWritten * static_cast<float>(SECTOR_SIZE) * 1000.0f / totalWriteTime) : 0;
+    Logger::log(LogLevel::INFO, "SD logger: " + String(enabled ? "enabled" : "disabled") + ", file " +
+                (file ? fileName(fileIndex) : String("none")) + ", " + String(samplesRecorded) + " samples, " +
+                String(samplesDropped) + " dropped, " + String(fullSectors) + "/" + String(BUFFER_SECTORS) + " sectors buffered, " +
+                String(sectorsWritten) + " sectors written, " + String(writeErrors) + " write errors, " +
+                String(openFailures) + " failed file creations");
+    Logger::log(LogLevel::INFO, "SD logger timing: sector write avg " + String(averageWriteTime) + " us, max " +
+                String(maxWriteTime) + " us, sync max " + String(maxSyncTime) + " us, card throughput " +
+                String(throughput) + " kB/s");
+}
+
+void SdLogger::writeBufferedSector() {
+    unsigned long start = micros();
+    size_t written = file.write(buffer[writeSector], SECTOR_SIZE);
+    unsigned long duration = micros() - start;
+    totalWriteTime += duration;
+    if (duration > maxWriteTime) maxWriteTime = duration;
+
+    if (written != SECTOR_SIZE) {
+        // Card removed or full: keep running without it
+        writeErrors++;
+        Logger::log(LogLevel::ERROR, "SD card write failed, on-board data logging stopped (" + fileName(fileIndex) + ")");
+        closeFile();
+        enabled = false;
+        return;
+    }
+    sectorsWritten++;
+    writeSector = (writeSector + 1) % BUFFER_SECTORS;
+    fullSectors--;
+}
+
+void SdLogger::closeFile() {
+    if (file) {
+        file.close();
+    }
+}
+
+void SdLogger::dumpNextSector() {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    uint8_t sector[SECTOR_SIZE];
+    int length = dumpFile.read(sector, SECTOR_SIZE);
+    if (length <= 0) {
+        Serial.print(F("DUMP:END "));
+        Serial.println(dumpSectors);
+        dumpFile.close();
+        return;
+    }
+
+    char line[2 * SECTOR_SIZE];
+    for (int i = 0; i < length; i++) {
+        line[2 * i] = HEX_DIGITS[sector[i] >> 4];
+        line[2 * i + 1] = HEX_DIGITS[sector[i] & 0x0F];
+    }
+    Serial.print(F("DUMP:"));
+    Serial.write(line, 2 * length);
+    Serial.println();
+    dumpSectors++;
+}
+
+String SdLogger::fileName(uint32_t index) {
+    char name[18];                      // "LOG" + up to 10 digits + ".BIN"
+    snprintf(name, sizeof(name), "LOG%04lu.BIN", static_cast<unsigned long>(index));
+    return String(name);
+}
@@ -0,0 +1,116 @@
+// SdLogger.h
+#ifndef SD_LOGGER_H
+#define SD_LOGGER_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include "DataCollector.h"
+
+/*
+ * Time series of the periodic data on the built-in SD card of the Teensy 4.1, kept whatever the state of the
+ * ESP32/WiFi/backend path. Each program start opens a new file LOGnnnn.BIN:
+ *   sector 0: FileHeader (program name and command)
+ *   then fixed-size SampleRecords, SAMPLES_PER_SECTOR per 512-byte sector
+ * Samples are packed in a RAM buffer of BUFFER_SECTORS sectors. Only full sectors are written, one per call of
+ * service() from the scheduler idle time, so that the card always sees aligned single-sector writes.
+ * When the card is slower than the samples (or missing), new samples are dropped and counted.
+ * A file that cannot be created is tried again every OPEN_RETRY_INTERVAL, under the same number.
+ * A reset loses the samples still in RAM, at most BUFFER_SECTORS * SAMPLES_PER_SECTOR.
+ *
+ * "dump <n>" streams a file over the console, one sector per service() call, as "DUMP:" hex lines
+ * (see tools/sdlog_dump.py).
+ */
+class SdLogger {
+public:
+    static const uint8_t FILE_VERSION = 1;
+    static const int SECTOR_SIZE = 512;
+    static const int BUFFER_SECTORS = 8;
+
+    // Multi-byte values are little-endian, volumes in 0.1 ml
+    struct SampleRecord {
+        uint32_t time;                // millis()
+        uint16_t sequence;            // Incremented for every sample, dropped ones included
+        uint8_t programState;
+        uint8_t reserved;
+        float waterTemp;
+        float airTemp;
+        float elecTemp;
+        float pH;
+        float turbidity;
+        float oxygen;
+        float airFlow;
+        uint16_t actuatorRunning;     // Bit n set when actuator n (ActuatorId) is running
+        int16_t actuatorValues[TelemetryProtocol::ACTUATOR_COUNT];
+        uint16_t currentVolume;
+        uint16_t addedNaOH;
+        uint16_t addedNutrient;
+        uint16_t crc;                 // CRC-16/CCITT-FALSE of the bytes above, a sample never written fails it
+    };
+    static_assert(sizeof(SampleRecord) == 64, "SampleRecord must divide the sector size");
+    static const int SAMPLES_PER_SECTOR = SECTOR_SIZE / sizeof(SampleRecord);
+
+    struct FileHeader {
+        char magic[4];                // "BRLG"
+        uint8_t version;
+        uint8_t recordSize;
+        uint16_t reserved;
+        uint32_t fileIndex;
+        uint32_t startTime;           // millis() when the file was opened
+        char programName[16];
+        char command[128];
+    };
+
+    // Mount the card, false when there is none (the logger then stays disabled)
+    static bool begin(DataCollector& dataCollector);
+
+    // Write what is buffered to the current file and continue in a new one
+    static void startFile(const String& programName, const String& command);
+
+    // Add the current periodic data to the buffer
+    static void recordSample(const String& currentProgram, int currentState);
+
+    // Write one buffered sector, or send one sector of the file being dumped. Called when the main loop is idle
+    static void service();
+
+    static void listFiles();
+    static bool startDump(uint32_t fileIndex);
+    static void logStatistics();
+
+private:
+    static DataCollector* _dataCollector;
+    static bool enabled;
+    static File file;
+    static uint32_t fileIndex;
+
+    static uint8_t buffer[BUFFER_SECTORS][SECTOR_SIZE];
+    static int writeSector;           // Next full sector to write
+    static int fillSector;            // Sector being filled
+    static int fillCount;             // Samples in the sector being filled
+    static int fullSectors;
+    static uint16_t sequence;
+    static unsigned long lastSync;
+
+    static File dumpFile;
+    static uint32_t dumpSectors;
+
+    static unsigned long samplesRecorded;
+    static unsigned long samplesDropped;
+    static unsigned long sectorsWritten;
+    static unsigned long writeErrors;
+    static unsigned long totalWriteTime;  // us, sector writes
+    static unsigned long maxWriteTime;    // us
+    static unsigned long maxSyncTime;     // us
+    static unsigned long openFailures;    // Failed file creations in a row
+    static unsigned long lastOpenFailure; // millis()
+
+    static const unsigned long SYNC_INTERVAL = 60000; // Directory entry updated with the file size, ms
+    static const unsigned long OPEN_RETRY_INTERVAL = 60000; // Between two file creations after a failure, ms
+
+    static void writeBufferedSector();
+    static void closeFile();
+    static void openFailed(const String& name);
+    static void dumpNextSector();
+    static String fileName(uint32_t index);
+};
+
+#endif // SD_LOGGER_H
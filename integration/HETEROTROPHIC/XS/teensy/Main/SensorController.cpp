@@ -10,6 +10,14 @@ PHSensor* SensorController::phSensor = nullptr;
 OxygenSensor* SensorController::oxygenSensor = nullptr;
 AirFlowSensor* SensorController::airFlowSensor = nullptr;
 TurbiditySensorSEN0554* SensorController::turbiditySensorSEN0554 = nullptr;
+SensorController::AcquisitionSlot SensorController::slots[SensorController::SENSOR_COUNT];
+SensorSnapshot SensorController::snapshot = {};
+unsigned long SensorController::physicalReadCount = 0;
+unsigned long SensorController::snapshotReadCount = 0;
+unsigned long SensorController::directReadCount = 0;
+unsigned long SensorController::statisticsStart = 0;
+bool SensorController::sampleInProgress = false;
+unsigned long SensorController::sampleStart = 0;
 
 // Initialize method
 void SensorController::initialize(PT100Sensor& waterTemp, DS18B20TemperatureSensor& airTemp, DS18B20TemperatureSensor& electronicTemp,
@@ -25,6 +33,27 @@ void SensorController::initialize(PT100Sensor& waterTemp, DS18B20TemperatureSens
     oxygenSensor = &oxygen;
     airFlowSensor = &airFlow;
     turbiditySensorSEN0554 = &turbiditySEN0554;
+
+    // Register every sensor in the acquisition engine
+    setupSlot(SensorId::WaterTemp, waterTempSensor, BUS_PT100, WATER_TEMP_INTERVAL);
+    setupSlot(SensorId::AirTemp, airTempSensor, BUS_AIR_TEMP, AIR_TEMP_INTERVAL);
+    setupSlot(SensorId::ElectronicTemp, electronicTempSensor, BUS_ELECTRONIC_TEMP, ELECTRONIC_TEMP_INTERVAL);
+    setupSlot(SensorId::PH, phSensor, BUS_PH, TRANSMITTER_INTERVAL);
+    setupSlot(SensorId::Oxygen, oxygenSensor, BUS_OXYGEN, TRANSMITTER_INTERVAL);
+    setupSlot(SensorId::AirFlow, airFlowSensor, BUS_AIR_FLOW, AIR_FLOW_INTERVAL);
+    setupSlot(SensorId::Turbidity, turbiditySensorSEN0554, BUS_TURBIDITY, TURBIDITY_INTERVAL);
+}
+
+void SensorController::setupSlot(SensorId id, SensorInterface* sensor, uint8_t bus, unsigned long interval) {
+    AcquisitionSlot& slot = slotFor(id);
+    slot.sensor = sensor;
+    slot.bus = bus;
+    slot.interval = interval;
+    slot.inProgress = false;
+    slot.lastStart = 0;
+    slot.value = 0.0f;
+    slot.timestamp = 0;
+    slot.hasValue = false;
 }
 
 void SensorController::beginAll() {
@@ -35,44 +64,177 @@ void SensorController::beginAll() {
     oxygenSensor->begin();
     airFlowSensor->begin();
     turbiditySensorSEN0554->begin();
+
+    // Fill the cache so that consumers never see a sensor without value
+    updateAllSensors();
+    takeSnapshot();
+}
+
+float SensorController::readSensor(SensorId id) {
+    AcquisitionSlot& slot = slotFor(id);
+    directReadCount++;
+    if (!slot.hasValue && !slot.inProgress) {
+        // Nothing acquired yet (right after boot): fall back to a direct read
+        publish(slot, slot.sensor->readValue());
+    }
+    //Logger::log(LogLevel::INFO, "Read sensor " + String(slot.sensor->getName()) + ": " + String(slot.value));
+    return slot.value;
 }
 
 float SensorController::readSensor(const String& sensorName) {
-    SensorInterface* sensor = findSensorByName(sensorName);
-    if (sensor) {
-        float value = sensor->readValue();
-        //Logger::log(LogLevel::INFO, "Read sensor " + sensorName + ": " + String(value));
-        return value;
+    SensorId id;
+    if (findSensorId(sensorName, id)) {
+        return readSensor(id);
     }
     Logger::log(LogLevel::WARNING, "Sensor not found: " + sensorName);
     return 0.0f;
 }
 
+unsigned long SensorController::getLastUpdateTime(SensorId id) {
+    const AcquisitionSlot& slot = slotFor(id);
+    return slot.hasValue ? slot.timestamp : 0;
+}
+
+unsigned long SensorController::getLastUpdateTime(const String& sensorName) {
+    SensorId id;
+    return findSensorId(sensorName, id) ? getLastUpdateTime(id) : 0;
+}
+
+void SensorController::update() {
+    unsigned long currentTime = millis();
+    updateSample(currentTime);
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        AcquisitionSlot& slot = slots[i];
+        if (sampleInProgress && i == static_cast<int>(SensorId::Turbidity) && !slot.inProgress) {
+            continue; // The sample is still flowing or settling
+        }
+        if (slot.inProgress) {
+            float value;
+            if (slot.sensor->pollReading(value)) {
+                slot.inProgress = false;
+                publish(slot, value);
+            }
+        } else if (currentTime - slot.lastStart >= slot.interval && !isBusBusy(slot.bus)) {
+            prepareCompensation(slot);
+            slot.lastStart = currentTime;
+            slot.inProgress = slot.sensor->startReading();
+        }
+    }
+}
+
 void SensorController::updateAllSensors() {
-    readSensor(waterTempSensor->getName());
-    readSensor(airTempSensor->getName());
-    readSensor(electronicTempSensor->getName());
-    readSensor(phSensor->getName());
-    readSensor(oxygenSensor->getName());
-    readSensor(airFlowSensor->getName());
-    readSensor(turbiditySensorSEN0554->getName());
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        AcquisitionSlot& slot = slots[i];
+        if (slot.inProgress) {
+            continue; // Let the engine finish the measurement in progress
+        }
+        prepareCompensation(slot);
+        publish(slot, slot.sensor->readValue());
+    }
+}
+
+const SensorSnapshot& SensorController::takeSnapshot() {
+    snapshot.sequence++;
+    snapshot.timestamp = millis();
+    snapshot.oldestSampleTime = snapshot.timestamp;
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        if (slots[i].timestamp < snapshot.oldestSampleTime) {
+            snapshot.oldestSampleTime = slots[i].timestamp;
+        }
+    }
+
+    snapshot.waterTemp = slotFor(SensorId::WaterTemp).value;
+    snapshot.airTemp = slotFor(SensorId::AirTemp).value;
+    snapshot.electronicTemp = slotFor(SensorId::ElectronicTemp).value;
+    snapshot.pH = slotFor(SensorId::PH).value;
+    snapshot.oxygen = slotFor(SensorId::Oxygen).value;
+    snapshot.airFlow = slotFor(SensorId::AirFlow).value;
+    snapshot.turbidity = slotFor(SensorId::Turbidity).value;
+    return snapshot;
+}
+
+const SensorSnapshot& SensorController::getSnapshot() {
+    snapshotReadCount++;
+    return snapshot;
+}
+
+void SensorController::logReadStatistics() {
+    unsigned long elapsed = millis() - statisticsStart;
+    Logger::log(LogLevel::INFO, "Sensor reads over the last " + String(elapsed / 1000) + " s: " +
+                String(physicalReadCount) + " physical, " +
+                String(snapshotReadCount) + " snapshot passes (" + String(snapshotReadCount * SENSOR_COUNT) + " values), " +
+                String(directReadCount) + " direct, snapshot #" + String(snapshot.sequence));
+    physicalReadCount = 0;
+    snapshotReadCount = 0;
+    directReadCount = 0;
+    statisticsStart = millis();
+}
+
+bool SensorController::isBusBusy(uint8_t bus) {
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        if (slots[i].bus == bus && slots[i].inProgress) return true;
+    }
+    return false;
+}
+
+void SensorController::publish(AcquisitionSlot& slot, float value) {
+    slot.value = value;
+    slot.timestamp = millis();
+    slot.hasValue = true;
+    physicalReadCount++;
+}
+
+// pH and O2 are compensated with the cached water temperature instead of a new PT100 read
+void SensorController::prepareCompensation(AcquisitionSlot& slot) {
+    const AcquisitionSlot& waterTemp = slotFor(SensorId::WaterTemp);
+    if (!waterTemp.hasValue) return;
+    if (slot.sensor == phSensor) {
+        phSensor->setCompensationTemperature(waterTemp.value);
+    } else if (slot.sensor == oxygenSensor) {
+        oxygenSensor->setCompensationTemperature(waterTemp.value);
+    }
+}
+
+SensorInterface* SensorController::getSensor(SensorId id) {
+    return slotFor(id).sensor;
+}
+
+void SensorController::replaceSensor(SensorId id, SensorInterface* sensor) {
+    AcquisitionSlot& slot = slotFor(id);
+    slot.sensor = sensor;
+    slot.inProgress = false;
 }
 
 SensorInterface* SensorController::findSensorByName(const String& name) {
-    if (name == waterTempSensor->getName()) return waterTempSensor;
-    if (name == airTempSensor->getName()) return airTempSensor;
-    if (name == electronicTempSensor->getName()) return electronicTempSensor;
-    if (name == phSensor->getName()) return phSensor;
-    if (name == oxygenSensor->getName()) return oxygenSensor;
-    if (name == airFlowSensor->getName()) return airFlowSensor;
-    if (name == turbiditySensorSEN0554->getName()) return turbiditySensorSEN0554;
-    return nullptr;
+    SensorId id;
+    return findSensorId(name, id) ? getSensor(id) : nullptr;
+}
+
+bool SensorController::findSensorId(const String& name, SensorId& id) {
+    for (int i = 0; i < SENSOR_COUNT; i++) {
+        if (name == slots[i].sensor->getName()) {
+            id = static_cast<SensorId>(i);
+            return true;
+        }
+    }
+    return false;
 }
 
 void SensorController::takeSample() {
-    // Start the sample pump
-    ActuatorController::runActuator("samplePump", 100, PUMP_RUNTIME);
-    // Wait until the sample is stable
-    delay(STABILIZATION_TIME);
+    // Start the sample pump, stopped by ActuatorController::update() while measurements go on
+    ActuatorController::runActuator(ActuatorId::SamplePump, 100, PUMP_RUNTIME);
+    sampleInProgress = true;
+    sampleStart = millis();
+}
+
+// Once the pump has stopped and the sample has settled, the turbidity is measured on the fresh sample
+void SensorController::updateSample(unsigned long currentTime) {
+    if (!sampleInProgress || currentTime - sampleStart < PUMP_RUNTIME + STABILIZATION_TIME) {
+        return;
+    }
+    sampleInProgress = false;
+    AcquisitionSlot& slot = slotFor(SensorId::Turbidity);
+    slot.lastStart = currentTime - slot.interval;
+    Logger::log(LogLevel::INFO, F("Fresh sample stabilized"));
 }
 
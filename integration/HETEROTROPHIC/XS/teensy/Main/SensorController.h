@@ -9,6 +9,32 @@
 #include "AirFlowSensor.h"
 #include "TurbiditySensorSEN0554.h"
 
+// Typed handles of the sensors, used as direct index into the controller tables
+enum class SensorId : uint8_t {
+    WaterTemp,
+    AirTemp,
+    ElectronicTemp,
+    PH,
+    Oxygen,
+    AirFlow,
+    Turbidity,
+    Count
+};
+
+// Consistent set of sensor values shared by PID, safety and telemetry during one loop cycle
+struct SensorSnapshot {
+    uint32_t sequence;        // Incremented every time a snapshot is taken (0 = none yet)
+    unsigned long timestamp;  // millis() at which the snapshot was taken
+    unsigned long oldestSampleTime; // Acquisition time of the oldest value in the snapshot
+    float waterTemp;
+    float airTemp;
+    float electronicTemp;
+    float pH;
+    float oxygen;
+    float airFlow;
+    float turbidity;
+};
+
 class SensorController {
 public:
     static void initialize(PT100Sensor& waterTemp, DS18B20TemperatureSensor& airTemp, DS18B20TemperatureSensor& electronicTempSensor,
@@ -17,12 +43,32 @@ public:
                            AirFlowSensor& airFlow, 
                            TurbiditySensorSEN0554& turbiditySEN0554);
     
+    // Returns the latest value published by the acquisition engine (no bus access)
+    static float readSensor(SensorId id);
     static float readSensor(const String& sensorName);
+    // Time (millis) at which the value returned by readSensor() was acquired, 0 if never
+    static unsigned long getLastUpdateTime(SensorId id);
+    static unsigned long getLastUpdateTime(const String& sensorName);
+    // Non-blocking acquisition engine: starts and polls sensor measurements, call on every loop
+    static void update();
+    // Blocking refresh of every sensor value
     static void updateAllSensors();
+    // Copy the latest values into the shared snapshot, call once per loop cycle after update()
+    static const SensorSnapshot& takeSnapshot();
+    // Snapshot of the current loop cycle
+    static const SensorSnapshot& getSnapshot();
+    // Log the number of physical sensor reads and consumer reads since the last call
+    static void logReadStatistics();
     static void beginAll();
     
+    static SensorInterface* getSensor(SensorId id);
+    // Swap the sensor behind a handle (plant simulation), any measurement in progress is dropped
+    static void replaceSensor(SensorId id, SensorInterface* sensor);
+    // Name based lookup kept for the serial commands, resolves the name to its SensorId
     static SensorInterface* findSensorByName(const String& name);
+    static bool findSensorId(const String& name, SensorId& id);
 
+    // Starts a sample cycle: sample pump run, then STABILIZATION_TIME before the turbidity is measured again
     static void takeSample();
 
 private:
@@ -35,8 +81,58 @@ private:
     static TurbiditySensorSEN0554* turbiditySensorSEN0554;
 
     static const unsigned long PUMP_RUNTIME = 10000; // 10 seconds to prime the pump
-    static const unsigned long STABILIZATION_TIME = 1500; // 1 seconds to stabilise the sample
+    static const unsigned long STABILIZATION_TIME = 1500; // 1.5 seconds to stabilise the sample
+
+    // Sample cycle started by takeSample(), advanced by update()
+    static bool sampleInProgress;
+    static unsigned long sampleStart;
+
+    // Sensors sharing a bus are never measured at the same time
+    enum SensorBus : uint8_t {
+        BUS_PT100,
+        BUS_AIR_TEMP,
+        BUS_ELECTRONIC_TEMP,
+        BUS_PH,             // pH and O2 share the multiplexed link to the Arduino Uno:
+        BUS_OXYGEN,         // started together, they are served by a single READ_ALL transaction
+        BUS_AIR_FLOW,
+        BUS_TURBIDITY
+    };
+
+    struct AcquisitionSlot {
+        SensorInterface* sensor;
+        uint8_t bus;
+        unsigned long interval;   // Minimum time between two measurement starts (ms)
+        bool inProgress;          // A measurement has been started and is being polled
+        unsigned long lastStart;
+        float value;              // Last published value
+        unsigned long timestamp;  // millis() at which value was published
+        bool hasValue;
+    };
+
+    static const int SENSOR_COUNT = static_cast<int>(SensorId::Count);
+    static AcquisitionSlot slots[SENSOR_COUNT];
+    static SensorSnapshot snapshot;
+
+    // Read statistics, reset by logReadStatistics()
+    static unsigned long physicalReadCount;  // Measurements completed on a sensor bus
+    static unsigned long snapshotReadCount;  // Consumer passes served from the snapshot
+    static unsigned long directReadCount;    // Consumer reads through readSensor()
+    static unsigned long statisticsStart;
+
+    // Refresh intervals of the acquisition engine (ms)
+    static const unsigned long WATER_TEMP_INTERVAL = 2000;   // PT100 conversion takes ~75 ms, polled
+    static const unsigned long AIR_TEMP_INTERVAL = 5000;
+    static const unsigned long ELECTRONIC_TEMP_INTERVAL = 10000;
+    static const unsigned long TRANSMITTER_INTERVAL = 5000;  // pH and O2
+    static const unsigned long AIR_FLOW_INTERVAL = 1000;
+    static const unsigned long TURBIDITY_INTERVAL = 5000;
 
+    static AcquisitionSlot& slotFor(SensorId id) { return slots[static_cast<int>(id)]; }
+    static void setupSlot(SensorId id, SensorInterface* sensor, uint8_t bus, unsigned long interval);
+    static bool isBusBusy(uint8_t bus);
+    static void publish(AcquisitionSlot& slot, float value);
+    static void prepareCompensation(AcquisitionSlot& slot);
+    static void updateSample(unsigned long currentTime);
 
 };
 
@@ -22,6 +22,24 @@ public:
      */
     virtual float readValue() = 0;
 
+    /*
+     * Virtual function to start a non-blocking measurement.
+     * Sensors that answer instantly keep this default implementation.
+     * @return: true if a measurement has been started.
+     */
+    virtual bool startReading() { return true; }
+
+    /*
+     * Virtual function to poll a measurement started with startReading().
+     * Must never wait on the bus: it returns false while the measurement is in progress.
+     * @param value: Receives the measured value once the measurement is complete.
+     * @return: true when the measurement is complete and value has been written.
+     */
+    virtual bool pollReading(float& value) {
+        value = readValue();
+        return true;
+    }
+
     /*
      * Virtual function to get the name of the sensor.
      * @return: Constant character pointer to the name of the sensor.
@@ -0,0 +1,137 @@
+// SensorTransmitterLink.cpp
+#include "SensorTransmitterLink.h"
+#include "Logger.h"
+
+SensorTransmitterLink::SensorTransmitterLink(HardwareSerial* serial)
+    : _serial(serial), _reader(*serial), _nextTag(1),
+      _readingTag(0), _readingSentTime(0), _completedTag(0), _completedTime(0), _pH(-1), _oxygen(-1),
+      _commandTag(0), _commandAnswered(false),
+      _transactionCount(0), _joinedCount(0), _timeoutCount(0), _unmatchedCount(0) {}
+
+uint16_t SensorTransmitterLink::requestReading(float temperature) {
+    poll();
+    checkReadingTimeout();
+    if (_readingTag != 0) {
+        _joinedCount++;
+        return _readingTag;
+    }
+    _readingTag = sendTagged("READ_ALL:" + String(temperature, 2));
+    _readingSentTime = millis();
+    return _readingTag;
+}
+
+void SensorTransmitterLink::poll() {
+    while (_reader.tryReadLine()) {
+        handleLine(_reader.line());
+    }
+}
+
+SensorTransmitterLink::ReadingStatus SensorTransmitterLink::getReadingStatus(uint16_t readingId) {
+    checkReadingTimeout();
+    if (readingId == _readingTag) {
+        return ReadingStatus::PENDING;
+    }
+    return (readingId == _completedTag) ? ReadingStatus::READY : ReadingStatus::FAILED;
+}
+
+bool SensorTransmitterLink::readAll(float temperature) {
+    poll();
+    if (_completedTag != 0 && _readingTag == 0 && millis() - _completedTime < FRESH_READING_AGE) {
+        _joinedCount++;
+        return true;
+    }
+
+    uint16_t readingId = requestReading(temperature);
+    ReadingStatus status;
+    while ((status = getReadingStatus(readingId)) == ReadingStatus::PENDING) {
+        poll();
+        yield();
+    }
+    return status == ReadingStatus::READY;
+}
+
+String SensorTransmitterLink::sendCommand(const String& command) {
+    _commandAnswered = false;
+    _commandTag = sendTagged(command);
+    unsigned long startTime = millis();
+    while (!_commandAnswered) {
+        if (millis() - startTime > RESPONSE_TIMEOUT) {
+            _commandTag = 0;
+            _timeoutCount++;
+            return "ERROR:TIMEOUT";
+        }
+        poll();
+        checkReadingTimeout();
+        yield();
+    }
+    _commandTag = 0;
+    return _commandResponse;
+}
+
+void SensorTransmitterLink::logStatistics() {
+    Logger::log(LogLevel::INFO, "Transmitter link: " + String(_transactionCount) + " transactions, " +
+                String(_joinedCount) + " joined readings, " + String(_timeoutCount) + " timeouts, " +
+                String(_unmatchedCount) + " unmatched answers, " + String(_reader.droppedLines()) + " dropped lines");
+    _transactionCount = 0;
+    _joinedCount = 0;
+    _timeoutCount = 0;
+    _unmatchedCount = 0;
+}
+
+uint16_t SensorTransmitterLink::sendTagged(const String& command) {
+    uint16_t tag = _nextTag;
+    _nextTag = (_nextTag >= 9999) ? 1 : _nextTag + 1; // Tag 0 means "no request"
+    _serial->println("#" + String(tag) + ":" + command);
+    _transactionCount++;
+    return tag;
+}
+
+// Answers look like "#<tag>:<response>"
+void SensorTransmitterLink::handleLine(const char* line) {
+    if (line[0] != '#') {
+        _unmatchedCount++;
+        return;
+    }
+    char* end;
+    uint16_t tag = strtoul(line + 1, &end, 10);
+    if (*end != ':' || tag == 0) {
+        _unmatchedCount++;
+        return;
+    }
+    const char* response = end + 1;
+
+    if (tag == _readingTag) {
+        _readingTag = 0;
+        char* pHEnd = nullptr;
+        char* oxygenEnd = nullptr;
+        float pH = 0, oxygen = 0;
+        if (strncmp(response, "ALL:", 4) == 0) {
+            pH = strtod(response + 4, &pHEnd);
+            if (*pHEnd == ':') {
+                oxygen = strtod(pHEnd + 1, &oxygenEnd);
+            }
+        }
+        if (oxygenEnd != nullptr && oxygenEnd != pHEnd + 1) {
+            _pH = pH;
+            _oxygen = oxygen;
+            _completedTag = tag;
+            _completedTime = millis();
+        } else {
+            Logger::log(LogLevel::ERROR, "Invalid transmitter reading: " + String(response));
+        }
+    } else if (tag == _commandTag) {
+        _commandResponse = response;
+        _commandResponse.trim();
+        _commandAnswered = true;
+    } else {
+        _unmatchedCount++; // Late answer to a request that already timed out
+    }
+}
+
+void SensorTransmitterLink::checkReadingTimeout() {
+    if (_readingTag != 0 && millis() - _readingSentTime > RESPONSE_TIMEOUT) {
+        Logger::log(LogLevel::ERROR, F("Timeout waiting for pH/O2 transmitter response"));
+        _readingTag = 0;
+        _timeoutCount++;
+    }
+}
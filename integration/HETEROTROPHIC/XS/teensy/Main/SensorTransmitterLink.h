@@ -0,0 +1,90 @@
+// SensorTransmitterLink.h
+#ifndef SENSOR_TRANSMITTER_LINK_H
+#define SENSOR_TRANSMITTER_LINK_H
+
+#include <Arduino.h>
+#include "SerialLineReader.h"
+
+/*
+ * Request/response multiplexer on the serial link to the pH & O2 transmitter (Arduino Uno).
+ * Every request carries a tag echoed by the transmitter: "#<tag>:<command>" -> "#<tag>:<response>",
+ * so a late answer to a timed out request can never be taken for the answer to another one.
+ * A single "READ_ALL:<temp>" transaction returns both pH and O2 ("ALL:<pH>:<O2>"):
+ * the pH and O2 sensors join the same reading instead of each sending its own request.
+ */
+class SensorTransmitterLink {
+public:
+    enum class ReadingStatus {
+        PENDING,
+        READY,
+        FAILED
+    };
+
+    SensorTransmitterLink(HardwareSerial* serial);
+
+    /*
+     * Start a READ_ALL transaction, or join the one already in progress.
+     * @return: Id of the reading to pass to getReadingStatus().
+     */
+    uint16_t requestReading(float temperature);
+
+    /*
+     * Process the answers already received, without waiting.
+     */
+    void poll();
+
+    ReadingStatus getReadingStatus(uint16_t readingId);
+
+    /*
+     * Blocking reading, used outside of the acquisition engine.
+     * A reading completed less than FRESH_READING_AGE ago is returned without a new transaction.
+     * @return: false on timeout or invalid answer.
+     */
+    bool readAll(float temperature);
+
+    // Values of the last completed reading
+    float getPH() const { return _pH; }
+    float getOxygen() const { return _oxygen; }
+
+    /*
+     * Blocking tagged command (calibration), readings received meanwhile are still processed.
+     * @return: Answer without its tag, "ERROR:TIMEOUT" if none arrived in time.
+     */
+    String sendCommand(const String& command);
+
+    void logStatistics();
+
+private:
+    HardwareSerial* _serial;
+    SerialLineReader<48> _reader;
+    uint16_t _nextTag;
+
+    // READ_ALL transaction in progress (tag 0 = none)
+    uint16_t _readingTag;
+    unsigned long _readingSentTime;
+    // Last completed READ_ALL
+    uint16_t _completedTag;
+    unsigned long _completedTime;
+    float _pH;
+    float _oxygen;
+
+    // Blocking command in progress (tag 0 = none)
+    uint16_t _commandTag;
+    bool _commandAnswered;
+    String _commandResponse;
+
+    // Statistics, reset by logStatistics()
+    unsigned long _transactionCount;
+    unsigned long _joinedCount;
+    unsigned long _timeoutCount;
+    unsigned long _unmatchedCount;
+
+    static const unsigned long RESPONSE_TIMEOUT = 5000;   // Time allowed for the transmitter to answer (ms)
+    static const unsigned long FRESH_READING_AGE = 1000;  // Age under which readAll() reuses the last reading (ms)
+
+    uint16_t sendTagged(const String& command);
+    void handleLine(const char* line);
+    void checkReadingTimeout();
+};
+
+#endif // SENSOR_TRANSMITTER_LINK_H
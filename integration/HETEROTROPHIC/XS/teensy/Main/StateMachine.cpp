@@ -1,5 +1,7 @@
 // StateMachine.cpp
 #include "StateMachine.h"
+#include "ParameterStore.h"
+#include "SdLogger.h"
 
 
 StateMachine::StateMachine(PIDManager& pidManager, VolumeManager& volumeManager, Communication& espCommunication)
@@ -34,11 +36,18 @@ void StateMachine::update() {
 
 void StateMachine::startProgram(const String& programName, const String& command) {
     ProgramBase** program = programs.find(programName);
-    if (program) {
+    if (program && command.length() >= sizeof(ProgramRecord::command)) {
+        // A truncated command could not restart the program after a reset
+        Logger::log(LogLevel::ERROR, "Command too long (" + String(command.length()) + " characters, " +
+                    String(sizeof(ProgramRecord::command) - 1) + " max), program not started: " + programName);
+    } else if (program) {
         //stopProgram();
         currentProgram = *program;
+        currentCommand = command;
+        SdLogger::startFile(programName, command);
         currentProgram->start(command);
         transitionToState(ProgramState::RUNNING);
+        saveProgramState();
         
         // log and send the data
         Logger::logProgramEvent(programName, currentProgram);
@@ -95,6 +104,44 @@ void StateMachine::transitionToState(ProgramState newState) {
     if (newState != currentState) {
         currentState = newState;
         Logger::log(LogLevel::INFO, "State changed to: " + String(static_cast<int>(currentState)));
+        saveProgramState();
     }
 }
 
+void StateMachine::saveProgramState() {
+    ProgramRecord record;
+    memset(&record, 0, sizeof(record));
+    record.state = static_cast<uint8_t>(currentState);
+    strncpy(record.name, getCurrentProgram().c_str(), sizeof(record.name) - 1);
+    if (currentProgram) {
+        strncpy(record.command, currentCommand.c_str(), sizeof(record.command) - 1);
+    }
+    ParameterStore::queue(record);
+}
+
+bool StateMachine::restoreProgramState() {
+    ProgramRecord record;
+    if (!ParameterStore::load(record)) {
+        return false;
+    }
+    ProgramState state = static_cast<ProgramState>(record.state);
+    bool interrupted = (state == ProgramState::RUNNING || state == ProgramState::PAUSED) && strcmp(record.name, "None") != 0;
+    if (!interrupted) {
+        return false;
+    }
+    Logger::log(LogLevel::WARNING, "Program interrupted by a reset: " + String(record.name) + " (" + String(record.command) + ")");
+
+    ProgramBase** program = programs.find(String(record.name));
+    if (!program || !(*program)->resumeFromCheckpoint(record.command)) {
+        Logger::log(LogLevel::WARNING, "Program not resumed: " + String(record.name));
+        transitionToState(ProgramState::STOPPED);
+        return false;
+    }
+    currentProgram = *program;
+    currentCommand = record.command;
+    SdLogger::startFile(currentProgram->getName(), currentCommand);
+    transitionToState(currentProgram->isPaused() ? ProgramState::PAUSED : ProgramState::RUNNING);
+    Logger::log(LogLevel::INFO, "Resumed program: " + String(record.name));
+    return true;
+}
+
@@ -30,6 +30,9 @@ public:
     ProgramState getCurrentState() const;
     String getCurrentProgram() const;
 
+    // Resume the program that was running or paused at the last reset from its checkpoint, true if resumed
+    bool restoreProgramState();
+
 private:
     static const int MAX_PROGRAMS = 10;
     SimpleMap<String, ProgramBase*, MAX_PROGRAMS> programs;
@@ -39,7 +42,10 @@ private:
     VolumeManager& volumeManager;
     Communication& espCommunication;
 
+    String currentCommand;
+
     void transitionToState(ProgramState newState);
+    void saveProgramState();
 };
 
 #endif // STATE_MACHINE_H
\ No newline at end of file
@@ -0,0 +1,5 @@
+// SystemClock.cpp
+#include "SystemClock.h"
+
+bool SystemClock::virtualTime = false;
+unsigned long SystemClock::virtualMillis = 0;
@@ -0,0 +1,31 @@
+// SystemClock.h
+#ifndef SYSTEM_CLOCK_H
+#define SYSTEM_CLOCK_H
+
+#include <Arduino.h>
+
+/*
+ * Time base of the control code (PID, safety, timed actuator runs).
+ * Follows millis(), except during a replay where it only moves when advance() is called,
+ * so that recorded data can be fed faster than real time with the original timing.
+ */
+class SystemClock {
+public:
+    static unsigned long now() { return virtualTime ? virtualMillis : millis(); }
+
+    static void startVirtual() {
+        virtualMillis = millis();
+        virtualTime = true;
+    }
+
+    static void stopVirtual() { virtualTime = false; }
+    static bool isVirtual() { return virtualTime; }
+
+    static void advance(unsigned long ms) { virtualMillis += ms; }
+
+private:
+    static bool virtualTime;
+    static unsigned long virtualMillis;
+};
+
+#endif // SYSTEM_CLOCK_H
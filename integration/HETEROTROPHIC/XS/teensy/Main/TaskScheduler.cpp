@@ -0,0 +1,125 @@
+// TaskScheduler.cpp
+#include "TaskScheduler.h"
+#include "Logger.h"
+
+TaskScheduler::Task TaskScheduler::tasks[TaskScheduler::MAX_TASKS];
+int TaskScheduler::taskCount = 0;
+unsigned long TaskScheduler::idlePasses = 0;
+TaskFunction TaskScheduler::idleTask = nullptr;
+unsigned long TaskScheduler::statisticsStart = 0;
+
+bool TaskScheduler::addTask(const char* name, TaskFunction function, unsigned long interval, uint8_t priority) {
+    if (taskCount >= MAX_TASKS) {
+        Logger::log(LogLevel::ERROR, "Task table full, cannot add task " + String(name));
+        return false;
+    }
+
+    // Keep the table sorted by priority, tasks of equal priority run in registration order
+    int index = taskCount;
+    while (index > 0 && tasks[index - 1].priority > priority) {
+        tasks[index] = tasks[index - 1];
+        index--;
+    }
+
+    Task& task = tasks[index];
+    task.name = name;
+    task.function = function;
+    task.interval = interval * 1000;
+    task.priority = priority;
+    task.nextRun = micros();
+    resetStatistics(task);
+    taskCount++;
+    return true;
+}
+
+void TaskScheduler::run() {
+    bool anyRun = false;
+    for (int i = 0; i < taskCount; i++) {
+        unsigned long now = micros();
+        // Signed difference so that the comparison survives the micros() overflow
+        if (static_cast<long>(now - tasks[i].nextRun) >= 0) {
+            execute(tasks[i], now);
+            anyRun = true;
+        }
+    }
+    if (!anyRun) {
+        idlePasses++;
+        if (idleTask) {
+            idleTask();
+        }
+    }
+}
+
+void TaskScheduler::execute(Task& task, unsigned long now) {
+    unsigned long jitter = now - task.nextRun;
+    if (jitter >= task.interval) {
+        task.deadlineMisses++;
+    }
+
+    task.function();
+    unsigned long execTime = micros() - now;
+
+    task.runs++;
+    task.totalExecTime += execTime;
+    if (execTime > task.maxExecTime) task.maxExecTime = execTime;
+    if (jitter > task.maxJitter) task.maxJitter = jitter;
+    if (execTime > task.interval) task.overruns++;
+    task.execHistogram[bucketFor(execTime)]++;
+    task.jitterHistogram[bucketFor(jitter)]++;
+
+    // Stay on the original time grid; after a miss, restart from now instead of running a burst of late runs
+    task.nextRun += task.interval;
+    if (static_cast<long>(micros() - task.nextRun) >= 0) {
+        task.nextRun = now + task.interval;
+    }
+}
+
+void TaskScheduler::logStatistics() {
+    unsigned long elapsed = millis() - statisticsStart;
+    Logger::log(LogLevel::INFO, "Task statistics over the last " + String(elapsed / 1000) + " s, " +
+                String(idlePasses) + " idle passes (histograms: <100us/<1ms/<10ms/<100ms/>=100ms)");
+    for (int i = 0; i < taskCount; i++) {
+        Task& task = tasks[i];
+        unsigned long averageExecTime = task.runs > 0 ? task.totalExecTime / task.runs : 0;
+        Logger::log(LogLevel::INFO, String(task.name) + " (" + String(task.interval / 1000) + " ms, priority " + String(task.priority) + "): " +
+                    String(task.runs) + " runs, " + String(task.deadlineMisses) + " deadline misses, " +
+                    String(task.overruns) + " overruns, exec avg " + String(averageExecTime) + " us max " + String(task.maxExecTime) +
+                    " us " + formatHistogram(task.execHistogram) +
+                    ", jitter max " + String(task.maxJitter) + " us " + formatHistogram(task.jitterHistogram));
+        resetStatistics(task);
+    }
+    idlePasses = 0;
+    statisticsStart = millis();
+}
+
+void TaskScheduler::resetStatistics(Task& task) {
+    task.runs = 0;
+    task.deadlineMisses = 0;
+    task.overruns = 0;
+    task.totalExecTime = 0;
+    task.maxExecTime = 0;
+    task.maxJitter = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        task.execHistogram[i] = 0;
+        task.jitterHistogram[i] = 0;
+    }
+}
+
+int TaskScheduler::bucketFor(unsigned long duration) {
+    int bucket = 0;
+    unsigned long limit = 100;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && duration >= limit) {
+        limit *= 10;
+        bucket++;
+    }
+    return bucket;
+}
+
+String TaskScheduler::formatHistogram(const uint32_t* histogram) {
+    String result = "[";
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        if (i > 0) result += "/";
+        result += String(histogram[i]);
+    }
+    return result + "]";
+}
@@ -0,0 +1,76 @@
+// TaskScheduler.h
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <Arduino.h>
+
+typedef void (*TaskFunction)();
+
+/*
+ * Cooperative scheduler for the main loop.
+ * Periodic tasks are registered once in setup() and run from loop() when due. When several tasks are due
+ * in the same pass they run by priority (lower value first). Tasks never preempt each other:
+ * a task that blocks delays every other one, which shows up in the statistics.
+ *
+ * For each task the scheduler records:
+ *   - jitter: delay between the time the task was due and the time it started
+ *   - execution time
+ *   - deadline misses: start delayed by a full period or more (at least one run skipped)
+ *   - overruns: execution longer than the period
+ */
+class TaskScheduler {
+public:
+    static const int MAX_TASKS = 10;
+
+    /*
+     * Register a periodic task.
+     * @param name: Name shown in the statistics (must stay valid, usually a literal).
+     * @param interval: Period in milliseconds.
+     * @param priority: Order among the tasks due in the same pass, 0 runs first.
+     * @return: false if the task table is full.
+     */
+    static bool addTask(const char* name, TaskFunction function, unsigned long interval, uint8_t priority);
+
+    // Run the tasks that are due, call on every loop
+    static void run();
+
+    // Function called in the passes where no task is due (background work that must not delay the tasks much)
+    static void setIdleTask(TaskFunction function) { idleTask = function; }
+
+    // Log the statistics of every task since the last call, then reset them
+    static void logStatistics();
+
+private:
+    // Histogram buckets (us): < 100, < 1 ms, < 10 ms, < 100 ms, >= 100 ms
+    static const int HISTOGRAM_BUCKETS = 5;
+
+    struct Task {
+        const char* name;
+        TaskFunction function;
+        unsigned long interval;     // us
+        uint8_t priority;
+        unsigned long nextRun;      // micros() at which the task is due
+
+        unsigned long runs;
+        unsigned long deadlineMisses;
+        unsigned long overruns;
+        unsigned long totalExecTime; // us
+        unsigned long maxExecTime;   // us
+        unsigned long maxJitter;     // us
+        uint32_t execHistogram[HISTOGRAM_BUCKETS];
+        uint32_t jitterHistogram[HISTOGRAM_BUCKETS];
+    };
+
+    static Task tasks[MAX_TASKS];   // Sorted by priority
+    static int taskCount;
+    static unsigned long idlePasses; // Passes where no task was due
+    static TaskFunction idleTask;
+    static unsigned long statisticsStart;
+
+    static void execute(Task& task, unsigned long now);
+    static void resetStatistics(Task& task);
+    static int bucketFor(unsigned long duration);
+    static String formatHistogram(const uint32_t* histogram);
+};
+
+#endif // TASK_SCHEDULER_H
@@ -0,0 +1,186 @@
+// TelemetryProtocol.cpp
+// Keep in sync with XS/ESP32/TelemetryProtocol.cpp
+#include "TelemetryProtocol.h"
+
+namespace TelemetryProtocol {
+
+namespace {
+
+// Little-endian writer over a fixed buffer
+class Writer {
+public:
+    Writer(uint8_t* buffer) : _buffer(buffer), _pos(0) {}
+    void u8(uint8_t value) { _buffer[_pos++] = value; }
+    void u16(uint16_t value) { u8(value & 0xFF); u8(value >> 8); }
+    void i16(int16_t value) { u16(static_cast<uint16_t>(value)); }
+    void u32(uint32_t value) { u16(value & 0xFFFF); u16(value >> 16); }
+    void f32(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        u16(bits & 0xFFFF);
+        u16(bits >> 16);
+    }
+    void bytes(const void* data, size_t length) {
+        memcpy(_buffer + _pos, data, length);
+        _pos += length;
+    }
+    size_t position() const { return _pos; }
+
+private:
+    uint8_t* _buffer;
+    size_t _pos;
+};
+
+// Little-endian reader over a payload whose size has already been checked
+class Reader {
+public:
+    Reader(const uint8_t* buffer) : _buffer(buffer), _pos(0) {}
+    uint8_t u8() { return _buffer[_pos++]; }
+    uint16_t u16() { uint16_t low = u8(); return low | (static_cast<uint16_t>(u8()) << 8); }
+    int16_t i16() { return static_cast<int16_t>(u16()); }
+    uint32_t u32() { uint32_t low = u16(); return low | (static_cast<uint32_t>(u16()) << 16); }
+    float f32() {
+        uint32_t bits = u16();
+        bits |= static_cast<uint32_t>(u16()) << 16;
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    void bytes(void* data, size_t length) {
+        memcpy(data, _buffer + _pos, length);
+        _pos += length;
+    }
+
+private:
+    const uint8_t* _buffer;
+    size_t _pos;
+};
+
+} // namespace
+
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc) {
+    for (size_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t encodeAllData(const AllDataFrame& frame, uint8_t* buffer, size_t size) {
+    if (size < MAX_FRAME_SIZE) {
+        return 0;
+    }
+
+    Writer writer(buffer);
+    writer.u8(SYNC_BYTE);
+    writer.u8(ALL_DATA_PAYLOAD_SIZE);
+
+    writer.u8(SCHEMA_VERSION);
+    writer.u8(FRAME_TYPE_ALL_DATA);
+    writer.bytes(frame.currentProgram, PROGRAM_NAME_SIZE);
+    writer.u8(frame.programState);
+
+    writer.f32(frame.waterTemp);
+    writer.f32(frame.airTemp);
+    writer.f32(frame.elecTemp);
+    writer.f32(frame.pH);
+    writer.f32(frame.turbidity);
+    writer.f32(frame.oxygen);
+    writer.f32(frame.airFlow);
+
+    writer.u16(frame.actuatorRunning);
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        writer.i16(frame.actuatorValues[i]);
+    }
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        writer.u32(frame.actuatorRemaining[i]);
+    }
+
+    writer.f32(frame.currentVolume);
+    writer.f32(frame.availableVolume);
+    writer.f32(frame.addedNaOH);
+    writer.f32(frame.addedNutrient);
+    writer.f32(frame.addedMicroalgae);
+    writer.f32(frame.removedVolume);
+
+    // CRC over the length byte and the payload
+    uint16_t crc = crc16(buffer + 1, writer.position() - 1);
+    writer.u16(crc);
+    return writer.position();
+}
+
+bool decodeAllData(const uint8_t* payload, size_t length, AllDataFrame& frame) {
+    if (length != ALL_DATA_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    Reader reader(payload);
+    if (reader.u8() != SCHEMA_VERSION || reader.u8() != FRAME_TYPE_ALL_DATA) {
+        return false;
+    }
+    reader.bytes(frame.currentProgram, PROGRAM_NAME_SIZE);
+    frame.currentProgram[PROGRAM_NAME_SIZE - 1] = '\0';
+    frame.programState = reader.u8();
+
+    frame.waterTemp = reader.f32();
+    frame.airTemp = reader.f32();
+    frame.elecTemp = reader.f32();
+    frame.pH = reader.f32();
+    frame.turbidity = reader.f32();
+    frame.oxygen = reader.f32();
+    frame.airFlow = reader.f32();
+
+    frame.actuatorRunning = reader.u16();
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        frame.actuatorValues[i] = reader.i16();
+    }
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        frame.actuatorRemaining[i] = reader.u32();
+    }
+
+    frame.currentVolume = reader.f32();
+    frame.availableVolume = reader.f32();
+    frame.addedNaOH = reader.f32();
+    frame.addedNutrient = reader.f32();
+    frame.addedMicroalgae = reader.f32();
+    frame.removedVolume = reader.f32();
+    return true;
+}
+
+FrameReader::Result FrameReader::push(uint8_t byte) {
+    switch (_state) {
+        case WAIT_SYNC:
+            if (byte == SYNC_BYTE) {
+                _state = WAIT_LENGTH;
+            }
+            break;
+        case WAIT_LENGTH:
+            _length = byte;
+            _received = 0;
+            _crc = crc16(&byte, 1);
+            _state = (_length > 0) ? PAYLOAD : CRC_LOW;
+            break;
+        case PAYLOAD:
+            _payload[_received++] = byte;
+            _crc = crc16(&byte, 1, _crc);
+            if (_received == _length) {
+                _state = CRC_LOW;
+            }
+            break;
+        case CRC_LOW:
+            _crcLow = byte;
+            _state = CRC_HIGH;
+            break;
+        case CRC_HIGH:
+            _state = WAIT_SYNC;
+            if ((_crcLow | (static_cast<uint16_t>(byte) << 8)) == _crc) {
+                return Result::FRAME;
+            }
+            return Result::CRC_ERROR;
+    }
+    return Result::NEED_MORE;
+}
+
+} // namespace TelemetryProtocol
@@ -0,0 +1,108 @@
+// TelemetryProtocol.h
+// Binary telemetry frames sent by the Teensy to the ESP32 bridge.
+// The same file is used by the ESP32 sketch (XS/ESP32/TelemetryProtocol.h): keep both copies in sync.
+#ifndef TELEMETRY_PROTOCOL_H
+#define TELEMETRY_PROTOCOL_H
+
+#include <Arduino.h>
+
+/*
+ * Frame layout (multi-byte values are little-endian):
+ *   [SYNC 0xA5][LENGTH][PAYLOAD ... LENGTH bytes][CRC16 low][CRC16 high]
+ * The CRC16 (CCITT-FALSE) covers LENGTH and PAYLOAD.
+ * The payload starts with the schema version and the frame type.
+ * A JSON text line can never start with the sync byte, so both formats can share the link:
+ * the receiver only looks for a sync byte at the start of a line.
+ */
+namespace TelemetryProtocol {
+
+static const uint8_t SYNC_BYTE = 0xA5;
+static const uint8_t SCHEMA_VERSION = 2;     // 2: actuatorRemaining added
+static const uint8_t FRAME_TYPE_ALL_DATA = 1;
+
+static const uint8_t PROGRAM_NAME_SIZE = 16; // Including the terminating '\0'
+static const uint8_t ACTUATOR_COUNT = 9;     // Same order as ActuatorId
+static const uint8_t VOLUME_COUNT = 6;
+
+// Content of a periodic frame, mirrors DataCollector::collectAllData()
+struct AllDataFrame {
+    char currentProgram[PROGRAM_NAME_SIZE];
+    uint8_t programState;
+
+    float waterTemp;
+    float airTemp;
+    float elecTemp;
+    float pH;
+    float turbidity;
+    float oxygen;
+    float airFlow;
+
+    uint16_t actuatorRunning;                 // Bit n set when actuator n is running
+    int16_t actuatorValues[ACTUATOR_COUNT];
+    uint32_t actuatorRemaining[ACTUATOR_COUNT]; // ms left on the timed runs, 0 when stopped or running continuously
+
+    float currentVolume;
+    float availableVolume;
+    float addedNaOH;
+    float addedNutrient;
+    float addedMicroalgae;
+    float removedVolume;
+};
+
+static const uint8_t ALL_DATA_PAYLOAD_SIZE = 2 + PROGRAM_NAME_SIZE + 1 + 7 * 4 + 2 + ACTUATOR_COUNT * 2 + ACTUATOR_COUNT * 4 + VOLUME_COUNT * 4;
+static const uint8_t FRAME_OVERHEAD = 4; // Sync, length and CRC
+static const uint8_t MAX_FRAME_SIZE = ALL_DATA_PAYLOAD_SIZE + FRAME_OVERHEAD;
+
+// Longest text line the ESP32 forwards (line reader and flash queue record), longer ones are dropped
+static const size_t MAX_TEXT_LINE_LENGTH = 1023;
+
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+/*
+ * Encode a periodic frame.
+ * @return: Number of bytes written, 0 if the buffer is too small.
+ */
+size_t encodeAllData(const AllDataFrame& frame, uint8_t* buffer, size_t size);
+
+/*
+ * Decode the payload of a frame whose CRC has already been checked by FrameReader.
+ * @return: false if the schema version, the frame type or the size does not match.
+ */
+bool decodeAllData(const uint8_t* payload, size_t length, AllDataFrame& frame);
+
+/*
+ * Incremental frame parser, fed one byte at a time from the UART.
+ */
+class FrameReader {
+public:
+    enum class Result {
+        NEED_MORE,  // Keep feeding bytes
+        FRAME,      // A valid frame is available through payload()/length()
+        CRC_ERROR   // Frame dropped, the reader is back to waiting for a sync byte
+    };
+
+    FrameReader() : _state(WAIT_SYNC), _length(0), _received(0), _crc(0), _crcLow(0) {}
+
+    // Only valid between a sync byte and the end of the frame
+    bool inFrame() const { return _state != WAIT_SYNC; }
+
+    Result push(uint8_t byte);
+    void reset() { _state = WAIT_SYNC; }
+
+    const uint8_t* payload() const { return _payload; }
+    uint8_t length() const { return _length; }
+
+private:
+    enum State { WAIT_SYNC, WAIT_LENGTH, PAYLOAD, CRC_LOW, CRC_HIGH };
+
+    State _state;
+    uint8_t _length;
+    uint8_t _received;
+    uint16_t _crc;      // CRC computed over the bytes received so far
+    uint8_t _crcLow;    // Low byte of the CRC sent with the frame
+    uint8_t _payload[255];
+};
+
+} // namespace TelemetryProtocol
+
+#endif // TELEMETRY_PROTOCOL_H
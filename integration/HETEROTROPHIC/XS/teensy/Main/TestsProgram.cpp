@@ -128,9 +128,9 @@ void TestsProgram::updateAllActuatorsTest() {
     switch (_currentActuatorTest) {
         case 0:
             if (elapsedTime < 5000) {
-                ActuatorController::runActuator("airPump", 50, 0);
+                ActuatorController::runActuator(ActuatorId::AirPump, 50, 0);
             } else {
-                ActuatorController::stopActuator("airPump");
+                ActuatorController::stopActuator(ActuatorId::AirPump);
                 _currentActuatorTest++;
                 //Logger::log(LogLevel::INFO, "Air Pump test completed");
                 Logger::log(LogLevel::INFO, F("Air Pump test completed"));
@@ -138,9 +138,9 @@ void TestsProgram::updateAllActuatorsTest() {
             break;
         case 1:
             if (elapsedTime < 10000) {
-                ActuatorController::runActuator("drainPump", 80, 0);
+                ActuatorController::runActuator(ActuatorId::DrainPump, 80, 0);
             } else {
-                ActuatorController::stopActuator("drainPump");
+                ActuatorController::stopActuator(ActuatorId::DrainPump);
                 _currentActuatorTest++;
                 //Logger::log(LogLevel::INFO, "Drain Pump test completed");
                 Logger::log(LogLevel::INFO, F("Drain Pump test completed"));
@@ -148,9 +148,9 @@ void TestsProgram::updateAllActuatorsTest() {
             break;
         case 2:
             if (elapsedTime < 10000) {
-                ActuatorController::runActuator("samplePump", 80, 0);
+                ActuatorController::runActuator(ActuatorId::SamplePump, 80, 0);
             } else {
-                ActuatorController::stopActuator("samplePump");
+                ActuatorController::stopActuator(ActuatorId::SamplePump);
                 _currentActuatorTest++;
                 //Logger::log(LogLevel::INFO, "Sample Pump test completed");
                 Logger::log(LogLevel::INFO, F("Sample Pump test completed"));
@@ -158,9 +158,9 @@ void TestsProgram::updateAllActuatorsTest() {
             break;
         case 3:
             if (elapsedTime < 15000) {
-                ActuatorController::runActuator("stirringMotor", 1500, 0);
+                ActuatorController::runActuator(ActuatorId::StirringMotor, 1500, 0);
             } else {
-                ActuatorController::stopActuator("stirringMotor");
+                ActuatorController::stopActuator(ActuatorId::StirringMotor);
                 _currentActuatorTest++;
                 //Logger::log(LogLevel::INFO, "Stirring Motor test completed");
                 Logger::log(LogLevel::INFO, F("Stirring Motor test completed"));
@@ -168,9 +168,9 @@ void TestsProgram::updateAllActuatorsTest() {
             break;
         case 4:
             if (elapsedTime < 20000) {
-                ActuatorController::runActuator("nutrientPump", 50, 0);
+                ActuatorController::runActuator(ActuatorId::NutrientPump, 50, 0);
             } else {
-                ActuatorController::stopActuator("nutrientPump");
+                ActuatorController::stopActuator(ActuatorId::NutrientPump);
                 _currentActuatorTest++;
                 Logger::log(LogLevel::INFO, "Nutrient Pump test completed");
                 Logger::log(LogLevel::INFO, F("Nutrient Pump test completed"));
@@ -178,9 +178,9 @@ void TestsProgram::updateAllActuatorsTest() {
             break;
         case 5:
             if (elapsedTime < 25000) {
-                ActuatorController::runActuator("basePump", 30, 0);
+                ActuatorController::runActuator(ActuatorId::BasePump, 30, 0);
             } else {
-                ActuatorController::stopActuator("basePump");
+                ActuatorController::stopActuator(ActuatorId::BasePump);
                 _currentActuatorTest++;
                 //Logger::log(LogLevel::INFO, "Base Pump test completed");
                 Logger::log(LogLevel::INFO, F("Base Pump test completed"));
@@ -188,9 +188,9 @@ void TestsProgram::updateAllActuatorsTest() {
             break;
         case 6:
             if (elapsedTime < 30000) {
-                ActuatorController::runActuator("heatingPlate", 100, 0);
+                ActuatorController::runActuator(ActuatorId::HeatingPlate, 100, 0);
             } else {
-                ActuatorController::stopActuator("heatingPlate");
+                ActuatorController::stopActuator(ActuatorId::HeatingPlate);
                 _currentActuatorTest++;
                 //Logger::log(LogLevel::INFO, "Heating Plate test completed");
                 Logger::log(LogLevel::INFO, F("Heating Plate test completed"));
@@ -198,9 +198,9 @@ void TestsProgram::updateAllActuatorsTest() {
             break;
         case 7:
             if (elapsedTime < 35000) {
-                ActuatorController::runActuator("ledGrowLight", 100, 0);
+                ActuatorController::runActuator(ActuatorId::LedGrowLight, 100, 0);
             } else {
-                ActuatorController::stopActuator("ledGrowLight");
+                ActuatorController::stopActuator(ActuatorId::LedGrowLight);
                 _currentActuatorTest++;
                 //Logger::log(LogLevel::INFO, "LED Grow Light test completed");
                 Logger::log(LogLevel::INFO, F("LED Grow Light test completed"));
@@ -211,9 +211,9 @@ void TestsProgram::updateAllActuatorsTest() {
             break;
         case 8:
             if (elapsedTime < 10000) {
-                ActuatorController::runActuator("fillPump", 80, 0);
+                ActuatorController::runActuator(ActuatorId::FillPump, 80, 0);
             } else {
-                ActuatorController::stopActuator("fillPump");
+                ActuatorController::stopActuator(ActuatorId::FillPump);
                 _currentActuatorTest++;
                 Logger::log(LogLevel::INFO, F("Fill Pump test completed"));
             }
@@ -344,7 +344,7 @@ void TestsProgram::stopPIDTest() {
         default:
             break;
     }
-    ActuatorController::stopActuator("stirringMotor");
+    ActuatorController::stopActuator(ActuatorId::StirringMotor);
     Logger::log(LogLevel::INFO, "Stopped PID test: " + getTestTypeName(_currentTestType) + " and stirring motor");
 }
 
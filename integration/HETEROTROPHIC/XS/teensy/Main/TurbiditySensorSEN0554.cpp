@@ -20,31 +20,59 @@ void TurbiditySensorSEN0554::begin() {
 
 float TurbiditySensorSEN0554::readValue() {
     if (communicate()) {
-        int rawTurbidity = _response[3];
-        float adjustedTurbidity = (rawTurbidity * SCALE_FACTOR) + OFFSET;
-        //Logger::log(LogLevel::INFO, String(_name) + " - raw value: " + String(rawTurbidity) + ", Adjusted value: " + String(adjustedTurbidity));     
-        return adjustedTurbidity;
+        //Logger::log(LogLevel::INFO, String(_name) + " - raw value: " + String(_response[3]) + ", Adjusted value: " + String(convertResponse()));
+        return convertResponse();
     }
     //Logger::log(LogLevel::WARNING, String(_name) + " - No sensor response");
     //Logger::log(LogLevel::WARNING, String(_name) + F(" - No sensor response"));
     return -1.0f;
 }
 
+bool TurbiditySensorSEN0554::startReading() {
+    // Drop any stale bytes so the next 5 bytes are the answer to this request
+    while (_serial->available() > 0) {
+        _serial->read();
+    }
+    _serial->write(_command, 5);
+    _requestTime = millis();
+    return true;
+}
+
+bool TurbiditySensorSEN0554::pollReading(float& value) {
+    if (_serial->available() >= 5) {
+        value = receiveResponse() ? convertResponse() : -1.0f;
+        return true;
+    }
+    if (millis() - _requestTime > RESPONSE_TIMEOUT) {
+        value = -1.0f; // No sensor response
+        return true;
+    }
+    return false;
+}
+
 bool TurbiditySensorSEN0554::communicate() {
     _serial->write(_command, 5);
     delay(100);  // Délai ajouté comme dans le code fonctionnel
 
     if (_serial->available() >= 5) {
-        for (int i = 0; i < 5; i++) {
-            _response[i] = _serial->read();
-        }
-        
-        if (_response[0] == 0x18 && _response[1] == 0x05) {
-            return true;
-        } else {
-            //Logger::log(LogLevel::ERROR, String(_name) + " - Réponse invalide du capteur");
-            //Logger::log(LogLevel::ERROR, String(_name) + F(" - Réponse invalide du capteur"));
-        }
+        return receiveResponse();
     }
     return false;
-}
\ No newline at end of file
+}
+
+bool TurbiditySensorSEN0554::receiveResponse() {
+    for (int i = 0; i < 5; i++) {
+        _response[i] = _serial->read();
+    }
+
+    if (_response[0] == 0x18 && _response[1] == 0x05) {
+        return true;
+    }
+    //Logger::log(LogLevel::ERROR, String(_name) + F(" - Réponse invalide du capteur"));
+    return false;
+}
+
+float TurbiditySensorSEN0554::convertResponse() const {
+    int rawTurbidity = _response[3];
+    return (rawTurbidity * SCALE_FACTOR) + OFFSET;
+}
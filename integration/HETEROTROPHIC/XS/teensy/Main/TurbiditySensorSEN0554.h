@@ -32,6 +32,8 @@ public:
     TurbiditySensorSEN0554(HardwareSerial* serial, const char* name); 
     void begin() override;
     float readValue() override;
+    bool startReading() override;
+    bool pollReading(float& value) override;
     const char* getName() const override { return _name; }
 
 private:
@@ -41,7 +43,11 @@ private:
     unsigned char _response[5];
     const float SCALE_FACTOR = 1.5;
     const int OFFSET = 10;
+    static const unsigned long RESPONSE_TIMEOUT = 200; // Time allowed for the 5-byte answer (ms)
+    unsigned long _requestTime = 0;
     bool communicate();
+    bool receiveResponse();
+    float convertResponse() const;
 };
 
 #endif
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include "VolumeManager.h"
 #include "ActuatorController.h"
 #include "Logger.h"
+#include "ParameterStore.h"
 
 VolumeManager::VolumeManager(float totalVolume, float maxVolumePercent, float minVolume)
     : totalVolume(totalVolume), maxVolumePercent(maxVolumePercent), minVolume(minVolume),
-      currentVolume(0), addedNaOH(0), addedNutrient(0), addedMicroalgae(0), removedVolume(0),
+      currentVolume(0), initialVolume(0), addedNaOH(0), addedNutrient(0), addedMicroalgae(0), removedVolume(0),
       cumulativeNaOH(0), cumulativeNutrient(0), cumulativeMicroalgae(0), cumulativeRemoved(0) {}
 
 void VolumeManager::updateVolume() {
@@ -132,4 +133,32 @@ void VolumeManager::resetVolume() {
         cumulativeMicroalgae = 0;
         cumulativeRemoved = 0;
         Logger::log(LogLevel::INFO, "Volume reset to initial conditions: " + String(initialVolume) + " L");
-    }
\ No newline at end of file
+    }
+
+bool VolumeManager::saveState() {
+    VolumeRecord record;
+    memset(&record, 0, sizeof(record));
+    record.currentVolume = currentVolume;
+    record.initialVolume = initialVolume;
+    record.cumulativeNaOH = cumulativeNaOH;
+    record.cumulativeNutrient = cumulativeNutrient;
+    record.cumulativeMicroalgae = cumulativeMicroalgae;
+    record.cumulativeRemoved = cumulativeRemoved;
+    return ParameterStore::queue(record);
+}
+
+bool VolumeManager::loadState() {
+    VolumeRecord record;
+    if (!ParameterStore::load(record)) {
+        return false;
+    }
+    currentVolume = record.currentVolume;
+    initialVolume = record.initialVolume;
+    cumulativeNaOH = record.cumulativeNaOH;
+    cumulativeNutrient = record.cumulativeNutrient;
+    cumulativeMicroalgae = record.cumulativeMicroalgae;
+    cumulativeRemoved = record.cumulativeRemoved;
+    Logger::log(LogLevel::INFO, "Volume restored: " + String(currentVolume, 4) + " L, added NaOH: " + String(cumulativeNaOH, 4) +
+                " L, added nutrient: " + String(cumulativeNutrient, 4) + " L");
+    return true;
+}
\ No newline at end of file
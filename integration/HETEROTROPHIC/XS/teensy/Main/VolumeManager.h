@@ -28,6 +28,10 @@ public:
     String getVolumeInfo() const;
     void resetVolume();
 
+    // Current volume and cumulative totals in the ParameterStore, written by ParameterStore::service()
+    bool saveState();
+    bool loadState();
+
 private:
     float totalVolume;
     float maxVolumePercent;
@@ -0,0 +1,5 @@
+// MainSketch.cpp
+// Main.ino as the Arduino IDE compiles it: the IDE declares the sketch functions before the sketch body.
+void registerTasks();
+
+#include "Main.ino"
@@ -0,0 +1,135 @@
+// Adafruit_MAX31865.cpp
+#include <Adafruit_MAX31865.h>
+#include <Adafruit_SPIDevice.h>
+
+float Adafruit_MAX31865::hostTemperature = 22.0f;
+unsigned long Adafruit_MAX31865::hostConversions = 0;
+unsigned long Adafruit_MAX31865::hostBadReads = 0;
+
+static const float HOST_RTD_NOMINAL = 100.0f;
+static const float HOST_REF_RESISTOR = 430.0f;
+
+static uint8_t config = 0;
+static unsigned long biasSince = 0;
+static bool converting = false;
+static bool conversionValid = false;
+static unsigned long conversionStart = 0;
+static uint16_t rtdRegister = 0;
+
+// RTD register (15-bit ratio to the reference resistor, fault bit clear) for the test temperature
+static uint16_t rtdCode(float temperature) {
+    float resistance = HOST_RTD_NOMINAL * (1 + RTD_A * temperature + RTD_B * temperature * temperature);
+    return static_cast<uint16_t>(lround(resistance / HOST_REF_RESISTOR * 32768)) << 1;
+}
+
+static void finishConversion() {
+    if (converting && millis() - conversionStart >= Adafruit_MAX31865::CONVERSION_TIME) {
+        converting = false;
+        if (conversionValid) {
+            rtdRegister = rtdCode(Adafruit_MAX31865::hostTemperature);
+            Adafruit_MAX31865::hostConversions++;
+        }
+    }
+}
+
+uint8_t Adafruit_MAX31865::readRegister(uint8_t address) {
+    finishConversion();
+    switch (address) {
+        case MAX31865_CONFIG_REG: return config | (converting ? MAX31865_CONFIG_1SHOT : 0);
+        case MAX31865_RTDMSB_REG:
+        case MAX31865_RTDLSB_REG:
+            if (converting) hostBadReads++;
+            return address == MAX31865_RTDMSB_REG ? rtdRegister >> 8 : rtdRegister & 0xFF;
+        default: return 0;
+    }
+}
+
+void Adafruit_MAX31865::writeRegister(uint8_t address, uint8_t data) {
+    finishConversion();
+    if (address != MAX31865_CONFIG_REG) return;
+    if ((data & MAX31865_CONFIG_BIAS) && !(config & MAX31865_CONFIG_BIAS)) {
+        biasSince = millis();
+    }
+    if (data & MAX31865_CONFIG_1SHOT) {
+        converting = true;
+        conversionStart = millis();
+        conversionValid = (data & MAX31865_CONFIG_BIAS) && millis() - biasSince >= BIAS_TIME;
+        if (!conversionValid) hostBadReads++;
+    }
+    // 1SHOT and FAULTSTAT clear themselves
+    config = data & ~(MAX31865_CONFIG_1SHOT | MAX31865_CONFIG_FAULTSTAT);
+}
+
+bool Adafruit_MAX31865::begin(max31865_numwires_t wires) {
+    writeRegister(MAX31865_CONFIG_REG, wires == MAX31865_3WIRE ? MAX31865_CONFIG_3WIRE : 0);
+    return true;
+}
+
+void Adafruit_MAX31865::clearFault() {
+    writeRegister(MAX31865_CONFIG_REG, readRegister(MAX31865_CONFIG_REG) | MAX31865_CONFIG_FAULTSTAT);
+}
+
+void Adafruit_MAX31865::enableBias(bool enabled) {
+    uint8_t value = readRegister(MAX31865_CONFIG_REG);
+    writeRegister(MAX31865_CONFIG_REG, enabled ? (value | MAX31865_CONFIG_BIAS) : (value & ~MAX31865_CONFIG_BIAS));
+}
+
+uint16_t Adafruit_MAX31865::readRTD() {
+    clearFault();
+    enableBias(true);
+    delay(BIAS_TIME);
+    writeRegister(MAX31865_CONFIG_REG, readRegister(MAX31865_CONFIG_REG) | MAX31865_CONFIG_1SHOT);
+    delay(CONVERSION_TIME);
+    uint16_t rtd = (readRegister(MAX31865_RTDMSB_REG) << 8) | readRegister(MAX31865_RTDLSB_REG);
+    enableBias(false);
+    return rtd >> 1;
+}
+
+float Adafruit_MAX31865::temperature(float rtdNominal, float refResistor) {
+    return calculateTemperature(readRTD(), rtdNominal, refResistor);
+}
+
+// Callendar-Van Dusen inversion of the library
+float Adafruit_MAX31865::calculateTemperature(uint16_t rtdRaw, float rtdNominal, float refResistor) {
+    float Z1 = -RTD_A;
+    float Z2 = RTD_A * RTD_A - (4 * RTD_B);
+    float Z3 = (4 * RTD_B) / rtdNominal;
+    float Z4 = 2 * RTD_B;
+    float Rt = rtdRaw / 32768.0f * refResistor;
+    float temp = (sqrtf(Z2 + (Z3 * Rt)) + Z1) / Z4;
+    if (temp >= 0) return temp;
+
+    // Below 0 °C
+    Rt = Rt / rtdNominal * 100;
+    float rpoly = Rt;
+    temp = -242.02f;
+    temp += 2.2228f * rpoly;
+    rpoly *= Rt;
+    temp += 2.5859e-3f * rpoly;
+    rpoly *= Rt;
+    temp -= 4.8260e-6f * rpoly;
+    rpoly *= Rt;
+    temp -= 2.8183e-8f * rpoly;
+    rpoly *= Rt;
+    temp += 1.5243e-10f * rpoly;
+    return temp;
+}
+
+bool Adafruit_SPIDevice::write(const uint8_t* buffer, size_t len, const uint8_t* prefixBuffer, size_t prefixLen) {
+    (void)prefixBuffer; (void)prefixLen;
+    uint8_t address = buffer[0] & 0x7F;
+    for (size_t i = 1; i < len; i++) {
+        Adafruit_MAX31865::writeRegister(address + i - 1, buffer[i]);
+    }
+    return true;
+}
+
+bool Adafruit_SPIDevice::write_then_read(const uint8_t* writeBuffer, size_t writeLen, uint8_t* readBuffer,
+                                         size_t readLen, uint8_t sendValue) {
+    (void)writeLen; (void)sendValue;
+    uint8_t address = writeBuffer[0] & 0x7F;
+    for (size_t i = 0; i < readLen; i++) {
+        readBuffer[i] = Adafruit_MAX31865::readRegister(address + i);
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+// Adafruit_MAX31865.h
+// RTD amplifier measuring the temperature set by the test (22 °C by default).
+// The configuration and RTD registers are modelled: a one-shot conversion started with the bias on for less than
+// BIAS_TIME, or an RTD register read before the end of the conversion, returns the previous result and is counted.
+#ifndef HOST_ADAFRUIT_MAX31865_H
+#define HOST_ADAFRUIT_MAX31865_H
+#include <Arduino.h>
+
+#define MAX31865_CONFIG_REG 0x00
+#define MAX31865_CONFIG_BIAS 0x80
+#define MAX31865_CONFIG_MODEAUTO 0x40
+#define MAX31865_CONFIG_1SHOT 0x20
+#define MAX31865_CONFIG_3WIRE 0x10
+#define MAX31865_CONFIG_FAULTSTAT 0x02
+#define MAX31865_RTDMSB_REG 0x01
+#define MAX31865_RTDLSB_REG 0x02
+
+#define RTD_A 3.9083e-3
+#define RTD_B -5.775e-7
+
+typedef enum { MAX31865_2WIRE = 0, MAX31865_3WIRE = 1, MAX31865_4WIRE = 0 } max31865_numwires_t;
+
+class Adafruit_MAX31865 {
+public:
+    Adafruit_MAX31865(int8_t cs, int8_t mosi, int8_t miso, int8_t clk) { (void)cs; (void)mosi; (void)miso; (void)clk; }
+    bool begin(max31865_numwires_t wires = MAX31865_2WIRE);
+    uint8_t readFault() { return 0; }
+    void clearFault();
+    void enableBias(bool enabled);
+    void autoConvert(bool enabled) { (void)enabled; }
+    // Blocking one-shot conversion, same sequence and duration as the hardware (bias settling + conversion)
+    uint16_t readRTD();
+    float temperature(float rtdNominal, float refResistor);
+    float calculateTemperature(uint16_t rtdRaw, float rtdNominal, float refResistor);
+
+    static float hostTemperature;
+    // Register model
+    static uint8_t readRegister(uint8_t address);
+    static void writeRegister(uint8_t address, uint8_t data);
+    static unsigned long hostConversions;  // One-shot conversions completed
+    static unsigned long hostBadReads;     // Conversions started without settled bias or read before completion
+
+    static const unsigned long BIAS_TIME = 10;
+    static const unsigned long CONVERSION_TIME = 65;
+};
+
+#endif
@@ -0,0 +1,17 @@
+// Adafruit_MCP4725.h
+#ifndef HOST_ADAFRUIT_MCP4725_H
+#define HOST_ADAFRUIT_MCP4725_H
+#include <Wire.h>
+
+class Adafruit_MCP4725 {
+public:
+    bool begin(uint8_t address = 0x62, TwoWire* wire = &Wire) { (void)address; (void)wire; return true; }
+    bool setVoltage(uint16_t output, bool writeEEPROM, uint32_t i2cFrequency = 400000) {
+        (void)writeEEPROM; (void)i2cFrequency;
+        value = output;
+        return true;
+    }
+    uint16_t value = 0; // Last output, for the host checks
+};
+
+#endif
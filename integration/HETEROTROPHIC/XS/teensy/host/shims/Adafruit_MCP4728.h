@@ -0,0 +1,29 @@
+// Adafruit_MCP4728.h
+#ifndef HOST_ADAFRUIT_MCP4728_H
+#define HOST_ADAFRUIT_MCP4728_H
+#include <Wire.h>
+
+typedef enum { MCP4728_CHANNEL_A, MCP4728_CHANNEL_B, MCP4728_CHANNEL_C, MCP4728_CHANNEL_D } MCP4728_channel_t;
+typedef enum { MCP4728_VREF_VDD, MCP4728_VREF_INTERNAL } MCP4728_vref_t;
+typedef enum { MCP4728_GAIN_1X, MCP4728_GAIN_2X } MCP4728_gain_t;
+typedef enum { MCP4728_PD_MODE_NORMAL } MCP4728_pd_mode_t;
+
+class Adafruit_MCP4728 {
+public:
+    bool begin(uint8_t address = 0x60, TwoWire* wire = &Wire) { (void)address; (void)wire; return true; }
+    bool setChannelValue(MCP4728_channel_t channel, uint16_t newValue, MCP4728_vref_t vref = MCP4728_VREF_VDD,
+                         MCP4728_gain_t gain = MCP4728_GAIN_1X, MCP4728_pd_mode_t powerMode = MCP4728_PD_MODE_NORMAL,
+                         bool udac = false) {
+        (void)vref; (void)gain; (void)powerMode; (void)udac;
+        values[channel] = newValue;
+        return true;
+    }
+    bool fastWrite(uint16_t a, uint16_t b, uint16_t c, uint16_t d) {
+        values[0] = a; values[1] = b; values[2] = c; values[3] = d;
+        return true;
+    }
+    bool saveToEEPROM() { return true; }
+    uint16_t values[4] = {0, 0, 0, 0}; // Last outputs, for the host checks
+};
+
+#endif
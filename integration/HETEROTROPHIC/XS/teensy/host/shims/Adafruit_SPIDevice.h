@@ -0,0 +1,26 @@
+// Adafruit_SPIDevice.h
+// SPI device whose register transfers are served by the chip model of the shims (the MAX31865, the only SPI chip).
+#ifndef HOST_ADAFRUIT_SPIDEVICE_H
+#define HOST_ADAFRUIT_SPIDEVICE_H
+#include <Arduino.h>
+
+typedef enum { SPI_BITORDER_MSBFIRST = 0, SPI_BITORDER_LSBFIRST = 1 } BusIOBitOrder;
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+class Adafruit_SPIDevice {
+public:
+    Adafruit_SPIDevice(int8_t cs, int8_t sclk, int8_t miso, int8_t mosi, uint32_t freq = 1000000,
+                       BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST, uint8_t dataMode = SPI_MODE0) {
+        (void)cs; (void)sclk; (void)miso; (void)mosi; (void)freq; (void)dataOrder; (void)dataMode;
+    }
+    bool begin() { return true; }
+    // First byte: register address, bit 7 set for a write
+    bool write(const uint8_t* buffer, size_t len, const uint8_t* prefixBuffer = nullptr, size_t prefixLen = 0);
+    bool write_then_read(const uint8_t* writeBuffer, size_t writeLen, uint8_t* readBuffer, size_t readLen,
+                         uint8_t sendValue = 0xFF);
+};
+
+#endif
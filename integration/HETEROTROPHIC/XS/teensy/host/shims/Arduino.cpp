@@ -0,0 +1,330 @@
+// Arduino.cpp
+#include <Arduino.h>
+#include "HostRuntime.h"
+
+#include <cctype>
+#include <vector>
+
+usb_serial_class Serial;
+HardwareSerial Serial1, Serial2, Serial3, Serial4, Serial5, Serial6, Serial7, Serial8;
+
+// ---- String ----
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (_s.size() != other._s.size()) return false;
+    for (size_t i = 0; i < _s.size(); i++) {
+        if (tolower(static_cast<unsigned char>(_s[i])) != tolower(static_cast<unsigned char>(other._s[i]))) return false;
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    return offset <= _s.size() && _s.compare(offset, prefix._s.size(), prefix._s) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return _s.size() >= suffix._s.size() && _s.compare(_s.size() - suffix._s.size(), suffix._s.size(), suffix._s) == 0;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _s.size()) return String();
+    if (to > _s.size()) to = _s.size();
+    return String(_s.substr(from, to - from));
+}
+
+void String::trim() {
+    size_t begin = 0;
+    while (begin < _s.size() && isspace(static_cast<unsigned char>(_s[begin]))) begin++;
+    size_t end = _s.size();
+    while (end > begin && isspace(static_cast<unsigned char>(_s[end - 1]))) end--;
+    _s = _s.substr(begin, end - begin);
+}
+
+void String::toUpperCase() {
+    for (char& c : _s) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+}
+
+void String::toLowerCase() {
+    for (char& c : _s) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+}
+
+void String::replace(char find, char replacement) {
+    std::replace(_s.begin(), _s.end(), find, replacement);
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find._s.empty()) return;
+    size_t index = 0;
+    while ((index = _s.find(find._s, index)) != std::string::npos) {
+        _s.replace(index, find._s.size(), replacement._s);
+        index += replacement._s.size();
+    }
+}
+
+void String::getBytes(unsigned char* buffer, unsigned int size, unsigned int index) const {
+    if (!buffer || size == 0) return;
+    unsigned int count = 0;
+    if (index < _s.size()) {
+        count = std::min<unsigned int>(size - 1, _s.size() - index);
+        memcpy(buffer, _s.data() + index, count);
+    }
+    buffer[count] = '\0';
+}
+
+std::string String::formatInteger(long long value, unsigned char base) {
+    if (value < 0 && base == 10) return "-" + formatUnsigned(static_cast<unsigned long long>(-(value + 1)) + 1, base);
+    // Negative values in another base print as their two's complement, like on the target (32 bits)
+    if (value < 0) return formatUnsigned(static_cast<uint32_t>(value), base);
+    return formatUnsigned(static_cast<unsigned long long>(value), base);
+}
+
+std::string String::formatUnsigned(unsigned long long value, unsigned char base) {
+    if (base < 2 || base > 36) base = 10;
+    char digits[66];
+    int length = 0;
+    do {
+        int digit = static_cast<int>(value % base);
+        digits[length++] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value > 0);
+    std::string result;
+    while (length > 0) result += digits[--length];
+    return result;
+}
+
+std::string String::formatFloat(double value, unsigned char decimals) {
+    if (std::isnan(value)) return "nan";
+    if (std::isinf(value)) return value > 0 ? "inf" : "-inf";
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), value);
+    return buffer;
+}
+
+// ---- Print / Stream ----
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t count = 0;
+    while (size--) {
+        count += write(*buffer++);
+    }
+    return count;
+}
+
+int Print::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    char small[256];
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(small, sizeof(small), format, copy);
+    va_end(copy);
+    if (length < 0) {
+        va_end(args);
+        return length;
+    }
+    if (static_cast<size_t>(length) < sizeof(small)) {
+        write(small, length);
+    } else {
+        std::vector<char> large(length + 1);
+        vsnprintf(large.data(), large.size(), format, args);
+        write(large.data(), length);
+    }
+    va_end(args);
+    return length;
+}
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) return c;
+        delay(1);
+    } while (millis() - start < _timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) break;
+        buffer[count++] = static_cast<char>(c);
+    }
+    return count;
+}
+
+String Stream::readStringUntil(char terminator) {
+    std::string result;
+    int c = timedRead();
+    while (c >= 0 && c != terminator) {
+        result += static_cast<char>(c);
+        c = timedRead();
+    }
+    return String(result);
+}
+
+String Stream::readString() {
+    std::string result;
+    int c = timedRead();
+    while (c >= 0) {
+        result += static_cast<char>(c);
+        c = timedRead();
+    }
+    return String(result);
+}
+
+// ---- HardwareSerial ----
+
+size_t HardwareSerial::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    _tx.append(reinterpret_cast<const char*>(buffer), size);
+    if (_echo) {
+        fwrite(buffer, 1, size, _echo);
+    }
+    // Keep long runs bounded when nobody reads the port
+    if (_tx.size() > (1u << 24)) {
+        _tx.erase(0, _tx.size() / 2);
+    }
+    return size;
+}
+
+int HardwareSerial::available() {
+    receiveWire();
+    return static_cast<int>(_rx.size());
+}
+
+int HardwareSerial::read() {
+    receiveWire();
+    if (_rx.empty()) return -1;
+    int c = _rx.front();
+    _rx.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek() {
+    receiveWire();
+    return _rx.empty() ? -1 : _rx.front();
+}
+
+void HardwareSerial::hostInject(const std::string& data) {
+    _rx.insert(_rx.end(), data.begin(), data.end());
+}
+
+void HardwareSerial::hostSend(const std::string& data) {
+    receiveWire();
+    if (_wire.empty()) {
+        _wireArrival = HostRuntime::nowMicros() + byteTime();
+    }
+    _wire.insert(_wire.end(), data.begin(), data.end());
+}
+
+// Nobody reads the port between two calls, so the bytes received meanwhile can be moved in one go
+void HardwareSerial::receiveWire() {
+    double now = static_cast<double>(HostRuntime::nowMicros());
+    while (!_wire.empty() && _wireArrival <= now) {
+        if (_rx.size() < _rxCapacity) {
+            _rx.push_back(_wire.front());
+        } else {
+            _droppedBytes++;
+        }
+        _wire.pop_front();
+        _wireArrival += byteTime();
+    }
+}
+
+double HardwareSerial::byteTime() const {
+    return 10e6 / (_baud ? _baud : 9600);
+}
+
+std::string HardwareSerial::hostTakeOutput() {
+    std::string output;
+    output.swap(_tx);
+    return output;
+}
+
+// ---- Time ----
+
+unsigned long millis() {
+    return static_cast<unsigned long>(HostRuntime::nowMicros() / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(HostRuntime::nowMicros());
+}
+
+void delay(unsigned long ms) {
+    HostRuntime::advanceMicros(static_cast<uint64_t>(ms) * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    HostRuntime::advanceMicros(us);
+}
+
+// Busy-wait loops call yield(): let them see time pass as on the target, and the boards on the other end answer
+void yield() {
+    HostRuntime::advanceMicros(10);
+    HostRuntime::servicePeer();
+}
+
+// ---- Pins ----
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    HostRuntime::pin(pin).mode = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    HostRuntime::pin(pin).digital = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return HostRuntime::pin(pin).digital;
+}
+
+int analogRead(uint8_t pin) {
+    return HostRuntime::pin(pin).analogInput;
+}
+
+void analogWrite(uint8_t pin, int value) {
+    HostRuntime::pin(pin).analogOutput = value;
+}
+
+void analogReadResolution(unsigned int bits) { (void)bits; }
+void analogWriteResolution(unsigned int bits) { (void)bits; }
+
+int digitalPinToInterrupt(uint8_t pin) {
+    return pin;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*function)(), int mode) {
+    (void)mode;
+    HostRuntime::pin(interrupt).isr = function;
+}
+
+void detachInterrupt(uint8_t interrupt) {
+    HostRuntime::pin(interrupt).isr = nullptr;
+}
+
+void noInterrupts() {}
+void interrupts() {}
+
+// ---- Random ----
+
+static uint32_t randomState = 1;
+
+long random(long max) {
+    if (max <= 0) return 0;
+    randomState = randomState * 1103515245u + 12345u;
+    return static_cast<long>((randomState >> 1) % static_cast<uint32_t>(max));
+}
+
+long random(long min, long max) {
+    return min >= max ? min : min + random(max - min);
+}
+
+void randomSeed(unsigned long seed) {
+    randomState = static_cast<uint32_t>(seed ? seed : 1);
+}
@@ -0,0 +1,631 @@
+// ArduinoJson.cpp
+#include <ArduinoJson.h>
+#include <climits>
+#include <cmath>
+
+namespace HostJson {
+
+void* Node::allocate(size_t size) {
+    if (!allocator) return nullptr;
+    void* block = allocator->allocate(size);
+    if (!block && overflowed) *overflowed = true;
+    return block;
+}
+
+void Node::release(void*& block) {
+    if (block && allocator) allocator->deallocate(block);
+    block = nullptr;
+}
+
+void Node::reset(Type newType) {
+    type = newType;
+    boolean = false;
+    integer = 0;
+    uinteger = 0;
+    number = 0;
+    text.clear();
+    release(textBlock);
+    members.clear();
+    items.clear();
+}
+
+std::unique_ptr<Node> Node::newChild() {
+    ShimHeap scope;
+    std::unique_ptr<Node> child(new Node());
+    child->allocator = allocator;
+    child->overflowed = overflowed;
+    if (allocator) {
+        child->slot = allocate(SLOT_SIZE);
+        if (!child->slot) return nullptr;
+    }
+    return child;
+}
+
+bool Node::setText(const std::string& value) {
+    ShimHeap scope;
+    reset(Text);
+    if (allocator) {
+        textBlock = allocate(STRING_HEADER_SIZE + value.size() + 1);
+        if (!textBlock) {
+            reset();
+            return false;
+        }
+    }
+    text = value;
+    return true;
+}
+
+bool Node::copyFrom(const Node& other) {
+    ShimHeap scope;
+    if (&other == this) return true;
+    if (other.type == Text) return setText(other.text);
+    reset(other.type);
+    boolean = other.boolean;
+    integer = other.integer;
+    uinteger = other.uinteger;
+    number = other.number;
+    for (const auto& m : other.members) {
+        std::unique_ptr<Node> copy = newChild();
+        if (!copy || !copy->copyFrom(*m.second)) return false;
+        members.emplace_back(m.first, std::move(copy));
+    }
+    for (const auto& item : other.items) {
+        std::unique_ptr<Node> copy = newChild();
+        if (!copy || !copy->copyFrom(*item)) return false;
+        items.push_back(std::move(copy));
+    }
+    return true;
+}
+
+Node* Node::find(const std::string& key) const {
+    if (type != Object) return nullptr;
+    for (const auto& m : members) {
+        if (m.first == key) return m.second.get();
+    }
+    return nullptr;
+}
+
+Node* Node::member(const std::string& key) {
+    ShimHeap scope;
+    if (type == Null) reset(Object);
+    if (type != Object) return nullptr;
+    if (Node* existing = find(key)) return existing;
+    std::unique_ptr<Node> child = newChild();
+    if (!child) return nullptr;
+    members.emplace_back(key, std::move(child));
+    return members.back().second.get();
+}
+
+Node* Node::element(size_t index, bool create) {
+    ShimHeap scope;
+    if (type == Null && create) reset(Array);
+    if (type != Array) return nullptr;
+    if (index < items.size()) return items[index].get();
+    if (!create) return nullptr;
+    while (items.size() <= index) {
+        if (!append()) return nullptr;
+    }
+    return items[index].get();
+}
+
+Node* Node::append() {
+    ShimHeap scope;
+    if (type == Null) reset(Array);
+    if (type != Array) return nullptr;
+    std::unique_ptr<Node> child = newChild();
+    if (!child) return nullptr;
+    items.push_back(std::move(child));
+    return items.back().get();
+}
+
+bool Node::removeMember(const std::string& key) {
+    for (auto it = members.begin(); it != members.end(); ++it) {
+        if (it->first == key) {
+            members.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---- Writer ----
+
+static void writeString(const std::string& s, std::string& out) {
+    out += '"';
+    for (unsigned char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+    out += '"';
+}
+
+// Shortest decimal form with the precision of the stored type, never in exponent form for usual magnitudes
+static void writeNumber(double value, int digits, std::string& out) {
+    if (std::isnan(value) || std::isinf(value)) {
+        out += "null";
+        return;
+    }
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.0f", value);
+        out += buffer;
+        return;
+    }
+    char buffer[64];
+    if (std::fabs(value) >= 1e-5 && std::fabs(value) < 1e15) {
+        int integerDigits = value == 0 ? 1 : static_cast<int>(std::floor(std::log10(std::fabs(value)))) + 1;
+        int decimals = std::max(0, digits - integerDigits);
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        std::string text(buffer);
+        if (text.find('.') != std::string::npos) {
+            while (!text.empty() && text.back() == '0') text.pop_back();
+            if (!text.empty() && text.back() == '.') text.pop_back();
+        }
+        out += text;
+    } else {
+        snprintf(buffer, sizeof(buffer), "%.*g", digits, value);
+        out += buffer;
+    }
+}
+
+void write(const Node* node, std::string& out) {
+    ShimHeap scope;
+    if (!node) {
+        out += "null";
+        return;
+    }
+    switch (node->type) {
+        case Node::Null: out += "null"; break;
+        case Node::Bool: out += node->boolean ? "true" : "false"; break;
+        case Node::Integer: out += std::to_string(node->integer); break;
+        case Node::Unsigned: out += std::to_string(node->uinteger); break;
+        case Node::Float: writeNumber(node->number, 7, out); break;
+        case Node::Double: writeNumber(node->number, 9, out); break;
+        case Node::Text: writeString(node->text, out); break;
+        case Node::Object: {
+            out += '{';
+            bool first = true;
+            for (const auto& m : node->members) {
+                if (!first) out += ',';
+                first = false;
+                writeString(m.first, out);
+                out += ':';
+                write(m.second.get(), out);
+            }
+            out += '}';
+            break;
+        }
+        case Node::Array: {
+            out += '[';
+            bool first = true;
+            for (const auto& item : node->items) {
+                if (!first) out += ',';
+                first = false;
+                write(item.get(), out);
+            }
+            out += ']';
+            break;
+        }
+    }
+}
+
+// ---- Parser ----
+
+namespace {
+
+struct Parser {
+    const char* p;
+    const char* end;
+    const char* error;
+
+    void skipSpaces() {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    }
+
+    bool fail(const char* message) {
+        error = message;
+        return false;
+    }
+
+    bool literal(const char* word) {
+        size_t length = strlen(word);
+        if (static_cast<size_t>(end - p) < length || strncmp(p, word, length) != 0) return fail("InvalidInput");
+        p += length;
+        return true;
+    }
+
+    static void appendUtf8(uint32_t codepoint, std::string& out) {
+        if (codepoint < 0x80) {
+            out += static_cast<char>(codepoint);
+        } else if (codepoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codepoint >> 6));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        } else if (codepoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codepoint >> 12));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codepoint >> 18));
+            out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+    }
+
+    bool string(std::string& out) {
+        p++; // opening quote
+        while (p < end && *p != '"') {
+            char c = *p++;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (p >= end) return fail("IncompleteInput");
+            char e = *p++;
+            switch (e) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    if (end - p < 4) return fail("IncompleteInput");
+                    char hex[5] = {p[0], p[1], p[2], p[3], 0};
+                    p += 4;
+                    appendUtf8(static_cast<uint32_t>(strtoul(hex, nullptr, 16)), out);
+                    break;
+                }
+                default: return fail("InvalidInput");
+            }
+        }
+        if (p >= end) return fail("IncompleteInput");
+        p++; // closing quote
+        return true;
+    }
+
+    bool number(Node& node) {
+        const char* start = p;
+        bool isFloat = false;
+        if (p < end && (*p == '-' || *p == '+')) p++;
+        while (p < end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' || *p == '-' || *p == '+')) {
+            if (*p == '.' || *p == 'e' || *p == 'E') isFloat = true;
+            p++;
+        }
+        std::string text(start, p);
+        if (text.empty() || text == "-" || text == "+") return fail("InvalidInput");
+        if (isFloat) {
+            node.reset(Node::Double);
+            node.number = strtod(text.c_str(), nullptr);
+        } else if (text[0] == '-') {
+            node.reset(Node::Integer);
+            node.integer = strtoll(text.c_str(), nullptr, 10);
+        } else {
+            unsigned long long value = strtoull(text.c_str(), nullptr, 10);
+            if (value <= static_cast<unsigned long long>(LLONG_MAX)) {
+                node.reset(Node::Integer);
+                node.integer = static_cast<long long>(value);
+            } else {
+                node.reset(Node::Unsigned);
+                node.uinteger = value;
+            }
+        }
+        return true;
+    }
+
+    bool value(Node& node, int depth) {
+        if (depth > 10) return fail("TooDeep");
+        skipSpaces();
+        if (p >= end) return fail("IncompleteInput");
+        char c = *p;
+        if (c == '{') {
+            node.reset(Node::Object);
+            p++;
+            skipSpaces();
+            if (p < end && *p == '}') {
+                p++;
+                return true;
+            }
+            while (true) {
+                skipSpaces();
+                if (p >= end) return fail("IncompleteInput");
+                if (*p != '"') return fail("InvalidInput");
+                std::string key;
+                if (!string(key)) return false;
+                skipSpaces();
+                if (p >= end) return fail("IncompleteInput");
+                if (*p++ != ':') return fail("InvalidInput");
+                Node* child = node.member(key);
+                if (!value(*child, depth + 1)) return false;
+                skipSpaces();
+                if (p >= end) return fail("IncompleteInput");
+                if (*p == ',') {
+                    p++;
+                    continue;
+                }
+                if (*p == '}') {
+                    p++;
+                    return true;
+                }
+                return fail("InvalidInput");
+            }
+        }
+        if (c == '[') {
+            node.reset(Node::Array);
+            p++;
+            skipSpaces();
+            if (p < end && *p == ']') {
+                p++;
+                return true;
+            }
+            while (true) {
+                if (!value(*node.append(), depth + 1)) return false;
+                skipSpaces();
+                if (p >= end) return fail("IncompleteInput");
+                if (*p == ',') {
+                    p++;
+                    continue;
+                }
+                if (*p == ']') {
+                    p++;
+                    return true;
+                }
+                return fail("InvalidInput");
+            }
+        }
+        if (c == '"') {
+            node.reset(Node::Text);
+            return string(node.text);
+        }
+        if (c == 't') {
+            node.reset(Node::Bool);
+            node.boolean = true;
+            return literal("true");
+        }
+        if (c == 'f') {
+            node.reset(Node::Bool);
+            return literal("false");
+        }
+        if (c == 'n') {
+            node.reset();
+            return literal("null");
+        }
+        return number(node);
+    }
+};
+
+} // namespace
+
+bool parse(const char* input, size_t length, Node& node, const char** error) {
+    Parser parser{input, input + length, nullptr};
+    parser.skipSpaces();
+    if (parser.p >= parser.end) {
+        *error = "EmptyInput";
+        return false;
+    }
+    if (!parser.value(node, 0)) {
+        *error = parser.error;
+        return false;
+    }
+    return true;
+}
+
+} // namespace HostJson
+
+// ---- JsonVariant ----
+
+HostJson::Node* JsonVariant::node(bool create) const {
+    HostJson::ShimHeap scope;
+    if (_node) return _node;
+    if (!_parent) return nullptr;
+    HostJson::Node* parent = _parent->node(create);
+    if (!parent) return nullptr;
+    if (_index < 0) {
+        return create ? parent->member(_key) : parent->find(_key);
+    }
+    return parent->element(static_cast<size_t>(_index), create);
+}
+
+JsonVariant JsonVariant::child(const char* key) const {
+    HostJson::ShimHeap scope;
+    JsonVariant proxy;
+    proxy._parent = std::make_shared<JsonVariant>(*this);
+    proxy._key = key;
+    return proxy;
+}
+
+JsonVariant JsonVariant::element(size_t index) const {
+    HostJson::ShimHeap scope;
+    JsonVariant proxy;
+    proxy._parent = std::make_shared<JsonVariant>(*this);
+    proxy._index = static_cast<long>(index);
+    return proxy;
+}
+
+bool JsonVariant::set(const char* value) {
+    HostJson::ShimHeap scope;
+    if (!value) return set(nullptr);
+    std::string copy(value);
+    HostJson::Node* n = node(true);
+    return n && n->setText(copy);
+}
+
+bool JsonVariant::set(const JsonVariant& value) {
+    HostJson::ShimHeap scope;
+    HostJson::Node copy;
+    if (const HostJson::Node* source = value.node(false)) copy.copyFrom(*source);
+    HostJson::Node* n = node(true);
+    return n && n->copyFrom(copy);
+}
+
+bool JsonVariant::isNull() const {
+    const HostJson::Node* n = node(false);
+    return !n || n->type == HostJson::Node::Null;
+}
+
+size_t JsonVariant::size() const {
+    const HostJson::Node* n = node(false);
+    return n ? n->size() : 0;
+}
+
+bool JsonVariant::containsKey(const char* key) const {
+    HostJson::ShimHeap scope;
+    const HostJson::Node* n = node(false);
+    return n && n->find(key) != nullptr;
+}
+
+void JsonVariant::remove(const char* key) {
+    HostJson::ShimHeap scope;
+    HostJson::Node* n = node(false);
+    if (n) n->removeMember(key);
+}
+
+void JsonVariant::clear() {
+    HostJson::Node* n = node(false);
+    if (n) {
+        HostJson::Node::Type type = n->type;
+        n->reset(type == HostJson::Node::Object || type == HostJson::Node::Array ? type : HostJson::Node::Null);
+    }
+}
+
+JsonObject JsonVariant::createNestedObject(const char* key) {
+    return (*this)[key].to<JsonObject>();
+}
+
+JsonObject JsonVariant::createNestedObject(const String& key) {
+    return (*this)[key].to<JsonObject>();
+}
+
+JsonArray JsonVariant::createNestedArray(const char* key) {
+    return (*this)[key].to<JsonArray>();
+}
+
+JsonObject JsonVariant::createNestedObject() {
+    return add().to<JsonObject>();
+}
+
+JsonArray JsonVariant::createNestedArray() {
+    return add().to<JsonArray>();
+}
+
+JsonVariant JsonVariant::add() {
+    HostJson::ShimHeap scope;
+    HostJson::Node* n = node(true);
+    if (!n) return JsonVariant();
+    HostJson::Node* item = n->append();
+    return item ? JsonVariant(item) : JsonVariant();
+}
+
+// ---- JsonDocument ----
+
+JsonDocument::JsonDocument() {
+    HostJson::ShimHeap scope;
+    _root.reset(new HostJson::Node());
+    _overflowed.reset(new bool(false));
+    _node = _root.get();
+}
+
+JsonDocument::JsonDocument(ArduinoJson::Allocator* allocator) : JsonDocument() {
+    _root->allocator = allocator;
+    _root->overflowed = _overflowed.get();
+}
+
+JsonDocument::JsonDocument(const JsonDocument& other) : JsonDocument() {
+    _root->copyFrom(*other._root);
+}
+
+JsonDocument& JsonDocument::operator=(const JsonDocument& other) {
+    *_overflowed = false;
+    _root->copyFrom(*other._root);
+    return *this;
+}
+
+// ---- Serialization ----
+
+const char* DeserializationError::c_str() const {
+    switch (_code) {
+        case Ok: return "Ok";
+        case EmptyInput: return "EmptyInput";
+        case IncompleteInput: return "IncompleteInput";
+        case InvalidInput: return "InvalidInput";
+        case NoMemory: return "NoMemory";
+        case TooDeep: return "TooDeep";
+    }
+    return "Unknown";
+}
+
+DeserializationError deserializeJson(JsonVariant destination, const char* input, size_t length) {
+    HostJson::ShimHeap scope;
+    HostJson::Node* target = destination.node(true);
+    if (!target) return DeserializationError::NoMemory;
+    const char* error = nullptr;
+    HostJson::Node parsed;
+    if (!input || !HostJson::parse(input, length, parsed, &error)) {
+        target->reset();
+        if (!input || strcmp(error, "EmptyInput") == 0) return DeserializationError::EmptyInput;
+        if (strcmp(error, "IncompleteInput") == 0) return DeserializationError::IncompleteInput;
+        if (strcmp(error, "TooDeep") == 0) return DeserializationError::TooDeep;
+        return DeserializationError::InvalidInput;
+    }
+    if (!target->copyFrom(parsed)) {
+        target->reset();
+        return DeserializationError::NoMemory;
+    }
+    return DeserializationError::Ok;
+}
+
+size_t serializeJson(const JsonVariant& source, std::string& output) {
+    HostJson::ShimHeap scope;
+    size_t before = output.size();
+    HostJson::write(source.node(false), output);
+    return output.size() - before;
+}
+
+size_t serializeJson(const JsonVariant& source, String& output) {
+    HostJson::ShimHeap scope;
+    std::string text;
+    serializeJson(source, text);
+    output += text.c_str();
+    return text.size();
+}
+
+size_t serializeJson(const JsonVariant& source, Print& output) {
+    HostJson::ShimHeap scope;
+    std::string text;
+    serializeJson(source, text);
+    return output.write(text.data(), text.size());
+}
+
+size_t serializeJson(const JsonVariant& source, char* buffer, size_t size) {
+    HostJson::ShimHeap scope;
+    if (!buffer || size == 0) return 0;
+    std::string text;
+    serializeJson(source, text);
+    size_t count = std::min(text.size(), size - 1);
+    memcpy(buffer, text.data(), count);
+    buffer[count] = '\0';
+    return count;
+}
+
+size_t measureJson(const JsonVariant& source) {
+    HostJson::ShimHeap scope;
+    std::string text;
+    return serializeJson(source, text);
+}
@@ -0,0 +1,30 @@
+// DFRobot_PH.h
+// DFRobot Gravity pH meter library, used by the Uno transmitter sketch: the library's two-point line through the
+// default calibration (pH 7.0 at 1500 mV, pH 4.0 at 2032.44 mV). Calibration commands are accepted and ignored.
+#ifndef HOST_DFROBOT_PH_H
+#define HOST_DFROBOT_PH_H
+#include <Arduino.h>
+
+class DFRobot_PH {
+public:
+    void begin() {}
+
+    float readPH(float voltage, float temperature) {
+        (void)temperature;
+        float slope = (7.0 - 4.0) / ((_neutralVoltage - 1500.0) / 3.0 - (_acidVoltage - 1500.0) / 3.0);
+        float intercept = 7.0 - slope * (_neutralVoltage - 1500.0) / 3.0;
+        return slope * (voltage - 1500.0) / 3.0 + intercept;
+    }
+
+    void calibration(float voltage, float temperature, char* cmd) {
+        (void)voltage;
+        (void)temperature;
+        (void)cmd;
+    }
+
+private:
+    float _neutralVoltage = 1500.0;
+    float _acidVoltage = 2032.44;
+};
+
+#endif
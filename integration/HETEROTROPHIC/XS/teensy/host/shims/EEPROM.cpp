@@ -0,0 +1,41 @@
+// EEPROM.cpp
+#include <EEPROM.h>
+#include <unistd.h>
+
+EEPROMClass EEPROM;
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (!inRange(address)) return;
+    _writes++;
+    if (_killAt != 0 && _writes >= _killAt) {
+        // Power lost before this byte reached the cell: nothing else is flushed
+        _exit(_killCode);
+    }
+    _data[address] = value;
+    if (_file) {
+        fseek(_file, address, SEEK_SET);
+        fputc(value, _file);
+        fflush(_file);
+    }
+}
+
+void EEPROMClass::hostAttachFile(const char* path) {
+    if (_file) fclose(_file);
+    _file = fopen(path, "r+b");
+    if (_file) {
+        size_t count = fread(_data, 1, SIZE, _file);
+        if (count < static_cast<size_t>(SIZE)) memset(_data + count, 0xFF, SIZE - count);
+    } else {
+        memset(_data, 0xFF, sizeof(_data));
+        _file = fopen(path, "w+b");
+        if (_file) {
+            fwrite(_data, 1, SIZE, _file);
+            fflush(_file);
+        }
+    }
+}
+
+void EEPROMClass::hostKillAtWrite(unsigned long count, int exitCode) {
+    _killAt = count == 0 ? 0 : _writes + count;
+    _killCode = exitCode;
+}
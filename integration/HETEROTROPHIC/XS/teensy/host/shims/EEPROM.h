@@ -0,0 +1,52 @@
+// EEPROM.h
+// Teensy 4.1 emulated EEPROM (4284 bytes, erased to 0xFF). The content can be kept in a file so that
+// a second process resumes from what the first one wrote, and the process can be killed in the middle
+// of a write sequence to check what survives a power loss.
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+#include <Arduino.h>
+
+class EEPROMClass {
+public:
+    static const int SIZE = 4284;
+
+    EEPROMClass() { memset(_data, 0xFF, sizeof(_data)); }
+
+    uint8_t read(int address) { return inRange(address) ? _data[address] : 0; }
+    void write(int address, uint8_t value);
+    void update(int address, uint8_t value) {
+        if (read(address) != value) write(address, value);
+    }
+    uint16_t length() { return SIZE; }
+
+    template<class T> T& get(int address, T& value) {
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(&value);
+        for (size_t i = 0; i < sizeof(T); i++) bytes[i] = read(address + i);
+        return value;
+    }
+    template<class T> const T& put(int address, const T& value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        for (size_t i = 0; i < sizeof(T); i++) update(address + i, bytes[i]);
+        return value;
+    }
+
+    // Host side
+    // Load the content from path (erased if the file does not exist) and write every change through to it
+    void hostAttachFile(const char* path);
+    // End the process with exit code 'exitCode' instead of performing write number 'count' (0 = never)
+    void hostKillAtWrite(unsigned long count, int exitCode);
+    unsigned long hostWriteCount() const { return _writes; }
+
+private:
+    uint8_t _data[SIZE];
+    FILE* _file = nullptr;
+    unsigned long _writes = 0;
+    unsigned long _killAt = 0;
+    int _killCode = 0;
+
+    static bool inRange(int address) { return address >= 0 && address < SIZE; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
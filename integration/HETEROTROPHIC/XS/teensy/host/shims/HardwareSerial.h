@@ -0,0 +1,5 @@
+// HardwareSerial.h
+#ifndef HOST_HARDWARE_SERIAL_H
+#define HOST_HARDWARE_SERIAL_H
+#include <Arduino.h>
+#endif
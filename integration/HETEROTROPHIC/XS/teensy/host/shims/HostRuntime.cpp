@@ -0,0 +1,44 @@
+// HostRuntime.cpp
+#include "HostRuntime.h"
+#include <Arduino.h>
+
+void setup();
+void loop();
+
+uint64_t HostRuntime::clockMicros = 0;
+void (*HostRuntime::peer)() = nullptr;
+
+HostRuntime::Pin& HostRuntime::pin(uint8_t number) {
+    static Pin pins[256];
+    return pins[number];
+}
+
+void HostRuntime::boot() {
+    setup();
+}
+
+void HostRuntime::runFor(uint64_t durationMs, uint32_t tickUs) {
+    uint64_t end = clockMicros + durationMs * 1000;
+    while (clockMicros < end) {
+        loop();
+        // Nothing is due right after the tasks have run: this pass runs the scheduler idle task
+        // (SD card writes), as loop() spinning between two tasks does on the target
+        loop();
+        servicePeer();
+        clockMicros += tickUs;
+    }
+}
+
+void HostRuntime::command(const std::string& line, uint32_t tickUs) {
+    Serial.hostInject(line + "\n");
+    // The command task runs every 10 ms, one pass past its period reads the whole line
+    runFor(20, tickUs);
+}
+
+void HostRuntime::setConsoleEcho(bool enabled) {
+    Serial.hostSetEcho(enabled ? stdout : nullptr);
+}
+
+std::string HostRuntime::takeConsole() {
+    return Serial.hostTakeOutput();
+}
@@ -0,0 +1,61 @@
+// HostRuntime.h
+// Drives the sketch on the host: virtual clock, pin states and the setup()/loop() calls.
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+#include <stdint.h>
+#include <string>
+
+class HardwareSerial;
+
+class HostRuntime {
+public:
+    struct Pin {
+        uint8_t mode = 0;
+        uint8_t digital = 0;
+        int analogInput = 0;
+        int analogOutput = 0;
+        void (*isr)() = nullptr;
+    };
+
+    // Virtual time since boot; only delay() and the functions below move it
+    static uint64_t nowMicros() { return clockMicros; }
+    static void advanceMicros(uint64_t us) { clockMicros += us; }
+    static void advanceMillis(uint64_t ms) { clockMicros += ms * 1000; }
+
+    static Pin& pin(uint8_t number);
+
+    // Run the sketch setup() (once per process: the sketch objects are globals)
+    static void boot();
+
+    /*
+     * Call loop() until the virtual clock has moved by duration, advancing it by tick after every two passes
+     * (the second one finds no due task and runs the idle task).
+     * The sketch tasks run every 10 ms or more, a 10 ms tick runs each of them on time with the fewest passes.
+     */
+    static void runFor(uint64_t durationMs, uint32_t tickUs = 10000);
+
+    // Type a command in the Serial Monitor and run the loop long enough for the command task to read it
+    static void command(const std::string& line, uint32_t tickUs = 10000);
+
+    /*
+     * Another board on a serial link (e.g. the pH/O2 transmitter): service is called after every two loop() passes
+     * of runFor() and from yield(), so that a blocking request of the sketch gets its answer while it waits.
+     */
+    static void setPeer(void (*service)()) { peer = service; }
+    static void servicePeer() {
+        if (peer) peer();
+    }
+
+    // Echo the console output to stdout (off by default, the output is also kept in Serial)
+    static void setConsoleEcho(bool enabled);
+
+    // Console output since the last call
+    static std::string takeConsole();
+
+private:
+    static uint64_t clockMicros;
+    static void (*peer)();
+};
+
+#endif // HOST_RUNTIME_H
@@ -0,0 +1,108 @@
+// OneWire.h
+// 1-Wire bus. By default no device answers the search and reset() reports no presence pulse. A test can put a
+// DS18B20 on a pin: it answers the ROM search, converts in conversionMs of virtual time (the scratchpad holds the
+// 85 C power-on value until then), and every reset and byte slot takes its time on the bus.
+#ifndef HOST_ONE_WIRE_H
+#define HOST_ONE_WIRE_H
+#include <Arduino.h>
+#include "HostRuntime.h"
+
+class OneWire {
+public:
+    // Bus timing at standard speed (us)
+    static const uint32_t RESET_US = 960;
+    static const uint32_t BYTE_US = 8 * 70;
+
+    struct HostDS18B20 {
+        bool present = false;
+        float temperature = 0;
+        uint32_t conversionMs = 750;
+        uint64_t conversionEnd = 0;     // Virtual us at which the last conversion completes
+    };
+
+    // Host side: DS18B20 on pin
+    static void hostAttachDS18B20(uint8_t pin, float temperature, uint32_t conversionMs = 750) {
+        HostDS18B20& device = hostDevice(pin);
+        device.present = true;
+        device.temperature = temperature;
+        device.conversionMs = conversionMs;
+        device.conversionEnd = 0;
+    }
+    static HostDS18B20& hostDevice(uint8_t pin) {
+        static HostDS18B20 devices[256];
+        return devices[pin];
+    }
+
+    explicit OneWire(uint8_t pin) : _pin(pin) {}
+
+    uint8_t reset() {
+        HostRuntime::advanceMicros(RESET_US);
+        _readIndex = -1;
+        return device().present ? 1 : 0;
+    }
+    void select(const uint8_t* rom) {
+        (void)rom;
+        HostRuntime::advanceMicros(9 * BYTE_US);
+    }
+    void skip() { HostRuntime::advanceMicros(BYTE_US); }
+    void write(uint8_t value, uint8_t power = 0) {
+        (void)power;
+        HostRuntime::advanceMicros(BYTE_US);
+        if (!device().present) return;
+        if (value == 0x44) {                // Convert T
+            device().conversionEnd = HostRuntime::nowMicros() + device().conversionMs * 1000ULL;
+        } else if (value == 0xBE) {         // Read scratchpad
+            fillScratchpad();
+            _readIndex = 0;
+        }
+    }
+    uint8_t read() {
+        HostRuntime::advanceMicros(BYTE_US);
+        if (_readIndex < 0 || _readIndex >= 9) return 0xFF;
+        return _scratchpad[_readIndex++];
+    }
+    uint8_t read_bit() { return 1; }
+    bool search(uint8_t* address, bool searchMode = true) {
+        (void)searchMode;
+        if (!device().present || _searched) return false;
+        _searched = true;
+        const uint8_t rom[7] = {0x28, 0x61, 0x64, 0x12, 0x3C, 0x7A, _pin};
+        memcpy(address, rom, 7);
+        address[7] = crc8(address, 7);
+        return true;
+    }
+    void reset_search() { _searched = false; }
+
+    static uint8_t crc8(const uint8_t* address, uint8_t length) {
+        uint8_t crc = 0;
+        while (length--) {
+            uint8_t inbyte = *address++;
+            for (uint8_t i = 8; i; i--) {
+                uint8_t mix = (crc ^ inbyte) & 0x01;
+                crc >>= 1;
+                if (mix) crc ^= 0x8C;
+                inbyte >>= 1;
+            }
+        }
+        return crc;
+    }
+
+private:
+    uint8_t _pin;
+    bool _searched = false;
+    int _readIndex = -1;
+    uint8_t _scratchpad[9];
+
+    HostDS18B20& device() { return hostDevice(_pin); }
+
+    void fillScratchpad() {
+        bool converted = device().conversionEnd != 0 && HostRuntime::nowMicros() >= device().conversionEnd;
+        int16_t raw = static_cast<int16_t>((converted ? device().temperature : 85.0f) * 16);
+        const uint8_t data[8] = {static_cast<uint8_t>(raw & 0xFF), static_cast<uint8_t>(raw >> 8), 0x4B, 0x46,
+                                 0x7F, 0xFF, 0x0C, 0x10};
+        memcpy(_scratchpad, data, 8);
+        _scratchpad[8] = crc8(data, 8);
+    }
+};
+
+#endif
@@ -0,0 +1,105 @@
+// SD.cpp
+#include <SD.h>
+#include <sys/stat.h>
+#include "HostRuntime.h"
+
+SDClass SD;
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!_file) return 0;
+    if (SD._writeLimited) {
+        if (SD._writeBudget < size) return 0;
+        SD._writeBudget -= size;
+    }
+    SD._writes++;
+    HostRuntime::advanceMicros(SD._writeUs);
+    if (SD._stallEvery > 0 && SD._writes % SD._stallEvery == 0) HostRuntime::advanceMicros(SD._stallUs);
+    return fwrite(buffer, 1, size, _file.get());
+}
+
+int File::read(void* buffer, size_t size) {
+    if (!_file) return -1;
+    return static_cast<int>(fread(buffer, 1, size, _file.get()));
+}
+
+int File::read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+}
+
+int File::available() {
+    if (!_file) return 0;
+    long position = ftell(_file.get());
+    return static_cast<int>(size() - position);
+}
+
+void File::flush() {
+    if (!_file) return;
+    HostRuntime::advanceMicros(SD._flushUs);
+    fflush(_file.get());
+}
+
+void File::close() {
+    _file.reset();
+    _dir.reset();
+}
+
+uint64_t File::size() {
+    if (_file) fflush(_file.get());
+    struct stat st;
+    return stat(_path.c_str(), &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+}
+
+File File::openNextFile(uint8_t mode) {
+    File entry;
+    if (!_dir) return entry;
+    while (dirent* d = readdir(_dir.get())) {
+        if (d->d_name[0] == '.') continue;
+        entry._name = d->d_name;
+        entry._path = _path + "/" + d->d_name;
+        FILE* f = fopen(entry._path.c_str(), mode == FILE_WRITE ? "ab" : "rb");
+        if (f) entry._file.reset(f, fclose);
+        return entry;
+    }
+    return entry;
+}
+
+bool SDClass::begin(uint8_t csPin) {
+    (void)csPin;
+    struct stat st;
+    _mounted = !_root.empty() && stat(_root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    return _mounted;
+}
+
+std::string SDClass::fullPath(const char* path) const {
+    std::string p(path ? path : "");
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return p == "/" ? _root : _root + p;
+}
+
+bool SDClass::exists(const char* path) {
+    struct stat st;
+    return _mounted && stat(fullPath(path).c_str(), &st) == 0;
+}
+
+File SDClass::open(const char* path, uint8_t mode) {
+    File file;
+    _opens++;
+    if (!_mounted || _failOpen) return file;
+    file._path = fullPath(path);
+    std::string name(path);
+    file._name = name.substr(name.find_last_of('/') == std::string::npos ? 0 : name.find_last_of('/') + 1);
+    struct stat st;
+    if (stat(file._path.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(file._path.c_str());
+        if (dir) file._dir.reset(dir, closedir);
+        return file;
+    }
+    FILE* f = fopen(file._path.c_str(), mode == FILE_WRITE ? "ab+" : "rb");
+    if (f) file._file.reset(f, fclose);
+    return file;
+}
+
+bool SDClass::remove(const char* path) {
+    return _mounted && ::remove(fullPath(path).c_str()) == 0;
+}
@@ -0,0 +1,84 @@
+// SD.h
+// Teensy SD library on a host directory. Nothing is mounted until the test sets the directory:
+// SD.begin() fails like a board without a card.
+#ifndef HOST_SD_H
+#define HOST_SD_H
+#include <Arduino.h>
+#include <memory>
+#include <dirent.h>
+
+#define BUILTIN_SDCARD 254
+#define FILE_READ 0
+#define FILE_WRITE 1
+
+class File {
+public:
+    File() {}
+    explicit operator bool() const { return _file || _dir; }
+
+    size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* buffer, size_t size) { return write(reinterpret_cast<const uint8_t*>(buffer), size); }
+    int read(void* buffer, size_t size);
+    int read();
+    int available();
+    void flush();
+    void close();
+    uint64_t size();
+    const char* name() const { return _name.c_str(); }
+    bool isDirectory() const { return static_cast<bool>(_dir); }
+    File openNextFile(uint8_t mode = FILE_READ);
+
+private:
+    friend class SDClass;
+    std::shared_ptr<FILE> _file;
+    std::shared_ptr<DIR> _dir;
+    std::string _path;
+    std::string _name;
+};
+
+class SDClass {
+public:
+    bool begin(uint8_t csPin);
+    bool exists(const char* path);
+    File open(const char* path, uint8_t mode = FILE_READ);
+    bool remove(const char* path);
+
+    // Host side
+    void hostSetRoot(const std::string& directory) { _root = directory; }
+    // Make every following open() fail (card removed, file system full...)
+    void hostFailOpen(bool fail) { _failOpen = fail; }
+    // Make every write() fail once 'bytes' more bytes have been written (0 = never)
+    void hostFailWritesAfter(uint64_t bytes) { _writeLimited = bytes != 0; _writeBudget = bytes; }
+    // Calls of open(), failed ones included
+    unsigned long hostOpenCount() const { return _opens; }
+    /*
+     * Card timing on the virtual clock: every write() takes writeUs, every stallEvery-th one stallUs more (the card
+     * erasing a block), every flush() takes flushUs. All 0 (the default): the card takes no time.
+     */
+    void hostSetLatency(uint32_t writeUs, uint32_t flushUs, uint32_t stallEvery = 0, uint32_t stallUs = 0) {
+        _writeUs = writeUs;
+        _flushUs = flushUs;
+        _stallEvery = stallEvery;
+        _stallUs = stallUs;
+    }
+
+private:
+    friend class File;
+    std::string _root;
+    bool _mounted = false;
+    bool _failOpen = false;
+    bool _writeLimited = false;
+    uint64_t _writeBudget = 0;
+    unsigned long _opens = 0;
+    uint32_t _writeUs = 0;
+    uint32_t _flushUs = 0;
+    uint32_t _stallEvery = 0;
+    uint32_t _stallUs = 0;
+    unsigned long _writes = 0;
+
+    std::string fullPath(const char* path) const;
+};
+
+extern SDClass SD;
+
+#endif
@@ -0,0 +1,12 @@
+// SoftwareSerial.h
+#ifndef HOST_SOFTWARE_SERIAL_H
+#define HOST_SOFTWARE_SERIAL_H
+#include <Arduino.h>
+
+class SoftwareSerial : public HardwareSerial {
+public:
+    SoftwareSerial(uint8_t rxPin, uint8_t txPin) { (void)rxPin; (void)txPin; }
+    bool listen() { return true; }
+};
+
+#endif
@@ -0,0 +1,4 @@
+// Wire.cpp
+#include <Wire.h>
+
+TwoWire Wire, Wire1, Wire2;
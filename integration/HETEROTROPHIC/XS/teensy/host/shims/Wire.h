@@ -0,0 +1,23 @@
+// Wire.h
+// I2C buses without devices: transmissions succeed and are discarded.
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+#include <Arduino.h>
+
+class TwoWire {
+public:
+    void begin() {}
+    void setSDA(uint8_t pin) { (void)pin; }
+    void setSCL(uint8_t pin) { (void)pin; }
+    void setClock(uint32_t frequency) { (void)frequency; }
+    void beginTransmission(uint8_t address) { (void)address; }
+    uint8_t endTransmission(bool sendStop = true) { (void)sendStop; return 0; }
+    size_t write(uint8_t b) { (void)b; return 1; }
+    uint8_t requestFrom(uint8_t address, uint8_t count) { (void)address; (void)count; return 0; }
+    int available() { return 0; }
+    int read() { return -1; }
+};
+
+extern TwoWire Wire, Wire1, Wire2;
+
+#endif
@@ -0,0 +1,71 @@
+// UnoTransmitter.cpp
+// The Uno sketch sources are included in namespace UnoTransmitter: its classes do not clash with the Teensy ones of
+// the same name, and its Serial, EEPROM, analogRead() and delay() are the ones below rather than the Teensy's.
+// The Uno runs alongside the Teensy: its delays do not move the shared clock, they hold its answer back instead.
+#include "UnoTransmitter.h"
+#include "HostRuntime.h"
+#include <EEPROM.h>
+#include <SoftwareSerial.h>
+
+namespace UnoTransmitter {
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+
+static int analogInputs[256];
+
+int analogRead(uint8_t pin) {
+    return analogInputs[pin];
+}
+
+static uint64_t busyUntil = 0;      // Virtual time at which the Uno is done with the command in progress
+static std::string answer;          // Written by the command in progress, sent at busyUntil
+
+void delay(unsigned long ms) {
+    busyUntil += ms * 1000ULL;
+}
+
+void setup();
+void loop();
+String handleCommand(const String& command);
+
+#include "../../../arduino_uno/sensor_transmitter/sensor_transmitter.ino"
+#include "../../../arduino_uno/sensor_transmitter/SensorController.cpp"
+#include "../../../arduino_uno/sensor_transmitter/PHSensor.cpp"
+#include "../../../arduino_uno/sensor_transmitter/OxygenSensor.cpp"
+
+static HardwareSerial* teensyLink = nullptr;
+
+void boot(HardwareSerial& link) {
+    busyUntil = HostRuntime::nowMicros();
+    setup();
+    teensyLink = &link;
+    HostRuntime::setPeer(service);
+}
+
+void service() {
+    static bool servicing = false;
+    if (!teensyLink || servicing) return;
+    servicing = true;
+    std::string request = teensyLink->hostTakeOutput();
+    if (!request.empty()) teensySerial.hostInject(request);
+    while (HostRuntime::nowMicros() >= busyUntil) {
+        if (!answer.empty()) teensyLink->hostInject(answer);
+        answer.clear();
+        if (!teensySerial.available()) break;
+        busyUntil = HostRuntime::nowMicros();
+        loop();
+        answer = teensySerial.hostTakeOutput();
+    }
+    servicing = false;
+}
+
+void setAnalogInput(uint8_t pin, int value) {
+    analogInputs[pin] = value;
+}
+
+std::string takeConsole() {
+    return Serial.hostTakeOutput();
+}
+
+}
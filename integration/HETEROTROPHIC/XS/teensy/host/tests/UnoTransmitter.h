@@ -0,0 +1,26 @@
+// UnoTransmitter.h
+// The pH/O2 transmitter sketch (arduino_uno/sensor_transmitter) built on the host in its own namespace, wired to a
+// serial port of the Teensy sketch. The Uno has its own console, EEPROM and analog inputs.
+#ifndef UNO_TRANSMITTER_H
+#define UNO_TRANSMITTER_H
+
+#include <Arduino.h>
+#include <string>
+
+namespace UnoTransmitter {
+
+// Run the Uno setup() and answer the Teensy on link from then on (HostRuntime peer)
+void boot(HardwareSerial& link);
+
+// Move the bytes written on each side to the other one and let the Uno loop() handle what it received
+void service();
+
+// Raw ADC value (0-1023) of an Uno analog input
+void setAnalogInput(uint8_t pin, int value);
+
+// Uno console output since the last call
+std::string takeConsole();
+
+}
+
+#endif // UNO_TRANSMITTER_H
@@ -0,0 +1,100 @@
+// Periodic data streamed from the frame pool (DataCollector::writeAllData): the bytes are those of collectAllData()
+// for the same state, building and writing a frame takes no heap, and the bytes and time per frame of both paths.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <new>
+#include <string>
+#include "DataCollector.h"
+#include "Logger.h"
+#include "StateMachine.h"
+
+extern DataCollector dataCollector;
+extern StateMachine stateMachine;
+
+// Heap allocations of the sketch, the host JSON shim's own tree excepted (the library keeps it in the frame pool)
+static std::atomic<unsigned long> heapAllocations(0);
+
+void* operator new(size_t size) {
+    if (!HostJson::ShimHeap::active()) heapAllocations++;
+    void* block = malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+void operator delete(void* block) noexcept { free(block); }
+void operator delete(void* block, size_t) noexcept { free(block); }
+
+// Print into a fixed buffer, as the UART does into its FIFO
+class FixedPrint : public Print {
+public:
+    size_t write(uint8_t b) override {
+        if (length >= sizeof(data)) return 0;
+        data[length++] = b;
+        return 1;
+    }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        size_t written = 0;
+        while (written < size && write(buffer[written])) written++;
+        return written;
+    }
+    char data[4096];
+    size_t length = 0;
+};
+
+int main() {
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    HostRuntime::command("mix 50");
+    HostRuntime::runFor(60000);
+    String program = stateMachine.getCurrentProgram();
+    int state = static_cast<int>(stateMachine.getCurrentState());
+
+    // Same bytes through String, char buffer and Print
+    String reference = dataCollector.collectAllData(program, state);
+    static char buffer[4096];
+    size_t length = dataCollector.writeAllData(buffer, sizeof(buffer), program, state);
+    CHECK(length == reference.length());
+    CHECK(std::string(buffer, length) == reference.c_str());
+    static FixedPrint output;
+    CHECK(dataCollector.writeAllData(output, program, state) == reference.length());
+    CHECK(std::string(output.data, output.length) == reference.c_str());
+    // A buffer one byte short (no room for the NUL) gets nothing rather than a cut frame
+    CHECK(dataCollector.writeAllData(buffer, reference.length(), program, state) == 0);
+
+    // The console line is the one Logger::log would print
+    HostRuntime::takeConsole();
+    Logger::logAllData(program, state);
+    std::string console = HostRuntime::takeConsole();
+    CHECK(console == std::string("INFO: Periodic Event :") + reference.c_str() + "\r\n");
+
+    // No heap for the pool paths
+    unsigned long before = heapAllocations;
+    for (int i = 0; i < 100; i++) {
+        dataCollector.writeAllData(buffer, sizeof(buffer), program, state);
+        output.length = 0;
+        dataCollector.writeAllData(output, program, state);
+    }
+    unsigned long poolAllocations = heapAllocations - before;
+    printf("heap allocations for 200 pool frames: %lu\n", poolAllocations);
+    CHECK(poolAllocations == 0);
+
+    // Bytes and time per frame
+    const int FRAMES = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; i++) {
+        String frame = dataCollector.collectAllData(program, state);
+        CHECK(frame.length() == length);
+    }
+    double stringUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; i++) {
+        output.length = 0;
+        dataCollector.writeAllData(output, program, state);
+    }
+    double poolUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    printf("%u bytes per frame: collectAllData %.2f us, writeAllData %.2f us per frame\n",
+           static_cast<unsigned>(length), stringUs / FRAMES, poolUs / FRAMES);
+    return testResult();
+}
@@ -0,0 +1,95 @@
+// Relay autotune of the temperature loop on the plant model, then the same warm-up to 37 C with the default gains and
+// with the tuned ones: the tuned loop settles within +/-0.3 C, sooner than the default one (which holds the culture
+// under the setpoint). Each run is a child process with its own sketch.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <math.h>
+#include <string>
+#include "PlantSimulator.h"
+#include "StateMachine.h"
+
+extern StateMachine stateMachine;
+
+static const float SETPOINT = 37.0f;
+static const float BAND = 0.3f;
+static const unsigned long RUN_SECONDS = 6 * 3600;
+static const unsigned long SAMPLE_SECONDS = 10;
+
+// Warm-up from ambient under a fermentation program: settling time (s, -1 if still outside the band at the end)
+// and the mean error over the last hour (mC)
+static void warmUp(int fd) {
+    HostRuntime::command("fermentation 37 7 6 5 1.5 12 2 Autotune \"settling\"");
+    float start = PlantSimulator::getValue(SensorId::WaterTemp);
+    long settledAt = 0;
+    double lastHourError = 0;
+    int lastHourSamples = 0;
+    for (unsigned long t = SAMPLE_SECONDS; t <= RUN_SECONDS; t += SAMPLE_SECONDS) {
+        HostRuntime::runFor(SAMPLE_SECONDS * 1000);
+        float error = PlantSimulator::getValue(SensorId::WaterTemp) - SETPOINT;
+        if (fabsf(error) > BAND) settledAt = -1;
+        else if (settledAt <= 0) settledAt = t;
+        if (t > RUN_SECONDS - 3600) {
+            lastHourError += error;
+            lastHourSamples++;
+        }
+        if (t % 3600 == 0) HostRuntime::takeConsole();
+    }
+    std::string settling = settledAt < 0 ? "not settled" : "settled after " + std::to_string(settledAt) + " s";
+    printf("  from %.1f C: %s, last hour mean error %+.2f C\n", start, settling.c_str(),
+           lastHourError / lastHourSamples);
+    fflush(stdout);     // The child leaves with _exit()
+    sendToParent(fd, settledAt);
+    sendToParent(fd, static_cast<long>(lastHourError / lastHourSamples * 1000));
+}
+
+static void defaultGains(int fd) {
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    warmUp(fd);
+}
+
+static void tunedGains(int fd) {
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    HostRuntime::takeConsole();
+    HostRuntime::command("autotune temperature 37");
+    std::string console;
+    for (int minutes = 0; minutes < 8 * 60 && stateMachine.getCurrentProgram() == "Autotune"; minutes++) {
+        HostRuntime::runFor(60000);
+        console += HostRuntime::takeConsole();
+    }
+    size_t result = console.find("loop completed - Ku: ");
+    printf("  %s\n", result == std::string::npos ? "autotune did not complete"
+                                                  : console.substr(result, console.find('\n', result) - result).c_str());
+    sendToParent(fd, result != std::string::npos);
+
+    // Back to ambient: the simulation restarts from the measured (host) water temperature
+    HostRuntime::command("simulate stop");
+    HostRuntime::runFor(10000);
+    HostRuntime::command("simulate start 1");
+    warmUp(fd);
+}
+
+int main() {
+    double wallStart = wallSeconds();
+    std::vector<long> results;
+
+    printf("default gains:\n");
+    CHECK(runChild(defaultGains, results) == 0 && results.size() == 2);
+    long defaultSettling = results.size() == 2 ? results[0] : -1;
+    long defaultError = results.size() == 2 ? results[1] : 0;
+
+    printf("autotuned gains:\n");
+    CHECK(runChild(tunedGains, results) == 0 && results.size() == 3);
+    CHECK(results.size() == 3 && results[0] == 1);
+    long tunedSettling = results.size() == 3 ? results[1] : -1;
+    long tunedError = results.size() == 3 ? results[2] : 0;
+
+    CHECK(tunedSettling > 0 && tunedSettling <= 30 * 60);
+    CHECK(defaultSettling < 0 || tunedSettling < defaultSettling);
+    CHECK(labs(tunedError) < labs(defaultError));
+    CHECK(labs(tunedError) < 100);
+    printf("%.1f s wall\n", wallSeconds() - wallStart);
+    return testResult();
+}
@@ -0,0 +1,98 @@
+// Crash-safe fermentation: the sketch runs an 8 h fermentation on the plant model and loses power in the middle of
+// an EEPROM write, after 3 h. A second boot on the same EEPROM must resume the program from its checkpoint, with
+// its setpoints and PID outputs, and end it when the fermentation time (power cut excluded) reaches 8 h.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <vector>
+#include "ParameterStore.h"
+#include "PIDManager.h"
+#include "StateMachine.h"
+
+extern StateMachine stateMachine;
+extern PIDManager pidManager;
+
+static const int KILLED = 3;
+static const char* EEPROM_FILE = "fermentation_resume.eeprom";
+static const unsigned long DURATION = 8UL * 3600000UL;
+static const unsigned long CUT_AFTER = 3UL * 3600000UL;
+
+// Power cut at EEPROM write 'cutWrite' after CUT_AFTER of fermentation.
+// Sends the fermentation start time, then the time of each second run until the cut.
+static void firstBoot(int fd, unsigned long cutWrite) {
+    EEPROM.hostAttachFile(EEPROM_FILE);
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    HostRuntime::command("fermentation 30 7 6 5 1.5 8 2 HostRun resume");
+    if (stateMachine.getCurrentProgram() != "Fermentation") _exit(1);
+    sendToParent(fd, millis());
+    HostRuntime::runFor(CUT_AFTER);
+    HostRuntime::takeConsole();
+    EEPROM.hostKillAtWrite(cutWrite, KILLED);
+    for (int second = 0; second < 3600; second++) {
+        sendToParent(fd, millis());
+        HostRuntime::runFor(1000);
+        HostRuntime::takeConsole();
+    }
+    // The cut must happen within the hour
+    _exit(1);
+}
+
+// Results of the second boot
+enum ResumeResult { RESUMED, CHECKPOINT_ELAPSED, TEMP_SETPOINT, OUTPUT_RESTORED, REMAINING_TIME, RESULT_COUNT };
+
+static void secondBoot(int fd) {
+    EEPROM.hostAttachFile(EEPROM_FILE);
+    HostRuntime::boot();
+    FermentationCheckpointRecord checkpoint;
+    bool hasCheckpoint = ParameterStore::load(checkpoint);
+    sendToParent(fd, stateMachine.getCurrentProgram() == "Fermentation" && hasCheckpoint);
+    sendToParent(fd, hasCheckpoint ? checkpoint.elapsedTime : 0);
+    sendToParent(fd, lround(pidManager.getTemperatureSetpoint() * 10));
+    sendToParent(fd, hasCheckpoint && fabs(pidManager.getTemperatureOutput() - checkpoint.tempOutput) < 1e-3);
+
+    HostRuntime::command("simulate start 1");
+    unsigned long resumedAt = millis();
+    while (stateMachine.getCurrentProgram() == "Fermentation" && millis() - resumedAt < DURATION) {
+        HostRuntime::runFor(1000);
+        HostRuntime::takeConsole();
+    }
+    sendToParent(fd, millis() - resumedAt);
+}
+
+int main() {
+    const unsigned long cutWrites[] = {1, 5, 9, 17, 30, 47, 64, 97, 150};
+    int resumed = 0;
+    for (unsigned long cutWrite : cutWrites) {
+        remove(EEPROM_FILE);
+        std::vector<long> times;
+        int code = runChild([cutWrite](int fd) { firstBoot(fd, cutWrite); }, times);
+        CHECK(code == KILLED);
+        if (code != KILLED || times.size() < 2) continue;
+        unsigned long fermentationAtCut = times.back() - times.front();
+
+        std::vector<long> results;
+        runChild(secondBoot, results);
+        CHECK(results.size() == RESULT_COUNT);
+        if (results.size() != RESULT_COUNT) continue;
+
+        unsigned long elapsed = results[CHECKPOINT_ELAPSED];
+        unsigned long lost = fermentationAtCut - elapsed;
+        printf("cut at write %3lu after %.1f min: resumed at %.1f min (%.1f s lost), %.2f h to go\n", cutWrite,
+               fermentationAtCut / 60000.0, elapsed / 60000.0, lost / 1000.0, results[REMAINING_TIME] / 3600000.0);
+
+        CHECK(results[RESUMED]);
+        CHECK(results[TEMP_SETPOINT] == 300);
+        CHECK(results[OUTPUT_RESTORED]);
+        // At most one checkpoint interval (plus the write still in progress) is lost
+        CHECK(elapsed <= fermentationAtCut);
+        CHECK(lost <= 2 * 60000UL);
+        // The program ends once the fermentation time reaches its duration
+        CHECK_NEAR(results[REMAINING_TIME], DURATION - elapsed, 1000);
+        if (results[RESUMED]) resumed++;
+    }
+    remove(EEPROM_FILE);
+    printf("%d/%zu power cuts resumed\n", resumed, sizeof(cutWrites) / sizeof(cutWrites[0]));
+    return testResult();
+}
@@ -0,0 +1,100 @@
+// Frame pool overflow (JsonFrameAllocator): a document built on a pool too small for it must report overflowed() and
+// still serialize to valid JSON, the pool must be reusable after reset(), and the sketch's periodic frame and profile
+// must each fit in DataCollector::FRAME_BUFFER_SIZE.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <string>
+#include "DataCollector.h"
+#include "JsonFrameAllocator.h"
+#include "StateMachine.h"
+
+extern DataCollector dataCollector;
+extern StateMachine stateMachine;
+
+static void checkPoolOverflow() {
+    alignas(sizeof(void*)) uint8_t buffer[256];
+    JsonFrameAllocator allocator(buffer, sizeof(buffer));
+
+    JsonDocument doc(&allocator);
+    int added = 0;
+    while (!doc.overflowed() && added < 100) {
+        String key = "sensor" + String(added);
+        doc[key] = "a reading too long to be stored inline";
+        added++;
+    }
+    printf("256 B pool: overflowed after %d members, %u bytes used\n", added, static_cast<unsigned>(allocator.used()));
+    CHECK(doc.overflowed());
+    CHECK(added > 1);
+    CHECK(allocator.used() <= allocator.capacity());
+
+    // The members that fitted are kept and the output is still a whole document
+    std::string json;
+    serializeJson(doc, json);
+    JsonDocument parsed;
+    CHECK(!deserializeJson(parsed, json));
+    CHECK(parsed.as<JsonObject>().size() == static_cast<size_t>(added - 1));
+
+    // A nested object whose slot does not fit is dropped with its members
+    JsonObject nested = doc["nested"].to<JsonObject>();
+    nested["value"] = 1;
+    CHECK(!doc["nested"]["value"].is<int>());
+
+    // Once released, the pool serves a new document
+    allocator.reset();
+    CHECK(allocator.used() == 0);
+    JsonDocument next(&allocator);
+    next["currentProgram"] = "Fermentation";
+    next["programState"] = 1;
+    CHECK(!next.overflowed());
+    CHECK(strcmp(next["currentProgram"].as<const char*>(), "Fermentation") == 0);
+
+    // clear() starts a new frame on the same document
+    doc.clear();
+    CHECK(!doc.overflowed());
+
+    // Without an allocator, the heap is used and the document never overflows
+    JsonDocument heap;
+    for (int i = 0; i < 200; i++) heap["sensor" + String(i)] = "a reading too long to be stored inline";
+    CHECK(!heap.overflowed());
+}
+
+// Print into a fixed buffer
+class FixedPrint : public Print {
+public:
+    size_t write(uint8_t b) override {
+        if (length >= sizeof(data) - 1) return 0;
+        data[length++] = b;
+        data[length] = '\0';
+        return 1;
+    }
+    char data[4096];
+    size_t length = 0;
+};
+
+static void checkSketchFrames() {
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    HostRuntime::command("profile telemetry on");
+    HostRuntime::runFor(10000);
+    HostRuntime::takeConsole();
+
+    String program = stateMachine.getCurrentProgram();
+    static char frame[4096];            // DataCollector::FRAME_BUFFER_SIZE
+    size_t length = dataCollector.writeAllData(frame, sizeof(frame), program, 1);
+    static FixedPrint profile;
+    size_t profileLength = dataCollector.writeProfile(profile);
+    printf("periodic frame %u bytes, profile %u bytes\n", static_cast<unsigned>(length),
+           static_cast<unsigned>(profileLength));
+    CHECK(length > 0);
+    CHECK(profileLength > 0 && profileLength == profile.length);
+    CHECK(strncmp(profile.data, "{\"profile\":{\"", 13) == 0);
+    CHECK(HostRuntime::takeConsole().find("does not fit") == std::string::npos);
+}
+
+int main() {
+    checkPoolOverflow();
+    checkSketchFrames();
+    return testResult();
+}
@@ -0,0 +1,68 @@
+// Baud rate negotiation of the ESP32 link (Communication), played from the ESP32 side on Serial7:
+// accepted and refused rates, PING confirmation, fallback to the default rate when the ESP32 goes silent.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+
+// Send a line to the Teensy and return what it answered on the link within one command task period
+static std::string exchange(const std::string& line) {
+    Serial7.hostInject(line + "\n");
+    HostRuntime::runFor(20);
+    return Serial7.hostTakeOutput();
+}
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+int main() {
+    HostRuntime::boot();
+    HostRuntime::takeConsole();
+    Serial7.hostTakeOutput();
+    CHECK(Serial7.hostBaud() == 9600);
+    CHECK(Serial7.hostRxCapacity() >= 1024);
+
+    // Unsupported rate: refused, the link stays at the default rate
+    CHECK(contains(exchange("LINK:BAUD:57600"), "LINK:BAUD_REFUSED:57600"));
+    CHECK(Serial7.hostBaud() == 9600);
+
+    // Switch without confirmation: back to the default rate after LINK_CONFIRM_TIMEOUT (2 s)
+    CHECK(contains(exchange("LINK:BAUD:115200"), "LINK:BAUD_OK:115200"));
+    CHECK(Serial7.hostBaud() == 115200);
+    HostRuntime::runFor(1900);
+    CHECK(Serial7.hostBaud() == 115200);
+    HostRuntime::runFor(200);
+    CHECK(Serial7.hostBaud() == 9600);
+    CHECK(contains(HostRuntime::takeConsole(), "ESP32 link lost, back to 9600 baud"));
+
+    // Switch confirmed by a PING
+    CHECK(contains(exchange("LINK:BAUD:460800"), "LINK:BAUD_OK:460800"));
+    CHECK(Serial7.hostBaud() == 460800);
+    CHECK(contains(exchange("LINK:PING"), "LINK:PONG"));
+    CHECK(contains(HostRuntime::takeConsole(), "ESP32 link running at 460800 baud"));
+
+    // Kept as long as the ESP32 pings, telemetry keeps flowing at the new rate
+    std::string traffic;
+    for (int i = 0; i < 6; i++) {
+        HostRuntime::runFor(10000);
+        traffic += exchange("LINK:PING");
+    }
+    CHECK(Serial7.hostBaud() == 460800);
+    CHECK(contains(traffic, "\"sensorData\""));
+
+    // ESP32 silent (e.g. rebooted at the default rate): back to 9600 after LINK_IDLE_TIMEOUT (30 s)
+    HostRuntime::runFor(29000);
+    CHECK(Serial7.hostBaud() == 460800);
+    HostRuntime::runFor(2000);
+    CHECK(Serial7.hostBaud() == 9600);
+
+    // And a new negotiation works from there
+    CHECK(contains(exchange("LINK:BAUD:115200"), "LINK:BAUD_OK:115200"));
+    CHECK(contains(exchange("LINK:PING"), "LINK:PONG"));
+    HostRuntime::runFor(5000);
+    CHECK(Serial7.hostBaud() == 115200);
+
+    // LINK messages never reach the command handler
+    CHECK(!contains(HostRuntime::takeConsole(), "Received from ESP32: LINK"));
+    return testResult();
+}
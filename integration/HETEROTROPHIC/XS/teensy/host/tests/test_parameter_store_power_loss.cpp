@@ -0,0 +1,135 @@
+// Power loss during ParameterStore writes: a sequence of saves, long enough to go through journal compactions,
+// is cut at every single EEPROM write. The EEPROM left behind must hold the last saved value of each record
+// (or the one being saved), never a mix of two records, and the journal must keep accepting records.
+#include "HostTest.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <vector>
+#include "ParameterStore.h"
+
+static const int SAVE_COUNT = 100;  // Alternating PID and volume records, two journal compactions
+static const int KILLED = 3;        // Exit code of a child cut by the EEPROM shim
+static const char* EEPROM_FILE = "parameter_store_power_loss.eeprom";
+
+// Record n of each type, every field derived from n so that a mixed record shows
+static PIDParametersRecord pidRecord(int n) {
+    PIDParametersRecord record;
+    memset(&record, 0, sizeof(record));
+    for (int i = 0; i < 3; i++) {
+        record.Kp[i] = n + i;
+        record.Ki[i] = n * 0.5f + i;
+        record.Kd[i] = n * 0.25f;
+        record.hysteresis[i] = 0.1f * i;
+        record.setpoint[i] = n * 2.0f;
+        record.tuned[i] = n & 1;
+    }
+    return record;
+}
+
+static VolumeRecord volumeRecord(int n) {
+    VolumeRecord record;
+    record.currentVolume = 1.0f + n;
+    record.initialVolume = 1.0f;
+    record.cumulativeNaOH = n * 0.01f;
+    record.cumulativeNutrient = n * 0.02f;
+    record.cumulativeMicroalgae = n * 0.03f;
+    record.cumulativeRemoved = n * 0.04f;
+    return record;
+}
+
+// Save number s (1 based): odd saves are PID records, even saves volume records
+static void save(int s) {
+    if (s % 2) {
+        ParameterStore::save(pidRecord((s + 1) / 2));
+    } else {
+        ParameterStore::save(volumeRecord(s / 2));
+    }
+}
+
+// Index n of the record found in the EEPROM file, 0 if none, -1 if its fields do not belong to one record
+template<class T, class M> static long recordIndex(M make) {
+    T record;
+    if (!ParameterStore::load(record)) return 0;
+    for (int n = 1; n <= SAVE_COUNT; n++) {
+        T expected = make(n);
+        if (memcmp(&record, &expected, sizeof(T)) == 0) return n;
+    }
+    return -1;
+}
+
+int main() {
+    // Reference run: EEPROM writes used by the sequence up to the end of each save
+    std::vector<long> writesAfterSave;
+    remove(EEPROM_FILE);
+    runChild([](int fd) {
+        EEPROM.hostAttachFile(EEPROM_FILE);
+        ParameterStore::begin();
+        unsigned long start = EEPROM.hostWriteCount();
+        for (int s = 1; s <= SAVE_COUNT; s++) {
+            save(s);
+            sendToParent(fd, EEPROM.hostWriteCount() - start);
+        }
+        // Shows the number of compactions the sequence went through
+        Serial.hostSetEcho(stdout);
+        ParameterStore::logStatistics();
+        fflush(stdout);
+    }, writesAfterSave);
+    CHECK(writesAfterSave.size() == static_cast<size_t>(SAVE_COUNT));
+    if (writesAfterSave.size() != static_cast<size_t>(SAVE_COUNT)) return testResult();
+    long totalWrites = writesAfterSave.back();
+
+    int mixed = 0;
+    int lost = 0;
+    int stuck = 0;
+    for (long kill = 1; kill <= totalWrites; kill++) {
+        std::vector<long> unused;
+        remove(EEPROM_FILE);
+        int code = runChild([kill](int) {
+            EEPROM.hostAttachFile(EEPROM_FILE);
+            ParameterStore::begin();
+            EEPROM.hostKillAtWrite(kill, KILLED);
+            for (int s = 1; s <= SAVE_COUNT; s++) save(s);
+        }, unused);
+        CHECK(code == KILLED);
+
+        // Saves completed before the cut
+        int done = 0;
+        while (done < SAVE_COUNT && writesAfterSave[done] < kill) done++;
+        long pidDone = (done + 1) / 2;
+        long volumeDone = done / 2;
+
+        // Power back: what the journal holds, then one more save on top of it
+        std::vector<long> found;
+        runChild([](int fd) {
+            EEPROM.hostAttachFile(EEPROM_FILE);
+            ParameterStore::begin();
+            sendToParent(fd, recordIndex<PIDParametersRecord>(pidRecord));
+            sendToParent(fd, recordIndex<VolumeRecord>(volumeRecord));
+            ParameterStore::save(pidRecord(SAVE_COUNT));
+            ParameterStore::begin();
+            sendToParent(fd, recordIndex<PIDParametersRecord>(pidRecord));
+        }, found);
+        if (found.size() != 3) {
+            stuck++;
+            continue;
+        }
+        long pid = found[0];
+        long volume = found[1];
+        if (pid < 0 || volume < 0) {
+            mixed++;
+        } else if ((pid != pidDone && pid != pidDone + 1) || (volume != volumeDone && volume != volumeDone + 1)) {
+            fprintf(stderr, "cut at write %ld: PID record %ld (saved %ld), volume record %ld (saved %ld)\n", kill, pid,
+                    pidDone, volume, volumeDone);
+            lost++;
+        }
+        if (found[2] != SAVE_COUNT) stuck++;
+    }
+    remove(EEPROM_FILE);
+
+    printf("%ld power cuts over %d saves: %d mixed records, %d lost saves, %d journals refusing new records\n",
+           totalWrites, SAVE_COUNT, mixed, lost, stuck);
+    CHECK(mixed == 0);
+    CHECK(lost == 0);
+    CHECK(stuck == 0);
+    return testResult();
+}
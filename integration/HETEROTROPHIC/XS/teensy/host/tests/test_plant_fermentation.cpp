@@ -0,0 +1,44 @@
+// A 48 h fermentation of the plant model: the real sketch (programs, PID, safety, scheduler) on the virtual clock.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include "PlantSimulator.h"
+#include "StateMachine.h"
+
+extern StateMachine stateMachine;
+
+int main() {
+    double wallStart = wallSeconds();
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    CHECK(PlantSimulator::isRunning());
+
+    HostRuntime::command("fermentation 30 7 6 5 1.5 48 2 HostRun \"48 h plant model\"");
+    CHECK(stateMachine.getCurrentProgram() == "Fermentation");
+    HostRuntime::takeConsole();
+
+    const float setpoint = 30.0f;
+    float maxErrorAfterWarmUp = 0;
+    int hoursRun = 0;
+    while (hoursRun < 50 && stateMachine.getCurrentProgram() == "Fermentation") {
+        HostRuntime::runFor(3600UL * 1000UL);
+        hoursRun++;
+        float waterTemp = PlantSimulator::getValue(SensorId::WaterTemp);
+        if (hoursRun >= 3) {
+            maxErrorAfterWarmUp = max(maxErrorAfterWarmUp, fabsf(waterTemp - setpoint));
+        }
+        printf("%2d h: water %.2f C, pH %.2f, DO %.2f mg/L, turbidity %.0f NTU\n", hoursRun, waterTemp,
+               PlantSimulator::getValue(SensorId::PH), PlantSimulator::getValue(SensorId::Oxygen),
+               PlantSimulator::getValue(SensorId::Turbidity));
+        HostRuntime::takeConsole();
+    }
+
+    // The program ends by itself once its duration is over
+    CHECK(hoursRun == 48);
+    CHECK(stateMachine.getCurrentProgram() != "Fermentation");
+    CHECK(maxErrorAfterWarmUp < 1.0f);
+
+    double wall = wallSeconds() - wallStart;
+    printf("%d simulated hours in %.1f s (x%.0f)\n", hoursRun, wall, hoursRun * 3600.0 / wall);
+    return testResult();
+}
@@ -0,0 +1,115 @@
+// Sensor/actuator registry micro-benchmark: lookups per second through the SensorId/ActuatorId handles and through the
+// String names kept for the commands, and heap allocations per lookup and per telemetry frame.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <new>
+#include "ActuatorController.h"
+#include "DataCollector.h"
+#include "SensorController.h"
+#include "StateMachine.h"
+
+extern DataCollector dataCollector;
+extern StateMachine stateMachine;
+
+// Heap allocations of the sketch, the host JSON shim's own tree excepted (the library keeps it in the frame pool)
+static std::atomic<unsigned long> heapAllocations(0);
+
+void* operator new(size_t size) {
+    if (!HostJson::ShimHeap::active()) heapAllocations++;
+    void* block = malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+void operator delete(void* block) noexcept { free(block); }
+void operator delete(void* block, size_t) noexcept { free(block); }
+
+static const char* const ACTUATOR_NAMES[] = {
+    "airPump", "drainPump", "samplePump", "nutrientPump", "basePump",
+    "fillPump", "stirringMotor", "heatingPlate", "ledGrowLight"
+};
+static const char* const SENSOR_NAMES[] = {
+    "waterTempSensor", "airTempSensor", "electronicTempSensor", "phSensor", "oxygenSensor", "airFlowSensor",
+    "turbiditySensorSEN0554"
+};
+static const int ACTUATORS = sizeof(ACTUATOR_NAMES) / sizeof(ACTUATOR_NAMES[0]);
+static const int SENSORS = sizeof(SENSOR_NAMES) / sizeof(SENSOR_NAMES[0]);
+
+// Keeps the results alive so that the loops are not optimized out
+static volatile long sink;
+
+struct Result {
+    double lookupsPerSecond;
+    double allocationsPerLookup;
+};
+
+template<class F> static Result measure(long lookups, F lookup) {
+    unsigned long before = heapAllocations;
+    auto start = std::chrono::steady_clock::now();
+    long total = 0;
+    for (long i = 0; i < lookups; i++) total += lookup(i);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sink = total;
+    return {lookups / seconds, static_cast<double>(heapAllocations - before) / lookups};
+}
+
+static void report(const char* name, const Result& result) {
+    printf("%-40s %12.0f lookups/s, %.2f allocations per lookup\n", name, result.lookupsPerSecond,
+           result.allocationsPerLookup);
+}
+
+int main() {
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    HostRuntime::runFor(10000);
+
+    // Every name resolves to its handle
+    for (int i = 0; i < ACTUATORS; i++) {
+        ActuatorId id;
+        CHECK(ActuatorController::findActuatorId(ACTUATOR_NAMES[i], id) && static_cast<int>(id) == i);
+        CHECK(ActuatorController::findActuatorByName(ACTUATOR_NAMES[i]) == ActuatorController::getActuator(id));
+    }
+    for (int i = 0; i < SENSORS; i++) {
+        SensorId id;
+        CHECK(SensorController::findSensorId(SENSOR_NAMES[i], id) && static_cast<int>(id) == i);
+    }
+
+    const long LOOKUPS = 2000000;
+    Result actuatorById = measure(LOOKUPS, [](long i) {
+        return static_cast<long>(ActuatorController::isActuatorRunning(static_cast<ActuatorId>(i % ACTUATORS)));
+    });
+    Result actuatorByName = measure(LOOKUPS / 10, [](long i) {
+        return static_cast<long>(ActuatorController::isActuatorRunning(String(ACTUATOR_NAMES[i % ACTUATORS])));
+    });
+    Result sensorById = measure(LOOKUPS, [](long i) {
+        return static_cast<long>(SensorController::getSensor(static_cast<SensorId>(i % SENSORS)) != nullptr);
+    });
+    Result sensorByName = measure(LOOKUPS / 10, [](long i) {
+        return static_cast<long>(SensorController::findSensorByName(String(SENSOR_NAMES[i % SENSORS])) != nullptr);
+    });
+    report("isActuatorRunning(ActuatorId)", actuatorById);
+    report("isActuatorRunning(const String&)", actuatorByName);
+    report("getSensor(SensorId)", sensorById);
+    report("findSensorByName(const String&)", sensorByName);
+    // The host String keeps up to 15 characters without heap, the Teensy one allocates for every name
+    CHECK(actuatorById.allocationsPerLookup == 0);
+    CHECK(sensorById.allocationsPerLookup == 0);
+
+    // Allocations per telemetry frame
+    String program = stateMachine.getCurrentProgram();
+    static char buffer[4096];
+    const int FRAMES = 1000;
+    unsigned long before = heapAllocations;
+    for (int i = 0; i < FRAMES; i++) dataCollector.writeAllData(buffer, sizeof(buffer), program, 0);
+    double jsonFrame = static_cast<double>(heapAllocations - before) / FRAMES;
+    before = heapAllocations;
+    TelemetryProtocol::AllDataFrame frame;
+    for (int i = 0; i < FRAMES; i++) dataCollector.collectAllDataFrame(frame, program, 0);
+    double binaryFrame = static_cast<double>(heapAllocations - before) / FRAMES;
+    printf("allocations per frame: JSON %.2f, binary %.2f\n", jsonFrame, binaryFrame);
+    CHECK(jsonFrame == 0);
+    CHECK(binaryFrame == 0);
+    return testResult();
+}
@@ -0,0 +1,149 @@
+// Replay of recorded sensor data: 24 h of backend rows (one every 10 s) are fed through the replay commands sent by
+// tools/replay_csv.py, one row per command task period of the Teensy (1000x real time). The PIDs must compute at the
+// recorded intervals and follow the recorded setpoints without any program, nothing of the replay may reach the EEPROM,
+// and stop() must leave the sketch as it was before the replay.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stdio.h>
+#include <string>
+#include "ActuatorController.h"
+#include "ParameterStore.h"
+#include "PIDManager.h"
+#include "ReplayHarness.h"
+#include "SensorController.h"
+#include "StateMachine.h"
+#include "SystemClock.h"
+
+extern StateMachine stateMachine;
+extern PIDManager pidManager;
+extern ReplayHarness replayHarness;
+
+static const unsigned long ROW_INTERVAL = 10000;
+static const int ROW_COUNT = 24 * 3600 / 10;
+static const float TEMP_SETPOINT = 30.0f;
+
+// Recorded culture: heated from 22 °C to the setpoint in the first hours, pH drifting down with the growth
+static std::string stepCommand(int row) {
+    float hours = row * ROW_INTERVAL / 3600000.0f;
+    float waterTemp = hours < 4 ? 22.0f + 2.2f * hours : TEMP_SETPOINT + 0.3f * sinf(hours);
+    float pH = 7.0f - 0.02f * hours;
+    char line[160];
+    snprintf(line, sizeof(line), "replay step %lu %.2f %.2f %.2f %.2f %.1f %.2f %.2f", row ? ROW_INTERVAL : 0,
+             waterTemp, 24.0f, 35.0f, pH, 120.0f + hours * 20, 7.5f, 1.0f);
+    return line;
+}
+
+// Value of the heating plate in the REPLAY: line of the console output, -1 if there is none
+static int heatingPlateValue(const std::string& console) {
+    size_t start = console.find("REPLAY:");
+    if (start == std::string::npos) return -1;
+    size_t field = start;
+    // step, virtual ms, compute us, then the actuators in ActuatorId order
+    for (int i = 0; i < 3 + static_cast<int>(ActuatorId::HeatingPlate); i++) {
+        field = console.find(',', field) + 1;
+    }
+    return atoi(console.c_str() + field);
+}
+
+int main() {
+    HostRuntime::boot();
+    HostRuntime::runFor(5000);
+
+    // Not while a program runs
+    HostRuntime::command("mix 50");
+    HostRuntime::command("replay start");
+    CHECK(!replayHarness.isRunning());
+    HostRuntime::command("stop");
+    HostRuntime::runFor(1000);
+
+    ProgramRecord programBefore;
+    CHECK(ParameterStore::load(programBefore));
+    double setpointBefore = pidManager.getTemperatureSetpoint();
+    CHECK(ParameterStore::isIdle());
+    unsigned long writesBefore = EEPROM.hostWriteCount();
+    HostRuntime::takeConsole();
+
+    // Proportional temperature loop: its output follows the recorded water temperature below the setpoint
+    pidManager.setTunedParameters(PIDLoop::Temperature, 10, 0, 0);
+    HostRuntime::command("replay start");
+    CHECK(replayHarness.isRunning());
+    HostRuntime::command("replay setpoints 30 7.0 6.0");
+    CHECK(pidManager.isTemperaturePIDRunning());
+
+    double wallStart = wallSeconds();
+    unsigned long targetStart = millis();
+    int heatedWhileCold = 0;
+    int heatedWhileWarm = 0;
+    int answered = 0;
+    int changedBelowSetpoint = 0;
+    int tempComputes = 0;
+    double previousOutput = pidManager.getTemperatureOutput();
+    float previousTemp = SensorController::getSnapshot().waterTemp;
+    for (int row = 0; row < ROW_COUNT; row++) {
+        // The next row as soon as the step is answered: one command task period
+        Serial.hostInject(stepCommand(row) + "\n");
+        HostRuntime::runFor(10);
+        std::string console = HostRuntime::takeConsole();
+        // Below the setpoint the output of the loop follows the temperature: it changes at each computation
+        double output = pidManager.getTemperatureOutput();
+        float temp = SensorController::getSnapshot().waterTemp;
+        if (temp < TEMP_SETPOINT && temp != previousTemp) {
+            changedBelowSetpoint++;
+            if (output != previousOutput) tempComputes++;
+        }
+        previousOutput = output;
+        previousTemp = temp;
+        int heating = heatingPlateValue(console);
+        if (heating < 0) continue;
+        answered++;
+        float hours = row * ROW_INTERVAL / 3600000.0f;
+        if (hours > 0.5f && hours < 3.0f && heating > 0) heatedWhileCold++;
+        if (hours > 5.0f && 0.3f * sinf(hours) > 0.1f && heating > 0) heatedWhileWarm++;
+        // No program is started by a replay
+        CHECK(stateMachine.getCurrentProgram() == "None");
+    }
+    double wall = wallSeconds() - wallStart;
+    // Replay speed on the Teensy clock, the host simulation itself runs much faster
+    double speed = ROW_COUNT * static_cast<double>(ROW_INTERVAL) / (millis() - targetStart);
+    unsigned long replayWrites = EEPROM.hostWriteCount() - writesBefore;
+
+    HostRuntime::command("replay stop");
+    std::string console = HostRuntime::takeConsole();
+    printf("%d rows (24 h) replayed in %.0f s of Teensy time (%.2f s on the host): %.0fx real time, %d steps answered, "
+           "%d/%d temperature changes below the setpoint computed, %lu EEPROM writes\n", ROW_COUNT,
+           (millis() - targetStart) / 1000.0, wall, speed, answered, tempComputes, changedBelowSetpoint, replayWrites);
+
+    CHECK(answered == ROW_COUNT);
+    CHECK(speed >= 1000);
+    // UPDATE_INTERVAL_TEMP (5 s) is shorter than a row: a computation per row, although 10 ms pass between two rows
+    CHECK(changedBelowSetpoint > 500);
+    CHECK(tempComputes == changedBelowSetpoint);
+    // Heating on while the recorded water is below the setpoint, off above it
+    CHECK(heatedWhileCold > 500);
+    CHECK(heatedWhileWarm == 0);
+    CHECK(replayWrites == 0);
+
+    // Back to the state saved before the replay
+    CHECK(!replayHarness.isRunning());
+    CHECK(!SystemClock::isVirtual());
+    CHECK(!ParameterStore::areWritesSuspended());
+    CHECK(!pidManager.isTemperaturePIDRunning());
+    CHECK(pidManager.getTemperatureSetpoint() == setpointBefore);
+    for (int i = 0; i < static_cast<int>(ActuatorId::Count); i++) {
+        CHECK(!ActuatorController::isActuatorRunning(static_cast<ActuatorId>(i)));
+    }
+    ProgramRecord programAfter;
+    CHECK(ParameterStore::load(programAfter));
+    CHECK(memcmp(&programBefore, &programAfter, sizeof(ProgramRecord)) == 0);
+    CHECK(console.find("Parameter store writes resumed") != std::string::npos);
+
+    // A program started during a replay is stopped with it
+    HostRuntime::command("replay start");
+    HostRuntime::command("mix 50");
+    CHECK(stateMachine.getCurrentProgram() != "None");
+    HostRuntime::command("replay stop");
+    CHECK(stateMachine.getCurrentProgram() == "None");
+    return testResult();
+}
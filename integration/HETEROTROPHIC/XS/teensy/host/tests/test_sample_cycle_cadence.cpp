@@ -0,0 +1,87 @@
+// Sample cycle (SensorController::takeSample) with the timed actuator runs: the sample pump runs for PUMP_RUNTIME and is
+// stopped from the loop, the fresh sample is measured after STABILIZATION_TIME, and meanwhile no loop pass blocks and
+// the safety and PID tasks keep their 100 ms period without a deadline miss.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string>
+#include "ActuatorController.h"
+#include "SensorController.h"
+
+void loop();
+
+// SensorController::PUMP_RUNTIME and STABILIZATION_TIME (private), ms
+static const unsigned long PUMP_RUNTIME = 10000;
+static const unsigned long STABILIZATION_TIME = 1500;
+
+struct TaskLine {
+    long runs = -1;
+    long deadlineMisses = -1;
+    long maxJitter = -1;      // us
+};
+
+// Statistics of a task in the output of the "stats" command
+static TaskLine taskLine(const std::string& console, const std::string& name) {
+    TaskLine line;
+    size_t start = console.find("INFO: " + name + " (");
+    if (start == std::string::npos) return line;
+    std::string text = console.substr(start, console.find('\n', start) - start);
+    size_t runs = text.find("): ");
+    size_t jitter = text.find("jitter max ");
+    if (runs == std::string::npos || jitter == std::string::npos) return line;
+    char* end;
+    line.runs = strtol(text.c_str() + runs + 3, &end, 10);
+    line.deadlineMisses = strtol(end + strlen(" runs, "), nullptr, 10);
+    line.maxJitter = atol(text.c_str() + jitter + strlen("jitter max "));
+    return line;
+}
+
+int main() {
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    HostRuntime::runFor(30000);
+    HostRuntime::command("stats");
+    HostRuntime::takeConsole();
+
+    SensorController::takeSample();
+    uint64_t sampleStart = HostRuntime::nowMicros();
+    CHECK(ActuatorController::isActuatorRunning(ActuatorId::SamplePump));
+
+    // HostRuntime::runFor, timing every pass and noting when the pump stops
+    const uint64_t CYCLE_US = (PUMP_RUNTIME + STABILIZATION_TIME + 2000) * 1000ULL;
+    uint64_t worstPass = 0;
+    uint64_t pumpStopped = 0;
+    while (HostRuntime::nowMicros() - sampleStart < CYCLE_US) {
+        for (int i = 0; i < 2; i++) {
+            uint64_t start = HostRuntime::nowMicros();
+            loop();
+            worstPass = max(worstPass, HostRuntime::nowMicros() - start);
+        }
+        if (!pumpStopped && !ActuatorController::isActuatorRunning(ActuatorId::SamplePump)) {
+            pumpStopped = HostRuntime::nowMicros();
+        }
+        HostRuntime::advanceMicros(10000);
+    }
+    std::string console = HostRuntime::takeConsole();
+    HostRuntime::command("stats");
+    std::string statistics = HostRuntime::takeConsole();
+
+    double pumpRun = (pumpStopped - sampleStart) / 1000.0;
+    printf("sample pump ran %.0f ms, worst loop pass %llu us\n", pumpRun,
+           static_cast<unsigned long long>(worstPass));
+    CHECK(pumpRun >= PUMP_RUNTIME && pumpRun <= PUMP_RUNTIME + 20);
+    CHECK(console.find("Fresh sample stabilized") != std::string::npos);
+    CHECK(worstPass < 10000);
+
+    long expectedRuns = static_cast<long>(CYCLE_US / 100000);
+    for (const char* name : {"safety", "pid"}) {
+        TaskLine line = taskLine(statistics, name);
+        printf("%s during the sample cycle: %ld runs (%ld expected), %ld deadline misses, jitter max %ld us\n", name,
+               line.runs, expectedRuns, line.deadlineMisses, line.maxJitter);
+        CHECK(line.runs >= expectedRuns - 1 && line.runs <= expectedRuns + 1);
+        CHECK(line.deadlineMisses == 0);
+        CHECK(line.maxJitter >= 0 && line.maxJitter < 20000);
+    }
+    return testResult();
+}
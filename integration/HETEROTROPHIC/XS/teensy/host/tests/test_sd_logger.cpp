@@ -0,0 +1,108 @@
+// SD card logger on a host directory: file creation failures are retried at a bounded rate under the same file
+// number, the samples of a run are all in the file with a valid CRC, and a card that stops accepting writes
+// disables the logger instead of being retried on every sample.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <SD.h>
+#include <stdlib.h>
+#include <string>
+#include "SdLogger.h"
+#include "TelemetryProtocol.h"
+
+static std::string cardDirectory;
+
+static std::string cardPath(const char* name) {
+    return cardDirectory + "/" + name;
+}
+
+static int countOccurrences(const std::string& text, const std::string& part) {
+    int count = 0;
+    for (size_t pos = text.find(part); pos != std::string::npos; pos = text.find(part, pos + 1)) count++;
+    return count;
+}
+
+// Check the file written by the logger, returns the number of valid samples
+static int checkLogFile(const char* name, uint32_t expectedIndex) {
+    FILE* file = fopen(cardPath(name).c_str(), "rb");
+    CHECK(file != nullptr);
+    if (!file) return 0;
+
+    uint8_t sector[SdLogger::SECTOR_SIZE];
+    CHECK(fread(sector, 1, sizeof(sector), file) == sizeof(sector));
+    const SdLogger::FileHeader* header = reinterpret_cast<const SdLogger::FileHeader*>(sector);
+    CHECK(memcmp(header->magic, "BRLG", 4) == 0);
+    CHECK(header->version == SdLogger::FILE_VERSION);
+    CHECK(header->recordSize == sizeof(SdLogger::SampleRecord));
+    CHECK(header->fileIndex == expectedIndex);
+
+    int samples = 0;
+    uint16_t lastSequence = 0;
+    uint32_t lastTime = 0;
+    while (fread(sector, 1, sizeof(sector), file) == sizeof(sector)) {
+        for (int i = 0; i < SdLogger::SAMPLES_PER_SECTOR; i++) {
+            const SdLogger::SampleRecord* record = reinterpret_cast<const SdLogger::SampleRecord*>(sector) + i;
+            uint16_t crc = TelemetryProtocol::crc16(reinterpret_cast<const uint8_t*>(record),
+                                                    offsetof(SdLogger::SampleRecord, crc));
+            if (crc != record->crc) continue; // Padding of a closed file
+            if (samples > 0) {
+                CHECK(static_cast<uint16_t>(record->sequence - lastSequence) == 1);
+                // 1 s task
+                CHECK(record->time - lastTime >= 900 && record->time - lastTime <= 1100);
+            }
+            lastSequence = record->sequence;
+            lastTime = record->time;
+            samples++;
+        }
+    }
+    fclose(file);
+    return samples;
+}
+
+int main() {
+    char directory[] = "/tmp/sdcardXXXXXX";
+    CHECK(mkdtemp(directory) != nullptr);
+    cardDirectory = directory;
+    SD.hostSetRoot(cardDirectory);
+
+    // Card mounted but no file can be created: one attempt per OPEN_RETRY_INTERVAL, one error message
+    SD.hostFailOpen(true);
+    HostRuntime::boot();
+    unsigned long opensAtBoot = SD.hostOpenCount();
+    HostRuntime::runFor(10 * 60 * 1000UL);
+    std::string console = HostRuntime::takeConsole();
+    unsigned long attempts = SD.hostOpenCount() - opensAtBoot;
+    printf("10 min without file creation: %lu attempts, %d error messages\n", attempts,
+           countOccurrences(console, "Cannot create"));
+    CHECK(attempts >= 9 && attempts <= 11);
+    CHECK(countOccurrences(console, "Cannot create") == 1);
+    CHECK(console.find("LOG0002.BIN") == std::string::npos);
+
+    // Back to normal: the next attempt creates LOG0001.BIN and the samples follow each other in it
+    SD.hostFailOpen(false);
+    HostRuntime::runFor(61 * 1000UL);
+    console = HostRuntime::takeConsole();
+    CHECK(console.find("SD log file LOG0001.BIN created after") != std::string::npos);
+    HostRuntime::runFor(30 * 60 * 1000UL);
+    // A program start closes the file, with every buffered sample
+    HostRuntime::command("mix 50");
+    HostRuntime::runFor(5000);
+    HostRuntime::command("stop");
+    int samples = checkLogFile("LOG0001.BIN", 1);
+    printf("LOG0001.BIN: %d samples\n", samples);
+    CHECK(samples >= 30 * 60);
+
+    // Card full during the next file: logging stops, the card is left alone
+    HostRuntime::takeConsole();
+    SD.hostFailWritesAfter(20 * SdLogger::SECTOR_SIZE);
+    HostRuntime::runFor(10 * 60 * 1000UL);
+    console = HostRuntime::takeConsole();
+    unsigned long opensWhenFull = SD.hostOpenCount();
+    HostRuntime::runFor(10 * 60 * 1000UL);
+    CHECK(console.find("SD card write failed, on-board data logging stopped") != std::string::npos);
+    CHECK(SD.hostOpenCount() == opensWhenFull);
+
+    std::string cleanup = "rm -rf " + cardDirectory;
+    CHECK(system(cleanup.c_str()) == 0);
+    return testResult();
+}
@@ -0,0 +1,91 @@
+// SD card logger benchmark: throughput of the sample path (pack, CRC, sector write) on the host, then the worst-case
+// latency a card write or flush adds to a loop() pass on a modeled card with slow sectors. The logger does one card
+// operation per idle pass, so the longest pass is the slowest card operation and no sample is lost meanwhile.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <SD.h>
+#include <stdlib.h>
+#include <string>
+#include "SdLogger.h"
+
+void loop();
+
+// Card model: sector write 250 us, flush (directory update) 3 ms, a 40 ms erase stall every 128 sectors
+static const uint32_t WRITE_US = 250;
+static const uint32_t FLUSH_US = 3000;
+static const uint32_t STALL_EVERY = 128;
+static const uint32_t STALL_US = 40000;
+
+// Value following label in the text, -1 when missing
+static long valueAfter(const std::string& text, const std::string& label) {
+    size_t pos = text.rfind(label);
+    return pos == std::string::npos ? -1 : atol(text.c_str() + pos + label.size());
+}
+
+static void benchThroughput() {
+    const long SAMPLES = 200000;
+    String program = "None";
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < SAMPLES; i++) {
+        SdLogger::recordSample(program, 0);
+        SdLogger::service();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%ld samples in %.3f s: %.2f us per sample, %.1f MB/s of records\n", SAMPLES, seconds,
+           seconds * 1e6 / SAMPLES, SAMPLES * sizeof(SdLogger::SampleRecord) / seconds / 1e6);
+
+    HostRuntime::takeConsole();
+    SdLogger::logStatistics();
+    std::string statistics = HostRuntime::takeConsole();
+    CHECK(valueAfter(statistics, "samples, ") == 0);   // dropped
+    CHECK(valueAfter(statistics, "buffered, ") >= SAMPLES / SdLogger::SAMPLES_PER_SECTOR - 1);
+}
+
+static void benchLatency() {
+    SD.hostSetLatency(WRITE_US, FLUSH_US, STALL_EVERY, STALL_US);
+    HostRuntime::command("stop");       // New file, new statistics start from the current counters
+    HostRuntime::takeConsole();
+    SdLogger::logStatistics();
+    long droppedBefore = valueAfter(HostRuntime::takeConsole(), "samples, ");
+
+    // HostRuntime::runFor, timing every pass: 3 h of 1 s samples is ~1350 sectors and 10 stalls
+    uint64_t worstPass = 0;
+    uint64_t end = HostRuntime::nowMicros() + 3 * 3600 * 1000000ULL;
+    while (HostRuntime::nowMicros() < end) {
+        for (int i = 0; i < 2; i++) {
+            uint64_t start = HostRuntime::nowMicros();
+            loop();
+            worstPass = max(worstPass, HostRuntime::nowMicros() - start);
+        }
+        HostRuntime::advanceMicros(10000);
+    }
+
+    SdLogger::logStatistics();
+    std::string statistics = HostRuntime::takeConsole();
+    long maxWrite = valueAfter(statistics, "us, max ");
+    long maxSync = valueAfter(statistics, "sync max ");
+    printf("modeled card: worst loop pass %llu us, sector write max %ld us, flush max %ld us\n",
+           static_cast<unsigned long long>(worstPass), maxWrite, maxSync);
+    CHECK(maxWrite == WRITE_US + STALL_US);
+    CHECK(maxSync == FLUSH_US);
+    // One card operation per pass, the rest of the pass is not slowed down by the card
+    CHECK(worstPass >= WRITE_US + STALL_US);
+    CHECK(worstPass < WRITE_US + STALL_US + 5000);
+    CHECK(valueAfter(statistics, "samples, ") == droppedBefore);
+    SD.hostSetLatency(0, 0);
+}
+
+int main() {
+    char directory[] = "/tmp/sdbenchXXXXXX";
+    CHECK(mkdtemp(directory) != nullptr);
+    SD.hostSetRoot(directory);
+    HostRuntime::boot();
+
+    benchThroughput();
+    benchLatency();
+
+    std::string cleanup = std::string("rm -rf ") + directory;
+    CHECK(system(cleanup.c_str()) == 0);
+    return testResult();
+}
@@ -0,0 +1,138 @@
+// Sensors with their latency modeled on the virtual clock: two DS18B20 on 1-Wire (750 ms conversion, bus slots),
+// the SEN0554 answering on its UART after 55 ms, and the Uno transmitter averaging its O2 probe for 100 ms.
+// The blocking reads wait for each of them; the acquisition engine (startReading/pollReading) publishes the same
+// values while no loop pass waits longer than the 1-Wire bus transfers themselves.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <OneWire.h>
+#include <string>
+#include "SensorController.h"
+#include "UnoTransmitter.h"
+
+void loop();
+
+// Main.ino wiring
+static const uint8_t AIR_TEMP_PIN = 39;
+static const uint8_t ELECTRONIC_TEMP_PIN = 36;
+
+static const int SENSORS = static_cast<int>(SensorId::Count);
+
+static const float AIR_TEMP = 24.5f;
+static const float ELECTRONIC_TEMP = 31.0f;
+static const uint8_t TURBIDITY_RAW = 20;            // 20 x 1.5 + 10
+static const float TURBIDITY = 40.0f;
+static const float EXPECTED_PH = 4.4f;              // Uno A1 = 400, see test_transmitter_link
+static const float EXPECTED_OXYGEN = 8.5f;          // Uno A5 = 200
+
+// SEN0554 on Serial8: answers a 5-byte request after its processing time plus 5 bytes at 9600 baud
+static const uint64_t TURBIDITY_ANSWER_US = 50000 + 5200;
+
+struct TurbidityModel {
+    uint64_t answerTime = 0;    // 0 = no request pending
+
+    void service() {
+        std::string request = Serial8.hostTakeOutput();
+        if (request.size() >= 5 && static_cast<uint8_t>(request[0]) == 0x18) {
+            answerTime = HostRuntime::nowMicros() + TURBIDITY_ANSWER_US;
+        }
+        if (answerTime != 0 && HostRuntime::nowMicros() >= answerTime) {
+            const char answer[5] = {0x18, 0x05, 0x00, static_cast<char>(TURBIDITY_RAW), 0x0D};
+            Serial8.hostInject(std::string(answer, 5));
+            answerTime = 0;
+        }
+    }
+};
+
+static TurbidityModel turbidity;
+
+static void serviceDevices() {
+    UnoTransmitter::service();
+    turbidity.service();
+}
+
+// Time taken by a blocking readValue() (the other devices answer from yield())
+static uint64_t timeBlockingRead(SensorId id, float& value) {
+    uint64_t start = HostRuntime::nowMicros();
+    value = SensorController::getSensor(id)->readValue();
+    return HostRuntime::nowMicros() - start;
+}
+
+int main() {
+    OneWire::hostAttachDS18B20(AIR_TEMP_PIN, AIR_TEMP);
+    OneWire::hostAttachDS18B20(ELECTRONIC_TEMP_PIN, ELECTRONIC_TEMP);
+    UnoTransmitter::setAnalogInput(A1, 400);
+    UnoTransmitter::setAnalogInput(A5, 200);
+    UnoTransmitter::boot(Serial3);
+    HostRuntime::setPeer(serviceDevices);
+    HostRuntime::boot();
+    HostRuntime::runFor(30000);
+
+    // Blocking path: every read waits for its device
+    float value;
+    uint64_t ds18b20Us = timeBlockingRead(SensorId::AirTemp, value);
+    CHECK_NEAR(value, AIR_TEMP, 1e-4);
+    uint64_t turbidityUs = timeBlockingRead(SensorId::Turbidity, value);
+    uint64_t transmitterUs = timeBlockingRead(SensorId::PH, value);
+    CHECK_NEAR(value, EXPECTED_PH, 1e-4);
+    printf("blocking reads: DS18B20 %llu us, SEN0554 %llu us, pH/O2 %llu us\n",
+           static_cast<unsigned long long>(ds18b20Us), static_cast<unsigned long long>(turbidityUs),
+           static_cast<unsigned long long>(transmitterUs));
+    CHECK(ds18b20Us >= 750000);
+    CHECK(turbidityUs >= 100000);
+    CHECK(transmitterUs >= 100000);
+
+    // Non-blocking path: HostRuntime::runFor timing every pass, the devices served between passes. A 1 ms tick, as
+    // the target loop spins continuously: the 10 ms tasks are then late only by what the passes take
+    HostRuntime::command("stats");
+    HostRuntime::takeConsole();
+    unsigned long updates[SENSORS] = {};
+    unsigned long lastUpdate[SENSORS] = {};
+    uint64_t worstPass = 0;
+    uint64_t end = HostRuntime::nowMicros() + 60 * 1000000ULL;
+    while (HostRuntime::nowMicros() < end) {
+        for (int i = 0; i < 2; i++) {
+            uint64_t start = HostRuntime::nowMicros();
+            loop();
+            worstPass = max(worstPass, HostRuntime::nowMicros() - start);
+        }
+        serviceDevices();
+        for (int i = 0; i < SENSORS; i++) {
+            unsigned long time = SensorController::getLastUpdateTime(static_cast<SensorId>(i));
+            if (time != lastUpdate[i]) updates[i]++;
+            lastUpdate[i] = time;
+        }
+        HostRuntime::advanceMicros(1000);
+    }
+    HostRuntime::command("stats");
+    std::string statistics = HostRuntime::takeConsole();
+
+    const SensorSnapshot& snapshot = SensorController::getSnapshot();
+    printf("60 s acquisition: air %.1f C (%lu readings), electronic %.1f C (%lu), turbidity %.1f (%lu), "
+           "pH %.1f (%lu), O2 %.1f (%lu), worst loop pass %llu us\n",
+           snapshot.airTemp, updates[static_cast<int>(SensorId::AirTemp)], snapshot.electronicTemp,
+           updates[static_cast<int>(SensorId::ElectronicTemp)], snapshot.turbidity,
+           updates[static_cast<int>(SensorId::Turbidity)], snapshot.pH, updates[static_cast<int>(SensorId::PH)],
+           snapshot.oxygen, updates[static_cast<int>(SensorId::Oxygen)], static_cast<unsigned long long>(worstPass));
+    CHECK_NEAR(snapshot.airTemp, AIR_TEMP, 1e-4);
+    CHECK_NEAR(snapshot.electronicTemp, ELECTRONIC_TEMP, 1e-4);
+    CHECK_NEAR(snapshot.turbidity, TURBIDITY, 1e-4);
+    CHECK_NEAR(snapshot.pH, EXPECTED_PH, 1e-4);
+    CHECK_NEAR(snapshot.oxygen, EXPECTED_OXYGEN, 1e-4);
+    // SensorController intervals: air 5 s, electronic 10 s, turbidity and transmitter 5 s
+    CHECK(updates[static_cast<int>(SensorId::AirTemp)] >= 11);
+    CHECK(updates[static_cast<int>(SensorId::ElectronicTemp)] >= 5);
+    CHECK(updates[static_cast<int>(SensorId::Turbidity)] >= 11);
+    CHECK(updates[static_cast<int>(SensorId::PH)] >= 11);
+    // A pass at most reads a scratchpad (reset, Skip ROM, Read Scratchpad, 2 bytes, reset) on each 1-Wire bus,
+    // it never waits for a device, and the 10 ms tasks keep their period
+    const uint64_t SCRATCHPAD_US = 2 * OneWire::RESET_US + 4 * OneWire::BYTE_US;
+    CHECK(worstPass <= 2 * SCRATCHPAD_US);
+    CHECK(worstPass < 10000);
+    for (const char* task : {"acquisition", "safety", "pid", "program"}) {
+        size_t line = statistics.find(std::string("INFO: ") + task + " (");
+        CHECK(line != std::string::npos);
+        CHECK(statistics.find(" 0 deadline misses, 0 overruns", line) < statistics.find('\n', line));
+    }
+    return testResult();
+}
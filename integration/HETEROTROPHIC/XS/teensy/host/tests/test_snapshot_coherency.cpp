@@ -0,0 +1,97 @@
+// PID, safety and telemetry read one snapshot per loop pass, while the acquisition engine keeps publishing new values.
+// Every pass checks that the snapshot holds the values published at the time it was taken, and every telemetry
+// message sent to the ESP32 is compared with the snapshot of the pass that sent it.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "PlantSimulator.h"
+#include "SensorController.h"
+
+static const SensorId SENSOR_IDS[] = {
+    SensorId::WaterTemp, SensorId::AirTemp, SensorId::ElectronicTemp, SensorId::PH,
+    SensorId::Oxygen, SensorId::AirFlow, SensorId::Turbidity
+};
+
+static float snapshotValue(const SensorSnapshot& snapshot, SensorId id) {
+    switch (id) {
+        case SensorId::WaterTemp: return snapshot.waterTemp;
+        case SensorId::AirTemp: return snapshot.airTemp;
+        case SensorId::ElectronicTemp: return snapshot.electronicTemp;
+        case SensorId::PH: return snapshot.pH;
+        case SensorId::Oxygen: return snapshot.oxygen;
+        case SensorId::AirFlow: return snapshot.airFlow;
+        case SensorId::Turbidity: return snapshot.turbidity;
+        default: return NAN;
+    }
+}
+
+int main() {
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    CHECK(PlantSimulator::isRunning());
+    // Let every sensor slot be served by the plant model once (the real transmitters time out at boot)
+    HostRuntime::runFor(30000);
+    HostRuntime::takeConsole();
+    Serial7.hostTakeOutput();
+
+    const int passes = 5 * 60 * 100; // 5 minutes of 10 ms passes
+    uint32_t lastSequence = SensorController::getSnapshot().sequence;
+    int snapshotsTaken = 0;
+    int stalePasses = 0;        // Passes where the culture has grown since the last turbidity reading
+    int telemetryMessages = 0;
+    unsigned long maxAge = 0;
+    std::string pending;
+
+    for (int pass = 0; pass < passes; pass++) {
+        HostRuntime::runFor(10);
+        const SensorSnapshot snapshot = SensorController::getSnapshot();
+
+        // One snapshot per acquisition pass, never more
+        CHECK(snapshot.sequence - lastSequence <= 1);
+        snapshotsTaken += snapshot.sequence - lastSequence;
+        lastSequence = snapshot.sequence;
+
+        // The snapshot is the set of values published when it was taken
+        for (SensorId id : SENSOR_IDS) {
+            CHECK(snapshotValue(snapshot, id) == SensorController::readSensor(id));
+        }
+        if (snapshot.turbidity != PlantSimulator::getValue(SensorId::Turbidity)) {
+            stalePasses++;
+        }
+        CHECK(snapshot.oldestSampleTime <= snapshot.timestamp);
+        maxAge = max(maxAge, snapshot.timestamp - snapshot.oldestSampleTime);
+
+        // Telemetry is sent after the acquisition task in the same pass: it must carry this snapshot
+        pending += Serial7.hostTakeOutput();
+        size_t end;
+        while ((end = pending.find('\n')) != std::string::npos) {
+            std::string line = pending.substr(0, end);
+            pending.erase(0, end + 1);
+            JsonDocument doc;
+            if (line.empty() || line[0] != '{' || deserializeJson(doc, line) || !doc["sensorData"].is<JsonObject>()) {
+                continue;
+            }
+            telemetryMessages++;
+            JsonObject sensors = doc["sensorData"];
+            CHECK_NEAR(sensors["waterTemp"].as<float>(), snapshot.waterTemp, 1e-4);
+            CHECK_NEAR(sensors["airTemp"].as<float>(), snapshot.airTemp, 1e-4);
+            CHECK_NEAR(sensors["elecTemp"].as<float>(), snapshot.electronicTemp, 1e-4);
+            CHECK_NEAR(sensors["pH"].as<float>(), snapshot.pH, 1e-4);
+            CHECK_NEAR(sensors["oxygen"].as<float>(), snapshot.oxygen, 1e-4);
+            CHECK_NEAR(sensors["airFlow"].as<float>(), snapshot.airFlow, 1e-4);
+            CHECK_NEAR(sensors["turbidity"].as<float>(), snapshot.turbidity, 1e-3);
+        }
+        HostRuntime::takeConsole();
+    }
+
+    printf("%d passes, %d snapshots, %d telemetry messages, oldest value %lu ms old at most\n",
+           passes, snapshotsTaken, telemetryMessages, maxAge);
+    CHECK(snapshotsTaken >= passes * 9 / 10);
+    CHECK(telemetryMessages >= 19);
+    // The per-pass comparison is only meaningful if the plant moves between two sensor refreshes
+    CHECK(stalePasses > 0);
+    // Slowest sensor: electronics temperature, refreshed every 10 s
+    CHECK(maxAge <= 11000);
+    return testResult();
+}
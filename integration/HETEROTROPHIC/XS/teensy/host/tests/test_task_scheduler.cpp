@@ -0,0 +1,153 @@
+// TaskScheduler on the virtual clock: the tasks burn a set time with HostRuntime::advanceMicros, so the jitter,
+// deadline misses, overruns and the recovery after a stall are exact. No sketch is booted, the tasks are the test's.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "TaskScheduler.h"
+
+struct TaskLine {
+    long runs = -1;
+    long deadlineMisses = -1;
+    long overruns = -1;
+    long maxExec = -1;      // us
+    long maxJitter = -1;    // us
+    std::string jitterHistogram;
+};
+
+// Statistics of a task in the output of TaskScheduler::logStatistics()
+static TaskLine taskLine(const std::string& console, const std::string& name) {
+    TaskLine line;
+    size_t start = console.find("INFO: " + name + " (");
+    if (start == std::string::npos) return line;
+    std::string text = console.substr(start, console.find('\n', start) - start);
+    const char* values = text.c_str() + text.find("): ") + 3;
+    char* end;
+    line.runs = strtol(values, &end, 10);
+    line.deadlineMisses = strtol(end + strlen(" runs, "), &end, 10);
+    line.overruns = strtol(end + strlen(" deadline misses, "), &end, 10);
+    line.maxExec = atol(text.c_str() + text.find(" us max ") + strlen(" us max "));
+    size_t jitter = text.find("jitter max ") + strlen("jitter max ");
+    line.maxJitter = atol(text.c_str() + jitter);
+    line.jitterHistogram = text.substr(text.find('[', jitter), text.find(']', jitter) - text.find('[', jitter) + 1);
+    return line;
+}
+
+static std::string statistics() {
+    HostRuntime::takeConsole();
+    TaskScheduler::logStatistics();
+    return HostRuntime::takeConsole();
+}
+
+// Execution times of the tasks (us), changed by the scenarios
+static uint64_t fastExec = 200;
+static uint64_t slowExec = 500;
+static std::vector<char> order;
+static unsigned long idleCalls = 0;
+
+static void fastTask() {
+    order.push_back('F');
+    HostRuntime::advanceMicros(fastExec);
+}
+
+static void slowTask() {
+    order.push_back('S');
+    HostRuntime::advanceMicros(slowExec);
+}
+
+static void idleTask() {
+    idleCalls++;
+}
+
+// loop() calling TaskScheduler::run() every 1 ms of idle time
+static void runFor(uint64_t durationMs) {
+    uint64_t end = HostRuntime::nowMicros() + durationMs * 1000;
+    while (HostRuntime::nowMicros() < end) {
+        TaskScheduler::run();
+        HostRuntime::advanceMicros(1000);
+    }
+}
+
+static void checkOnTime() {
+    order.clear();
+    idleCalls = 0;
+    runFor(10000);
+    std::string output = statistics();
+    TaskLine fast = taskLine(output, "fast");
+    TaskLine slow = taskLine(output, "slow");
+    printf("on time: fast %ld runs jitter max %ld us %s, slow %ld runs jitter max %ld us %s\n", fast.runs,
+           fast.maxJitter, fast.jitterHistogram.c_str(), slow.runs, slow.maxJitter, slow.jitterHistogram.c_str());
+    CHECK(fast.runs == 1000 && slow.runs == 100);
+    CHECK(fast.deadlineMisses == 0 && slow.deadlineMisses == 0);
+    CHECK(fast.overruns == 0 && slow.overruns == 0);
+    CHECK(fast.maxExec == 200 && slow.maxExec == 500);
+    // The fast task starts within the 1 ms polling step, the slow one at most after the fast one it shares a pass with
+    CHECK(fast.maxJitter < 1000);
+    CHECK(slow.maxJitter >= 200 && slow.maxJitter < 1200);
+    // When both are due the higher priority runs first
+    int slowAfterFast = 0;
+    for (size_t i = 1; i < order.size(); i++) {
+        if (order[i] == 'S') slowAfterFast += order[i - 1] == 'F';
+    }
+    CHECK(slowAfterFast == 100);
+    // The idle task runs in the passes where nothing was due, and only then
+    long idlePasses = atol(output.c_str() + output.find(" s, ") + strlen(" s, "));
+    CHECK(idleCalls > 0 && idleCalls == static_cast<unsigned long>(idlePasses));
+}
+
+static void checkStall() {
+    // The fast task blocks for 250 ms once: both tasks miss their deadline (the slow one was due in the first 100 ms
+    // of the stall), the fast one overruns
+    fastExec = 250000;
+    runFor(10);
+    fastExec = 200;
+    order.clear();
+    runFor(200);
+    int fastRuns = 0;
+    for (char task : order) fastRuns += task == 'F';
+    runFor(10000 - 10 - 200);
+    std::string output = statistics();
+    TaskLine fast = taskLine(output, "fast");
+    TaskLine slow = taskLine(output, "slow");
+    printf("250 ms stall: fast %ld misses %ld overruns jitter max %ld us, slow %ld misses jitter max %ld us, "
+           "%d fast runs in the 200 ms after\n", fast.deadlineMisses, fast.overruns, fast.maxJitter,
+           slow.deadlineMisses, slow.maxJitter, fastRuns);
+    CHECK(fast.deadlineMisses == 1 && fast.overruns == 1);
+    CHECK(fast.maxExec == 250000);
+    CHECK(fast.maxJitter >= 240000 && fast.maxJitter < 250000);
+    CHECK(slow.deadlineMisses == 1);
+    CHECK(slow.maxJitter >= 150000 && slow.maxJitter < 251000);
+    // The skipped runs are dropped rather than run in a burst once the stall is over
+    CHECK(fastRuns >= 19 && fastRuns <= 21);
+    // The jitter histogram puts the late start in the >= 100 ms bucket
+    CHECK(slow.jitterHistogram.substr(slow.jitterHistogram.rfind('/')) == "/1]");
+}
+
+static void checkLateByLessThanAPeriod() {
+    // Starts delayed by less than a period (9 ms on a 10 ms task) are jitter, not deadline misses
+    slowExec = 9000;
+    runFor(10000);
+    slowExec = 500;
+    std::string output = statistics();
+    TaskLine fast = taskLine(output, "fast");
+    TaskLine slow = taskLine(output, "slow");
+    printf("9 ms slow task: fast %ld runs %ld misses jitter max %ld us %s\n", fast.runs, fast.deadlineMisses,
+           fast.maxJitter, fast.jitterHistogram.c_str());
+    CHECK(fast.deadlineMisses == 0);
+    CHECK(fast.maxJitter >= 5000 && fast.maxJitter < 10000);
+    CHECK(slow.overruns == 0);
+}
+
+int main() {
+    CHECK(TaskScheduler::addTask("slow", slowTask, 100, 1));
+    CHECK(TaskScheduler::addTask("fast", fastTask, 10, 0));
+    TaskScheduler::setIdleTask(idleTask);
+    statistics();
+
+    checkOnTime();
+    checkStall();
+    checkLateByLessThanAPeriod();
+    return testResult();
+}
@@ -0,0 +1,233 @@
+// Binary telemetry frames (TelemetryProtocol): encode/decode round trip, CRC, resynchronisation after a corrupted
+// frame, then the frames the sketch actually sends to the ESP32 once "telemetry binary" is enabled, and the JSON lines
+// it sends with the profiler results, each within the line length the ESP32 forwards.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <vector>
+#include "ActuatorController.h"
+#include "DataCollector.h"
+#include "SensorController.h"
+#include "StateMachine.h"
+#include "TelemetryProtocol.h"
+
+using namespace TelemetryProtocol;
+
+extern DataCollector dataCollector;
+extern StateMachine stateMachine;
+
+static AllDataFrame sampleFrame() {
+    AllDataFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    strcpy(frame.currentProgram, "Fermentation");
+    frame.programState = 1;
+    frame.waterTemp = 30.125f;
+    frame.airTemp = 22.5f;
+    frame.elecTemp = 35.0f;
+    frame.pH = 7.02f;
+    frame.turbidity = 412.75f;
+    frame.oxygen = 6.4f;
+    frame.airFlow = -1.0f;
+    frame.actuatorRunning = 0x0155;
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        frame.actuatorValues[i] = static_cast<int16_t>(i * 11 - 20);
+        frame.actuatorRemaining[i] = i == 0 ? 0xFFFFFFFFu : i * 70001u;
+    }
+    frame.currentVolume = 1.25f;
+    frame.availableVolume = 0.75f;
+    frame.addedNaOH = 0.01f;
+    frame.addedNutrient = 0.2f;
+    frame.addedMicroalgae = 0.1f;
+    frame.removedVolume = 0.05f;
+    return frame;
+}
+
+static bool sameFrame(const AllDataFrame& a, const AllDataFrame& b) {
+    if (strcmp(a.currentProgram, b.currentProgram) != 0 || a.programState != b.programState ||
+        a.actuatorRunning != b.actuatorRunning) {
+        return false;
+    }
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        if (a.actuatorValues[i] != b.actuatorValues[i] || a.actuatorRemaining[i] != b.actuatorRemaining[i]) return false;
+    }
+    // Floats travel as their bit pattern: exact equality
+    return a.waterTemp == b.waterTemp && a.airTemp == b.airTemp && a.elecTemp == b.elecTemp && a.pH == b.pH &&
+           a.turbidity == b.turbidity && a.oxygen == b.oxygen && a.airFlow == b.airFlow &&
+           a.currentVolume == b.currentVolume && a.availableVolume == b.availableVolume &&
+           a.addedNaOH == b.addedNaOH && a.addedNutrient == b.addedNutrient &&
+           a.addedMicroalgae == b.addedMicroalgae && a.removedVolume == b.removedVolume;
+}
+
+// Feed bytes to a reader, collect the decoded frames and count the CRC errors
+static std::vector<AllDataFrame> readFrames(FrameReader& reader, const uint8_t* data, size_t length, int& crcErrors) {
+    std::vector<AllDataFrame> frames;
+    for (size_t i = 0; i < length; i++) {
+        FrameReader::Result result = reader.push(data[i]);
+        if (result == FrameReader::Result::FRAME) {
+            AllDataFrame frame;
+            if (decodeAllData(reader.payload(), reader.length(), frame)) {
+                frames.push_back(frame);
+            }
+        } else if (result == FrameReader::Result::CRC_ERROR) {
+            crcErrors++;
+        }
+    }
+    return frames;
+}
+
+static void testCrc() {
+    // CRC-16/CCITT-FALSE check value
+    const char* check = "123456789";
+    CHECK(crc16(reinterpret_cast<const uint8_t*>(check), 9) == 0x29B1);
+}
+
+static void testRoundTrip() {
+    AllDataFrame frame = sampleFrame();
+    uint8_t buffer[MAX_FRAME_SIZE];
+    size_t length = encodeAllData(frame, buffer, sizeof(buffer));
+    CHECK(length == MAX_FRAME_SIZE);
+    CHECK(buffer[0] == SYNC_BYTE);
+    CHECK(encodeAllData(frame, buffer, MAX_FRAME_SIZE - 1) == 0);
+
+    FrameReader reader;
+    int crcErrors = 0;
+    std::vector<AllDataFrame> frames = readFrames(reader, buffer, length, crcErrors);
+    CHECK(frames.size() == 1);
+    CHECK(crcErrors == 0);
+    CHECK(!frames.empty() && sameFrame(frames[0], frame));
+
+    // Wrong schema version or truncated payload: refused by the decoder even with a valid CRC
+    AllDataFrame decoded;
+    uint8_t payload[ALL_DATA_PAYLOAD_SIZE];
+    memcpy(payload, buffer + 2, sizeof(payload));
+    CHECK(decodeAllData(payload, sizeof(payload), decoded));
+    CHECK(!decodeAllData(payload, sizeof(payload) - 1, decoded));
+    payload[0] = SCHEMA_VERSION + 1;
+    CHECK(!decodeAllData(payload, sizeof(payload), decoded));
+}
+
+// Any single bit error is caught, and the reader locks on the next good frame
+static void testCorruption() {
+    AllDataFrame frame = sampleFrame();
+    uint8_t good[MAX_FRAME_SIZE];
+    size_t length = encodeAllData(frame, good, sizeof(good));
+
+    int corruptedAccepted = 0;
+    int lostResync = 0;
+    for (size_t bit = 8; bit < length * 8; bit++) { // Bit errors in the sync byte just hide the frame
+        std::vector<uint8_t> stream(good, good + length);
+        stream[bit / 8] ^= 1 << (bit % 8);
+        // A few good frames behind the damaged one, as on the link
+        for (int i = 0; i < 3; i++) stream.insert(stream.end(), good, good + length);
+
+        FrameReader reader;
+        int crcErrors = 0;
+        std::vector<AllDataFrame> frames = readFrames(reader, stream.data(), stream.size(), crcErrors);
+        for (const AllDataFrame& received : frames) {
+            if (!sameFrame(received, frame)) corruptedAccepted++;
+        }
+        if (frames.empty()) lostResync++;
+    }
+    CHECK(corruptedAccepted == 0);
+    CHECK(lostResync == 0);
+
+    // Noise and a JSON line between frames do not disturb the reader
+    std::string noise = "{\"program\":\"mix\"}\n";
+    std::vector<uint8_t> stream(noise.begin(), noise.end());
+    stream.insert(stream.end(), good, good + length);
+    stream.push_back(0x00);
+    stream.insert(stream.end(), good, good + length);
+    FrameReader reader;
+    int crcErrors = 0;
+    CHECK(readFrames(reader, stream.data(), stream.size(), crcErrors).size() == 2);
+    CHECK(crcErrors == 0);
+}
+
+// The frames sent by the sketch carry the snapshot of their loop pass, and are smaller than the JSON message
+static void testSketchFrames() {
+    HostRuntime::boot();
+    HostRuntime::command("simulate start 1");
+    HostRuntime::runFor(30000);
+    HostRuntime::command("telemetry binary");
+    HostRuntime::takeConsole();
+    Serial7.hostTakeOutput();
+    // A timed run, its remaining time travels with the frames
+    ActuatorController::runActuator(ActuatorId::AirPump, 1, 5 * 60 * 1000UL);
+
+    FrameReader reader;
+    int crcErrors = 0;
+    int received = 0;
+    size_t binaryBytes = 0;
+    size_t jsonBytes = 0;
+    for (int pass = 0; pass < 2 * 60 * 100; pass++) {
+        HostRuntime::runFor(10);
+        std::string output = Serial7.hostTakeOutput();
+        std::vector<AllDataFrame> frames = readFrames(reader, reinterpret_cast<const uint8_t*>(output.data()),
+                                                      output.size(), crcErrors);
+        for (const AllDataFrame& frame : frames) {
+            const SensorSnapshot& snapshot = SensorController::getSnapshot();
+            CHECK(frame.waterTemp == snapshot.waterTemp);
+            CHECK(frame.pH == snapshot.pH);
+            CHECK(frame.oxygen == snapshot.oxygen);
+            CHECK(frame.turbidity == snapshot.turbidity);
+            CHECK(frame.programState == 0);
+            // Sent during the last 10 ms
+            unsigned long remaining = ActuatorController::getRemainingTime(ActuatorId::AirPump);
+            uint8_t airPump = static_cast<uint8_t>(ActuatorId::AirPump);
+            CHECK(remaining > 0 && frame.actuatorRemaining[airPump] >= remaining &&
+                  frame.actuatorRemaining[airPump] <= remaining + 10);
+            CHECK(frame.actuatorRemaining[static_cast<uint8_t>(ActuatorId::DrainPump)] == 0);
+            received++;
+            binaryBytes = output.size();
+            // Same content as the JSON message the sketch sends without "telemetry binary", with its CRLF
+            jsonBytes = dataCollector.collectAllData(stateMachine.getCurrentProgram(), 0).length() + 2;
+        }
+        HostRuntime::takeConsole();
+    }
+    CHECK(crcErrors == 0);
+    CHECK(received >= 7);
+    CHECK(binaryBytes == MAX_FRAME_SIZE);
+    printf("%d frames from the sketch, %zu bytes per frame instead of %zu bytes of JSON\n", received, binaryBytes,
+           jsonBytes);
+}
+
+// JSON telemetry with "profile telemetry on": the periodic data and the profile, each on a line the bridge accepts
+static void testSketchLines() {
+    HostRuntime::command("telemetry json");
+    HostRuntime::command("profile telemetry on");
+    HostRuntime::runFor(1000);
+    Serial7.hostTakeOutput();
+    HostRuntime::runFor(2 * 60 * 1000UL);
+    std::string output = Serial7.hostTakeOutput();
+    HostRuntime::takeConsole();
+
+    int dataLines = 0;
+    int profileLines = 0;
+    size_t longest = 0;
+    for (size_t start = 0, end; (end = output.find('\n', start)) != std::string::npos; start = end + 1) {
+        std::string line = output.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        longest = std::max(longest, line.size());
+        CHECK(line.size() <= MAX_TEXT_LINE_LENGTH);
+        if (line.find("\"sensorData\"") != std::string::npos) {
+            CHECK(line.find("\"profile\"") == std::string::npos);
+            dataLines++;
+        } else if (line.compare(0, 12, "{\"profile\":{") == 0) {
+            profileLines++;
+        }
+    }
+    printf("%d data lines and %d profile lines, longest %zu bytes (bridge limit %zu)\n", dataLines, profileLines,
+           longest, MAX_TEXT_LINE_LENGTH);
+    CHECK(dataLines >= 7);
+    CHECK(profileLines == dataLines);
+}
+
+int main() {
+    testCrc();
+    testRoundTrip();
+    testCorruption();
+    testSketchFrames();
+    testSketchLines();
+    return testResult();
+}
@@ -0,0 +1,139 @@
+// Teensy SensorTransmitterLink against the Uno transmitter sketch (handleCommand) through the serial shim: one tagged
+// READ_ALL serves both pH and O2 without blocking the loop while the Uno averages its O2 samples, the calibration
+// commands get their answer, and an answer arriving after its request timed out is dropped.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string>
+#include "SensorController.h"
+#include "SensorTransmitterLink.h"
+#include "UnoTransmitter.h"
+
+extern SensorTransmitterLink sensorTransmitter;
+
+void loop();
+
+// Uno inputs: pH 4.4 on A1 (1953 mV on the default calibration line), 976 mV on the O2 probe (A5)
+static const int PH_INPUT = 400;
+static const int OXYGEN_INPUT = 200;
+static const float EXPECTED_PH = 4.4f;
+static const float EXPECTED_OXYGEN = 8.5f;   // Uncalibrated: 8.73 mg/L saturation at 22 C x 0.976 V
+
+static int count(const std::string& text, const std::string& pattern) {
+    int found = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) found++;
+    return found;
+}
+
+// Value following label in the last occurrence, -1 when missing
+static long valueBefore(const std::string& text, const std::string& label) {
+    size_t pos = text.rfind(label);
+    if (pos == std::string::npos) return -1;
+    size_t start = text.find_last_of(", :", pos - 1);
+    return atol(text.c_str() + (start == std::string::npos ? 0 : start + 1));
+}
+
+// HostRuntime::runFor, timing every pass; an unplugged transmitter gets the requests but never answers
+static uint64_t runTimed(uint64_t durationMs, bool plugged = true) {
+    uint64_t worstPass = 0;
+    uint64_t end = HostRuntime::nowMicros() + durationMs * 1000;
+    while (HostRuntime::nowMicros() < end) {
+        for (int i = 0; i < 2; i++) {
+            uint64_t start = HostRuntime::nowMicros();
+            loop();
+            worstPass = max(worstPass, HostRuntime::nowMicros() - start);
+        }
+        if (plugged) UnoTransmitter::service();
+        HostRuntime::advanceMicros(10000);
+    }
+    return worstPass;
+}
+
+static std::string linkStatistics() {
+    HostRuntime::takeConsole();
+    sensorTransmitter.logStatistics();
+    return HostRuntime::takeConsole();
+}
+
+static void checkReadings() {
+    linkStatistics();
+    UnoTransmitter::takeConsole();
+    uint64_t worstPass = runTimed(60000);
+    std::string uno = UnoTransmitter::takeConsole();
+    std::string statistics = linkStatistics();
+
+    SensorSnapshot snapshot = SensorController::getSnapshot();
+    int readAll = count(uno, "Command received: #");
+    printf("60 s: %d READ_ALL, pH %.1f, O2 %.1f, worst loop pass %llu us\n", readAll, snapshot.pH, snapshot.oxygen,
+           static_cast<unsigned long long>(worstPass));
+    CHECK_NEAR(snapshot.pH, EXPECTED_PH, 1e-4);
+    CHECK_NEAR(snapshot.oxygen, EXPECTED_OXYGEN, 1e-4);
+    // pH and O2 share the transaction: every request is a READ_ALL, none of the single-sensor reads
+    CHECK(readAll > 0);
+    CHECK(count(uno, ":READ_ALL:") == readAll);
+    CHECK(uno.find("PH:READ") == std::string::npos && uno.find("O2:READ") == std::string::npos);
+    CHECK(valueBefore(statistics, " transactions") == readAll);
+    CHECK(valueBefore(statistics, " timeouts") == 0);
+    CHECK(valueBefore(statistics, " unmatched answers") == 0);
+    // The Uno takes 100 ms to average the O2 probe, the Teensy passes never wait for it
+    CHECK(uno.find("O2: V=976.0mV") != std::string::npos);
+    CHECK(worstPass < 10000);
+
+    // Blocking reading (outside of the acquisition engine), answered while readAll() yields
+    CHECK(sensorTransmitter.readAll(22.0f));
+    CHECK_NEAR(sensorTransmitter.getPH(), EXPECTED_PH, 1e-4);
+    CHECK_NEAR(sensorTransmitter.getOxygen(), EXPECTED_OXYGEN, 1e-4);
+}
+
+static void checkCalibration() {
+    UnoTransmitter::takeConsole();
+    HostRuntime::command("ph ENTERPH");
+    CHECK(HostRuntime::takeConsole().find("pH calibration response: ENTERPH:ENTERPHOK") != std::string::npos);
+    CHECK(sensorTransmitter.sendCommand("O2:CAL:RESET") == "O2:CAL:RESET:OK");
+    CHECK(sensorTransmitter.sendCommand("PH:CAL:EXITPH:22.00") == "EXITPH:EXITPHOK");
+    // Unknown command: the Uno does not answer, the link gives up after its timeout
+    CHECK(sensorTransmitter.sendCommand("NOT_A_COMMAND") == "ERROR:TIMEOUT");
+    CHECK(UnoTransmitter::takeConsole().find("Unknown command: NOT_A_COMMAND") != std::string::npos);
+    linkStatistics();
+}
+
+static void checkLateAnswer() {
+    // Transmitter unplugged: the next READ_ALL times out, the loop keeps running
+    HostRuntime::setPeer(nullptr);
+    Serial3.hostTakeOutput();
+    HostRuntime::takeConsole();
+    uint64_t worstPass = 0;
+    for (int i = 0; i < 6000 && Serial3.hostOutput().find(":READ_ALL:") == std::string::npos; i++) {
+        worstPass = max(worstPass, runTimed(10, false));
+    }
+    CHECK(Serial3.hostOutput().find(":READ_ALL:") != std::string::npos);
+    worstPass = max(worstPass, runTimed(6000, false));
+    CHECK(HostRuntime::takeConsole().find("Timeout waiting for pH/O2 transmitter response") != std::string::npos);
+    CHECK(worstPass < 10000);
+
+    // Plugged back with the stale request still in its buffer: the answer to it is counted as unmatched and
+    // not taken for the current reading, a new reading is then made with the new inputs
+    UnoTransmitter::setAnalogInput(A1, 307);
+    HostRuntime::setPeer(UnoTransmitter::service);
+    runTimed(30000);
+    std::string statistics = linkStatistics();
+    printf("late answer: %ld unmatched, %ld timeouts, pH now %.1f\n", valueBefore(statistics, " unmatched answers"),
+           valueBefore(statistics, " timeouts"), SensorController::getSnapshot().pH);
+    CHECK(valueBefore(statistics, " unmatched answers") == 1);
+    CHECK(valueBefore(statistics, " timeouts") == 1);
+    CHECK_NEAR(SensorController::getSnapshot().pH, 7.0, 1e-4);
+}
+
+int main() {
+    UnoTransmitter::setAnalogInput(A1, PH_INPUT);
+    UnoTransmitter::setAnalogInput(A5, OXYGEN_INPUT);
+    UnoTransmitter::boot(Serial3);
+    HostRuntime::boot();
+    HostRuntime::runFor(30000);
+
+    checkReadings();
+    checkCalibration();
+    checkLateAnswer();
+    return testResult();
+}
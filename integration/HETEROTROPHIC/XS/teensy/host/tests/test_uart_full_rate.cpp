@@ -0,0 +1,117 @@
+// ESP32 link at 460800 baud with the wire saturated: the bytes arrive at the line rate into the UART receive buffer
+// (Communication's RX memory included), the loop drains it without ever waiting and no byte is lost. The margin is
+// the time the buffer takes to fill: a pass shorter than that loses nothing, a longer one does.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <string>
+
+void loop();
+
+static const unsigned long BAUD = 460800;
+static const double BYTES_PER_MS = BAUD / 10 / 1000.0;
+
+static int count(const std::string& text, const std::string& pattern) {
+    int found = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) found++;
+    return found;
+}
+
+struct Run {
+    uint64_t worstPass = 0;
+    size_t peakBuffered = 0;
+    std::string link;
+    std::string console;
+};
+
+// loop() on a 1 ms tick until the wire is idle, timing every pass and noting the receive buffer fill
+static Run runUntilIdle(uint64_t stallAtMs = 0, uint64_t stallMs = 0) {
+    Run run;
+    uint64_t start = HostRuntime::nowMicros();
+    bool stalled = false;
+    while (Serial7.hostWirePending() > 0 || Serial7.available() > 0) {
+        if (!stalled && stallMs > 0 && HostRuntime::nowMicros() - start >= stallAtMs * 1000) {
+            HostRuntime::advanceMillis(stallMs);
+            stalled = true;
+        }
+        run.peakBuffered = max(run.peakBuffered, static_cast<size_t>(Serial7.available()));
+        uint64_t passStart = HostRuntime::nowMicros();
+        loop();
+        run.worstPass = max(run.worstPass, HostRuntime::nowMicros() - passStart);
+        run.link += Serial7.hostTakeOutput();
+        run.console += HostRuntime::takeConsole();
+        HostRuntime::advanceMicros(1000);
+    }
+    HostRuntime::runFor(20);
+    run.link += Serial7.hostTakeOutput();
+    run.console += HostRuntime::takeConsole();
+    return run;
+}
+
+// Seconds of saturated wire: link PINGs back to back, with a command every 20 ms
+static std::string saturatedStream(int seconds, int& pings, int& commands) {
+    std::string stream;
+    pings = 0;
+    commands = 0;
+    size_t nextCommand = 0;
+    while (stream.size() < seconds * BYTES_PER_MS * 1000) {
+        if (stream.size() >= nextCommand) {
+            stream += "telemetry json\n";
+            commands++;
+            nextCommand += static_cast<size_t>(20 * BYTES_PER_MS);
+        } else {
+            stream += "LINK:PING\n";
+            pings++;
+        }
+    }
+    return stream;
+}
+
+int main() {
+    HostRuntime::boot();
+    Serial7.hostInject("LINK:BAUD:" + std::to_string(BAUD) + "\n");
+    HostRuntime::runFor(20);
+    CHECK(Serial7.hostBaud() == BAUD);
+    Serial7.hostSend("LINK:PING\n");
+    HostRuntime::runFor(20);
+    CHECK(HostRuntime::takeConsole().find("ESP32 link running at 460800 baud") != std::string::npos);
+    Serial7.hostTakeOutput();
+
+    // 10 s at the line rate
+    int pings, commands;
+    std::string stream = saturatedStream(10, pings, commands);
+    Serial7.hostSend(stream);
+    Run run = runUntilIdle();
+    printf("%u bytes at %lu baud: %d PINGs, %d commands, %lu bytes dropped, receive buffer peak %u of %u bytes, "
+           "worst loop pass %llu us\n", static_cast<unsigned>(stream.size()), BAUD, pings, commands,
+           Serial7.hostDroppedBytes(), static_cast<unsigned>(run.peakBuffered),
+           static_cast<unsigned>(Serial7.hostRxCapacity()), static_cast<unsigned long long>(run.worstPass));
+    CHECK(Serial7.hostDroppedBytes() == 0);
+    CHECK(count(run.link, "LINK:PONG\r\n") == pings);
+    CHECK(count(run.console, "Received from ESP32: telemetry json") == commands);
+    CHECK(run.console.find("Unknown command") == std::string::npos);
+    CHECK(run.console.find("ESP32 link lost") == std::string::npos);
+    CHECK(run.worstPass == 0);
+    CHECK(Serial7.hostBaud() == BAUD);
+
+    // The slowest pass of the sketch (a 40 ms SD card erase stall, see test_sd_logger_bench) loses nothing,
+    // a pass longer than the buffer fill time does
+    double fillMs = Serial7.hostRxCapacity() / BYTES_PER_MS;
+    const uint64_t shortStall = 45;
+    Serial7.hostSend(saturatedStream(1, pings, commands));
+    run = runUntilIdle(500, shortStall);
+    printf("%llu ms pass (buffer fills in %.1f ms): %lu bytes dropped, peak %u bytes\n",
+           static_cast<unsigned long long>(shortStall), fillMs, Serial7.hostDroppedBytes(),
+           static_cast<unsigned>(run.peakBuffered));
+    CHECK(Serial7.hostDroppedBytes() == 0);
+    CHECK(count(run.link, "LINK:PONG\r\n") == pings);
+    CHECK(count(run.console, "Received from ESP32: telemetry json") == commands);
+
+    uint64_t longStall = static_cast<uint64_t>(fillMs * 1.5);
+    Serial7.hostSend(saturatedStream(1, pings, commands));
+    runUntilIdle(500, longStall);
+    printf("%llu ms pass: %lu bytes dropped\n", static_cast<unsigned long long>(longStall),
+           Serial7.hostDroppedBytes());
+    CHECK(Serial7.hostDroppedBytes() > 0);
+    return testResult();
+}
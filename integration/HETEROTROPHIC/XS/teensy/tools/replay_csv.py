@@ -0,0 +1,98 @@
+"""
+Replay a backend CSV (ServerFastAPI data/data.csv) through the Teensy control code.
+
+The Teensy replaces its sensors by the recorded values and runs PIDManager and SafetySystem on a
+virtual clock (see ReplayHarness.h). For every periodic row this script sends one "replay step" and
+collects the resulting "REPLAY:" line: actuator values and PID/safety compute time.
+
+The setpoints of the Fermentation program events found in the CSV are sent as "replay setpoints"
+commands: the PIDs run with the recorded setpoints, but no program is started and nothing of the
+replay is written to the EEPROM.
+
+Warning: the actuators connected to the Teensy are driven by the replay.
+
+Usage:
+    python replay_csv.py data.csv COM4 --output replay_out.csv
+"""
+import argparse
+import csv
+import time
+from datetime import datetime
+
+import serial
+
+SENSOR_COLUMNS = ["waterTemp", "airTemp", "elecTemp", "pH", "turbidity", "oxygen", "airFlow"]
+ACTUATOR_COLUMNS = ["airPump", "drainPump", "samplePump", "nutrientPump", "basePump",
+                    "fillPump", "stirringMotor", "heatingPlate", "ledGrowLight"]  # ActuatorId order
+
+
+def send(ser, command):
+    ser.write((command + "\n").encode("ascii"))
+
+
+def wait_for_step(ser, timeout):
+    """Return the fields of the next REPLAY: line, None on timeout."""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        line = ser.readline().decode("utf-8", errors="replace").strip()
+        if line.startswith("REPLAY:"):
+            return line[len("REPLAY:"):].split(",")
+    return None
+
+
+def setpoints_command(row):
+    return "replay setpoints " + " ".join([row["tempSetpoint"], row["pHSetpoint"], row["DOSetpoint"]])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay recorded sensor data through the Teensy PID and safety code")
+    parser.add_argument("csv_file")
+    parser.add_argument("port")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--output", default="replay_out.csv")
+    # The PIDs compute on the virtual time of the steps, the next row can be sent as soon as a step is answered
+    parser.add_argument("--min-interval", type=float, default=0.0, help="Minimum real time between two steps (s)")
+    args = parser.parse_args()
+
+    ser = serial.Serial(args.port, args.baud, timeout=0.5)
+    time.sleep(2)
+    ser.reset_input_buffer()
+    send(ser, "replay start")
+
+    steps = 0
+    with open(args.csv_file, newline="") as source, open(args.output, "w", newline="") as output:
+        writer = csv.writer(output)
+        writer.writerow(["Backend_Time", "step", "virtual_ms", "compute_us"] + ACTUATOR_COLUMNS)
+
+        previous_time = None
+        for row in csv.DictReader(source):
+            if row["Event_Type"] == "program_event" and row.get("program") == "Fermentation":
+                send(ser, setpoints_command(row))
+                continue
+            if row["Event_Type"] != "periodic" or any(row[c] in ("", None) for c in SENSOR_COLUMNS):
+                continue
+
+            row_time = datetime.strptime(row["Backend_Time"], "%Y-%m-%d %H:%M:%S")
+            dt_ms = int((row_time - previous_time).total_seconds() * 1000) if previous_time else 0
+            previous_time = row_time
+
+            step_start = time.time()
+            send(ser, "replay step " + str(max(dt_ms, 0)) + " " + " ".join(row[c] for c in SENSOR_COLUMNS))
+            fields = wait_for_step(ser, timeout=5.0)
+            if fields is None:
+                print(f"No answer for the row at {row['Backend_Time']}, stopping")
+                break
+            writer.writerow([row["Backend_Time"]] + fields)
+            steps += 1
+
+            remaining = args.min_interval - (time.time() - step_start)
+            if remaining > 0:
+                time.sleep(remaining)
+
+    send(ser, "replay stop")
+    ser.close()
+    print(f"{steps} steps replayed, results in {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,122 @@
+"""
+Fetch a log file of the Teensy SD card logger (see SdLogger.h) and convert it to CSV.
+
+The file is either read from the Teensy console ("dump <n>" command, DUMP: hex lines) or, with --file,
+straight from a LOGnnnn.BIN copied from the card. Samples whose CRC does not match (end of a file cut by a
+reset, padding) are skipped; gaps in the sequence numbers are samples dropped by the Teensy.
+
+Usage:
+    python sdlog_dump.py COM4 12 --output log12.csv
+    python sdlog_dump.py --file LOG0012.BIN --output log12.csv
+"""
+import argparse
+import csv
+import struct
+
+import serial
+
+SECTOR_SIZE = 512
+HEADER_FORMAT = "<4sBBHII16s128s"
+RECORD_FORMAT = "<IHBB7fH9h3HH"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+SENSOR_COLUMNS = ["waterTemp", "airTemp", "elecTemp", "pH", "turbidity", "oxygen", "airFlow"]
+ACTUATOR_COLUMNS = ["airPump", "drainPump", "samplePump", "nutrientPump", "basePump",
+                    "fillPump", "stirringMotor", "heatingPlate", "ledGrowLight"]  # ActuatorId order
+VOLUME_COLUMNS = ["currentVolume", "addedNaOH", "addedNutrient"]  # L
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as TelemetryProtocol::crc16()."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def read_from_console(port, baud, index, timeout):
+    ser = serial.Serial(port, baud, timeout=timeout)
+    ser.reset_input_buffer()
+    ser.write(f"dump {index}\n".encode("ascii"))
+    data = bytearray()
+    started = False
+    while True:
+        line = ser.readline().decode("ascii", errors="replace").strip()
+        if not line:
+            ser.close()
+            raise RuntimeError("No answer from the Teensy" if not started else "Dump interrupted")
+        if not line.startswith("DUMP:"):
+            continue
+        content = line[len("DUMP:"):]
+        if content.startswith("BEGIN"):
+            started = True
+            print(f"Receiving {content[len('BEGIN '):]} bytes")
+        elif content.startswith("END"):
+            break
+        elif started:
+            data += bytes.fromhex(content)
+    ser.close()
+    return bytes(data)
+
+
+def decode(data, writer):
+    magic, version, record_size, _, file_index, start_time, program, command = \
+        struct.unpack_from(HEADER_FORMAT, data, 0)
+    if magic != b"BRLG" or record_size != RECORD_SIZE:
+        raise ValueError("Not an SD logger file, or unsupported version")
+    program = program.split(b"\0")[0].decode(errors="replace")
+    command = command.split(b"\0")[0].decode(errors="replace")
+    print(f"File {file_index} (version {version}): {program}, command: {command}")
+
+    samples = skipped = dropped = 0
+    previous_sequence = None
+    for offset in range(SECTOR_SIZE, len(data) - RECORD_SIZE + 1, RECORD_SIZE):
+        raw = data[offset:offset + RECORD_SIZE]
+        values = struct.unpack(RECORD_FORMAT, raw)
+        if values[-1] != crc16(raw[:-2]):
+            skipped += 1
+            continue
+        time_ms, sequence, state = values[0], values[1], values[2]
+        sensors = values[4:11]
+        running = values[11]
+        actuators = values[12:21]
+        volumes = [v / 10000.0 for v in values[21:24]]
+        if previous_sequence is not None:
+            dropped += (sequence - previous_sequence - 1) & 0xFFFF
+        previous_sequence = sequence
+        writer.writerow([time_ms, sequence, program, state] + [f"{v:.3f}" for v in sensors] +
+                        [actuators[i] if running & (1 << i) else 0 for i in range(len(ACTUATOR_COLUMNS))] +
+                        [f"{v:.4f}" for v in volumes])
+        samples += 1
+    print(f"{samples} samples, {dropped} dropped by the Teensy, {skipped} invalid records skipped")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a Teensy SD card log file to CSV")
+    parser.add_argument("port", nargs="?")
+    parser.add_argument("index", nargs="?", type=int, help="n of LOGnnnn.BIN, see the 'dump' command")
+    parser.add_argument("--file", help="LOGnnnn.BIN copied from the card instead of the console")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=5.0, help="Maximum silence during the dump (s)")
+    parser.add_argument("--output", default="sdlog.csv")
+    args = parser.parse_args()
+
+    if args.file:
+        with open(args.file, "rb") as source:
+            data = source.read()
+    elif args.port and args.index is not None:
+        data = read_from_console(args.port, args.baud, args.index, args.timeout)
+    else:
+        parser.error("give a port and a file index, or --file")
+
+    with open(args.output, "w", newline="") as output:
+        writer = csv.writer(output)
+        writer.writerow(["Teensy_ms", "sequence", "program", "programState"] + SENSOR_COLUMNS +
+                        ACTUATOR_COLUMNS + VOLUME_COLUMNS)
+        decode(data, writer)
+    print(f"Written to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
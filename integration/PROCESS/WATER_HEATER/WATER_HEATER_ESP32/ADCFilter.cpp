@@ -0,0 +1,54 @@
+/**
+ * ADCFilter.cpp
+ * Implementation of the streaming trimmed mean.
+ */
+
+#include "ADCFilter.h"
+#include <algorithm>
+
+ADCFilter::ADCFilter(size_t blockSize, size_t discard)
+    : _blockSize(std::min(std::max(blockSize, static_cast<size_t>(1)), MAX_BLOCK_SIZE))
+    , _discard(discard) {
+    // At least one sample left in the mean
+    if (2 * _discard >= _blockSize) {
+        _discard = (_blockSize - 1) / 2;
+    }
+}
+
+bool ADCFilter::add(uint16_t raw) {
+    _block[_used++] = raw;
+    if (_used < _blockSize) {
+        return false;
+    }
+    _value = trimmedMean(_block, _used, _discard);
+    _used = 0;
+    _blockCount++;
+    return true;
+}
+
+void ADCFilter::reset() {
+    _used = 0;
+    _value = 0;
+    _blockCount = 0;
+}
+
+uint16_t ADCFilter::trimmedMean(uint16_t* samples, size_t count, size_t discard) {
+    if (count == 0) return 0;
+    if (2 * discard >= count) {
+        discard = (count - 1) / 2;
+    }
+
+    // Average selection in O(n): the `discard` lowest samples before first, the highest after last
+    uint16_t* first = samples + discard;
+    uint16_t* last = samples + count - discard;
+    if (discard > 0) {
+        std::nth_element(samples, first, samples + count);
+        std::nth_element(first, last - 1, samples + count);
+    }
+
+    uint32_t sum = 0;
+    for (uint16_t* sample = first; sample < last; sample++) {
+        sum += *sample;
+    }
+    return sum / (count - 2 * discard);
+}
@@ -0,0 +1,48 @@
+/**
+ * ADCFilter.h
+ * Streaming trimmed mean of raw ADC samples.
+ *
+ * Samples are collected in blocks of blockSize; when a block is full the lowest and highest `discard` samples are
+ * dropped and the others averaged. Outliers (spikes, DMA glitches) are rejected as with a median, in O(n) per block
+ * (two selections instead of a sort).
+ * Plain C++, no Arduino dependency: the filter can be fed with recorded ADC traces on a host.
+ */
+
+#ifndef ADC_FILTER_H
+#define ADC_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class ADCFilter {
+public:
+    static constexpr size_t MAX_BLOCK_SIZE = 512;
+
+    ADCFilter(size_t blockSize, size_t discard);
+
+    /*
+     * Add a raw sample to the block being collected.
+     * @return: true when the sample completed a block and value() was updated.
+     */
+    bool add(uint16_t raw);
+
+    uint16_t value() const { return _value; }          // Trimmed mean of the last complete block
+    uint32_t blockCount() const { return _blockCount; }
+    void reset();
+
+    /*
+     * Trimmed mean of samples, reordered in place.
+     * @param discard: number of samples dropped at each end.
+     */
+    static uint16_t trimmedMean(uint16_t* samples, size_t count, size_t discard);
+
+private:
+    size_t _blockSize;
+    size_t _discard;
+    uint16_t _block[MAX_BLOCK_SIZE];
+    size_t _used = 0;
+    uint16_t _value = 0;
+    uint32_t _blockCount = 0;
+};
+
+#endif // ADC_FILTER_H
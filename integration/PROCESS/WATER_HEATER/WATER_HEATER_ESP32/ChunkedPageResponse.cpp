@@ -0,0 +1,32 @@
+// ChunkedPageResponse.cpp
+#include "ChunkedPageResponse.h"
+
+void ChunkedPageResponse::send(AsyncWebServerRequest* request, const char* contentType, Renderer render) {
+    // Called from the async TCP task: rendering must not block
+    AsyncWebServerResponse* response = request->beginChunkedResponse(contentType,
+        [render](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            Window window(buffer, index, maxLen);
+            render(window);
+            return window.length();     // 0 once index is past the end: last chunk
+        });
+    request->send(response);
+}
+
+ChunkedPageResponse::Window::Window(uint8_t* buffer, size_t start, size_t size)
+    : buffer(buffer), start(start), size(size), position(0), copied(0) {}
+
+size_t ChunkedPageResponse::Window::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t ChunkedPageResponse::Window::write(const uint8_t* data, size_t length) {
+    size_t end = position + length;
+    if (end > start && copied < size) {
+        size_t from = position > start ? 0 : start - position;
+        size_t count = min(length - from, size - copied);
+        memcpy(buffer + copied, data + from, count);
+        copied += count;
+    }
+    position = end;
+    return length;      // Bytes past the window are dropped, the writer must not stop
+}
@@ -0,0 +1,42 @@
+// ChunkedPageResponse.h
+#ifndef CHUNKED_PAGE_RESPONSE_H
+#define CHUNKED_PAGE_RESPONSE_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <functional>
+
+/*
+ * Sends a page written to a Print (WebPageBuilder) as an AsyncWebServer chunked response, never held whole in RAM.
+ * AsyncWebServer pulls the body one TCP window at a time: the page is written again for every chunk and only the
+ * bytes of that window are kept. The page must therefore be the same on every call: the renderer captures its
+ * values when the request arrives.
+ */
+class ChunkedPageResponse {
+public:
+    using Renderer = std::function<void(Print& out)>;
+
+    static void send(AsyncWebServerRequest* request, const char* contentType, Renderer render);
+
+private:
+    // Print keeping bytes [start, start + size) of what is written into buffer
+    class Window : public Print {
+    public:
+        Window(uint8_t* buffer, size_t start, size_t size);
+
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t* data, size_t size) override;
+        using Print::write;
+
+        size_t length() const { return copied; }
+
+    private:
+        uint8_t* buffer;
+        size_t start;
+        size_t size;
+        size_t position;        // Bytes written so far, including the skipped ones
+        size_t copied;
+    };
+};
+
+#endif // CHUNKED_PAGE_RESPONSE_H
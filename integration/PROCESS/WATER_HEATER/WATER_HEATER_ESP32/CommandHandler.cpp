@@ -4,6 +4,7 @@
 #include "MQTTClient.h"
 #include "DataManager.h"
 #include "Logger.h"
+#include "SafetyInterlock.h"
 
 CommandHandler::CommandHandler(StateMachine& stateMachine, MQTTClient& mqttClient)
    : _stateMachine(stateMachine)
@@ -49,6 +50,9 @@ void CommandHandler::executeCommand(const String& command) {
        _stateMachine.stopAllPrograms();
        Logger::log(Logger::LogLevel::INFO, F("Program stopped"));
    }
+   else if (command == "reset") {
+       SafetyInterlock::reset();
+   }
    else {
        Logger::log(Logger::LogLevel::WARNING, "Unknown command: " + command);
    }
@@ -62,6 +66,7 @@ void CommandHandler::printHelp() {
    Serial.println(F("Available commands:"));
    Serial.println(F("cip <temp> <duration> - Start CIP program"));
    Serial.println(F("stop - Stop current program"));
+   Serial.println(F("reset - Reset the safety interlock after a trip"));
    Serial.println(F("help - Show this help message"));
    Serial.println(F("\nHTTP Endpoints:"));
    Serial.println(F("GET http://<ip>/  - Main dashboard"));
@@ -94,6 +99,12 @@ void CommandHandler::handleJsonCommand(const String& jsonCommand) {
         SensorData data = DataManager::collectSensorData();
         _mqttClient.publishSensorData(data);
     }
+    else if (command == "resetInterlock") {
+        SafetyInterlock::reset();
+    }
+    else if (command == "telemetryFormat") {
+        _mqttClient.setTelemetryFormat(doc["params"]["format"].as<String>());
+    }
     else if (command == "cip") {
         JsonObject params = doc["params"].as<JsonObject>();
         String cipCmd = "cip " + String(params["temp"].as<float>()) + " " + 
@@ -3,18 +3,16 @@
 #include "StateMachine.h" // to avoid circular dependencies 
 
 SensorData DataManager::collectSensorData() {
+    // Both values from the same sampling cycle
+    SensorSnapshot snapshot = SensorController::getSnapshot();
     SensorData data;
-    data.waterTemp = SensorController::readSensor("waterTempSensor");
-    data.pressure = SensorController::readSensor("pressureSensor");
+    data.waterTemp = snapshot.waterTemp;
+    data.pressure = snapshot.pressure;
     return data;
 }
 
 PressureStats DataManager::collectPressureStats() {
-    PressureSensor* sensor = (PressureSensor*)SensorController::findSensorByName("pressureSensor");
-    if (sensor) {
-        return sensor->getStatistics();
-    }
-    return PressureStats{};
+    return SensorController::getSnapshot().pressureStats;
 }
 
 String DataManager::collectActuatorState() {
@@ -65,7 +63,14 @@ String DataManager::collectProgramState(const String& programName, ProgramBase*
 
 String DataManager::collectAllData(const StateMachine& stateMachine) {
     JsonDocument doc;
+    addAllData(doc, stateMachine);
     
+    String output;
+    serializeJson(doc, output);
+    return output;
+}
+
+void DataManager::addAllData(JsonDocument& doc, const StateMachine& stateMachine) {
     // Programme et état
     doc["program"] = stateMachine.getCurrentProgram();
     doc["state"] = static_cast<int>(stateMachine.getCurrentState());
@@ -74,10 +79,17 @@ String DataManager::collectAllData(const StateMachine& stateMachine) {
     addSensorDataToJson(doc);
     addActuatorDataToJson(doc);
     addSystemDataToJson(doc);
-    
-    String output;
-    serializeJson(doc, output);
-    return output;
+}
+
+size_t DataManager::writeLiveData(char* buffer, size_t size, const StateMachine& stateMachine) {
+    SensorData data = collectSensorData();
+    int length = snprintf(buffer, size,
+        "{\"waterTemp\":%.2f,\"pressure\":%.3f,\"heating\":%s,\"program\":\"%s\",\"state\":%d,\"uptime\":%lu}",
+        data.waterTemp, data.pressure,
+        ActuatorController::isActuatorRunning("heatingPlate") ? "true" : "false",
+        stateMachine.getCurrentProgram().c_str(), static_cast<int>(stateMachine.getCurrentState()),
+        millis() / 1000);
+    return (length > 0 && static_cast<size_t>(length) < size) ? length : 0;
 }
 
 void DataManager::addSensorDataToJson(JsonDocument& doc) {
@@ -92,8 +104,13 @@ void DataManager::addActuatorDataToJson(JsonDocument& doc) {
 }
 
 void DataManager::addSystemDataToJson(JsonDocument& doc) {
+    // Formatted on the stack: IPAddress::toString() allocates a String on every publish
+    IPAddress localIP = WiFi.localIP();
+    char ip[16];
+    snprintf(ip, sizeof(ip), "%u.%u.%u.%u", localIP[0], localIP[1], localIP[2], localIP[3]);
+
     doc["deviceInfo"]["id"] = MQTT_CLIENT_ID;
-    doc["deviceInfo"]["ip"] = WiFi.localIP().toString();
+    doc["deviceInfo"]["ip"] = ip;
     doc["deviceInfo"]["uptime"] = millis() / 1000;
     doc["systemMetrics"]["freeHeap"] = ESP.getFreeHeap();
     doc["systemMetrics"]["wifiStrength"] = WiFi.RSSI();
@@ -101,16 +118,22 @@ void DataManager::addSystemDataToJson(JsonDocument& doc) {
 
 String DataManager::createHeartbeatMessage() {
     JsonDocument doc;
-    doc["type"] = "heartbeat";
-    doc["uptime"] = millis() / 1000;
-    doc["heap"] = ESP.getFreeHeap();
-    doc["wifi_strength"] = WiFi.RSSI();
+    addHeartbeatData(doc);
     
     String output;
     serializeJson(doc, output);
     return output;
 }
 
+void DataManager::addHeartbeatData(JsonDocument& doc) {
+    doc["type"] = "heartbeat";
+    doc["uptime"] = millis() / 1000;
+    doc["heap"] = ESP.getFreeHeap();
+    doc["heap_min"] = ESP.getMinFreeHeap();
+    doc["heap_max_block"] = ESP.getMaxAllocHeap();      // Falls below heap when the heap fragments
+    doc["wifi_strength"] = WiFi.RSSI();
+}
+
 String DataManager::createErrorMessage(const String& error) {
     JsonDocument doc;
     doc["error"] = error;
@@ -36,9 +36,15 @@ public:
     
     // Collection complète
     static String collectAllData(const StateMachine& stateMachine);
+    static void addAllData(JsonDocument& doc, const StateMachine& stateMachine);     // Into a caller's document (MQTT pool)
+
+    // Live values of the web dashboard (/api/live, /events) as JSON, written into buffer; returns the length (0 if it does not fit)
+    static const size_t LIVE_DATA_SIZE = 192;
+    static size_t writeLiveData(char* buffer, size_t size, const StateMachine& stateMachine);
 
     //
     static String createHeartbeatMessage();
+    static void addHeartbeatData(JsonDocument& doc);
     static String createErrorMessage(const String& error);
     static bool parseSensorCommand(const String& message, SensorData& data);
     static bool parseCommand(const String& message, String& command, JsonDocument& params);
@@ -78,6 +78,7 @@ void HeatingPlate::setCycleTime(unsigned long newCycleTime) {
 
 #include "HeatingPlate.h"
 #include "Logger.h"
+#include "SafetyInterlock.h"
 
 HeatingPlate::HeatingPlate(int relayPin, bool isPWMCapable, const char* name)
     : _relayPin(relayPin), _name(name), _status(false), _isPWMCapable(isPWMCapable), _currentValue(0) {
@@ -92,6 +93,16 @@ void HeatingPlate::begin() {
 void HeatingPlate::control(bool state, int value) {
     value = constrain(value, 0, 100);
 
+    // Latched interlock fault: the plate stays off until SafetyInterlock::reset()
+    if (state && SafetyInterlock::isTripped()) {
+        if (_status || _currentValue != 0) {
+            Logger::log(Logger::LogLevel::WARNING, String(_name) + " locked off by the safety interlock");
+        }
+        controlOnOff(false);
+        _currentValue = 0;
+        return;
+    }
+
     Logger::log(Logger::LogLevel::INFO, String(_name) + 
         " Control called - State: " + String(state) + 
         ", Value: " + String(value) + 
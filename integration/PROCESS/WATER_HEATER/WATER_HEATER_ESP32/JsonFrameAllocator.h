@@ -0,0 +1,44 @@
+// JsonFrameAllocator.h
+// The same file is used by the XS Teensy (HETEROTROPHIC/XS/teensy/Main/JsonFrameAllocator.h): keep the copies in sync.
+#ifndef JSON_FRAME_ALLOCATOR_H
+#define JSON_FRAME_ALLOCATOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/*
+ * ArduinoJson allocator serving memory from a fixed buffer instead of the heap.
+ * Memory is never returned block by block: reset() releases everything at once,
+ * so it is meant for a document that is built, serialized and dropped (one telemetry frame).
+ */
+class JsonFrameAllocator : public ArduinoJson::Allocator {
+public:
+    JsonFrameAllocator(uint8_t* buffer, size_t capacity);
+
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
+
+    /*
+     * Release every block. Must only be called once no document uses the allocator anymore.
+     */
+    void reset();
+
+    size_t used() const { return _used; }
+    size_t capacity() const { return _capacity; }
+
+private:
+    // Each block is preceded by its size so that reallocate() can copy it
+    struct BlockHeader {
+        size_t size;
+    };
+
+    uint8_t* _buffer;
+    size_t _capacity;
+    size_t _used;
+    uint8_t* _lastBlock; // Last block handed out, can grow or shrink in place
+
+    static size_t align(size_t size) { return (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1); }
+};
+
+#endif // JSON_FRAME_ALLOCATOR_H
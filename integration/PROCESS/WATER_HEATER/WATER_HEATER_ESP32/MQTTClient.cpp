@@ -1,13 +1,19 @@
 // ===== MQTTClient.cpp =====
 #include "MQTTClient.h"
+#include <ezTime.h>
 
 MQTTClient::MQTTClient()
     : reconnectTaskHandle(nullptr)
     , heartbeatTaskHandle(nullptr)
     , messageQueue(nullptr)
+    , messagePool(MQTT_POOL_SIZE)
+    , receiving(nullptr)
     , stateMachine(nullptr)
     , connected(false)
     , retryCount(0)
+    , telemetryBatch(TELEMETRY_SCHEMA, TELEMETRY_CHANNELS, TELEMETRY_BATCH_SIZE, TELEMETRY_KEYFRAME_INTERVAL)
+    , batchTelemetry(TELEMETRY_BATCH_DEFAULT)
+    , keyframeRequested(false)
     , connectionEstablishedCallback(nullptr)
     , connectionLostCallback(nullptr)
     , messageCallback(nullptr)
@@ -31,8 +37,12 @@ bool MQTTClient::begin() {
         WiFiManager::connect();
     }
     
-    // Créer la queue de messages
-    messageQueue = TaskManager::createQueue(MQTT_QUEUE_SIZE, sizeof(MQTTMessage));
+    // Créer le pool et la queue de messages (pointeurs vers le pool)
+    if (!messagePool.begin()) {
+        Logger::log(Logger::LogLevel::ERROR, F("MQTT message pool allocation failed"));
+        return false;
+    }
+    messageQueue = TaskManager::createQueue(MQTT_POOL_SIZE, sizeof(MQTTMessagePool::Message*));
     
     // Configuration MQTT
     setupMQTT();
@@ -83,10 +93,17 @@ void MQTTClient::dataSenderTask(void* parameter) {
     TickType_t xLastWakeTime = xTaskGetTickCount();
     
     while (true) {
+        if (client->batchTelemetry) {
+            // One sample per TELEMETRY_SAMPLE_INTERVAL, published TELEMETRY_BATCH_SIZE at a time
+            client->addTelemetrySample();
+            vTaskDelayUntil(&xLastWakeTime, client->sampleFrequency);
+            continue;
+        }
+        if (!client->telemetryBatch.isEmpty()) {
+            client->publishTelemetryBatch();   // Switched to JSON
+        }
         if (client->isConnected()) {
             SensorData data = DataManager::collectSensorData();
-            String jsonData = DataManager::collectAllData(*client->stateMachine);
-            Logger::log(Logger::LogLevel::INFO, "Data collected: " + jsonData);
             
             if (client->publishSensorData(data)) {
                 Logger::log(Logger::LogLevel::INFO, "Data sent successfully");
@@ -98,6 +115,68 @@ void MQTTClient::dataSenderTask(void* parameter) {
     }
 }
 
+void MQTTClient::addTelemetrySample() {
+    if (keyframeRequested.exchange(false)) {
+        telemetryBatch.requestKeyframe();
+    }
+    if (!isConnected() || !stateMachine) {
+        // Subscribers lose the batch being built: the next one starts with a keyframe
+        if (!telemetryBatch.isEmpty()) {
+            telemetryBatch.requestKeyframe();
+            telemetryBatch.next();
+        }
+        return;
+    }
+
+    // A batch carries a single program name
+    String program = stateMachine->getCurrentProgram();
+    if (!telemetryBatch.isEmpty() && program != telemetryBatch.getLabel()) {
+        publishTelemetryBatch();
+    }
+    telemetryBatch.setLabel(program);
+
+    // Channel order and scales of schema 1 in telemetry_batch.py
+    SensorData data = DataManager::collectSensorData();
+    int32_t values[TELEMETRY_CHANNELS] = {
+        static_cast<int32_t>(stateMachine->getCurrentState()),
+        TelemetryBatch::toFixed(data.waterTemp, 100),
+        TelemetryBatch::toFixed(data.pressure, 1000),
+        ActuatorController::isActuatorRunning("heatingPlate") ? 1 : 0,
+        ActuatorController::getCurrentValue("heatingPlate")
+    };
+    uint32_t time = timeStatus() == timeSet ? UTC.now() : 0;
+    if (telemetryBatch.addSample(time, millis(), values)) {
+        publishTelemetryBatch();
+    }
+}
+
+bool MQTTClient::publishTelemetryBatch() {
+    bool sent = isConnected() &&
+                mqttClient.publish(MQTT_TOPIC_SENSORS_BATCH, 0, false,
+                                   reinterpret_cast<const char*>(telemetryBatch.data()), telemetryBatch.length()) != 0;
+    if (!sent) {
+        telemetryBatch.requestKeyframe();
+        Logger::log(Logger::LogLevel::ERROR, F("Failed to send telemetry batch"));
+    }
+    telemetryBatch.next();
+    return sent;
+}
+
+bool MQTTClient::setTelemetryFormat(const String& format) {
+    if (format != "batch" && format != "json") {
+        Logger::log(Logger::LogLevel::WARNING, "Unknown telemetry format: " + format);
+        return false;
+    }
+    // The data sender task publishes the partial batch on its own, and restarts batches with a keyframe
+    bool batch = (format == "batch");
+    if (batch && !batchTelemetry) {
+        keyframeRequested = true;
+    }
+    batchTelemetry = batch;
+    Logger::log(Logger::LogLevel::INFO, "MQTT telemetry format: " + format);
+    return true;
+}
+
 void MQTTClient::disconnect() {
     if (isConnected()) {
         publishStatus("offline");
@@ -157,13 +236,14 @@ void MQTTClient::heartbeatTask(void* parameter) {
 
 void MQTTClient::messageHandlerTask(void* parameter) {
     MQTTClient* client = static_cast<MQTTClient*>(parameter);
-    MQTTMessage message;
+    MQTTMessagePool::Message* message;
 
     while (true) {
         if (xQueueReceive(client->messageQueue, &message, portMAX_DELAY) == pdTRUE) {
             if (client->messageCallback) {
-                client->messageCallback(message.topic, message.payload);
+                client->messageCallback(message->topic, message->payload);
             }
+            client->messagePool.release(message);
         }
     }
 }
@@ -181,6 +261,9 @@ void MQTTClient::handleConnect(bool sessionPresent) {
     // Publier le status initial
     publishStatus("online");
 
+    // New subscribers can decode from the first batch
+    keyframeRequested = true;
+
     if (connectionEstablishedCallback) {
         connectionEstablishedCallback();
     }
@@ -198,55 +281,89 @@ void MQTTClient::handleDisconnect(AsyncMqttClientDisconnectReason reason) {
 void MQTTClient::handleMessage(char* topic, char* payload,
                              AsyncMqttClientMessageProperties properties,
                              size_t len, size_t index, size_t total) {
-    static unsigned long lastMsgTime = 0;
-    if (millis() - lastMsgTime < 100) return;
-    lastMsgTime = millis();
+    // A message larger than the TCP segment arrives in several chunks, copied at their index into the same slot
+    if (index == 0) {
+        if (receiving) {
+            messagePool.release(receiving);    // Previous message never completed
+            receiving = nullptr;
+        }
 
-    if (len >= sizeof(MQTTMessage::payload)) {
-        Logger::log(Logger::LogLevel::ERROR, F("Message too large"));
-        return;
+        static unsigned long lastMsgTime = 0;
+        if (millis() - lastMsgTime < 100) return;
+        lastMsgTime = millis();
+
+        if (total >= MQTTMessagePool::PAYLOAD_SIZE || strlen(topic) >= MQTTMessagePool::TOPIC_SIZE) {
+            Logger::log(Logger::LogLevel::ERROR, F("Message too large"));
+            return;
+        }
+        receiving = messagePool.acquire();
+        if (!receiving) {
+            Logger::log(Logger::LogLevel::ERROR, F("Message queue full"));
+            return;
+        }
+        strlcpy(receiving->topic, topic, sizeof(receiving->topic));
     }
+    if (!receiving || index + len > total || total >= MQTTMessagePool::PAYLOAD_SIZE) return;
 
-    MQTTMessage message;
-    strlcpy(message.topic, topic, sizeof(message.topic));
-    strlcpy(message.payload, payload, sizeof(message.payload));
+    // The payload is not NUL-terminated
+    memcpy(receiving->payload + index, payload, len);
+    if (index + len < total) return;
 
-    if (xQueueSend(messageQueue, &message, 0) != pdTRUE) {
+    receiving->payload[total] = '\0';
+    receiving->length = total;
+    if (xQueueSend(messageQueue, &receiving, 0) != pdTRUE) {
+        messagePool.release(receiving);
         Logger::log(Logger::LogLevel::ERROR, F("Message queue full"));
     }
+    receiving = nullptr;
+}
+
+template <typename Builder>
+bool MQTTClient::publishJson(const char* topic, uint8_t qos, bool retain, Builder builder) {
+    MQTTMessagePool::Message* message = messagePool.acquire();
+    if (!message) {
+        Logger::log(Logger::LogLevel::ERROR, F("MQTT message pool empty"));
+        return false;
+    }
+
+    bool sent = false;
+    if (messagePool.serialize(message, builder)) {
+        // AsyncMqttClient copies the payload into its own buffer: the slot is free again once publish() returns
+        sent = mqttClient.publish(topic, qos, retain, message->payload, message->length) != 0;
+    } else {
+        Logger::log(Logger::LogLevel::ERROR, "Generated message too large for " + String(topic));
+    }
+    messagePool.release(message);
+    return sent;
 }
 
 bool MQTTClient::publishSensorData(const SensorData& data) {
     if (!isConnected() || !stateMachine) return false;
 
-    String payload = DataManager::collectAllData(*stateMachine);
-    
-    if (payload.length() >= sizeof(MQTTMessage::payload)) {     //if (payload.length() >= JSON_BUFFER_SIZE) { 
-        Logger::log(Logger::LogLevel::ERROR, "Generated message too large: " + String(payload.length()) + " bytes");
-        return false;
-    }
-    
-    return mqttClient.publish(MQTT_TOPIC_SENSORS, 0, true, payload.c_str()) != 0;
+    return publishJson(MQTT_TOPIC_SENSORS, 0, true, [this](JsonDocument& doc) {
+        DataManager::addAllData(doc, *stateMachine);
+    });
 }
 
 bool MQTTClient::publishStatus(const String& status) {
     if (!isConnected()) return false;
 
-    JsonDocument doc;
-    doc["status"] = status;
-    doc["timestamp"] = millis();
-    String payload;
-    serializeJson(doc, payload);
-    
-    return mqttClient.publish(MQTT_TOPIC_STATUS, 0, true, payload.c_str()) != 0;
+    return publishJson(MQTT_TOPIC_STATUS, 0, true, [&status](JsonDocument& doc) {
+        doc["status"] = status;
+        doc["timestamp"] = millis();
+    });
 }
 
 bool MQTTClient::publishHeartbeat() {
     if (!isConnected()) return false;
 
-    String payload = DataManager::createHeartbeatMessage();
-    
-    return mqttClient.publish(MQTT_TOPIC_STATUS, 0, false, payload.c_str()) != 0;
+    return publishJson(MQTT_TOPIC_STATUS, 0, false, [this](JsonDocument& doc) {
+        DataManager::addHeartbeatData(doc);
+        // Lowest free slot count and arena use since boot: the pool is sized right when neither reaches its limit
+        doc["mqtt_pool_min"] = messagePool.getMinFreeSlots();
+        doc["mqtt_pool_failed"] = messagePool.getFailedAcquires();
+        doc["json_arena_peak"] = messagePool.getArenaPeak();
+    });
 }
 
 // Getters & Setters
@@ -273,6 +390,7 @@ void MQTTClient::onError(std::function<void(const char* error)> callback) {
 
 void MQTTClient::publishStateChange(const StateMachine& stateMachine) {
    if (!isConnected()) return;
-   String jsonData = DataManager::collectAllData(stateMachine);
-   mqttClient.publish(MQTT_TOPIC_SENSORS, 0, true, jsonData.c_str());  // Utiliser mqttClient au lieu de publish
+   publishJson(MQTT_TOPIC_SENSORS, 0, true, [&stateMachine](JsonDocument& doc) {
+       DataManager::addAllData(doc, stateMachine);
+   });
 }
\ No newline at end of file
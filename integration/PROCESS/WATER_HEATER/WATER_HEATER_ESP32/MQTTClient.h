@@ -5,11 +5,14 @@
 #include "StateMachine.h"
 #include <AsyncMqttClient.h>
 #include <functional>
+#include <atomic>
 #include "Logger.h"
 #include "TaskManager.h"
 #include "DataManager.h"
 #include "SystemMonitor.h"
 #include "WiFiManager.h"
+#include "TelemetryBatch.h"
+#include "MQTTMessagePool.h"
 #include "config.h"
 
 
@@ -30,6 +33,11 @@ public:
     bool publishHeartbeat();
     void publishStateChange(const StateMachine& stateMachine);
 
+    // "batch" (TelemetryBatch) or "json" (one collectAllData() per publish)
+    bool setTelemetryFormat(const String& format);
+
+    const MQTTMessagePool& getMessagePool() const { return messagePool; }
+
     // Callback setters
     void onConnectionEstablished(std::function<void()> callback);
     void onConnectionLost(std::function<void()> callback);
@@ -37,18 +45,17 @@ public:
     void onError(std::function<void(const char* error)> callback);
 
 private: 
-    struct MQTTMessage {
-        char topic[128];
-        char payload[1024];
-    };
-
     // MQTT client instance
     AsyncMqttClient mqttClient;
     
     // FreeRTOS resources
     TaskHandle_t reconnectTaskHandle;
     TaskHandle_t heartbeatTaskHandle;
-    QueueHandle_t messageQueue;
+    QueueHandle_t messageQueue;         // MQTTMessagePool::Message* received, released by the handler task
+
+    // Buffers of the received and published messages, no heap after begin()
+    MQTTMessagePool messagePool;
+    MQTTMessagePool::Message* receiving;    // Message whose next chunk is expected (AsyncMqttClient callback only)
 
     // Composants système
     StateMachine* stateMachine;
@@ -57,6 +64,11 @@ private:
     bool connected;
     int retryCount;
 
+    // Batched telemetry, built by the data sender task only: the other tasks set these flags, applied by it
+    TelemetryBatch telemetryBatch;
+    std::atomic<bool> batchTelemetry;
+    std::atomic<bool> keyframeRequested;
+
     // Callbacks
     std::function<void()> connectionEstablishedCallback;
     std::function<void()> connectionLostCallback;
@@ -69,6 +81,13 @@ private:
     static void messageHandlerTask(void* parameter);
     static void dataSenderTask(void* parameter);
     const TickType_t senderFrequency = pdMS_TO_TICKS(TASK_INTERVAL_DATASENDER);
+    const TickType_t sampleFrequency = pdMS_TO_TICKS(TELEMETRY_SAMPLE_INTERVAL);
+    void addTelemetrySample();
+    bool publishTelemetryBatch();
+
+    // Build the JSON with builder(JsonDocument&) into a pool message and publish it
+    template <typename Builder>
+    bool publishJson(const char* topic, uint8_t qos, bool retain, Builder builder);
 
     // MQTT handlers
     void setupMQTT();
@@ -0,0 +1,47 @@
+// MQTTMessagePool.cpp
+// The same file is used by the water bath (HETEROTROPHIC/WATER_BATH/main/MQTTMessagePool.cpp): keep both copies in sync.
+#include "MQTTMessagePool.h"
+
+MQTTMessagePool::MQTTMessagePool(size_t slotCount)
+    : slotCount(slotCount), slots(nullptr), freeSlots(nullptr), minFreeSlots(0), failedAcquires(0),
+      arena(arenaBuffer, JSON_ARENA_SIZE), arenaMutex(nullptr), arenaPeak(0) {}
+
+bool MQTTMessagePool::begin() {
+    if (slots) return true;
+
+    // The only allocations of the pool, kept for the whole uptime
+    slots = new (std::nothrow) Message[slotCount];
+    freeSlots = xQueueCreate(slotCount, sizeof(Message*));
+    arenaMutex = xSemaphoreCreateMutex();
+    if (!slots || !freeSlots || !arenaMutex) {
+        return false;
+    }
+
+    for (size_t i = 0; i < slotCount; i++) {
+        Message* message = &slots[i];
+        xQueueSend(freeSlots, &message, 0);
+    }
+    minFreeSlots = slotCount;
+    return true;
+}
+
+MQTTMessagePool::Message* MQTTMessagePool::acquire() {
+    Message* message = nullptr;
+    if (!freeSlots || xQueueReceive(freeSlots, &message, 0) != pdTRUE) {
+        failedAcquires++;
+        return nullptr;
+    }
+    size_t available = uxQueueMessagesWaiting(freeSlots);
+    if (available < minFreeSlots) minFreeSlots = available;
+
+    message->topic[0] = '\0';
+    message->payload[0] = '\0';
+    message->length = 0;
+    return message;
+}
+
+void MQTTMessagePool::release(Message* message) {
+    if (message) {
+        xQueueSend(freeSlots, &message, 0);
+    }
+}
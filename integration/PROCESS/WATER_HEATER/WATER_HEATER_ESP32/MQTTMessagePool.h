@@ -0,0 +1,87 @@
+// MQTTMessagePool.h
+// Fixed pool of MQTT message buffers, allocated once at begin().
+// The same file is used by the water bath (HETEROTROPHIC/WATER_BATH/main/MQTTMessagePool.h): keep both copies in sync.
+#ifndef MQTT_MESSAGE_POOL_H
+#define MQTT_MESSAGE_POOL_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include "JsonFrameAllocator.h"
+
+/*
+ * Received messages are copied once into a slot and passed between tasks as Message pointers; published JSON is
+ * serialized straight into a slot (serialize()) from a document whose memory comes from a fixed arena.
+ * Nothing is allocated on the heap after begin(): the heap does not fragment whatever the uptime.
+ */
+class MQTTMessagePool {
+public:
+    static const size_t TOPIC_SIZE = 64;
+    static const size_t PAYLOAD_SIZE = 1024;
+    static const size_t JSON_ARENA_SIZE = 4096;     // JsonDocument memory of one message being built
+
+    struct Message {
+        char topic[TOPIC_SIZE];
+        char payload[PAYLOAD_SIZE];                 // NUL-terminated
+        size_t length;
+    };
+
+    explicit MQTTMessagePool(size_t slotCount);
+    bool begin();
+
+    // A free slot, nullptr when all of them are in use (never waits)
+    Message* acquire();
+    void release(Message* message);
+
+    /*
+     * Build a JSON document with build(JsonDocument&) and serialize it into message->payload.
+     * Callable from any task, the arena is shared.
+     * @return: false when the document or its serialization does not fit.
+     */
+    template <typename Builder>
+    bool serialize(Message* message, Builder build);
+
+    // Statistics
+    size_t getSlotCount() const { return slotCount; }
+    size_t getFreeSlots() const { return freeSlots ? uxQueueMessagesWaiting(freeSlots) : 0; }
+    size_t getMinFreeSlots() const { return minFreeSlots; }
+    uint32_t getFailedAcquires() const { return failedAcquires; }
+    size_t getArenaPeak() const { return arenaPeak; }
+
+private:
+    size_t slotCount;
+    Message* slots;
+    QueueHandle_t freeSlots;                        // Message* of the free slots
+    size_t minFreeSlots;
+    uint32_t failedAcquires;
+
+    alignas(sizeof(void*)) uint8_t arenaBuffer[JSON_ARENA_SIZE];
+    JsonFrameAllocator arena;
+    SemaphoreHandle_t arenaMutex;
+    size_t arenaPeak;
+};
+
+template <typename Builder>
+bool MQTTMessagePool::serialize(Message* message, Builder build) {
+    if (!message || xSemaphoreTake(arenaMutex, portMAX_DELAY) != pdTRUE) return false;
+
+    bool serialized = false;
+    {
+        JsonDocument doc(&arena);
+        build(doc);
+        if (!doc.overflowed()) {
+            // serializeJson() truncates to PAYLOAD_SIZE - 1 characters: a full buffer is a message too large
+            message->length = serializeJson(doc, message->payload, PAYLOAD_SIZE);
+            serialized = message->length > 0 && message->length < PAYLOAD_SIZE - 1;
+        }
+    }
+    arenaPeak = max(arenaPeak, arena.used());
+    arena.reset();
+
+    xSemaphoreGive(arenaMutex);
+    return serialized;
+}
+
+#endif // MQTT_MESSAGE_POOL_H
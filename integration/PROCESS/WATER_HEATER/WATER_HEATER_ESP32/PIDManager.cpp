@@ -3,6 +3,7 @@
 #include "Logger.h"
 #include <Arduino.h>
 #include "ActuatorController.h"
+#include "PIDParameterStore.h"
 
 PIDManager::PIDManager()
     : tempPID(&tempInput, &tempOutput, &tempSetpoint, 0, 0, 0, DIRECT)
@@ -309,6 +310,7 @@ void PIDManager::resumeAllPID() {
 void PIDManager::adjustPIDParameters(const String& pidType, double Kp, double Ki, double Kd) {
     if (pidType == "temperature") {
         tempPID.SetTunings(Kp, Ki, Kd);
+        saveParameters();
     /*
     } else if (pidType == "pH") {
         phPID.SetTunings(Kp, Ki, Kd);
@@ -318,14 +320,28 @@ void PIDManager::adjustPIDParameters(const String& pidType, double Kp, double Ki
     }
 }
 
-// A sauvegarder/charger sur le serveur SI BESOIN de plus de data.
-void PIDManager::saveParameters(const char* filename) {
-    // Implement saving PID parameters to EEPROM or SD card
-    Logger::log(Logger::LogLevel::INFO, "Saving PID parameters to " + String(filename));
+bool PIDManager::saveParameters() {
+    PIDParameters parameters = {tempPID.GetKp(), tempPID.GetKi(), tempPID.GetKd(), tempHysteresis, tempSetpoint};
+    if (!PIDParameterStore::save(parameters)) {
+        return false;
+    }
+    Logger::log(Logger::LogLevel::INFO, F("PID parameters saved"));
+    return true;
 }
-void PIDManager::loadParameters(const char* filename) {
-    // Implement loading PID parameters from EEPROM or SD card
-    Logger::log(Logger::LogLevel::INFO, "Loading PID parameters from " + String(filename));
+
+bool PIDManager::loadParameters() {
+    PIDParameters parameters;
+    if (!PIDParameterStore::load(parameters)) {
+        Logger::log(Logger::LogLevel::INFO, F("No saved PID parameters, using the defaults"));
+        return false;
+    }
+    tempPID.SetTunings(parameters.Kp, parameters.Ki, parameters.Kd);
+    tempHysteresis = parameters.hysteresis;
+    tempSetpoint = parameters.setpoint;
+    Logger::log(Logger::LogLevel::INFO, "PID parameters restored - Kp: " + String(parameters.Kp) + ", Ki: " +
+                String(parameters.Ki) + ", Kd: " + String(parameters.Kd) + ", Hysteresis: " +
+                String(tempHysteresis) + ", Setpoint: " + String(tempSetpoint));
+    return true;
 }
 /*
 double PIDManager::convertPIDOutputToFlowRate(double pidOutput) {
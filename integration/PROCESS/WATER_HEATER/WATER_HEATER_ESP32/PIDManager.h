@@ -43,8 +43,9 @@ public:
 
     //void adjustPIDStirringSpeed();
 
-    void saveParameters(const char* filename);
-    void loadParameters(const char* filename);
+    // Gains, hysteresis and setpoint of the temperature loop in NVS (PIDParameterStore)
+    bool saveParameters();
+    bool loadParameters();
 
     void setHysteresis(double tempHyst);
                       //,double phHyst, double doHyst
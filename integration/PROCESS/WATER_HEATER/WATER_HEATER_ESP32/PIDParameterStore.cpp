@@ -0,0 +1,71 @@
+// PIDParameterStore.cpp
+#include "PIDParameterStore.h"
+#include "Logger.h"
+#include <Preferences.h>
+
+static const char* const NVS_NAMESPACE = "pid";
+static const char* const NVS_KEY = "params";
+
+bool PIDParameterStore::save(const PIDParameters& parameters) {
+    Record record;
+    record.version = VERSION;
+    record.size = sizeof(Record);
+    record.parameters = parameters;
+    record.crc = recordCrc(record);
+
+    Preferences preferences;
+    if (!preferences.begin(NVS_NAMESPACE, false)) {
+        Logger::log(Logger::LogLevel::ERROR, F("PID parameters: NVS not available"));
+        return false;
+    }
+    size_t written = preferences.putBytes(NVS_KEY, &record, sizeof(record));
+    preferences.end();
+    if (written != sizeof(record)) {
+        Logger::log(Logger::LogLevel::ERROR, F("PID parameters: NVS write failed"));
+        return false;
+    }
+    return true;
+}
+
+bool PIDParameterStore::load(PIDParameters& parameters) {
+    Preferences preferences;
+    if (!preferences.begin(NVS_NAMESPACE, true)) {
+        return false;   // Namespace not created yet: nothing saved
+    }
+    Record record;
+    size_t length = preferences.getBytesLength(NVS_KEY);
+    size_t read = length == sizeof(record) ? preferences.getBytes(NVS_KEY, &record, sizeof(record)) : 0;
+    preferences.end();
+
+    if (length == 0) {
+        return false;
+    }
+    if (read != sizeof(record) || record.version != VERSION || record.size != sizeof(Record)) {
+        Logger::log(Logger::LogLevel::WARNING, F("PID parameters: saved record of another format ignored"));
+        return false;
+    }
+    if (record.crc != recordCrc(record)) {
+        Logger::log(Logger::LogLevel::WARNING, F("PID parameters: CRC error, saved record ignored"));
+        return false;
+    }
+    parameters = record.parameters;
+    return true;
+}
+
+uint32_t PIDParameterStore::recordCrc(const Record& record) {
+    Record copy = record;
+    copy.crc = 0;
+    return crc32(reinterpret_cast<const uint8_t*>(&copy), sizeof(copy));
+}
+
+// CRC-32 (IEEE 802.3, reflected), bitwise: the record is written a few times a day
+uint32_t PIDParameterStore::crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (length--) {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
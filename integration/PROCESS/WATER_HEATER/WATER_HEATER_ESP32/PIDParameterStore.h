@@ -0,0 +1,44 @@
+/**
+ * PIDParameterStore.h
+ * Temperature loop parameters kept in NVS (Preferences), so that tuning done on the bench survives a reset.
+ *
+ * - One record in the "pid" namespace: format version, the parameters, CRC-32 of both.
+ * - A record of another size or version (firmware update that changed the layout) or with a wrong CRC is ignored:
+ *   load() fails and the caller keeps its defaults.
+ */
+
+#ifndef PID_PARAMETER_STORE_H
+#define PID_PARAMETER_STORE_H
+
+#include <Arduino.h>
+
+struct PIDParameters {
+    double Kp;
+    double Ki;
+    double Kd;
+    double hysteresis;      // °C
+    double setpoint;        // °C
+};
+
+class PIDParameterStore {
+public:
+    static const uint16_t VERSION = 1;
+
+    static bool save(const PIDParameters& parameters);
+    static bool load(PIDParameters& parameters);
+
+    static uint32_t crc32(const uint8_t* data, size_t length);
+
+private:
+    // No padding: every stored byte is covered by the CRC
+    struct Record {
+        uint16_t version;
+        uint16_t size;
+        uint32_t crc;       // Of the record with this field at 0
+        PIDParameters parameters;
+    };
+
+    static uint32_t recordCrc(const Record& record);
+};
+
+#endif // PID_PARAMETER_STORE_H
@@ -4,6 +4,19 @@
  */
 
 #include "PressureSensor.h"
+#include "TaskManager.h"
+#include "config.h"
+
+// Layout of the DMA results
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_RESULT_CHANNEL(result) ((result)->type1.channel)
+#define ADC_RESULT_DATA(result) ((result)->type1.data)
+#else
+#define ADC_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_RESULT_CHANNEL(result) ((result)->type2.channel)
+#define ADC_RESULT_DATA(result) ((result)->type2.data)
+#endif
 
 PressureSensor::PressureSensor(uint8_t pin, const char* name)
     : _pin(pin)
@@ -12,6 +25,10 @@ PressureSensor::PressureSensor(uint8_t pin, const char* name)
 
 void PressureSensor::begin() {
     pinMode(_pin, INPUT);
+    if (startContinuousADC()) {
+        // First block
+        vTaskDelay(pdMS_TO_TICKS(2 * ADC_BLOCK_SIZE * 1000 / ADC_SAMPLE_RATE));
+    }
     _lastReadTime = millis();
     
     // Initialize readings
@@ -27,7 +44,8 @@ void PressureSensor::begin() {
     resetStatistics();
     
     if(DEBUG_MODE) {
-        Serial.println("Pressure sensor initialized:");
+        Serial.println(isContinuous() ? "Pressure sensor initialized (continuous ADC):"
+                                      : "Pressure sensor initialized (analogRead):");
         Serial.print("Initial voltage: "); Serial.print(initialVoltage, 3); Serial.println("V");
         Serial.print("Initial pressure: "); Serial.print(initialPressure, 2); Serial.println(" bar");
     }
@@ -63,6 +81,10 @@ float PressureSensor::getRawVoltage() const {
 }
 
 uint16_t PressureSensor::readADC() const {
+    if (isContinuous()) {
+        return _filteredADC.load(std::memory_order_relaxed);
+    }
+
     uint16_t samples[ADC_SAMPLES];
     
     // Collect samples with delay between readings
@@ -71,24 +93,107 @@ uint16_t PressureSensor::readADC() const {
         delayMicroseconds(200);
     }
     
-    // Sort samples for median calculation
-    for(int i = 0; i < ADC_SAMPLES-1; i++) {
-        for(int j = i+1; j < ADC_SAMPLES; j++) {
-            if(samples[i] > samples[j]) {
-                uint16_t temp = samples[i];
-                samples[i] = samples[j];
-                samples[j] = temp;
+    uint16_t value = ADCFilter::trimmedMean(samples, ADC_SAMPLES, ADC_DISCARD);
+    _filteredADC.store(value, std::memory_order_relaxed);
+    return value;
+}
+
+float PressureSensor::getInstantPressure() const {
+    return voltageToPresure((_filteredADC.load(std::memory_order_relaxed) * VOLTAGE_REFERENCE) / ADC_RESOLUTION);
+}
+
+uint8_t PressureSensor::getInstantErrorFlags() const {
+    // Same thresholds as validateReading(), which also clamps a lost signal to 0 bar in voltageToPresure()
+    float voltage = (_filteredADC.load(std::memory_order_relaxed) * VOLTAGE_REFERENCE) / ADC_RESOLUTION;
+    uint8_t flags = 0;
+    if (voltage < FAULT_LOW_V) flags |= static_cast<uint8_t>(PressureError::DISCONNECTED);
+    if (voltage > FAULT_HIGH_V) flags |= static_cast<uint8_t>(PressureError::OVER_RANGE);
+    return flags;
+}
+
+bool PressureSensor::startContinuousADC() {
+    adc_unit_t unit;
+    if (adc_continuous_io_to_channel(_pin, &unit, &_adcChannel) != ESP_OK || unit != ADC_UNIT_1) {
+        Serial.println("Pressure sensor: pin not on ADC1, continuous sampling disabled");
+        return false;
+    }
+
+    adc_continuous_handle_cfg_t handleConfig = {};
+    handleConfig.max_store_buf_size = 4 * ADC_FRAME_SIZE * SOC_ADC_DIGI_RESULT_BYTES;
+    handleConfig.conv_frame_size = ADC_FRAME_SIZE * SOC_ADC_DIGI_RESULT_BYTES;
+    adc_continuous_handle_t handle = nullptr;
+    if (adc_continuous_new_handle(&handleConfig, &handle) != ESP_OK) {
+        Serial.println("Pressure sensor: continuous ADC not available");
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ADC_ATTEN_DB_12;                   // 0-3.3V, as analogRead()
+    pattern.channel = _adcChannel;
+    pattern.unit = ADC_UNIT_1;
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_continuous_config_t config = {};
+    config.pattern_num = 1;
+    config.adc_pattern = &pattern;
+    config.sample_freq_hz = ADC_SAMPLE_RATE;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_OUTPUT_FORMAT;
+
+    adc_continuous_evt_cbs_t callbacks = {};
+    callbacks.on_conv_done = onConversionDone;
+
+    _adcHandle = handle;
+    _lastBlockTime.store(millis());
+    _adcTaskHandle = TaskManager::createTask(adcTask, "PressureADC", STACK_SIZE_SENSORS, this, TASK_PRIORITY_SENSORS,
+                                              SENSOR_CORE);
+    if (!_adcTaskHandle ||
+        adc_continuous_config(handle, &config) != ESP_OK ||
+        adc_continuous_register_event_callbacks(handle, &callbacks, this) != ESP_OK ||
+        adc_continuous_start(handle) != ESP_OK) {
+        Serial.println("Pressure sensor: continuous ADC start failed");
+        TaskManager::deleteTask(_adcTaskHandle);
+        adc_continuous_deinit(handle);
+        _adcHandle = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool IRAM_ATTR PressureSensor::onConversionDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t* data,
+                                                void* userData) {
+    BaseType_t mustYield = pdFALSE;
+    vTaskNotifyGiveFromISR(static_cast<PressureSensor*>(userData)->_adcTaskHandle, &mustYield);
+    return mustYield == pdTRUE;
+}
+
+void PressureSensor::adcTask(void* parameter) {
+    PressureSensor* sensor = static_cast<PressureSensor*>(parameter);
+    uint8_t frame[ADC_FRAME_SIZE * SOC_ADC_DIGI_RESULT_BYTES];
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        uint32_t length = 0;
+        while (adc_continuous_read(sensor->_adcHandle, frame, sizeof(frame), &length, 0) == ESP_OK) {
+            for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+                adc_digi_output_data_t* result = reinterpret_cast<adc_digi_output_data_t*>(&frame[i]);
+                if (ADC_RESULT_CHANNEL(result) != sensor->_adcChannel) continue;
+
+                // 12-bit as analogRead(), whatever the width of the digital controller
+                uint16_t raw = ADC_RESULT_DATA(result) >> (SOC_ADC_DIGI_MAX_BITWIDTH - 12);
+                if (sensor->_filter.add(raw)) {
+                    sensor->_filteredADC.store(sensor->_filter.value(), std::memory_order_relaxed);
+                    sensor->_lastBlockTime.store(millis(), std::memory_order_relaxed);
+                    if (sensor->_blockCallback) {
+                        uint8_t errors = sensor->getInstantErrorFlags();
+                        bool valid = !(errors & static_cast<uint8_t>(PressureError::DISCONNECTED));
+                        sensor->_blockCallback(sensor->getInstantPressure(), valid);
+                    }
+                }
             }
         }
     }
-    
-    // Calculate median by averaging central values
-    uint32_t sum = 0;
-    for(int i = ADC_DISCARD; i < ADC_SAMPLES - ADC_DISCARD; i++) {
-        sum += samples[i];
-    }
-    
-    return sum / (ADC_SAMPLES - (2 * ADC_DISCARD));
 }
 
 float PressureSensor::voltageToPresure(float voltage) const {
@@ -140,6 +245,12 @@ bool PressureSensor::validateReading(float pressure, float voltage) {
     _errorFlags = 0;
     bool isValid = true;
 
+    // DMA stopped: the voltage is the one of the last block
+    if (isContinuous() && millis() - _lastBlockTime.load(std::memory_order_relaxed) > ADC_STALE_TIMEOUT) {
+        _errorFlags |= static_cast<uint8_t>(PressureError::ADC_ERROR);
+        isValid = false;
+    }
+
     // Check voltage limits
     if (voltage < FAULT_LOW_V) {
         if(DEBUG_MODE) {
@@ -5,7 +5,8 @@
  * 
  * Features:
  * - Handles 4-20mA pressure sensor with 0-5 bar range
- * - Median filtering for ADC readings
+ * - Continuous ADC sampling by DMA, trimmed mean of each block of samples (ADCFilter)
+ *   (burst of analogRead() when the pin cannot be sampled continuously)
  * - EMA (Exponential Moving Average) for smooth output
  * - Comprehensive error detection
  * - Statistical analysis of readings
@@ -16,8 +17,11 @@
 #define PRESSURE_SENSOR_H
 
 #include <Arduino.h>
+#include <atomic>
 #include <CircularBuffer.hpp>
+#include <esp_adc/adc_continuous.h>
 #include "SensorInterface.h"
+#include "ADCFilter.h"
 
 // Pressure sensor error flags
 enum class PressureError {
@@ -53,6 +57,19 @@ public:
     uint8_t getErrorFlags() const { return _errorFlags; }
     bool isHealthy() const { return _errorFlags == 0; }
     float getRawVoltage() const;
+    bool isContinuous() const { return _adcHandle != nullptr; }
+
+    // Pressure of the last block of samples, without EMA nor validation: for overpressure trips.
+    // Updated every ADC_BLOCK_SIZE / ADC_SAMPLE_RATE, no ADC access (any task)
+    float getInstantPressure() const;
+    // Signal faults of the last block (DISCONNECTED, OVER_RANGE): the pressure above means nothing when set
+    uint8_t getInstantErrorFlags() const;
+
+    // Called from the ADC task after each block (continuous sampling only) with getInstantPressure().
+    // valid is false when the sensor signal is lost (DISCONNECTED). Blocks that stop arriving (ADC_ERROR) are
+    // detected by the receiver.
+    typedef void (*BlockCallback)(float pressure, bool valid);
+    void setBlockCallback(BlockCallback callback) { _blockCallback = callback; }
     void setMaxRateOfChange(float maxRatePerSecond) { _maxRateOfChange = maxRatePerSecond; }
     
     // Statistics methods
@@ -89,9 +106,16 @@ private:
     // Signal processing parameters
     static constexpr float EMA_ALPHA = 0.1f;           // EMA smoothing factor
     static constexpr uint8_t FILTER_SIZE = 20;         // Circular buffer size
-    static constexpr int ADC_SAMPLES = 30;             // Number of ADC samples for median
+    static constexpr int ADC_SAMPLES = 30;             // Number of ADC samples for median (analogRead fallback)
     static constexpr int ADC_DISCARD = 5;              // Number of extreme values to discard
 
+    // Continuous ADC (DMA)
+    static constexpr uint32_t ADC_SAMPLE_RATE = 20000;            // Hz, lowest rate of the ESP32 digital controller
+    static constexpr size_t ADC_BLOCK_SIZE = 100;                 // Samples per trimmed mean: 5 ms
+    static constexpr size_t ADC_BLOCK_DISCARD = ADC_BLOCK_SIZE / 6;  // Same proportion as ADC_DISCARD / ADC_SAMPLES
+    static constexpr size_t ADC_FRAME_SIZE = ADC_BLOCK_SIZE;      // Samples per DMA interrupt
+    static constexpr uint32_t ADC_STALE_TIMEOUT = 500;            // ms without block before ADC_ERROR
+
     // Error detection
     float _maxRateOfChange = 0.5f;                     // Maximum bar/second change
     uint32_t _lastReadTime = 0;                        // Last reading timestamp
@@ -103,6 +127,15 @@ private:
     CircularBuffer<float, FILTER_SIZE> _samples;       // Circular buffer for EMA
     float _emaValue = 0.0f;                           // Current EMA value
 
+    // Continuous ADC: the DMA interrupt wakes the ADC task, which filters the samples into _filteredADC
+    adc_continuous_handle_t _adcHandle = nullptr;
+    adc_channel_t _adcChannel;
+    TaskHandle_t _adcTaskHandle = nullptr;
+    ADCFilter _filter{ADC_BLOCK_SIZE, ADC_BLOCK_DISCARD};
+    mutable std::atomic<uint16_t> _filteredADC{0};     // Last trimmed mean (12-bit)
+    std::atomic<uint32_t> _lastBlockTime{0};           // millis() of the last block
+    BlockCallback _blockCallback = nullptr;
+
     // Statistics
     PressureStats _stats = {
         MAX_PRESSURE,    // minPressure
@@ -122,6 +155,10 @@ private:
     bool validateReading(float pressure, float voltage);
     uint16_t readADC() const;
     void updateStatistics(float pressure);
+    bool startContinuousADC();
+    static void adcTask(void* parameter);
+    static bool IRAM_ATTR onConversionDone(adc_continuous_handle_t handle, const adc_continuous_evt_data_t* data,
+                                           void* userData);
 };
 
 #endif // PRESSURE_SENSOR_H
\ No newline at end of file
@@ -0,0 +1,122 @@
+// SafetyInterlock.cpp
+#include "SafetyInterlock.h"
+#include "Logger.h"
+#include "config.h"
+
+uint8_t SafetyInterlock::heaterPin = 0;
+hw_timer_t* SafetyInterlock::timer = nullptr;
+int32_t SafetyInterlock::maxPressureMbar = INT32_MAX;
+int32_t SafetyInterlock::maxTemperatureCenti = INT32_MAX;
+
+std::atomic<int32_t> SafetyInterlock::pressureMbar(0);
+std::atomic<bool> SafetyInterlock::pressureValid(true);
+std::atomic<int32_t> SafetyInterlock::temperatureCenti(0);
+std::atomic<uint32_t> SafetyInterlock::lastPressureTime(0);
+std::atomic<uint32_t> SafetyInterlock::faults(0);
+std::atomic<uint32_t> SafetyInterlock::tripFault(0);
+std::atomic<int32_t> SafetyInterlock::tripValue(0);
+std::atomic<uint32_t> SafetyInterlock::tripTime(0);
+
+bool SafetyInterlock::begin(uint8_t pin, float maxPressure, float maxTemperature) {
+    heaterPin = pin;
+    maxPressureMbar = lroundf(maxPressure * 1000.0f);
+    maxTemperatureCenti = lroundf(maxTemperature * 100.0f);
+
+    timer = timerBegin(1000000);                        // 1 MHz: alarm in µs
+    if (!timer) {
+        Logger::log(Logger::LogLevel::ERROR, F("Safety interlock: no hardware timer, block checks only"));
+        return false;
+    }
+    timerAttachInterrupt(timer, onTimer);
+    timerAlarm(timer, INTERLOCK_TIMER_PERIOD_US, true, 0);
+
+    Logger::log(Logger::LogLevel::INFO, "Safety interlock armed: " + String(maxPressure, 2) + " bar, " +
+                String(maxTemperature, 1) + " C");
+    return true;
+}
+
+void SafetyInterlock::updatePressure(float pressure, bool valid) {
+    pressureMbar.store(lroundf(pressure * 1000.0f));
+    pressureValid.store(valid);
+    lastPressureTime.store(max(millis(), 1UL));
+    check();
+}
+
+void SafetyInterlock::updateTemperature(float temperature) {
+    temperatureCenti.store(lroundf(temperature * 100.0f));
+    check();
+}
+
+float SafetyInterlock::getTripValue() {
+    switch (getTripFault()) {
+        case InterlockFault::OVERPRESSURE:
+        case InterlockFault::PRESSURE_INVALID: return tripValue.load() / 1000.0f;
+        case InterlockFault::OVERTEMPERATURE:  return tripValue.load() / 100.0f;
+        default:                               return tripValue.load();
+    }
+}
+
+bool SafetyInterlock::reset() {
+    if (!isTripped()) {
+        return true;
+    }
+
+    if (!pressureValid.load()) {
+        Logger::log(Logger::LogLevel::WARNING, F("Safety interlock: reset refused, no pressure sensor signal"));
+        return false;
+    }
+    uint32_t lastPressure = lastPressureTime.load();
+    if (pressureMbar.load() > maxPressureMbar || temperatureCenti.load() > maxTemperatureCenti ||
+        (lastPressure != 0 && millis() - lastPressure > INTERLOCK_PRESSURE_TIMEOUT)) {
+        Logger::log(Logger::LogLevel::WARNING, F("Safety interlock: reset refused, limit still exceeded"));
+        return false;
+    }
+
+    faults.store(0);
+    tripFault.store(0);
+    Logger::log(Logger::LogLevel::INFO, F("Safety interlock reset"));
+    return true;
+}
+
+void IRAM_ATTR SafetyInterlock::onTimer() {
+    check();
+}
+
+void IRAM_ATTR SafetyInterlock::check() {
+    // Latched: drive the pin low again, a trip can land between the isTripped() check of HeatingPlate::control()
+    // and its write of the pin
+    if (faults.load()) {
+        digitalWrite(heaterPin, LOW);
+    }
+
+    int32_t pressure = pressureMbar.load();
+    if (pressure > maxPressureMbar) {
+        trip(InterlockFault::OVERPRESSURE, pressure);
+    }
+    if (!pressureValid.load()) {
+        trip(InterlockFault::PRESSURE_INVALID, pressure);
+    }
+
+    int32_t temperature = temperatureCenti.load();
+    if (temperature > maxTemperatureCenti) {
+        trip(InterlockFault::OVERTEMPERATURE, temperature);
+    }
+
+    uint32_t lastPressure = lastPressureTime.load();
+    uint32_t sinceLastPressure = millis() - lastPressure;
+    if (lastPressure != 0 && static_cast<int32_t>(sinceLastPressure) > INTERLOCK_PRESSURE_TIMEOUT) {
+        trip(InterlockFault::PRESSURE_TIMEOUT, sinceLastPressure);
+    }
+}
+
+void IRAM_ATTR SafetyInterlock::trip(InterlockFault fault, int32_t value) {
+    // Also when already tripped: the heater task may have driven the pin since
+    digitalWrite(heaterPin, LOW);
+
+    uint32_t previous = faults.fetch_or(static_cast<uint32_t>(fault));
+    if (previous == 0) {
+        tripFault.store(static_cast<uint32_t>(fault));
+        tripValue.store(value);
+        tripTime.store(micros());
+    }
+}
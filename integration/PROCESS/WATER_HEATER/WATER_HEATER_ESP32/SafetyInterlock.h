@@ -0,0 +1,69 @@
+/**
+ * SafetyInterlock.h
+ * Fast-path cut of the heating plate on overpressure and overtemperature, independent of the safety task.
+ *
+ * - The pressure is checked for every ADC block (PressureSensor block callback, every 5 ms), the temperature for
+ *   every sampling cycle (SensorController).
+ * - A block without sensor signal (wire cut: the pressure would read 0 bar) trips at once, the heater cannot be run
+ *   without overpressure protection.
+ * - A hardware timer interrupt checks the last values again every INTERLOCK_TIMER_PERIOD_US, and trips when no
+ *   pressure block arrived for INTERLOCK_PRESSURE_TIMEOUT (ADC task starved or DMA stopped).
+ * A trip drives the heater pin low at once and latches the fault: HeatingPlate stays off until reset(), SafetySystem
+ * reports the fault and stops the programs. While latched, every check drives the pin low again.
+ * Values are kept in fixed point (mbar, 1/100 °C): no floating point in the interrupt.
+ */
+
+#ifndef SAFETY_INTERLOCK_H
+#define SAFETY_INTERLOCK_H
+
+#include <Arduino.h>
+#include <atomic>
+
+enum class InterlockFault {
+    NONE = 0x00,
+    OVERPRESSURE = 0x01,
+    OVERTEMPERATURE = 0x02,
+    PRESSURE_TIMEOUT = 0x04,    // No pressure block for INTERLOCK_PRESSURE_TIMEOUT
+    PRESSURE_INVALID = 0x08     // Pressure block without sensor signal
+};
+
+class SafetyInterlock {
+public:
+    // Thresholds in bar and °C, heaterPin is driven low on a trip
+    static bool begin(uint8_t heaterPin, float maxPressure, float maxTemperature);
+
+    // Latest values, checked at once. valid: the sensor signal is present (PressureSensor::BlockCallback)
+    static void updatePressure(float pressure, bool valid);
+    static void updateTemperature(float temperature);
+
+    static uint8_t getFaults() { return faults.load(); }       // InterlockFault flags, latched
+    static bool isTripped() { return getFaults() != 0; }
+    static bool hasPressure() { return lastPressureTime.load() != 0; }
+    static InterlockFault getTripFault() { return static_cast<InterlockFault>(tripFault.load()); }  // First fault
+    static float getTripValue();       // Of the first fault: pressure (bar), temperature (°C) or ms without block
+    static unsigned long getTripTime() { return tripTime.load(); }   // micros() of the first trip
+
+    // Clear the latch, refused while a value is still over its threshold or the pressure signal is lost
+    static bool reset();
+
+private:
+    static uint8_t heaterPin;
+    static hw_timer_t* timer;
+    static int32_t maxPressureMbar;
+    static int32_t maxTemperatureCenti;
+
+    static std::atomic<int32_t> pressureMbar;
+    static std::atomic<bool> pressureValid;
+    static std::atomic<int32_t> temperatureCenti;
+    static std::atomic<uint32_t> lastPressureTime;     // millis(), 0 before the first block
+    static std::atomic<uint32_t> faults;
+    static std::atomic<uint32_t> tripFault;
+    static std::atomic<int32_t> tripValue;
+    static std::atomic<uint32_t> tripTime;
+
+    static void IRAM_ATTR onTimer();
+    static void IRAM_ATTR check();
+    static void IRAM_ATTR trip(InterlockFault fault, int32_t value);
+};
+
+#endif // SAFETY_INTERLOCK_H
@@ -1,5 +1,6 @@
 // SafetySystem.cpp
 #include "SafetySystem.h"
+#include "SafetyInterlock.h"
 
 SafetySystem::SafetySystem(StateMachine& stateMachine)
     : lastCheckTime(0)
@@ -38,20 +39,53 @@ void SafetySystem::checkLimits() {
     }
     lastCheckTime = currentTime;
     
+    checkInterlock();
     checkPressure();
     checkWaterTemperature();
 }
 
-void SafetySystem::checkPressure() {
-    PressureSensor* sensor = (PressureSensor*)SensorController::findSensorByName("pressureSensor");
-    if (!sensor) {
-        Logger::log(Logger::LogLevel::ERROR, "Pressure sensor not found in system");
+void SafetySystem::checkInterlock() {
+    if (!interlockPressureWarned && !SafetyInterlock::hasPressure()) {
+        Logger::log(Logger::LogLevel::WARNING, F("Interlock: no continuous pressure sampling, overpressure not cut"));
+        interlockPressureWarned = true;
+    }
+
+    uint8_t faults = SafetyInterlock::getFaults();
+    if (faults == reportedInterlockFaults) {
         return;
     }
+    uint8_t newFaults = faults & ~reportedInterlockFaults;
+    reportedInterlockFaults = faults;
 
-    if (!sensor->isHealthy()) {
-        uint8_t errorFlags = sensor->getErrorFlags();
-        
+    if (faults == 0) {
+        Logger::log(Logger::LogLevel::INFO, F("Safety interlock cleared, heating allowed"));
+        return;
+    }
+
+    // The interlock has already cut the heater: stop the programs and report
+    if (newFaults & static_cast<uint8_t>(InterlockFault::OVERPRESSURE)) {
+        Logger::log(Logger::LogLevel::ERROR, F("Interlock: overpressure, heating plate cut"));
+    }
+    if (newFaults & static_cast<uint8_t>(InterlockFault::OVERTEMPERATURE)) {
+        Logger::log(Logger::LogLevel::ERROR, F("Interlock: overtemperature, heating plate cut"));
+    }
+    if (newFaults & static_cast<uint8_t>(InterlockFault::PRESSURE_TIMEOUT)) {
+        Logger::log(Logger::LogLevel::ERROR, F("Interlock: no pressure reading, heating plate cut"));
+    }
+    if (newFaults & static_cast<uint8_t>(InterlockFault::PRESSURE_INVALID)) {
+        Logger::log(Logger::LogLevel::ERROR, F("Interlock: pressure sensor signal lost, heating plate cut"));
+    }
+    if (newFaults == faults) {
+        Logger::log(Logger::LogLevel::ERROR, "Interlock tripped at " + String(SafetyInterlock::getTripValue(), 2) +
+                    " (" + String((micros() - SafetyInterlock::getTripTime()) / 1000) + " ms ago)");
+    }
+    _stateMachine.stopAllPrograms();
+}
+
+void SafetySystem::checkPressure() {
+    uint8_t errorFlags = SensorController::getSnapshot().pressureErrorFlags;
+
+    if (errorFlags != 0) {
         if (errorFlags & static_cast<uint8_t>(PressureError::DISCONNECTED)) {
             Logger::log(Logger::LogLevel::ERROR, F("Pressure sensor disconnected or wire broken"));
         }
@@ -48,7 +48,10 @@ private:
     bool alarmEnabled;              // Whether alarms are enabled
     bool warningEnabled;            // Whether warnings are enabled
     StateMachine& _stateMachine;
+    uint8_t reportedInterlockFaults = 0;  // SafetyInterlock faults already reported
+    bool interlockPressureWarned = false;
 
+    void checkInterlock();          // Report the faults latched by SafetyInterlock
     void checkPressure();           // Check pressure sensor status
     void checkWaterTemperature();   // Check water temperature status
     void logSafetyEvent(const String& message, Logger::LogLevel level) {
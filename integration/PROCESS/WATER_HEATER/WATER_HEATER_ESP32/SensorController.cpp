@@ -1,9 +1,14 @@
 // SensorController.cpp
 #include "SensorController.h"
 #include "Logger.h"
+#include "TaskManager.h"
+#include "SafetyInterlock.h"
+#include "config.h"
 
 DS18B20TemperatureSensor* SensorController::waterTempSensor = nullptr;
 PressureSensor* SensorController::pressureSensor = nullptr;
+SnapshotBuffer<SensorSnapshot> SensorController::snapshot;
+TaskHandle_t SensorController::samplingTaskHandle = nullptr;
 
 bool SensorController::initialize(DS18B20TemperatureSensor& waterTemp, PressureSensor& pressure) {
     waterTempSensor = &waterTemp;
@@ -66,17 +71,63 @@ bool SensorController::beginAll() {
 
 float SensorController::readSensor(const String& sensorName) {
     SensorInterface* sensor = findSensorByName(sensorName);
-    if (sensor) {
-        float value = sensor->readValue();
-        return value;
+    if (!sensor) {
+        Logger::log(Logger::LogLevel::WARNING, String("Sensor not found: ") + String(sensorName));
+        return 0.0f;
     }
-    Logger::log(Logger::LogLevel::WARNING, String("Sensor not found: ") + String(sensorName));
-    return 0.0f;
+
+    // Before the sampling task starts (setup), the sensor is read directly
+    if (!samplingTaskHandle) {
+        return sensor->readValue();
+    }
+    SensorSnapshot last = snapshot.read();
+    return (sensor == waterTempSensor) ? last.waterTemp : last.pressure;
 }
 
 void SensorController::updateAllSensors() {
-    readSensor(waterTempSensor->getName());
-    readSensor(pressureSensor->getName());
+    SensorSnapshot next;
+    next.waterTemp = waterTempSensor->readValue();
+    next.pressure = pressureSensor->readValue();
+    next.pressureErrorFlags = pressureSensor->getErrorFlags();
+    next.pressureStats = pressureSensor->getStatistics();
+    next.timestamp = millis();
+    snapshot.publish(next);
+    SafetyInterlock::updateTemperature(next.waterTemp);
+}
+
+bool SensorController::startSampling() {
+    if (!waterTempSensor || !pressureSensor) {
+        Logger::log(Logger::LogLevel::ERROR, F("Sensors not initialized"));
+        return false;
+    }
+    if (samplingTaskHandle) {
+        return true;
+    }
+
+    // First snapshot before the readers switch to it
+    updateAllSensors();
+    samplingTaskHandle = TaskManager::createTask(
+        samplingTask,
+        "SensorSampling",
+        STACK_SIZE_SENSORS,
+        nullptr,
+        TASK_PRIORITY_SENSORS,
+        SENSOR_CORE
+    );
+    return samplingTaskHandle != nullptr;
+}
+
+void SensorController::samplingTask(void* parameter) {
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+
+    while (true) {
+        updateAllSensors();
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(TASK_INTERVAL_SENSORS));
+    }
+}
+
+SensorSnapshot SensorController::getSnapshot() {
+    return snapshot.read();
 }
 
 SensorInterface* SensorController::findSensorByName(const String& name) {
@@ -3,10 +3,28 @@
 #define SENSOR_CONTROLLER_H
 
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "PT100Sensor.h"
 #include "PressureSensor.h"
 #include "DS18B20TemperatureSensor.h"
+#include "SnapshotBuffer.h"
 
+// Last readings of all sensors, published by the sampling task
+struct SensorSnapshot {
+    float waterTemp;
+    float pressure;
+    uint8_t pressureErrorFlags;     // PressureError flags of the last pressure reading
+    PressureStats pressureStats;
+    unsigned long timestamp;        // millis() at the end of the sampling cycle, 0 before the first one
+};
+
+/*
+ * Only the sampling task (startSampling()) talks to the sensors: the OneWire conversion takes about 1 s and the
+ * pressure sensor keeps filter state, neither can be shared between tasks.
+ * Every other task reads the last snapshot, without waiting (SnapshotBuffer): a copy starts again at most once per
+ * TASK_INTERVAL_SENSORS.
+ */
 class SensorController {
 public:
     static bool initialize(DS18B20TemperatureSensor& waterTemp, PressureSensor& pressure);
@@ -15,10 +33,19 @@ public:
     static bool beginAll();
     static SensorInterface* findSensorByName(const String& name);
 
+    // Start the sampling task, readSensor() returns the snapshot values from then on
+    static bool startSampling();
+    static SensorSnapshot getSnapshot();
+    static uint32_t getSnapshotSequence() { return snapshot.sequence(); }
+
 private:
     static DS18B20TemperatureSensor* waterTempSensor;
     static PressureSensor* pressureSensor;
 
+    static SnapshotBuffer<SensorSnapshot> snapshot;
+    static TaskHandle_t samplingTaskHandle;
+
+    static void samplingTask(void* parameter);
 };
 
-#endif
\ No newline at end of file
+#endif
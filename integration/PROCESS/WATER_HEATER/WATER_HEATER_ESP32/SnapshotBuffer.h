@@ -0,0 +1,55 @@
+/**
+ * SnapshotBuffer.h
+ * Last value of a single writer task, read by any task without waiting.
+ *
+ * The writer fills the free slot of a double buffer then publishes it by incrementing the sequence; a reader copies
+ * the published slot and starts again if a new value was published meanwhile (the slot may have been rewritten).
+ * Plain C++, no Arduino dependency: the coherency of the copies can be checked on a host.
+ */
+
+#ifndef SNAPSHOT_BUFFER_H
+#define SNAPSHOT_BUFFER_H
+
+#include <atomic>
+#include <stdint.h>
+
+template <typename T>
+class SnapshotBuffer {
+public:
+    SnapshotBuffer() : _slots(), _sequence(0) {}
+
+    // Writer task only
+    void publish(const T& value) {
+        // Only the writer touches the free slot
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _slots[(sequence + 1) & 1] = value;
+        // acq_rel: the slot is written before it is published, and the next write waits for the publication
+        _sequence.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    /*
+     * Copy of the last published value (T() before the first one).
+     * @param retries: incremented for every copy started again, may be nullptr.
+     */
+    T read(uint32_t* retries = nullptr) const {
+        T value;
+        uint32_t sequence = _sequence.load(std::memory_order_acquire);
+        while (true) {
+            value = _slots[sequence & 1];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint32_t current = _sequence.load(std::memory_order_relaxed);
+            if (current == sequence) return value;
+            sequence = current;
+            if (retries) (*retries)++;
+        }
+    }
+
+    // Number of values published, changes when a new value is available
+    uint32_t sequence() const { return _sequence.load(std::memory_order_acquire); }
+
+private:
+    T _slots[2];                        // _slots[sequence & 1] is the published one
+    std::atomic<uint32_t> _sequence;
+};
+
+#endif // SNAPSHOT_BUFFER_H
@@ -0,0 +1,92 @@
+// TelemetryBatch.cpp
+// The same file is used by the XS bridge (HETEROTROPHIC/XS/ESP32/TelemetryBatch.cpp): keep both copies in sync.
+#include "TelemetryBatch.h"
+
+static const size_t HEADER_SIZE = 11;
+
+TelemetryBatch::TelemetryBatch(uint8_t schema, uint8_t channelCount, uint8_t samplesPerBatch, uint8_t keyframeInterval)
+    : schema(schema), channelCount(min(channelCount, MAX_CHANNELS)), samplesPerBatch(samplesPerBatch),
+      keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1),
+      used(0), sampleCount(0), sequence(0), batchesSinceKeyframe(0), keyframeRequested(true), keyframe(false),
+      previousTimeMs(0) {
+    memset(previous, 0, sizeof(previous));
+}
+
+bool TelemetryBatch::addSample(uint32_t time, uint32_t timeMs, const int32_t* values) {
+    if (isFull()) return true;
+    if (sampleCount == 0) {
+        startBatch(time);
+    }
+
+    writeVarint(sampleCount == 0 ? 0 : timeMs - previousTimeMs);
+    for (uint8_t i = 0; i < channelCount; i++) {
+        // 64-bit difference: MISSING minus a positive value does not fit 32 bits
+        int64_t value = (keyframe && sampleCount == 0) ? values[i] : static_cast<int64_t>(values[i]) - previous[i];
+        writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        previous[i] = values[i];
+    }
+    previousTimeMs = timeMs;
+    sampleCount++;
+    buffer[4] = sampleCount;
+    return isFull();
+}
+
+void TelemetryBatch::setLabel(const String& newLabel) {
+    String truncated = newLabel.substring(0, MAX_LABEL_SIZE);
+    if (truncated != label) {
+        label = truncated;
+        keyframeRequested = true;
+    }
+}
+
+void TelemetryBatch::next() {
+    if (sampleCount > 0) {
+        sequence++;
+        batchesSinceKeyframe = keyframe ? 1 : batchesSinceKeyframe + 1;
+    }
+    used = 0;
+    sampleCount = 0;
+}
+
+bool TelemetryBatch::isFull() const {
+    return sampleCount >= samplesPerBatch || (sampleCount > 0 && used + maxSampleSize() > BUFFER_SIZE);
+}
+
+int32_t TelemetryBatch::toFixed(float value, float scale) {
+    if (isnan(value)) return MISSING;
+    float scaled = roundf(value * scale);
+    if (scaled >= 2147483520.0f) return INT32_MAX;
+    if (scaled <= -2147483520.0f) return INT32_MIN + 1;
+    return static_cast<int32_t>(scaled);
+}
+
+void TelemetryBatch::startBatch(uint32_t time) {
+    keyframe = keyframeRequested || batchesSinceKeyframe >= keyframeInterval;
+    keyframeRequested = false;
+
+    buffer[0] = VERSION;
+    buffer[1] = schema;
+    buffer[2] = keyframe ? FLAG_KEYFRAME : 0;
+    buffer[3] = channelCount;
+    buffer[4] = 0;
+    buffer[5] = sequence & 0xFF;
+    buffer[6] = sequence >> 8;
+    buffer[7] = time & 0xFF;
+    buffer[8] = (time >> 8) & 0xFF;
+    buffer[9] = (time >> 16) & 0xFF;
+    buffer[10] = time >> 24;
+    used = HEADER_SIZE;
+    if (keyframe) {
+        buffer[used++] = label.length();
+        memcpy(buffer + used, label.c_str(), label.length());
+        used += label.length();
+    }
+}
+
+void TelemetryBatch::writeVarint(uint64_t value) {
+    while (value >= 0x80) {
+        buffer[used++] = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    buffer[used++] = static_cast<uint8_t>(value);
+}
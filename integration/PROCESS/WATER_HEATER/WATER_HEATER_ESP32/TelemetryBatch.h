@@ -0,0 +1,82 @@
+// TelemetryBatch.h
+// Batched MQTT telemetry, several samples per publish.
+// The same file is used by the XS bridge (HETEROTROPHIC/XS/ESP32/TelemetryBatch.h) and decoded
+// on the server by telemetry_batch.py: keep the copies in sync.
+#ifndef TELEMETRY_BATCH_H
+#define TELEMETRY_BATCH_H
+
+#include <Arduino.h>
+
+/*
+ * Payload layout (multi-byte values are little-endian):
+ *   [VERSION][schema][flags][channel count][sample count][sequence, 2 bytes][time, 4 bytes]
+ *   keyframe only: [label length][label ... label length bytes]
+ *   then for each sample: [ms since the previous sample, varint] and one zigzag varint per channel
+ * time is the UTC epoch of the first sample (0 when the clock is not set). The schema tells the decoder the name
+ * and scale of each channel: values are fixed-point integers (see toFixed()).
+ * In a keyframe the first sample holds absolute values; every other value is the difference to the previous
+ * sample, the first sample of a batch referring to the last sample of the previous batch (sequence - 1).
+ * A subscriber that missed a batch waits for the next keyframe, sent every keyframeInterval batches.
+ */
+class TelemetryBatch {
+public:
+    static const uint8_t VERSION = 1;
+    static const uint8_t FLAG_KEYFRAME = 0x01;
+    static const uint8_t MAX_CHANNELS = 32;
+    static const uint8_t MAX_LABEL_SIZE = 32;
+    static const size_t BUFFER_SIZE = 2048;
+    static const int32_t MISSING = INT32_MIN;     // Value not available (NaN)
+
+    TelemetryBatch(uint8_t schema, uint8_t channelCount, uint8_t samplesPerBatch, uint8_t keyframeInterval);
+
+    /*
+     * Add a sample of channelCount values to the batch being built.
+     * @param time: UTC epoch, only used for the first sample of a batch.
+     * @param timeMs: millis() when the sample was taken.
+     * @return: true when the batch is full, publish data() then call next().
+     */
+    bool addSample(uint32_t time, uint32_t timeMs, const int32_t* values);
+
+    // Label of the next keyframes (program name). A new label starts the next batch with a keyframe
+    void setLabel(const String& label);
+    const String& getLabel() const { return label; }
+
+    // The next batch starts with a keyframe, to be called when a batch could not be published
+    void requestKeyframe() { keyframeRequested = true; }
+
+    // Forget the batch being built and start the next one
+    void next();
+
+    bool isEmpty() const { return sampleCount == 0; }
+    bool isFull() const;
+    const uint8_t* data() const { return buffer; }
+    size_t length() const { return used; }
+    uint16_t getSequence() const { return sequence; }
+
+    // Fixed-point value of a measure: value * scale, rounded; NaN gives MISSING
+    static int32_t toFixed(float value, float scale);
+
+private:
+    uint8_t schema;
+    uint8_t channelCount;
+    uint8_t samplesPerBatch;
+    uint8_t keyframeInterval;
+
+    uint8_t buffer[BUFFER_SIZE];
+    size_t used;
+    uint8_t sampleCount;
+    uint16_t sequence;
+    uint8_t batchesSinceKeyframe;
+    bool keyframeRequested;
+    bool keyframe;                                // Batch being built
+    String label;
+
+    int32_t previous[MAX_CHANNELS];
+    uint32_t previousTimeMs;
+
+    void startBatch(uint32_t time);
+    void writeVarint(uint64_t value);
+    size_t maxSampleSize() const { return 5 + 10 * channelCount; }
+};
+
+#endif // TELEMETRY_BATCH_H
@@ -14,6 +14,7 @@
  *   • Surveillance des limites critiques
  *   • Arrêt d'urgence automatique
  *   • Gestion des alarmes
+ *   • SafetyInterlock : coupure de la plaque chauffante en < 10 ms (surpression, surchauffe)
  * 
  * - MQTTClient : Communication MQTT
  *   • Publication des données des capteurs
@@ -99,7 +100,7 @@
  * 
  * 2. Required Libraries:
  *    - WiFi.h : Connectivity
- *    - WebServer.h : Web interface
+ *    - ESPAsyncWebServer (+ AsyncTCP) : Web interface, /events stream
  *    - ArduinoJson : JSON parsing
  *    - AsyncMqttClient : MQTT communication
  *    - ElegantOTA : OTA updates
@@ -133,7 +134,6 @@
  */
 
 #include <Arduino.h>
-#include <WebServer.h>
 #include <ezTime.h>
 #include "config.h"
 #include "Logger.h"
@@ -150,6 +150,7 @@
 #include "PressureSensor.h"
 #include "HeatingPlate.h"
 #include "SafetySystem.h"
+#include "SafetyInterlock.h"
 #include "WebAPIHandler.h"
 #include "PressureSterilizationProgram.h"
 #include "CIPProgram.h"
@@ -163,7 +164,6 @@ MQTTClient mqttClient;
 StateMachine stateMachine(pidManager, mqttClient);
 WebAPIHandler webAPI(stateMachine);
 WebServerManager webServer(webAPI, stateMachine);
-WebServer otaServer(OTA_SERVER_PORT);  
 CommandHandler commandHandler(stateMachine, mqttClient);
 
 // Sensor declarations
@@ -187,6 +187,10 @@ void setup() {
     Serial.begin(115200);
     delay(1000);
 
+    // Heater cut on overpressure / overtemperature, armed before the sensors feed it
+    SafetyInterlock::begin(HEATING_PLATE_PIN, CRITICAL_PRESSURE, CRITICAL_WATER_TEMP);
+    pressureSensor.setBlockCallback(SafetyInterlock::updatePressure);
+
     //   Initialize sensors and actuators with verification
     bool sensorsOk = SensorController::initialize(waterTempSensor, pressureSensor);
     bool sensorsStarted = SensorController::beginAll();
@@ -217,6 +221,8 @@ void setup() {
     // Initialize PID
     pidManager.initialize(2.0, 5.0, 1.0);
     pidManager.setHysteresis(0.5);
+    // Gains, hysteresis and setpoint saved in NVS replace the defaults above
+    pidManager.loadParameters();
     Logger::log(Logger::LogLevel::INFO, F("PID setup"));
 
     // Initialiser le WiFi
@@ -243,8 +249,9 @@ void setup() {
     myTZ.setLocation(F("Europe/Paris"));
     Logger::log(Logger::LogLevel::INFO, "Time synchronized: " + myTZ.dateTime());
 
-    // Initialize Task
-    if (!safetySystem.begin() ||
+    // Initialize Task (sensor sampling first: the other tasks read its snapshot)
+    if (!SensorController::startSampling() ||
+        !safetySystem.begin() ||
         !stateMachine.begin() ||
         !mqttClient.begin() ||
         !commandHandler.begin()) {
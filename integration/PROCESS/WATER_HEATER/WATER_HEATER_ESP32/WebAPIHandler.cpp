@@ -28,7 +28,6 @@ void WebAPIHandler::handlePOSTRequest(AsyncWebServerRequest *request) {
 }
 
 void WebAPIHandler::handleDataRequest(AsyncWebServerRequest *request) {
-    SensorData data = DataManager::collectSensorData();
     String jsonData = DataManager::collectAllData(_stateMachine);
     sendJsonResponse(request, jsonData);
 }
@@ -0,0 +1,97 @@
+// WebAssets.h
+// Generated by web/build_assets.py from web/style.css, web/app.js: do not edit
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+struct WebAsset {
+    const char* path;
+    const char* contentType;
+    const uint8_t* data;        // gzip
+    size_t length;
+    const char* etag;
+};
+
+// style.css: 1005 bytes, 439 compressed
+static const uint8_t STYLE_CSS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x92, 0xdd, 0x6e, 0x83, 0x20,
+    0x14, 0xc7, 0xef, 0x7d, 0x0a, 0x92, 0x66, 0xc9, 0xd6, 0x54, 0xab, 0x56, 0x93, 0x06, 0xaf, 0x9a,
+    0x25, 0xbb, 0xde, 0x2b, 0x60, 0x41, 0x21, 0xa3, 0x60, 0x10, 0xfb, 0x91, 0xa6, 0xef, 0x3e, 0x40,
+    0xd8, 0xb4, 0x6b, 0xe7, 0xb9, 0x91, 0x03, 0xe7, 0x7f, 0x7e, 0xe7, 0xa3, 0x96, 0xf8, 0x02, 0xae,
+    0x11, 0x30, 0x5f, 0x23, 0x85, 0x8e, 0x1b, 0x74, 0x60, 0xfc, 0x02, 0xc1, 0x4e, 0x31, 0xc4, 0x2b,
+    0xe7, 0x3f, 0x20, 0xd5, 0x32, 0x01, 0x41, 0x3a, 0x1e, 0x3b, 0x84, 0x31, 0x13, 0x2d, 0x04, 0x79,
+    0xda, 0x9d, 0x47, 0x57, 0x8d, 0xf6, 0x5f, 0xad, 0x92, 0x83, 0xc0, 0x10, 0x2c, 0xb2, 0xdc, 0xda,
+    0x78, 0xb1, 0x97, 0x5c, 0x2a, 0xe3, 0x23, 0xa9, 0xb5, 0x2a, 0xba, 0x45, 0x51, 0xb2, 0x47, 0x0a,
+    0xfb, 0x8c, 0xf3, 0x38, 0x62, 0xcd, 0x0b, 0x4a, 0x85, 0x89, 0x8a, 0x15, 0xc2, 0x6c, 0xe8, 0x21,
+    0xd8, 0x86, 0x44, 0x0f, 0x72, 0x07, 0xba, 0xac, 0xec, 0xce, 0x01, 0xb1, 0x96, 0xe7, 0xb8, 0xa7,
+    0x08, 0xcb, 0x93, 0xa1, 0x06, 0xb9, 0xb9, 0xb0, 0x97, 0xaa, 0xad, 0xd1, 0x6b, 0xba, 0x72, 0x96,
+    0x94, 0x6f, 0x8e, 0x86, 0x66, 0x2b, 0x40, 0x73, 0x8f, 0x13, 0x68, 0x1b, 0xf7, 0x4d, 0xe5, 0xe3,
+    0x5a, 0x6a, 0x2d, 0x0f, 0x21, 0xaf, 0x09, 0xd4, 0xa8, 0xe6, 0xc4, 0xc7, 0x9d, 0x18, 0xd6, 0xd4,
+    0x10, 0xa4, 0xe9, 0xcb, 0x0c, 0xdf, 0xe8, 0x71, 0xd4, 0xf5, 0x04, 0x82, 0xf0, 0x77, 0x87, 0x9c,
+    0x8e, 0xc8, 0x56, 0x8e, 0xae, 0x80, 0x0e, 0x6d, 0xf9, 0xa9, 0x32, 0xcb, 0x43, 0x95, 0x9a, 0x9c,
+    0x75, 0x8c, 0x38, 0x6b, 0x4d, 0x18, 0x27, 0x8d, 0x9e, 0xe5, 0x09, 0x70, 0x99, 0x91, 0xeb, 0x25,
+    0x67, 0x18, 0x2c, 0x36, 0x9b, 0x8d, 0xd7, 0xfd, 0xd3, 0xea, 0x38, 0x94, 0x99, 0x63, 0x6b, 0xd5,
+    0xd3, 0xd2, 0xdd, 0x3e, 0x9c, 0x08, 0x6b, 0xa9, 0x86, 0x26, 0x15, 0xc7, 0xe3, 0xfc, 0x8e, 0x88,
+    0x0f, 0x64, 0xba, 0x32, 0xf3, 0x27, 0x53, 0xb5, 0xe2, 0x7d, 0xf7, 0x51, 0xfa, 0x02, 0x15, 0xa4,
+    0xf2, 0x48, 0xd4, 0x3f, 0x38, 0xa5, 0x35, 0xf7, 0xb8, 0xf3, 0xaf, 0x42, 0xa3, 0xb6, 0xbf, 0xa3,
+    0xe5, 0x4c, 0x90, 0x98, 0xfa, 0x8c, 0x59, 0x32, 0xbe, 0x5f, 0x2f, 0xc1, 0xa7, 0x92, 0xad, 0x42,
+    0x07, 0xd3, 0xbb, 0x96, 0x80, 0xe5, 0x3a, 0x4a, 0xea, 0xc1, 0x34, 0x45, 0x80, 0xeb, 0xa4, 0x9b,
+    0xb6, 0xdd, 0x6e, 0x80, 0xb3, 0x09, 0x54, 0xf7, 0xdb, 0x56, 0x5a, 0xdf, 0x7e, 0x50, 0xbd, 0xc5,
+    0xea, 0x24, 0x13, 0x9a, 0xa8, 0x6a, 0xbe, 0xab, 0xbe, 0x75, 0xa1, 0xd0, 0x13, 0x65, 0x9a, 0x04,
+    0x1d, 0x08, 0x84, 0x14, 0xe6, 0x74, 0x8b, 0x92, 0x5e, 0x4b, 0x53, 0xca, 0x3c, 0x14, 0x6f, 0xf2,
+    0x26, 0x6f, 0xdc, 0x35, 0x13, 0xdd, 0xa0, 0xa7, 0x84, 0xdb, 0x29, 0x5b, 0xf9, 0x00, 0xad, 0x70,
+    0xbe, 0xa9, 0x9c, 0x1d, 0xf4, 0x13, 0x8c, 0xc9, 0x3a, 0x14, 0x45, 0x61, 0x33, 0x7e, 0x03, 0x69,
+    0x3a, 0x3b, 0x9e, 0xed, 0x03, 0x00, 0x00,
+};
+
+// app.js: 1466 bytes, 611 compressed
+static const uint8_t APP_JS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x53, 0xcb, 0x6e, 0xdb, 0x30,
+    0x10, 0xbc, 0xfb, 0x2b, 0x16, 0x42, 0x11, 0x49, 0x88, 0x21, 0xb9, 0x05, 0x7a, 0x89, 0x1f, 0x41,
+    0x9b, 0x07, 0x92, 0x22, 0x4d, 0x0c, 0x24, 0x40, 0xaf, 0xa1, 0xc5, 0xb5, 0xa5, 0x42, 0x26, 0x09,
+    0x92, 0xb2, 0x52, 0x04, 0xfe, 0xf7, 0x2e, 0x29, 0x4b, 0x7e, 0x14, 0x76, 0x6e, 0xd5, 0x41, 0xa4,
+    0xc4, 0xd9, 0xe1, 0xee, 0xce, 0x6c, 0x9a, 0xc2, 0x43, 0xb1, 0x42, 0x58, 0xb1, 0xb2, 0x42, 0x03,
+    0x72, 0x0e, 0x36, 0x47, 0xe0, 0xcc, 0xe4, 0x33, 0xc9, 0x34, 0x87, 0x28, 0xc5, 0x15, 0x0a, 0x6b,
+    0xfa, 0x90, 0x32, 0x55, 0xa4, 0xa5, 0xc3, 0xd6, 0x85, 0xcd, 0x65, 0x65, 0xe1, 0xc6, 0x9d, 0x3c,
+    0xcb, 0x4a, 0x67, 0x18, 0x03, 0x13, 0x1c, 0x94, 0x96, 0x0b, 0xcd, 0x96, 0xa0, 0xd8, 0x02, 0x81,
+    0x65, 0xb6, 0x90, 0xc2, 0xf4, 0x7a, 0xf3, 0x4a, 0xf8, 0x2d, 0x98, 0x5c, 0xd6, 0xd7, 0xcc, 0xb2,
+    0x88, 0xd3, 0x2b, 0x86, 0xf7, 0x1e, 0xd0, 0xc3, 0x65, 0x56, 0x2d, 0x89, 0x27, 0x59, 0xa0, 0xbd,
+    0x29, 0xd1, 0x6d, 0xbf, 0xff, 0xb9, 0xe7, 0x51, 0xe8, 0x40, 0x61, 0x9c, 0x14, 0x42, 0xa0, 0xbe,
+    0x7b, 0xf9, 0xf9, 0x00, 0x63, 0x78, 0xf5, 0x11, 0xee, 0x19, 0xa9, 0xc9, 0x2f, 0x66, 0x51, 0xc3,
+    0x0b, 0x2e, 0xd5, 0x05, 0x8c, 0x8c, 0x62, 0x02, 0xb2, 0x92, 0x19, 0x33, 0x0e, 0x7c, 0x29, 0xc1,
+    0xe4, 0xd3, 0xbb, 0x63, 0x48, 0x6a, 0x07, 0x73, 0xa8, 0xc4, 0xca, 0xdb, 0xe2, 0x0d, 0x79, 0xf4,
+    0x39, 0x5e, 0x9f, 0x71, 0x5c, 0x0c, 0xaf, 0x46, 0xa9, 0x0b, 0x9b, 0x8c, 0x52, 0x35, 0xd9, 0x25,
+    0x9e, 0x6a, 0x34, 0xa6, 0xd2, 0x78, 0x92, 0x56, 0x6d, 0x40, 0x1d, 0xeb, 0x97, 0x78, 0x0d, 0x33,
+    0xa6, 0x8f, 0x70, 0xde, 0x21, 0xb3, 0x85, 0x58, 0x9c, 0xa4, 0xcc, 0x1b, 0x0c, 0x5c, 0x42, 0xf8,
+    0xf4, 0x18, 0xc2, 0x05, 0x2d, 0xb7, 0xb7, 0xe1, 0xfa, 0x68, 0x96, 0xbe, 0xd7, 0x1f, 0x24, 0xe9,
+    0x31, 0xff, 0x50, 0xbc, 0x0e, 0x7b, 0xeb, 0x1d, 0x5d, 0x2a, 0x45, 0x68, 0xf4, 0xca, 0xb4, 0xaa,
+    0xcc, 0xd1, 0x66, 0x79, 0x14, 0x76, 0x9a, 0x87, 0x71, 0x77, 0x77, 0x42, 0x06, 0x11, 0x11, 0x95,
+    0xaf, 0x48, 0x5d, 0x84, 0xf1, 0x04, 0xda, 0x7d, 0xf2, 0xdb, 0x48, 0x11, 0xc5, 0x87, 0xd0, 0x56,
+    0xf6, 0xd8, 0xdf, 0x5a, 0xcc, 0x21, 0xfa, 0x40, 0xf3, 0x36, 0x09, 0x07, 0xad, 0x0b, 0xc1, 0x65,
+    0x9d, 0xec, 0x59, 0xed, 0xbd, 0xbb, 0x20, 0x4d, 0x61, 0x5a, 0x99, 0x1c, 0x39, 0x48, 0x91, 0x21,
+    0x28, 0x32, 0x84, 0x41, 0x61, 0x24, 0x2d, 0x82, 0x29, 0xba, 0xd8, 0xf6, 0xbd, 0x9f, 0x67, 0x5a,
+    0xd6, 0x86, 0x0e, 0x35, 0x66, 0x92, 0xfc, 0x94, 0x59, 0x72, 0xba, 0x80, 0xc2, 0x2d, 0xb5, 0xe8,
+    0xd8, 0x56, 0x8c, 0xe2, 0xfc, 0x1d, 0xe4, 0x35, 0x81, 0xf5, 0xae, 0xc1, 0xa9, 0x17, 0xcd, 0x20,
+    0x84, 0x54, 0x46, 0x1b, 0xd0, 0x80, 0x13, 0xc6, 0xb9, 0x47, 0x3e, 0x14, 0xc6, 0x22, 0xb9, 0x35,
+    0x0a, 0x7d, 0xcb, 0xfa, 0xd0, 0x76, 0x38, 0xf2, 0xa1, 0x94, 0xf8, 0x76, 0x04, 0x7e, 0x3c, 0x3f,
+    0x3d, 0x26, 0x8a, 0x69, 0x83, 0xcd, 0x61, 0xe2, 0x67, 0x22, 0x1e, 0xc2, 0x7a, 0xc3, 0xbf, 0x06,
+    0x2c, 0xa9, 0xbd, 0xdb, 0x5a, 0x0d, 0xda, 0x7b, 0x41, 0x5e, 0x26, 0x89, 0xa3, 0xad, 0x62, 0x7d,
+    0xf8, 0x3a, 0x18, 0x0c, 0x76, 0x72, 0xda, 0x15, 0x73, 0xc3, 0xb4, 0x27, 0xb6, 0xb1, 0x4c, 0xdb,
+    0xab, 0xfb, 0x69, 0x27, 0xb5, 0xab, 0xda, 0xd2, 0x7c, 0x50, 0xcd, 0xc7, 0x74, 0x09, 0xb2, 0x42,
+    0xb9, 0x11, 0x0a, 0xe2, 0xc4, 0x1b, 0x6c, 0xd8, 0x05, 0xf2, 0x4a, 0x33, 0x4f, 0x7b, 0x3a, 0xf8,
+    0x7a, 0x03, 0xdb, 0x27, 0x68, 0x4c, 0x16, 0xa4, 0x04, 0xb8, 0x74, 0x19, 0x8c, 0x03, 0x38, 0x6f,
+    0x52, 0x39, 0x87, 0xe0, 0xac, 0xa5, 0xf6, 0x7f, 0xdb, 0x8f, 0x43, 0x6f, 0x75, 0x1d, 0x6e, 0x3d,
+    0xe8, 0x9a, 0xac, 0xd1, 0x56, 0x5a, 0x6c, 0x6d, 0x69, 0xf1, 0xcd, 0x46, 0xbe, 0xb5, 0xc7, 0xa2,
+    0x1d, 0xc2, 0x45, 0xb2, 0x12, 0xb5, 0x6d, 0xbe, 0x1a, 0x25, 0xf6, 0x3b, 0x27, 0xd5, 0xb7, 0xb2,
+    0x3c, 0x98, 0x91, 0x20, 0x75, 0xff, 0x83, 0xff, 0x9f, 0xd8, 0x5f, 0x6c, 0x0a, 0x7a, 0x11, 0xba,
+    0x05, 0x00, 0x00,
+};
+
+static const WebAsset WEB_ASSETS[] = {
+    {"/style.css", "text/css", STYLE_CSS_GZ, sizeof(STYLE_CSS_GZ), "\"e024495fdc922880\""},
+    {"/app.js", "application/javascript", APP_JS_GZ, sizeof(APP_JS_GZ), "\"1aaee01ca7236a4a\""},
+};
+static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
+
+#endif // WEB_ASSETS_H
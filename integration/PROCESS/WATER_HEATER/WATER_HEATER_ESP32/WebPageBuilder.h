@@ -5,19 +5,20 @@
 #include <Arduino.h>
 #include "DataManager.h"
 
-
+/*
+ * Pages are written piece by piece to a Print (ChunkedPageResponse) instead of being built in a String.
+ * A page may be written several times for one request: it only depends on its arguments.
+ * Style and script are the static /style.css and /app.js (WebAssets.h, sources in ../web).
+ */
 class WebPageBuilder {
 public:
-    static String buildIndexPage(const String& deviceInfo);
-    static String buildDataPage(const SensorData& data);
-    static String buildConfigPage();
-    static String buildProgramPage();
+    static void writeIndexPage(Print& out, unsigned long uptime);
+    static void writeDataPage(Print& out, const SensorData& data);
+    static void writeProgramPage(Print& out);
     
 private:
-    static String getHeader(const String& title);
-    static String getFooter();
-    static String getStyle();
-    static String getScript();
+    static void writeHeader(Print& out, const char* title);
+    static void writeFooter(Print& out);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,5 +1,7 @@
 // WebServerManager.cpp
 #include "WebServerManager.h"
+#include "ChunkedPageResponse.h"
+#include "WebAssets.h"      // Only included here: the PROGMEM arrays are defined in the header
 
 // Variables statiques
 unsigned long WebServerManager::lastRequest = 0;
@@ -7,9 +9,10 @@ int WebServerManager::requestCount = 0;
 
 WebServerManager::WebServerManager(WebAPIHandler& apiHandler, StateMachine& stateMachine)
     : server(80)
+    , events("/events")
     , _apiHandler(apiHandler)
     , _stateMachine(stateMachine)
-    , serverTaskHandle(nullptr)
+    , eventsTaskHandle(nullptr)
     , allowedIP(ALLOWED_IP)
     , lastFailedAttempt(0)
     , failedAttempts(0)
@@ -17,16 +20,18 @@ WebServerManager::WebServerManager(WebAPIHandler& apiHandler, StateMachine& stat
 }
 
 void WebServerManager::begin() {
-    setupRoutes();
+    // OTA guards first: AsyncWebServer gives a request to the first handler accepting it
     setupOTA();
+    setupRoutes();
+    setupEvents();
     
     xTaskCreatePinnedToCore(
-        serverTask,
-        "WebServer",
+        eventsTask,
+        "WebEvents",
         STACK_SIZE_WEBSERVER, 
         this,
         1,
-        &serverTaskHandle,
+        &eventsTaskHandle,
         0
     );
     
@@ -95,19 +100,24 @@ void WebServerManager::setupOTA() {
 */
 
 void WebServerManager::setupOTA() {
+    // The async OTA callbacks do not get the request: the IP is checked by these handlers, which only accept
+    // the OTA requests of another address (the allowed one goes on to ElegantOTA)
+    auto unauthorized = [this](AsyncWebServerRequest* request) {
+        return request->client()->remoteIP().toString() != allowedIP;
+    };
+    auto deny = [](AsyncWebServerRequest* request) {
+        Logger::log(Logger::LogLevel::ERROR, "⛔ OTA Access Denied - Unauthorized IP: " +
+                    request->client()->remoteIP().toString());
+        request->send(403, "text/plain", "Forbidden");
+    };
+    server.on("/ota/start", HTTP_ANY, deny).setFilter(unauthorized);
+    server.on("/ota/upload", HTTP_ANY, deny).setFilter(unauthorized);
+
     ElegantOTA.begin(&server, OTA_USERNAME, OTA_PASSWORD);
     ElegantOTA.setAutoReboot(false);
 
     ElegantOTA.onStart([this]() -> bool {
-        String clientIP = server.client().remoteIP().toString();
         Logger::log(Logger::LogLevel::INFO, "🚀 OTA Update Started");
-        Logger::log(Logger::LogLevel::INFO, "📡 Client: " + clientIP);
-        Logger::log(Logger::LogLevel::INFO, "Allowed IP: " + String(allowedIP));
-
-        if (clientIP != this->allowedIP) { 
-            Logger::log(Logger::LogLevel::ERROR, "⛔ Access Denied - Unauthorized IP");
-            return false;
-        }
 
         if (failedAttempts >= OTA_MAX_ATTEMPTS) {
             unsigned long timeLeft = (OTA_BLOCK_TIME - (millis() - lastFailedAttempt)) / 1000;
@@ -181,103 +191,149 @@ bool WebServerManager::checkRateLimit() {
     return true;
 }
 
+// Precompressed static file: a browser that has the current version gets a 304 without body
+void WebServerManager::serveAsset(AsyncWebServerRequest* request, const WebAsset& asset) {
+    AsyncWebServerResponse* response;
+    AsyncWebHeader* ifNoneMatch = request->getHeader("If-None-Match");
+    if (ifNoneMatch && ifNoneMatch->value() == asset.etag) {
+        response = request->beginResponse(304);
+    } else {
+        response = request->beginResponse_P(200, asset.contentType, asset.data, asset.length);
+        response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", "no-cache");   // Always revalidated: a new firmware changes the ETag
+    request->send(response);
+}
+
 // setupRoutes complet
 void WebServerManager::setupRoutes() {
     Logger::log(Logger::LogLevel::INFO, "Setting up web routes...");
-    server.on("/", HTTP_GET, [this]() {
+
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        const WebAsset* asset = &WEB_ASSETS[i];
+        server.on(asset->path, HTTP_GET, [this, asset](AsyncWebServerRequest* request) {
+            serveAsset(request, *asset);
+        });
+    }
+
+    server.on("/", HTTP_GET, [this](AsyncWebServerRequest* request) {
         if (!checkRateLimit()) {
-            server.send(429, "text/plain", "Too many requests");
+            request->send(429, "text/plain", "Too many requests");
             return;
         }
-        String html = WebPageBuilder::buildIndexPage(DataManager::collectDeviceInfo());
-        server.send(200, "text/html", html);
+        unsigned long uptime = millis() / 1000;
+        ChunkedPageResponse::send(request, "text/html", [uptime](Print& page) {
+            WebPageBuilder::writeIndexPage(page, uptime);
+        });
     });
     
-    server.on("/data", HTTP_GET, [this]() {
+    server.on("/data", HTTP_GET, [this](AsyncWebServerRequest* request) {
         if (!checkRateLimit()) {
-            server.send(429, "text/plain", "Too many requests");
+            request->send(429, "text/plain", "Too many requests");
             return;
         }
         SensorData data = DataManager::collectSensorData();
-        String html = WebPageBuilder::buildDataPage(data);
-        server.send(200, "text/html", html);
-    });
-    
-    server.on("/api/data", HTTP_GET, [this]() {
-        if (!checkRateLimit()) {
-            server.send(429, "text/plain", "Too many requests");
-            return;
-        }
-        String json = DataManager::collectAllData(_stateMachine);
-        server.send(200, "application/json", json);
+        ChunkedPageResponse::send(request, "text/html", [data](Print& page) {
+            WebPageBuilder::writeDataPage(page, data);
+        });
     });
 
-    server.on("/api/system", HTTP_GET, [this]() {
-        if (!checkRateLimit()) {
-            server.send(429, "text/plain", "Too many requests");
+    // Initial values of the dashboard, then /events: last snapshot of the sampling task, not rate limited
+    server.on("/api/live", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        char json[DataManager::LIVE_DATA_SIZE];
+        if (DataManager::writeLiveData(json, sizeof(json), _stateMachine) == 0) {
+            request->send(500, "text/plain", "Live data too large");
             return;
         }
-        String info = DataManager::collectSystemMetrics();
-        server.send(200, "application/json", info);
+        request->send(200, "application/json", json);
     });
-
-    server.on("/api/status", HTTP_GET, [this]() {
+    
+    // Complete data, system metrics, device info
+    auto api = [this](AsyncWebServerRequest* request) {
         if (!checkRateLimit()) {
-            server.send(429, "text/plain", "Too many requests");
+            request->send(429, "text/plain", "Too many requests");
             return;
         }
-        String status = DataManager::collectDeviceInfo();
-        server.send(200, "application/json", status);
-    });
-
-    server.on("/cip", HTTP_GET, [this]() {
-        if (server.hasArg("temp") && server.hasArg("duration")) {
-            String temp = server.arg("temp");
-            String duration = server.arg("duration");
+        _apiHandler.handleGETRequest(request);
+    };
+    server.on("/api/data", HTTP_GET, api);
+    server.on("/api/system", HTTP_GET, api);
+    server.on("/api/status", HTTP_GET, api);
+
+    server.on("/cip", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        if (request->hasParam("temp") && request->hasParam("duration")) {
+            String temp = request->getParam("temp")->value();
+            String duration = request->getParam("duration")->value();
             String command = "cip " + temp + " " + duration;
             _stateMachine.startProgram("CIP", command);
-            server.send(200, "text/plain", "CIP started: " + temp + "°C for " + duration + " minutes");
+            request->send(200, "text/plain", "CIP started: " + temp + "°C for " + duration + " minutes");
         } else {
-            server.send(400, "text/plain", "Use: /cip?temp=30&duration=30");
+            request->send(400, "text/plain", "Use: /cip?temp=30&duration=30");
         }
     });
 
-    server.on("/stop", HTTP_GET, [this]() {
+    server.on("/stop", HTTP_GET, [this](AsyncWebServerRequest* request) {
       _stateMachine.stopAllPrograms();
-      server.send(200, "text/plain", "All programs stopped");
+      request->send(200, "text/plain", "All programs stopped");
     });
 
-    server.on("/program", HTTP_GET, [this]() {
-      String html = WebPageBuilder::buildProgramPage();
-      server.send(200, "text/html", html);
+    server.on("/program", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      ChunkedPageResponse::send(request, "text/html", [](Print& page) {
+          WebPageBuilder::writeProgramPage(page);
+      });
     });
 
+    server.onNotFound([](AsyncWebServerRequest* request) {
+        request->send(404, "text/plain", "Not found");
+    });
 }
 
-void WebServerManager::handle() {
-    if (server.client()) {
-        String clientIP = server.client().remoteIP().toString();
-        Logger::log(Logger::LogLevel::DEBUG, "Request from: " + clientIP);
+void WebServerManager::setupEvents() {
+    // A new subscriber gets the current values at once, then every new snapshot
+    events.onConnect([this](AsyncEventSourceClient* client) {
+        sendLiveData(client);
+    });
+    server.addHandler(&events);
+}
+
+void WebServerManager::sendLiveData(AsyncEventSourceClient* client) {
+    char json[DataManager::LIVE_DATA_SIZE];
+    if (DataManager::writeLiveData(json, sizeof(json), _stateMachine) == 0) {
+        return;
+    }
+
+    uint32_t id = SensorController::getSnapshotSequence();
+    if (client) {
+        client->send(json, "live", id);
+    } else {
+        events.send(json, "live", id);
     }
-    
-    server.handleClient();
-    ElegantOTA.loop();
 }
 
-void WebServerManager::serverTask(void* parameter) {
+void WebServerManager::eventsTask(void* parameter) {
     WebServerManager* manager = static_cast<WebServerManager*>(parameter);
-    const TickType_t xDelay = pdMS_TO_TICKS(10);
+    const TickType_t xDelay = pdMS_TO_TICKS(TASK_INTERVAL_WEB_EVENTS);
+    uint32_t lastSequence = SensorController::getSnapshotSequence();
     
     while (true) {
-        manager->handle();
+        // One serialization per snapshot, whatever the number of subscribers, none without any
+        uint32_t sequence = SensorController::getSnapshotSequence();
+        if (sequence != lastSequence) {
+            lastSequence = sequence;
+            if (manager->events.count() > 0) {
+                manager->sendLiveData(nullptr);
+            }
+        }
         vTaskDelay(xDelay);
     }
 }
 
 void WebServerManager::stop() {
-    if (serverTaskHandle) {
-        vTaskDelete(serverTaskHandle);
-        serverTaskHandle = nullptr;
+    if (eventsTaskHandle) {
+        vTaskDelete(eventsTaskHandle);
+        eventsTaskHandle = nullptr;
     }
-    server.stop();
+    events.close();
+    server.end();
 }
@@ -2,8 +2,8 @@
 #ifndef WEBSERVER_MANAGER_H
 #define WEBSERVER_MANAGER_H
 
-#include <WebServer.h>
-#include <ElegantOTA.h>
+#include <ESPAsyncWebServer.h>
+#include <ElegantOTA.h>     // Needs ELEGANTOTA_USE_ASYNC_WEBSERVER 1 (ElegantOTA.h or build flag)
 #include <Arduino.h>
 #include "WebAPIHandler.h"
 #include "config.h"
@@ -11,18 +11,25 @@
 #include "StateMachine.h"
 #include "WebPageBuilder.h"
 
+struct WebAsset;
+
+/*
+ * Requests are handled by AsyncWebServer in the async TCP task, several clients at once.
+ * /events is a Server-Sent Events stream: eventsTask() serializes each new sensor snapshot once and the same
+ * "live" event goes to every subscriber, the dashboard no longer polls.
+ */
 class WebServerManager {
 public:
     WebServerManager(WebAPIHandler& apiHandler, StateMachine& stateMachine);
     void begin();
-    void handle();  // Called from task
     void stop();
 
 private:
-    WebServer server;
+    AsyncWebServer server;
+    AsyncEventSource events;
     WebAPIHandler& _apiHandler;
     StateMachine& _stateMachine;
-    TaskHandle_t serverTaskHandle;
+    TaskHandle_t eventsTaskHandle;
 
     String allowedIP;
     
@@ -31,7 +38,10 @@ private:
     
     void setupOTA();
     void setupRoutes();
-    static void serverTask(void* parameter);
+    void setupEvents();
+    void serveAsset(AsyncWebServerRequest* request, const WebAsset& asset);
+    void sendLiveData(AsyncEventSourceClient* client);     // nullptr: to all subscribers
+    static void eventsTask(void* parameter);
 
     static unsigned long lastRequest;
     static int requestCount;
@@ -16,7 +16,7 @@
 #define DS18B20_PIN 32
 
   // Pressure Pin Configuration
-#define PRESSURE_SENSOR_PIN 35    // ADC0/GPIO35 pour le capteur de pression
+#define PRESSURE_SENSOR_PIN 35    // ADC0/GPIO35 pour le capteur de pression (ADC1 pin for the continuous DMA sampling)
 
 // Actuator Pin Configuration
 #define HEATING_PLATE_PIN  12     // Pin pour le contrôle de la plaque chauffante   // Heating plate (Relay: 12, Not PWM capable) - 24V
@@ -32,6 +32,7 @@
 // OTA
 static const char* ALLOWED_IP = "192.168.1.122";  // La seule adresse IP autorisé à téléversé sur l'ESP32
 #define STACK_SIZE_WEBSERVER 8192  
+#define TASK_INTERVAL_WEB_EVENTS 100    // Check for a new sensor snapshot to push on /events
 
 // MQTT Configuration
 #define MQTT_BROKER "192.168.1.25" // Adress du serveur
@@ -42,6 +43,15 @@ static const char* ALLOWED_IP = "192.168.1.122";  // La seule adresse IP autoris
 #define MQTT_TOPIC_STATUS "water_bath/status"
 #define MQTT_TOPIC_SENSORS "water_bath/sensors"
 #define MQTT_TOPIC_COMMANDS "water_bath/commands"
+#define MQTT_TOPIC_SENSORS_BATCH "water_bath/sensors/batch"
+
+// Batched MQTT telemetry (TelemetryBatch.h), {"command":"telemetryFormat","params":{"format":"json"}} for one JSON per sample
+#define TELEMETRY_BATCH_DEFAULT true     // false: one JSON every TASK_INTERVAL_DATASENDER on MQTT_TOPIC_SENSORS
+#define TELEMETRY_SCHEMA 1               // Water heater, see telemetry_batch.py on the server
+#define TELEMETRY_CHANNELS 5
+#define TELEMETRY_SAMPLE_INTERVAL 1000   // ms
+#define TELEMETRY_BATCH_SIZE 15          // Samples per publish
+#define TELEMETRY_KEYFRAME_INTERVAL 10   // Batches between two keyframes
 
 // OTA Settings 
 #define OTA_USERNAME "admin"
@@ -52,6 +62,7 @@ static const char* ALLOWED_IP = "192.168.1.122";  // La seule adresse IP autoris
 
 
 // Task Configuration
+#define TASK_PRIORITY_SENSORS 6   // Sensor sampling, above the tasks reading its snapshot
 #define TASK_PRIORITY_HIGH 5
 #define TASK_PRIORITY_MEDIUM 3
 #define TASK_PRIORITY_LOW 1
@@ -68,6 +79,7 @@ static const char* ALLOWED_IP = "192.168.1.122";  // La seule adresse IP autoris
 
 // Task Intervals (in milliseconds)
 // pdMS_TO_TICKS converts milliseconds to FreeRTOS ticks for precise timing control
+#define TASK_INTERVAL_SENSORS         1000  // Sensor sampling interval, at least the 1 s DS18B20 conversion
 #define TASK_INTERVAL_STATEMACHINE    1000  // State machine update interval
 #define TASK_INTERVAL_SAFETY          1000  // Safety check interval
 #define TASK_INTERVAL_DATASENDER      15000 // MQTT data sending interval
@@ -78,7 +90,7 @@ static const char* ALLOWED_IP = "192.168.1.122";  // La seule adresse IP autoris
 
 // Buffer Sizes
 #define JSON_BUFFER_SIZE 1024  
-#define MQTT_QUEUE_SIZE 20
+#define MQTT_POOL_SIZE 6       // MQTTMessagePool slots: received messages waiting for the handler + publishes in progress
 
 //
 #define MQTT_MAX_RETRIES 5
@@ -106,6 +118,13 @@ static const char* ALLOWED_IP = "192.168.1.122";  // La seule adresse IP autoris
 #define MAX_WATER_TEMP 40.0f       // Maximum safe water temperature
 #define CRITICAL_WATER_TEMP 45.0f  // Critical water temperature threshold
 
+// Pressure Safety Limits
+#define CRITICAL_PRESSURE 1.5f     // bar, stops all programs (pressure sterilization runs at ~1.1 bar)
+
+// Safety interlock (SafetyInterlock.h): heater cut on CRITICAL_PRESSURE / CRITICAL_WATER_TEMP
+#define INTERLOCK_TIMER_PERIOD_US 1000    // Timer check period
+#define INTERLOCK_PRESSURE_TIMEOUT 100    // ms without pressure block before the heater is cut
+
 #define API_REQUEST_WINDOW 60000 // 1 minute
 #define API_MAX_REQUESTS 10
 
@@ -0,0 +1,24 @@
+// Adafruit_MAX31865.h
+// Declaration only, for PT100Sensor.h: no SPI on the host.
+#ifndef HOST_ADAFRUIT_MAX31865_H
+#define HOST_ADAFRUIT_MAX31865_H
+
+#include <Arduino.h>
+
+typedef enum { MAX31865_2WIRE = 0, MAX31865_3WIRE = 1, MAX31865_4WIRE = 0 } max31865_numwires_t;
+
+class Adafruit_MAX31865 {
+public:
+    Adafruit_MAX31865(int8_t spiCs, int8_t spiMosi, int8_t spiMiso, int8_t spiClk);
+    explicit Adafruit_MAX31865(int8_t spiCs);
+    bool begin(max31865_numwires_t wires = MAX31865_2WIRE);
+    uint8_t readFault();
+    void clearFault();
+    uint16_t readRTD();
+    float temperature(float RTDnominal, float refResistor);
+
+private:
+    int8_t cs;
+};
+
+#endif // HOST_ADAFRUIT_MAX31865_H
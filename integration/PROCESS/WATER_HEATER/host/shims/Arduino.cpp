@@ -0,0 +1,114 @@
+// Arduino.cpp
+#include <Arduino.h>
+#include "HostRuntime.h"
+
+#include <vector>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ---- String ----
+
+int String::indexOf(const String& s, unsigned int from) const {
+    size_t index = _s.find(s._s, from);
+    return index == std::string::npos ? -1 : static_cast<int>(index);
+}
+
+std::string String::formatFloat(double value, unsigned int decimals) {
+    if (std::isnan(value)) return "nan";
+    if (std::isinf(value)) return value > 0 ? "inf" : "-inf";
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), value);
+    return buffer;
+}
+
+// ---- Serial ----
+
+int HardwareSerial::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(nullptr, 0, format, copy);
+    va_end(copy);
+    if (length > 0) {
+        std::vector<char> text(length + 1);
+        vsnprintf(text.data(), text.size(), format, args);
+        write(text.data(), length);
+    }
+    va_end(args);
+    return length;
+}
+
+size_t HardwareSerial::write(const char* buffer, size_t size) {
+    _tx.append(buffer, size);
+    if (_echo) {
+        fwrite(buffer, 1, size, _echo);
+    }
+    // Keep long runs bounded when nobody reads the port
+    if (_tx.size() > (1u << 24)) {
+        _tx.erase(0, _tx.size() / 2);
+    }
+    return size;
+}
+
+std::string HardwareSerial::hostTakeOutput() {
+    std::string output;
+    output.swap(_tx);
+    return output;
+}
+
+// ---- Time ----
+
+unsigned long millis() {
+    return static_cast<unsigned long>(HostRuntime::nowMicros() / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(HostRuntime::nowMicros());
+}
+
+void delay(unsigned long ms) {
+    HostRuntime::advanceMillis(ms);
+}
+
+void delayMicroseconds(unsigned int us) {
+    HostRuntime::advanceMicros(us);
+}
+
+// ---- Pins ----
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    HostRuntime::pin(pin).mode = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    HostRuntime::Pin& state = HostRuntime::pin(pin);
+    if (state.beforeWrite) {
+        void (*hook)() = state.beforeWrite;
+        state.beforeWrite = nullptr;
+        hook();
+    }
+    state.digital = value ? HIGH : LOW;
+    state.lastWrite = HostRuntime::nowMicros();
+}
+
+void analogWrite(uint8_t pin, int value) {
+    HostRuntime::pin(pin).analogOutput = value;
+}
+
+int digitalRead(uint8_t pin) {
+    return HostRuntime::pin(pin).digital;
+}
+
+// ---- String functions of the ESP32 libc ----
+
+size_t strlcpy(char* destination, const char* source, size_t size) {
+    size_t length = strlen(source);
+    if (size > 0) {
+        size_t count = length < size - 1 ? length : size - 1;
+        memcpy(destination, source, count);
+        destination[count] = '\0';
+    }
+    return length;
+}
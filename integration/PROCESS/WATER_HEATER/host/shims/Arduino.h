@@ -0,0 +1,135 @@
+// Arduino.h
+// Host stand-in of the ESP32 Arduino core for the units of WATER_HEATER_ESP32 built on the PC: String, Serial,
+// pins, the hardware timer API, ESP heap figures, FreeRTOS (freertos/) and a virtual clock.
+// Time never moves by itself: the tests advance it through HostRuntime, which also fires the timer alarms.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+#include <new>
+#include <type_traits>
+#include <algorithm>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+#define IRAM_ATTR
+#define PROGMEM
+#define F(x) (x)
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+class String {
+public:
+    String() {}
+    String(const char* value) : _s(value ? value : "") {}
+    String(const std::string& value) : _s(value) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(int value) : _s(std::to_string(value)) {}
+    explicit String(unsigned int value) : _s(std::to_string(value)) {}
+    explicit String(long value) : _s(std::to_string(value)) {}
+    explicit String(unsigned long value) : _s(std::to_string(value)) {}
+    explicit String(float value, unsigned int decimals = 2) : _s(formatFloat(value, decimals)) {}
+    explicit String(double value, unsigned int decimals = 2) : _s(formatFloat(value, decimals)) {}
+
+    unsigned int length() const { return _s.size(); }
+    const char* c_str() const { return _s.c_str(); }
+    bool isEmpty() const { return _s.empty(); }
+    int indexOf(const String& s, unsigned int from = 0) const;
+    String substring(unsigned int from, unsigned int to) const {
+        if (from >= _s.size() || to <= from) return String();
+        return String(_s.substr(from, to - from));
+    }
+
+    String& operator+=(const String& s) { _s += s._s; return *this; }
+    String& operator+=(const char* s) { if (s) _s += s; return *this; }
+    String& operator+=(char c) { _s += c; return *this; }
+
+    bool operator==(const String& other) const { return _s == other._s; }
+    bool operator==(const char* other) const { return _s == (other ? other : ""); }
+    bool operator!=(const String& other) const { return !(*this == other); }
+
+    const std::string& str() const { return _s; }
+
+private:
+    std::string _s;
+
+    static std::string formatFloat(double value, unsigned int decimals);
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+
+// Serial port: what the firmware prints is kept until the test takes it
+class HardwareSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s, strlen(s)); }
+    size_t print(float value, int digits = 2) { return print(String(value, digits)); }
+    template<class T> size_t println(const T& value) { size_t n = print(value); return n + write("\r\n", 2); }
+    size_t println(float value, int digits) { size_t n = print(value, digits); return n + write("\r\n", 2); }
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    size_t write(const char* buffer, size_t size);
+
+    // Host side
+    std::string hostTakeOutput();
+    void hostSetEcho(FILE* stream) { _echo = stream; }
+
+private:
+    std::string _tx;
+    FILE* _echo = nullptr;
+};
+
+extern HardwareSerial Serial;
+
+// Heap figures of the target, reported by the logs and the heartbeat
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return 180000; }
+    uint32_t getMinFreeHeap() { return 170000; }
+    uint32_t getMaxAllocHeap() { return 110000; }
+};
+
+extern EspClass ESP;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+
+// Hardware timer (ESP32 core 3.x API), alarms fired by HostRuntime as the virtual clock moves
+struct hw_timer_t;
+hw_timer_t* timerBegin(uint32_t frequency);
+void timerAttachInterrupt(hw_timer_t* timer, void (*function)());
+void timerAlarm(hw_timer_t* timer, uint64_t alarmValue, bool autoreload, uint64_t reloadCount);
+
+size_t strlcpy(char* destination, const char* source, size_t size);
+
+template<class A, class B> auto min(A a, B b) -> typename std::common_type<A, B>::type { return (b < a) ? b : a; }
+template<class A, class B> auto max(A a, B b) -> typename std::common_type<A, B>::type { return (a < b) ? b : a; }
+#define constrain(value, low, high) ((value) < (low) ? (low) : ((value) > (high) ? (high) : (value)))
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+using std::abs;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,212 @@
+// ArduinoJson.cpp
+#include <ArduinoJson.h>
+
+namespace HostJson {
+
+class HeapAllocator : public ArduinoJson::Allocator {
+public:
+    void* allocate(size_t size) override { return ::operator new(size, std::nothrow); }
+    void deallocate(void* ptr) override { ::operator delete(ptr); }
+    void* reallocate(void* ptr, size_t newSize) override {
+        // Not used by the documents of the shim (fixed size nodes and strings)
+        (void)ptr;
+        (void)newSize;
+        return nullptr;
+    }
+};
+
+ArduinoJson::Allocator* defaultAllocator() {
+    static HeapAllocator allocator;
+    return &allocator;
+}
+
+// Output with the truncation of serializeJson(): characters past the capacity are counted, not written
+struct Writer {
+    char* buffer;
+    size_t capacity;        // Characters that can be written, NUL excluded
+    size_t length = 0;      // Characters of the whole document
+
+    void put(char c) {
+        if (buffer && length < capacity) buffer[length] = c;
+        length++;
+    }
+    void put(const char* text) {
+        while (*text) put(*text++);
+    }
+};
+
+static void writeText(Writer& out, const char* text) {
+    out.put('"');
+    for (; *text; text++) {
+        unsigned char c = static_cast<unsigned char>(*text);
+        if (c == '"' || c == '\\') {
+            out.put('\\');
+            out.put(static_cast<char>(c));
+        } else if (c == '\n') {
+            out.put("\\n");
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out.put(escaped);
+        } else {
+            out.put(static_cast<char>(c));
+        }
+    }
+    out.put('"');
+}
+
+static void writeNode(Writer& out, const Node* node) {
+    char number[32];
+    switch (node->type) {
+        case Node::Null:
+            out.put("null");
+            break;
+        case Node::Bool:
+            out.put(node->boolean ? "true" : "false");
+            break;
+        case Node::Signed:
+            snprintf(number, sizeof(number), "%lld", node->integer);
+            out.put(number);
+            break;
+        case Node::Unsigned:
+            snprintf(number, sizeof(number), "%llu", node->uinteger);
+            out.put(number);
+            break;
+        case Node::Float:
+        case Node::Double:
+            // NaN and infinities are not JSON: null, as the library does
+            if (!std::isfinite(node->number)) {
+                out.put("null");
+                break;
+            }
+            snprintf(number, sizeof(number), node->type == Node::Float ? "%.7g" : "%.15g", node->number);
+            out.put(number);
+            break;
+        case Node::LinkedText:
+        case Node::OwnedText:
+            writeText(out, node->text);
+            break;
+        case Node::Object:
+            out.put('{');
+            for (const Node* member = node->child; member; member = member->next) {
+                if (member != node->child) out.put(',');
+                writeText(out, member->key);
+                out.put(':');
+                writeNode(out, member);
+            }
+            out.put('}');
+            break;
+    }
+}
+
+} // namespace HostJson
+
+using HostJson::Node;
+
+JsonVariant JsonVariant::operator[](const char* key) {
+    Node* member = node();
+    if (member && member->type != Node::Object) {
+        _doc->release(member);
+        member->type = Node::Object;
+        member->child = nullptr;
+    }
+    return JsonVariant(_doc, member, key);
+}
+
+Node* JsonVariant::node() {
+    if (!_parent) return nullptr;
+    for (Node* member = _parent->child; member; member = member->next) {
+        if (strcmp(member->key, _key) == 0) return member;
+    }
+    return _doc->newNode(_parent, _key);
+}
+
+void JsonVariant::setText(const char* text, bool copy) {
+    Node* member = node();
+    if (!member) return;
+    _doc->release(member);
+    if (!text) return;
+    if (copy) {
+        text = _doc->copyText(text);
+        if (!text) return;
+    }
+    member->type = copy ? Node::OwnedText : Node::LinkedText;
+    member->text = text;
+}
+
+Node* JsonDocument::newNode(Node* parent, const char* key) {
+    void* memory = _allocator->allocate(sizeof(Node));
+    if (!memory) {
+        _overflowed = true;
+        return nullptr;
+    }
+    Node* node = new (memory) Node;
+    node->key = key;
+
+    // Members keep their insertion order
+    Node** last = &parent->child;
+    while (*last) last = &(*last)->next;
+    *last = node;
+    return node;
+}
+
+const char* JsonDocument::copyText(const char* text) {
+    size_t size = strlen(text) + 1;
+    char* copy = static_cast<char*>(_allocator->allocate(size));
+    if (!copy) {
+        _overflowed = true;
+        return nullptr;
+    }
+    memcpy(copy, text, size);
+    return copy;
+}
+
+// Give back what the value of a node holds, the node becomes null
+void JsonDocument::release(Node* node) {
+    if (node->type == Node::OwnedText) {
+        _allocator->deallocate(const_cast<char*>(node->text));
+    } else if (node->type == Node::Object) {
+        Node* member = node->child;
+        while (member) {
+            Node* next = member->next;
+            release(member);
+            member->~Node();
+            _allocator->deallocate(member);
+            member = next;
+        }
+    }
+    node->type = Node::Null;
+    node->uinteger = 0;
+}
+
+void JsonDocument::clear() {
+    release(&_root);
+    _root.type = Node::Object;
+    _root.child = nullptr;
+    _overflowed = false;
+}
+
+size_t serializeJson(const JsonDocument& doc, char* buffer, size_t size) {
+    if (!buffer || size == 0) return 0;
+    HostJson::Writer out{buffer, size - 1};
+    HostJson::writeNode(out, doc.root());
+    size_t written = min(out.length, size - 1);
+    buffer[written] = '\0';
+    return written;
+}
+
+size_t serializeJson(const JsonDocument& doc, String& output) {
+    HostJson::Writer measure{nullptr, 0};
+    HostJson::writeNode(measure, doc.root());
+    std::string text(measure.length, '\0');
+    HostJson::Writer out{&text[0], measure.length};
+    HostJson::writeNode(out, doc.root());
+    output = String(text);
+    return text.size();
+}
+
+size_t measureJson(const JsonDocument& doc) {
+    HostJson::Writer out{nullptr, 0};
+    HostJson::writeNode(out, doc.root());
+    return out.length;
+}
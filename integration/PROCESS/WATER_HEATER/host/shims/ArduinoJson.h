@@ -0,0 +1,143 @@
+// ArduinoJson.h
+// Subset of the ArduinoJson 7 API used to build the published messages: documents, member proxies
+// (doc["a"]["b"] = value) and serializeJson()/measureJson().
+// As in the library, every node and every copied string comes from the document allocator and goes back to it when
+// the document is destroyed, and an allocation failure sets overflowed(): what the firmware does with its memory can
+// be measured on the host. String literals are stored by pointer, other strings (String, char*, char[]) are copied.
+// Keys are string literals in the firmware: they are always stored by pointer.
+#ifndef HOST_ARDUINO_JSON_H
+#define HOST_ARDUINO_JSON_H
+
+#include <Arduino.h>
+#include <type_traits>
+#include <utility>
+
+namespace ArduinoJson {
+class Allocator {
+public:
+    virtual void* allocate(size_t size) = 0;
+    virtual void deallocate(void* ptr) = 0;
+    virtual void* reallocate(void* ptr, size_t newSize) = 0;
+
+protected:
+    ~Allocator() = default;
+};
+}
+
+namespace HostJson {
+
+struct Node {
+    enum Type : uint8_t { Null, Bool, Signed, Unsigned, Float, Double, LinkedText, OwnedText, Object };
+
+    Type type = Null;
+    const char* key = nullptr;
+    union {
+        bool boolean;
+        long long integer;
+        unsigned long long uinteger;
+        double number;
+        const char* text;
+        Node* child;
+    };
+    Node* next = nullptr;
+
+    Node() : uinteger(0) {}
+};
+
+// Allocator of the documents created without one: the heap
+ArduinoJson::Allocator* defaultAllocator();
+
+} // namespace HostJson
+
+class JsonDocument;
+
+// Member of an object, created when a value is assigned to it or when one of its own members is accessed
+class JsonVariant {
+public:
+    JsonVariant(JsonDocument* doc, HostJson::Node* parent, const char* key) : _doc(doc), _parent(parent), _key(key) {}
+
+    // Turns the member into an object
+    JsonVariant operator[](const char* key);
+
+    template<class T, class = typename std::enable_if<
+        !std::is_same<typename std::decay<T>::type, JsonVariant>::value>::type>
+    JsonVariant& operator=(T&& value);
+
+private:
+    JsonDocument* _doc;
+    HostJson::Node* _parent;    // Object holding the member, nullptr when it could not be allocated
+    const char* _key;
+
+    // Member node, created when missing (nullptr when the allocator is full)
+    HostJson::Node* node();
+    void setText(const char* text, bool copy);
+};
+
+class JsonDocument {
+public:
+    explicit JsonDocument(ArduinoJson::Allocator* allocator = HostJson::defaultAllocator()) : _allocator(allocator) {
+        _root.type = HostJson::Node::Object;
+        _root.child = nullptr;
+    }
+    ~JsonDocument() { clear(); }
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    JsonVariant operator[](const char* key) { return JsonVariant(this, &_root, key); }
+
+    bool overflowed() const { return _overflowed; }
+    void clear();
+
+    const HostJson::Node* root() const { return &_root; }
+
+private:
+    friend class JsonVariant;
+
+    ArduinoJson::Allocator* _allocator;
+    HostJson::Node _root;
+    bool _overflowed = false;
+
+    HostJson::Node* newNode(HostJson::Node* parent, const char* key);
+    const char* copyText(const char* text);
+    void release(HostJson::Node* node);
+};
+
+template<class T, class>
+JsonVariant& JsonVariant::operator=(T&& value) {
+    typedef typename std::remove_reference<T>::type Value;
+    if constexpr (std::is_array<Value>::value) {
+        // A const char array is a string literal
+        setText(value, !std::is_const<typename std::remove_extent<Value>::type>::value);
+    } else if constexpr (std::is_same<typename std::decay<T>::type, String>::value) {
+        setText(value.c_str(), true);
+    } else if constexpr (std::is_convertible<Value, const char*>::value) {
+        setText(value, true);
+    } else {
+        HostJson::Node* member = node();
+        if (!member) return *this;
+        _doc->release(member);
+        if constexpr (std::is_same<typename std::decay<T>::type, bool>::value) {
+            member->type = HostJson::Node::Bool;
+            member->boolean = value;
+        } else if constexpr (std::is_integral<Value>::value && std::is_signed<Value>::value) {
+            member->type = HostJson::Node::Signed;
+            member->integer = value;
+        } else if constexpr (std::is_integral<Value>::value) {
+            member->type = HostJson::Node::Unsigned;
+            member->uinteger = value;
+        } else {
+            static_assert(std::is_floating_point<Value>::value, "Unsupported JSON value type");
+            member->type = std::is_same<typename std::decay<T>::type, float>::value ? HostJson::Node::Float
+                                                                                   : HostJson::Node::Double;
+            member->number = value;
+        }
+    }
+    return *this;
+}
+
+// Write at most size - 1 characters and a NUL, returns the number of characters written
+size_t serializeJson(const JsonDocument& doc, char* buffer, size_t size);
+size_t serializeJson(const JsonDocument& doc, String& output);
+size_t measureJson(const JsonDocument& doc);
+
+#endif // HOST_ARDUINO_JSON_H
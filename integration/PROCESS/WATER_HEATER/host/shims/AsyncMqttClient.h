@@ -0,0 +1,94 @@
+// AsyncMqttClient.h
+// Host stand-in of the MQTT client: no broker. The test plays the broker side of the last client constructed:
+// it connects it, hands it received messages in chunks as the library does from its TCP buffer, and sees every
+// publish, in the publishing task, while the payload is still the caller's (the library copies it there).
+#ifndef HOST_ASYNC_MQTT_CLIENT_H
+#define HOST_ASYNC_MQTT_CLIENT_H
+
+#include <Arduino.h>
+#include <functional>
+
+enum class AsyncMqttClientDisconnectReason : uint8_t {
+    TCP_DISCONNECTED = 0,
+};
+
+struct AsyncMqttClientMessageProperties {
+    uint8_t qos;
+    bool dup;
+    bool retain;
+};
+
+class AsyncMqttClient {
+public:
+    typedef std::function<void(bool sessionPresent)> OnConnectUserCallback;
+    typedef std::function<void(AsyncMqttClientDisconnectReason reason)> OnDisconnectUserCallback;
+    typedef std::function<void(char* topic, char* payload, AsyncMqttClientMessageProperties properties, size_t len,
+                               size_t index, size_t total)> OnMessageUserCallback;
+    typedef void (*HostPublishHook)(const char* topic, uint8_t qos, bool retain, const char* payload, size_t length);
+
+    AsyncMqttClient() { last() = this; }
+
+    AsyncMqttClient& onConnect(OnConnectUserCallback callback) { _onConnect = callback; return *this; }
+    AsyncMqttClient& onDisconnect(OnDisconnectUserCallback callback) { _onDisconnect = callback; return *this; }
+    AsyncMqttClient& onMessage(OnMessageUserCallback callback) { _onMessage = callback; return *this; }
+    AsyncMqttClient& setServer(const char* host, uint16_t port) { (void)host; (void)port; return *this; }
+    AsyncMqttClient& setClientId(const char* clientId) { (void)clientId; return *this; }
+    AsyncMqttClient& setCredentials(const char* username, const char* password = nullptr) {
+        (void)username; (void)password;
+        return *this;
+    }
+    AsyncMqttClient& setKeepAlive(uint16_t keepAlive) { (void)keepAlive; return *this; }
+
+    // The connection is up when the test says so (hostConnect)
+    void connect() {}
+    void disconnect(bool force = false) { (void)force; }
+    uint16_t subscribe(const char* topic, uint8_t qos) { (void)topic; (void)qos; return 1; }
+    uint16_t publish(const char* topic, uint8_t qos, bool retain, const char* payload = nullptr, size_t length = 0,
+                     bool dup = false, uint16_t messageId = 0) {
+        (void)dup; (void)messageId;
+        if (payload && length == 0) length = strlen(payload);
+        HostPublishHook hook = publishHook();
+        if (hook) hook(topic, qos, retain, payload, length);
+        return 1;
+    }
+
+    // ---- Host side ----
+    static AsyncMqttClient* hostLast() { return last(); }
+    static void hostOnPublish(HostPublishHook hook) { publishHook() = hook; }
+
+    void hostConnect(bool sessionPresent = false) {
+        if (_onConnect) _onConnect(sessionPresent);
+    }
+    void hostDisconnect() {
+        if (_onDisconnect) _onDisconnect(AsyncMqttClientDisconnectReason::TCP_DISCONNECTED);
+    }
+    // Received message of total bytes in chunks of at most chunkSize, from the calling task. With upTo < total the
+    // connection drops after the chunks of the first upTo bytes.
+    void hostReceive(const char* topic, const char* payload, size_t total, size_t chunkSize, size_t upTo = SIZE_MAX) {
+        AsyncMqttClientMessageProperties properties = {1, false, false};
+        size_t index = 0;
+        do {
+            size_t len = total - index < chunkSize ? total - index : chunkSize;
+            if (_onMessage) {
+                _onMessage(const_cast<char*>(topic), const_cast<char*>(payload) + index, properties, len, index, total);
+            }
+            index += len;
+        } while (index < total && index < upTo);
+    }
+
+private:
+    static AsyncMqttClient*& last() {
+        static AsyncMqttClient* client = nullptr;
+        return client;
+    }
+    static HostPublishHook& publishHook() {
+        static HostPublishHook hook = nullptr;
+        return hook;
+    }
+
+    OnConnectUserCallback _onConnect;
+    OnDisconnectUserCallback _onDisconnect;
+    OnMessageUserCallback _onMessage;
+};
+
+#endif // HOST_ASYNC_MQTT_CLIENT_H
@@ -0,0 +1,41 @@
+// CircularBuffer.hpp
+// Fixed size ring of the CircularBuffer library (push drops the oldest item when full).
+#ifndef HOST_CIRCULAR_BUFFER_HPP
+#define HOST_CIRCULAR_BUFFER_HPP
+
+#include <stddef.h>
+
+template <typename T, size_t S>
+class CircularBuffer {
+public:
+    bool push(T value) {
+        items[(head + count) % S] = value;
+        if (count < S) {
+            count++;
+            return true;
+        }
+        head = (head + 1) % S;
+        return false;
+    }
+    T shift() {
+        T value = items[head];
+        head = (head + 1) % S;
+        count--;
+        return value;
+    }
+    T operator[](size_t index) const { return items[(head + index) % S]; }
+    T first() const { return items[head]; }
+    T last() const { return items[(head + count - 1) % S]; }
+    size_t size() const { return count; }
+    size_t available() const { return S - count; }
+    bool isEmpty() const { return count == 0; }
+    bool isFull() const { return count == S; }
+    void clear() { head = count = 0; }
+
+private:
+    T items[S];
+    size_t head = 0;
+    size_t count = 0;
+};
+
+#endif // HOST_CIRCULAR_BUFFER_HPP
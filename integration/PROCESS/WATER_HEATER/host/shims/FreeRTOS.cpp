@@ -0,0 +1,171 @@
+// FreeRTOS.cpp
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <Arduino.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct HostQueue {
+    std::mutex mutex;
+    std::condition_variable changed;
+    uint8_t* storage;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head = 0;
+    UBaseType_t count = 0;
+};
+
+struct HostTask {
+    char name[16];
+    TaskFunction_t function;
+    void* parameter;
+    bool used;
+    bool started;
+};
+
+// Fixed table, as the tests count the heap: the firmware creates a handful of tasks
+static const size_t MAX_TASKS = 16;
+static HostTask tasks[MAX_TASKS];
+static std::mutex tasksMutex;
+
+static std::atomic<bool> failNextSend(false);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreID) {
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    for (HostTask& task : tasks) {
+        if (task.used) continue;
+        strlcpy(task.name, name, sizeof(task.name));
+        task.function = function;
+        task.parameter = parameter;
+        task.used = true;
+        task.started = false;
+        if (created) *created = &task;
+        return pdPASS;
+    }
+    return pdFALSE;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (!task) return;
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    task->used = false;
+}
+
+void vTaskSuspend(TaskHandle_t task) { (void)task; }
+void vTaskResume(TaskHandle_t task) { (void)task; }
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    (void)task;
+    return 4096;
+}
+
+char* pcTaskGetName(TaskHandle_t task) {
+    return task ? task->name : nullptr;
+}
+
+bool hostStartTask(const char* name) {
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    for (HostTask& task : tasks) {
+        if (!task.used || task.started || strcmp(task.name, name) != 0) continue;
+        task.started = true;
+        std::thread(task.function, task.parameter).detach();
+        return true;
+    }
+    return false;
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(millis() / portTICK_PERIOD_MS);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks * portTICK_PERIOD_MS);
+}
+
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t increment) {
+    *previousWakeTime += increment;
+    TickType_t now = xTaskGetTickCount();
+    if (static_cast<int32_t>(*previousWakeTime - now) > 0) {
+        vTaskDelay(*previousWakeTime - now);
+    }
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    HostQueue* queue = new (std::nothrow) HostQueue;
+    if (!queue) return nullptr;
+    queue->storage = new (std::nothrow) uint8_t[length * itemSize + 1];
+    if (!queue->storage) {
+        delete queue;
+        return nullptr;
+    }
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    if (!queue) return;
+    delete[] queue->storage;
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (ticksToWait == portMAX_DELAY) {
+        queue->changed.wait(lock, [queue] { return queue->count < queue->length; });
+    } else if (queue->count >= queue->length || failNextSend.exchange(false)) {
+        return pdFALSE;
+    }
+    UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    memcpy(queue->storage + tail * queue->itemSize, item, queue->itemSize);
+    queue->count++;
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (ticksToWait == portMAX_DELAY) {
+        queue->changed.wait(lock, [queue] { return queue->count > 0; });
+    } else if (queue->count == 0) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->storage + queue->head * queue->itemSize, queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->count;
+}
+
+void hostFailNextQueueSend() {
+    failNextSend = true;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    SemaphoreHandle_t semaphore = xQueueCreate(1, 1);
+    if (semaphore) {
+        xSemaphoreGive(semaphore);
+    }
+    return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+    uint8_t token;
+    return xQueueReceive(semaphore, &token, ticksToWait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    uint8_t token = 0;
+    return xQueueSend(semaphore, &token, 0);
+}
@@ -0,0 +1,67 @@
+// HostRuntime.cpp
+#include "HostRuntime.h"
+#include <Arduino.h>
+
+#include <vector>
+
+struct hw_timer_t {
+    uint32_t frequency;
+    void (*function)();
+    uint64_t periodMicros;
+    bool autoreload;
+    uint64_t nextAlarm;         // nowMicros() of the next alarm, 0 when none
+};
+
+static std::vector<hw_timer_t*>& timers() {
+    static std::vector<hw_timer_t*> list;
+    return list;
+}
+
+std::atomic<uint64_t> HostRuntime::clockMicros(0);
+
+void HostRuntime::advanceMicros(uint64_t us) {
+    uint64_t end = clockMicros + us;
+    while (true) {
+        hw_timer_t* due = nullptr;
+        for (hw_timer_t* timer : timers()) {
+            if (timer->function && timer->nextAlarm != 0 && timer->nextAlarm <= end &&
+                (!due || timer->nextAlarm < due->nextAlarm)) {
+                due = timer;
+            }
+        }
+        if (!due) break;
+
+        clockMicros = due->nextAlarm;
+        due->nextAlarm = due->autoreload ? due->nextAlarm + due->periodMicros : 0;
+        due->function();
+    }
+    clockMicros = end;
+}
+
+HostRuntime::Pin& HostRuntime::pin(uint8_t number) {
+    static Pin pins[256];
+    return pins[number];
+}
+
+std::string HostRuntime::takeConsole() {
+    return Serial.hostTakeOutput();
+}
+
+// ---- Hardware timer ----
+
+hw_timer_t* timerBegin(uint32_t frequency) {
+    hw_timer_t* timer = new hw_timer_t{frequency, nullptr, 0, false, 0};
+    timers().push_back(timer);
+    return timer;
+}
+
+void timerAttachInterrupt(hw_timer_t* timer, void (*function)()) {
+    timer->function = function;
+}
+
+void timerAlarm(hw_timer_t* timer, uint64_t alarmValue, bool autoreload, uint64_t reloadCount) {
+    (void)reloadCount;
+    timer->periodMicros = max(alarmValue * 1000000 / timer->frequency, static_cast<uint64_t>(1));
+    timer->autoreload = autoreload;
+    timer->nextAlarm = HostRuntime::nowMicros() + timer->periodMicros;
+}
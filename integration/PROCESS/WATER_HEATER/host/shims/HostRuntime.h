@@ -0,0 +1,36 @@
+// HostRuntime.h
+// Virtual clock, pin states and hardware timer alarms of the host build.
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+
+class HostRuntime {
+public:
+    struct Pin {
+        uint8_t mode = 0;
+        uint8_t digital = 0;
+        int analogOutput = 0;
+        uint64_t lastWrite = 0;     // nowMicros() of the last digitalWrite()
+        // Called once just before the next digitalWrite(), to interleave an interrupt with the code writing the pin
+        void (*beforeWrite)() = nullptr;
+    };
+
+    // Virtual time since boot, only the functions below move it (from one task; any task may read it)
+    static uint64_t nowMicros() { return clockMicros; }
+    // Move the clock, firing every timer alarm due on the way at its own time
+    static void advanceMicros(uint64_t us);
+    static void advanceMillis(uint64_t ms) { advanceMicros(ms * 1000); }
+
+    static Pin& pin(uint8_t number);
+
+    // Console output since the last call
+    static std::string takeConsole();
+
+private:
+    static std::atomic<uint64_t> clockMicros;
+};
+
+#endif // HOST_RUNTIME_H
@@ -0,0 +1,24 @@
+// OneWire.h
+// Declaration only, for DS18B20TemperatureSensor.h: no bus on the host.
+#ifndef HOST_ONEWIRE_H
+#define HOST_ONEWIRE_H
+
+#include <Arduino.h>
+
+class OneWire {
+public:
+    explicit OneWire(uint8_t pin);
+    uint8_t reset();
+    void select(const uint8_t rom[8]);
+    void skip();
+    void write(uint8_t value, uint8_t power = 0);
+    uint8_t read();
+    bool search(uint8_t* newAddr, bool searchMode = true);
+    void reset_search();
+    static uint8_t crc8(const uint8_t* addr, uint8_t len);
+
+private:
+    uint8_t pin;
+};
+
+#endif // HOST_ONEWIRE_H
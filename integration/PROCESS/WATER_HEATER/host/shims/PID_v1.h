@@ -0,0 +1,37 @@
+// PID_v1.h
+// Declaration of the Arduino PID library (v1.2) for the firmware headers that hold a PID. Not implemented: the host
+// units do not run the control loop.
+#ifndef HOST_PID_V1_H
+#define HOST_PID_V1_H
+
+#define AUTOMATIC 1
+#define MANUAL 0
+#define DIRECT 0
+#define REVERSE 1
+
+class PID {
+public:
+    PID(double* input, double* output, double* setpoint, double Kp, double Ki, double Kd, int controllerDirection);
+    void SetMode(int mode);
+    bool Compute();
+    void SetOutputLimits(double min, double max);
+    void SetTunings(double Kp, double Ki, double Kd);
+    void SetSampleTime(int sampleTime);
+    double GetKp();
+    double GetKi();
+    double GetKd();
+    int GetMode();
+
+private:
+    double* myInput;
+    double* myOutput;
+    double* mySetpoint;
+    double kp, ki, kd;
+    unsigned long lastTime;
+    double outputSum, lastInput;
+    unsigned long SampleTime;
+    double outMin, outMax;
+    bool inAuto;
+};
+
+#endif // HOST_PID_V1_H
@@ -0,0 +1,57 @@
+// Preferences.h
+// NVS key-value storage of the ESP32 core, byte blobs only, kept in memory for the process. A test can look at and
+// damage the stored bytes through hostBlob().
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class Preferences {
+public:
+    typedef std::map<std::string, std::vector<uint8_t>> Namespace;
+
+    // Host side: stored bytes of a key, created empty if missing
+    static std::vector<uint8_t>& hostBlob(const char* name, const char* key) { return storage()[name][key]; }
+    static void hostErase() { storage().clear(); }
+
+    // Like NVS, a read-only begin() fails on a namespace that was never written
+    bool begin(const char* name, bool readOnly = false) {
+        if (readOnly && storage().find(name) == storage().end()) return false;
+        _namespace = &storage()[name];
+        _readOnly = readOnly;
+        return true;
+    }
+    void end() { _namespace = nullptr; }
+
+    size_t putBytes(const char* key, const void* value, size_t length) {
+        if (!_namespace || _readOnly) return 0;
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        (*_namespace)[key].assign(bytes, bytes + length);
+        return length;
+    }
+    size_t getBytesLength(const char* key) {
+        if (!_namespace) return 0;
+        auto entry = _namespace->find(key);
+        return entry == _namespace->end() ? 0 : entry->second.size();
+    }
+    size_t getBytes(const char* key, void* buffer, size_t maxLength) {
+        size_t length = getBytesLength(key);
+        if (length == 0 || length > maxLength) return 0;
+        memcpy(buffer, (*_namespace)[key].data(), length);
+        return length;
+    }
+
+private:
+    static std::map<std::string, Namespace>& storage() {
+        static std::map<std::string, Namespace> namespaces;
+        return namespaces;
+    }
+
+    Namespace* _namespace = nullptr;
+    bool _readOnly = false;
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,14 @@
+// WiFi.h
+// Types of the ESP32 WiFi library used in the firmware headers. The link state comes from WiFiManager, which the
+// tests replace.
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+
+typedef int WiFiEvent_t;
+struct WiFiEventInfo_t {
+    uint32_t reason;
+};
+
+#endif // HOST_WIFI_H
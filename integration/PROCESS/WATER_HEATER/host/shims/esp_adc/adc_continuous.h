@@ -0,0 +1,19 @@
+// esp_adc/adc_continuous.h
+// Types of the ESP-IDF continuous ADC driver used in PressureSensor.h. The driver is not implemented: the tests
+// feed ADCFilter with the traces directly.
+#ifndef HOST_ADC_CONTINUOUS_H
+#define HOST_ADC_CONTINUOUS_H
+
+#include <stdint.h>
+
+typedef enum { ADC_CHANNEL_0, ADC_CHANNEL_1, ADC_CHANNEL_2, ADC_CHANNEL_3, ADC_CHANNEL_4, ADC_CHANNEL_5,
+               ADC_CHANNEL_6, ADC_CHANNEL_7, ADC_CHANNEL_8, ADC_CHANNEL_9 } adc_channel_t;
+
+typedef struct adc_continuous_ctx_t* adc_continuous_handle_t;
+
+typedef struct {
+    uint8_t* conv_frame_buffer;
+    uint32_t size;
+} adc_continuous_evt_data_t;
+
+#endif // HOST_ADC_CONTINUOUS_H
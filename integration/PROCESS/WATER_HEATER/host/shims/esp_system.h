@@ -0,0 +1,10 @@
+// esp_system.h
+#ifndef HOST_ESP_SYSTEM_H
+#define HOST_ESP_SYSTEM_H
+
+#include <Arduino.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+#endif // HOST_ESP_SYSTEM_H
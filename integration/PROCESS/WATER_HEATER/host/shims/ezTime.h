@@ -0,0 +1,19 @@
+// ezTime.h
+// The clock is never synchronised on the host: timeStatus() stays timeNotSet and the firmware falls back on 0.
+#ifndef HOST_EZTIME_H
+#define HOST_EZTIME_H
+
+#include <Arduino.h>
+#include <time.h>
+
+enum timeStatus_t { timeNotSet, timeSet, timeNeedsSync };
+
+class Timezone {
+public:
+    time_t now() { return 0; }
+};
+
+inline timeStatus_t timeStatus() { return timeNotSet; }
+inline Timezone UTC;
+
+#endif // HOST_EZTIME_H
@@ -0,0 +1,26 @@
+// FreeRTOS.h
+// Host stand-in of the FreeRTOS types and of the queues and mutexes used by the units under test (queue.h,
+// semphr.h), on top of std::mutex so that tests can run the tasks as threads.
+// Tick = 1 ms of the virtual clock. A finite block time is not waited: only 0 and portMAX_DELAY are meaningful.
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+
+struct HostQueue;
+typedef HostQueue* QueueHandle_t;
+typedef HostQueue* SemaphoreHandle_t;
+
+#endif // HOST_FREERTOS_H
@@ -0,0 +1,18 @@
+// queue.h
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+// Items are copied into storage allocated at creation, as on the target
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+// Host side: the next xQueueSend() without block time, whatever the queue, fails as on a full queue. For the paths
+// a test cannot reach otherwise (a queue as long as the pool feeding it never fills); arm it just before the send.
+void hostFailNextQueueSend();
+
+#endif // HOST_FREERTOS_QUEUE_H
@@ -0,0 +1,13 @@
+// semphr.h
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "queue.h"
+
+// A mutex is a queue of one item, given at creation
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+#define vSemaphoreDelete(semaphore) vQueueDelete(semaphore)
+
+#endif // HOST_FREERTOS_SEMPHR_H
@@ -0,0 +1,29 @@
+// task.h
+// Created tasks do not run by themselves: a task loops on the virtual clock, which only the test moves. The test
+// starts the ones it needs as threads with hostStartTask(), the others stay created and idle.
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void* parameter);
+struct HostTask;
+typedef HostTask* TaskHandle_t;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t coreID);
+// A started task cannot be stopped: delete only forgets it
+void vTaskDelete(TaskHandle_t task);
+void vTaskSuspend(TaskHandle_t task);
+void vTaskResume(TaskHandle_t task);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+char* pcTaskGetName(TaskHandle_t task);
+
+TickType_t xTaskGetTickCount();
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t increment);
+
+// Host side: run the task created under this name in its own thread; false if there is none or it already runs
+bool hostStartTask(const char* name);
+
+#endif // HOST_FREERTOS_TASK_H
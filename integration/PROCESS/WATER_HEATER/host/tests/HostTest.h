@@ -0,0 +1,46 @@
+// HostTest.h
+// Minimal checks for the host tests: a failed CHECK prints its location and makes the test exit with 1.
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+static int hostTestFailures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            hostTestFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(value, expected, tolerance) \
+    do { \
+        double checkValue = (value); \
+        double checkExpected = (expected); \
+        if (!(checkValue >= checkExpected - (tolerance) && checkValue <= checkExpected + (tolerance))) { \
+            fprintf(stderr, "%s:%d: CHECK_NEAR failed: %s = %g, expected %g +/- %g\n", __FILE__, __LINE__, \
+                    #value, checkValue, checkExpected, static_cast<double>(tolerance)); \
+            hostTestFailures++; \
+        } \
+    } while (0)
+
+inline int testResult() {
+    if (hostTestFailures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", hostTestFailures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
+
+// Wall clock time, to report how much faster than real time a simulated run went
+inline double wallSeconds() {
+    using namespace std::chrono;
+    return duration_cast<duration<double>>(steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // HOST_TEST_H
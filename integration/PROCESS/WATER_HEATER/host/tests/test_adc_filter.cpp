@@ -0,0 +1,139 @@
+// Streaming trimmed mean of the pressure input (ADCFilter) on ADC traces: same result as the sort it replaced, the
+// pressure of each block stays on the trace level through noise, hum and spikes, follows a step within two blocks,
+// and a cut wire drops below the disconnection threshold of PressureSensor.
+#include "HostTest.h"
+#include <math.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "ADCFilter.h"
+
+// Block of PressureSensor (ADC_BLOCK_SIZE, ADC_BLOCK_DISCARD at ADC_SAMPLE_RATE)
+static const size_t BLOCK_SIZE = 100;
+static const size_t BLOCK_DISCARD = BLOCK_SIZE / 6;
+static const double BLOCK_TIME = 0.005;
+
+// PressureSensor::voltageToPresure() and its disconnection threshold
+static const float FAULT_LOW_V = 0.330f;
+
+static float toVoltage(uint16_t raw) {
+    return raw * 3.3f / 4095.0f;
+}
+
+static float toPressure(uint16_t raw) {
+    float voltage = toVoltage(raw);
+    if (voltage <= 0.430f) return 0.0f;
+    if (voltage >= 2.4f) return 5.0f;
+    return 5.0f * (voltage - 0.430f) / (2.4f - 0.430f);
+}
+
+// Trimmed mean of the previous PressureSensor::readADC(): bubble sort, then the mean of the middle
+static uint16_t sortedTrimmedMean(uint16_t* samples, size_t count, size_t discard) {
+    for (size_t i = 0; i + 1 < count; i++) {
+        for (size_t j = i + 1; j < count; j++) {
+            if (samples[i] > samples[j]) std::swap(samples[i], samples[j]);
+        }
+    }
+    uint32_t sum = 0;
+    for (size_t i = discard; i < count - discard; i++) sum += samples[i];
+    return sum / (count - 2 * discard);
+}
+
+struct Trace {
+    double rate = 0;
+    double stepTime = 0;
+    float before = 0;
+    float after = 0;
+    double cutTime = 0;
+    std::vector<uint16_t> samples;
+};
+
+static bool loadTrace(const std::string& path, Trace& trace) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) return false;
+    char line[128];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') {
+            sscanf(line, "# rate %lf", &trace.rate);
+            sscanf(line, "# step %lf %f %f", &trace.stepTime, &trace.before, &trace.after);
+            sscanf(line, "# cut %lf", &trace.cutTime);
+            continue;
+        }
+        trace.samples.push_back(static_cast<uint16_t>(atoi(line)));
+    }
+    fclose(file);
+    return trace.rate > 0 && !trace.samples.empty();
+}
+
+static void checkAgainstSort() {
+    std::mt19937 random(3);
+    int mismatches = 0;
+    for (int window = 0; window < 100000; window++) {
+        size_t count = 1 + random() % BLOCK_SIZE;
+        size_t discard = random() % (count / 2 + 1);
+        if (2 * discard >= count) discard = (count - 1) / 2;
+        uint16_t samples[BLOCK_SIZE];
+        uint16_t reference[BLOCK_SIZE];
+        for (size_t i = 0; i < count; i++) {
+            // Mostly a narrow band with duplicates, some spikes
+            samples[i] = reference[i] = (random() % 8 == 0) ? random() % 4096 : 1000 + random() % 16;
+        }
+        if (ADCFilter::trimmedMean(samples, count, discard) != sortedTrimmedMean(reference, count, discard)) {
+            mismatches++;
+        }
+    }
+    printf("trimmedMean vs sort: %d mismatches in 100000 windows\n", mismatches);
+    CHECK(mismatches == 0);
+}
+
+static void checkTrace(const char* name) {
+    Trace trace;
+    CHECK(loadTrace(std::string(TRACE_DIR) + "/" + name, trace));
+    if (trace.samples.empty()) return;
+    CHECK_NEAR(trace.rate * BLOCK_TIME, BLOCK_SIZE, 1e-6);
+
+    ADCFilter filter(BLOCK_SIZE, BLOCK_DISCARD);
+    float errorBefore = 0;
+    float errorAfter = 0;
+    double stepDetected = -1;
+    double cutDetected = -1;
+    double start = wallSeconds();
+    for (size_t i = 0; i < trace.samples.size(); i++) {
+        if (!filter.add(trace.samples[i])) continue;
+
+        double time = (i + 1) / trace.rate;     // End of the block
+        float pressure = toPressure(filter.value());
+        float middle = (trace.before + trace.after) / 2;
+        if (time <= trace.stepTime) {
+            errorBefore = fmaxf(errorBefore, fabsf(pressure - trace.before));
+        } else if (stepDetected < 0 && pressure > middle) {
+            stepDetected = time - trace.stepTime;
+        }
+        // Settled: the first block entirely after the step
+        if (time >= trace.stepTime + BLOCK_TIME && (trace.cutTime == 0 || time <= trace.cutTime)) {
+            errorAfter = fmaxf(errorAfter, fabsf(pressure - trace.after));
+        }
+        if (trace.cutTime > 0 && time > trace.cutTime && cutDetected < 0 && toVoltage(filter.value()) < FAULT_LOW_V) {
+            cutDetected = time - trace.cutTime;
+        }
+    }
+    double nanoseconds = (wallSeconds() - start) * 1e9 / trace.samples.size();
+
+    printf("%s: %u blocks, %.1f ns/sample, max error %.1f mbar before the step and %.1f after, "
+           "step seen after %.1f ms, cut after %.1f ms\n", name, filter.blockCount(), nanoseconds,
+           errorBefore * 1000, errorAfter * 1000, stepDetected * 1000, cutDetected * 1000);
+    CHECK(filter.blockCount() == trace.samples.size() / BLOCK_SIZE);
+    // 2 mbar per ADC count: the 50 Hz hum is not averaged out by a 5 ms block
+    CHECK(errorBefore < 0.025f);
+    CHECK(errorAfter < 0.025f);
+    CHECK(stepDetected > 0 && stepDetected <= 2 * BLOCK_TIME);
+    if (trace.cutTime > 0) {
+        CHECK(cutDetected > 0 && cutDetected <= 2 * BLOCK_TIME);
+    }
+}
+
+int main() {
+    checkAgainstSort();
+    checkTrace("pressure_step.txt");
+    return testResult();
+}
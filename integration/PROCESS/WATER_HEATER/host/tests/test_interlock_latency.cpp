@@ -0,0 +1,221 @@
+// Trip latency of SafetyInterlock in virtual time. The pressure input is sampled at 20 kS/s with noise and spikes,
+// the ADC driver hands over frames of 100 samples, the ADC task wakes up 0-1 ms later and feeds ADCFilter blocks to
+// the interlock as PressureSensor does; the 1 ms hardware timer runs on the virtual clock.
+// The heater pin must go low within 10 ms of the crossing of CRITICAL_PRESSURE for fast ramps, within one block of
+// a wire cut, and INTERLOCK_PRESSURE_TIMEOUT after the last block when the ADC stops. A trip landing inside
+// HeatingPlate::control(), after its isTripped() check, may not leave the heater on past the next timer check.
+#include "HostTest.h"
+#include "HostRuntime.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "ADCFilter.h"
+#include "HeatingPlate.h"
+#include "SafetyInterlock.h"
+#include "config.h"
+
+// PressureSensor: sampling, block and conversion of a 12-bit reading
+static const uint32_t SAMPLE_PERIOD_US = 50;
+static const size_t BLOCK_SIZE = 100;
+static const size_t BLOCK_DISCARD = BLOCK_SIZE / 6;
+static const float FAULT_LOW_V = 0.330f;
+
+static float toVoltage(uint16_t raw) {
+    return raw * 3.3f / 4095.0f;
+}
+
+static float toPressure(uint16_t raw) {
+    float voltage = toVoltage(raw);
+    if (voltage <= 0.430f) return 0.0f;
+    if (voltage >= 2.4f) return 5.0f;
+    return 5.0f * (voltage - 0.430f) / (2.4f - 0.430f);
+}
+
+static double toRaw(double bar) {
+    return (0.430 + bar / 5.0 * (2.4 - 0.430)) / 3.3 * 4095;
+}
+
+static std::mt19937 randomEngine(7);
+
+static double uniform() {
+    return std::uniform_real_distribution<double>(0, 1)(randomEngine);
+}
+
+/*
+ * Sample the input given by pressureAt(time in µs, negative: no current) until the heater pin goes low or for
+ * maxDuration, through the DMA frames and the ADC task. adcStopsAt: no frame is delivered from this time on.
+ * Returns the time of the trip, 0 when the pin stayed high.
+ */
+template<class Input>
+static uint64_t runUntilTrip(Input pressureAt, uint64_t maxDuration, uint64_t adcStopsAt = UINT64_MAX) {
+    std::normal_distribution<double> noise(0, 12);
+    ADCFilter filter(BLOCK_SIZE, BLOCK_DISCARD);
+    std::vector<uint16_t> frame;
+    std::vector<uint16_t> delivered;
+    uint64_t taskWakeUp = UINT64_MAX;
+    uint64_t end = HostRuntime::nowMicros() + maxDuration;
+
+    while (HostRuntime::nowMicros() < end) {
+        uint64_t now = HostRuntime::nowMicros();
+        double bar = pressureAt(now);
+        double raw = bar < 0 ? 4 + noise(randomEngine) / 4 : toRaw(bar) + noise(randomEngine);
+        if (uniform() < 0.002) raw = uniform() < 0.5 ? 0 : 4095;
+        frame.push_back(static_cast<uint16_t>(std::max(0.0, std::min(4095.0, raw))));
+
+        if (frame.size() == BLOCK_SIZE) {
+            if (now < adcStopsAt) {
+                delivered.swap(frame);
+                taskWakeUp = now + static_cast<uint64_t>(uniform() * 1000);
+            }
+            frame.clear();
+        }
+        if (now >= taskWakeUp) {
+            for (uint16_t sample : delivered) {
+                if (filter.add(sample)) {
+                    uint16_t block = filter.value();
+                    SafetyInterlock::updatePressure(toPressure(block), toVoltage(block) >= FAULT_LOW_V);
+                }
+            }
+            taskWakeUp = UINT64_MAX;
+        }
+
+        HostRuntime::advanceMicros(SAMPLE_PERIOD_US);
+        if (digitalRead(HEATING_PLATE_PIN) == LOW) {
+            return HostRuntime::pin(HEATING_PLATE_PIN).lastWrite;
+        }
+    }
+    return 0;
+}
+
+// Clear the latch on a normal pressure, heater on
+static void rearm() {
+    SafetyInterlock::updatePressure(1.0f, true);
+    SafetyInterlock::updateTemperature(25.0f);
+    CHECK(SafetyInterlock::reset());
+    CHECK(!SafetyInterlock::isTripped());
+    digitalWrite(HEATING_PLATE_PIN, HIGH);
+}
+
+static double percentile(std::vector<double> values, double fraction) {
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(values.size() * fraction))];
+}
+
+static void checkRamps() {
+    const double rates[] = {1, 5, 20, 100};        // bar/s, from 1.0 bar
+    const int RUNS = 200;
+    for (double rate : rates) {
+        std::vector<double> latencies;
+        int early = 0;
+        for (int run = 0; run < RUNS; run++) {
+            rearm();
+            // Random phase against the frames and the timer
+            HostRuntime::advanceMicros(static_cast<uint64_t>(uniform() * 5000));
+            uint64_t start = HostRuntime::nowMicros();
+            uint64_t crossing = start + static_cast<uint64_t>((CRITICAL_PRESSURE - 1.0) / rate * 1e6);
+            uint64_t trip = runUntilTrip([start, rate](uint64_t now) { return 1.0 + rate * (now - start) / 1e6; },
+                                         crossing - start + 1000000);
+            CHECK(trip != 0);
+            CHECK(SafetyInterlock::getTripFault() == InterlockFault::OVERPRESSURE);
+            // Noise can trip a few mbar before the threshold: on the safe side, counted as no latency
+            if (trip < crossing) early++;
+            latencies.push_back(trip > crossing ? (trip - crossing) / 1000.0 : 0.0);
+        }
+        double worst = percentile(latencies, 1.0);
+        printf("ramp %5.1f bar/s: pin low after the %.1f bar crossing in p50 %.2f ms, p99 %.2f ms, max %.2f ms "
+               "(%d/%d trips up to a few mbar early)\n", rate, CRITICAL_PRESSURE, percentile(latencies, 0.5),
+               percentile(latencies, 0.99), worst, early, RUNS);
+        // Slow ramps: 2 mbar per ADC count and the block noise set the latency, not the interlock
+        CHECK(worst < (rate >= 5 ? 10.0 : 25.0));
+    }
+}
+
+static void checkWireCut() {
+    std::vector<double> latencies;
+    for (int run = 0; run < 50; run++) {
+        rearm();
+        HostRuntime::advanceMicros(static_cast<uint64_t>(uniform() * 5000));
+        uint64_t cut = HostRuntime::nowMicros() + 200000;
+        // Heating at 1.1 bar, the sensor wire breaks: the input reads 0 bar
+        uint64_t trip = runUntilTrip([cut](uint64_t now) { return now < cut ? 1.1 : -1.0; }, 400000);
+        CHECK(trip > cut);
+        CHECK(SafetyInterlock::getTripFault() == InterlockFault::PRESSURE_INVALID);
+        latencies.push_back(trip > cut ? (trip - cut) / 1000.0 : 0.0);
+    }
+    double worst = percentile(latencies, 1.0);
+    printf("wire cut: pin low after p50 %.2f ms, max %.2f ms, fault 0x%x\n", percentile(latencies, 0.5), worst,
+           SafetyInterlock::getFaults());
+    CHECK(worst < 10.0);
+
+    // No reset while the signal is missing
+    CHECK(!SafetyInterlock::reset());
+    SafetyInterlock::updatePressure(0.0f, false);
+    CHECK(!SafetyInterlock::reset());
+    CHECK(SafetyInterlock::isTripped());
+}
+
+static void checkAdcStopped() {
+    rearm();
+    uint64_t stop = HostRuntime::nowMicros() + 100000;
+    uint64_t trip = runUntilTrip([](uint64_t) { return 0.8; }, 400000, stop);
+    CHECK(trip > stop);
+    CHECK(SafetyInterlock::getTripFault() == InterlockFault::PRESSURE_TIMEOUT);
+    // Trip value: ms since the last block, cut by the first timer tick past INTERLOCK_PRESSURE_TIMEOUT
+    float sinceLastBlock = SafetyInterlock::getTripValue();
+    printf("ADC stopped: pin low %.1f ms after the last block\n", sinceLastBlock);
+    CHECK(sinceLastBlock > INTERLOCK_PRESSURE_TIMEOUT);
+    CHECK(sinceLastBlock <= INTERLOCK_PRESSURE_TIMEOUT + 2);
+}
+
+static void checkTemperature() {
+    rearm();
+    SafetyInterlock::updateTemperature(CRITICAL_WATER_TEMP + 0.5f);
+    CHECK(digitalRead(HEATING_PLATE_PIN) == LOW);
+    CHECK(SafetyInterlock::getTripFault() == InterlockFault::OVERTEMPERATURE);
+    CHECK_NEAR(SafetyInterlock::getTripValue(), CRITICAL_WATER_TEMP + 0.5f, 0.01);
+    CHECK(!SafetyInterlock::reset());
+    SafetyInterlock::updateTemperature(CRITICAL_WATER_TEMP - 5.0f);
+    CHECK(SafetyInterlock::reset());
+}
+
+// Pressure spike of one block, the next block is normal again: only the latch keeps the heater off
+static void spikeBlock() {
+    SafetyInterlock::updatePressure(CRITICAL_PRESSURE + 0.2f, true);
+    SafetyInterlock::updatePressure(1.0f, true);
+}
+
+static void checkTripDuringControl() {
+    rearm();
+    HeatingPlate plate(HEATING_PLATE_PIN, false, "heatingPlate");
+    digitalWrite(HEATING_PLATE_PIN, LOW);
+    // The spike is handled after control() found the interlock clear, before it writes the pin
+    HostRuntime::pin(HEATING_PLATE_PIN).beforeWrite = spikeBlock;
+    plate.control(true, 100);
+    CHECK(SafetyInterlock::isTripped());
+    CHECK(SafetyInterlock::getTripFault() == InterlockFault::OVERPRESSURE);
+    CHECK(digitalRead(HEATING_PLATE_PIN) == HIGH);
+
+    uint64_t written = HostRuntime::pin(HEATING_PLATE_PIN).lastWrite;
+    HostRuntime::advanceMicros(INTERLOCK_TIMER_PERIOD_US);
+    uint64_t cut = HostRuntime::pin(HEATING_PLATE_PIN).lastWrite;
+    printf("trip inside HeatingPlate::control(): stale write cut after %.2f ms\n", (cut - written) / 1000.0);
+    CHECK(digitalRead(HEATING_PLATE_PIN) == LOW);
+    CHECK(cut - written <= INTERLOCK_TIMER_PERIOD_US);
+
+    // Locked off from then on
+    plate.control(true, 100);
+    CHECK(digitalRead(HEATING_PLATE_PIN) == LOW);
+    CHECK(SafetyInterlock::reset());
+}
+
+int main() {
+    HostRuntime::advanceMillis(1000);
+    CHECK(SafetyInterlock::begin(HEATING_PLATE_PIN, CRITICAL_PRESSURE, CRITICAL_WATER_TEMP));
+    checkRamps();
+    checkWireCut();
+    checkAdcStopped();
+    checkTemperature();
+    checkTripDuringControl();
+    return testResult();
+}
@@ -0,0 +1,378 @@
+// Heap use and received message path of the real MQTTClient (MQTTClient.cpp over MQTTMessagePool) through two weeks
+// of traffic. Sensor, heartbeat and status messages go out through publishSensorData(), publishHeartbeat() and
+// publishStatus() from their own tasks; commands come in through the AsyncMqttClient callback in chunks, are put
+// together by handleMessage() and reach the callback from the firmware's handler task. Every operator new and delete
+// is counted: after begin() nothing may be allocated and the live heap bytes must not move, the pool must never run
+// out of slots and the arena peak must stay below JSON_ARENA_SIZE. Then the edges of handleMessage(): the largest
+// payload, one byte too many, no free slot, a full queue and a message cut short must all leave the pool whole.
+#include "HostTest.h"
+#include <Arduino.h>
+#include <AsyncMqttClient.h>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <string.h>
+#include <thread>
+#include "HostRuntime.h"
+#include "MQTTClient.h"
+#include "config.h"
+
+// ---- Heap accounting ----
+
+// Each block is preceded by its size, so that the live bytes stay right for the blocks allocated before the soak
+struct alignas(std::max_align_t) BlockHeader {
+    size_t size;
+};
+
+static std::atomic<bool> soaking(false);
+static std::atomic<uint64_t> soakAllocations(0);
+static std::atomic<int64_t> liveBytes(0);
+static std::atomic<int64_t> peakBytes(0);
+
+static void* countedAllocate(size_t size) {
+    BlockHeader* header = static_cast<BlockHeader*>(malloc(sizeof(BlockHeader) + size));
+    if (!header) return nullptr;
+    header->size = size;
+    int64_t live = liveBytes += size;
+    int64_t peak = peakBytes.load();
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {}
+    if (soaking) soakAllocations++;
+    return header + 1;
+}
+
+static void countedFree(void* ptr) {
+    if (!ptr) return;
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    liveBytes -= header->size;
+    free(header);
+}
+
+void* operator new(size_t size) {
+    void* ptr = countedAllocate(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size); }
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { countedFree(ptr); }
+
+// ---- The firmware around MQTTClient, replaced at link time ----
+
+// Second of the sensor task and uptime of the heartbeat task, for the documents built from their publishes
+static thread_local uint32_t sensorSecond;
+static thread_local unsigned long heartbeatUptime;
+
+bool WiFiManager::isConnected() { return true; }
+void WiFiManager::connect() {}
+
+PID::PID(double* input, double* output, double* setpoint, double Kp, double Ki, double Kd, int controllerDirection) {}
+PIDManager::PIDManager() : tempPID(&tempInput, &tempOutput, &tempSetpoint, 0, 0, 0, DIRECT) {}
+
+StateMachine::StateMachine(PIDManager& pidManager, MQTTClient& mqttClient)
+    : currentState(ProgramState::RUNNING), currentProgram(nullptr), pidManager(pidManager), _mqttClient(mqttClient),
+      _stateMutex(nullptr), taskHandle(nullptr) {}
+String StateMachine::getCurrentProgram() const { return String("Sterilization"); }
+ProgramState StateMachine::getCurrentState() const { return currentState; }
+
+bool ActuatorController::isActuatorRunning(const String& actuatorName) { return false; }
+int ActuatorController::getCurrentValue(const String& actuatorName) { return 0; }
+
+SensorData DataManager::collectSensorData() { return {20.0f, 1.0f}; }
+
+// The documents of DataManager::addAllData() and addHeartbeatData(), the program copied as a String
+void DataManager::addAllData(JsonDocument& doc, const StateMachine& stateMachine) {
+    uint32_t second = sensorSecond;
+    char ip[16];
+    snprintf(ip, sizeof(ip), "%u.%u.%u.%u", 192, 168, 1, second % 250);
+
+    doc["program"] = stateMachine.getCurrentProgram();
+    doc["state"] = static_cast<int>(second % 5);
+    doc["sensorData"]["waterTemp"] = 20.0f + (second % 1000) * 0.1f;
+    doc["sensorData"]["pressure"] = 1.0f + (second % 100) * 0.01f;
+    doc["actuatorData"]["heatingPlate"] = (second & 1) != 0;
+    doc["actuatorValues"]["heatingPlateValue"] = static_cast<float>(second % 2);
+    doc["deviceInfo"]["id"] = MQTT_CLIENT_ID;
+    doc["deviceInfo"]["ip"] = ip;
+    doc["deviceInfo"]["uptime"] = static_cast<unsigned long>(second);
+    doc["systemMetrics"]["freeHeap"] = ESP.getFreeHeap();
+    doc["systemMetrics"]["wifiStrength"] = -60 - static_cast<int>(second % 20);
+}
+
+void DataManager::addHeartbeatData(JsonDocument& doc) {
+    doc["type"] = "heartbeat";
+    doc["uptime"] = heartbeatUptime;
+    doc["heap"] = ESP.getFreeHeap();
+    doc["heap_min"] = ESP.getMinFreeHeap();
+    doc["heap_max_block"] = ESP.getMaxAllocHeap();
+    doc["wifi_strength"] = -65;
+}
+
+// ---- Firmware traffic ----
+
+// Two weeks at the rates of a heating run: sensor data every second, a heartbeat every MQTT_HEARTBEAT_INTERVAL,
+// a command every 10 s and a status change every hour
+static const uint32_t SOAK_SECONDS = 14 * 24 * 3600;
+static const uint32_t SENSOR_PUBLISHES = SOAK_SECONDS;
+static const uint32_t HEARTBEAT_PUBLISHES = SOAK_SECONDS / (MQTT_HEARTBEAT_INTERVAL / 1000);
+static const uint32_t STATUS_PUBLISHES = SOAK_SECONDS / 3600;
+static const uint32_t COMMANDS = SOAK_SECONDS / 10;
+
+// AsyncMqttClient hands over received messages in chunks of its TCP buffer
+static const size_t CHUNK_SIZE = 256;
+static const double HANDLER_TIMEOUT = 5.0;          // s of wall time for the handler task to take a command
+
+// Never destroyed: the handler task still waits on its queue when main() returns
+static MQTTClient& client = *new MQTTClient;
+static AsyncMqttClient* broker;
+
+static std::atomic<uint32_t> publishes(0);
+static std::atomic<uint32_t> payloadErrors(0);
+
+// What the publishing task expects of its own publish
+struct ExpectedPublish {
+    const char* topic;
+    char text[48];
+};
+static thread_local ExpectedPublish expected;
+
+static void onPublish(const char* topic, uint8_t qos, bool retain, const char* payload, size_t length) {
+    publishes++;
+    if (!expected.topic || strcmp(topic, expected.topic) != 0 || length != strlen(payload) ||
+        !strstr(payload, expected.text)) {
+        payloadErrors++;
+    }
+}
+
+static void sensorTask() {
+    expected.topic = MQTT_TOPIC_SENSORS;
+    for (uint32_t second = 0; second < SENSOR_PUBLISHES; second++) {
+        sensorSecond = second;
+        snprintf(expected.text, sizeof(expected.text), "\"uptime\":%u}", second);
+        if (!client.publishSensorData(DataManager::collectSensorData())) payloadErrors++;
+    }
+}
+
+static void heartbeatTask() {
+    expected.topic = MQTT_TOPIC_STATUS;
+    for (uint32_t beat = 0; beat < HEARTBEAT_PUBLISHES; beat++) {
+        heartbeatUptime = static_cast<unsigned long>(beat) * (MQTT_HEARTBEAT_INTERVAL / 1000);
+        snprintf(expected.text, sizeof(expected.text), "\"uptime\":%lu,", heartbeatUptime);
+        if (!client.publishHeartbeat()) payloadErrors++;
+    }
+}
+
+static void statusTask() {
+    const String states[] = {"online", "heating", "holding", "cooling"};
+    expected.topic = MQTT_TOPIC_STATUS;
+    for (uint32_t hour = 0; hour < STATUS_PUBLISHES; hour++) {
+        const String& status = states[hour % 4];
+        snprintf(expected.text, sizeof(expected.text), "{\"status\":\"%s\"", status.c_str());
+        if (!client.publishStatus(status)) payloadErrors++;
+    }
+}
+
+// ---- Received commands ----
+
+// Commands the handler task gave to the callback, and the length the next one must have
+static std::atomic<uint32_t> commandsHandled(0);
+static std::atomic<size_t> expectedLength(0);
+static std::atomic<bool> holdHandler(false);
+
+// Command number seq of total bytes; every byte depends on its position, a chunk copied at the wrong index shows
+static size_t commandPayload(char* payload, uint32_t seq, size_t total) {
+    int length = snprintf(payload, total, "{\"command\":\"setpoint\",\"seq\":%u,\"profile\":\"", seq);
+    for (size_t i = length; i < total - 2; i++) payload[i] = 'a' + (i + seq) % 26;
+    memcpy(payload + total - 2, "\"}", 2);
+    return total;
+}
+
+// MQTTClient::onMessageReceived(), called from the firmware's handler task
+static void onCommand(const char* topic, const char* message) {
+    static char command[MQTTMessagePool::PAYLOAD_SIZE];
+    while (holdHandler) std::this_thread::yield();
+    size_t total = commandPayload(command, commandsHandled, expectedLength);
+    if (strcmp(topic, MQTT_TOPIC_COMMANDS) != 0 || strlen(message) != total || memcmp(message, command, total) != 0) {
+        payloadErrors++;
+    }
+    commandsHandled++;
+}
+
+// From the AsyncMqttClient task: handleMessage() drops what comes less than 100 ms after the previous message
+static void receiveCommand(uint32_t seq, size_t total, size_t upTo = SIZE_MAX) {
+    static char payload[MQTTMessagePool::PAYLOAD_SIZE + 1];
+    HostRuntime::advanceMillis(100);
+    commandPayload(payload, seq, total);
+    broker->hostReceive(MQTT_TOPIC_COMMANDS, payload, total, CHUNK_SIZE, upTo);
+}
+
+static bool waitHandled(uint32_t count) {
+    double deadline = wallSeconds() + HANDLER_TIMEOUT;
+    while (commandsHandled < count) {
+        if (wallSeconds() > deadline) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+static void receiveTask() {
+    for (uint32_t command = 0; command < COMMANDS; command++) {
+        // 300 to 900 bytes: one to four chunks
+        expectedLength = 300 + (command * 37) % 600;
+        HostRuntime::advanceMillis(10000 - 100);
+        receiveCommand(command, expectedLength);
+        if (!waitHandled(command + 1)) {
+            payloadErrors++;
+            return;
+        }
+    }
+}
+
+// Pool whole again: the handler task releases a slot just after the callback returns
+static bool waitIdle() {
+    const MQTTMessagePool& pool = client.getMessagePool();
+    double deadline = wallSeconds() + HANDLER_TIMEOUT;
+    while (pool.getFreeSlots() < pool.getSlotCount()) {
+        if (wallSeconds() > deadline) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// handleMessage() at its limits. The messages that must not reach the callback carry seq UINT32_MAX: the next
+// command checked by onCommand() would not match if one got through.
+static void checkReceiveEdges() {
+    const MQTTMessagePool& pool = client.getMessagePool();
+    const size_t slots = pool.getSlotCount();
+    const uint32_t failedAcquires = pool.getFailedAcquires();
+    uint32_t handled = commandsHandled;
+
+    // Largest payload, PAYLOAD_SIZE - 1 bytes and the NUL, in five chunks
+    expectedLength = MQTTMessagePool::PAYLOAD_SIZE - 1;
+    receiveCommand(handled, expectedLength);
+    CHECK(waitHandled(++handled));
+    CHECK(waitIdle());
+
+    // One byte more is refused before a slot is taken
+    receiveCommand(UINT32_MAX, MQTTMessagePool::PAYLOAD_SIZE);
+    CHECK(pool.getFreeSlots() == slots);
+    expectedLength = 3 * CHUNK_SIZE + 10;
+    receiveCommand(handled, expectedLength);
+    CHECK(waitHandled(++handled));
+    CHECK(waitIdle());
+
+    // No free slot: the held handler and the queue have every slot, the next message is dropped
+    holdHandler = true;
+    for (size_t i = 0; i < slots; i++) receiveCommand(handled + i, expectedLength);
+    receiveCommand(UINT32_MAX, expectedLength);
+    CHECK(pool.getFreeSlots() == 0);
+    CHECK(pool.getFailedAcquires() == failedAcquires + 1);
+    holdHandler = false;
+    handled += slots;
+    CHECK(waitHandled(handled));
+    CHECK(waitIdle());
+
+    // Full queue: the complete message goes back to the pool
+    hostFailNextQueueSend();
+    receiveCommand(UINT32_MAX, expectedLength);
+    CHECK(pool.getFreeSlots() == slots);
+    receiveCommand(handled, expectedLength);
+    CHECK(waitHandled(++handled));
+    CHECK(waitIdle());
+
+    // Cut after its first chunk: the slot waits for the rest until the next message starts
+    receiveCommand(UINT32_MAX, expectedLength, CHUNK_SIZE);
+    CHECK(pool.getFreeSlots() == slots - 1);
+    receiveCommand(handled, expectedLength);
+    CHECK(waitHandled(++handled));
+    CHECK(waitIdle());
+
+    CHECK(commandsHandled == handled);
+    CHECK(pool.getFailedAcquires() == failedAcquires + 1);
+}
+
+// A document that does not fit is refused, the slot and the arena stay usable
+static void checkOversize() {
+    static MQTTMessagePool pool(MQTT_POOL_SIZE);
+    CHECK(pool.begin());
+    MQTTMessagePool::Message* message = pool.acquire();
+    CHECK(message != nullptr);
+
+    // More copied strings than the arena holds
+    CHECK(!pool.serialize(message, [](JsonDocument& doc) {
+        static const char* keys[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
+        char value[600];
+        memset(value, 'x', sizeof(value) - 1);
+        value[sizeof(value) - 1] = '\0';
+        for (const char* key : keys) doc[key] = value;
+    }));
+    // Fits in the arena, not in the payload
+    static char text[MQTTMessagePool::PAYLOAD_SIZE + 1];
+    memset(text, 'y', MQTTMessagePool::PAYLOAD_SIZE);
+    CHECK(!pool.serialize(message, [](JsonDocument& doc) { doc["text"] = text; }));
+
+    CHECK(pool.serialize(message, [](JsonDocument& doc) { doc["status"] = "online"; }));
+    CHECK(strcmp(message->payload, "{\"status\":\"online\"}") == 0);
+    pool.release(message);
+}
+
+int main() {
+    static PIDManager pidManager;
+    static StateMachine stateMachine(pidManager, client);
+    client.setStateMachine(&stateMachine);
+    client.onMessageReceived(onCommand);
+    AsyncMqttClient::hostOnPublish(onPublish);
+    CHECK(client.begin());
+    broker = AsyncMqttClient::hostLast();
+    CHECK(hostStartTask("MQTTMsgHandler"));
+
+    // handleConnect() publishes the "online" status
+    expected.topic = MQTT_TOPIC_STATUS;
+    strlcpy(expected.text, "{\"status\":\"online\"", sizeof(expected.text));
+    broker->hostConnect();
+    CHECK(client.isConnected());
+    CHECK(publishes.exchange(0) == 1);
+
+    int64_t liveBefore = liveBytes.load();
+    double start = wallSeconds();
+    std::thread threads[] = {std::thread(receiveTask), std::thread(statusTask), std::thread(heartbeatTask),
+                             std::thread(sensorTask)};
+    // Thread stacks and states are allocated above: count from the first message on
+    int64_t peakBefore = liveBytes.load();
+    peakBytes = peakBefore;
+    soaking = true;
+    for (std::thread& thread : threads) thread.join();
+    CHECK(waitIdle());
+    soaking = false;
+    double seconds = wallSeconds() - start;
+
+    const MQTTMessagePool& pool = client.getMessagePool();
+    uint32_t published = SENSOR_PUBLISHES + HEARTBEAT_PUBLISHES + STATUS_PUBLISHES;
+    printf("%u publishes and %u received commands (%u simulated days) in %.1f s: %llu heap allocations, "
+           "live heap %+lld bytes, peak %+lld bytes\n", publishes.load(), commandsHandled.load(),
+           SOAK_SECONDS / 86400, seconds, static_cast<unsigned long long>(soakAllocations.load()),
+           static_cast<long long>(liveBytes.load() - liveBefore),
+           static_cast<long long>(peakBytes.load() - peakBefore));
+    printf("pool: %u slots, min free %u, failed acquires %u; JSON arena peak %u of %u bytes\n",
+           static_cast<unsigned>(pool.getSlotCount()), static_cast<unsigned>(pool.getMinFreeSlots()),
+           pool.getFailedAcquires(), static_cast<unsigned>(pool.getArenaPeak()),
+           static_cast<unsigned>(MQTTMessagePool::JSON_ARENA_SIZE));
+
+    CHECK(soakAllocations.load() == 0);
+    CHECK(peakBytes.load() == peakBefore);
+    CHECK(publishes.load() == published);
+    CHECK(commandsHandled.load() == COMMANDS);
+    CHECK(payloadErrors.load() == 0);
+    CHECK(pool.getFailedAcquires() == 0);
+    CHECK(pool.getMinFreeSlots() > 0);
+    CHECK(pool.getFreeSlots() == pool.getSlotCount());
+    CHECK(pool.getArenaPeak() < MQTTMessagePool::JSON_ARENA_SIZE);
+
+    checkReceiveEdges();
+    CHECK(payloadErrors.load() == 0);
+    checkOversize();
+    return testResult();
+}
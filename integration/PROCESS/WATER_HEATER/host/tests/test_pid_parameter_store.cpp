@@ -0,0 +1,80 @@
+// PID parameters in NVS (PIDParameterStore): what is saved comes back bit for bit, and a missing, damaged, truncated
+// or other-version record is refused so that PIDManager keeps its defaults.
+#include "HostTest.h"
+#include <Preferences.h>
+#include <string.h>
+#include <vector>
+#include "PIDParameterStore.h"
+
+static std::vector<uint8_t>& storedRecord() {
+    return Preferences::hostBlob("pid", "params");
+}
+
+// Rewrite the CRC (bytes 4-7, computed with them at 0) after a change, so that only the field changed is wrong
+static void resealRecord() {
+    std::vector<uint8_t>& record = storedRecord();
+    memset(record.data() + 4, 0, 4);
+    uint32_t crc = PIDParameterStore::crc32(record.data(), record.size());
+    memcpy(record.data() + 4, &crc, 4);
+}
+
+static bool sameParameters(const PIDParameters& a, const PIDParameters& b) {
+    return a.Kp == b.Kp && a.Ki == b.Ki && a.Kd == b.Kd && a.hysteresis == b.hysteresis && a.setpoint == b.setpoint;
+}
+
+int main() {
+    const char check[] = "123456789";
+    CHECK(PIDParameterStore::crc32(reinterpret_cast<const uint8_t*>(check), 9) == 0xCBF43926);
+
+    const PIDParameters defaults = {2.0, 5.0, 1.0, 0.5, 0.0};
+    const PIDParameters tuned = {3.125, 0.0421, 12.5, 0.25, 121.0};
+    PIDParameters loaded = defaults;
+
+    // Nothing saved yet
+    CHECK(!PIDParameterStore::load(loaded));
+    CHECK(sameParameters(loaded, defaults));
+
+    // Round trip
+    CHECK(PIDParameterStore::save(tuned));
+    CHECK(PIDParameterStore::load(loaded));
+    CHECK(sameParameters(loaded, tuned));
+
+    // Any flipped bit is caught by the CRC
+    const std::vector<uint8_t> good = storedRecord();
+    int undetected = 0;
+    for (size_t bit = 0; bit < good.size() * 8; bit++) {
+        storedRecord() = good;
+        storedRecord()[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+        loaded = defaults;
+        if (PIDParameterStore::load(loaded) || !sameParameters(loaded, defaults)) undetected++;
+    }
+    printf("%zu byte record, %d of %zu bit flips undetected\n", good.size(), undetected, good.size() * 8);
+    CHECK(undetected == 0);
+
+    // Truncated record (interrupted write of an older firmware, other layout)
+    storedRecord() = good;
+    storedRecord().resize(good.size() - 8);
+    loaded = defaults;
+    CHECK(!PIDParameterStore::load(loaded));
+    CHECK(sameParameters(loaded, defaults));
+
+    // Record of another format version, with a valid CRC
+    storedRecord() = good;
+    storedRecord()[0] = PIDParameterStore::VERSION + 1;
+    resealRecord();
+    CHECK(!PIDParameterStore::load(loaded));
+    CHECK(sameParameters(loaded, defaults));
+
+    // The next save replaces the bad record
+    CHECK(PIDParameterStore::save(tuned));
+    CHECK(PIDParameterStore::load(loaded));
+    CHECK(sameParameters(loaded, tuned));
+    CHECK(storedRecord() == good);
+
+    // NVS erased (new flash partition)
+    Preferences::hostErase();
+    loaded = defaults;
+    CHECK(!PIDParameterStore::load(loaded));
+    CHECK(sameParameters(loaded, defaults));
+    return testResult();
+}
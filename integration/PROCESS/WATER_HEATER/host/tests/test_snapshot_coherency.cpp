@@ -0,0 +1,131 @@
+// Coherency of the sensor snapshot (SnapshotBuffer): one writer publishes snapshots whose fields all derive from one
+// counter, reader threads copy them meanwhile. Every copy must be a whole published snapshot, never a mix of two, and
+// a reader must never see an older snapshot than the one it saw before. Run with the writer publishing back to back
+// (the slot being copied can be rewritten at any time) and at a sampling task pace.
+#include "HostTest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "SnapshotBuffer.h"
+
+// Shape of SensorSnapshot: readings, flags, statistics and timestamp
+struct Snapshot {
+    float waterTemp;
+    float pressure;
+    uint8_t errorFlags;
+    float minimum;
+    float maximum;
+    float average;
+    uint32_t readings;
+    unsigned long timestamp;
+};
+
+static Snapshot make(uint32_t n) {
+    Snapshot snapshot;
+    snapshot.waterTemp = n * 0.5f;
+    snapshot.pressure = (n % 5000) * 0.001f;
+    snapshot.errorFlags = n & 0xff;
+    snapshot.minimum = static_cast<float>(n % 1000);
+    snapshot.maximum = static_cast<float>(n % 1000) + 1;
+    snapshot.average = static_cast<float>(n % 1000) + 0.5f;
+    snapshot.readings = n;
+    snapshot.timestamp = n;
+    return snapshot;
+}
+
+static bool coherent(const Snapshot& snapshot) {
+    Snapshot expected = make(snapshot.readings);
+    return snapshot.waterTemp == expected.waterTemp && snapshot.pressure == expected.pressure &&
+           snapshot.errorFlags == expected.errorFlags && snapshot.minimum == expected.minimum &&
+           snapshot.maximum == expected.maximum && snapshot.average == expected.average &&
+           snapshot.timestamp == expected.timestamp;
+}
+
+struct ReaderResult {
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t backwards = 0;
+    uint32_t retries = 0;
+    uint32_t distinct = 0;
+    std::vector<double> latencies;      // ns, one read in 64
+};
+
+static void runReader(const SnapshotBuffer<Snapshot>& buffer, const std::atomic<bool>& running, ReaderResult& result) {
+    uint32_t last = 0;
+    while (running.load(std::memory_order_relaxed)) {
+        auto start = std::chrono::steady_clock::now();
+        Snapshot snapshot = buffer.read(&result.retries);
+        auto end = std::chrono::steady_clock::now();
+        if ((result.reads++ & 63) == 0) {
+            result.latencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        if (!coherent(snapshot)) {
+            result.torn++;
+        } else if (snapshot.readings < last) {
+            result.backwards++;
+        } else if (snapshot.readings > last) {
+            result.distinct++;
+            last = snapshot.readings;
+        }
+    }
+}
+
+static double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(values.size() * fraction))];
+}
+
+/*
+ * Publish for duration with pause between two snapshots (0: back to back) while the readers copy.
+ */
+static void checkCoherency(const char* name, std::chrono::microseconds pause, std::chrono::milliseconds duration) {
+    const int READERS = 3;
+    SnapshotBuffer<Snapshot> buffer;
+    buffer.publish(make(1));
+    std::atomic<bool> running(true);
+    ReaderResult results[READERS];
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READERS; i++) {
+        readers.emplace_back(runReader, std::cref(buffer), std::cref(running), std::ref(results[i]));
+    }
+
+    uint32_t published = 1;
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        buffer.publish(make(++published));
+        if (pause.count() > 0) std::this_thread::sleep_for(pause);
+    }
+    running = false;
+    for (std::thread& reader : readers) reader.join();
+
+    ReaderResult total;
+    for (const ReaderResult& result : results) {
+        total.reads += result.reads;
+        total.torn += result.torn;
+        total.backwards += result.backwards;
+        total.retries += result.retries;
+        total.latencies.insert(total.latencies.end(), result.latencies.begin(), result.latencies.end());
+        CHECK(result.distinct > 1);
+    }
+    printf("%s: %u snapshots published, %llu reads by %d readers, %u retries, %llu torn, %llu going back; "
+           "read p50 %.0f ns, p99 %.0f ns\n", name, published, static_cast<unsigned long long>(total.reads), READERS,
+           total.retries, static_cast<unsigned long long>(total.torn),
+           static_cast<unsigned long long>(total.backwards), percentile(total.latencies, 0.5),
+           percentile(total.latencies, 0.99));
+    CHECK(buffer.sequence() == published);
+    CHECK(total.torn == 0);
+    CHECK(total.backwards == 0);
+}
+
+int main() {
+    SnapshotBuffer<Snapshot> empty;
+    CHECK(empty.sequence() == 0);
+    CHECK(empty.read().readings == 0);
+
+    checkCoherency("back to back", std::chrono::microseconds(0), std::chrono::milliseconds(1500));
+    checkCoherency("every 1 ms", std::chrono::microseconds(1000), std::chrono::milliseconds(500));
+    return testResult();
+}
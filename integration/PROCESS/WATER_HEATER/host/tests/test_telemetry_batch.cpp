@@ -0,0 +1,175 @@
+// TelemetryBatch encoder against the committed vector vectors/telemetry_batch.txt, which the server test
+// (test_server.py) decodes with telemetry_batch.py. The batches below cover the keyframe rules (first batch, every
+// keyframeInterval batches, label change, failed publish), the varint length boundaries of the time and value
+// differences, the int32 extremes and MISSING, and a millis() rollover; the encoder must give the vector byte for byte.
+// After a deliberate format change (new VERSION), regenerate the vector with: test_telemetry_batch --write <file>
+#include "HostTest.h"
+#include <Arduino.h>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "TelemetryBatch.h"
+
+static const uint8_t SCHEMA = 1;        // Water heater: state, waterTemp, pressure, heatingPlate, heatingPlateValue
+static const uint8_t CHANNELS = 5;
+static const uint8_t SAMPLES_PER_BATCH = 4;
+static const uint8_t KEYFRAME_INTERVAL = 4;
+static const int32_t MAX = INT32_MAX;
+static const int32_t MIN = INT32_MIN + 1;          // Lowest value of toFixed()
+static const int32_t MISSING = TelemetryBatch::MISSING;
+
+static TelemetryBatch batch(SCHEMA, CHANNELS, SAMPLES_PER_BATCH, KEYFRAME_INTERVAL);
+static std::vector<std::string> lines;
+
+static void sample(uint32_t time, uint32_t timeMs, std::initializer_list<int32_t> values) {
+    std::vector<int32_t> channels(values);
+    CHECK(channels.size() == CHANNELS);
+    batch.addSample(time, timeMs, channels.data());
+    std::string line = "sample " + std::to_string(time) + " " + std::to_string(timeMs);
+    for (int32_t value : channels) line += " " + std::to_string(value);
+    lines.push_back(line);
+}
+
+static void label(const char* name) {
+    // As the publishers do: a batch of the previous label is published first
+    CHECK(batch.isEmpty());
+    batch.setLabel(name);
+    lines.push_back(std::string("label ") + name);
+}
+
+/*
+ * Batch done, as received by the subscriber: "batch" decoded, "missed" lost on the way, "skipped" dropped by the
+ * decoder until the next keyframe. full: the encoder asked for the publish (partial batch before a label change).
+ */
+static void publish(const char* reception, bool keyframe, bool full = true) {
+    CHECK(batch.isFull() == full);
+    CHECK(batch.data()[0] == TelemetryBatch::VERSION);
+    CHECK(((batch.data()[2] & TelemetryBatch::FLAG_KEYFRAME) != 0) == keyframe);
+    std::string hex;
+    char digits[3];
+    for (size_t i = 0; i < batch.length(); i++) {
+        snprintf(digits, sizeof(digits), "%02x", batch.data()[i]);
+        hex += digits;
+    }
+    lines.push_back(std::string(reception) + (keyframe ? " key " : " delta ") + hex);
+    batch.next();
+}
+
+// The publish failed: the samples are lost and the next batch starts with a keyframe
+static void failedPublish(bool keyframe) {
+    CHECK(batch.isFull());
+    CHECK(((batch.data()[2] & TelemetryBatch::FLAG_KEYFRAME) != 0) == keyframe);
+    lines.push_back(std::string("failed") + (keyframe ? " key" : " delta"));
+    batch.requestKeyframe();
+    batch.next();
+}
+
+static void encodeScenario() {
+    const uint32_t T = 1760000000;
+    label("CIP");
+    // Keyframe: absolute values
+    sample(T, 1000, {2, 2050, 1000, 1, 255});
+    sample(T, 2000, {2, 2055, 1010, 1, 255});
+    sample(T, 3000, {2, 2061, 1005, 0, 0});
+    sample(T, 4000, {2, 2066, 998, 1, 255});
+    publish("batch", true);
+
+    // Time deltas around the 1/2 and 2/3 byte varint boundaries, value differences around the zigzag ones
+    sample(T + 5, 4127, {65, 2066, 999, 1, 8446});          // +63, +8191: 1 and 2 bytes
+    sample(T + 5, 4255, {1, 2066, 998, 1, 254});            // -64, -8192: 1 and 2 bytes
+    sample(T + 5, 20638, {65, 2066, 999, 1, 8446});         // +64, +8192: 2 and 3 bytes
+    sample(T + 5, 37022, {0, 2066, 998, 1, 253});           // -65, -8193: 2 and 3 bytes
+    publish("batch", false);
+
+    // Samples taken in the same ms, 3/4 byte time deltas and value differences, missing temperature
+    sample(T + 37, 37022, {2, MISSING, 0, 1, 255});
+    sample(T + 37, 37022, {2, 2000, 1048575, 1, 255});      // +2^20 - 1: 3 bytes
+    sample(T + 37, 2134173, {2, MISSING, -1, 1, 255});      // 2^21 - 1 ms, -2^20: 3 bytes
+    sample(T + 37, 4231325, {2, 2100, 1048575, 1, 255});    // 2^21 ms, +2^20: 4 bytes
+    publish("batch", false);
+
+    // int32 extremes and MISSING next to each other: the differences need 33 bits
+    sample(T + 4232, 4232325, {MAX, MIN, MAX, 0, MIN});
+    sample(T + 4232, 4233325, {MIN, MAX, MISSING, 0, MAX});
+    sample(T + 4232, 4234325, {MISSING, MISSING, MIN, 0, MISSING});
+    sample(T + 4232, 4235325, {MAX, 2100, 0, 0, 0});
+    publish("batch", false);
+
+    // KEYFRAME_INTERVAL batches since the last keyframe; extremes as absolute values; millis() rolls over
+    sample(T + 8000, 4294966296u, {MISSING, MAX, MIN, 1, 100});
+    sample(T + 8000, 0, {2, 2105, 1003, 1, 100});
+    sample(T + 8000, 1000, {2, 2110, 1004, 1, 100});
+    sample(T + 8000, 2000, {2, 2115, 1006, 1, 100});
+    publish("batch", true);
+
+    // The subscriber misses a batch: the next one cannot be applied
+    for (int i = 0; i < SAMPLES_PER_BATCH; i++) sample(T + 8004, 3000 + 1000 * i, {2, 2120 + i, 1006, 0, 0});
+    publish("missed", false);
+    for (int i = 0; i < SAMPLES_PER_BATCH; i++) sample(T + 8008, 7000 + 1000 * i, {2, 2124 + i, 1007, 0, 0});
+    publish("skipped", false);
+
+    // Program change: the partial batch goes out first (still skipped), the new label starts with a keyframe
+    sample(T + 8012, 11000, {2, 2128, 1007, 1, 255});
+    sample(T + 8012, 12000, {2, 2130, 1008, 1, 255});
+    publish("skipped", false, false);
+    label("PressureSterilization");
+    for (int i = 0; i < SAMPLES_PER_BATCH; i++) sample(T + 8014, 13000 + 1000 * i, {1, 2132 + i, 1010 + i, 1, 255});
+    publish("batch", true);
+
+    // Failed publish, then a keyframe; clock not set (time 0)
+    for (int i = 0; i < SAMPLES_PER_BATCH; i++) sample(T + 8018, 17000 + 1000 * i, {1, 2136, 1014 + i, 1, 255});
+    failedPublish(false);
+    for (int i = 0; i < SAMPLES_PER_BATCH; i++) sample(0, 21000 + 1000 * i, {1, 2140, 1018 + i, 0, 0});
+    publish("batch", true);
+    for (int i = 0; i < SAMPLES_PER_BATCH; i++) sample(0, 25000 + 1000 * i, {3, 2140 - i, 1021, 0, 0});
+    publish("batch", false);
+}
+
+static std::vector<std::string> loadVector(const std::string& path) {
+    std::vector<std::string> result;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line[0] != '#') result.push_back(line);
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    encodeScenario();
+
+    if (argc == 3 && std::string(argv[1]) == "--write") {
+        std::ofstream file(argv[2]);
+        file << "# TelemetryBatch vector, written by test_telemetry_batch --write (WATER_HEATER/host)\n"
+             << "# encoder <schema> <channels> <samples per batch> <keyframe interval>\n"
+             << "# sample <time> <timeMs> <channel values>, label <name>: calls to the encoder\n"
+             << "# batch|missed|skipped key|delta <payload>: published; decoded, lost, dropped by the decoder\n"
+             << "# failed key|delta: publish failed, the samples are lost\n"
+             << "encoder " << int(SCHEMA) << " " << int(CHANNELS) << " " << int(SAMPLES_PER_BATCH) << " "
+             << int(KEYFRAME_INTERVAL) << "\n";
+        for (const std::string& line : lines) file << line << "\n";
+        printf("%zu lines written to %s\n", lines.size() + 1, argv[2]);
+        return testResult();
+    }
+
+    std::vector<std::string> expected = loadVector(std::string(VECTOR_DIR) + "/telemetry_batch.txt");
+    CHECK(!expected.empty());
+    CHECK(expected.size() == lines.size() + 1);
+    if (!expected.empty()) {
+        char header[64];
+        snprintf(header, sizeof(header), "encoder %d %d %d %d", SCHEMA, CHANNELS, SAMPLES_PER_BATCH,
+                 KEYFRAME_INTERVAL);
+        CHECK(expected[0] == header);
+    }
+    int mismatches = 0;
+    for (size_t i = 0; i + 1 < expected.size() && i < lines.size(); i++) {
+        if (expected[i + 1] != lines[i]) {
+            if (mismatches++ < 3) fprintf(stderr, "vector line %zu:\n  expected %s\n  encoded  %s\n", i + 2,
+                                          expected[i + 1].c_str(), lines[i].c_str());
+        }
+    }
+    printf("%zu vector lines, %d differences\n", lines.size(), mismatches);
+    CHECK(mismatches == 0);
+    return testResult();
+}
@@ -0,0 +1,45 @@
+"""
+Writes pressure_step.txt (or the path given): raw 12-bit samples of the 4-20 mA pressure input at the ADC_SAMPLE_RATE of PressureSensor,
+in the format of the traces read by test_adc_filter (one sample per line, "#" lines are the description).
+
+0.8 bar for 1 s, step to 1.7 bar, wire cut at 1.8 s. The signal is noisy (12 counts rms), has 50 Hz hum and
+0.2 % of spikes to 0 or 4095 (DMA glitches). Recorded traces can be added in the same format.
+
+CTest runs it before test_adc_filter, into the build directory: the trace is not kept in the repository.
+"""
+import math
+import random
+import sys
+
+RATE = 20000
+DURATION = 2.0
+STEP_TIME = 1.0
+CUT_TIME = 1.8
+
+
+def raw(bar):
+    voltage = 0.430 + bar / 5.0 * (2.4 - 0.430)     # PressureSensor: 4 mA at 0.43 V, 20 mA (5 bar) at 2.4 V
+    return voltage / 3.3 * 4095
+
+
+def main():
+    path = sys.argv[1] if len(sys.argv) > 1 else "pressure_step.txt"
+    random.seed(1)
+    with open(path, "w") as out:
+        out.write("# Synthetic trace, make_pressure_trace.py\n")
+        out.write(f"# rate {RATE}\n")
+        out.write(f"# step {STEP_TIME} 0.8 1.7\n")
+        out.write(f"# cut {CUT_TIME}\n")
+        for i in range(int(RATE * DURATION)):
+            t = i / RATE
+            if t >= CUT_TIME:
+                x = random.gauss(4, 3)                  # Open loop: no current
+            else:
+                x = raw(0.8 if t < STEP_TIME else 1.7) + random.gauss(0, 12) + 8 * math.sin(2 * math.pi * 50 * t)
+            if random.random() < 0.002:
+                x = random.choice([0, 4095])
+            out.write("%d\n" % max(0, min(4095, round(x))))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,41 @@
+// Live values of the dashboard (/events, /api/live without EventSource) and program page actions
+
+function showData(data) {
+    document.getElementById('data').innerHTML = `
+        <p>Water Temp: <span class="value">${data.waterTemp.toFixed(1)}&deg;C</span></p>
+        <p>Pressure: <span class="value">${data.pressure.toFixed(2)} bar</span></p>
+        <p>Heating: <span class="value">${data.heating ? 'ON' : 'OFF'}</span></p>
+        <p>Program: <span class="value">${data.program}</span></p>
+    `;
+}
+
+function updateData() {
+    fetch('/api/live')
+        .then(response => response.json())
+        .then(showData);
+}
+
+if (document.getElementById('data')) {
+    if (window.EventSource) {
+        // Pushed once per sensor snapshot, the browser reconnects on its own
+        var source = new EventSource('/events');
+        source.addEventListener('live', function(event) { showData(JSON.parse(event.data)); });
+    } else {
+        setInterval(updateData, 5000);
+        updateData();
+    }
+}
+
+function startCIP() {
+    var temp = document.getElementById("cipTemp").value;
+    var duration = document.getElementById("cipDuration").value;
+    fetch("/cip?temp=" + temp + "&duration=" + duration)
+        .then(function(response) { return response.text(); })
+        .then(function(text) { alert(text); });
+}
+
+function stopAll() {
+    fetch("/stop")
+        .then(function(response) { return response.text(); })
+        .then(function(text) { alert(text); });
+}
@@ -6,7 +6,7 @@ import csv
 from datetime import datetime
 import os
 import pandas as pd
-from typing import List
+from typing import Any, List
 import json
 import asyncio
 import logging
@@ -14,6 +14,10 @@ from logging.handlers import RotatingFileHandler
 import paho.mqtt.client as mqtt
 from threading import Thread
 import shutil  
+try:  # Started as ServerFastAPI.backend or as backend
+    from .telemetry_batch import BatchDecoder
+except ImportError:
+    from telemetry_batch import BatchDecoder
 
 def flatten_dict(d, parent_key='', sep='_'):
     items = []
@@ -28,6 +32,7 @@ def flatten_dict(d, parent_key='', sep='_'):
 class BioreactorData(BaseModel):
     arduino_value: dict
     timestamp: str
+    epoch: int = 0  # UTC time the bridge received the data, 0 when unknown (sent on arrival)
 
 # Configuration du logging
 log_formatter = logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s')
@@ -47,6 +52,7 @@ logger.addHandler(console_handler)
 # MQTT Setup
 mqtt_client = mqtt.Client()
 mqtt_connected = False
+batch_decoder = BatchDecoder()
 
 def on_mqtt_connect(client, userdata, flags, rc):
     global mqtt_connected
@@ -54,11 +60,22 @@ def on_mqtt_connect(client, userdata, flags, rc):
     logger.info("Connected to MQTT broker")
     client.subscribe("bioreactor/status")
     client.subscribe("bioreactor/sensors")
+    client.subscribe("bioreactor/sensors/batch")
+
+def handle_mqtt_payload(topic, payload):
+    """Consumer of the JSON messages, batched samples are given to it as if received one by one"""
+    logger.debug(f"MQTT message received on {topic}: {payload}")
 
 def on_mqtt_message(client, userdata, msg):
     try:
-        payload = json.loads(msg.payload.decode())
-        logger.debug(f"MQTT message received on {msg.topic}: {payload}")
+        if msg.topic.endswith("/batch"):
+            samples = batch_decoder.decode(msg.topic, msg.payload)
+            logger.debug(f"MQTT batch received on {msg.topic}: {len(samples)} samples")
+            topic = msg.topic[:-len("/batch")]
+            for sample in samples:
+                handle_mqtt_payload(topic, sample)
+            return
+        handle_mqtt_payload(msg.topic, json.loads(msg.payload.decode()))
     except Exception as e:
         logger.error(f"Error processing MQTT message: {e}")
 
@@ -199,17 +216,55 @@ async def execute_stop():
 @app.post("/sensor_data")
 async def receive_data(data: BioreactorData):
     logger.info("Received bioreactor data")
+    try:
+        save_bioreactor_data(data)
+    except Exception as e:
+        raise HTTPException(status_code=500, detail=str(e))
+    return {"status": "success", "message": "Data received and processed"}
+
+@app.post("/sensor_data/batch")
+async def receive_data_batch(batch: List[Any]):
+    """Data queued by the ESP32 bridge during an outage, in the order the Teensy sent it"""
+    logger.info(f"Received a batch of {len(batch)} bioreactor data")
+    # Entries are validated one by one: a bad entry must not block the entries queued behind it,
+    # it is logged and skipped
+    valid = []
+    for index, entry in enumerate(batch):
+        try:
+            if not isinstance(entry, dict):
+                raise ValueError("entry must be an object")
+            data = BioreactorData(**entry)
+            validate_bioreactor_data(data)
+            valid.append(data)
+        except (ValueError, ValidationError) as e:
+            logger.warning(f"Batch entry {index} rejected: {e}")
+    # Any other failure is on the server side: the bridge keeps the batch and sends it again
+    try:
+        for data in valid:
+            save_bioreactor_data(data)
+    except Exception as e:
+        raise HTTPException(status_code=500, detail=str(e))
+    return {"status": "success", "saved": len(valid), "rejected": len(batch) - len(valid)}
+
+def validate_bioreactor_data(data: BioreactorData):
+    """Raise ValueError if the data cannot be saved"""
+    if not isinstance(data.arduino_value, dict):
+        raise ValueError("arduino_value must be a dictionary")
+    if data.epoch < 0 or data.epoch >= 2 ** 32:
+        raise ValueError(f"epoch out of range: {data.epoch}")
+
+def save_bioreactor_data(data: BioreactorData):
     logger.debug(f"Raw received data: {data.dict()}")
     ensure_csv_header()
 
-    backend_time = datetime.now().strftime("%Y-%m-%d %H:%M:%S")
+    # Data delayed by a network outage keeps the time the bridge received it
+    sample_time = datetime.fromtimestamp(data.epoch) if data.epoch > 0 else datetime.now()
+    backend_time = sample_time.strftime("%Y-%m-%d %H:%M:%S")
 
     try:
+        validate_bioreactor_data(data)
         bioreactor_data = data.arduino_value
         logger.debug(f"Parsed arduino_value: {bioreactor_data}")
-
-        if not isinstance(bioreactor_data, dict):
-            raise ValueError("arduino_value must be a dictionary")
         
         # Determine event type and process program parameters
         event_type = "unknown"
@@ -304,11 +359,10 @@ async def receive_data(data: BioreactorData):
             writer.writerow(row)
 
         logger.info("Bioreactor data successfully saved")
-        return {"status": "success", "message": "Data received and processed"}
 
     except Exception as e:
         logger.error(f"Error processing data: {str(e)}")
-        raise HTTPException(status_code=500, detail=str(e))
+        raise
 
 @app.get("/sensor_data")
 async def get_sensor_data():
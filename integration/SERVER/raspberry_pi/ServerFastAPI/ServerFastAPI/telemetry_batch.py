@@ -0,0 +1,130 @@
+"""
+Decoder of the batched MQTT telemetry published on <sensors topic>/batch by the water heater and the XS bridge
+(see TelemetryBatch.h on the ESP32s for the layout).
+
+Each sample is rebuilt as the per-sample JSON the devices publish in legacy mode, without the static fields
+(device info, IP...). A decoder keeps the last values of each topic: a batch that does not follow the previous
+one (lost message, decoder started late) is skipped until the next keyframe.
+
+Usage:
+    decoder = BatchDecoder()
+    samples = decoder.decode(msg.topic, msg.payload)
+"""
+import struct
+
+VERSION = 1
+FLAG_KEYFRAME = 0x01
+HEADER_FORMAT = "<BBBBBHI"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+MISSING = -2 ** 31
+
+XS_ACTUATORS = ["airPump", "drainPump", "samplePump", "nutrientPump", "basePump",
+                "fillPump", "stirringMotor", "heatingPlate", "ledGrowLight"]  # ActuatorId order
+
+# Channels of each schema: (JSON path, scale). A scale of bool is a 0/1 value, None a bit field of running actuators.
+SCHEMAS = {
+    1: {  # Water heater
+        "label": "program",
+        "channels": [
+            (("state",), 1),
+            (("sensorData", "waterTemp"), 100),
+            (("sensorData", "pressure"), 1000),
+            (("actuatorData", "heatingPlate"), bool),
+            (("actuatorValues", "heatingPlateValue"), 1),
+        ],
+    },
+    2: {  # XS bioreactor (Teensy through the bridge)
+        "label": "currentProgram",
+        "channels": [(("programState",), 1)] +
+                    [(("sensorData", name), 100) for name in
+                     ["waterTemp", "airTemp", "elecTemp", "pH", "turbidity", "oxygen", "airFlow"]] +
+                    [(("actuatorData",), None)] +
+                    [(("actuatorSetpoints", name + "Value"), 1) for name in XS_ACTUATORS] +
+                    [(("volumeData", name), 10000) for name in
+                     ["currentVolume", "availableVolume", "addedNaOH", "addedNutrient", "addedMicroalgae",
+                      "removedVolume"]],
+    },
+}
+
+
+def read_varint(data, offset):
+    value = shift = 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+class BatchDecoder:
+    def __init__(self):
+        self.streams = {}  # topic -> {"sequence", "values", "label"} of the last decoded batch
+        self.skipped_batches = 0
+
+    def decode(self, topic, payload):
+        """Samples of a batch as a list of dicts, empty when the batch cannot be decoded."""
+        version, schema_id, flags, channel_count, sample_count, sequence, time = \
+            struct.unpack_from(HEADER_FORMAT, payload, 0)
+        schema = SCHEMAS.get(schema_id)
+        if version != VERSION or schema is None or len(schema["channels"]) != channel_count:
+            raise ValueError(f"Unsupported telemetry batch (version {version}, schema {schema_id})")
+
+        offset = HEADER_SIZE
+        stream = self.streams.get(topic)
+        keyframe = flags & FLAG_KEYFRAME
+        if keyframe:
+            label_length = payload[offset]
+            label = payload[offset + 1:offset + 1 + label_length].decode(errors="replace")
+            offset += 1 + label_length
+            values = [0] * channel_count
+        elif stream is None or sequence != (stream["sequence"] + 1) & 0xFFFF:
+            self.skipped_batches += 1
+            self.streams.pop(topic, None)
+            return []
+        else:
+            label = stream["label"]
+            values = stream["values"]
+
+        samples = []
+        elapsed_ms = 0
+        for index in range(sample_count):
+            delta_ms, offset = read_varint(payload, offset)
+            elapsed_ms += delta_ms
+            for channel in range(channel_count):
+                raw, offset = read_varint(payload, offset)
+                value = unzigzag(raw)
+                values[channel] = value if keyframe and index == 0 else values[channel] + value
+            samples.append(self._build_sample(schema, label, values, time, elapsed_ms))
+
+        self.streams[topic] = {"sequence": sequence, "values": values, "label": label}
+        return samples
+
+    @staticmethod
+    def _build_sample(schema, label, values, time, elapsed_ms):
+        sample = {schema["label"]: label}
+        for (path, scale), value in zip(schema["channels"], values):
+            if scale is None:
+                node = sample.setdefault(path[0], {})
+                for bit, name in enumerate(XS_ACTUATORS):
+                    node[name] = bool(value & (1 << bit))
+                continue
+            node = sample
+            for key in path[:-1]:
+                node = node.setdefault(key, {})
+            if value == MISSING:
+                node[path[-1]] = None
+            elif scale is bool:
+                node[path[-1]] = bool(value)
+            elif scale == 1:
+                node[path[-1]] = value
+            else:
+                node[path[-1]] = value / scale
+        # Reception time of the sample, the first sample of the batch at "time"
+        sample["epoch"] = time + elapsed_ms / 1000.0 if time else 0
+        return sample
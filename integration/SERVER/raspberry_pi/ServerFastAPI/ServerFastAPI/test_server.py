@@ -1,6 +1,14 @@
-import requests
 import json
+import math
+import struct
 from datetime import datetime
+from pathlib import Path
+
+try:
+    from .telemetry_batch import (BatchDecoder, FLAG_KEYFRAME, HEADER_FORMAT, MISSING, SCHEMAS, VERSION,
+                                  XS_ACTUATORS)
+except ImportError:
+    from telemetry_batch import BatchDecoder, FLAG_KEYFRAME, HEADER_FORMAT, MISSING, SCHEMAS, VERSION, XS_ACTUATORS
 
 url = "http://192.168.1.25:8000/sensor_data"
 data = {
@@ -35,5 +43,199 @@ data = {
     "timestamp": datetime.now().strftime("%Y-%m-%dT%H:%M:%S")
 }
 
-response = requests.post(url, json=data)
-print(response.json())
+
+def post_test_data():
+    """Send one sample to a running backend"""
+    import requests
+    response = requests.post(url, json=data)
+    print(response.json())
+
+
+# Encoder of TelemetryBatch.cpp (ESP32), to check telemetry_batch.py without a device
+
+def write_varint(out, value):
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+
+
+def zigzag(value):
+    return (value << 1) ^ (value >> 63) if value < 0 else value << 1
+
+
+def to_fixed(value, scale):
+    return MISSING if value is None or math.isnan(value) else int(round(value * scale))
+
+
+class BatchEncoder:
+    def __init__(self, schema_id, samples_per_batch=15, keyframe_interval=10):
+        self.schema_id = schema_id
+        self.channel_count = len(SCHEMAS[schema_id]["channels"])
+        self.samples_per_batch = samples_per_batch
+        self.keyframe_interval = keyframe_interval
+        self.sequence = 0
+        self.previous = [0] * self.channel_count
+
+    def encode(self, label, time, samples):
+        """samples: list of (ms since the previous sample, channel values), returns the payload"""
+        keyframe = self.sequence % self.keyframe_interval == 0
+        out = bytearray(struct.pack(HEADER_FORMAT, VERSION, self.schema_id, FLAG_KEYFRAME if keyframe else 0,
+                                    self.channel_count, len(samples), self.sequence & 0xFFFF, time))
+        if keyframe:
+            out.append(len(label))
+            out += label.encode()
+        for index, (delta_ms, values) in enumerate(samples):
+            write_varint(out, delta_ms)
+            for channel, value in enumerate(values):
+                difference = value if keyframe and index == 0 else value - self.previous[channel]
+                write_varint(out, zigzag(difference) & 0xFFFFFFFFFFFFFFFF)
+                self.previous[channel] = value
+        self.sequence += 1
+        return bytes(out)
+
+
+def xs_sample(second):
+    """Channel values of the XS schema for one second of a simulated culture"""
+    sensors = [25 + 5 * math.sin(second / 600), 22.5, 38 + math.sin(second / 60), 7 - second / 36000,
+               120 + second / 30, float("nan") if second % 97 == 0 else 6.5, 1.2]
+    running = 0b010000001 if second % 300 < 30 else 0b010000000
+    setpoints = [50, 0, 0, 0, 0, 0, 300, 80 if running & 0x80 else 0, 0]
+    volumes = [0.5 + second / 1e6, 0.3, second / 1e7, second / 2e6, 0.0, 0.0]
+    return ([2] + [to_fixed(v, 100) for v in sensors] + [running] + setpoints + [to_fixed(v, 10000) for v in volumes])
+
+
+def expected_sample(values):
+    """Sample as telemetry_batch.py rebuilds it from the channel values"""
+    sample = {"currentProgram": "Fermentation", "programState": values[0], "sensorData": {}}
+    names = ["waterTemp", "airTemp", "elecTemp", "pH", "turbidity", "oxygen", "airFlow"]
+    for name, value in zip(names, values[1:8]):
+        sample["sensorData"][name] = None if value == MISSING else value / 100
+    sample["actuatorData"] = {name: bool(values[8] & (1 << bit)) for bit, name in enumerate(XS_ACTUATORS)}
+    sample["actuatorSetpoints"] = {name + "Value": value for name, value in zip(XS_ACTUATORS, values[9:18])}
+    volume_names = ["currentVolume", "availableVolume", "addedNaOH", "addedNutrient", "addedMicroalgae",
+                    "removedVolume"]
+    sample["volumeData"] = {name: value / 10000 for name, value in zip(volume_names, values[18:])}
+    return sample
+
+
+def test_telemetry_batch_round_trip():
+    """One hour of XS samples at 1 sample/s: decoded values match, batches are far smaller than the JSON"""
+    encoder = BatchEncoder(2)
+    decoder = BatchDecoder()
+    topic = "bioreactor/sensors/batch"
+    start = 1760000000
+    batch_bytes = 0
+    json_bytes = 0
+    decoded = 0
+    for first in range(0, 3600, 15):
+        seconds = range(first, first + 15)
+        values = [xs_sample(second) for second in seconds]
+        payload = encoder.encode("Fermentation", start + first, [(0 if i == 0 else 1000, v) for i, v in
+                                                                   enumerate(values)])
+        samples = decoder.decode(topic, payload)
+        assert len(samples) == len(values)
+        for second, sample, channel_values in zip(seconds, samples, values):
+            expected = expected_sample(channel_values)
+            assert sample["epoch"] == start + second
+            for key, value in expected.items():
+                assert sample[key] == value, (second, key)
+            json_bytes += len(json.dumps(sample))
+        batch_bytes += len(payload)
+        decoded += len(samples)
+
+    assert decoded == 3600
+    assert decoder.skipped_batches == 0
+    # Lower bound of the gain: the legacy JSON also repeats the device fields in every message
+    print(f"{batch_bytes / decoded:.1f} B/sample batched, {json_bytes / decoded:.1f} B/sample as JSON")
+    assert batch_bytes * 10 < json_bytes
+
+
+def test_telemetry_batch_missed_batch():
+    """A batch that does not follow the previous one is skipped until the next keyframe"""
+    encoder = BatchEncoder(2, keyframe_interval=4)
+    decoder = BatchDecoder()
+    topic = "bioreactor/sensors/batch"
+    counts = []
+    for batch in range(8):
+        payload = encoder.encode("Fermentation", 0, [(1000, xs_sample(batch * 15 + i)) for i in range(15)])
+        if batch == 1:
+            continue  # Lost on the way
+        counts.append(len(decoder.decode(topic, payload)))
+    assert counts == [15, 0, 0, 15, 15, 15, 15]
+    assert decoder.skipped_batches == 2
+
+
+
+# Written by the encoder itself: WATER_HEATER/host/tests/test_telemetry_batch.cpp checks it byte for byte
+DEVICE_VECTOR = (Path(__file__).resolve().parents[4] / "PROCESS" / "WATER_HEATER" / "host" / "vectors" /
+                 "telemetry_batch.txt")
+
+
+def channel_values(schema_id, sample):
+    """Channel values of a decoded sample, as given to the encoder"""
+    values = []
+    for path, scale in SCHEMAS[schema_id]["channels"]:
+        node = sample
+        if scale is None:
+            values.append(sum(1 << bit for bit, name in enumerate(XS_ACTUATORS) if node[path[0]][name]))
+            continue
+        for key in path:
+            node = node[key]
+        if node is None:
+            values.append(MISSING)
+        elif scale is bool or scale == 1:
+            values.append(int(node))
+        else:
+            values.append(round(node * scale))
+    return values
+
+
+def test_telemetry_batch_device_vector():
+    """Batches of TelemetryBatch.cpp decode to the samples given to the encoder: keyframe flags, varint boundaries,
+    int32 extremes and missing values, millis() rollover, lost and failed batches"""
+    decoder = BatchDecoder()
+    topic = "water_heater/sensors/batch"
+    schema_id = label = None
+    pending = []
+    decoded = 0
+    for line in DEVICE_VECTOR.read_text().splitlines():
+        if not line or line.startswith("#"):
+            continue
+        kind, *fields = line.split()
+        if kind == "encoder":
+            schema_id = int(fields[0])
+            assert len(SCHEMAS[schema_id]["channels"]) == int(fields[1])
+        elif kind == "label":
+            label = fields[0]
+        elif kind == "sample":
+            pending.append((int(fields[0]), int(fields[1]), [int(value) for value in fields[2:]]))
+        elif kind == "failed":
+            pending = []
+        else:
+            payload = bytes.fromhex(fields[1])
+            assert payload[0] == VERSION and payload[1] == schema_id
+            assert bool(payload[2] & FLAG_KEYFRAME) == (fields[0] == "key")
+            if kind == "missed":
+                pending = []
+                continue
+            samples = decoder.decode(topic, payload)
+            if kind == "skipped":
+                assert samples == []
+            else:
+                assert len(samples) == len(pending)
+                first_time, first_ms, _ = pending[0]
+                for sample, (_, ms, values) in zip(samples, pending):
+                    assert sample[SCHEMAS[schema_id]["label"]] == label
+                    assert channel_values(schema_id, sample) == values
+                    elapsed_ms = (ms - first_ms) & 0xFFFFFFFF
+                    assert sample["epoch"] == (first_time + elapsed_ms / 1000.0 if first_time else 0)
+                decoded += len(samples)
+            pending = []
+
+    assert decoded == 32
+    assert decoder.skipped_batches == 2
+
+
+if __name__ == "__main__":
+    post_test_data()